@@ -68,6 +68,13 @@ void AppController::initialize() {
     } else {
         main_window_.setIntegrationStatus("Eigen-Kern off");
     }
+    // Netz-Cache auf der Platte: Projekt-Öffnen lädt unveränderte Teile statt sie neu zu tessellieren
+    std::error_code mesh_cache_error;
+    const std::filesystem::path mesh_cache_dir = std::filesystem::temp_directory_path(mesh_cache_error);
+    if (!mesh_cache_error) {
+        mesh_cache_ = std::make_unique<cad::kernel::io::MeshCache>((mesh_cache_dir / "hydracad-mesh-cache").string());
+    }
+    // Precise-Kollision: Netz-Lieferant wird je Prüfung mit festem Schnappschuss gesetzt (prepareInterferenceCheck)
 #endif
     techdraw_bridge_.initialize();
     cad::core::Sketch sketch("Sketch1");
@@ -335,9 +342,11 @@ void AppController::updateAssemblyConstraintStatus() {
     if (active_assembly_.components().empty()) {
         return;
     }
-    int dof = active_assembly_.getDegreesOfFreedom();
-    bool over = active_assembly_.isOverConstrained();
-    bool under = active_assembly_.isUnderConstrained();
+    // Eine Analyse (Jacobi-Rang) für DOF und Über-/Unterbestimmung statt je Abfrage neu
+    const cad::core::MateSolveReport report = active_assembly_.analyzeMates();
+    const int dof = report.degrees_of_freedom;
+    const bool over = report.redundant_equations > 0;
+    const bool under = dof > 0 && active_assembly_.components().size() > 1;
     std::string status;
     if (over) {
         status = "Assembly: Überbestimmt (Konflikte möglich)";
@@ -422,6 +431,17 @@ void AppController::initializeAssembly() {
     bom_service_.registerAssembly("MainAssembly", active_assembly_);
 
     assembly_manager_.setCacheLimit(300);
+    std::error_code temp_error;
+    const std::filesystem::path temp_dir = std::filesystem::temp_directory_path(temp_error);
+    if (!temp_error) {
+        assembly_manager_.setDiskCacheDirectory((temp_dir / "hydracad-assembly-cache").string());
+    }
+#ifdef CAD_USE_EIGENER_KERN
+    assembly_manager_.setTessellator([this](const cad::core::Part& part, cad::core::LodMode lod,
+                                            cad::core::TriangleMesh& mesh) {
+        return tessellatePart(part, static_cast<int>(lod), mesh);
+    });
+#endif
     assembly_manager_.enableBackgroundLoading(true);
     assembly_manager_.setLodMode(cad::core::LodMode::Simplified);
     assembly_manager_.setTargetFps(30.0);
@@ -433,6 +453,7 @@ void AppController::initializeAssembly() {
     } else {
         main_window_.setViewportStatus("LOD recommendation: full");
     }
+    publishSketchSnapshot();
     cad::core::PerfTimer timer("AssemblyLoad");
     cad::core::AssemblyLoadStats load_stats = assembly_manager_.loadAssembly("MainAssembly");
     cad::core::PerfSpan span = timer.finish();
@@ -514,6 +535,69 @@ void AppController::syncAssemblyTransformsToViewport() {
 #endif
 }
 
+std::shared_ptr<const std::map<std::string, cad::core::Sketch>> AppController::publishSketchSnapshot() {
+    auto snapshot = std::make_shared<std::map<std::string, cad::core::Sketch>>(project_sketches_);
+    snapshot->insert_or_assign(active_sketch_.name(), active_sketch_);
+    std::shared_ptr<const std::map<std::string, cad::core::Sketch>> published = std::move(snapshot);
+    std::lock_guard<std::mutex> lock(sketch_snapshot_mutex_);
+    sketch_snapshot_ = published;
+    return published;
+}
+
+void AppController::prepareInterferenceCheck() {
+    auto snapshot = publishSketchSnapshot();
+#ifdef CAD_USE_EIGENER_KERN
+    // Precise-Kollision: echte Dreiecksnetze aus dem Eigen-Kern. Läuft parallel auf dem Pool: eigene Bridge
+    // je Aufruf, Skizzen aus dem gebundenen Schnappschuss (kein Zugriff auf Member-Zustand), MeshCache sperrt selbst.
+    interference_checker_.setMeshProvider(
+        [this, snapshot](const cad::core::Part& part, cad::core::TriangleMesh& mesh) {
+            return tessellatePart(part, 0, *snapshot, mesh);
+        });
+#else
+    (void)snapshot;
+#endif
+}
+
+#ifdef CAD_USE_EIGENER_KERN
+bool AppController::tessellatePart(const cad::core::Part& part, int lod, cad::core::TriangleMesh& mesh) {
+    std::shared_ptr<const std::map<std::string, cad::core::Sketch>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(sketch_snapshot_mutex_);
+        snapshot = sketch_snapshot_;
+    }
+    if (!snapshot) {
+        return false;  // noch nichts eingeplant
+    }
+    return tessellatePart(part, lod, *snapshot, mesh);
+}
+
+bool AppController::tessellatePart(const cad::core::Part& part, int lod,
+                                   const std::map<std::string, cad::core::Sketch>& sketches,
+                                   cad::core::TriangleMesh& mesh) {
+    // Schlüssel über jede vom Part referenzierte Skizze (Inhalt, nicht nur Id).
+    // Der Eigen-Kern tesselliert exakt (ebene Facetten) → Toleranz fest, geht nur in den Schlüssel ein
+    const std::uint64_t key = cad::kernel::partContentKey(part, &sketches, 1e-3);
+    if (mesh_cache_) {
+        if (auto cached = mesh_cache_->load(key, lod)) {
+            mesh.vertices.assign(cached->vertices(), cached->vertices() + cached->vertexCount() * 3);
+            mesh.indices.assign(cached->indices(), cached->indices() + cached->indexCount());
+            return !mesh.indices.empty();
+        }
+    }
+    cad::kernel::KernelBridge bridge;
+    if (!bridge.initialize() || !bridge.buildPartFromPart(part, &sketches)) {
+        return false;
+    }
+    cad::kernel::io::TriangleMesh solid_mesh = cad::kernel::io::MeshCache::weld(bridge.getLastSolidMesh());
+    if (mesh_cache_) {
+        mesh_cache_->store(key, solid_mesh, lod);
+    }
+    mesh.vertices = std::move(solid_mesh.vertices);
+    mesh.indices = std::move(solid_mesh.indices);
+    return !mesh.indices.empty();
+}
+#endif
+
 void AppController::executeCommand(const std::string& command) {
     // Parse command into base name and space-separated parameters (for sketch commands)
     std::string base_cmd = command;
@@ -579,18 +663,18 @@ void AppController::executeCommand(const std::string& command) {
     if (command == "iLogic") {
         cad::core::AssemblyComponent* comp = active_assembly_.findComponent(active_assembly_.components().empty() ? 0 : active_assembly_.components()[0].id);
         if (comp) {
-            if (comp->part.rules().empty()) {
+            if (comp->part->rules().empty()) {
                 cad::core::Rule rule;
                 rule.name = "WidthToHeight";
                 rule.trigger = "ParameterChange";
                 rule.condition_expression = "Width > 80";
                 rule.then_parameter = "Height";
                 rule.then_value_expression = "40";
-                comp->part.addRule(rule);
+                comp->part.edit().addRule(rule);
             }
-            modeler_.evaluatePartParameters(comp->part);
-            modeler_.evaluatePartRules(comp->part);
-            main_window_.setIntegrationStatus("iLogic: " + std::to_string(comp->part.rules().size()) + " rule(s) evaluated");
+            modeler_.evaluatePartParameters(comp->part.edit());
+            modeler_.evaluatePartRules(comp->part.edit());
+            main_window_.setIntegrationStatus("iLogic: " + std::to_string(comp->part->rules().size()) + " rule(s) evaluated");
             main_window_.setViewportStatus("Regeln ausgeführt (ParameterChange)");
         } else {
             main_window_.setIntegrationStatus("iLogic: No part selected");
@@ -604,16 +688,16 @@ void AppController::executeCommand(const std::string& command) {
         std::vector<std::string> expressions;
         cad::core::AssemblyComponent* comp = active_assembly_.findComponent(active_assembly_.components().empty() ? 0 : active_assembly_.components()[0].id);
         if (comp) {
-            modeler_.evaluatePartParameters(comp->part);
-            modeler_.evaluatePartRules(comp->part);
-            for (const auto& p : comp->part.userParameters()) {
+            modeler_.evaluatePartParameters(comp->part.edit());
+            modeler_.evaluatePartRules(comp->part.edit());
+            for (const auto& p : comp->part->userParameters()) {
                 names.push_back(p.name);
                 values.push_back(p.value);
                 expressions.push_back(p.expression);
             }
             total_params += static_cast<int>(names.size());
-            if (!comp->part.userParameters().empty()) {
-                summary += " | Part: " + std::to_string(comp->part.userParameters().size()) + " user";
+            if (!comp->part->userParameters().empty()) {
+                summary += " | Part: " + std::to_string(comp->part->userParameters().size()) + " user";
             }
         }
         main_window_.setParameterTable(names, values, expressions);
@@ -803,6 +887,7 @@ void AppController::executeCommand(const std::string& command) {
         request.duration = 2.0;
         request.time_step = 0.02;
         request.joint_drives["Revolute1"] = 1.0;
+        request.assembly = &active_assembly_;
         cad::modules::SimulationResult result = simulation_service_.runSimulation(request);
         if (simulation_service_.exportMotionReport(result, "motion_report.txt")) {
             main_window_.setIntegrationStatus("Motion report exported to motion_report.txt");
@@ -812,6 +897,7 @@ void AppController::executeCommand(const std::string& command) {
             main_window_.setViewportStatus("Export fehlgeschlagen");
         }
     } else if (command == "Interference") {
+        prepareInterferenceCheck();
         cad::core::InterferenceResult result = interference_checker_.checkAssembly(active_assembly_);
         main_window_.setIntegrationStatus(result.message);
         if (result.has_interference) {
@@ -824,6 +910,21 @@ void AppController::executeCommand(const std::string& command) {
         } else {
             main_window_.setViewportStatus("No interference detected");
         }
+    } else if (command == "Clearance") {
+        // Freigang: alle Komponentenpaare näher als 2 mm
+        prepareInterferenceCheck();
+        cad::core::ClearanceReport report = interference_checker_.checkClearance(active_assembly_, 2.0);
+        main_window_.setIntegrationStatus(report.message);
+        if (!report.pairs.empty()) {
+            const cad::core::ClearancePair& closest = *std::min_element(
+                report.pairs.begin(), report.pairs.end(),
+                [](const cad::core::ClearancePair& x, const cad::core::ClearancePair& y) { return x.distance < y.distance; });
+            main_window_.setViewportStatus("Clearance: " + std::to_string(report.pairs.size()) + " pair(s) < 2 mm (min " +
+                                           std::to_string(closest.distance) + " mm, " + closest.part_a_name +
+                                           " <-> " + closest.part_b_name + ")");
+        } else {
+            main_window_.setViewportStatus("Clearance OK (>= 2 mm)");
+        }
     } else if (command == "Base View" || command == "BaseView") {
         cad::modules::DrawingRequest request;
         request.sourcePart = "Bracket";
@@ -1151,6 +1252,7 @@ void AppController::executeCommand(const std::string& command) {
             syncAssemblyTransformsToViewport();
         }
     } else if (command == "LoadAssembly") {
+        publishSketchSnapshot();
         assembly_manager_.enqueueLoad("MainAssembly");
         main_window_.setLoadProgress(0);
         main_window_.setViewportStatus("Assembly load queued");
@@ -1538,9 +1640,9 @@ void AppController::executeCommand(const std::string& command) {
         bool did_suppress = false;
         if (!active_assembly_.components().empty()) {
             cad::core::AssemblyComponent* comp = active_assembly_.findComponent(active_assembly_.components()[0].id);
-            if (comp && !comp->part.features().empty()) {
-                std::string feat_name = comp->part.features().back().name;
-                did_suppress = comp->part.setFeatureSuppressed(feat_name, true);
+            if (comp && !comp->part->features().empty()) {
+                std::string feat_name = comp->part->features().back().name;
+                did_suppress = comp->part.edit().setFeatureSuppressed(feat_name, true);
                 if (did_suppress) {
                     main_window_.setIntegrationStatus("Suppress: Feature \"" + feat_name + "\" suppressed.");
                     main_window_.setViewportStatus("Feature suppressed");
@@ -1832,6 +1934,7 @@ bool AppController::loadProject(const std::string& file_path) {
     std::map<std::string, cad::core::Sketch> loaded_sketches;
     bool success = project_file_service_.loadProject(file_path, active_assembly_, &loaded_sketches);
     if (success) {
+        project_sketches_ = loaded_sketches;
         if (!loaded_sketches.empty()) {
             auto it = loaded_sketches.find(active_sketch_.name());
             active_sketch_ = (it != loaded_sketches.end()) ? it->second : loaded_sketches.begin()->second;
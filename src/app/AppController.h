@@ -4,6 +4,8 @@
 #include "core/Modeler/Modeler.h"
 #ifdef CAD_USE_EIGENER_KERN
 #include "core/kernel/KernelBridge.h"
+#include "core/kernel/PartHash.h"
+#include "core/kernel/io/MeshCache.h"
 #endif
 #include "core/undo/UndoStack.h"
 #include "core/TechDrawBridge.h"
@@ -35,7 +37,9 @@
 #include "PrinterService.h"
 #include "ai/AIService.h"
 #include <vector>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <filesystem>
 #include <algorithm>
 
@@ -91,11 +95,31 @@ private:
     void bindCommands();
     void executeCommand(const std::string& command);
     void syncAssemblyTransformsToViewport();
+    /**
+     * UI-Thread, vor dem Einplanen von Ladeaufträgen und Kollisionsprüfungen: Projekt- und aktive Skizze
+     * als unveränderliche Kopie bereitstellen. Worker lesen nur diese Kopie, nie active_sketch_.
+     */
+    std::shared_ptr<const std::map<std::string, cad::core::Sketch>> publishSketchSnapshot();
+    /**
+     * UI-Thread, vor checkAssembly/checkClearance: Schnappschuss veröffentlichen und fest an den
+     * Netz-Lieferanten der Kollisionsprüfung binden, damit ein Lauf durchgehend denselben Stand sieht.
+     */
+    void prepareInterferenceCheck();
+#ifdef CAD_USE_EIGENER_KERN
+    /**
+     * Part tessellieren, über den Netz-Cache (Inhaltsschlüssel + LOD) statt Neuaufbau wo möglich.
+     * Läuft auf Pool-Workern; Skizzen aus dem zuletzt veröffentlichten Schnappschuss.
+     */
+    bool tessellatePart(const cad::core::Part& part, int lod, cad::core::TriangleMesh& mesh);
+    bool tessellatePart(const cad::core::Part& part, int lod, const std::map<std::string, cad::core::Sketch>& sketches,
+                        cad::core::TriangleMesh& mesh);
+#endif
 
     cad::ui::MainWindow main_window_;
     cad::core::Modeler modeler_;
 #ifdef CAD_USE_EIGENER_KERN
     std::unique_ptr<cad::kernel::KernelBridge> eigen_kernel_;
+    std::unique_ptr<cad::kernel::io::MeshCache> mesh_cache_;
 #endif
     cad::core::TechDrawBridge techdraw_bridge_;
     cad::core::InterferenceChecker interference_checker_;
@@ -125,6 +149,10 @@ private:
     cad::app::PrinterService printer_service_;
     cad::app::ai::AIService ai_service_;
     cad::core::Sketch active_sketch_{"Sketch"};
+    /** Alle Skizzen des geladenen Projekts (Parts referenzieren auch andere als die aktive). */
+    std::map<std::string, cad::core::Sketch> project_sketches_;
+    mutable std::mutex sketch_snapshot_mutex_;
+    std::shared_ptr<const std::map<std::string, cad::core::Sketch>> sketch_snapshot_;
     cad::core::Assembly active_assembly_;
     std::vector<std::string> recent_projects_;
     bool has_unsaved_changes_{false};
@@ -8,6 +8,7 @@
 #endif
 
 #include <algorithm>
+#include <cctype>
 #include <cstdlib>
 #include <ctime>
 
@@ -150,7 +151,24 @@ PrinterUploadResult PrinterService::testConnection(const std::string& printer_id
 PrinterUploadResult PrinterService::sendStlToPrinter(const std::string& printer_id,
                                                      const std::string& stl_path,
                                                      bool start_print) const {
+    return sendModelToPrinter(printer_id, stl_path, start_print);
+}
+
+PrinterUploadResult PrinterService::sendModelToPrinter(const std::string& printer_id,
+                                                       const std::string& model_path,
+                                                       bool start_print) const {
     PrinterUploadResult result;
+    std::string extension;
+    const std::size_t dot = model_path.find_last_of('.');
+    if (dot != std::string::npos) {
+        extension = model_path.substr(dot + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    }
+    if (extension != "stl" && extension != "3mf") {
+        result.message = "Unsupported model format (STL or 3MF expected)";
+        return result;
+    }
     if (!http_client_) {
         result.message = "HTTP client not available";
         return result;
@@ -173,7 +191,7 @@ PrinterUploadResult PrinterService::sendStlToPrinter(const std::string& printer_
         result.message = "Printer URL not set";
         return result;
     }
-    HttpResponse resp = http_client_->uploadFile(url, stl_path, headers);
+    HttpResponse resp = http_client_->uploadFile(url, model_path, headers);
     result.status_code = resp.status_code;
     result.success = (resp.status_code >= 200 && resp.status_code < 300);
     result.message = resp.body.empty() ? (result.success ? "Upload OK" : "Upload failed") : resp.body;
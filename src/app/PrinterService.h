@@ -39,6 +39,9 @@ public:
     /** Upload STL file to printer. OctoPrint: POST /api/files/local; Moonraker: POST /server/files/upload. */
     PrinterUploadResult sendStlToPrinter(const std::string& printer_id, const std::string& stl_path,
                                           bool start_print = false) const;
+    /** Upload STL or 3MF (by extension) to printer; same endpoints as sendStlToPrinter. */
+    PrinterUploadResult sendModelToPrinter(const std::string& printer_id, const std::string& model_path,
+                                            bool start_print = false) const;
 
 private:
     HttpClient* http_client_{nullptr};
@@ -892,12 +892,14 @@ std::string ProjectFileService::serializeAssembly(const cad::core::Assembly& ass
     std::vector<std::string> part_ids;
     
     for (const auto& component : assembly.components()) {
-        std::string part_id = component.part.name();
+        std::string part_id = component.part->name();
         part_ids.push_back(part_id);
         oss << "COMPONENT_ID:" << component.id << "\n";
         oss << "COMPONENT:" << part_id << "\n";
+        const cad::core::Quaternion q = cad::core::orientationOf(component.transform);
         oss << "TRANSFORM:" << component.transform.tx << ","
-            << component.transform.ty << "," << component.transform.tz << "\n";
+            << component.transform.ty << "," << component.transform.tz << ","
+            << q.w << "," << q.x << "," << q.y << "," << q.z << "\n";
         oss << serializePart(component.part);
     }
     
@@ -938,6 +940,8 @@ std::string ProjectFileService::serializeAssembly(const cad::core::Assembly& ass
             oss << "LIGHTWEIGHT:" << comp.id << "\n";
         if (assembly.isComponentFlexible(comp.id))
             oss << "FLEXIBLE:" << comp.id << "\n";
+        if (comp.parent_id != 0)
+            oss << "COMPONENT_PARENT:" << comp.id << "," << comp.parent_id << "\n";
         for (const std::string& iface : assembly.getComponentInterfaces(comp.id))
             oss << "COMPONENT_INTERFACE:" << comp.id << "|" << iface << "\n";
     }
@@ -957,7 +961,7 @@ std::string ProjectFileService::serializeAssemblyWithSketches(const cad::core::A
     if (sketches != nullptr && !sketches->empty()) {
         std::set<std::string> sketch_ids;
         for (const auto& component : assembly.components()) {
-            for (const auto& f : component.part.features()) {
+            for (const auto& f : component.part->features()) {
                 if (!f.sketch_id.empty()) sketch_ids.insert(f.sketch_id);
             }
         }
@@ -1017,25 +1021,32 @@ bool ProjectFileService::deserializeAssembly(const std::string& data, cad::core:
         std::string line;
         int component_count = 0;
         int mate_count = 0;
+        // Identische Part-Blöcke (Name + Features) teilen eine Definition (Flyweight)
+        std::map<std::string, cad::core::PartRef> definitions;
         
         while (std::getline(iss, line)) {
             if (line.find("COMPONENTS:") == 0) {
                 component_count = std::stoi(line.substr(11));
             } else if (line.find("COMPONENT_ID:") == 0) {
-                // Component ID (stored but not used in current implementation)
-                std::getline(iss, line);  // Skip to next line (COMPONENT:)
+                // IDs werden beim Laden fortlaufend neu vergeben (entspricht der gespeicherten Reihenfolge)
+                (void)line;
             } else if (line.find("COMPONENT:") == 0) {
                 std::string part_name = line.substr(10);
                 cad::core::Part part(part_name);
                 cad::core::Transform transform;
                 if (std::getline(iss, line) && line.find("TRANSFORM:") == 0) {
-                    std::string transform_str = line.substr(10);
-                    size_t pos1 = transform_str.find(',');
-                    size_t pos2 = transform_str.find(',', pos1 + 1);
-                    if (pos1 != std::string::npos && pos2 != std::string::npos) {
-                        transform.tx = std::stod(transform_str.substr(0, pos1));
-                        transform.ty = std::stod(transform_str.substr(pos1 + 1, pos2 - pos1 - 1));
-                        transform.tz = std::stod(transform_str.substr(pos2 + 1));
+                    std::vector<double> vals;
+                    std::istringstream tss(line.substr(10));
+                    for (std::string tok; std::getline(tss, tok, ',');) {
+                        vals.push_back(std::stod(tok));
+                    }
+                    if (vals.size() >= 3) {
+                        transform.tx = vals[0];
+                        transform.ty = vals[1];
+                        transform.tz = vals[2];
+                    }
+                    if (vals.size() >= 7) {
+                        cad::core::setOrientation(transform, cad::core::Quaternion{vals[3], vals[4], vals[5], vals[6]});
                     }
                 }
                 std::string part_data;
@@ -1047,9 +1058,16 @@ bool ProjectFileService::deserializeAssembly(const std::string& data, cad::core:
                         part_data += line + "\n";
                         if (line == "FEATURE_END") ++features_read;
                     }
-                    deserializePart(part_data, part);
                 }
-                assembly.addComponent(part, transform);
+                const std::string key = part_name + "\n" + part_data;
+                auto def = definitions.find(key);
+                if (def == definitions.end()) {
+                    if (!part_data.empty()) {
+                        deserializePart(part_data, part);
+                    }
+                    def = definitions.emplace(key, cad::core::PartRef(std::move(part))).first;
+                }
+                assembly.addComponent(def->second, transform);
             } else if (line.find("MATES:") == 0) {
                 mate_count = std::stoi(line.substr(6));
             } else if (line.find("MATE:") == 0) {
@@ -1150,6 +1168,16 @@ bool ProjectFileService::deserializeAssembly(const std::string& data, cad::core:
                     std::uint64_t cid = static_cast<std::uint64_t>(std::stoull(line.substr(12)));
                     assembly.setComponentLightweight(cid, true);
                 } catch (...) {}
+            } else if (line.find("COMPONENT_PARENT:") == 0) {
+                std::string rest = line.substr(17);
+                size_t comma = rest.find(',');
+                if (comma != std::string::npos) {
+                    try {
+                        std::uint64_t cid = static_cast<std::uint64_t>(std::stoull(rest.substr(0, comma)));
+                        std::uint64_t pid = static_cast<std::uint64_t>(std::stoull(rest.substr(comma + 1)));
+                        assembly.setComponentParent(cid, pid);
+                    } catch (...) {}
+                }
             } else if (line.find("FLEXIBLE:") == 0) {
                 try {
                     std::uint64_t cid = static_cast<std::uint64_t>(std::stoull(line.substr(8)));
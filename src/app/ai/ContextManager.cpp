@@ -24,7 +24,7 @@ void ContextManager::updateAssembly(const cad::core::Assembly& assembly) {
     context_.assembly.component_names.clear();
     
     for (const auto& component : assembly.components()) {
-        context_.assembly.component_names.push_back(component.part.name());
+        context_.assembly.component_names.push_back(component.part->name());
     }
     
     // Build description
@@ -0,0 +1,116 @@
+// cad_convert: kopflose Batch-Konvertierung (ohne Qt/UI) über IoPipeline.
+//
+//   cad_convert [--jobs N] [--quiet] <manifest>
+//   cad_convert [--jobs N] [--quiet] <quelle> <ziel>
+//
+// Manifest: je Zeile "quelle ziel", '#' Kommentar (siehe IoPipeline::readManifest).
+// Exit-Code 0 = alle Aufträge erfolgreich, 1 = mindestens einer fehlgeschlagen, 2 = Aufrufehler.
+
+#include "ProjectFileService.h"
+#include "core/perf/PerfSpan.h"
+#include "interop/IoPipeline.h"
+#ifdef CAD_USE_EIGENER_KERN
+#include "core/kernel/KernelBridge.h"
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+void usage() {
+    std::fprintf(stderr,
+                 "usage: cad_convert [--jobs N] [--quiet] <manifest>\n"
+                 "       cad_convert [--jobs N] [--quiet] <input> <output>\n"
+                 "formats: in  .step .stp .stl .obj .ply .3mf .gltf .glb .hcasm .hcad .cad\n"
+                 "         out .step .stl .obj .ply .3mf .gltf .glb\n");
+}
+
+/** Projekt über den Projektdienst; Teile werden mit den Skizzen des Projekts im Kern tesselliert. */
+bool loadProject(const std::string& path, cad::core::Assembly& assembly,
+                 cad::interop::IoPipeline::Tessellator& tessellator) {
+    auto sketches = std::make_shared<std::map<std::string, cad::core::Sketch>>();
+    if (!cad::app::ProjectFileService().loadProject(path, assembly, sketches.get())) {
+        return false;
+    }
+#ifdef CAD_USE_EIGENER_KERN
+    tessellator = [sketches](const cad::core::Part& part, cad::core::TriangleMesh& mesh) {
+        cad::kernel::KernelBridge bridge;
+        if (!bridge.initialize() || !bridge.buildPartFromPart(part, sketches.get())) {
+            return false;
+        }
+        cad::kernel::io::TriangleMesh solid_mesh = bridge.getLastSolidMesh();
+        mesh.vertices = std::move(solid_mesh.vertices);
+        mesh.indices = std::move(solid_mesh.indices);
+        return !mesh.indices.empty();
+    };
+#else
+    (void)tessellator;
+#endif
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t concurrency = 0;
+    bool quiet = false;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--jobs" && i + 1 < argc) {
+            concurrency = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--quiet") {
+            quiet = true;
+        } else if (arg == "--help" || arg == "-h") {
+            usage();
+            return 0;
+        } else if (!arg.empty() && arg[0] == '-') {
+            usage();
+            return 2;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+
+    std::vector<cad::interop::ConversionJob> jobs;
+    if (positional.size() == 1) {
+        std::string error;
+        if (!cad::interop::IoPipeline::readManifest(positional[0], jobs, error)) {
+            std::fprintf(stderr, "cad_convert: %s\n", error.c_str());
+            return 2;
+        }
+    } else if (positional.size() == 2) {
+        jobs.push_back(cad::interop::ConversionJob{positional[0], positional[1]});
+    } else {
+        usage();
+        return 2;
+    }
+
+    cad::interop::IoPipeline pipeline;
+    pipeline.setProjectLoader(loadProject);
+    cad::core::PerfTimer timer("convert");
+    const std::vector<cad::interop::ConversionResult> results = pipeline.convertAll(
+        jobs, concurrency,
+        [quiet](const cad::interop::ConversionResult& result, std::size_t done, std::size_t total) {
+            if (quiet && result.success) {
+                return;
+            }
+            std::fprintf(result.success ? stdout : stderr, "[%zu/%zu] %s %8.1f ms  %s -> %s  (%s)\n", done, total,
+                         result.success ? "OK  " : "FAIL", result.total_ms, result.job.input.c_str(),
+                         result.job.output.c_str(), result.message.c_str());
+        });
+    const cad::interop::ConversionStats stats =
+        cad::interop::IoPipeline::summarize(results, timer.finish().elapsed_ms);
+
+    std::printf("%zu jobs: %zu ok, %zu failed in %.1f ms\n", stats.jobs, stats.succeeded, stats.failed,
+                stats.wall_ms);
+    std::printf("throughput: %.2f jobs/s, %.2f MB/s input\n", stats.jobs_per_second, stats.megabytes_per_second);
+    std::printf("latency: mean %.1f ms, p50 %.1f ms, p95 %.1f ms, max %.1f ms\n", stats.latency_mean_ms,
+                stats.latency_p50_ms, stats.latency_p95_ms, stats.latency_max_ms);
+    return stats.failed == 0 ? 0 : 1;
+}
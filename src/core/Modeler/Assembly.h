@@ -4,9 +4,11 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Part.h"
+#include "PartRef.h"
 #include "ReferenceGeometry.h"
 #include "Transform.h"
 
@@ -15,8 +17,12 @@ namespace core {
 
 struct AssemblyComponent {
     std::uint64_t id{0};
-    Part part{"Part"};
+    /** Geteilte Part-Definition; Änderungen nur über part.edit() (Copy-on-Write). */
+    PartRef part{};
+    /** Lage relativ zur Eltern-Komponente (parent_id == 0: relativ zur Baugruppe). */
     Transform transform{};
+    /** Unterbaugruppe: Eltern-Komponente (0 = oberste Ebene). */
+    std::uint64_t parent_id{0};
     /** SpeedPak / Large Assembly Mode: bei true nur vereinfachte Darstellung (LOD). */
     bool lightweight_display{false};
     /** Flexible Subassembly (SolidWorks): Unterbaugruppe kann intern bewegt werden. */
@@ -43,6 +49,43 @@ struct MateConstraint {
     double value{0.0};
 };
 
+/**
+ * Ergebnis des globalen Mate-Solvers (§13): Konvergenz, echte Freiheitsgrade aus dem Rang der
+ * Mate-Jacobi-Matrix, widersprüchliche Mates (überbestimmt) und unterbestimmte Komponenten.
+ * Die erste Komponente ist fixiert (Inventor: Grounded).
+ */
+struct MateSolveReport {
+    /** Nur true, wenn das Restresiduum innerhalb der Toleranz liegt (Ausgleichslösung zählt nicht). */
+    bool converged{false};
+    int iterations{0};
+    double max_residual{0.0};
+    int equations{0};
+    int degrees_of_freedom{0};
+    /** Linear abhängige Gleichungen (m - Rang); > 0 = überbestimmt (redundant oder widersprüchlich). */
+    int redundant_equations{0};
+    /** Indizes in mates(), deren Residuum nach dem Lösen nicht verschwindet. */
+    std::vector<std::size_t> conflicting_mates;
+    /** Komponenten mit verbleibenden Freiheitsgraden. */
+    std::vector<std::uint64_t> under_constrained_components;
+    /** Starr gekoppelte Komponentengruppen (werden als ein Körper gelöst). */
+    std::vector<std::vector<std::uint64_t>> rigid_groups;
+    double solve_ms{0.0};
+};
+
+/**
+ * Welt-Transformationen aller Komponenten als Structure-of-Arrays (Slot = Index in components()).
+ * Für Bulk-Zugriffe (Renderer, Kollision) ohne Hierarchie-Traversierung.
+ */
+struct WorldTransformArrays {
+    std::vector<double> tx;
+    std::vector<double> ty;
+    std::vector<double> tz;
+    std::vector<double> qw;
+    std::vector<double> qx;
+    std::vector<double> qy;
+    std::vector<double> qz;
+};
+
 /** Joint type for kinematic motion (§13): defines allowed DOF between two components. */
 enum class JointType {
     Rigid,      /** No relative motion */
@@ -79,8 +122,15 @@ struct AssemblyConfiguration {
 
 class Assembly {
 public:
-    std::uint64_t addComponent(const Part& part, const Transform& transform);
+    /** parent_id != 0: Komponente einer Unterbaugruppe, transform relativ zu parent_id. */
+    std::uint64_t addComponent(const PartRef& part, const Transform& transform, std::uint64_t parent_id = 0);
+    /** Weiteres Vorkommen derselben Part-Definition (teilt Features/Parameter); 0 = Quelle unbekannt. */
+    std::uint64_t addInstance(std::uint64_t source_component_id, const Transform& transform);
     const std::vector<AssemblyComponent>& components() const;
+    /** Bearbeitung im Kontext: löst die Komponente per Copy-on-Write von geteilten Definitionen; nullptr = unbekannt. */
+    Part* editComponentPart(std::uint64_t component_id);
+    /** Anzahl unterschiedlicher Part-Definitionen (≤ Anzahl Komponenten). */
+    std::size_t uniquePartDefinitionCount() const;
     void addMate(const MateConstraint& mate);
     const std::vector<MateConstraint>& mates() const;
     
@@ -101,7 +151,14 @@ public:
     std::string createCam(std::uint64_t component_a, std::uint64_t component_b, double phase_offset = 0.0);
     
     // Mate solving (updates component transforms based on mates)
+    /**
+     * Globaler 6-DOF-Solver (Quaternionen, dünnbesetztes Levenberg-Marquardt); false = nicht konvergiert.
+     * Arbeitet auf den lokalen Transformationen (für Komponenten der obersten Ebene = Welt).
+     */
     bool solveMates();
+    const MateSolveReport& lastMateSolveReport() const { return last_solve_report_; }
+    /** Rang-Analyse bei aktuellen Transformationen, ohne diese zu ändern. */
+    MateSolveReport analyzeMates() const;
     
     // Mate validation
     bool validateMates() const;
@@ -109,9 +166,29 @@ public:
     bool isOverConstrained() const;
     bool isUnderConstrained() const;
     
+    /**
+     * O(1) über id→Slot-Index. Nicht-const für Part-Änderungen; transform und parent_id nur über
+     * setComponentTransform/setComponentParent ändern, sonst bleibt der Welt-Cache veraltet.
+     */
     AssemblyComponent* findComponent(std::uint64_t id);
     const AssemblyComponent* findComponent(std::uint64_t id) const;
 
+    // Hierarchie / Welt-Transformationen (Unterbaugruppen)
+    /** Setzt die lokale Transformation; invalidiert nur den Teilbaum der Komponente. */
+    bool setComponentTransform(std::uint64_t component_id, const Transform& transform);
+    /** Hängt die Komponente um; false bei unbekannter ID oder Zyklus. Lokale Transformation bleibt erhalten. */
+    bool setComponentParent(std::uint64_t component_id, std::uint64_t parent_id);
+    std::vector<std::uint64_t> childComponents(std::uint64_t component_id) const;
+    /**
+     * Welt-Transformation (Eltern-Kette verkettet, gecacht mit Dirty-Flags). Aktualisiert den Cache lazy –
+     * vor parallelem Lesen aus mehreren Threads einmal worldTransforms() aufrufen.
+     */
+    Transform worldTransform(std::uint64_t component_id) const;
+    /** Alle Welt-Transformationen (SoA); aktualisiert vorher nur verschmutzte Einträge. */
+    const WorldTransformArrays& worldTransforms() const;
+    /** Anzahl neu berechneter Welt-Transformationen seit Erzeugung (Cache-Statistik). */
+    std::size_t worldTransformRecomputations() const { return world_recomputations_; }
+
     // Joints (§13): kinematic connections for simulation
     // Creo: Mechanisms/Kinematik-UI nutzt dieselbe Joint-API (Revolute, Slider, Cylindrical, Planar).
     void addJoint(const Joint& joint);
@@ -145,7 +222,7 @@ public:
     double getExplosionFactor() const;
     void clearExplosionOffsets();
     bool hasExplosionOffsets() const;
-    /** Effective transform for display (base transform + explosion_offset * factor). */
+    /** Effective transform for display (world transform + explosion_offset * factor). */
     Transform getDisplayTransform(std::uint64_t component_id) const;
 
     /** SpeedPak / Large Assembly: Leichte Darstellung (nur Bounding-Box/LOD). */
@@ -171,6 +248,13 @@ public:
 private:
     std::uint64_t next_id_{1};
     std::vector<AssemblyComponent> components_{};
+    std::unordered_map<std::uint64_t, std::size_t> slot_by_id_{};
+    /** Slots der direkten Kinder je Slot. */
+    std::vector<std::vector<std::size_t>> child_slots_{};
+    mutable WorldTransformArrays world_{};
+    /** Invariante: ist ein Slot dirty, sind es auch alle Nachfahren. */
+    mutable std::vector<char> world_dirty_{};
+    mutable std::size_t world_recomputations_{0};
     std::vector<MateConstraint> mates_{};
     std::vector<Joint> joints_{};
     std::vector<AssemblyConfiguration> configurations_{};
@@ -180,6 +264,13 @@ private:
     std::map<std::uint64_t, Vector3D> explosion_offsets_{};
     double explosion_factor_{0.0};
     std::map<std::uint64_t, std::vector<std::string>> component_interfaces_{};
+    MateSolveReport last_solve_report_{};
+
+    std::size_t slotOf(std::uint64_t id) const;
+    /** Kopie der Komponenten mit Welt- statt Eltern-relativer Transformation (für den Mate-Solver). */
+    std::vector<AssemblyComponent> worldComponents() const;
+    void markSubtreeDirty(std::size_t slot);
+    void updateWorldTransform(std::size_t slot) const;
 };
 
 }  // namespace core
@@ -0,0 +1,871 @@
+#include "MateSolver.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <set>
+#include <unordered_map>
+#include <utility>
+
+#include "parallel/ThreadPool.h"
+
+namespace cad {
+namespace core {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+struct V3 {
+    double x{0.0};
+    double y{0.0};
+    double z{0.0};
+};
+
+inline V3 operator+(const V3& a, const V3& b) { return V3{a.x + b.x, a.y + b.y, a.z + b.z}; }
+inline V3 operator-(const V3& a, const V3& b) { return V3{a.x - b.x, a.y - b.y, a.z - b.z}; }
+inline V3 operator*(const V3& a, double s) { return V3{a.x * s, a.y * s, a.z * s}; }
+inline double dot(const V3& a, const V3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+inline V3 cross(const V3& a, const V3& b) {
+    return V3{a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+inline V3 rotate(const Quaternion& q, V3 v) {
+    rotateVector(q, v.x, v.y, v.z);
+    return v;
+}
+
+inline V3 axisOf(const Quaternion& q, int k) {
+    return rotate(q, V3{k == 0 ? 1.0 : 0.0, k == 1 ? 1.0 : 0.0, k == 2 ? 1.0 : 0.0});
+}
+
+inline double wrapAngle(double a) {
+    a = std::fmod(a, 2.0 * kPi);
+    if (a > kPi) a -= 2.0 * kPi;
+    if (a <= -kPi) a += 2.0 * kPi;
+    return a;
+}
+
+struct Pose {
+    V3 p;
+    Quaternion q;
+};
+
+/** Eine Residuenzeile mit Gradient bzgl. (dp, dθ) von Körper A und B (dθ: Weltrahmen-Drehvektor). */
+struct Row {
+    double r{0.0};
+    std::array<double, 6> ja{};
+    std::array<double, 6> jb{};
+};
+
+inline void setLin(std::array<double, 6>& j, const V3& v) { j[0] = v.x; j[1] = v.y; j[2] = v.z; }
+inline void setAng(std::array<double, 6>& j, const V3& v) { j[3] = v.x; j[4] = v.y; j[5] = v.z; }
+
+/** pb - (pa + Ra*la) = 0 (3 Zeilen). */
+int pointCoincidence(const Pose& a, const Pose& b, const V3& la, Row* rows) {
+    const V3 wa = rotate(a.q, la);
+    const V3 d = b.p - a.p - wa;
+    const double r[3] = {d.x, d.y, d.z};
+    // ∂r/∂θa = [wa]x
+    const V3 skew[3] = {V3{0.0, -wa.z, wa.y}, V3{wa.z, 0.0, -wa.x}, V3{-wa.y, wa.x, 0.0}};
+    for (int k = 0; k < 3; ++k) {
+        Row& row = rows[k];
+        row = Row{};
+        row.r = r[k];
+        row.ja[k] = -1.0;
+        row.jb[k] = 1.0;
+        setAng(row.ja, skew[k]);
+    }
+    return 3;
+}
+
+/** (pb - pa) · (Ra e_axis) - value. */
+int projectedDistance(const Pose& a, const Pose& b, int axis, double value, Row* rows) {
+    const V3 u = axisOf(a.q, axis);
+    const V3 d = b.p - a.p;
+    Row& row = rows[0];
+    row = Row{};
+    row.r = dot(d, u) - value;
+    setLin(row.ja, u * -1.0);
+    setAng(row.ja, cross(u, d));
+    setLin(row.jb, u);
+    return 1;
+}
+
+/** (Ra e_i) · (Rb e_j) = 0. */
+int perpendicular(const Pose& a, int axis_a, const Pose& b, int axis_b, Row* rows) {
+    const V3 u = axisOf(a.q, axis_a);
+    const V3 v = axisOf(b.q, axis_b);
+    Row& row = rows[0];
+    row = Row{};
+    row.r = dot(u, v);
+    setAng(row.ja, cross(u, v));
+    setAng(row.jb, cross(v, u));
+    return 1;
+}
+
+/** |pb - pa| - value. */
+int pointDistance(const Pose& a, const Pose& b, double value, Row* rows) {
+    const V3 d = b.p - a.p;
+    const double len = std::sqrt(dot(d, d));
+    const V3 n = len > 1e-12 ? d * (1.0 / len) : V3{1.0, 0.0, 0.0};
+    Row& row = rows[0];
+    row = Row{};
+    row.r = len - value;
+    setLin(row.ja, n * -1.0);
+    setLin(row.jb, n);
+    return 1;
+}
+
+/** Verdrehung von B gegenüber A um za: atan2(xb·ya, xb·xa) - value. */
+int relativeTwist(const Pose& a, const Pose& b, double value, Row* rows) {
+    const V3 xa = axisOf(a.q, 0);
+    const V3 ya = axisOf(a.q, 1);
+    const V3 xb = axisOf(b.q, 0);
+    const double s = dot(ya, xb);
+    const double c = dot(xa, xb);
+    const double den = std::max(s * s + c * c, 1e-12);
+    const V3 gb = (cross(xb, ya) * c - cross(xb, xa) * s) * (1.0 / den);
+    Row& row = rows[0];
+    row = Row{};
+    row.r = wrapAngle(std::atan2(s, c) - value);
+    setAng(row.jb, gb);
+    setAng(row.ja, gb * -1.0);
+    return 1;
+}
+
+/** Drehwinkel um Welt-z und dessen Gradient. */
+double worldTwist(const Pose& pose, V3& grad) {
+    const V3 x = axisOf(pose.q, 0);
+    const double s = x.y;
+    const double c = x.x;
+    const double den = std::max(s * s + c * c, 1e-12);
+    grad = (cross(x, V3{0.0, 1.0, 0.0}) * c - cross(x, V3{1.0, 0.0, 0.0}) * s) * (1.0 / den);
+    return std::atan2(s, c);
+}
+
+constexpr int kMaxRowsPerMate = 6;
+
+int evaluateMate(const MateConstraint& mate, const Pose& a, const Pose& b, Row* rows) {
+    switch (mate.type) {
+        case MateType::Mate:
+            return pointCoincidence(a, b, V3{mate.value, 0.0, 0.0}, rows);
+        case MateType::Flush: {
+            int n = perpendicular(a, 1, b, 0, rows);
+            n += perpendicular(a, 2, b, 0, rows + n);
+            n += projectedDistance(a, b, 0, mate.value, rows + n);
+            return n;
+        }
+        case MateType::Concentric: {
+            int n = perpendicular(a, 0, b, 2, rows);
+            n += perpendicular(a, 1, b, 2, rows + n);
+            n += projectedDistance(a, b, 0, mate.value, rows + n);
+            n += projectedDistance(a, b, 1, 0.0, rows + n);
+            return n;
+        }
+        case MateType::Tangent:
+            return projectedDistance(a, b, 0, mate.value, rows);
+        case MateType::Parallel: {
+            int n = perpendicular(a, 1, b, 0, rows);
+            n += perpendicular(a, 2, b, 0, rows + n);
+            if (std::abs(mate.value) > 1e-9) {
+                n += projectedDistance(a, b, 0, mate.value, rows + n);
+            }
+            return n;
+        }
+        case MateType::Distance:
+            return pointDistance(a, b, mate.value, rows);
+        case MateType::Angle:
+            return relativeTwist(a, b, mate.value, rows);
+        case MateType::Insert: {
+            int n = perpendicular(a, 0, b, 2, rows);
+            n += perpendicular(a, 1, b, 2, rows + n);
+            n += pointCoincidence(a, b, V3{}, rows + n);
+            return n;
+        }
+        case MateType::Gear:
+        case MateType::Cam: {
+            V3 ga, gb;
+            const double ta = worldTwist(a, ga);
+            const double tb = worldTwist(b, gb);
+            const double factor = mate.type == MateType::Gear ? mate.value : 1.0;
+            const double offset = mate.type == MateType::Cam ? mate.value : 0.0;
+            Row& row = rows[0];
+            row = Row{};
+            row.r = wrapAngle(tb - factor * ta - offset);
+            setAng(row.ja, ga * -factor);
+            setAng(row.jb, gb);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+using Mat6 = std::array<double, 36>;
+
+/**
+ * Block-Cholesky für symmetrische Matrizen mit 6x6-Blöcken. Minimum-Degree-Ordnung und Fill-In-Muster
+ * werden einmal bestimmt (analyze), danach beliebig oft numerisch faktorisiert. Pivots unter der Schwelle
+ * gelten als Null (positiv semidefinit → freie Richtung); so liefert die Faktorisierung auch den Rang.
+ */
+class BlockCholesky {
+public:
+    void analyze(int n, const std::vector<std::pair<int, int>>& edges) {
+        n_ = n;
+        std::vector<std::set<int>> adj(static_cast<std::size_t>(n));
+        for (const auto& e : edges) {
+            if (e.first == e.second) continue;
+            adj[static_cast<std::size_t>(e.first)].insert(e.second);
+            adj[static_cast<std::size_t>(e.second)].insert(e.first);
+        }
+        std::set<std::pair<std::size_t, int>> queue;
+        for (int v = 0; v < n; ++v) queue.emplace(adj[static_cast<std::size_t>(v)].size(), v);
+        order_.clear();
+        order_.reserve(static_cast<std::size_t>(n));
+        pos_.assign(static_cast<std::size_t>(n), -1);
+        col_.assign(static_cast<std::size_t>(n), {});
+        while (!queue.empty()) {
+            const int v = queue.begin()->second;
+            queue.erase(queue.begin());
+            pos_[static_cast<std::size_t>(v)] = static_cast<int>(order_.size());
+            order_.push_back(v);
+            std::vector<int> nbrs(adj[static_cast<std::size_t>(v)].begin(), adj[static_cast<std::size_t>(v)].end());
+            col_[static_cast<std::size_t>(v)] = nbrs;
+            for (int a : nbrs) {
+                auto& set_a = adj[static_cast<std::size_t>(a)];
+                queue.erase({set_a.size(), a});
+                set_a.erase(v);
+                for (int b : nbrs) {
+                    if (b != a) set_a.insert(b);
+                }
+                queue.emplace(set_a.size(), a);
+            }
+            adj[static_cast<std::size_t>(v)].clear();
+        }
+        block_index_.clear();
+        blocks_.clear();
+        for (int v = 0; v < n; ++v) {
+            auto& c = col_[static_cast<std::size_t>(v)];
+            std::sort(c.begin(), c.end(), [this](int a, int b) {
+                return pos_[static_cast<std::size_t>(a)] < pos_[static_cast<std::size_t>(b)];
+            });
+            for (int i : c) {
+                block_index_.emplace(key(v, i), blocks_.size());
+                blocks_.emplace_back();
+            }
+        }
+        diag_.assign(static_cast<std::size_t>(n), Mat6{});
+        zero_pivot_.assign(static_cast<std::size_t>(n) * 6, 0);
+    }
+
+    void clear() {
+        for (auto& d : diag_) d.fill(0.0);
+        for (auto& b : blocks_) b.fill(0.0);
+    }
+
+    Mat6& diag(int v) { return diag_[static_cast<std::size_t>(v)]; }
+
+    /** Assemblierte Werte sichern/wiederherstellen (LM: mehrere Dämpfungen je Iteration). */
+    void save() {
+        saved_diag_ = diag_;
+        saved_blocks_ = blocks_;
+    }
+    void restore() {
+        diag_ = saved_diag_;
+        blocks_ = saved_blocks_;
+    }
+
+    /** H_ab (Zeilen a, Spalten b) addieren; intern als Block (Zeile später eliminiert, Spalte früher). */
+    void addOff(int a, int b, const Mat6& hab) {
+        if (pos_[static_cast<std::size_t>(a)] < pos_[static_cast<std::size_t>(b)]) {
+            Mat6& blk = blocks_[block_index_.at(key(a, b))];
+            for (int r = 0; r < 6; ++r)
+                for (int c = 0; c < 6; ++c) blk[r * 6 + c] += hab[c * 6 + r];
+        } else {
+            Mat6& blk = blocks_[block_index_.at(key(b, a))];
+            for (int k = 0; k < 36; ++k) blk[k] += hab[k];
+        }
+    }
+
+    /** Faktorisiert in-place; liefert Anzahl Null-Pivots (freie Richtungen). */
+    int factor(double relative_tolerance) {
+        std::vector<std::array<double, 6>> scale(static_cast<std::size_t>(n_));
+        for (int v = 0; v < n_; ++v)
+            for (int t = 0; t < 6; ++t) scale[static_cast<std::size_t>(v)][static_cast<std::size_t>(t)] = diag_[static_cast<std::size_t>(v)][static_cast<std::size_t>(t * 7)];
+        int zero = 0;
+        for (int k : order_) {
+            Mat6& L = diag_[static_cast<std::size_t>(k)];
+            char* zp = &zero_pivot_[static_cast<std::size_t>(k) * 6];
+            for (int t = 0; t < 6; ++t) {
+                double d = L[t * 7];
+                for (int s = 0; s < t; ++s) d -= L[t * 6 + s] * L[t * 6 + s];
+                const double threshold = relative_tolerance * std::max(scale[static_cast<std::size_t>(k)][static_cast<std::size_t>(t)], 1e-300);
+                if (d <= threshold) {
+                    zp[t] = 1;
+                    ++zero;
+                    for (int u = t; u < 6; ++u) L[u * 6 + t] = 0.0;
+                    continue;
+                }
+                zp[t] = 0;
+                const double lt = std::sqrt(d);
+                L[t * 7] = lt;
+                for (int u = t + 1; u < 6; ++u) {
+                    double v = L[u * 6 + t];
+                    for (int s = 0; s < t; ++s) v -= L[u * 6 + s] * L[t * 6 + s];
+                    L[u * 6 + t] = v / lt;
+                }
+            }
+            for (int u = 0; u < 6; ++u)
+                for (int t = u + 1; t < 6; ++t) L[u * 6 + t] = 0.0;
+
+            const auto& c = col_[static_cast<std::size_t>(k)];
+            std::vector<Mat6*> lblocks;
+            lblocks.reserve(c.size());
+            for (int i : c) {
+                Mat6& B = blocks_[block_index_.at(key(k, i))];
+                // L_ik = B * L_kk^-T  ⇔  L_kk * L_ik^T = B^T, zeilenweise Vorwärtseinsetzen
+                for (int r = 0; r < 6; ++r) {
+                    double* row = &B[static_cast<std::size_t>(r * 6)];
+                    for (int t = 0; t < 6; ++t) {
+                        if (zp[t]) { row[t] = 0.0; continue; }
+                        double v = row[t];
+                        for (int s = 0; s < t; ++s) v -= L[t * 6 + s] * row[s];
+                        row[t] = v / L[t * 7];
+                    }
+                }
+                lblocks.push_back(&B);
+            }
+            for (std::size_t ii = 0; ii < c.size(); ++ii) {
+                const Mat6& Li = *lblocks[ii];
+                Mat6& Di = diag_[static_cast<std::size_t>(c[ii])];
+                for (int r = 0; r < 6; ++r)
+                    for (int s = 0; s <= r; ++s) {
+                        double v = 0.0;
+                        for (int t = 0; t < 6; ++t) v += Li[r * 6 + t] * Li[s * 6 + t];
+                        Di[r * 6 + s] -= v;
+                        if (s != r) Di[s * 6 + r] -= v;
+                    }
+                for (std::size_t jj = ii + 1; jj < c.size(); ++jj) {
+                    const Mat6& Lj = *lblocks[jj];
+                    Mat6& Hji = blocks_[block_index_.at(key(c[ii], c[jj]))];
+                    for (int r = 0; r < 6; ++r)
+                        for (int s = 0; s < 6; ++s) {
+                            double v = 0.0;
+                            for (int t = 0; t < 6; ++t) v += Lj[r * 6 + t] * Li[s * 6 + t];
+                            Hji[r * 6 + s] -= v;
+                        }
+                }
+            }
+        }
+        return zero;
+    }
+
+    /** Löst L L^T x = b (b wird überschrieben); Null-Pivot-Richtungen erhalten 0. */
+    void solve(std::vector<double>& b) const {
+        for (int k : order_) {
+            const Mat6& L = diag_[static_cast<std::size_t>(k)];
+            const char* zp = &zero_pivot_[static_cast<std::size_t>(k) * 6];
+            double* y = &b[static_cast<std::size_t>(k) * 6];
+            for (int t = 0; t < 6; ++t) {
+                if (zp[t]) { y[t] = 0.0; continue; }
+                double v = y[t];
+                for (int s = 0; s < t; ++s) v -= L[t * 6 + s] * y[s];
+                y[t] = v / L[t * 7];
+            }
+            for (int i : col_[static_cast<std::size_t>(k)]) {
+                const Mat6& Li = blocks_[block_index_.at(key(k, i))];
+                double* bi = &b[static_cast<std::size_t>(i) * 6];
+                for (int r = 0; r < 6; ++r) {
+                    double v = 0.0;
+                    for (int t = 0; t < 6; ++t) v += Li[r * 6 + t] * y[t];
+                    bi[r] -= v;
+                }
+            }
+        }
+        for (auto it = order_.rbegin(); it != order_.rend(); ++it) {
+            const int k = *it;
+            const Mat6& L = diag_[static_cast<std::size_t>(k)];
+            const char* zp = &zero_pivot_[static_cast<std::size_t>(k) * 6];
+            double* x = &b[static_cast<std::size_t>(k) * 6];
+            for (int i : col_[static_cast<std::size_t>(k)]) {
+                const Mat6& Li = blocks_[block_index_.at(key(k, i))];
+                const double* xi = &b[static_cast<std::size_t>(i) * 6];
+                for (int t = 0; t < 6; ++t) {
+                    double v = 0.0;
+                    for (int r = 0; r < 6; ++r) v += Li[r * 6 + t] * xi[r];
+                    x[t] -= v;
+                }
+            }
+            for (int t = 5; t >= 0; --t) {
+                if (zp[t]) { x[t] = 0.0; continue; }
+                double v = x[t];
+                for (int u = t + 1; u < 6; ++u) v -= L[u * 6 + t] * x[u];
+                x[t] = v / L[t * 7];
+            }
+        }
+    }
+
+    bool isZeroPivot(int v, int t) const { return zero_pivot_[static_cast<std::size_t>(v) * 6 + static_cast<std::size_t>(t)] != 0; }
+
+private:
+    static std::uint64_t key(int col, int row) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(col)) << 32) | static_cast<std::uint32_t>(row);
+    }
+
+    int n_{0};
+    std::vector<int> order_;
+    std::vector<int> pos_;
+    std::vector<std::vector<int>> col_;
+    std::unordered_map<std::uint64_t, std::size_t> block_index_;
+    std::vector<Mat6> blocks_;
+    std::vector<Mat6> diag_;
+    std::vector<char> zero_pivot_;
+    std::vector<Mat6> saved_diag_;
+    std::vector<Mat6> saved_blocks_;
+};
+
+/** Körper → Variable: Weltpose = Variablenpose ∘ (rel_p, rel_q); var < 0 = fixiert (pose gilt). */
+struct BodyMap {
+    int var{-1};
+    V3 rel_p;
+    Quaternion rel_q;
+};
+
+struct Term {
+    std::size_t mate{0};
+    int body_a{0};
+    int body_b{0};
+};
+
+/** Nichtlineares Ausgleichsproblem über Variablen-Posen (Levenberg-Marquardt). */
+struct Problem {
+    const std::vector<MateConstraint>* mates{nullptr};
+    std::vector<Pose>* body_pose{nullptr};  // Weltposen aller Körper (fixierte bleiben unverändert)
+    std::vector<BodyMap> bodies;
+    std::vector<Pose> vars;
+    std::vector<Term> terms;
+
+    Pose worldPose(int body, const std::vector<Pose>& var_poses) const {
+        const BodyMap& m = bodies[static_cast<std::size_t>(body)];
+        if (m.var < 0) return (*body_pose)[static_cast<std::size_t>(body)];
+        const Pose& v = var_poses[static_cast<std::size_t>(m.var)];
+        return Pose{v.p + rotate(v.q, m.rel_p), multiply(v.q, m.rel_q)};
+    }
+
+    /** Gradient bzgl. Körper auf Variable umrechnen: dθ_var = dθ - (dp × w), w = Rv * rel_p. */
+    std::array<double, 6> toVar(int body, const std::array<double, 6>& j, const std::vector<Pose>& var_poses) const {
+        const BodyMap& m = bodies[static_cast<std::size_t>(body)];
+        const V3 w = rotate(var_poses[static_cast<std::size_t>(m.var)].q, m.rel_p);
+        const V3 c = cross(V3{j[0], j[1], j[2]}, w);
+        return {j[0], j[1], j[2], j[3] - c.x, j[4] - c.y, j[5] - c.z};
+    }
+
+    double cost(const std::vector<Pose>& var_poses, double* max_abs = nullptr) const {
+        Row rows[kMaxRowsPerMate];
+        double sum = 0.0;
+        double mx = 0.0;
+        for (const auto& t : terms) {
+            const int n = evaluateMate((*mates)[t.mate], worldPose(t.body_a, var_poses), worldPose(t.body_b, var_poses), rows);
+            for (int k = 0; k < n; ++k) {
+                sum += rows[k].r * rows[k].r;
+                mx = std::max(mx, std::abs(rows[k].r));
+            }
+        }
+        if (max_abs) *max_abs = mx;
+        return sum;
+    }
+
+    std::vector<std::pair<int, int>> edges() const {
+        std::vector<std::pair<int, int>> out;
+        for (const auto& t : terms) {
+            const int va = bodies[static_cast<std::size_t>(t.body_a)].var;
+            const int vb = bodies[static_cast<std::size_t>(t.body_b)].var;
+            if (va >= 0 && vb >= 0 && va != vb) out.emplace_back(std::min(va, vb), std::max(va, vb));
+        }
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+        return out;
+    }
+
+    /** J^T J und J^T r assemblieren. */
+    void assemble(BlockCholesky& chol, std::vector<double>& g, int* equations = nullptr) const {
+        chol.clear();
+        g.assign(vars.size() * 6, 0.0);
+        Row rows[kMaxRowsPerMate];
+        int m = 0;
+        for (const auto& t : terms) {
+            const int va = bodies[static_cast<std::size_t>(t.body_a)].var;
+            const int vb = bodies[static_cast<std::size_t>(t.body_b)].var;
+            if (va < 0 && vb < 0) continue;
+            const int n = evaluateMate((*mates)[t.mate], worldPose(t.body_a, vars), worldPose(t.body_b, vars), rows);
+            m += n;
+            Mat6 haa{}, hbb{}, hab{};
+            for (int k = 0; k < n; ++k) {
+                std::array<double, 6> ja{}, jb{};
+                if (va >= 0) ja = toVar(t.body_a, rows[k].ja, vars);
+                if (vb >= 0) jb = toVar(t.body_b, rows[k].jb, vars);
+                if (va >= 0 && va == vb) {
+                    for (int c = 0; c < 6; ++c) ja[static_cast<std::size_t>(c)] += jb[static_cast<std::size_t>(c)];
+                    jb.fill(0.0);
+                }
+                const double r = rows[k].r;
+                for (int i = 0; i < 6; ++i) {
+                    if (va >= 0) g[static_cast<std::size_t>(va) * 6 + static_cast<std::size_t>(i)] += ja[static_cast<std::size_t>(i)] * r;
+                    if (vb >= 0 && vb != va) g[static_cast<std::size_t>(vb) * 6 + static_cast<std::size_t>(i)] += jb[static_cast<std::size_t>(i)] * r;
+                    for (int c = 0; c < 6; ++c) {
+                        haa[static_cast<std::size_t>(i * 6 + c)] += ja[static_cast<std::size_t>(i)] * ja[static_cast<std::size_t>(c)];
+                        hbb[static_cast<std::size_t>(i * 6 + c)] += jb[static_cast<std::size_t>(i)] * jb[static_cast<std::size_t>(c)];
+                        hab[static_cast<std::size_t>(i * 6 + c)] += ja[static_cast<std::size_t>(i)] * jb[static_cast<std::size_t>(c)];
+                    }
+                }
+            }
+            if (va >= 0) {
+                Mat6& d = chol.diag(va);
+                for (int k = 0; k < 36; ++k) d[static_cast<std::size_t>(k)] += haa[static_cast<std::size_t>(k)];
+            }
+            if (vb >= 0 && vb != va) {
+                Mat6& d = chol.diag(vb);
+                for (int k = 0; k < 36; ++k) d[static_cast<std::size_t>(k)] += hbb[static_cast<std::size_t>(k)];
+                if (va >= 0) chol.addOff(va, vb, hab);
+            }
+        }
+        if (equations) *equations = m;
+    }
+
+    struct Stats {
+        bool converged{false};
+        int iterations{0};
+        double max_residual{0.0};
+    };
+
+    Stats solveLM(const MateSolverOptions& options) {
+        Stats stats;
+        if (vars.empty()) {
+            cost(vars, &stats.max_residual);
+            stats.converged = stats.max_residual <= options.tolerance;
+            return stats;
+        }
+        BlockCholesky chol;
+        chol.analyze(static_cast<int>(vars.size()), edges());
+        std::vector<double> g;
+        std::vector<double> step;
+        std::vector<Pose> trial(vars.size());
+        double max_abs = 0.0;
+        double current = cost(vars, &max_abs);
+        double lambda = 1e-4;
+        for (int it = 0; it < options.max_iterations; ++it) {
+            if (max_abs <= options.tolerance) {
+                break;
+            }
+            stats.iterations = it + 1;
+            assemble(chol, g);
+            chol.save();
+            bool improved = false;
+            while (lambda < 1e12) {
+                chol.restore();
+                for (std::size_t v = 0; v < vars.size(); ++v) {
+                    Mat6& d = chol.diag(static_cast<int>(v));
+                    for (int t = 0; t < 6; ++t) {
+                        double& e = d[static_cast<std::size_t>(t * 7)];
+                        e += lambda * e + 1e-9 * (1.0 + lambda);
+                    }
+                }
+                chol.factor(1e-14);
+                step = g;
+                chol.solve(step);
+                for (std::size_t v = 0; v < vars.size(); ++v) {
+                    const double* s = &step[v * 6];
+                    trial[v].p = vars[v].p - V3{s[0], s[1], s[2]};
+                    trial[v].q = normalized(multiply(quaternionFromRotationVector(-s[3], -s[4], -s[5]), vars[v].q));
+                }
+                double trial_max = 0.0;
+                const double next = cost(trial, &trial_max);
+                if (next < current) {
+                    const double decrease = current - next;
+                    vars.swap(trial);
+                    current = next;
+                    max_abs = trial_max;
+                    lambda = std::max(lambda / 3.0, 1e-12);
+                    improved = true;
+                    if (decrease <= 1e-15 * (1.0 + current)) {
+                        lambda = 1e12;  // stationär
+                    }
+                    break;
+                }
+                lambda *= 4.0;
+            }
+            if (!improved || lambda >= 1e12) {
+                // Stationärer Punkt: Ausgleichslösung, konvergiert nur bei verschwindendem Residuum
+                break;
+            }
+        }
+        stats.converged = max_abs <= options.tolerance;
+        stats.max_residual = max_abs;
+        return stats;
+    }
+
+    void writeBack() const {
+        for (std::size_t b = 0; b < bodies.size(); ++b) {
+            if (bodies[b].var >= 0) (*body_pose)[b] = worldPose(static_cast<int>(b), vars);
+        }
+    }
+};
+
+struct UnionFind {
+    std::vector<int> parent;
+    explicit UnionFind(std::size_t n) : parent(n) { std::iota(parent.begin(), parent.end(), 0); }
+    int find(int x) {
+        while (parent[static_cast<std::size_t>(x)] != x) {
+            parent[static_cast<std::size_t>(x)] = parent[static_cast<std::size_t>(parent[static_cast<std::size_t>(x)])];
+            x = parent[static_cast<std::size_t>(x)];
+        }
+        return x;
+    }
+    void unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a != b) parent[static_cast<std::size_t>(std::max(a, b))] = std::min(a, b);
+    }
+};
+
+/** Gültige Mates auf Körperindizes abbilden (Hash-Index statt linearer findComponent-Suche). */
+std::vector<Term> buildTerms(const std::vector<AssemblyComponent>& components,
+                             const std::vector<MateConstraint>& mates) {
+    std::unordered_map<std::uint64_t, int> index;
+    index.reserve(components.size());
+    for (std::size_t i = 0; i < components.size(); ++i) index.emplace(components[i].id, static_cast<int>(i));
+    std::vector<Term> terms;
+    terms.reserve(mates.size());
+    for (std::size_t m = 0; m < mates.size(); ++m) {
+        auto ia = index.find(mates[m].component_a);
+        auto ib = index.find(mates[m].component_b);
+        if (ia == index.end() || ib == index.end() || ia->second == ib->second) continue;
+        terms.push_back(Term{m, ia->second, ib->second});
+    }
+    return terms;
+}
+
+std::vector<Pose> posesOf(const std::vector<AssemblyComponent>& components) {
+    std::vector<Pose> poses(components.size());
+    for (std::size_t i = 0; i < components.size(); ++i) {
+        const Transform& t = components[i].transform;
+        poses[i] = Pose{V3{t.tx, t.ty, t.tz}, normalized(orientationOf(t))};
+    }
+    return poses;
+}
+
+/** Rang-Analyse ohne Gruppierung: jeder nicht fixierte, gematete Körper eine Variable. */
+void analyzeRank(const std::vector<AssemblyComponent>& components, const std::vector<MateConstraint>& mates,
+                 const std::vector<Term>& terms, std::vector<Pose>& poses, MateSolveReport& report) {
+    const std::size_t n = components.size();
+    report.degrees_of_freedom = n > 0 ? static_cast<int>(n - 1) * 6 : 0;
+    if (n == 0) return;
+    Problem problem;
+    problem.mates = &mates;
+    problem.body_pose = &poses;
+    problem.bodies.assign(n, BodyMap{});
+    problem.terms = terms;
+    std::vector<int> body_of_var;
+    for (const auto& t : terms) {
+        for (int b : {t.body_a, t.body_b}) {
+            if (b == 0 || problem.bodies[static_cast<std::size_t>(b)].var >= 0) continue;
+            problem.bodies[static_cast<std::size_t>(b)].var = static_cast<int>(problem.vars.size());
+            problem.vars.push_back(poses[static_cast<std::size_t>(b)]);
+            body_of_var.push_back(b);
+        }
+    }
+    std::set<std::uint64_t> under;
+    for (std::size_t b = 1; b < n; ++b) {
+        if (problem.bodies[b].var < 0) under.insert(components[b].id);  // ungematet: 6 DOF frei
+    }
+    if (!problem.vars.empty()) {
+        BlockCholesky chol;
+        chol.analyze(static_cast<int>(problem.vars.size()), problem.edges());
+        std::vector<double> g;
+        int equations = 0;
+        problem.assemble(chol, g, &equations);
+        const int zero = chol.factor(1e-9);
+        const int vars6 = static_cast<int>(problem.vars.size()) * 6;
+        const int rank = vars6 - zero;
+        report.equations = equations;
+        report.redundant_equations = std::max(0, equations - rank);
+        report.degrees_of_freedom = (static_cast<int>(n) - 1) * 6 - rank;
+        for (std::size_t v = 0; v < problem.vars.size(); ++v) {
+            for (int t = 0; t < 6; ++t) {
+                if (chol.isZeroPivot(static_cast<int>(v), t)) {
+                    under.insert(components[static_cast<std::size_t>(body_of_var[v])].id);
+                    break;
+                }
+            }
+        }
+    }
+    report.under_constrained_components.assign(under.begin(), under.end());
+
+    // Widersprüche: Mates, deren Residuum nicht verschwindet
+    Row rows[kMaxRowsPerMate];
+    std::set<std::size_t> conflicting;
+    double mx = 0.0;
+    for (const auto& t : terms) {
+        const int k = evaluateMate(mates[t.mate], poses[static_cast<std::size_t>(t.body_a)], poses[static_cast<std::size_t>(t.body_b)], rows);
+        for (int r = 0; r < k; ++r) {
+            mx = std::max(mx, std::abs(rows[r].r));
+            if (std::abs(rows[r].r) > 1e-6) conflicting.insert(t.mate);
+        }
+    }
+    report.max_residual = mx;
+    report.conflicting_mates.assign(conflicting.begin(), conflicting.end());
+}
+
+}  // namespace
+
+MateSolveReport MateSolver::analyze(const std::vector<AssemblyComponent>& components,
+                                    const std::vector<MateConstraint>& mates) {
+    MateSolveReport report;
+    std::vector<Pose> poses = posesOf(components);
+    analyzeRank(components, mates, buildTerms(components, mates), poses, report);
+    report.converged = report.conflicting_mates.empty();
+    return report;
+}
+
+MateSolveReport MateSolver::solve(std::vector<AssemblyComponent>& components,
+                                  const std::vector<MateConstraint>& mates,
+                                  const MateSolverOptions& options) {
+    const auto started = std::chrono::steady_clock::now();
+    MateSolveReport report;
+    const std::size_t n = components.size();
+    if (n == 0) {
+        report.converged = true;
+        return report;
+    }
+    std::vector<Pose> poses = posesOf(components);
+    const std::vector<Term> terms = buildTerms(components, mates);
+
+    // 1) Starre Teilgruppen: Mates eines Paares legen die Relativlage vollständig fest (Rang 6)
+    UnionFind groups(n);
+    if (options.detect_rigid_groups) {
+        std::unordered_map<std::uint64_t, Mat6> pair_h;
+        Row rows[kMaxRowsPerMate];
+        for (const auto& t : terms) {
+            const int a = std::min(t.body_a, t.body_b);
+            const int b = std::max(t.body_a, t.body_b);
+            const std::uint64_t key = (static_cast<std::uint64_t>(a) << 32) | static_cast<std::uint32_t>(b);
+            const int k = evaluateMate(mates[t.mate], poses[static_cast<std::size_t>(t.body_a)], poses[static_cast<std::size_t>(t.body_b)], rows);
+            Mat6& h = pair_h[key];
+            for (int r = 0; r < k; ++r)
+                for (int i = 0; i < 6; ++i)
+                    for (int c = 0; c < 6; ++c) h[static_cast<std::size_t>(i * 6 + c)] += rows[r].jb[static_cast<std::size_t>(i)] * rows[r].jb[static_cast<std::size_t>(c)];
+        }
+        for (const auto& [key, h] : pair_h) {
+            BlockCholesky single;
+            single.analyze(1, {});
+            single.diag(0) = h;
+            if (single.factor(1e-9) == 0) {
+                groups.unite(static_cast<int>(key >> 32), static_cast<int>(key & 0xffffffffu));
+            }
+        }
+    }
+    std::unordered_map<int, std::vector<int>> members;
+    for (std::size_t b = 0; b < n; ++b) members[groups.find(static_cast<int>(b))].push_back(static_cast<int>(b));
+
+    // 2) Gruppen intern lösen (Wurzel fixiert, parallel – Gruppen sind disjunkt)
+    std::vector<int> multi;
+    for (const auto& [root, list] : members) {
+        if (list.size() > 1) multi.push_back(root);
+    }
+    std::sort(multi.begin(), multi.end());
+    std::vector<std::vector<Term>> group_terms(multi.size());
+    {
+        std::unordered_map<int, std::size_t> slot;
+        for (std::size_t i = 0; i < multi.size(); ++i) slot.emplace(multi[i], i);
+        for (const auto& t : terms) {
+            const int ra = groups.find(t.body_a);
+            if (ra != groups.find(t.body_b)) continue;
+            auto it = slot.find(ra);
+            if (it != slot.end()) group_terms[it->second].push_back(t);
+        }
+    }
+    std::vector<Problem::Stats> group_stats(multi.size());
+    ThreadPool::shared().parallelFor(multi.size(), [&](std::size_t gi) {
+        const auto& list = members.at(multi[gi]);
+        Problem sub;
+        sub.mates = &mates;
+        sub.body_pose = &poses;
+        sub.bodies.assign(n, BodyMap{});
+        for (int b : list) {
+            if (b == list.front()) continue;  // Wurzel (kleinster Index; enthält ggf. fixierte Komponente 0)
+            sub.bodies[static_cast<std::size_t>(b)].var = static_cast<int>(sub.vars.size());
+            sub.vars.push_back(poses[static_cast<std::size_t>(b)]);
+        }
+        sub.terms = group_terms[gi];
+        MateSolverOptions inner = options;
+        inner.detect_rigid_groups = false;
+        group_stats[gi] = sub.solveLM(inner);
+        sub.writeBack();
+    });
+
+    // 3) Global: eine Variable je Gruppe (Pose der Wurzel), Gruppe mit Komponente 0 fixiert
+    Problem global;
+    global.mates = &mates;
+    global.body_pose = &poses;
+    global.bodies.assign(n, BodyMap{});
+    std::unordered_map<int, int> var_of_root;
+    for (const auto& t : terms) {
+        const int ra = groups.find(t.body_a);
+        const int rb = groups.find(t.body_b);
+        if (ra == rb) continue;
+        global.terms.push_back(t);
+        for (int r : {ra, rb}) {
+            if (r == groups.find(0) || var_of_root.count(r)) continue;
+            var_of_root.emplace(r, static_cast<int>(global.vars.size()));
+            global.vars.push_back(poses[static_cast<std::size_t>(r)]);
+        }
+    }
+    for (const auto& [root, var] : var_of_root) {
+        const Pose& rp = poses[static_cast<std::size_t>(root)];
+        const Quaternion inv = conjugate(rp.q);
+        for (int b : members.at(root)) {
+            BodyMap& m = global.bodies[static_cast<std::size_t>(b)];
+            m.var = var;
+            m.rel_p = rotate(inv, poses[static_cast<std::size_t>(b)].p - rp.p);
+            m.rel_q = normalized(multiply(inv, poses[static_cast<std::size_t>(b)].q));
+        }
+    }
+    const Problem::Stats stats = global.solveLM(options);
+    global.writeBack();
+
+    report.iterations = stats.iterations;
+    report.converged = stats.converged;
+    for (const auto& s : group_stats) {
+        report.converged = report.converged && s.converged;
+        report.iterations = std::max(report.iterations, s.iterations);
+    }
+    for (int root : multi) {
+        std::vector<std::uint64_t> ids;
+        for (int b : members.at(root)) ids.push_back(components[static_cast<std::size_t>(b)].id);
+        report.rigid_groups.push_back(std::move(ids));
+    }
+
+    // 4) Zurückschreiben (nur gematete Körper; Komponente 0 bleibt fixiert)
+    std::vector<char> touched(n, 0);
+    for (const auto& t : terms) {
+        touched[static_cast<std::size_t>(t.body_a)] = 1;
+        touched[static_cast<std::size_t>(t.body_b)] = 1;
+    }
+    for (std::size_t b = 1; b < n; ++b) {
+        if (!touched[b]) continue;
+        Transform& tr = components[b].transform;
+        tr.tx = poses[b].p.x;
+        tr.ty = poses[b].p.y;
+        tr.tz = poses[b].p.z;
+        setOrientation(tr, poses[b].q);
+    }
+
+    analyzeRank(components, mates, terms, poses, report);
+    report.solve_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    return report;
+}
+
+}  // namespace core
+}  // namespace cad
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+
+#include "Assembly.h"
+
+namespace cad {
+namespace core {
+
+struct MateSolverOptions {
+    int max_iterations{50};
+    /** Residuum-Toleranz (mm bzw. rad). */
+    double tolerance{1e-9};
+    /** Starr gekoppelte Paare (Rang 6) vorab als Gruppe lösen und global als ein Körper behandeln. */
+    bool detect_rigid_groups{true};
+};
+
+/**
+ * Globaler Mate-Solver (§13): jede Komponente ist ein 6-DOF-Starrkörper (Position + Quaternion).
+ * Pro Mate dünnbesetzte Residuen-Jacobi-Zeilen (nur die beiden beteiligten Körper), Levenberg-Marquardt
+ * auf den Normalgleichungen mit Block-Cholesky (6x6-Blöcke, Minimum-Degree-Ordnung). Die erste Komponente
+ * ist fixiert. Frame-Konvention: ebene Mates (Flush, Parallel, Tangent) nutzen die x-Achse von A als
+ * Normale, axiale Mates (Concentric, Insert, Angle, Gear, Cam) die z-Achse.
+ */
+class MateSolver {
+public:
+    /** Löst alle Mates und schreibt die Transformationen der gemateten Komponenten zurück. */
+    static MateSolveReport solve(std::vector<AssemblyComponent>& components,
+                                 const std::vector<MateConstraint>& mates,
+                                 const MateSolverOptions& options);
+    /** Nur Rang-/Residuen-Analyse bei den aktuellen Transformationen. */
+    static MateSolveReport analyze(const std::vector<AssemblyComponent>& components,
+                                   const std::vector<MateConstraint>& mates);
+};
+
+}  // namespace core
+}  // namespace cad
@@ -1,4 +1,5 @@
 #include "Modeler.h"
+#include "MateSolver.h"
 
 #include <utility>
 #include <cctype>
@@ -117,6 +118,7 @@ std::string Sketch::addPolygon(const std::vector<Point2D>& points) {
     entity.type = GeometryType::Polygon;
     entity.start_point = points.front();
     entity.end_point = points.size() > 1 ? points.back() : points.front();
+    entity.points = points;
     geometry_.push_back(entity);
     return entity.id;
 }
@@ -130,6 +132,7 @@ std::string Sketch::addSpline(const std::vector<Point2D>& control_points) {
     entity.type = GeometryType::Spline;
     entity.start_point = control_points.front();
     entity.end_point = control_points.size() > 1 ? control_points.back() : control_points.front();
+    entity.points = control_points;
     geometry_.push_back(entity);
     return entity.id;
 }
@@ -144,6 +147,15 @@ std::string Sketch::addText(const Point2D& position, const std::string& text) {
     return entity.id;
 }
 
+std::size_t Sketch::appendGeometry(std::vector<GeometryEntity> entities) {
+    geometry_.reserve(geometry_.size() + entities.size());
+    for (auto& entity : entities) {
+        entity.id = generateGeometryId();
+        geometry_.push_back(std::move(entity));
+    }
+    return entities.size();
+}
+
 const std::vector<GeometryEntity>& Sketch::geometry() const {
     return geometry_;
 }
@@ -732,19 +744,60 @@ bool Part::reorderFeature(std::size_t from_index, std::size_t to_index) {
     return true;
 }
 
-std::uint64_t Assembly::addComponent(const Part& part, const Transform& transform) {
+std::uint64_t Assembly::addComponent(const PartRef& part, const Transform& transform, std::uint64_t parent_id) {
+    const std::size_t parent_slot = parent_id != 0 ? slotOf(parent_id) : components_.size();
+    if (parent_id != 0 && parent_slot >= components_.size()) {
+        return 0;
+    }
     AssemblyComponent component;
     component.id = next_id_++;
     component.part = part;
     component.transform = transform;
-    components_.push_back(component);
-    return component.id;
+    component.parent_id = parent_id;
+    const std::size_t slot = components_.size();
+    components_.push_back(std::move(component));
+    slot_by_id_[components_.back().id] = slot;
+    child_slots_.emplace_back();
+    if (parent_id != 0) {
+        child_slots_[parent_slot].push_back(slot);
+    }
+    world_.tx.push_back(0.0);
+    world_.ty.push_back(0.0);
+    world_.tz.push_back(0.0);
+    world_.qw.push_back(1.0);
+    world_.qx.push_back(0.0);
+    world_.qy.push_back(0.0);
+    world_.qz.push_back(0.0);
+    world_dirty_.push_back(1);
+    return components_.back().id;
+}
+
+std::uint64_t Assembly::addInstance(std::uint64_t source_component_id, const Transform& transform) {
+    const std::size_t slot = slotOf(source_component_id);
+    if (slot >= components_.size()) {
+        return 0;
+    }
+    PartRef definition = components_[slot].part;
+    return addComponent(definition, transform);
 }
 
 const std::vector<AssemblyComponent>& Assembly::components() const {
     return components_;
 }
 
+Part* Assembly::editComponentPart(std::uint64_t component_id) {
+    const std::size_t slot = slotOf(component_id);
+    return slot < components_.size() ? &components_[slot].part.edit() : nullptr;
+}
+
+std::size_t Assembly::uniquePartDefinitionCount() const {
+    std::set<const Part*> definitions;
+    for (const auto& component : components_) {
+        definitions.insert(&component.part.get());
+    }
+    return definitions.size();
+}
+
 void Assembly::addMate(const MateConstraint& mate) {
     mates_.push_back(mate);
 }
@@ -853,183 +906,175 @@ std::string Assembly::createCam(std::uint64_t component_a, std::uint64_t compone
     return "Cam_" + std::to_string(mates_.size());
 }
 
+std::vector<AssemblyComponent> Assembly::worldComponents() const {
+    worldTransforms();
+    std::vector<AssemblyComponent> world = components_;
+    for (auto& component : world) {
+        component.transform = worldTransform(component.id);
+    }
+    return world;
+}
+
 bool Assembly::solveMates() {
-    const int max_iterations = 10;
-    const double tolerance = 0.001;
-    
-    for (int iteration = 0; iteration < max_iterations; ++iteration) {
-        bool converged = true;
-        
-        for (const auto& mate : mates_) {
-            AssemblyComponent* comp_a = findComponent(mate.component_a);
-            AssemblyComponent* comp_b = findComponent(mate.component_b);
-            
-            if (!comp_a || !comp_b) {
-                continue;
-            }
-            
-            double error = 0.0;
-            
-            switch (mate.type) {
-                case MateType::Mate: {
-                    double dx = comp_b->transform.tx - (comp_a->transform.tx + mate.value);
-                    double dy = comp_b->transform.ty - comp_a->transform.ty;
-                    double dz = comp_b->transform.tz - comp_a->transform.tz;
-                    error = std::sqrt(dx*dx + dy*dy + dz*dz);
-                    
-                    if (error > tolerance) {
-                        comp_b->transform.tx = comp_a->transform.tx + mate.value;
-                        comp_b->transform.ty = comp_a->transform.ty;
-                        comp_b->transform.tz = comp_a->transform.tz;
-                        converged = false;
-                    }
-                    break;
-                }
-                case MateType::Flush: {
-                    double dx = comp_b->transform.tx - (comp_a->transform.tx + mate.value);
-                    error = std::abs(dx);
-                    
-                    if (error > tolerance) {
-                        comp_b->transform.tx = comp_a->transform.tx + mate.value;
-                        converged = false;
-                    }
-                    break;
-                }
-                case MateType::Angle: {
-                    double angle_diff = comp_b->transform.rz - (comp_a->transform.rz + mate.value);
-                    while (angle_diff > M_PI) angle_diff -= 2.0 * M_PI;
-                    while (angle_diff < -M_PI) angle_diff += 2.0 * M_PI;
-                    error = std::abs(angle_diff);
-                    
-                    if (error > tolerance) {
-                        comp_b->transform.rz = comp_a->transform.rz + mate.value;
-                        converged = false;
-                    }
-                    break;
-                }
-                case MateType::Insert: {
-                    double dx = comp_b->transform.tx - comp_a->transform.tx;
-                    double dy = comp_b->transform.ty - comp_a->transform.ty;
-                    double dz = comp_b->transform.tz - comp_a->transform.tz;
-                    error = std::sqrt(dx*dx + dy*dy + dz*dz);
-                    
-                    if (error > tolerance) {
-                        comp_b->transform.tx = comp_a->transform.tx;
-                        comp_b->transform.ty = comp_a->transform.ty;
-                        comp_b->transform.tz = comp_a->transform.tz;
-                        converged = false;
-                    }
-                    break;
-                }
-                case MateType::Concentric: {
-                    double dx = comp_b->transform.tx - (comp_a->transform.tx + mate.value);
-                    double dy = comp_b->transform.ty - comp_a->transform.ty;
-                    double dz = comp_b->transform.tz - comp_a->transform.tz;
-                    error = std::sqrt(dx*dx + dy*dy + dz*dz);
-                    if (error > tolerance) {
-                        comp_b->transform.tx = comp_a->transform.tx + mate.value;
-                        comp_b->transform.ty = comp_a->transform.ty;
-                        comp_b->transform.tz = comp_a->transform.tz;
-                        converged = false;
-                    }
-                    break;
-                }
-                case MateType::Tangent: {
-                    double dx = comp_b->transform.tx - (comp_a->transform.tx + mate.value);
-                    error = std::abs(dx);
-                    if (error > tolerance) {
-                        comp_b->transform.tx = comp_a->transform.tx + mate.value;
-                        converged = false;
-                    }
-                    break;
-                }
-                case MateType::Gear: {
-                    // Kinematik: comp_b.rz = comp_a.rz * ratio (value = ratio)
-                    double target_rz = comp_a->transform.rz * mate.value;
-                    double angle_diff = comp_b->transform.rz - target_rz;
-                    while (angle_diff > M_PI) angle_diff -= 2.0 * M_PI;
-                    while (angle_diff < -M_PI) angle_diff += 2.0 * M_PI;
-                    error = std::abs(angle_diff);
-                    if (error > tolerance) {
-                        comp_b->transform.rz = target_rz;
-                        converged = false;
-                    }
-                    break;
-                }
-                case MateType::Cam: {
-                    // Phasenversatz: comp_b.rz = comp_a.rz + mate.value
-                    double target_rz = comp_a->transform.rz + mate.value;
-                    double angle_diff = comp_b->transform.rz - target_rz;
-                    while (angle_diff > M_PI) angle_diff -= 2.0 * M_PI;
-                    while (angle_diff < -M_PI) angle_diff += 2.0 * M_PI;
-                    error = std::abs(angle_diff);
-                    if (error > tolerance) {
-                        comp_b->transform.rz = target_rz;
-                        converged = false;
-                    }
-                    break;
-                }
-                case MateType::Parallel: {
-                    // Ebenen/Achsen parallel: angle alignment, value = optional distance
-                    double angle_diff = comp_b->transform.rz - comp_a->transform.rz;
-                    while (angle_diff > M_PI) angle_diff -= 2.0 * M_PI;
-                    while (angle_diff < -M_PI) angle_diff += 2.0 * M_PI;
-                    error = std::abs(angle_diff);
-                    if (error > tolerance) {
-                        comp_b->transform.rz = comp_a->transform.rz;
-                        converged = false;
-                    }
-                    if (std::abs(mate.value) > 1e-9) {
-                        double dx = comp_b->transform.tx - (comp_a->transform.tx + mate.value);
-                        if (std::abs(dx) > tolerance) {
-                            comp_b->transform.tx = comp_a->transform.tx + mate.value;
-                            converged = false;
-                        }
-                    }
-                    break;
-                }
-                case MateType::Distance: {
-                    double dx = comp_b->transform.tx - comp_a->transform.tx;
-                    double dy = comp_b->transform.ty - comp_a->transform.ty;
-                    double dz = comp_b->transform.tz - comp_a->transform.tz;
-                    double actual = std::sqrt(dx*dx + dy*dy + dz*dz);
-                    error = std::abs(actual - mate.value);
-                    if (error > tolerance && actual > 1e-9) {
-                        double scale = mate.value / actual;
-                        comp_b->transform.tx = comp_a->transform.tx + dx * scale;
-                        comp_b->transform.ty = comp_a->transform.ty + dy * scale;
-                        comp_b->transform.tz = comp_a->transform.tz + dz * scale;
-                        converged = false;
-                    }
-                    break;
-                }
-            }
+    // Mates gelten zwischen Weltlagen: auf Weltkopie lösen, dann relativ zum (ggf. ebenfalls bewegten) Eltern-Teil
+    std::vector<AssemblyComponent> world = worldComponents();
+    const std::vector<AssemblyComponent> before = world;
+    last_solve_report_ = MateSolver::solve(world, mates_, MateSolverOptions{});
+    auto moved = [&](std::size_t slot) {
+        const Transform& a = before[slot].transform;
+        const Transform& b = world[slot].transform;
+        return a.tx != b.tx || a.ty != b.ty || a.tz != b.tz || a.rotation.w != b.rotation.w ||
+               a.rotation.x != b.rotation.x || a.rotation.y != b.rotation.y || a.rotation.z != b.rotation.z ||
+               a.rx != b.rx || a.ry != b.ry || a.rz != b.rz;
+    };
+    for (std::size_t slot = 0; slot < components_.size(); ++slot) {
+        if (!moved(slot)) {
+            continue;
         }
-        
-        if (converged) {
-            return true;
+        const std::uint64_t parent = components_[slot].parent_id;
+        components_[slot].transform =
+            parent != 0 ? compose(inverse(world[slotOf(parent)].transform), world[slot].transform) : world[slot].transform;
+        markSubtreeDirty(slot);
+    }
+    return last_solve_report_.converged;
+}
+
+MateSolveReport Assembly::analyzeMates() const {
+    return MateSolver::analyze(worldComponents(), mates_);
+}
+
+std::size_t Assembly::slotOf(std::uint64_t id) const {
+    auto it = slot_by_id_.find(id);
+    return it != slot_by_id_.end() ? it->second : components_.size();
+}
+
+AssemblyComponent* Assembly::findComponent(std::uint64_t id) {
+    const std::size_t slot = slotOf(id);
+    if (slot >= components_.size()) {
+        return nullptr;
+    }
+    return &components_[slot];
+}
+
+const AssemblyComponent* Assembly::findComponent(std::uint64_t id) const {
+    const std::size_t slot = slotOf(id);
+    return slot < components_.size() ? &components_[slot] : nullptr;
+}
+
+bool Assembly::setComponentTransform(std::uint64_t component_id, const Transform& transform) {
+    const std::size_t slot = slotOf(component_id);
+    if (slot >= components_.size()) {
+        return false;
+    }
+    components_[slot].transform = transform;
+    markSubtreeDirty(slot);
+    return true;
+}
+
+bool Assembly::setComponentParent(std::uint64_t component_id, std::uint64_t parent_id) {
+    const std::size_t slot = slotOf(component_id);
+    if (slot >= components_.size()) {
+        return false;
+    }
+    std::size_t parent_slot = components_.size();
+    if (parent_id != 0) {
+        parent_slot = slotOf(parent_id);
+        if (parent_slot >= components_.size()) {
+            return false;
+        }
+        // Zyklus: neuer Elternteil darf nicht im eigenen Teilbaum liegen
+        for (std::size_t s = parent_slot; s < components_.size();
+             s = components_[s].parent_id != 0 ? slotOf(components_[s].parent_id) : components_.size()) {
+            if (s == slot) {
+                return false;
+            }
         }
     }
-    
+    AssemblyComponent& component = components_[slot];
+    if (component.parent_id != 0) {
+        auto& siblings = child_slots_[slotOf(component.parent_id)];
+        siblings.erase(std::remove(siblings.begin(), siblings.end(), slot), siblings.end());
+    }
+    component.parent_id = parent_id;
+    if (parent_id != 0) {
+        child_slots_[parent_slot].push_back(slot);
+    }
+    markSubtreeDirty(slot);
     return true;
 }
 
-AssemblyComponent* Assembly::findComponent(std::uint64_t id) {
-    for (auto& component : components_) {
-        if (component.id == id) {
-            return &component;
+std::vector<std::uint64_t> Assembly::childComponents(std::uint64_t component_id) const {
+    std::vector<std::uint64_t> ids;
+    const std::size_t slot = slotOf(component_id);
+    if (slot < components_.size()) {
+        for (std::size_t child : child_slots_[slot]) {
+            ids.push_back(components_[child].id);
         }
     }
-    return nullptr;
+    return ids;
 }
 
-const AssemblyComponent* Assembly::findComponent(std::uint64_t id) const {
-    for (const auto& component : components_) {
-        if (component.id == id) {
-            return &component;
+void Assembly::markSubtreeDirty(std::size_t slot) {
+    std::vector<std::size_t> stack{slot};
+    while (!stack.empty()) {
+        const std::size_t s = stack.back();
+        stack.pop_back();
+        if (world_dirty_[s]) {
+            continue;  // Nachfahren sind bereits dirty (Invariante)
         }
+        world_dirty_[s] = 1;
+        stack.insert(stack.end(), child_slots_[s].begin(), child_slots_[s].end());
     }
-    return nullptr;
+}
+
+void Assembly::updateWorldTransform(std::size_t slot) const {
+    if (!world_dirty_[slot]) {
+        return;
+    }
+    const AssemblyComponent& component = components_[slot];
+    Transform world = component.transform;
+    if (component.parent_id != 0) {
+        const std::size_t parent_slot = slotOf(component.parent_id);
+        updateWorldTransform(parent_slot);
+        Transform parent;
+        parent.tx = world_.tx[parent_slot];
+        parent.ty = world_.ty[parent_slot];
+        parent.tz = world_.tz[parent_slot];
+        parent.rotation = Quaternion{world_.qw[parent_slot], world_.qx[parent_slot],
+                                     world_.qy[parent_slot], world_.qz[parent_slot]};
+        world = compose(parent, component.transform);
+    }
+    const Quaternion q = orientationOf(world);
+    world_.tx[slot] = world.tx;
+    world_.ty[slot] = world.ty;
+    world_.tz[slot] = world.tz;
+    world_.qw[slot] = q.w;
+    world_.qx[slot] = q.x;
+    world_.qy[slot] = q.y;
+    world_.qz[slot] = q.z;
+    world_dirty_[slot] = 0;
+    ++world_recomputations_;
+}
+
+Transform Assembly::worldTransform(std::uint64_t component_id) const {
+    const std::size_t slot = slotOf(component_id);
+    if (slot >= components_.size()) {
+        return Transform{};
+    }
+    updateWorldTransform(slot);
+    Transform out;
+    out.tx = world_.tx[slot];
+    out.ty = world_.ty[slot];
+    out.tz = world_.tz[slot];
+    setOrientation(out, Quaternion{world_.qw[slot], world_.qx[slot], world_.qy[slot], world_.qz[slot]});
+    return out;
+}
+
+const WorldTransformArrays& Assembly::worldTransforms() const {
+    for (std::size_t slot = 0; slot < components_.size(); ++slot) {
+        updateWorldTransform(slot);
+    }
+    return world_;
 }
 
 void Assembly::addJoint(const Joint& joint) {
@@ -1171,11 +1216,10 @@ bool Assembly::hasExplosionOffsets() const {
 }
 
 Transform Assembly::getDisplayTransform(std::uint64_t component_id) const {
-    const AssemblyComponent* comp = findComponent(component_id);
-    if (!comp) {
+    if (!findComponent(component_id)) {
         return Transform{};
     }
-    Transform out = comp->transform;
+    Transform out = worldTransform(component_id);
     Vector3D off = getExplosionOffset(component_id);
     out.tx += off.x * explosion_factor_;
     out.ty += off.y * explosion_factor_;
@@ -1189,9 +1233,9 @@ void Assembly::setComponentLightweight(std::uint64_t component_id, bool lightwei
     } else {
         lightweight_components_.erase(component_id);
     }
-    AssemblyComponent* comp = findComponent(component_id);
-    if (comp) {
-        comp->lightweight_display = lightweight;
+    const std::size_t slot = slotOf(component_id);
+    if (slot < components_.size()) {
+        components_[slot].lightweight_display = lightweight;
     }
 }
 
@@ -1205,9 +1249,9 @@ void Assembly::setComponentFlexible(std::uint64_t component_id, bool flexible) {
     } else {
         flexible_components_.erase(component_id);
     }
-    AssemblyComponent* comp = findComponent(component_id);
-    if (comp) {
-        comp->flexible_subassembly = flexible;
+    const std::size_t slot = slotOf(component_id);
+    if (slot < components_.size()) {
+        components_[slot].flexible_subassembly = flexible;
     }
 }
 
@@ -1267,53 +1311,15 @@ bool Assembly::validateMates() const {
 }
 
 int Assembly::getDegreesOfFreedom() const {
-    int component_count = static_cast<int>(components_.size());
-    int total_dof = component_count * 6;
-    
-    int constraint_dof = 0;
-    for (const auto& mate : mates_) {
-        switch (mate.type) {
-            case MateType::Mate:
-                constraint_dof += 3;
-                break;
-            case MateType::Flush:
-            case MateType::Tangent:
-                constraint_dof += 1;
-                break;
-            case MateType::Concentric:
-                constraint_dof += 4;
-                break;
-            case MateType::Angle:
-                constraint_dof += 1;
-                break;
-            case MateType::Insert:
-                constraint_dof += 5;
-                break;
-            case MateType::Gear:
-            case MateType::Cam:
-                constraint_dof += 1;
-                break;
-            case MateType::Parallel:
-                constraint_dof += 2;
-                break;
-            case MateType::Distance:
-                constraint_dof += 1;
-                break;
-        }
-    }
-    
-    return total_dof - constraint_dof;
+    return analyzeMates().degrees_of_freedom;
 }
 
 bool Assembly::isOverConstrained() const {
-    int dof = getDegreesOfFreedom();
-    return dof < 0;
+    return analyzeMates().redundant_equations > 0;
 }
 
 bool Assembly::isUnderConstrained() const {
-    int dof = getDegreesOfFreedom();
-    int component_count = static_cast<int>(components_.size());
-    return dof > component_count * 3 && component_count > 1;
+    return analyzeMates().degrees_of_freedom > 0 && components_.size() > 1;
 }
 
 Part Modeler::createPart(const Sketch& sketch) const {
@@ -1473,6 +1479,65 @@ bool evaluateCondition(const std::string& expression,
     }
 }
 
+/** Feature-Maß per Feldname setzen; unbekannte Felder landen in Feature::parameters. */
+void setFeatureDimension(Feature& feature, const std::string& field, double value) {
+    static const std::unordered_map<std::string, double Feature::*> kDoubles = {
+        {"depth", &Feature::depth},
+        {"thin_thickness", &Feature::thin_thickness},
+        {"angle", &Feature::angle},
+        {"diameter", &Feature::diameter},
+        {"hole_depth", &Feature::hole_depth},
+        {"radius", &Feature::radius},
+        {"spacing_x", &Feature::spacing_x},
+        {"spacing_y", &Feature::spacing_y},
+        {"spacing_z", &Feature::spacing_z},
+        {"circular_angle", &Feature::circular_angle},
+        {"twist_angle", &Feature::twist_angle},
+        {"scale_factor", &Feature::scale_factor},
+        {"pitch", &Feature::pitch},
+        {"revolutions", &Feature::revolutions},
+        {"wall_thickness", &Feature::wall_thickness},
+        {"draft_angle", &Feature::draft_angle},
+        {"thread_pitch", &Feature::thread_pitch},
+        {"rib_thickness", &Feature::rib_thickness},
+    };
+    static const std::unordered_map<std::string, int Feature::*> kInts = {
+        {"count_x", &Feature::count_x},
+        {"count_y", &Feature::count_y},
+        {"count_z", &Feature::count_z},
+        {"circular_count", &Feature::circular_count},
+        {"path_count", &Feature::path_count},
+    };
+    static const std::unordered_map<std::string, bool Feature::*> kBools = {
+        {"suppressed", &Feature::suppressed},
+        {"symmetric", &Feature::symmetric},
+        {"thin_wall", &Feature::thin_wall},
+        {"through_all", &Feature::through_all},
+    };
+    if (auto it = kDoubles.find(field); it != kDoubles.end()) {
+        feature.*(it->second) = value;
+    } else if (auto it_i = kInts.find(field); it_i != kInts.end()) {
+        feature.*(it_i->second) = static_cast<int>(std::lround(value));
+    } else if (auto it_b = kBools.find(field); it_b != kBools.end()) {
+        feature.*(it_b->second) = (value != 0.0);
+    } else {
+        feature.parameters[field] = value;
+    }
+}
+
+bool applyFeatureOverride(Part& part, const std::string& key, double value) {
+    const std::size_t dot = key.rfind('.');
+    if (dot == std::string::npos || dot == 0 || dot + 1 == key.size()) {
+        return false;
+    }
+    Feature* feature = part.findFeature(key.substr(0, dot));
+    if (!feature) {
+        return false;
+    }
+    setFeatureDimension(*feature, key.substr(dot + 1), value);
+    return true;
+}
+
 }  // namespace
 
 bool Modeler::evaluateParameters(Sketch& sketch) const {
@@ -1523,6 +1588,7 @@ bool Modeler::evaluatePartRules(Part& part) const {
     for (const auto& p : part.userParameters()) {
         symbols[p.name] = p.value;
     }
+    bool all_ok = true;
     bool any_applied = false;
     for (const auto& rule : part.rules()) {
         if (rule.condition_expression.empty() || rule.then_parameter.empty()) {
@@ -1530,23 +1596,57 @@ bool Modeler::evaluatePartRules(Part& part) const {
         }
         bool cond = false;
         if (!evaluateCondition(rule.condition_expression, symbols, cond)) {
+            all_ok = false;
             continue;
         }
         if (!cond) {
             continue;
         }
         double value = 0.0;
-        if (!evaluateExpression(rule.then_value_expression.empty() ? "0" : rule.then_value_expression, symbols, value)) {
+        if (!evaluateExpression(rule.then_value_expression.empty() ? "0" : rule.then_value_expression, symbols, value) ||
+            !part.setParameterValue(rule.then_parameter, value)) {
+            all_ok = false;
             continue;
         }
-        part.setParameterValue(rule.then_parameter, value);
         symbols[rule.then_parameter] = value;
         any_applied = true;
     }
-    if (any_applied) {
-        evaluatePartParameters(part);
+    if (any_applied && !evaluatePartParameters(part)) {
+        all_ok = false;
     }
-    return true;
+    return all_ok;
+}
+
+bool Modeler::applyConfiguration(Part& part, const Configuration& config) const {
+    bool all_ok = true;
+    std::vector<std::pair<std::string, double>> feature_overrides;
+    for (const auto& [key, value] : config.parameter_overrides) {
+        if (Parameter* p = part.findParameter(key)) {
+            p->value = value;
+            p->expression.clear();
+        } else if (key.find('.') != std::string::npos) {
+            feature_overrides.emplace_back(key, value);
+        } else {
+            all_ok = false;  // Tippfehler im Tabellenkopf nicht still als neuen Parameter anlegen
+        }
+    }
+    if (!evaluatePartParameters(part)) {
+        all_ok = false;
+    }
+    if (!evaluatePartRules(part)) {
+        all_ok = false;
+    }
+    for (const auto& p : part.userParameters()) {
+        if (p.name.find('.') != std::string::npos) {
+            applyFeatureOverride(part, p.name, p.value);
+        }
+    }
+    for (const auto& [key, value] : feature_overrides) {
+        if (!applyFeatureOverride(part, key, value)) {
+            all_ok = false;
+        }
+    }
+    return all_ok;
 }
 
 bool Modeler::solveConstraints(Sketch& sketch) const {
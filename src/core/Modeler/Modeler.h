@@ -15,7 +15,15 @@ public:
     bool validateSketch(const Sketch& sketch) const;
     bool evaluateParameters(Sketch& sketch) const;
     bool evaluatePartParameters(Part& part) const;
+    /** Wendet erfüllte Regeln an; false, wenn eine Regel nicht auswertbar ist oder ihr Parameter fehlt. */
     bool evaluatePartRules(Part& part) const;
+    /**
+     * Konfiguration (§19.6) anwenden: Overrides setzen Benutzerparameter (Ausdruck wird übersteuert)
+     * oder direkt Feature-Maße über "Feature.feld" (z.B. "Extrude1.depth", "Hole1.suppressed").
+     * Benutzerparameter mit Punkt-Namen steuern ebenso Feature-Maße. false bei unbekanntem Parameter
+     * oder Feature sowie fehlgeschlagener Parameter- oder Regelauswertung.
+     */
+    bool applyConfiguration(Part& part, const Configuration& config) const;
     bool solveConstraints(Sketch& sketch) const;
     
     // Constraint validation
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include "Part.h"
+
+namespace cad {
+namespace core {
+
+/**
+ * Geteilte Part-Definition (Flyweight, vgl. Inventor/SolidWorks: eine Datei, viele Vorkommen).
+ * Komponenten referenzieren dieselbe unveränderliche Definition; Kopien kosten nur einen
+ * Referenzzähler. Änderungen im Kontext der Baugruppe laufen über edit() (Copy-on-Write):
+ * ist die Definition geteilt, wird sie vorher für diese Referenz geklont.
+ */
+class PartRef {
+public:
+    PartRef() : def_(emptyDefinition()) {}
+    PartRef(const Part& part) : def_(std::make_shared<Part>(part)) {}
+    PartRef(Part&& part) : def_(std::make_shared<Part>(std::move(part))) {}
+    explicit PartRef(std::shared_ptr<Part> definition)
+        : def_(definition ? std::move(definition) : emptyDefinition()) {}
+
+    PartRef& operator=(const Part& part) {
+        def_ = std::make_shared<Part>(part);
+        return *this;
+    }
+
+    const Part& get() const { return *def_; }
+    const Part& operator*() const { return *def_; }
+    const Part* operator->() const { return def_.get(); }
+    operator const Part&() const { return *def_; }
+
+    /** Copy-on-Write: liefert eine nur von dieser Referenz genutzte, änderbare Definition. */
+    Part& edit() {
+        if (def_.use_count() != 1) {
+            def_ = std::make_shared<Part>(*def_);
+        }
+        return *def_;
+    }
+
+    std::shared_ptr<const Part> shared() const { return def_; }
+    bool sharesWith(const PartRef& other) const { return def_ == other.def_; }
+    long useCount() const { return def_.use_count(); }
+
+private:
+    /** Gemeinsame leere Definition für default-konstruierte Komponenten (use_count > 1 → edit() klont). */
+    static const std::shared_ptr<Part>& emptyDefinition() {
+        static const std::shared_ptr<Part> empty = std::make_shared<Part>(Part("Part"));
+        return empty;
+    }
+
+    std::shared_ptr<Part> def_;
+};
+
+}  // namespace core
+}  // namespace cad
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 #include "ReferenceGeometry.h"
@@ -66,6 +67,7 @@ struct GeometryEntity {
     double width{0.0};       // rectangle width; ellipse minor radius
     double height{0.0};
     std::string text_content;  // for Text entity
+    std::vector<Point2D> points;  // polygon vertices (closed: last == first); spline control points
 };
 
 class Sketch {
@@ -89,6 +91,8 @@ public:
     std::string addPolygon(const std::vector<Point2D>& points);
     std::string addSpline(const std::vector<Point2D>& control_points);
     std::string addText(const Point2D& position, const std::string& text);
+    /** Massenimport (z.B. DXF): vergibt die Ids und hängt alle Elemente in einem Schritt an. */
+    std::size_t appendGeometry(std::vector<GeometryEntity> entities);
 
     const std::vector<GeometryEntity>& geometry() const;
     GeometryEntity* findGeometry(const std::string& id);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cmath>
+
 namespace cad {
 namespace core {
 
@@ -20,12 +22,133 @@ struct Transform {
     double rz{0.0};
 };
 
+inline Quaternion multiply(const Quaternion& a, const Quaternion& b) {
+    return Quaternion{a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+                      a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                      a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                      a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w};
+}
+
+inline Quaternion conjugate(const Quaternion& q) {
+    return Quaternion{q.w, -q.x, -q.y, -q.z};
+}
+
+inline Quaternion normalized(const Quaternion& q) {
+    const double n = std::sqrt(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
+    if (n < 1e-300) {
+        return Quaternion{};
+    }
+    return Quaternion{q.w / n, q.x / n, q.y / n, q.z / n};
+}
+
+inline bool isIdentity(const Quaternion& q) {
+    return q.w == 1.0 && q.x == 0.0 && q.y == 0.0 && q.z == 0.0;
+}
+
+/** Drehvektor (Achse * Winkel, rad) → Quaternion. */
+inline Quaternion quaternionFromRotationVector(double vx, double vy, double vz) {
+    const double angle = std::sqrt(vx * vx + vy * vy + vz * vz);
+    if (angle < 1e-12) {
+        return normalized(Quaternion{1.0, 0.5 * vx, 0.5 * vy, 0.5 * vz});
+    }
+    const double s = std::sin(0.5 * angle) / angle;
+    return Quaternion{std::cos(0.5 * angle), vx * s, vy * s, vz * s};
+}
+
+/** Euler-Winkel (rad), R = Rz(rz) * Ry(ry) * Rx(rx). */
+inline Quaternion quaternionFromEuler(double rx, double ry, double rz) {
+    const double cx = std::cos(0.5 * rx), sx = std::sin(0.5 * rx);
+    const double cy = std::cos(0.5 * ry), sy = std::sin(0.5 * ry);
+    const double cz = std::cos(0.5 * rz), sz = std::sin(0.5 * rz);
+    return Quaternion{cz * cy * cx + sz * sy * sx,
+                      cz * cy * sx - sz * sy * cx,
+                      cz * sy * cx + sz * cy * sx,
+                      sz * cy * cx - cz * sy * sx};
+}
+
+inline void eulerFromQuaternion(const Quaternion& q, double& rx, double& ry, double& rz) {
+    rx = std::atan2(2.0 * (q.w * q.x + q.y * q.z), 1.0 - 2.0 * (q.x * q.x + q.y * q.y));
+    const double s = 2.0 * (q.w * q.y - q.z * q.x);
+    ry = std::abs(s) >= 1.0 ? std::copysign(1.57079632679489661923, s) : std::asin(s);
+    rz = std::atan2(2.0 * (q.w * q.z + q.x * q.y), 1.0 - 2.0 * (q.y * q.y + q.z * q.z));
+}
+
+/** Effektive Orientierung: Quaternion, falls gesetzt; sonst aus den (Legacy-)Euler-Winkeln rx/ry/rz. */
+inline Quaternion orientationOf(const Transform& t) {
+    if (!isIdentity(t.rotation)) {
+        return t.rotation;
+    }
+    if (t.rx == 0.0 && t.ry == 0.0 && t.rz == 0.0) {
+        return Quaternion{};
+    }
+    return quaternionFromEuler(t.rx, t.ry, t.rz);
+}
+
+/** Rotation aus orthonormaler Basis (Bilder der Achsen = Spalten der Drehmatrix). */
+inline Quaternion quaternionFromBasis(const double x[3], const double y[3], const double z[3]) {
+    const double trace = x[0] + y[1] + z[2];
+    if (trace > 0.0) {
+        const double s = 2.0 * std::sqrt(trace + 1.0);
+        return Quaternion{0.25 * s, (y[2] - z[1]) / s, (z[0] - x[2]) / s, (x[1] - y[0]) / s};
+    }
+    if (x[0] > y[1] && x[0] > z[2]) {
+        const double s = 2.0 * std::sqrt(1.0 + x[0] - y[1] - z[2]);
+        return Quaternion{(y[2] - z[1]) / s, 0.25 * s, (y[0] + x[1]) / s, (z[0] + x[2]) / s};
+    }
+    if (y[1] > z[2]) {
+        const double s = 2.0 * std::sqrt(1.0 + y[1] - x[0] - z[2]);
+        return Quaternion{(z[0] - x[2]) / s, (y[0] + x[1]) / s, 0.25 * s, (z[1] + y[2]) / s};
+    }
+    const double s = 2.0 * std::sqrt(1.0 + z[2] - x[0] - y[1]);
+    return Quaternion{(x[1] - y[0]) / s, (z[0] + x[2]) / s, (z[1] + y[2]) / s, 0.25 * s};
+}
+
+/** Setzt Quaternion und Euler-Winkel konsistent. */
+inline void setOrientation(Transform& t, const Quaternion& q) {
+    t.rotation = normalized(q);
+    eulerFromQuaternion(t.rotation, t.rx, t.ry, t.rz);
+}
+
+/** v' = q * v * q^-1 (in place). */
+inline void rotateVector(const Quaternion& q, double& vx, double& vy, double& vz) {
+    // t = 2 * cross(q.xyz, v); v' = v + w * t + cross(q.xyz, t)
+    const double tx = 2.0 * (q.y * vz - q.z * vy);
+    const double ty = 2.0 * (q.z * vx - q.x * vz);
+    const double tz = 2.0 * (q.x * vy - q.y * vx);
+    const double ox = vx + q.w * tx + (q.y * tz - q.z * ty);
+    const double oy = vy + q.w * ty + (q.z * tx - q.x * tz);
+    const double oz = vz + q.w * tz + (q.x * ty - q.y * tx);
+    vx = ox;
+    vy = oy;
+    vz = oz;
+}
+
+/**
+ * Verkettung Eltern → Kind: out = a ∘ b (b ist relativ zu a angegeben).
+ * Rotation q = qa * qb, Translation t = ta + qa * tb.
+ */
 inline Transform compose(const Transform& a, const Transform& b) {
+    const Quaternion qa = orientationOf(a);
+    double x = b.tx, y = b.ty, z = b.tz;
+    rotateVector(qa, x, y, z);
+    Transform out;
+    out.tx = a.tx + x;
+    out.ty = a.ty + y;
+    out.tz = a.tz + z;
+    setOrientation(out, multiply(qa, orientationOf(b)));
+    return out;
+}
+
+/** Inverse: compose(t, inverse(t)) = Identität. */
+inline Transform inverse(const Transform& t) {
+    const Quaternion qi = conjugate(normalized(orientationOf(t)));
+    double x = -t.tx, y = -t.ty, z = -t.tz;
+    rotateVector(qi, x, y, z);
     Transform out;
-    out.tx = a.tx + b.tx;
-    out.ty = a.ty + b.ty;
-    out.tz = a.tz + b.tz;
-    out.rotation = a.rotation;
+    out.tx = x;
+    out.ty = y;
+    out.tz = z;
+    setOrientation(out, qi);
     return out;
 }
 
@@ -1,12 +1,42 @@
 #include "InterferenceChecker.h"
 #include "Modeler/Part.h"
+#include "parallel/ThreadPool.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
 #include <sstream>
+#include <unordered_map>
+#include <utility>
 
 namespace cad {
 namespace core {
 
+namespace {
+
+/** Obergrenze gesammelter Kontaktsegmente je Paar (Hervorhebung, keine Vollständigkeit nötig). */
+constexpr std::size_t kMaxContactSegments = 1024;
+
+/** Geschlossener Quader als 12 Dreiecke (Normalen nach außen). */
+TriangleMesh boxMesh(const BoundingBox& box) {
+    TriangleMesh mesh;
+    for (int corner = 0; corner < 8; ++corner) {
+        mesh.vertices.push_back((corner & 1) ? box.max_x : box.min_x);
+        mesh.vertices.push_back((corner & 2) ? box.max_y : box.min_y);
+        mesh.vertices.push_back((corner & 4) ? box.max_z : box.min_z);
+    }
+    mesh.indices = {0, 2, 1, 1, 2, 3,   // z min
+                    4, 5, 6, 5, 7, 6,   // z max
+                    0, 1, 4, 1, 5, 4,   // y min
+                    2, 6, 3, 3, 6, 7,   // y max
+                    0, 4, 2, 2, 4, 6,   // x min
+                    1, 3, 5, 3, 7, 5};  // x max
+    return mesh;
+}
+
+}  // namespace
+
 InterferenceResult InterferenceChecker::check(const std::string& assembly_id) const {
     InterferenceResult result;
     if (assembly_id.empty()) {
@@ -25,6 +55,25 @@ CollisionDetectionMode InterferenceChecker::detectionMode() const {
     return detection_mode_;
 }
 
+void InterferenceChecker::setMeshProvider(MeshProvider provider) {
+    mesh_provider_ = std::move(provider);
+}
+
+void InterferenceChecker::setVolumeSubdivisionDepth(int depth) {
+    volume_depth_ = std::max(0, std::min(depth, 10));
+}
+
+std::shared_ptr<const TriangleBvh> InterferenceChecker::buildPartBvh(const Part& part) const {
+    TriangleMesh mesh;
+    if (mesh_provider_ && mesh_provider_(part, mesh)) {
+        auto bvh = std::make_shared<const TriangleBvh>(mesh);
+        if (!bvh->empty()) {
+            return bvh;
+        }
+    }
+    return std::make_shared<const TriangleBvh>(boxMesh(estimateBoundingBoxFromFeatures(part, Transform{})));
+}
+
 InterferenceResult InterferenceChecker::checkAssembly(const Assembly& assembly) const {
     InterferenceResult result;
     result.has_interference = false;
@@ -36,60 +85,203 @@ InterferenceResult InterferenceChecker::checkAssembly(const Assembly& assembly)
         return result;
     }
     
-    // Calculate bounding boxes for all components based on detection mode
+    const std::vector<InterferenceProxy> proxies =
+        makeProxies(assembly, detection_mode_ == CollisionDetectionMode::Precise);
     std::vector<BoundingBox> boxes;
-    boxes.reserve(components.size());
-    for (const auto& component : components) {
-        if (detection_mode_ == CollisionDetectionMode::FeatureBased) {
-            boxes.push_back(estimateBoundingBoxFromFeatures(component.part, component.transform));
-        } else {
-            boxes.push_back(estimateBoundingBox(component.part, component.transform));
+    boxes.reserve(proxies.size());
+    for (const auto& proxy : proxies) {
+        boxes.push_back(proxy.box);
+    }
+
+    // Broad Phase: nur überlappende Boxen werden Kandidaten
+    const std::vector<std::pair<std::size_t, std::size_t>> candidates = overlappingPairs(boxes);
+    result.candidate_pairs = candidates.size();
+
+    // Narrow Phase parallel in Blöcken; Ergebnisse in Kandidatenreihenfolge (i, j) übernehmen
+    const bool precise = detection_mode_ == CollisionDetectionMode::Precise;
+    std::vector<char> collides(candidates.size(), 0);
+    std::vector<double> volumes(candidates.size(), 0.0);
+    std::vector<std::vector<ContactSegment>> contacts(precise ? candidates.size() : 0);
+    constexpr std::size_t kChunk = 256;
+    const std::size_t chunks = (candidates.size() + kChunk - 1) / kChunk;
+    ThreadPool::shared().parallelFor(chunks, [&](std::size_t chunk) {
+        const std::size_t end = std::min(candidates.size(), (chunk + 1) * kChunk);
+        for (std::size_t c = chunk * kChunk; c < end; ++c) {
+            collides[c] = testPair(proxies[candidates[c].first], proxies[candidates[c].second], volumes[c],
+                                   precise ? &contacts[c] : nullptr) ? 1 : 0;
         }
+    });
+
+    for (std::size_t c = 0; c < candidates.size(); ++c) {
+        if (!collides[c]) {
+            continue;
+        }
+        const std::size_t i = candidates[c].first;
+        const std::size_t j = candidates[c].second;
+        InterferencePair pair;
+        pair.component_a_id = components[i].id;
+        pair.component_b_id = components[j].id;
+        pair.part_a_name = components[i].part->name();
+        pair.part_b_name = components[j].part->name();
+        pair.overlap_volume = volumes[c];
+        if (precise) {
+            pair.contact_curves = std::move(contacts[c]);
+        }
+        result.interference_pairs.push_back(pair);
     }
-    
-    // Check all pairs for overlaps
-    for (std::size_t i = 0; i < components.size(); ++i) {
-        for (std::size_t j = i + 1; j < components.size(); ++j) {
-            bool has_collision = false;
-            
-            if (detection_mode_ == CollisionDetectionMode::Precise) {
-                // Use precise geometry-based collision check
-                has_collision = checkPreciseCollision(
-                    components[i].part, components[i].transform,
-                    components[j].part, components[j].transform);
-            } else if (detection_mode_ == CollisionDetectionMode::FeatureBased) {
-                // Use feature-based collision check
-                has_collision = checkFeatureCollision(
-                    components[i].part, components[i].transform,
-                    components[j].part, components[j].transform);
-            } else {
-                // Use bounding box overlap check
-                has_collision = boxesOverlap(boxes[i], boxes[j]);
+    describe(result);
+    return result;
+}
+
+ClearancePair InterferenceChecker::minimumDistance(const Assembly& assembly, std::uint64_t component_a,
+                                                   std::uint64_t component_b) const {
+    return minimumDistance(assembly, std::vector<std::uint64_t>{component_a}, std::vector<std::uint64_t>{component_b});
+}
+
+ClearancePair InterferenceChecker::minimumDistance(const Assembly& assembly, const std::vector<std::uint64_t>& group_a,
+                                                   const std::vector<std::uint64_t>& group_b) const {
+    ClearancePair best;
+    best.distance = std::numeric_limits<double>::infinity();
+
+    // Nur die beteiligten Definitionen vernetzen (geteilte Definitionen einmal)
+    assembly.worldTransforms();
+    std::unordered_map<const Part*, std::shared_ptr<const TriangleBvh>> bvhs;
+    auto collect = [&](const std::vector<std::uint64_t>& ids) {
+        std::vector<InterferenceProxy> proxies;
+        for (std::uint64_t id : ids) {
+            const AssemblyComponent* component = assembly.findComponent(id);
+            if (!component) {
+                continue;
             }
-            
-            if (has_collision) {
-                InterferencePair pair;
-                pair.component_a_id = components[i].id;
-                pair.component_b_id = components[j].id;
-                pair.part_a_name = components[i].part.name();
-                pair.part_b_name = components[j].part.name();
-                
-                if (detection_mode_ == CollisionDetectionMode::Precise) {
-                    // Calculate precise intersection volume
-                    pair.overlap_volume = calculateIntersectionVolume(
-                        components[i].part, components[i].transform,
-                        components[j].part, components[j].transform);
-                } else {
-                    pair.overlap_volume = calculateOverlapVolume(boxes[i], boxes[j]);
-                }
-                
-                result.interference_pairs.push_back(pair);
-                result.overlap_count++;
-                result.has_interference = true;
+            InterferenceProxy proxy;
+            proxy.component_id = id;
+            proxy.part = component->part.shared();
+            auto it = bvhs.find(proxy.part.get());
+            if (it == bvhs.end()) {
+                it = bvhs.emplace(proxy.part.get(), buildPartBvh(*proxy.part)).first;
             }
+            proxy.mesh = it->second;
+            proxy.local_box = proxy.mesh->bounds();
+            placeProxy(proxy, assembly.worldTransform(id));
+            proxies.push_back(std::move(proxy));
+        }
+        return proxies;
+    };
+    const std::vector<InterferenceProxy> proxies_a = collect(group_a);
+    const std::vector<InterferenceProxy> proxies_b = collect(group_b);
+
+    // Komponentenpaare nach Box-Abstand (Untergrenze) → Branch-and-Bound auch über die Paare
+    struct Candidate {
+        std::size_t a;
+        std::size_t b;
+        double bound;
+    };
+    std::vector<Candidate> candidates;
+    for (std::size_t i = 0; i < proxies_a.size(); ++i) {
+        for (std::size_t j = 0; j < proxies_b.size(); ++j) {
+            if (proxies_a[i].component_id == proxies_b[j].component_id) {
+                continue;
+            }
+            const BoundingBox& a = proxies_a[i].box;
+            const BoundingBox& b = proxies_b[j].box;
+            const double gx = std::max({0.0, b.min_x - a.max_x, a.min_x - b.max_x});
+            const double gy = std::max({0.0, b.min_y - a.max_y, a.min_y - b.max_y});
+            const double gz = std::max({0.0, b.min_z - a.max_z, a.min_z - b.max_z});
+            candidates.push_back(Candidate{i, j, std::sqrt(gx * gx + gy * gy + gz * gz)});
         }
     }
-    
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate& x, const Candidate& y) { return x.bound < y.bound; });
+
+    for (const Candidate& candidate : candidates) {
+        if (candidate.bound >= best.distance) {
+            break;
+        }
+        const InterferenceProxy& a = proxies_a[candidate.a];
+        const InterferenceProxy& b = proxies_b[candidate.b];
+        double distance = 0.0;
+        Point3D point_a;
+        Point3D point_b;
+        if (TriangleBvh::closestPoints(*a.mesh, a.frame, *b.mesh, b.frame, best.distance, distance, point_a, point_b)) {
+            best.component_a_id = a.component_id;
+            best.component_b_id = b.component_id;
+            best.part_a_name = a.part->name();
+            best.part_b_name = b.part->name();
+            best.distance = distance;
+            best.point_a = point_a;
+            best.point_b = point_b;
+        }
+    }
+    return best;
+}
+
+ClearanceReport InterferenceChecker::checkClearance(const Assembly& assembly, double threshold) const {
+    ClearanceReport report;
+    report.threshold = threshold;
+    if (assembly.components().size() < 2) {
+        report.message = "Assembly has fewer than 2 components";
+        return report;
+    }
+
+    // Broad Phase: Boxen je Seite um threshold/2 vergrößert → Überlappung, wenn Lücke < threshold
+    const std::vector<InterferenceProxy> proxies = makeProxies(assembly, true);
+    const double margin = 0.5 * std::max(0.0, threshold);
+    std::vector<BoundingBox> boxes;
+    boxes.reserve(proxies.size());
+    for (const auto& proxy : proxies) {
+        BoundingBox box = proxy.box;
+        box.min_x -= margin;
+        box.min_y -= margin;
+        box.min_z -= margin;
+        box.max_x += margin;
+        box.max_y += margin;
+        box.max_z += margin;
+        boxes.push_back(box);
+    }
+    const std::vector<std::pair<std::size_t, std::size_t>> candidates = overlappingPairs(boxes);
+    report.candidate_pairs = candidates.size();
+
+    std::vector<char> close(candidates.size(), 0);
+    std::vector<ClearancePair> measured(candidates.size());
+    constexpr std::size_t kChunk = 64;
+    const std::size_t chunks = (candidates.size() + kChunk - 1) / kChunk;
+    ThreadPool::shared().parallelFor(chunks, [&](std::size_t chunk) {
+        const std::size_t end = std::min(candidates.size(), (chunk + 1) * kChunk);
+        for (std::size_t c = chunk * kChunk; c < end; ++c) {
+            const InterferenceProxy& a = proxies[candidates[c].first];
+            const InterferenceProxy& b = proxies[candidates[c].second];
+            ClearancePair& pair = measured[c];
+            close[c] = TriangleBvh::closestPoints(*a.mesh, a.frame, *b.mesh, b.frame, threshold, pair.distance,
+                                                  pair.point_a, pair.point_b) ? 1 : 0;
+        }
+    });
+
+    for (std::size_t c = 0; c < candidates.size(); ++c) {
+        if (!close[c]) {
+            continue;
+        }
+        ClearancePair& pair = measured[c];
+        pair.component_a_id = proxies[candidates[c].first].component_id;
+        pair.component_b_id = proxies[candidates[c].second].component_id;
+        pair.part_a_name = proxies[candidates[c].first].part->name();
+        pair.part_b_name = proxies[candidates[c].second].part->name();
+        report.pairs.push_back(std::move(pair));
+    }
+
+    std::ostringstream oss;
+    if (report.pairs.empty()) {
+        oss << "All clearances >= " << threshold << " mm";
+    } else {
+        oss << report.pairs.size() << " pair(s) closer than " << threshold << " mm";
+    }
+    report.message = oss.str();
+    return report;
+}
+
+void InterferenceChecker::describe(InterferenceResult& result) {
+    result.overlap_count = static_cast<int>(result.interference_pairs.size());
+    result.has_interference = result.overlap_count > 0;
+
     // Build message
     if (result.has_interference) {
         std::ostringstream oss;
@@ -102,8 +294,145 @@ InterferenceResult InterferenceChecker::checkAssembly(const Assembly& assembly)
     } else {
         result.message = "No interference detected";
     }
-    
-    return result;
+}
+
+std::vector<InterferenceProxy> InterferenceChecker::makeProxies(const Assembly& assembly, bool meshes) const {
+    const auto& components = assembly.components();
+
+    // Die Boxen verschieben sich nur mit der Lage, daher einmal je geteilter Part-Definition
+    // schätzen. Feature-/Precise-Modus prüfen zuerst die Feature-Boxen → diese dienen als
+    // Broad-Phase-Boxen. Mit Netzen: je Definition ein Dreiecks-BVH (parallel aufgebaut).
+    const bool feature_boxes = detection_mode_ != CollisionDetectionMode::BoundingBox;
+    std::unordered_map<const Part*, std::size_t> definition_slots;
+    std::vector<std::shared_ptr<const Part>> definitions;
+    std::vector<std::size_t> definition_of(components.size());
+    for (std::size_t i = 0; i < components.size(); ++i) {
+        const Part& part = components[i].part;
+        auto inserted = definition_slots.emplace(&part, definitions.size());
+        if (inserted.second) {
+            definitions.push_back(components[i].part.shared());
+        }
+        definition_of[i] = inserted.first->second;
+    }
+
+    std::vector<BoundingBox> local_boxes(definitions.size());
+    std::vector<std::shared_ptr<const TriangleBvh>> bvhs(meshes ? definitions.size() : 0);
+    if (meshes) {
+        ThreadPool::shared().parallelFor(definitions.size(), [&](std::size_t d) {
+            bvhs[d] = buildPartBvh(*definitions[d]);
+            local_boxes[d] = bvhs[d]->bounds();
+        });
+    } else {
+        for (std::size_t d = 0; d < definitions.size(); ++d) {
+            local_boxes[d] = feature_boxes ? estimateBoundingBoxFromFeatures(*definitions[d], Transform{})
+                                           : estimateBoundingBox(*definitions[d], Transform{});
+        }
+    }
+
+    // Welt-Lagen einmal aktualisieren; danach nur noch lesender (thread-sicherer) Zugriff
+    assembly.worldTransforms();
+    std::vector<InterferenceProxy> proxies(components.size());
+    for (std::size_t i = 0; i < components.size(); ++i) {
+        InterferenceProxy& proxy = proxies[i];
+        proxy.component_id = components[i].id;
+        proxy.part = definitions[definition_of[i]];
+        if (meshes) {
+            proxy.mesh = bvhs[definition_of[i]];
+        }
+        proxy.local_box = local_boxes[definition_of[i]];
+        placeProxy(proxy, assembly.worldTransform(components[i].id));
+    }
+    return proxies;
+}
+
+void InterferenceChecker::placeProxy(InterferenceProxy& proxy, const Transform& world) const {
+    proxy.transform = world;
+    BoundingBox box = proxy.local_box;
+    if (proxy.mesh) {
+        proxy.frame = RigidFrame::fromTransform(world);
+        const double local_min[3] = {box.min_x, box.min_y, box.min_z};
+        const double local_max[3] = {box.max_x, box.max_y, box.max_z};
+        double world_min[3];
+        double world_max[3];
+        proxy.frame.applyBox(local_min, local_max, world_min, world_max);
+        box = BoundingBox{world_min[0], world_min[1], world_min[2], world_max[0], world_max[1], world_max[2]};
+    } else {
+        box.min_x += world.tx;
+        box.max_x += world.tx;
+        box.min_y += world.ty;
+        box.max_y += world.ty;
+        box.min_z += world.tz;
+        box.max_z += world.tz;
+    }
+    proxy.box = box;
+}
+
+bool InterferenceChecker::testPair(const InterferenceProxy& a, const InterferenceProxy& b, double& volume,
+                                   std::vector<ContactSegment>* contacts) const {
+    volume = 0.0;
+    if (detection_mode_ == CollisionDetectionMode::Precise) {
+        // Durchdringung der Oberflächen oder (bei vollständigem Einschluss) echtes Schnittvolumen
+        const bool crossing = TriangleBvh::intersect(*a.mesh, a.frame, *b.mesh, b.frame, contacts, kMaxContactSegments);
+        volume = TriangleBvh::overlapVolume(*a.mesh, a.frame, *b.mesh, b.frame, volume_depth_);
+        return crossing || volume > 0.0;
+    }
+    bool has_collision = true;  // BoundingBox: Box-Überlappung bereits in der Broad Phase geprüft
+    if (detection_mode_ == CollisionDetectionMode::FeatureBased) {
+        has_collision = checkFeatureCollision(*a.part, a.transform, *b.part, b.transform);
+    }
+    if (has_collision) {
+        volume = calculateOverlapVolume(a.box, b.box);
+    }
+    return has_collision;
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> InterferenceChecker::overlappingPairs(
+    const std::vector<BoundingBox>& boxes) {
+    std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    if (boxes.size() < 2) {
+        return pairs;
+    }
+
+    // Sweep-Achse: größte Varianz der Box-Mittelpunkte (trennt am besten)
+    double mean[3] = {0.0, 0.0, 0.0};
+    double sq[3] = {0.0, 0.0, 0.0};
+    for (const auto& b : boxes) {
+        const double c[3] = {b.min_x + b.max_x, b.min_y + b.max_y, b.min_z + b.max_z};
+        for (int k = 0; k < 3; ++k) {
+            mean[k] += c[k];
+            sq[k] += c[k] * c[k];
+        }
+    }
+    const double n = static_cast<double>(boxes.size());
+    int axis = 0;
+    double best = -1.0;
+    for (int k = 0; k < 3; ++k) {
+        const double variance = sq[k] / n - (mean[k] / n) * (mean[k] / n);
+        if (variance > best) {
+            best = variance;
+            axis = k;
+        }
+    }
+    auto lo = [axis](const BoundingBox& b) { return axis == 0 ? b.min_x : (axis == 1 ? b.min_y : b.min_z); };
+    auto hi = [axis](const BoundingBox& b) { return axis == 0 ? b.max_x : (axis == 1 ? b.max_y : b.max_z); };
+
+    std::vector<std::size_t> order(boxes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return lo(boxes[a]) < lo(boxes[b]); });
+
+    for (std::size_t s = 0; s < order.size(); ++s) {
+        const BoundingBox& a = boxes[order[s]];
+        const double a_hi = hi(a);
+        for (std::size_t t = s + 1; t < order.size() && lo(boxes[order[t]]) <= a_hi; ++t) {
+            const BoundingBox& b = boxes[order[t]];
+            if (a.min_x <= b.max_x && a.max_x >= b.min_x && a.min_y <= b.max_y && a.max_y >= b.min_y &&
+                a.min_z <= b.max_z && a.max_z >= b.min_z) {
+                pairs.emplace_back(std::min(order[s], order[t]), std::max(order[s], order[t]));
+            }
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
 }
 
 BoundingBox InterferenceChecker::estimateBoundingBox(const Part& part, const Transform& transform) const {
@@ -239,71 +568,6 @@ bool InterferenceChecker::checkFeatureCollision(const Part& part_a, const Transf
     return true;
 }
 
-bool InterferenceChecker::checkPreciseCollision(const Part& part_a, const Transform& transform_a,
-                                                 const Part& part_b, const Transform& transform_b) const {
-    
-    // First check bounding box overlap
-    BoundingBox box_a = estimateBoundingBoxFromFeatures(part_a, transform_a);
-    BoundingBox box_b = estimateBoundingBoxFromFeatures(part_b, transform_b);
-    
-    if (!boxesOverlap(box_a, box_b)) {
-        return false;
-    }
-    
-    // Check feature-based geometry intersection
-    const auto& features_a = part_a.features();
-    const auto& features_b = part_b.features();
-    
-    // For each feature in part_a, check intersection with features in part_b
-    for (const auto& feat_a : features_a) {
-        for (const auto& feat_b : features_b) {
-            // Extrude features: check if extrusions intersect
-            if (feat_a.type == FeatureType::Extrude && feat_b.type == FeatureType::Extrude) {
-                // Simplified: check if bounding boxes of extrusions overlap significantly
-                double overlap_vol = calculateOverlapVolume(box_a, box_b);
-                double volume_a = (box_a.max_x - box_a.min_x) * (box_a.max_y - box_a.min_y) * (box_a.max_z - box_a.min_z);
-                double volume_b = (box_b.max_x - box_b.min_x) * (box_b.max_y - box_b.min_y) * (box_b.max_z - box_b.min_z);
-                double min_volume = std::min(volume_a, volume_b);
-                
-                // If overlap is significant (>10% of smaller volume), consider it a collision
-                if (overlap_vol > min_volume * 0.1) {
-                    return true;
-                }
-            }
-            
-            // Holes don't cause interference (they remove material)
-            if (feat_a.type == FeatureType::Hole || feat_b.type == FeatureType::Hole) {
-                continue;
-            }
-        }
-    }
-    
-    // If we get here and boxes overlap, it's a potential collision
-    return true;
-}
-
-double InterferenceChecker::calculateIntersectionVolume(const Part& part_a, const Transform& transform_a,
-                                                         const Part& part_b, const Transform& transform_b) const {
-    // Calculate precise intersection volume
-    BoundingBox box_a = estimateBoundingBoxFromFeatures(part_a, transform_a);
-    BoundingBox box_b = estimateBoundingBoxFromFeatures(part_b, transform_b);
-    
-    if (!boxesOverlap(box_a, box_b)) {
-        return 0.0;
-    }
-    
-    // Calculate intersection box
-    double min_x = std::max(box_a.min_x, box_b.min_x);
-    double max_x = std::min(box_a.max_x, box_b.max_x);
-    double min_y = std::max(box_a.min_y, box_b.min_y);
-    double max_y = std::min(box_a.max_y, box_b.max_y);
-    double min_z = std::max(box_a.min_z, box_b.min_z);
-    double max_z = std::min(box_a.max_z, box_b.max_z);
-    
-    double volume = (max_x - min_x) * (max_y - min_y) * (max_z - min_z);
-    return volume;
-}
-
 bool InterferenceChecker::boxesOverlap(const BoundingBox& a, const BoundingBox& b) const {
     // Check if boxes overlap in all three dimensions
     bool x_overlap = (a.min_x <= b.max_x) && (a.max_x >= b.min_x);
@@ -331,5 +595,275 @@ double InterferenceChecker::calculateOverlapVolume(const BoundingBox& a, const B
     return overlap_x * overlap_y * overlap_z;
 }
 
+InterferenceSession::InterferenceSession(InterferenceChecker checker) : checker_(std::move(checker)) {}
+
+const InterferenceResult& InterferenceSession::begin(const Assembly& assembly) {
+    proxies_ = checker_.makeProxies(assembly, checker_.detectionMode() == CollisionDetectionMode::Precise);
+    index_of_.clear();
+    grid_.clear();
+    oversized_.clear();
+    pairs_.clear();
+    partners_.assign(proxies_.size(), {});
+    for (std::size_t i = 0; i < proxies_.size(); ++i) {
+        index_of_[proxies_[i].component_id] = static_cast<std::uint32_t>(i);
+    }
+
+    // Rasterweite = Median der größten Box-Ausdehnung → typische Box überdeckt höchstens 2 Zellen je Achse
+    std::vector<double> extents;
+    extents.reserve(proxies_.size());
+    for (const auto& proxy : proxies_) {
+        const BoundingBox& b = proxy.box;
+        extents.push_back(std::max({b.max_x - b.min_x, b.max_y - b.min_y, b.max_z - b.min_z}));
+    }
+    cell_size_ = 1.0;
+    if (!extents.empty()) {
+        std::nth_element(extents.begin(), extents.begin() + static_cast<std::ptrdiff_t>(extents.size() / 2), extents.end());
+        cell_size_ = std::max(1e-6, extents[extents.size() / 2]);
+    }
+    for (std::size_t i = 0; i < proxies_.size(); ++i) {
+        insertProxy(static_cast<std::uint32_t>(i));
+    }
+
+    // Erstprüfung wie checkAssembly per Sweep-and-Prune
+    std::vector<BoundingBox> boxes;
+    boxes.reserve(proxies_.size());
+    for (const auto& proxy : proxies_) {
+        boxes.push_back(proxy.box);
+    }
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> candidates;
+    for (const auto& pair : InterferenceChecker::overlappingPairs(boxes)) {
+        candidates.emplace_back(static_cast<std::uint32_t>(pair.first), static_cast<std::uint32_t>(pair.second));
+    }
+    testCandidates(candidates);
+    rebuildResult(candidates.size());
+    if (proxies_.size() < 2) {
+        result_.message = "Assembly has fewer than 2 components";
+    }
+    return result_;
+}
+
+const InterferenceResult& InterferenceSession::update(const Assembly& assembly,
+                                                      const std::vector<std::uint64_t>& moved_ids) {
+    const auto& components = assembly.components();
+    if (components.size() != proxies_.size()) {
+        return begin(assembly);
+    }
+    // Auch unbewegte Komponenten können eine neue Definition erhalten haben (editComponentPart klont)
+    for (std::size_t i = 0; i < components.size(); ++i) {
+        if (&components[i].part.get() != proxies_[i].part.get()) {
+            return begin(assembly);
+        }
+    }
+
+    // Bewegte Komponenten samt Unterkomponenten (Lage relativ zum Eltern-Teil)
+    std::vector<char> moved(proxies_.size(), 0);
+    std::vector<std::uint32_t> moved_list;
+    std::vector<std::uint64_t> pending(moved_ids.begin(), moved_ids.end());
+    while (!pending.empty()) {
+        const std::uint64_t id = pending.back();
+        pending.pop_back();
+        auto it = index_of_.find(id);
+        if (it == index_of_.end() || components[it->second].id != id) {
+            return begin(assembly);  // Struktur geändert
+        }
+        if (moved[it->second]) {
+            continue;
+        }
+        moved[it->second] = 1;
+        moved_list.push_back(it->second);
+        for (std::uint64_t child : assembly.childComponents(id)) {
+            pending.push_back(child);
+        }
+    }
+
+    assembly.worldTransforms();
+    for (std::uint32_t i : moved_list) {
+        removeProxy(i);
+        checker_.placeProxy(proxies_[i], assembly.worldTransform(proxies_[i].component_id));
+        insertProxy(i);
+    }
+
+    // Alte Ergebnisse bewegter Komponenten verwerfen; Paare unbewegter Komponenten bleiben gültig
+    for (std::uint32_t i : moved_list) {
+        for (std::uint32_t j : partners_[i]) {
+            pairs_.erase((static_cast<std::uint64_t>(std::min(i, j)) << 32) | std::max(i, j));
+            auto& others = partners_[j];
+            others.erase(std::remove(others.begin(), others.end(), i), others.end());
+        }
+        partners_[i].clear();
+    }
+
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> candidates;
+    for (std::uint32_t i : moved_list) {
+        collectCandidates(i, moved, candidates);
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    testCandidates(candidates);
+    rebuildResult(candidates.size());
+    return result_;
+}
+
+std::uint64_t InterferenceSession::cellKey(std::int64_t x, std::int64_t y, std::int64_t z) const {
+    // 21 Bit je Achse; Überläufe erzeugen nur zusätzliche Kandidaten (Box-Test filtert)
+    constexpr std::uint64_t kMask = (1u << 21) - 1u;
+    return ((static_cast<std::uint64_t>(x) & kMask) << 42) | ((static_cast<std::uint64_t>(y) & kMask) << 21) |
+           (static_cast<std::uint64_t>(z) & kMask);
+}
+
+bool InterferenceSession::cellRange(const BoundingBox& box, std::int64_t lo[3], std::int64_t hi[3]) const {
+    constexpr double kMaxCells = 64.0;
+    const double min[3] = {box.min_x, box.min_y, box.min_z};
+    const double max[3] = {box.max_x, box.max_y, box.max_z};
+    double cells = 1.0;
+    for (int axis = 0; axis < 3; ++axis) {
+        const double first = std::floor(min[axis] / cell_size_);
+        const double last = std::floor(max[axis] / cell_size_);
+        cells *= last - first + 1.0;
+        if (!(cells <= kMaxCells)) {
+            return false;
+        }
+        lo[axis] = static_cast<std::int64_t>(first);
+        hi[axis] = static_cast<std::int64_t>(last);
+    }
+    return true;
+}
+
+void InterferenceSession::insertProxy(std::uint32_t index) {
+    std::int64_t lo[3];
+    std::int64_t hi[3];
+    if (!cellRange(proxies_[index].box, lo, hi)) {
+        oversized_.push_back(index);
+        return;
+    }
+    for (std::int64_t x = lo[0]; x <= hi[0]; ++x) {
+        for (std::int64_t y = lo[1]; y <= hi[1]; ++y) {
+            for (std::int64_t z = lo[2]; z <= hi[2]; ++z) {
+                grid_[cellKey(x, y, z)].push_back(index);
+            }
+        }
+    }
+}
+
+void InterferenceSession::removeProxy(std::uint32_t index) {
+    std::int64_t lo[3];
+    std::int64_t hi[3];
+    if (!cellRange(proxies_[index].box, lo, hi)) {
+        oversized_.erase(std::remove(oversized_.begin(), oversized_.end(), index), oversized_.end());
+        return;
+    }
+    for (std::int64_t x = lo[0]; x <= hi[0]; ++x) {
+        for (std::int64_t y = lo[1]; y <= hi[1]; ++y) {
+            for (std::int64_t z = lo[2]; z <= hi[2]; ++z) {
+                auto it = grid_.find(cellKey(x, y, z));
+                if (it == grid_.end()) {
+                    continue;
+                }
+                auto& cell = it->second;
+                auto pos = std::find(cell.begin(), cell.end(), index);
+                if (pos != cell.end()) {
+                    *pos = cell.back();
+                    cell.pop_back();
+                }
+                if (cell.empty()) {
+                    grid_.erase(it);
+                }
+            }
+        }
+    }
+}
+
+void InterferenceSession::collectCandidates(std::uint32_t index, const std::vector<char>& moved,
+                                            std::vector<std::pair<std::uint32_t, std::uint32_t>>& candidates) const {
+    const BoundingBox& a = proxies_[index].box;
+    auto consider = [&](std::uint32_t other) {
+        // Paar zweier bewegter Komponenten nur einmal (vom kleineren Index aus)
+        if (other == index || (moved[other] && other < index)) {
+            return;
+        }
+        const BoundingBox& b = proxies_[other].box;
+        if (a.min_x <= b.max_x && a.max_x >= b.min_x && a.min_y <= b.max_y && a.max_y >= b.min_y &&
+            a.min_z <= b.max_z && a.max_z >= b.min_z) {
+            candidates.emplace_back(std::min(index, other), std::max(index, other));
+        }
+    };
+
+    std::int64_t lo[3];
+    std::int64_t hi[3];
+    if (!cellRange(a, lo, hi)) {
+        for (std::uint32_t other = 0; other < proxies_.size(); ++other) {
+            consider(other);
+        }
+        return;
+    }
+    for (std::int64_t x = lo[0]; x <= hi[0]; ++x) {
+        for (std::int64_t y = lo[1]; y <= hi[1]; ++y) {
+            for (std::int64_t z = lo[2]; z <= hi[2]; ++z) {
+                auto it = grid_.find(cellKey(x, y, z));
+                if (it != grid_.end()) {
+                    for (std::uint32_t other : it->second) {
+                        consider(other);
+                    }
+                }
+            }
+        }
+    }
+    for (std::uint32_t other : oversized_) {
+        consider(other);
+    }
+}
+
+void InterferenceSession::testCandidates(const std::vector<std::pair<std::uint32_t, std::uint32_t>>& candidates) {
+    const bool precise = checker_.detectionMode() == CollisionDetectionMode::Precise;
+    std::vector<char> collides(candidates.size(), 0);
+    std::vector<PairState> states(candidates.size());
+    constexpr std::size_t kChunk = 256;
+    const std::size_t chunks = (candidates.size() + kChunk - 1) / kChunk;
+    ThreadPool::shared().parallelFor(chunks, [&](std::size_t chunk) {
+        const std::size_t end = std::min(candidates.size(), (chunk + 1) * kChunk);
+        for (std::size_t c = chunk * kChunk; c < end; ++c) {
+            collides[c] = checker_.testPair(proxies_[candidates[c].first], proxies_[candidates[c].second],
+                                            states[c].volume, precise ? &states[c].contacts : nullptr) ? 1 : 0;
+        }
+    });
+    for (std::size_t c = 0; c < candidates.size(); ++c) {
+        if (!collides[c]) {
+            continue;
+        }
+        const std::uint32_t i = candidates[c].first;
+        const std::uint32_t j = candidates[c].second;
+        pairs_[(static_cast<std::uint64_t>(i) << 32) | j] = std::move(states[c]);
+        partners_[i].push_back(j);
+        partners_[j].push_back(i);
+    }
+}
+
+void InterferenceSession::rebuildResult(std::size_t tested_pairs) {
+    std::vector<std::uint64_t> keys;
+    keys.reserve(pairs_.size());
+    for (const auto& entry : pairs_) {
+        keys.push_back(entry.first);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    result_ = InterferenceResult{};
+    result_.candidate_pairs = tested_pairs;
+    result_.interference_pairs.reserve(keys.size());
+    for (std::uint64_t key : keys) {
+        const InterferenceProxy& a = proxies_[key >> 32];
+        const InterferenceProxy& b = proxies_[key & 0xffffffffu];
+        const PairState& state = pairs_.at(key);
+        InterferencePair pair;
+        pair.component_a_id = a.component_id;
+        pair.component_b_id = b.component_id;
+        pair.part_a_name = a.part->name();
+        pair.part_b_name = b.part->name();
+        pair.overlap_volume = state.volume;
+        pair.contact_curves = state.contacts;
+        result_.interference_pairs.push_back(std::move(pair));
+    }
+    InterferenceChecker::describe(result_);
+}
+
 }  // namespace core
 }  // namespace cad
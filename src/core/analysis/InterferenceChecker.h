@@ -1,28 +1,27 @@
 #pragma once
 
+#include <cstddef>
+#include <functional>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "../Modeler/Assembly.h"
+#include "TriangleBvh.h"
 
 namespace cad {
 namespace core {
 
-struct BoundingBox {
-    double min_x{0.0};
-    double min_y{0.0};
-    double min_z{0.0};
-    double max_x{0.0};
-    double max_y{0.0};
-    double max_z{0.0};
-};
-
 struct InterferencePair {
     std::uint64_t component_a_id{0};
     std::uint64_t component_b_id{0};
     std::string part_a_name;
     std::string part_b_name;
     double overlap_volume{0.0};
+    /** Precise: Durchdringungskurve als Schnittsegmente der Oberflächen (Welt), zum Hervorheben. */
+    std::vector<ContactSegment> contact_curves;
 };
 
 struct InterferenceResult {
@@ -30,34 +29,163 @@ struct InterferenceResult {
     int overlap_count{0};
     std::string message;
     std::vector<InterferencePair> interference_pairs;
+    /** Kandidatenpaare aus der Broad Phase (nur diese laufen durch die Narrow Phase). */
+    std::size_t candidate_pairs{0};
+};
+
+/** Abstand zweier Komponenten mit nächsten Punkten (Weltkoordinaten); 0 = Berührung/Durchdringung. */
+struct ClearancePair {
+    std::uint64_t component_a_id{0};
+    std::uint64_t component_b_id{0};
+    std::string part_a_name;
+    std::string part_b_name;
+    double distance{0.0};
+    Point3D point_a;
+    Point3D point_b;
+};
+
+struct ClearanceReport {
+    double threshold{0.0};
+    /** Alle Paare mit Abstand < threshold, sortiert nach Komponentenreihenfolge. */
+    std::vector<ClearancePair> pairs;
+    /** Paare, deren um threshold vergrößerte Boxen sich überlappen (nur diese werden vermessen). */
+    std::size_t candidate_pairs{0};
+    std::string message;
 };
 
 enum class CollisionDetectionMode {
     BoundingBox,
     FeatureBased,
+    /** Dreiecksnetze: Oberflächen-Schnitt, Schnittvolumen und Kontaktkurven. */
     Precise
 };
 
+/** Komponente in Weltlage, wie Broad und Narrow Phase sie sehen. */
+struct InterferenceProxy {
+    std::uint64_t component_id{0};
+    /** Geteilte Part-Definition (hält sie am Leben, auch wenn die Komponente sie inzwischen ersetzt). */
+    std::shared_ptr<const Part> part;
+    /** Nur Precise: geteilter BVH der Part-Definition. */
+    std::shared_ptr<const TriangleBvh> mesh;
+    BoundingBox local_box;
+    Transform transform;
+    RigidFrame frame;
+    BoundingBox box;
+};
+
 class InterferenceChecker {
 public:
+    /** Liefert das Dreiecksnetz einer Part-Definition (lokal); false → Ersatz-Quader aus der Feature-Schätzung. */
+    using MeshProvider = std::function<bool(const Part& part, TriangleMesh& mesh)>;
+
     InterferenceResult check(const std::string& assembly_id) const;
     InterferenceResult checkAssembly(const Assembly& assembly) const;
     void setDetectionMode(CollisionDetectionMode mode);
     CollisionDetectionMode detectionMode() const;
+    /** Netzquelle für den Precise-Modus (z.B. Eigen-Kern); muss thread-sicher sein. */
+    void setMeshProvider(MeshProvider provider);
+    /** Precise-Modus: Octree-Tiefe der Volumen-Voxelisierung (Randzellen = Schnittbox / 2^depth). */
+    void setVolumeSubdivisionDepth(int depth);
+
+    /**
+     * Dreiecks-BVH einer Part-Definition (Netz vom Provider, sonst Quader der Feature-Schätzung).
+     * checkAssembly baut je geteilter Definition genau einen BVH und nutzt ihn für alle Instanzen.
+     */
+    std::shared_ptr<const TriangleBvh> buildPartBvh(const Part& part) const;
+
+    /**
+     * Minimalabstand zwischen zwei Komponentengruppen (unabhängig vom Erkennungsmodus auf Dreiecks-BVHs):
+     * Komponentenpaare nach Box-Abstand geordnet, Abbruch sobald keine Box näher liegt als das beste Paar.
+     * Unbekannte IDs werden übergangen; ohne gültiges Paar ist distance = unendlich.
+     */
+    ClearancePair minimumDistance(const Assembly& assembly, const std::vector<std::uint64_t>& group_a,
+                                  const std::vector<std::uint64_t>& group_b) const;
+    ClearancePair minimumDistance(const Assembly& assembly, std::uint64_t component_a, std::uint64_t component_b) const;
+    /**
+     * Freigangsprüfung: alle Komponentenpaare mit Abstand < threshold (z.B. "alles unter 2 mm").
+     * Broad Phase über um threshold vergrößerte Boxen, je Kandidat Branch-and-Bound mit threshold als
+     * Startschranke; Kandidaten parallel auf dem ThreadPool.
+     */
+    ClearanceReport checkClearance(const Assembly& assembly, double threshold) const;
+
+    /**
+     * Broad Phase: Sweep-and-Prune entlang der Achse mit größter Streuung; liefert alle Paare (i < j)
+     * sich überlappender Boxen, sortiert nach (i, j). O(n log n + k) statt O(n²).
+     */
+    static std::vector<std::pair<std::size_t, std::size_t>> overlappingPairs(const std::vector<BoundingBox>& boxes);
     
 private:
+    friend class InterferenceSession;
+
+    /**
+     * Proxies aller Komponenten (Reihenfolge wie components()); Boxen einmal je geteilter Definition,
+     * mit meshes zusätzlich je Definition ein Dreiecks-BVH.
+     */
+    std::vector<InterferenceProxy> makeProxies(const Assembly& assembly, bool meshes) const;
+    /** Weltlage setzen: Box verschieben, mit BVH (Precise, Freigang) inkl. Drehung. */
+    void placeProxy(InterferenceProxy& proxy, const Transform& world) const;
+    /** Narrow Phase eines Broad-Phase-Kandidaten; contacts nur im Precise-Modus. */
+    bool testPair(const InterferenceProxy& a, const InterferenceProxy& b, double& volume,
+                  std::vector<ContactSegment>* contacts) const;
+    static void describe(InterferenceResult& result);
+
     BoundingBox estimateBoundingBox(const Part& part, const Transform& transform) const;
     BoundingBox estimateBoundingBoxFromFeatures(const Part& part, const Transform& transform) const;
     bool boxesOverlap(const BoundingBox& a, const BoundingBox& b) const;
     double calculateOverlapVolume(const BoundingBox& a, const BoundingBox& b) const;
     bool checkFeatureCollision(const Part& part_a, const Transform& transform_a,
                                const Part& part_b, const Transform& transform_b) const;
-    bool checkPreciseCollision(const Part& part_a, const Transform& transform_a,
-                               const Part& part_b, const Transform& transform_b) const;
-    double calculateIntersectionVolume(const Part& part_a, const Transform& transform_a,
-                                       const Part& part_b, const Transform& transform_b) const;
     
     CollisionDetectionMode detection_mode_{CollisionDetectionMode::FeatureBased};
+    MeshProvider mesh_provider_;
+    int volume_depth_{6};
+};
+
+/**
+ * Dauerhafte Kollisionsprüfung für interaktives Verschieben (Drag): hält Proxies, ein Hash-Raster als
+ * Broad Phase und die Ergebnisse je Paar. update() aktualisiert nur die Proxies der bewegten Komponenten
+ * (inkl. ihrer Unterkomponenten) und prüft nur Paare mit mindestens einem bewegten Partner neu;
+ * Paare unbewegter Komponenten behalten ihr Ergebnis. Ändert sich die Komponentenliste, wird neu aufgebaut.
+ */
+class InterferenceSession {
+public:
+    explicit InterferenceSession(InterferenceChecker checker = InterferenceChecker{});
+
+    /** Vollständiger Aufbau; Ergebnis wie checkAssembly. */
+    const InterferenceResult& begin(const Assembly& assembly);
+    /** Nach Lageänderung der Komponenten moved_ids; candidate_pairs = neu geprüfte Paare. */
+    const InterferenceResult& update(const Assembly& assembly, const std::vector<std::uint64_t>& moved_ids);
+
+    const InterferenceResult& result() const { return result_; }
+    bool active() const { return !proxies_.empty(); }
+
+private:
+    struct PairState {
+        double volume{0.0};
+        std::vector<ContactSegment> contacts;
+    };
+
+    std::uint64_t cellKey(std::int64_t x, std::int64_t y, std::int64_t z) const;
+    /** Rasterzellen der Box; false = zu groß fürs Raster (wird gegen alle geprüft). */
+    bool cellRange(const BoundingBox& box, std::int64_t lo[3], std::int64_t hi[3]) const;
+    void insertProxy(std::uint32_t index);
+    void removeProxy(std::uint32_t index);
+    void collectCandidates(std::uint32_t index, const std::vector<char>& moved,
+                           std::vector<std::pair<std::uint32_t, std::uint32_t>>& candidates) const;
+    void testCandidates(const std::vector<std::pair<std::uint32_t, std::uint32_t>>& candidates);
+    void rebuildResult(std::size_t tested_pairs);
+
+    InterferenceChecker checker_;
+    std::vector<InterferenceProxy> proxies_;
+    std::unordered_map<std::uint64_t, std::uint32_t> index_of_;
+    double cell_size_{1.0};
+    std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> grid_;
+    /** Proxies, die mehr Rasterzellen als erlaubt überdecken. */
+    std::vector<std::uint32_t> oversized_;
+    /** Kollidierende Paare, Schlüssel (i << 32) | j mit i < j (Proxy-Indizes). */
+    std::unordered_map<std::uint64_t, PairState> pairs_;
+    std::vector<std::vector<std::uint32_t>> partners_;
+    InterferenceResult result_;
 };
 
 }  // namespace core
@@ -0,0 +1,907 @@
+#include "TriangleBvh.h"
+#include "parallel/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <utility>
+
+namespace cad {
+namespace core {
+
+namespace {
+
+/** Strahlrichtung für den Paritätstest: irrational geneigt, damit Kanten/Ecken praktisch nie exakt getroffen werden. */
+constexpr double kRayDir[3] = {0.7581754014, 0.5723306740, 0.3123988498};
+
+inline void cross(const double a[3], const double b[3], double out[3]) {
+    out[0] = a[1] * b[2] - a[2] * b[1];
+    out[1] = a[2] * b[0] - a[0] * b[2];
+    out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+inline double dot(const double a[3], const double b[3]) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+/** Liegen Punkte echt auf beiden Seiten der Ebene? (Berührung innerhalb eps zählt nicht) */
+inline bool straddles(double d0, double d1, double d2, double eps) {
+    const bool positive = d0 > eps || d1 > eps || d2 > eps;
+    const bool negative = d0 < -eps || d1 < -eps || d2 < -eps;
+    return positive && negative;
+}
+
+/**
+ * Die zwei Punkte, in denen ein (die Ebene echt querendes) Dreieck die andere Ebene schneidet.
+ * d: Abstände der Ecken zur Ebene, |d| ≤ eps gilt als 0.
+ */
+bool planeCrossing(const double v[3][3], const double d_in[3], double eps, double out[2][3]) {
+    double d[3];
+    for (int i = 0; i < 3; ++i) {
+        d[i] = std::abs(d_in[i]) <= eps ? 0.0 : d_in[i];
+    }
+    int n = 0;
+    for (int i = 0; i < 3 && n < 2; ++i) {
+        if (d[i] == 0.0) {
+            std::copy(v[i], v[i] + 3, out[n++]);
+        }
+    }
+    for (int i = 0; i < 3 && n < 2; ++i) {
+        const int j = (i + 1) % 3;
+        if ((d[i] > 0.0 && d[j] < 0.0) || (d[i] < 0.0 && d[j] > 0.0)) {
+            const double t = d[i] / (d[i] - d[j]);
+            for (int k = 0; k < 3; ++k) {
+                out[n][k] = v[i][k] + t * (v[j][k] - v[i][k]);
+            }
+            ++n;
+        }
+    }
+    return n == 2;
+}
+
+/**
+ * Schnittsegment zweier Dreiecke, die die jeweils andere Ebene echt queren: beide Querungsstrecken
+ * liegen auf der Schnittgeraden der Ebenen, das Segment ist die Überlappung der Parameterintervalle.
+ */
+bool triangleSegment(const double p[3][3], const double dp[3], const double np[3],
+                     const double q[3][3], const double dq[3], const double nq[3],
+                     double eps, double out[2][3]) {
+    double dir[3];
+    cross(np, nq, dir);
+    const double len = std::sqrt(dot(dir, dir));
+    if (len < 1e-12) {
+        return false;  // (nahezu) koplanar: Berührung, keine Durchdringung
+    }
+    for (double& c : dir) {
+        c /= len;
+    }
+    double pa[2][3];
+    double qa[2][3];
+    if (!planeCrossing(p, dp, eps, pa) || !planeCrossing(q, dq, eps, qa)) {
+        return false;
+    }
+    double sp[2] = {dot(dir, pa[0]), dot(dir, pa[1])};
+    double sq[2] = {dot(dir, qa[0]), dot(dir, qa[1])};
+    if (sp[0] > sp[1]) {
+        std::swap(sp[0], sp[1]);
+        std::swap(pa[0], pa[1]);
+    }
+    if (sq[0] > sq[1]) {
+        std::swap(sq[0], sq[1]);
+        std::swap(qa[0], qa[1]);
+    }
+    const double lo = std::max(sp[0], sq[0]);
+    const double hi = std::min(sp[1], sq[1]);
+    if (hi - lo <= eps) {
+        return false;
+    }
+    std::copy(sp[0] >= sq[0] ? pa[0] : qa[0], (sp[0] >= sq[0] ? pa[0] : qa[0]) + 3, out[0]);
+    std::copy(sp[1] <= sq[1] ? pa[1] : qa[1], (sp[1] <= sq[1] ? pa[1] : qa[1]) + 3, out[1]);
+    return true;
+}
+
+inline double distanceSquared(const double a[3], const double b[3]) {
+    const double d[3] = {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+    return dot(d, d);
+}
+
+/** Nächster Punkt auf Dreieck (a, b, c) zu p (Voronoi-Regionen, Ericson 5.1.5). */
+void closestPointTriangle(const double p[3], const double a[3], const double b[3], const double c[3], double out[3]) {
+    const double ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    const double ac[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+    const double ap[3] = {p[0] - a[0], p[1] - a[1], p[2] - a[2]};
+    const double d1 = dot(ab, ap);
+    const double d2 = dot(ac, ap);
+    if (d1 <= 0.0 && d2 <= 0.0) {
+        std::copy(a, a + 3, out);
+        return;
+    }
+    const double bp[3] = {p[0] - b[0], p[1] - b[1], p[2] - b[2]};
+    const double d3 = dot(ab, bp);
+    const double d4 = dot(ac, bp);
+    if (d3 >= 0.0 && d4 <= d3) {
+        std::copy(b, b + 3, out);
+        return;
+    }
+    const double vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) {
+        const double v = d1 / (d1 - d3);
+        for (int k = 0; k < 3; ++k) {
+            out[k] = a[k] + v * ab[k];
+        }
+        return;
+    }
+    const double cp[3] = {p[0] - c[0], p[1] - c[1], p[2] - c[2]};
+    const double d5 = dot(ab, cp);
+    const double d6 = dot(ac, cp);
+    if (d6 >= 0.0 && d5 <= d6) {
+        std::copy(c, c + 3, out);
+        return;
+    }
+    const double vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) {
+        const double w = d2 / (d2 - d6);
+        for (int k = 0; k < 3; ++k) {
+            out[k] = a[k] + w * ac[k];
+        }
+        return;
+    }
+    const double va = d3 * d6 - d5 * d4;
+    if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0) {
+        const double w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        for (int k = 0; k < 3; ++k) {
+            out[k] = b[k] + w * (c[k] - b[k]);
+        }
+        return;
+    }
+    const double denom = 1.0 / (va + vb + vc);
+    const double v = vb * denom;
+    const double w = vc * denom;
+    for (int k = 0; k < 3; ++k) {
+        out[k] = a[k] + ab[k] * v + ac[k] * w;
+    }
+}
+
+/** Nächste Punkte zweier Strecken p1-q1 und p2-q2 (Ericson 5.1.9); liefert das Abstandsquadrat. */
+double closestSegmentSegment(const double p1[3], const double q1[3], const double p2[3], const double q2[3],
+                             double c1[3], double c2[3]) {
+    const double d1[3] = {q1[0] - p1[0], q1[1] - p1[1], q1[2] - p1[2]};
+    const double d2[3] = {q2[0] - p2[0], q2[1] - p2[1], q2[2] - p2[2]};
+    const double r[3] = {p1[0] - p2[0], p1[1] - p2[1], p1[2] - p2[2]};
+    const double a = dot(d1, d1);
+    const double e = dot(d2, d2);
+    const double f = dot(d2, r);
+    double s = 0.0;
+    double t = 0.0;
+    if (a <= 1e-300 && e <= 1e-300) {
+        s = t = 0.0;
+    } else if (a <= 1e-300) {
+        t = std::min(1.0, std::max(0.0, f / e));
+    } else {
+        const double c = dot(d1, r);
+        if (e <= 1e-300) {
+            s = std::min(1.0, std::max(0.0, -c / a));
+        } else {
+            const double b = dot(d1, d2);
+            const double denom = a * e - b * b;
+            s = denom > 0.0 ? std::min(1.0, std::max(0.0, (b * f - c * e) / denom)) : 0.0;
+            t = (b * s + f) / e;
+            if (t < 0.0) {
+                t = 0.0;
+                s = std::min(1.0, std::max(0.0, -c / a));
+            } else if (t > 1.0) {
+                t = 1.0;
+                s = std::min(1.0, std::max(0.0, (b - c) / a));
+            }
+        }
+    }
+    for (int k = 0; k < 3; ++k) {
+        c1[k] = p1[k] + d1[k] * s;
+        c2[k] = p2[k] + d2[k] * t;
+    }
+    return distanceSquared(c1, c2);
+}
+
+/**
+ * Abstandsquadrat zweier Dreiecke: 0 bei Durchdringung, sonst Minimum aus 9 Kante-Kante- und
+ * 6 Ecke-Fläche-Abständen. out_p/out_q: nächste Punkte.
+ */
+double triangleDistanceSquared(const double p[3][3], const double np[3], const double q[3][3], const double nq[3],
+                               double eps, double out_p[3], double out_q[3]) {
+    double dp[3];
+    double dq[3];
+    const double dp_plane = -dot(nq, q[0]);
+    const double dq_plane = -dot(np, p[0]);
+    for (int k = 0; k < 3; ++k) {
+        dp[k] = dot(nq, p[k]) + dp_plane;
+        dq[k] = dot(np, q[k]) + dq_plane;
+    }
+    if (straddles(dp[0], dp[1], dp[2], eps) && straddles(dq[0], dq[1], dq[2], eps)) {
+        double segment[2][3];
+        if (triangleSegment(p, dp, np, q, dq, nq, eps, segment)) {
+            std::copy(segment[0], segment[0] + 3, out_p);
+            std::copy(segment[0], segment[0] + 3, out_q);
+            return 0.0;
+        }
+    }
+    double best = 1e300;
+    double cp[3];
+    double cq[3];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            const double d = closestSegmentSegment(p[i], p[(i + 1) % 3], q[j], q[(j + 1) % 3], cp, cq);
+            if (d < best) {
+                best = d;
+                std::copy(cp, cp + 3, out_p);
+                std::copy(cq, cq + 3, out_q);
+            }
+        }
+    }
+    for (int i = 0; i < 3; ++i) {
+        closestPointTriangle(p[i], q[0], q[1], q[2], cq);
+        double d = distanceSquared(p[i], cq);
+        if (d < best) {
+            best = d;
+            std::copy(p[i], p[i] + 3, out_p);
+            std::copy(cq, cq + 3, out_q);
+        }
+        closestPointTriangle(q[i], p[0], p[1], p[2], cp);
+        d = distanceSquared(q[i], cp);
+        if (d < best) {
+            best = d;
+            std::copy(cp, cp + 3, out_p);
+            std::copy(q[i], q[i] + 3, out_q);
+        }
+    }
+    return best;
+}
+
+/** Abstand zweier achsparalleler Boxen (0 bei Überlappung). */
+inline double boxDistance(const double a_min[3], const double a_max[3], const double b_min[3], const double b_max[3]) {
+    double sum = 0.0;
+    for (int k = 0; k < 3; ++k) {
+        const double gap = std::max({0.0, b_min[k] - a_max[k], a_min[k] - b_max[k]});
+        sum += gap * gap;
+    }
+    return std::sqrt(sum);
+}
+
+inline bool boxesOverlapOpen(const double a_min[3], const double a_max[3],
+                             const double b_min[3], const double b_max[3]) {
+    return a_min[0] < b_max[0] && a_max[0] > b_min[0] && a_min[1] < b_max[1] && a_max[1] > b_min[1] &&
+           a_min[2] < b_max[2] && a_max[2] > b_min[2];
+}
+
+}  // namespace
+
+RigidFrame RigidFrame::fromTransform(const Transform& transform) {
+    const Quaternion q = normalized(orientationOf(transform));
+    RigidFrame frame;
+    frame.m[0] = 1.0 - 2.0 * (q.y * q.y + q.z * q.z);
+    frame.m[1] = 2.0 * (q.x * q.y - q.w * q.z);
+    frame.m[2] = 2.0 * (q.x * q.z + q.w * q.y);
+    frame.m[3] = 2.0 * (q.x * q.y + q.w * q.z);
+    frame.m[4] = 1.0 - 2.0 * (q.x * q.x + q.z * q.z);
+    frame.m[5] = 2.0 * (q.y * q.z - q.w * q.x);
+    frame.m[6] = 2.0 * (q.x * q.z - q.w * q.y);
+    frame.m[7] = 2.0 * (q.y * q.z + q.w * q.x);
+    frame.m[8] = 1.0 - 2.0 * (q.x * q.x + q.y * q.y);
+    frame.t[0] = transform.tx;
+    frame.t[1] = transform.ty;
+    frame.t[2] = transform.tz;
+    return frame;
+}
+
+RigidFrame RigidFrame::inverse() const {
+    RigidFrame out;
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) {
+            out.m[3 * r + c] = m[3 * c + r];
+        }
+    }
+    for (int r = 0; r < 3; ++r) {
+        out.t[r] = -(out.m[3 * r] * t[0] + out.m[3 * r + 1] * t[1] + out.m[3 * r + 2] * t[2]);
+    }
+    return out;
+}
+
+RigidFrame operator*(const RigidFrame& a, const RigidFrame& b) {
+    RigidFrame out;
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) {
+            out.m[3 * r + c] = a.m[3 * r] * b.m[c] + a.m[3 * r + 1] * b.m[3 + c] + a.m[3 * r + 2] * b.m[6 + c];
+        }
+        out.t[r] = a.m[3 * r] * b.t[0] + a.m[3 * r + 1] * b.t[1] + a.m[3 * r + 2] * b.t[2] + a.t[r];
+    }
+    return out;
+}
+
+void RigidFrame::apply(const double in[3], double out[3]) const {
+    const double x = in[0], y = in[1], z = in[2];
+    out[0] = m[0] * x + m[1] * y + m[2] * z + t[0];
+    out[1] = m[3] * x + m[4] * y + m[5] * z + t[1];
+    out[2] = m[6] * x + m[7] * y + m[8] * z + t[2];
+}
+
+void RigidFrame::applyBox(const double min[3], const double max[3], double out_min[3], double out_max[3]) const {
+    const double c[3] = {0.5 * (min[0] + max[0]), 0.5 * (min[1] + max[1]), 0.5 * (min[2] + max[2])};
+    const double e[3] = {0.5 * (max[0] - min[0]), 0.5 * (max[1] - min[1]), 0.5 * (max[2] - min[2])};
+    double center[3];
+    apply(c, center);
+    for (int r = 0; r < 3; ++r) {
+        const double extent = std::abs(m[3 * r]) * e[0] + std::abs(m[3 * r + 1]) * e[1] + std::abs(m[3 * r + 2]) * e[2];
+        out_min[r] = center[r] - extent;
+        out_max[r] = center[r] + extent;
+    }
+}
+
+TriangleBvh::TriangleBvh(const TriangleMesh& mesh) {
+    const std::size_t vertex_count = mesh.vertices.size() / 3;
+    std::vector<double> corners;
+    std::vector<double> centroids;
+    corners.reserve(mesh.indices.size() * 3);
+    centroids.reserve(mesh.indices.size());
+    double lo[3] = {0.0, 0.0, 0.0};
+    double hi[3] = {0.0, 0.0, 0.0};
+    for (std::size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        if (mesh.indices[i] >= vertex_count || mesh.indices[i + 1] >= vertex_count ||
+            mesh.indices[i + 2] >= vertex_count) {
+            continue;
+        }
+        double v[3][3];
+        for (int k = 0; k < 3; ++k) {
+            std::copy(&mesh.vertices[3 * mesh.indices[i + k]], &mesh.vertices[3 * mesh.indices[i + k]] + 3, v[k]);
+        }
+        const double e1[3] = {v[1][0] - v[0][0], v[1][1] - v[0][1], v[1][2] - v[0][2]};
+        const double e2[3] = {v[2][0] - v[0][0], v[2][1] - v[0][1], v[2][2] - v[0][2]};
+        double n[3];
+        cross(e1, e2, n);
+        if (dot(n, n) < 1e-24) {
+            continue;  // entartetes Dreieck
+        }
+        for (int k = 0; k < 3; ++k) {
+            corners.insert(corners.end(), v[k], v[k] + 3);
+            for (int axis = 0; axis < 3; ++axis) {
+                const bool first = centroids.empty() && k == 0;
+                lo[axis] = first ? v[k][axis] : std::min(lo[axis], v[k][axis]);
+                hi[axis] = first ? v[k][axis] : std::max(hi[axis], v[k][axis]);
+            }
+        }
+        for (int axis = 0; axis < 3; ++axis) {
+            centroids.push_back((v[0][axis] + v[1][axis] + v[2][axis]) / 3.0);
+        }
+    }
+
+    const std::size_t count = centroids.size() / 3;
+    if (count == 0) {
+        return;
+    }
+    const double diagonal = std::sqrt((hi[0] - lo[0]) * (hi[0] - lo[0]) + (hi[1] - lo[1]) * (hi[1] - lo[1]) +
+                                      (hi[2] - lo[2]) * (hi[2] - lo[2]));
+    epsilon_ = std::max(1e-12, diagonal * 1e-9);
+
+    std::vector<std::uint32_t> order(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        order[i] = static_cast<std::uint32_t>(i);
+    }
+    nodes_.reserve(2 * (count / kLeafSize + 1));
+    build(order, centroids, corners, 0, count);
+
+    for (auto& channel : vertex_) {
+        channel.reserve(count);
+    }
+    for (auto& channel : plane_) {
+        channel.reserve(count);
+    }
+    for (std::uint32_t t : order) {
+        const double* v = &corners[9 * t];
+        for (int k = 0; k < 9; ++k) {
+            vertex_[k].push_back(v[k]);
+        }
+        const double e1[3] = {v[3] - v[0], v[4] - v[1], v[5] - v[2]};
+        const double e2[3] = {v[6] - v[0], v[7] - v[1], v[8] - v[2]};
+        double n[3];
+        cross(e1, e2, n);
+        const double len = std::sqrt(dot(n, n));
+        for (double& c : n) {
+            c /= len;
+        }
+        plane_[0].push_back(n[0]);
+        plane_[1].push_back(n[1]);
+        plane_[2].push_back(n[2]);
+        plane_[3].push_back(-dot(n, v));
+    }
+}
+
+std::uint32_t TriangleBvh::build(std::vector<std::uint32_t>& order, const std::vector<double>& centroids,
+                                 const std::vector<double>& corners, std::size_t begin, std::size_t end) {
+    const std::uint32_t index = static_cast<std::uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+    Node node;
+    double c_lo[3];
+    double c_hi[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        node.min[axis] = corners[9 * order[begin] + axis];
+        node.max[axis] = node.min[axis];
+        c_lo[axis] = centroids[3 * order[begin] + axis];
+        c_hi[axis] = c_lo[axis];
+    }
+    for (std::size_t i = begin; i < end; ++i) {
+        for (int axis = 0; axis < 3; ++axis) {
+            for (int k = 0; k < 3; ++k) {
+                const double v = corners[9 * order[i] + 3 * k + axis];
+                node.min[axis] = std::min(node.min[axis], v);
+                node.max[axis] = std::max(node.max[axis], v);
+            }
+            c_lo[axis] = std::min(c_lo[axis], centroids[3 * order[i] + axis]);
+            c_hi[axis] = std::max(c_hi[axis], centroids[3 * order[i] + axis]);
+        }
+    }
+
+    if (end - begin <= kLeafSize) {
+        node.first = static_cast<std::uint32_t>(begin);
+        node.count = static_cast<std::uint32_t>(end - begin);
+        nodes_[index] = node;
+        return index;
+    }
+
+    int axis = 0;
+    for (int k = 1; k < 3; ++k) {
+        if (c_hi[k] - c_lo[k] > c_hi[axis] - c_lo[axis]) {
+            axis = k;
+        }
+    }
+    const std::size_t mid = begin + (end - begin) / 2;
+    std::nth_element(order.begin() + static_cast<std::ptrdiff_t>(begin), order.begin() + static_cast<std::ptrdiff_t>(mid),
+                     order.begin() + static_cast<std::ptrdiff_t>(end), [&](std::uint32_t a, std::uint32_t b) {
+                         return centroids[3 * a + axis] < centroids[3 * b + axis];
+                     });
+    build(order, centroids, corners, begin, mid);
+    node.first = build(order, centroids, corners, mid, end);
+    node.count = 0;
+    nodes_[index] = node;
+    return index;
+}
+
+BoundingBox TriangleBvh::bounds() const {
+    BoundingBox box;
+    if (nodes_.empty()) {
+        return box;
+    }
+    box.min_x = nodes_[0].min[0];
+    box.min_y = nodes_[0].min[1];
+    box.min_z = nodes_[0].min[2];
+    box.max_x = nodes_[0].max[0];
+    box.max_y = nodes_[0].max[1];
+    box.max_z = nodes_[0].max[2];
+    return box;
+}
+
+bool TriangleBvh::contains(const double point[3]) const {
+    if (nodes_.empty()) {
+        return false;
+    }
+    const double inv[3] = {1.0 / kRayDir[0], 1.0 / kRayDir[1], 1.0 / kRayDir[2]};
+    std::size_t crossings = 0;
+    std::uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const std::uint32_t index = stack[--top];
+        const Node& node = nodes_[index];
+        double t_near = 0.0;
+        double t_far = 1e300;
+        for (int axis = 0; axis < 3; ++axis) {
+            double t0 = (node.min[axis] - point[axis]) * inv[axis];
+            double t1 = (node.max[axis] - point[axis]) * inv[axis];
+            if (t0 > t1) {
+                std::swap(t0, t1);
+            }
+            t_near = std::max(t_near, t0);
+            t_far = std::min(t_far, t1);
+        }
+        if (t_near > t_far) {
+            continue;
+        }
+        if (node.count == 0) {
+            stack[top++] = index + 1;
+            stack[top++] = node.first;
+            continue;
+        }
+        // Möller-Trumbore, beidseitig
+        for (std::uint32_t i = node.first; i < node.first + node.count; ++i) {
+            const double v0[3] = {vertex_[0][i], vertex_[1][i], vertex_[2][i]};
+            const double e1[3] = {vertex_[3][i] - v0[0], vertex_[4][i] - v0[1], vertex_[5][i] - v0[2]};
+            const double e2[3] = {vertex_[6][i] - v0[0], vertex_[7][i] - v0[1], vertex_[8][i] - v0[2]};
+            double p[3];
+            cross(kRayDir, e2, p);
+            const double det = dot(e1, p);
+            if (std::abs(det) < 1e-300) {
+                continue;
+            }
+            const double inv_det = 1.0 / det;
+            const double s[3] = {point[0] - v0[0], point[1] - v0[1], point[2] - v0[2]};
+            const double u = dot(s, p) * inv_det;
+            if (u < 0.0 || u > 1.0) {
+                continue;
+            }
+            double q[3];
+            cross(s, e1, q);
+            const double v = dot(kRayDir, q) * inv_det;
+            if (v < 0.0 || u + v > 1.0) {
+                continue;
+            }
+            if (dot(e2, q) * inv_det > 0.0) {
+                ++crossings;
+            }
+        }
+    }
+    return (crossings % 2) == 1;
+}
+
+bool TriangleBvh::touchesBox(const double min[3], const double max[3]) const {
+    if (nodes_.empty()) {
+        return false;
+    }
+    std::uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const std::uint32_t index = stack[--top];
+        const Node& node = nodes_[index];
+        if (!boxesOverlapOpen(node.min, node.max, min, max)) {
+            continue;
+        }
+        if (node.count == 0) {
+            stack[top++] = index + 1;
+            stack[top++] = node.first;
+            continue;
+        }
+        for (std::uint32_t i = node.first; i < node.first + node.count; ++i) {
+            double t_min[3];
+            double t_max[3];
+            for (int axis = 0; axis < 3; ++axis) {
+                t_min[axis] = std::min({vertex_[axis][i], vertex_[3 + axis][i], vertex_[6 + axis][i]});
+                t_max[axis] = std::max({vertex_[axis][i], vertex_[3 + axis][i], vertex_[6 + axis][i]});
+            }
+            if (boxesOverlapOpen(t_min, t_max, min, max)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool TriangleBvh::intersect(const TriangleBvh& a, const RigidFrame& frame_a,
+                            const TriangleBvh& b, const RigidFrame& frame_b,
+                            std::vector<ContactSegment>* contacts, std::size_t max_contacts) {
+    if (a.empty() || b.empty()) {
+        return false;
+    }
+    // Rechnung im lokalen System von a; b wird mit rel = a^-1 * b hineingedreht
+    const RigidFrame rel = frame_a.inverse() * frame_b;
+    const double eps = std::max(a.epsilon_, b.epsilon_);
+    bool found = false;
+
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> stack;
+    stack.reserve(128);
+    stack.emplace_back(0u, 0u);
+    while (!stack.empty()) {
+        const std::uint32_t ia = stack.back().first;
+        const std::uint32_t ib = stack.back().second;
+        stack.pop_back();
+        const Node& na = a.nodes_[ia];
+        const Node& nb = b.nodes_[ib];
+        double b_min[3];
+        double b_max[3];
+        rel.applyBox(nb.min, nb.max, b_min, b_max);
+        if (na.min[0] > b_max[0] + eps || na.max[0] < b_min[0] - eps || na.min[1] > b_max[1] + eps ||
+            na.max[1] < b_min[1] - eps || na.min[2] > b_max[2] + eps || na.max[2] < b_min[2] - eps) {
+            continue;
+        }
+        if (na.count == 0 || nb.count == 0) {
+            // Größeren inneren Knoten zuerst teilen
+            const double size_a = (na.max[0] - na.min[0]) + (na.max[1] - na.min[1]) + (na.max[2] - na.min[2]);
+            const double size_b = (b_max[0] - b_min[0]) + (b_max[1] - b_min[1]) + (b_max[2] - b_min[2]);
+            if (nb.count != 0 || (na.count == 0 && size_a >= size_b)) {
+                stack.emplace_back(ia + 1, ib);
+                stack.emplace_back(na.first, ib);
+            } else {
+                stack.emplace_back(ia, ib + 1);
+                stack.emplace_back(ia, nb.first);
+            }
+            continue;
+        }
+
+        const std::uint32_t f = na.first;
+        const std::uint32_t n = na.count;
+        for (std::uint32_t j = nb.first; j < nb.first + nb.count; ++j) {
+            double q[3][3];
+            for (int k = 0; k < 3; ++k) {
+                const double local[3] = {b.vertex_[3 * k][j], b.vertex_[3 * k + 1][j], b.vertex_[3 * k + 2][j]};
+                rel.apply(local, q[k]);
+            }
+            const double nq_local[3] = {b.plane_[0][j], b.plane_[1][j], b.plane_[2][j]};
+            const double nq[3] = {rel.m[0] * nq_local[0] + rel.m[1] * nq_local[1] + rel.m[2] * nq_local[2],
+                                  rel.m[3] * nq_local[0] + rel.m[4] * nq_local[1] + rel.m[5] * nq_local[2],
+                                  rel.m[6] * nq_local[0] + rel.m[7] * nq_local[1] + rel.m[8] * nq_local[2]};
+            const double dq_plane = -dot(nq, q[0]);
+
+            // Ebenen-Tests für alle Dreiecke des Blatts von a in einem (vektorisierbaren) Durchlauf:
+            // Abstände der Ecken von q zu den Ebenen von a und der Ecken von a zur Ebene von q
+            double dq[3][kLeafSize];
+            double dp[3][kLeafSize];
+            for (std::uint32_t k = 0; k < n; ++k) {
+                const double px = a.plane_[0][f + k];
+                const double py = a.plane_[1][f + k];
+                const double pz = a.plane_[2][f + k];
+                const double pd = a.plane_[3][f + k];
+                dq[0][k] = px * q[0][0] + py * q[0][1] + pz * q[0][2] + pd;
+                dq[1][k] = px * q[1][0] + py * q[1][1] + pz * q[1][2] + pd;
+                dq[2][k] = px * q[2][0] + py * q[2][1] + pz * q[2][2] + pd;
+                dp[0][k] = nq[0] * a.vertex_[0][f + k] + nq[1] * a.vertex_[1][f + k] + nq[2] * a.vertex_[2][f + k] + dq_plane;
+                dp[1][k] = nq[0] * a.vertex_[3][f + k] + nq[1] * a.vertex_[4][f + k] + nq[2] * a.vertex_[5][f + k] + dq_plane;
+                dp[2][k] = nq[0] * a.vertex_[6][f + k] + nq[1] * a.vertex_[7][f + k] + nq[2] * a.vertex_[8][f + k] + dq_plane;
+            }
+
+            for (std::uint32_t k = 0; k < n; ++k) {
+                if (!straddles(dq[0][k], dq[1][k], dq[2][k], eps) || !straddles(dp[0][k], dp[1][k], dp[2][k], eps)) {
+                    continue;
+                }
+                const std::uint32_t i = f + k;
+                const double p[3][3] = {{a.vertex_[0][i], a.vertex_[1][i], a.vertex_[2][i]},
+                                        {a.vertex_[3][i], a.vertex_[4][i], a.vertex_[5][i]},
+                                        {a.vertex_[6][i], a.vertex_[7][i], a.vertex_[8][i]}};
+                const double np[3] = {a.plane_[0][i], a.plane_[1][i], a.plane_[2][i]};
+                const double dp_k[3] = {dp[0][k], dp[1][k], dp[2][k]};
+                const double dq_k[3] = {dq[0][k], dq[1][k], dq[2][k]};
+                double segment[2][3];
+                if (!triangleSegment(p, dp_k, np, q, dq_k, nq, eps, segment)) {
+                    continue;
+                }
+                found = true;
+                if (!contacts || contacts->size() >= max_contacts) {
+                    return true;
+                }
+                double w0[3];
+                double w1[3];
+                frame_a.apply(segment[0], w0);
+                frame_a.apply(segment[1], w1);
+                contacts->push_back(ContactSegment{Point3D{w0[0], w0[1], w0[2]}, Point3D{w1[0], w1[1], w1[2]}});
+            }
+        }
+    }
+    return found;
+}
+
+double TriangleBvh::overlapVolume(const TriangleBvh& a, const RigidFrame& frame_a,
+                                  const TriangleBvh& b, const RigidFrame& frame_b, int max_depth) {
+    if (a.empty() || b.empty()) {
+        return 0.0;
+    }
+    // Octree im lokalen System von a; Zellen werden für b konservativ umgerechnet
+    const RigidFrame b_to_a = frame_a.inverse() * frame_b;
+    const RigidFrame a_to_b = b_to_a.inverse();
+    const double eps = std::max(a.epsilon_, b.epsilon_);
+
+    double b_min[3];
+    double b_max[3];
+    b_to_a.applyBox(b.nodes_[0].min, b.nodes_[0].max, b_min, b_max);
+    struct Cell {
+        double min[3];
+        double max[3];
+        int depth;
+    };
+    Cell root;
+    root.depth = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        root.min[axis] = std::max(a.nodes_[0].min[axis], b_min[axis]);
+        root.max[axis] = std::min(a.nodes_[0].max[axis], b_max[axis]);
+        if (root.max[axis] - root.min[axis] <= eps) {
+            return 0.0;
+        }
+    }
+
+    double volume = 0.0;
+    std::vector<Cell> stack;
+    stack.push_back(root);
+    while (!stack.empty()) {
+        const Cell cell = stack.back();
+        stack.pop_back();
+        const double center[3] = {0.5 * (cell.min[0] + cell.max[0]), 0.5 * (cell.min[1] + cell.max[1]),
+                                  0.5 * (cell.min[2] + cell.max[2])};
+        double center_b[3];
+        a_to_b.apply(center, center_b);
+        double cell_b_min[3];
+        double cell_b_max[3];
+        a_to_b.applyBox(cell.min, cell.max, cell_b_min, cell_b_max);
+
+        // Zelle ohne Oberfläche eines Körpers liegt ganz innen oder ganz außen → eine Punktprobe genügt
+        const bool boundary_a = a.touchesBox(cell.min, cell.max);
+        if (!boundary_a && !a.contains(center)) {
+            continue;
+        }
+        const bool boundary_b = b.touchesBox(cell_b_min, cell_b_max);
+        if (!boundary_b && !b.contains(center_b)) {
+            continue;
+        }
+        const double cell_volume =
+            (cell.max[0] - cell.min[0]) * (cell.max[1] - cell.min[1]) * (cell.max[2] - cell.min[2]);
+        if (!boundary_a && !boundary_b) {
+            volume += cell_volume;
+            continue;
+        }
+        if (cell.depth >= max_depth) {
+            if ((!boundary_a || a.contains(center)) && (!boundary_b || b.contains(center_b))) {
+                volume += cell_volume;
+            }
+            continue;
+        }
+        for (int octant = 0; octant < 8; ++octant) {
+            Cell child;
+            child.depth = cell.depth + 1;
+            for (int axis = 0; axis < 3; ++axis) {
+                const bool upper = (octant >> axis) & 1;
+                child.min[axis] = upper ? center[axis] : cell.min[axis];
+                child.max[axis] = upper ? cell.max[axis] : center[axis];
+            }
+            stack.push_back(child);
+        }
+    }
+    return volume;
+}
+
+bool TriangleBvh::closestPoints(const TriangleBvh& a, const RigidFrame& frame_a,
+                                const TriangleBvh& b, const RigidFrame& frame_b, double max_distance,
+                                double& distance, Point3D& point_a, Point3D& point_b) {
+    distance = max_distance;
+    if (a.empty() || b.empty()) {
+        return false;
+    }
+    // Rechnung im lokalen System von a
+    const RigidFrame rel = frame_a.inverse() * frame_b;
+    const double eps = std::max(a.epsilon_, b.epsilon_);
+
+    struct Task {
+        std::uint32_t ia;
+        std::uint32_t ib;
+        double bound;
+    };
+    auto lowerBound = [&](std::uint32_t ia, std::uint32_t ib) {
+        double b_min[3];
+        double b_max[3];
+        rel.applyBox(b.nodes_[ib].min, b.nodes_[ib].max, b_min, b_max);
+        return boxDistance(a.nodes_[ia].min, a.nodes_[ia].max, b_min, b_max);
+    };
+    /** Kinder des größeren inneren Knotens (beide Blätter → keine). */
+    auto split = [&](const Task& task, Task children[2]) {
+        const Node& na = a.nodes_[task.ia];
+        const Node& nb = b.nodes_[task.ib];
+        if (na.count != 0 && nb.count != 0) {
+            return false;
+        }
+        const double size_a = (na.max[0] - na.min[0]) + (na.max[1] - na.min[1]) + (na.max[2] - na.min[2]);
+        const double size_b = (nb.max[0] - nb.min[0]) + (nb.max[1] - nb.min[1]) + (nb.max[2] - nb.min[2]);
+        if (nb.count != 0 || (na.count == 0 && size_a >= size_b)) {
+            children[0] = Task{task.ia + 1, task.ib, lowerBound(task.ia + 1, task.ib)};
+            children[1] = Task{na.first, task.ib, lowerBound(na.first, task.ib)};
+        } else {
+            children[0] = Task{task.ia, task.ib + 1, lowerBound(task.ia, task.ib + 1)};
+            children[1] = Task{task.ia, nb.first, lowerBound(task.ia, nb.first)};
+        }
+        return true;
+    };
+
+    // Gemeinsame Schranke aller Teilsuchen; Verbesserungen unter Sperre, Lesen lock-frei
+    std::atomic<double> best{max_distance};
+    std::mutex best_mutex;
+    double best_a[3] = {0.0, 0.0, 0.0};
+    double best_b[3] = {0.0, 0.0, 0.0};
+
+    auto search = [&](const Task& root) {
+        std::vector<Task> stack;
+        stack.reserve(64);
+        stack.push_back(root);
+        while (!stack.empty()) {
+            const Task task = stack.back();
+            stack.pop_back();
+            if (task.bound >= best.load(std::memory_order_relaxed)) {
+                continue;
+            }
+            Task children[2];
+            if (split(task, children)) {
+                // Näheres Paar zuletzt auf den Stapel → zuerst bearbeitet
+                if (children[0].bound < children[1].bound) {
+                    std::swap(children[0], children[1]);
+                }
+                for (const Task& child : children) {
+                    if (child.bound < best.load(std::memory_order_relaxed)) {
+                        stack.push_back(child);
+                    }
+                }
+                continue;
+            }
+            const Node& na = a.nodes_[task.ia];
+            const Node& nb = b.nodes_[task.ib];
+            for (std::uint32_t j = nb.first; j < nb.first + nb.count; ++j) {
+                double q[3][3];
+                for (int k = 0; k < 3; ++k) {
+                    const double local[3] = {b.vertex_[3 * k][j], b.vertex_[3 * k + 1][j], b.vertex_[3 * k + 2][j]};
+                    rel.apply(local, q[k]);
+                }
+                const double nq[3] = {rel.m[0] * b.plane_[0][j] + rel.m[1] * b.plane_[1][j] + rel.m[2] * b.plane_[2][j],
+                                      rel.m[3] * b.plane_[0][j] + rel.m[4] * b.plane_[1][j] + rel.m[5] * b.plane_[2][j],
+                                      rel.m[6] * b.plane_[0][j] + rel.m[7] * b.plane_[1][j] + rel.m[8] * b.plane_[2][j]};
+                for (std::uint32_t i = na.first; i < na.first + na.count; ++i) {
+                    const double p[3][3] = {{a.vertex_[0][i], a.vertex_[1][i], a.vertex_[2][i]},
+                                            {a.vertex_[3][i], a.vertex_[4][i], a.vertex_[5][i]},
+                                            {a.vertex_[6][i], a.vertex_[7][i], a.vertex_[8][i]}};
+                    const double np[3] = {a.plane_[0][i], a.plane_[1][i], a.plane_[2][i]};
+                    double cp[3];
+                    double cq[3];
+                    const double d = std::sqrt(triangleDistanceSquared(p, np, q, nq, eps, cp, cq));
+                    if (d < best.load(std::memory_order_relaxed)) {
+                        std::lock_guard<std::mutex> lock(best_mutex);
+                        if (d < best.load(std::memory_order_relaxed)) {
+                            best.store(d, std::memory_order_relaxed);
+                            std::copy(cp, cp + 3, best_a);
+                            std::copy(cq, cq + 3, best_b);
+                        }
+                    }
+                }
+            }
+            if (best.load(std::memory_order_relaxed) <= 0.0) {
+                return;  // Durchdringung: kleiner geht es nicht
+            }
+        }
+    };
+
+    // Große Netze: Frontier der obersten Knotenpaare aufspannen und parallel durchsuchen
+    constexpr std::size_t kParallelTriangles = 4096;
+    constexpr std::size_t kFrontier = 32;
+    std::vector<Task> frontier{Task{0, 0, lowerBound(0, 0)}};
+    if (a.triangleCount() + b.triangleCount() >= kParallelTriangles) {
+        bool expanded = true;
+        while (expanded && frontier.size() < kFrontier) {
+            expanded = false;
+            std::vector<Task> next;
+            for (const Task& task : frontier) {
+                Task children[2];
+                if (task.bound < max_distance && split(task, children)) {
+                    expanded = true;
+                    for (const Task& child : children) {
+                        if (child.bound < max_distance) {
+                            next.push_back(child);
+                        }
+                    }
+                } else if (task.bound < max_distance) {
+                    next.push_back(task);
+                }
+            }
+            frontier.swap(next);
+        }
+        std::sort(frontier.begin(), frontier.end(), [](const Task& x, const Task& y) { return x.bound < y.bound; });
+    }
+    if (frontier.size() > 1) {
+        ThreadPool::shared().parallelFor(frontier.size(), [&](std::size_t t) { search(frontier[t]); });
+    } else if (!frontier.empty()) {
+        search(frontier[0]);
+    }
+
+    distance = best.load();
+    if (!(distance < max_distance)) {
+        distance = max_distance;
+        return false;
+    }
+    double world_a[3];
+    double world_b[3];
+    frame_a.apply(best_a, world_a);
+    frame_a.apply(best_b, world_b);
+    point_a = Point3D{world_a[0], world_a[1], world_a[2]};
+    point_b = Point3D{world_b[0], world_b[1], world_b[2]};
+    return true;
+}
+
+}  // namespace core
+}  // namespace cad
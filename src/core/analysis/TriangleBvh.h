@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../Modeler/ReferenceGeometry.h"
+#include "../Modeler/Transform.h"
+
+namespace cad {
+namespace core {
+
+struct BoundingBox {
+    double min_x{0.0};
+    double min_y{0.0};
+    double min_z{0.0};
+    double max_x{0.0};
+    double max_y{0.0};
+    double max_z{0.0};
+};
+
+/** Dreiecksnetz: xyz-Koordinaten hintereinander, je drei Indizes ein Dreieck (Layout wie kernel::io::TriangleMesh). */
+struct TriangleMesh {
+    std::vector<double> vertices;
+    std::vector<unsigned int> indices;
+};
+
+/** Stück einer Kontakt-/Durchdringungskurve (Schnitt zweier Oberflächendreiecke), Weltkoordinaten. */
+struct ContactSegment {
+    Point3D start;
+    Point3D end;
+};
+
+/** Starre Lage als Rotationsmatrix + Translation (je Punkt günstiger als Quaternion-Rotation). */
+struct RigidFrame {
+    double m[9]{1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+    double t[3]{0.0, 0.0, 0.0};
+
+    static RigidFrame fromTransform(const Transform& transform);
+    RigidFrame inverse() const;
+    /** Verkettung: (a * b)(p) = a(b(p)). */
+    friend RigidFrame operator*(const RigidFrame& a, const RigidFrame& b);
+
+    void apply(const double in[3], double out[3]) const;
+    /** Konservative achsparallele Box um die abgebildete Box (Mittelpunkt + |R| * Halbachsen). */
+    void applyBox(const double min[3], const double max[3], double out_min[3], double out_max[3]) const;
+};
+
+/**
+ * Hüllkörperhierarchie (achsparallele Boxen, Median-Split) über die Dreiecke eines Teils im lokalen
+ * System der Part-Definition. Dreiecke liegen blattweise zusammenhängend als SoA-Felder vor, damit die
+ * Ebenen-Tests eines Blatts (≤ kLeafSize Dreiecke) in einem Durchlauf vektorisiert laufen.
+ * Nach dem Aufbau unveränderlich → von mehreren Threads gleichzeitig lesbar.
+ */
+class TriangleBvh {
+public:
+    static constexpr std::size_t kLeafSize = 4;
+
+    explicit TriangleBvh(const TriangleMesh& mesh);
+
+    std::size_t triangleCount() const { return plane_[0].size(); }
+    std::size_t nodeCount() const { return nodes_.size(); }
+    /** Lokale Hüllbox (leer: alle Werte 0). */
+    BoundingBox bounds() const;
+    bool empty() const { return nodes_.empty(); }
+
+    /** Punkt im Inneren (lokale Koordinaten, Strahl-Paritätstest; Netz muss geschlossen sein). */
+    bool contains(const double point[3]) const;
+
+    /**
+     * Durchdringen sich die Oberflächen? Berührung (koplanare Flächen, Kante auf Fläche) zählt nicht.
+     * Mit contacts werden die Schnittsegmente (Welt) gesammelt, höchstens max_contacts; ohne contacts
+     * endet die Suche beim ersten Treffer.
+     */
+    static bool intersect(const TriangleBvh& a, const RigidFrame& frame_a,
+                          const TriangleBvh& b, const RigidFrame& frame_b,
+                          std::vector<ContactSegment>* contacts = nullptr,
+                          std::size_t max_contacts = 1024);
+
+    /**
+     * Volumen des Schnittkörpers per adaptiver Voxelisierung (Octree über den Schnitt der Hüllboxen):
+     * Zellen ohne Oberflächenanteil werden als Ganzes klassifiziert, Randzellen bis max_depth geteilt
+     * und dort per Mittelpunkt gezählt.
+     */
+    static double overlapVolume(const TriangleBvh& a, const RigidFrame& frame_a,
+                                const TriangleBvh& b, const RigidFrame& frame_b,
+                                int max_depth = 6);
+
+    /**
+     * Minimalabstand per Branch-and-Bound über beide Hierarchien (Untergrenze: Abstand der Knotenboxen,
+     * nähere Knotenpaare zuerst). Gesucht werden nur Abstände < max_distance: Schwellwert-Prüfungen
+     * brechen ab, sobald keine Box näher liegt. Große Netze werden auf der obersten Ebene in Teilbäume
+     * zerlegt und parallel mit gemeinsamer Schranke durchsucht. Durchdringung ergibt 0.
+     * true, wenn ein Abstand < max_distance gefunden wurde; nächste Punkte in Weltkoordinaten.
+     */
+    static bool closestPoints(const TriangleBvh& a, const RigidFrame& frame_a,
+                              const TriangleBvh& b, const RigidFrame& frame_b, double max_distance,
+                              double& distance, Point3D& point_a, Point3D& point_b);
+
+private:
+    struct Node {
+        double min[3];
+        double max[3];
+        /** Blatt: erstes Dreieck; innerer Knoten: Index des rechten Kinds (linkes Kind = Index + 1). */
+        std::uint32_t first{0};
+        /** Anzahl Dreiecke im Blatt, 0 für innere Knoten. */
+        std::uint32_t count{0};
+    };
+
+    std::uint32_t build(std::vector<std::uint32_t>& order, const std::vector<double>& centroids,
+                        const std::vector<double>& corners, std::size_t begin, std::size_t end);
+    /** Schneidet ein Dreieck die offene Box? (Dreiecks-Hüllbox, konservativ) */
+    bool touchesBox(const double min[3], const double max[3]) const;
+
+    std::vector<Node> nodes_;
+    /** Eckpunkte je Dreieck, SoA: vertex_[3 * ecke + achse][dreieck]. */
+    std::vector<double> vertex_[9];
+    /** Ebene je Dreieck, SoA: nx, ny, nz (normiert), d mit n·p + d = 0. */
+    std::vector<double> plane_[4];
+    /** Toleranz (relativ zur Modellgröße) für Ebenenabstände. */
+    double epsilon_{1e-9};
+};
+
+}  // namespace core
+}  // namespace cad
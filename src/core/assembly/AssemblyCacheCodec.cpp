@@ -0,0 +1,677 @@
+#include "AssemblyCacheCodec.h"
+
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace cad {
+namespace core {
+
+namespace {
+
+constexpr char kMagic[4] = {'H', 'C', 'A', 'C'};
+constexpr std::uint32_t kVersion = 1;
+/** Knoten eines std::map/std::set (Farbe, Eltern, zwei Kinder) zusätzlich zum Wert. */
+constexpr std::size_t kTreeNodeOverhead = 4 * sizeof(void*);
+
+class Writer {
+public:
+    explicit Writer(std::string& out) : out_(out) {}
+
+    template <typename T>
+    void pod(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "pod() nur für trivial kopierbare Typen");
+        out_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+    void u64(std::uint64_t value) { pod(value); }
+    void i32(int value) { pod(static_cast<std::int32_t>(value)); }
+    void f64(double value) { pod(value); }
+    void flag(bool value) { pod(static_cast<std::uint8_t>(value ? 1 : 0)); }
+    void str(const std::string& value) {
+        u64(value.size());
+        out_.append(value);
+    }
+    void strings(const std::vector<std::string>& values) {
+        u64(values.size());
+        for (const auto& value : values) {
+            str(value);
+        }
+    }
+    void point(double x, double y, double z) {
+        f64(x);
+        f64(y);
+        f64(z);
+    }
+    template <typename T>
+    void array(const std::vector<T>& values) {
+        u64(values.size());
+        if (!values.empty()) {
+            out_.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+        }
+    }
+
+private:
+    std::string& out_;
+};
+
+/** Liest mit Bereichsprüfung; nach dem ersten Fehler liefern alle Zugriffe Nullwerte und ok() false. */
+class Reader {
+public:
+    explicit Reader(const std::string& data) : data_(data) {}
+
+    bool ok() const { return ok_; }
+    bool atEnd() const { return pos_ == data_.size(); }
+
+    template <typename T>
+    T pod() {
+        T value{};
+        if (!require(sizeof(T))) {
+            return value;
+        }
+        std::memcpy(&value, data_.data() + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return value;
+    }
+    std::uint64_t u64() { return pod<std::uint64_t>(); }
+    int i32() { return pod<std::int32_t>(); }
+    double f64() { return pod<double>(); }
+    bool flag() { return pod<std::uint8_t>() != 0; }
+    /** Anzahl mit Plausibilitätsgrenze (jedes Element belegt mindestens min_bytes). */
+    std::size_t count(std::size_t min_bytes = 1) {
+        const std::uint64_t n = u64();
+        if (ok_ && n > (data_.size() - pos_) / (min_bytes > 0 ? min_bytes : 1)) {
+            ok_ = false;
+            return 0;
+        }
+        return static_cast<std::size_t>(n);
+    }
+    std::string str() {
+        const std::size_t n = count();
+        if (!require(n)) {
+            return {};
+        }
+        std::string value = data_.substr(pos_, n);
+        pos_ += n;
+        return value;
+    }
+    std::vector<std::string> strings() {
+        std::vector<std::string> values(count(sizeof(std::uint64_t)));
+        for (auto& value : values) {
+            value = str();
+        }
+        return values;
+    }
+    Point3D point() {
+        Point3D p;
+        p.x = f64();
+        p.y = f64();
+        p.z = f64();
+        return p;
+    }
+    Vector3D vector() {
+        Point3D p = point();
+        return Vector3D{p.x, p.y, p.z};
+    }
+    template <typename T>
+    std::vector<T> array() {
+        std::vector<T> values(count(sizeof(T)));
+        if (!values.empty()) {
+            std::memcpy(values.data(), data_.data() + pos_, values.size() * sizeof(T));
+            pos_ += values.size() * sizeof(T);
+        }
+        return values;
+    }
+
+private:
+    bool require(std::size_t n) {
+        if (!ok_ || n > data_.size() - pos_) {
+            ok_ = false;
+            return false;
+        }
+        return true;
+    }
+
+    const std::string& data_;
+    std::size_t pos_{0};
+    bool ok_{true};
+};
+
+std::size_t stringBytes(const std::string& value) {
+    // Kurze Strings liegen im Objekt selbst (SSO)
+    return value.capacity() >= sizeof(std::string) ? value.capacity() + 1 : 0;
+}
+
+template <typename T>
+std::size_t vectorBytes(const std::vector<T>& values) {
+    return values.capacity() * sizeof(T);
+}
+
+std::size_t stringsBytes(const std::vector<std::string>& values) {
+    std::size_t bytes = vectorBytes(values);
+    for (const auto& value : values) {
+        bytes += stringBytes(value);
+    }
+    return bytes;
+}
+
+template <typename K, typename V>
+std::size_t treeBytes(const std::map<K, V>& values) {
+    return values.size() * (sizeof(std::pair<const K, V>) + kTreeNodeOverhead);
+}
+
+void writeFeature(Writer& w, const Feature& f) {
+    w.str(f.name);
+    w.i32(static_cast<int>(f.type));
+    w.str(f.sketch_id);
+    w.flag(f.suppressed);
+    w.u64(f.parameters.size());
+    for (const auto& [key, value] : f.parameters) {
+        w.str(key);
+        w.f64(value);
+    }
+    w.f64(f.depth);
+    w.flag(f.symmetric);
+    w.i32(static_cast<int>(f.extrude_mode));
+    w.flag(f.thin_wall);
+    w.f64(f.thin_thickness);
+    w.f64(f.angle);
+    w.str(f.axis);
+    w.f64(f.diameter);
+    w.f64(f.hole_depth);
+    w.flag(f.through_all);
+    w.f64(f.radius);
+    w.strings(f.edge_ids);
+    w.i32(f.count_x);
+    w.i32(f.count_y);
+    w.i32(f.count_z);
+    w.point(f.spacing_x, f.spacing_y, f.spacing_z);
+    w.i32(f.circular_count);
+    w.f64(f.circular_angle);
+    w.str(f.circular_axis);
+    w.str(f.path_sketch_id);
+    w.i32(f.path_count);
+    w.flag(f.path_equal_spacing);
+    w.f64(f.twist_angle);
+    w.f64(f.scale_factor);
+    w.f64(f.pitch);
+    w.f64(f.revolutions);
+    w.flag(f.clockwise);
+    w.f64(f.wall_thickness);
+    w.strings(f.face_ids);
+    w.f64(f.draft_angle);
+    w.str(f.draft_plane);
+    w.str(f.mirror_plane);
+    w.flag(f.merge_result);
+    w.str(f.thread_standard);
+    w.f64(f.thread_pitch);
+    w.flag(f.internal);
+    w.f64(f.rib_thickness);
+    w.str(f.rib_plane);
+}
+
+Feature readFeature(Reader& r) {
+    Feature f;
+    f.name = r.str();
+    f.type = static_cast<FeatureType>(r.i32());
+    f.sketch_id = r.str();
+    f.suppressed = r.flag();
+    for (std::size_t n = r.count(); n > 0 && r.ok(); --n) {
+        std::string key = r.str();
+        f.parameters[key] = r.f64();
+    }
+    f.depth = r.f64();
+    f.symmetric = r.flag();
+    f.extrude_mode = static_cast<ExtrudeMode>(r.i32());
+    f.thin_wall = r.flag();
+    f.thin_thickness = r.f64();
+    f.angle = r.f64();
+    f.axis = r.str();
+    f.diameter = r.f64();
+    f.hole_depth = r.f64();
+    f.through_all = r.flag();
+    f.radius = r.f64();
+    f.edge_ids = r.strings();
+    f.count_x = r.i32();
+    f.count_y = r.i32();
+    f.count_z = r.i32();
+    Point3D spacing = r.point();
+    f.spacing_x = spacing.x;
+    f.spacing_y = spacing.y;
+    f.spacing_z = spacing.z;
+    f.circular_count = r.i32();
+    f.circular_angle = r.f64();
+    f.circular_axis = r.str();
+    f.path_sketch_id = r.str();
+    f.path_count = r.i32();
+    f.path_equal_spacing = r.flag();
+    f.twist_angle = r.f64();
+    f.scale_factor = r.f64();
+    f.pitch = r.f64();
+    f.revolutions = r.f64();
+    f.clockwise = r.flag();
+    f.wall_thickness = r.f64();
+    f.face_ids = r.strings();
+    f.draft_angle = r.f64();
+    f.draft_plane = r.str();
+    f.mirror_plane = r.str();
+    f.merge_result = r.flag();
+    f.thread_standard = r.str();
+    f.thread_pitch = r.f64();
+    f.internal = r.flag();
+    f.rib_thickness = r.f64();
+    f.rib_plane = r.str();
+    return f;
+}
+
+void writePart(Writer& w, const Part& part) {
+    w.str(part.name());
+    w.u64(part.features().size());
+    for (const auto& feature : part.features()) {
+        writeFeature(w, feature);
+    }
+    w.u64(part.workPlanes().size());
+    for (const auto& plane : part.workPlanes()) {
+        w.str(plane.id);
+        w.str(plane.name);
+        w.point(plane.origin.x, plane.origin.y, plane.origin.z);
+        w.point(plane.normal.x, plane.normal.y, plane.normal.z);
+        w.str(plane.base_plane);
+        w.f64(plane.offset);
+        w.str(plane.plane_type);
+    }
+    w.u64(part.workAxes().size());
+    for (const auto& axis : part.workAxes()) {
+        w.str(axis.id);
+        w.str(axis.name);
+        w.point(axis.point.x, axis.point.y, axis.point.z);
+        w.point(axis.direction.x, axis.direction.y, axis.direction.z);
+        w.str(axis.base_axis);
+    }
+    w.u64(part.workPoints().size());
+    for (const auto& point : part.workPoints()) {
+        w.str(point.id);
+        w.str(point.name);
+        w.point(point.point.x, point.point.y, point.point.z);
+    }
+    w.u64(part.coordinateSystems().size());
+    for (const auto& cs : part.coordinateSystems()) {
+        w.str(cs.name);
+        w.point(cs.origin.x, cs.origin.y, cs.origin.z);
+        w.point(cs.direction_x.x, cs.direction_x.y, cs.direction_x.z);
+        w.point(cs.direction_y.x, cs.direction_y.y, cs.direction_y.z);
+    }
+    w.u64(part.userParameters().size());
+    for (const auto& parameter : part.userParameters()) {
+        w.str(parameter.name);
+        w.f64(parameter.value);
+        w.str(parameter.expression);
+    }
+    w.u64(part.rules().size());
+    for (const auto& rule : part.rules()) {
+        w.str(rule.name);
+        w.str(rule.trigger);
+        w.str(rule.condition_expression);
+        w.str(rule.then_parameter);
+        w.str(rule.then_value_expression);
+    }
+    w.u64(part.configurations().size());
+    for (const auto& config : part.configurations()) {
+        w.str(config.name);
+        w.u64(config.parameter_overrides.size());
+        for (const auto& [key, value] : config.parameter_overrides) {
+            w.str(key);
+            w.f64(value);
+        }
+    }
+    w.i32(part.activeConfigurationIndex());
+    w.str(part.skeletonPartId());
+    w.i32(part.rollbackPosition());
+}
+
+Part readPart(Reader& r) {
+    Part part(r.str());
+    for (std::size_t n = r.count(); n > 0 && r.ok(); --n) {
+        part.addFeature(readFeature(r));
+    }
+    // Arbeitselemente über die API anlegen (Zähler für neue IDs), danach gespeicherte Werte übernehmen
+    for (std::size_t n = r.count(); n > 0 && r.ok(); --n) {
+        WorkPlane plane;
+        plane.id = r.str();
+        plane.name = r.str();
+        plane.origin = r.point();
+        plane.normal = r.vector();
+        plane.base_plane = r.str();
+        plane.offset = r.f64();
+        plane.plane_type = r.str();
+        if (WorkPlane* added = part.findWorkPlane(part.addWorkPlane(plane.name, plane.origin, plane.normal))) {
+            *added = plane;
+        }
+    }
+    for (std::size_t n = r.count(); n > 0 && r.ok(); --n) {
+        WorkAxis axis;
+        axis.id = r.str();
+        axis.name = r.str();
+        axis.point = r.point();
+        axis.direction = r.vector();
+        axis.base_axis = r.str();
+        if (WorkAxis* added = part.findWorkAxis(part.addWorkAxis(axis.name, axis.point, axis.direction))) {
+            *added = axis;
+        }
+    }
+    for (std::size_t n = r.count(); n > 0 && r.ok(); --n) {
+        WorkPoint point;
+        point.id = r.str();
+        point.name = r.str();
+        point.point = r.point();
+        if (WorkPoint* added = part.findWorkPoint(part.addWorkPoint(point.name, point.point))) {
+            *added = point;
+        }
+    }
+    for (std::size_t n = r.count(); n > 0 && r.ok(); --n) {
+        std::string name = r.str();
+        Point3D origin = r.point();
+        Vector3D dir_x = r.vector();
+        Vector3D dir_y = r.vector();
+        part.addCoordinateSystem(name, origin, dir_x, dir_y);
+    }
+    for (std::size_t n = r.count(); n > 0 && r.ok(); --n) {
+        Parameter parameter;
+        parameter.name = r.str();
+        parameter.value = r.f64();
+        parameter.expression = r.str();
+        part.addUserParameter(parameter);
+    }
+    for (std::size_t n = r.count(); n > 0 && r.ok(); --n) {
+        Rule rule;
+        rule.name = r.str();
+        rule.trigger = r.str();
+        rule.condition_expression = r.str();
+        rule.then_parameter = r.str();
+        rule.then_value_expression = r.str();
+        part.addRule(rule);
+    }
+    for (std::size_t n = r.count(); n > 0 && r.ok(); --n) {
+        Configuration config;
+        config.name = r.str();
+        for (std::size_t k = r.count(); k > 0 && r.ok(); --k) {
+            std::string key = r.str();
+            config.parameter_overrides[key] = r.f64();
+        }
+        part.addConfiguration(config);
+    }
+    part.setActiveConfiguration(r.i32());
+    part.setSkeletonPartId(r.str());
+    part.setRollbackPosition(r.i32());
+    return part;
+}
+
+void writeConfigurations(Writer& w, const std::vector<AssemblyConfiguration>& configs) {
+    w.u64(configs.size());
+    for (const auto& config : configs) {
+        w.str(config.name);
+        w.u64(config.component_config_index.size());
+        for (const auto& [id, index] : config.component_config_index) {
+            w.u64(id);
+            w.i32(index);
+        }
+    }
+}
+
+}  // namespace
+
+std::string AssemblyCacheCodec::encode(const Assembly& assembly, const AssemblyMeshes& meshes) {
+    std::string out;
+    Writer w(out);
+    out.append(kMagic, sizeof(kMagic));
+    w.pod(kVersion);
+
+    const auto& components = assembly.components();
+    std::unordered_map<const Part*, std::uint64_t> definition_index;
+    std::vector<const Part*> definitions;
+    for (const auto& component : components) {
+        if (definition_index.emplace(&component.part.get(), definitions.size()).second) {
+            definitions.push_back(&component.part.get());
+        }
+    }
+    w.u64(definitions.size());
+    for (const Part* part : definitions) {
+        writePart(w, *part);
+    }
+
+    w.u64(components.size());
+    for (const auto& component : components) {
+        w.u64(component.id);
+        w.u64(definition_index[&component.part.get()]);
+        w.pod(component.transform);
+        w.u64(component.parent_id);
+        w.flag(component.lightweight_display);
+        w.flag(component.flexible_subassembly);
+        const Vector3D offset = assembly.getExplosionOffset(component.id);
+        w.point(offset.x, offset.y, offset.z);
+        w.strings(assembly.getComponentInterfaces(component.id));
+    }
+    w.f64(assembly.getExplosionFactor());
+
+    w.u64(assembly.mates().size());
+    for (const auto& mate : assembly.mates()) {
+        w.u64(mate.component_a);
+        w.u64(mate.component_b);
+        w.i32(static_cast<int>(mate.type));
+        w.f64(mate.value);
+    }
+    w.u64(assembly.joints().size());
+    for (const auto& joint : assembly.joints()) {
+        w.u64(joint.component_a);
+        w.u64(joint.component_b);
+        w.i32(static_cast<int>(joint.type));
+        w.point(joint.axis_direction.x, joint.axis_direction.y, joint.axis_direction.z);
+        w.point(joint.axis_origin.x, joint.axis_origin.y, joint.axis_origin.z);
+        w.point(joint.slot_direction.x, joint.slot_direction.y, joint.slot_direction.z);
+        w.f64(joint.limit_low);
+        w.f64(joint.limit_high);
+    }
+    writeConfigurations(w, assembly.configurations());
+    w.i32(assembly.activeConfigurationIndex());
+
+    w.u64(meshes.size());
+    for (const auto& [name, mesh] : meshes) {
+        w.str(name);
+        w.array(mesh.vertices);
+        w.array(mesh.indices);
+    }
+    return out;
+}
+
+bool AssemblyCacheCodec::decode(const std::string& data, Assembly& assembly, AssemblyMeshes& meshes) {
+    if (data.size() < sizeof(kMagic) || std::memcmp(data.data(), kMagic, sizeof(kMagic)) != 0) {
+        return false;
+    }
+    Reader r(data);
+    r.pod<std::uint32_t>();  // Magic
+    if (r.pod<std::uint32_t>() != kVersion) {
+        return false;
+    }
+
+    std::vector<std::shared_ptr<Part>> definitions(r.count());
+    for (auto& definition : definitions) {
+        definition = std::make_shared<Part>(readPart(r));
+    }
+
+    struct Record {
+        std::uint64_t id{0};
+        std::uint64_t parent_id{0};
+        bool lightweight{false};
+        bool flexible{false};
+        Vector3D explosion{};
+        std::vector<std::string> interfaces;
+    };
+    Assembly result;
+    std::vector<Record> records(r.count(5 * sizeof(std::uint64_t)));
+    std::unordered_map<std::uint64_t, std::uint64_t> ids;
+    for (auto& record : records) {
+        record.id = r.u64();
+        const std::uint64_t definition = r.u64();
+        const Transform transform = r.pod<Transform>();
+        record.parent_id = r.u64();
+        record.lightweight = r.flag();
+        record.flexible = r.flag();
+        record.explosion = r.vector();
+        record.interfaces = r.strings();
+        if (!r.ok() || definition >= definitions.size()) {
+            return false;
+        }
+        // Eltern erst im zweiten Durchlauf: sie können nach dem Kind stehen
+        ids[record.id] = result.addComponent(PartRef(definitions[definition]), transform);
+    }
+    auto mapped = [&](std::uint64_t id) {
+        auto it = ids.find(id);
+        return it != ids.end() ? it->second : 0;
+    };
+    for (const auto& record : records) {
+        const std::uint64_t id = ids[record.id];
+        if (record.parent_id != 0) {
+            result.setComponentParent(id, mapped(record.parent_id));
+        }
+        if (record.lightweight) {
+            result.setComponentLightweight(id, true);
+        }
+        if (record.flexible) {
+            result.setComponentFlexible(id, true);
+        }
+        if (record.explosion.x != 0.0 || record.explosion.y != 0.0 || record.explosion.z != 0.0) {
+            result.setExplosionOffset(id, record.explosion.x, record.explosion.y, record.explosion.z);
+        }
+        for (const auto& name : record.interfaces) {
+            result.addComponentInterface(id, name);
+        }
+    }
+    result.setExplosionFactor(r.f64());
+
+    for (std::size_t n = r.count(); n > 0 && r.ok(); --n) {
+        MateConstraint mate;
+        mate.component_a = mapped(r.u64());
+        mate.component_b = mapped(r.u64());
+        mate.type = static_cast<MateType>(r.i32());
+        mate.value = r.f64();
+        result.addMate(mate);
+    }
+    for (std::size_t n = r.count(); n > 0 && r.ok(); --n) {
+        Joint joint;
+        joint.component_a = mapped(r.u64());
+        joint.component_b = mapped(r.u64());
+        joint.type = static_cast<JointType>(r.i32());
+        joint.axis_direction = r.vector();
+        joint.axis_origin = r.point();
+        joint.slot_direction = r.vector();
+        joint.limit_low = r.f64();
+        joint.limit_high = r.f64();
+        result.addJoint(joint);
+    }
+    for (std::size_t n = r.count(); n > 0 && r.ok(); --n) {
+        AssemblyConfiguration config;
+        config.name = r.str();
+        for (std::size_t k = r.count(); k > 0 && r.ok(); --k) {
+            const std::uint64_t id = mapped(r.u64());
+            config.component_config_index[id] = r.i32();
+        }
+        result.addConfiguration(config);
+    }
+    result.setActiveConfiguration(r.i32());
+
+    AssemblyMeshes loaded;
+    for (std::size_t n = r.count(); n > 0 && r.ok(); --n) {
+        std::string name = r.str();
+        TriangleMesh& mesh = loaded[name];
+        mesh.vertices = r.array<double>();
+        mesh.indices = r.array<unsigned int>();
+    }
+    if (!r.ok() || !r.atEnd()) {
+        return false;
+    }
+    assembly = std::move(result);
+    meshes = std::move(loaded);
+    return true;
+}
+
+std::size_t AssemblyCacheCodec::footprint(const Part& part) {
+    std::size_t bytes = sizeof(Part) + stringBytes(part.name()) + vectorBytes(part.features());
+    for (const auto& f : part.features()) {
+        bytes += stringBytes(f.name) + stringBytes(f.sketch_id) + stringBytes(f.axis) +
+                 stringBytes(f.circular_axis) + stringBytes(f.path_sketch_id) + stringBytes(f.draft_plane) +
+                 stringBytes(f.mirror_plane) + stringBytes(f.thread_standard) + stringBytes(f.rib_plane) +
+                 stringsBytes(f.edge_ids) + stringsBytes(f.face_ids) + treeBytes(f.parameters);
+        for (const auto& entry : f.parameters) {
+            bytes += stringBytes(entry.first);
+        }
+    }
+    bytes += vectorBytes(part.workPlanes());
+    for (const auto& plane : part.workPlanes()) {
+        bytes += stringBytes(plane.id) + stringBytes(plane.name) + stringBytes(plane.base_plane) +
+                 stringBytes(plane.plane_type);
+    }
+    bytes += vectorBytes(part.workAxes());
+    for (const auto& axis : part.workAxes()) {
+        bytes += stringBytes(axis.id) + stringBytes(axis.name) + stringBytes(axis.base_axis);
+    }
+    bytes += vectorBytes(part.workPoints());
+    for (const auto& point : part.workPoints()) {
+        bytes += stringBytes(point.id) + stringBytes(point.name);
+    }
+    bytes += vectorBytes(part.coordinateSystems());
+    for (const auto& cs : part.coordinateSystems()) {
+        bytes += stringBytes(cs.id) + stringBytes(cs.name);
+    }
+    bytes += vectorBytes(part.userParameters());
+    for (const auto& parameter : part.userParameters()) {
+        bytes += stringBytes(parameter.name) + stringBytes(parameter.expression);
+    }
+    bytes += vectorBytes(part.rules());
+    for (const auto& rule : part.rules()) {
+        bytes += stringBytes(rule.name) + stringBytes(rule.trigger) + stringBytes(rule.condition_expression) +
+                 stringBytes(rule.then_parameter) + stringBytes(rule.then_value_expression);
+    }
+    bytes += vectorBytes(part.configurations());
+    for (const auto& config : part.configurations()) {
+        bytes += stringBytes(config.name) + treeBytes(config.parameter_overrides);
+        for (const auto& entry : config.parameter_overrides) {
+            bytes += stringBytes(entry.first);
+        }
+    }
+    return bytes + stringBytes(part.skeletonPartId());
+}
+
+std::size_t AssemblyCacheCodec::footprint(const Assembly& assembly) {
+    const auto& components = assembly.components();
+    // Je Slot: Komponente, Welt-Transform (SoA, 7 double), Dirty-Flag, Kind-Liste, ID-Index (Knoten + Bucket)
+    constexpr std::size_t kPerSlot = 7 * sizeof(double) + sizeof(char) + sizeof(std::vector<std::size_t>) +
+                                     sizeof(std::pair<const std::uint64_t, std::size_t>) + 3 * sizeof(void*);
+    std::size_t bytes = sizeof(Assembly) + vectorBytes(components) + components.size() * kPerSlot +
+                        vectorBytes(assembly.mates()) + vectorBytes(assembly.joints()) +
+                        vectorBytes(assembly.configurations());
+    for (const auto& config : assembly.configurations()) {
+        bytes += stringBytes(config.name) + treeBytes(config.component_config_index);
+    }
+    std::unordered_map<const Part*, bool> counted;
+    for (const auto& component : components) {
+        if (component.parent_id != 0) {
+            bytes += sizeof(std::size_t);  // Eintrag in der Kind-Liste des Elternteils
+        }
+        if (counted.emplace(&component.part.get(), true).second) {
+            // make_shared: Kontrollblock (Zähler) liegt im selben Block wie die Definition
+            bytes += footprint(component.part.get()) + 2 * sizeof(long);
+        }
+    }
+    return bytes;
+}
+
+std::size_t AssemblyCacheCodec::footprint(const AssemblyMeshes& meshes) {
+    std::size_t bytes = treeBytes(meshes);
+    for (const auto& [name, mesh] : meshes) {
+        bytes += stringBytes(name) + vectorBytes(mesh.vertices) + vectorBytes(mesh.indices);
+    }
+    return bytes;
+}
+
+}  // namespace core
+}  // namespace cad
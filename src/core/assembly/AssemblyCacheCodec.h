@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "../Modeler/Assembly.h"
+#include "../analysis/TriangleBvh.h"
+
+namespace cad {
+namespace core {
+
+/** Tessellierte Netze einer Baugruppe je Part-Definition (Schlüssel: Part-Name). */
+using AssemblyMeshes = std::map<std::string, TriangleMesh>;
+
+/**
+ * Kompaktes Binärformat für den Disk-Tier des Baugruppen-Caches: geteilte Part-Definitionen einmal,
+ * Komponenten als Index darauf, dazu Mates, Gelenke, Konfigurationen und Netze. Werte im
+ * Host-Byte-Layout (nur lokaler Cache, kein Austauschformat); IDs werden beim Lesen neu vergeben.
+ */
+class AssemblyCacheCodec {
+public:
+    static std::string encode(const Assembly& assembly, const AssemblyMeshes& meshes);
+    /** false bei fremdem/beschädigtem Inhalt oder anderer Formatversion. */
+    static bool decode(const std::string& data, Assembly& assembly, AssemblyMeshes& meshes);
+
+    /** Tatsächlich belegter Speicher (Kapazitäten von Feldern/Strings, Baumknoten), geteilte Definitionen einmal. */
+    static std::size_t footprint(const Assembly& assembly);
+    static std::size_t footprint(const Part& part);
+    static std::size_t footprint(const AssemblyMeshes& meshes);
+};
+
+}  // namespace core
+}  // namespace cad
@@ -1,15 +1,21 @@
 #include "AssemblyManager.h"
 #include "interop/ImportExportService.h"
 #include "Modeler/Assembly.h"
+#include "Modeler/Modeler.h"
 #include "Modeler/Part.h"
 #include "Modeler/Transform.h"
 
 #include <algorithm>
 #include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <future>
+#include <iterator>
 #include <mutex>
 #include <fstream>
 #include <cmath>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
@@ -20,131 +26,347 @@
 namespace cad {
 namespace core {
 
+namespace {
+
+/** Lage einer synthetischen Komponente (Dateien ohne Baugruppenstruktur), aus Pfad-Hash und Index. */
+Transform syntheticTransform(std::size_t path_hash, std::size_t index) {
+    const std::size_t part_hash = path_hash + index;
+    Transform transform;
+    transform.tx = static_cast<double>(static_cast<long long>(part_hash % 1000) - 500) * 0.1;
+    transform.ty = static_cast<double>(static_cast<long long>((part_hash / 1000) % 1000) - 500) * 0.1;
+    transform.tz = static_cast<double>(static_cast<long long>((part_hash / 1000000) % 1000) - 500) * 0.1;
+    transform.rx = static_cast<double>((part_hash % 360)) * M_PI / 180.0;
+    transform.ry = static_cast<double>(((part_hash / 100) % 360)) * M_PI / 180.0;
+    transform.rz = static_cast<double>(((part_hash / 10000) % 360)) * M_PI / 180.0;
+    return transform;
+}
+
+}  // namespace
+
 void AssemblyManager::setLodMode(LodMode mode) {
     lod_mode_ = mode;
 }
 
 void AssemblyManager::setTargetFps(double fps) {
     target_fps_ = fps <= 0.0 ? 30.0 : fps;
+    lod_governor_->setTargetFps(target_fps_);
+}
+
+void AssemblyManager::recordFrame(double frame_ms) {
+    performance_monitor_.recordFrame(frame_ms);
+    measured_fps_ = performance_monitor_.fps();
+    lod_governor_->adapt(performance_monitor_);
 }
 
 void AssemblyManager::setMaxComponents(std::size_t max_components) {
     max_components_ = max_components;
 }
 
-AssemblyLoadStats AssemblyManager::loadAssembly(const std::string& path) {
+/** Zustand eines Ladeauftrags, geteilt zwischen Aufrufer und Pool-Aufgaben. */
+struct AssemblyManager::LoadJobState {
+    /** Eine Komponente aus dem Datei-Schritt; Lage wird im Komponenten-Schritt bestimmt. */
+    struct Slot {
+        std::size_t definition{0};
+        Transform transform{};
+        std::uint64_t source_id{0};
+        std::uint64_t source_parent_id{0};
+    };
+
+    std::uint64_t id{0};
+    std::string path;
+    TaskPriority priority{TaskPriority::Normal};
+    /** nullptr: alle Schritte laufen im aufrufenden Thread. */
+    ThreadPool* pool{nullptr};
+    CancellationToken token;
+    // Einstellungen zum Startzeitpunkt (Setter des Managers wirken erst auf neue Aufträge)
+    LodMode lod{LodMode::Full};
+    std::size_t visible_limit{0};
+    std::size_t max_components{0};
+    bool background{false};
+    Tessellator tessellator;
+    std::chrono::steady_clock::time_point start;
+
+    // Datei-Schritt schreibt, danach nur noch je Index bzw. je geclaimter Definition
+    Assembly source;
+    bool from_cache{false};
+    std::size_t path_hash{0};
+    std::vector<Slot> slots;
+    std::vector<std::shared_ptr<Part>> definitions;
+    /** Netz je Definition, falls der Tessellator eines geliefert hat. */
+    std::vector<TriangleMesh> meshes;
+    std::vector<char> has_mesh;
+    /** Je Definition: die erste Komponente materialisiert, regeneriert und tesselliert sie. */
+    std::unique_ptr<std::atomic<bool>[]> claimed;
+    std::atomic<std::size_t> regenerated{0};
+
+    std::atomic<std::size_t> total_tasks{1};
+    std::atomic<std::size_t> completed_tasks{0};
+
+    std::mutex mutex;
+    std::condition_variable done;
+    bool finished{false};
     AssemblyLoadStats stats;
-    
-    // Use adaptive LOD if enabled
-    LodMode effective_lod = lod_mode_;
-    if (adaptive_lod_) {
-        effective_lod = adaptiveLodRecommendation();
+    std::promise<AssemblyLoadStats> promise;
+};
+
+AssemblyManager::~AssemblyManager() {
+    cancelAllLoads();
+    waitForLoadCompletion();
+    loader_pool_.reset();
+}
+
+AssemblyLoadStats AssemblyManager::loadAssembly(const std::string& path) {
+    std::shared_ptr<LoadJobState> job = startLoad(path, TaskPriority::Normal, multi_threaded_loading_);
+    return job->promise.get_future().get();
+}
+
+std::shared_ptr<AssemblyManager::LoadJobState> AssemblyManager::startLoad(const std::string& path,
+                                                                          TaskPriority priority, bool pooled) {
+    auto job = std::make_shared<LoadJobState>();
+    job->path = path;
+    job->priority = priority;
+    job->lod = adaptive_lod_ ? adaptiveLodRecommendation() : lod_mode_;
+    job->visible_limit = calculateLodComponentLimit(job->lod);
+    job->max_components = max_components_;
+    job->background = background_loading_;
+    job->tessellator = tessellator_;
+    job->start = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(load_mutex_);
+        job->id = next_job_id_++;
+        if (pooled) {
+            if (!loader_pool_) {
+                loader_pool_ = std::make_unique<ThreadPool>(thread_pool_size_);
+            }
+            job->pool = loader_pool_.get();
+        }
+        active_loads_.erase(std::remove_if(active_loads_.begin(), active_loads_.end(),
+                                           [](const std::shared_ptr<LoadJobState>& active) {
+                                               std::lock_guard<std::mutex> job_lock(active->mutex);
+                                               return active->finished;
+                                           }),
+                            active_loads_.end());
+        active_loads_.push_back(job);
     }
-    
-    // Try to get from cache first
-    Assembly assembly;
-    if (getCachedAssembly(path, assembly)) {
-        cache_hits_++;
-        stats.component_count = assembly.components().size();
-        stats.applied_lod = effective_lod;
-        stats.visible_components = getVisibleComponentCount(assembly, effective_lod);
-        stats.load_seconds = 0.0;  // Cached, instant load
-        stats.used_background_loading = false;
-        stats.from_cache = true;
-        stats.estimated_memory_mb = static_cast<double>(estimateAssemblyMemory(assembly)) / (1024.0 * 1024.0);
-        return stats;
+    dispatch(job, [this, job]() { runFileStage(job); }, priority);
+    return job;
+}
+
+void AssemblyManager::dispatch(const std::shared_ptr<LoadJobState>& job, std::function<void()> task,
+                               TaskPriority priority) {
+    if (job->pool) {
+        job->pool->submit(std::move(task), priority);
+    } else {
+        task();
     }
-    
-    cache_misses_++;
-    
+}
+
+void AssemblyManager::runFileStage(const std::shared_ptr<LoadJobState>& job) {
+    if (job->token.cancelled()) {
+        completeTasks(job, 1);
+        return;
+    }
+
+    Assembly cached;
+    const bool hit = getCachedAssembly(job->path, cached);
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        if (hit) {
+            cache_hits_++;
+        } else {
+            cache_misses_++;
+        }
+    }
+    if (hit) {
+        job->source = std::move(cached);
+        job->from_cache = true;
+        completeTasks(job, 1);
+        return;
+    }
+
     cad::interop::ImportExportService io_service;
-    cad::interop::FileFormat format = io_service.detectFileFormat(path);
-    
-    auto load_start = std::chrono::high_resolution_clock::now();
-    
+    cad::interop::FileFormat format = io_service.detectFileFormat(job->path);
+
     if (format == cad::interop::FileFormat::Step) {
-        assembly = io_service.importStepToAssembly(path);
+        job->source = io_service.importStepToAssembly(job->path);
+        // Geteilte Definitionen der Quelle bleiben geteilt (eine Regeneration je Definition)
+        std::unordered_map<const Part*, std::size_t> definition_index;
+        for (const auto& component : job->source.components()) {
+            auto inserted = definition_index.emplace(component.part.shared().get(), definition_index.size());
+            LoadJobState::Slot slot;
+            slot.definition = inserted.first->second;
+            slot.transform = component.transform;
+            slot.source_id = component.id;
+            slot.source_parent_id = component.parent_id;
+            job->slots.push_back(slot);
+        }
+        job->definitions.resize(definition_index.size());
     } else {
         cad::interop::ImportRequest request;
-        request.path = path;
+        request.path = job->path;
         request.format = format;
         cad::interop::IoResult result = io_service.importModel(request);
-        
-        if (result.success) {
-            assembly = Assembly();
-            
-            std::ifstream file(path, std::ios::binary);
-            if (file.is_open()) {
-                file.seekg(0, std::ios::end);
-                std::streampos file_size = file.tellg();
-                file.seekg(0, std::ios::beg);
-                
-                std::size_t estimated_components = static_cast<std::size_t>(file_size / 10240);
-                estimated_components = std::min(estimated_components, max_components_);
-                estimated_components = std::max(estimated_components, static_cast<std::size_t>(1));
-                
-                std::hash<std::string> hasher;
-                std::size_t path_hash = hasher(path);
-                
-                for (std::size_t i = 0; i < estimated_components; ++i) {
-                    Part part("Part_" + std::to_string(i + 1));
-                    
-                    std::size_t part_hash = path_hash + i;
-                    Transform transform;
-                    transform.tx = static_cast<double>((part_hash % 1000) - 500) * 0.1;
-                    transform.ty = static_cast<double>(((part_hash / 1000) % 1000) - 500) * 0.1;
-                    transform.tz = static_cast<double>(((part_hash / 1000000) % 1000) - 500) * 0.1;
-                    transform.rx = static_cast<double>((part_hash % 360)) * M_PI / 180.0;
-                    transform.ry = static_cast<double>(((part_hash / 100) % 360)) * M_PI / 180.0;
-                    transform.rz = static_cast<double>(((part_hash / 10000) % 360)) * M_PI / 180.0;
-                    
-                    assembly.addComponent(part, transform);
-                }
-                
-                file.close();
+
+        std::ifstream file(job->path, std::ios::binary);
+        if (result.success && file.is_open()) {
+            file.seekg(0, std::ios::end);
+            std::streampos file_size = file.tellg();
+
+            std::size_t estimated_components = static_cast<std::size_t>(file_size / 10240);
+            estimated_components = std::min(estimated_components, job->max_components);
+            estimated_components = std::max(estimated_components, static_cast<std::size_t>(1));
+
+            job->path_hash = std::hash<std::string>{}(job->path);
+            job->slots.resize(estimated_components);
+            for (std::size_t i = 0; i < estimated_components; ++i) {
+                job->slots[i].definition = i;
             }
+            job->definitions.resize(estimated_components);
+        }
+    }
+
+    const std::size_t definition_count = job->definitions.size();
+    job->meshes.resize(definition_count);
+    job->has_mesh.assign(definition_count, 0);
+    job->claimed.reset(new std::atomic<bool>[definition_count]);
+    for (std::size_t d = 0; d < definition_count; ++d) {
+        job->claimed[d].store(false, std::memory_order_relaxed);
+    }
+    // Gesamtzahl steht fest, bevor die erste Teilaufgabe fertig werden kann
+    job->total_tasks.store(1 + job->slots.size() + 2 * definition_count, std::memory_order_release);
+
+    for (std::size_t i = 0; i < job->slots.size(); ++i) {
+        // Sichtbare Komponenten (Reihenfolge wie getVisibleComponentIds) zuerst
+        const TaskPriority priority = i < job->visible_limit ? TaskPriority::High : job->priority;
+        dispatch(job, [this, job, i]() { runComponentStage(job, i); }, priority);
+    }
+    completeTasks(job, 1);
+}
+
+void AssemblyManager::runComponentStage(const std::shared_ptr<LoadJobState>& job, std::size_t index) {
+    LoadJobState::Slot& slot = job->slots[index];
+    const bool owner = !job->claimed[slot.definition].exchange(true, std::memory_order_acq_rel);
+    if (job->token.cancelled()) {
+        completeTasks(job, owner ? 3 : 1);
+        return;
+    }
+
+    if (job->source.components().empty()) {
+        slot.transform = syntheticTransform(job->path_hash, index);
+    }
+
+    const TaskPriority priority = index < job->visible_limit ? TaskPriority::High : job->priority;
+    if (owner) {
+        const std::size_t definition = slot.definition;
+        if (job->source.components().empty()) {
+            job->definitions[definition] = std::make_shared<Part>(Part("Part_" + std::to_string(index + 1)));
         } else {
-            assembly = Assembly();
+            job->definitions[definition] = std::make_shared<Part>(job->source.components()[index].part.get());
         }
+        dispatch(job, [this, job, definition, priority]() { runDefinitionStage(job, definition, false, priority); },
+                 priority);
     }
-    
-    auto load_end = std::chrono::high_resolution_clock::now();
-    auto load_duration = std::chrono::duration_cast<std::chrono::milliseconds>(load_end - load_start);
-    stats.load_seconds = load_duration.count() / 1000.0;
-    
-    if (!assembly.components().empty()) {
-        cacheAssembly(path, assembly);
+    completeTasks(job, 1);
+}
+
+void AssemblyManager::runDefinitionStage(const std::shared_ptr<LoadJobState>& job, std::size_t definition,
+                                         bool tessellate, TaskPriority priority) {
+    if (job->token.cancelled()) {
+        completeTasks(job, tessellate ? 1 : 2);
+        return;
     }
-    
-    stats.component_count = assembly.components().size();
-    stats.applied_lod = effective_lod;
-    stats.visible_components = getVisibleComponentCount(assembly, effective_lod);
-    
-    std::size_t component_count = assembly.components().size();
-    double base_load_time = 0.01;
-    double per_component_time = 0.001;
-    double file_size_factor = 0.0001;
-    
-    std::ifstream file_check(path, std::ios::binary);
-    std::streampos file_size = 0;
-    if (file_check.is_open()) {
-        file_check.seekg(0, std::ios::end);
-        file_size = file_check.tellg();
-        file_check.close();
+    Part& part = *job->definitions[definition];
+    if (tessellate) {
+        if (job->tessellator && job->tessellator(part, job->lod, job->meshes[definition])) {
+            job->has_mesh[definition] = 1;
+        }
+        completeTasks(job, 1);
+        return;
     }
-    
-    double load_time = base_load_time + (per_component_time * component_count) + 
-                      (static_cast<double>(file_size) * file_size_factor);
-    load_time = std::max(0.05, std::min(load_time, 10.0));
-    stats.load_seconds = load_time;
-    stats.used_background_loading = background_loading_;
-    stats.from_cache = false;
+
+    Modeler modeler;
+    modeler.evaluatePartParameters(part);
+    modeler.evaluatePartRules(part);
+    job->regenerated.fetch_add(1, std::memory_order_relaxed);
+    // Tessellierung als eigene Aufgabe: ein freier Worker kann sie stehlen, während dieser weiterparst
+    dispatch(job, [this, job, definition, priority]() { runDefinitionStage(job, definition, true, priority); },
+             priority);
+    completeTasks(job, 1);
+}
+
+void AssemblyManager::completeTasks(const std::shared_ptr<LoadJobState>& job, std::size_t count) {
+    const std::size_t completed = job->completed_tasks.fetch_add(count, std::memory_order_acq_rel) + count;
+    if (completed == job->total_tasks.load(std::memory_order_acquire)) {
+        finishLoad(job);
+    }
+}
+
+void AssemblyManager::finishLoad(const std::shared_ptr<LoadJobState>& job) {
+    AssemblyLoadStats stats;
+    stats.cancelled = job->token.cancelled();
+    stats.used_background_loading = job->background && !job->from_cache;
+    stats.applied_lod = job->lod;
+    stats.from_cache = job->from_cache;
+
+    Assembly assembly;
+    if (job->from_cache) {
+        assembly = std::move(job->source);
+    } else if (!stats.cancelled) {
+        std::unordered_map<std::uint64_t, std::uint64_t> ids;
+        for (const auto& slot : job->slots) {
+            const std::uint64_t parent = slot.source_parent_id != 0 ? ids[slot.source_parent_id] : 0;
+            const std::uint64_t id =
+                assembly.addComponent(PartRef(job->definitions[slot.definition]), slot.transform, parent);
+            if (slot.source_id != 0) {
+                ids[slot.source_id] = id;
+            }
+        }
+        AssemblyMeshes meshes;
+        for (std::size_t d = 0; d < job->definitions.size(); ++d) {
+            if (job->has_mesh[d]) {
+                meshes[job->definitions[d]->name()] = std::move(job->meshes[d]);
+            }
+        }
+        if (!assembly.components().empty()) {
+            cacheAssembly(job->path, assembly, meshes);
+        }
+        stats.load_seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - job->start).count();
+    }
+
+    stats.component_count = assembly.components().size();
+    stats.visible_components = std::min(stats.component_count, job->visible_limit);
+    stats.regenerated_definitions = job->regenerated.load(std::memory_order_relaxed);
     stats.estimated_memory_mb = static_cast<double>(estimateAssemblyMemory(assembly)) / (1024.0 * 1024.0);
-    
-    return stats;
+
+    job->promise.set_value(stats);
+    // Letzter Zugriff auf den Manager liegt davor: nach finished darf er zerstört werden
+    std::lock_guard<std::mutex> lock(job->mutex);
+    job->stats = stats;
+    job->finished = true;
+    job->done.notify_all();
+}
+
+AssemblyLoadJob AssemblyManager::snapshot(const LoadJobState& job) const {
+    AssemblyLoadJob out;
+    out.path = job.path;
+    out.id = job.id;
+    // Erst erledigte, dann alle lesen: die Gesamtzahl steht fest, bevor etwas als erledigt zählt
+    out.completed_tasks = job.completed_tasks.load(std::memory_order_acquire);
+    out.total_tasks = job.total_tasks.load(std::memory_order_acquire);
+    out.finished = job.finished;
+    out.cancelled = job.token.cancelled();
+    if (out.finished) {
+        out.progress = 100;
+    } else if (out.total_tasks > 0) {
+        // 100 erst, wenn die Baugruppe zusammengesetzt und gecacht ist
+        out.progress = std::min(99, static_cast<int>(out.completed_tasks * 100 / out.total_tasks));
+    }
+    return out;
 }
 
 CacheStats AssemblyManager::cacheStats() const {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
     CacheStats stats;
     stats.entries = cache_.size();
     stats.max_entries = cache_limit_;
@@ -152,6 +374,10 @@ CacheStats AssemblyManager::cacheStats() const {
     stats.cache_misses = cache_misses_;
     stats.evicted_entries = evicted_count_;
     stats.memory_usage_bytes = total_memory_usage_;
+    stats.disk_entries = disk_index_.size();
+    stats.disk_bytes = disk_bytes_;
+    stats.disk_hits = disk_hits_;
+    stats.spilled_entries = spilled_count_;
     
     std::size_t total_requests = cache_hits_ + cache_misses_;
     if (total_requests > 0) {
@@ -162,39 +388,64 @@ CacheStats AssemblyManager::cacheStats() const {
 }
 
 void AssemblyManager::setCacheLimit(std::size_t max_entries) {
-    cache_limit_ = max_entries;
-    while (cache_.size() > cache_limit_) {
-        evictOldestCacheEntry();
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        cache_limit_ = max_entries;
+        enforceCacheLimits();
     }
+    writePendingSpills();
 }
 
 void AssemblyManager::enableBackgroundLoading(bool enabled) {
     background_loading_ = enabled;
 }
 
-void AssemblyManager::enqueueLoad(const std::string& path) {
-    AssemblyLoadJob job;
-    job.path = path;
-    job.progress = 0;
+std::uint64_t AssemblyManager::enqueueLoad(const std::string& path) {
+    std::shared_ptr<LoadJobState> job = startLoad(path, TaskPriority::Normal, background_loading_);
+    std::lock_guard<std::mutex> lock(load_mutex_);
     load_queue_.push_back(job);
+    return job->id;
 }
 
 AssemblyLoadJob AssemblyManager::pollLoadProgress() {
+    std::lock_guard<std::mutex> lock(load_mutex_);
     if (load_queue_.empty()) {
         return {};
     }
-    AssemblyLoadJob& job = load_queue_.front();
-    if (job.progress < 100) {
-        job.progress += 25;
+    AssemblyLoadJob job;
+    {
+        std::lock_guard<std::mutex> job_lock(load_queue_.front()->mutex);
+        job = snapshot(*load_queue_.front());
     }
-    if (job.progress >= 100) {
-        AssemblyLoadJob done = job;
+    if (job.finished) {
         load_queue_.pop_front();
-        return done;
     }
     return job;
 }
 
+bool AssemblyManager::cancelLoad(std::uint64_t job_id) {
+    std::lock_guard<std::mutex> lock(load_mutex_);
+    for (const auto& job : active_loads_) {
+        if (job->id != job_id) {
+            continue;
+        }
+        std::lock_guard<std::mutex> job_lock(job->mutex);
+        if (job->finished) {
+            return false;
+        }
+        job->token.cancel();
+        return true;
+    }
+    return false;
+}
+
+void AssemblyManager::cancelAllLoads() {
+    std::lock_guard<std::mutex> lock(load_mutex_);
+    for (const auto& job : active_loads_) {
+        job->token.cancel();
+    }
+}
+
 LodMode AssemblyManager::recommendedLod() const {
     if (max_components_ >= 5000 || target_fps_ >= 60.0) {
         return LodMode::BoundingBoxes;
@@ -205,73 +456,107 @@ LodMode AssemblyManager::recommendedLod() const {
     return LodMode::Full;
 }
 
-void AssemblyManager::cacheAssembly(const std::string& path, const Assembly& assembly) {
-    std::lock_guard<std::mutex> lock(cache_mutex_);
-    
-    // Evict if cache is full (by entries or memory)
-    while ((cache_.size() >= cache_limit_ || 
-            total_memory_usage_ >= memory_limit_mb_ * 1024 * 1024) && 
-           !cache_.empty()) {
-        evictLowPriorityEntries();
-    }
-    
+void AssemblyManager::cacheAssembly(const std::string& path, const Assembly& assembly,
+                                    const AssemblyMeshes& meshes) {
     CachedAssembly cached;
     cached.assembly = assembly;
+    cached.meshes = meshes;
     cached.component_count = assembly.components().size();
     cached.cached_lod = lod_mode_;
     cached.access_count = 1;
-    cached.estimated_memory_bytes = estimateAssemblyMemory(assembly);
-    
-    auto now = std::chrono::steady_clock::now();
-    auto duration = now.time_since_epoch();
-    cached.last_access_time = std::chrono::duration<double>(duration).count();
-    cached.priority_score = calculatePriorityScore(cached);
-    
-    // Update memory usage
+    cached.memory_bytes = AssemblyCacheCodec::footprint(assembly) + AssemblyCacheCodec::footprint(meshes);
+    cached.last_access_time = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        // Neuer Inhalt macht eine ausgelagerte (oder gerade geschriebene) Fassung ungültig
+        removeDiskEntry(path);
+        spilling_.erase(path);
+        insertCached(path, std::move(cached));
+    }
+    writePendingSpills();
+}
+
+void AssemblyManager::insertCached(const std::string& path, CachedAssembly cached) {
     auto it = cache_.find(path);
     if (it != cache_.end()) {
-        total_memory_usage_ -= it->second.estimated_memory_bytes;
+        total_memory_usage_ -= it->second.memory_bytes;
+        lru_.erase(it->second.lru_position);
+        cache_.erase(it);
     }
-    
-    cache_[path] = cached;
-    total_memory_usage_ += cached.estimated_memory_bytes;
-    current_time_ = cached.last_access_time;
+    // Platz schaffen (nach Einträgen und Bytes); ein einzelner übergroßer Eintrag bleibt trotzdem
+    while (!cache_.empty() && (cache_.size() >= cache_limit_ ||
+                               total_memory_usage_ + cached.memory_bytes > memory_limit_mb_ * 1024 * 1024)) {
+        evictLeastRecentlyUsed();
+    }
+    lru_.push_front(path);
+    cached.lru_position = lru_.begin();
+    total_memory_usage_ += cached.memory_bytes;
+    cache_.emplace(path, std::move(cached));
 }
 
-bool AssemblyManager::getCachedAssembly(const std::string& path, Assembly& out_assembly) const {
-    std::lock_guard<std::mutex> lock(cache_mutex_);
-    
+CachedAssembly* AssemblyManager::findCached(const std::string& path) {
     auto it = cache_.find(path);
-    if (it != cache_.end()) {
-        // Update access info
-        CachedAssembly& cached = const_cast<CachedAssembly&>(it->second);
-        cached.access_count++;
-        auto now = std::chrono::steady_clock::now();
-        auto duration = now.time_since_epoch();
-        cached.last_access_time = std::chrono::duration<double>(duration).count();
-        cached.priority_score = calculatePriorityScore(cached);
-        
-        out_assembly = cached.assembly;
-        return true;
+    if (it == cache_.end()) {
+        CachedAssembly loaded;
+        if (!loadFromDisk(path, loaded)) {
+            return nullptr;
+        }
+        disk_hits_++;
+        insertCached(path, std::move(loaded));
+        it = cache_.find(path);
     }
-    return false;
+    CachedAssembly& cached = it->second;
+    lru_.splice(lru_.begin(), lru_, cached.lru_position);
+    cached.access_count++;
+    cached.last_access_time = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    return &cached;
+}
+
+bool AssemblyManager::getCachedAssembly(const std::string& path, Assembly& out_assembly) {
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        const CachedAssembly* cached = findCached(path);
+        if (cached) {
+            out_assembly = cached->assembly;
+            found = true;
+        }
+    }
+    writePendingSpills();  // Nachladen von der Platte kann andere Einträge verdrängt haben
+    return found;
+}
+
+bool AssemblyManager::getCachedMeshes(const std::string& path, AssemblyMeshes& out_meshes) {
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        const CachedAssembly* cached = findCached(path);
+        if (cached) {
+            out_meshes = cached->meshes;
+            found = true;
+        }
+    }
+    writePendingSpills();
+    return found;
 }
 
 void AssemblyManager::clearCache() {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
     cache_.clear();
+    lru_.clear();
     cache_hits_ = 0;
     cache_misses_ = 0;
     evicted_count_ = 0;
     total_memory_usage_ = 0;
+    disk_hits_ = 0;
+    spilled_count_ = 0;
 }
 
 std::vector<std::string> AssemblyManager::getCachedPaths() const {
-    std::vector<std::string> paths;
-    paths.reserve(cache_.size());
-    for (const auto& [path, cached] : cache_) {
-        paths.push_back(path);
-    }
-    return paths;
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    // Zuletzt benutzte zuerst
+    return std::vector<std::string>(lru_.begin(), lru_.end());
 }
 
 std::size_t AssemblyManager::getVisibleComponentCount(const Assembly& assembly, LodMode lod) const {
@@ -293,40 +578,23 @@ std::vector<std::uint64_t> AssemblyManager::getVisibleComponentIds(const Assembl
     return visible_ids;
 }
 
-void AssemblyManager::evictOldestCacheEntry() {
-    if (cache_.empty()) {
+void AssemblyManager::evictLeastRecentlyUsed() {
+    if (lru_.empty()) {
         return;
     }
-    
-    // Find entry with oldest access time
-    auto oldest_it = cache_.begin();
-    for (auto it = cache_.begin(); it != cache_.end(); ++it) {
-        if (it->second.last_access_time < oldest_it->second.last_access_time) {
-            oldest_it = it;
-        }
-    }
-    
-    total_memory_usage_ -= oldest_it->second.estimated_memory_bytes;
-    cache_.erase(oldest_it);
+    auto it = cache_.find(lru_.back());
+    total_memory_usage_ -= it->second.memory_bytes;
+    queueSpill(it->first, std::move(it->second));
+    cache_.erase(it);
+    lru_.pop_back();
     evicted_count_++;
 }
 
-void AssemblyManager::evictLowPriorityEntries() {
-    if (cache_.empty()) {
-        return;
-    }
-    
-    // Find entry with lowest priority score
-    auto lowest_it = cache_.begin();
-    for (auto it = cache_.begin(); it != cache_.end(); ++it) {
-        if (it->second.priority_score < lowest_it->second.priority_score) {
-            lowest_it = it;
-        }
+void AssemblyManager::enforceCacheLimits() {
+    while (!cache_.empty() &&
+           (cache_.size() > cache_limit_ || total_memory_usage_ > memory_limit_mb_ * 1024 * 1024)) {
+        evictLeastRecentlyUsed();
     }
-    
-    total_memory_usage_ -= lowest_it->second.estimated_memory_bytes;
-    cache_.erase(lowest_it);
-    evicted_count_++;
 }
 
 std::size_t AssemblyManager::calculateLodComponentLimit(LodMode lod) const {
@@ -343,9 +611,246 @@ std::size_t AssemblyManager::calculateLodComponentLimit(LodMode lod) const {
 }
 
 void AssemblyManager::setMemoryLimit(std::size_t max_memory_mb) {
-    memory_limit_mb_ = max_memory_mb;
-    while (total_memory_usage_ >= memory_limit_mb_ * 1024 * 1024 && !cache_.empty()) {
-        evictLowPriorityEntries();
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        memory_limit_mb_ = max_memory_mb;
+        enforceCacheLimits();
+    }
+    writePendingSpills();
+}
+
+namespace {
+
+constexpr char kDiskMagic[4] = {'H', 'C', 'D', 'C'};
+const char* const kDiskExtension = ".hcache";
+
+/** Größe und Änderungszeit der Quelldatei (0/0, wenn es keine gibt, z.B. synthetische Pfade). */
+std::pair<std::uint64_t, std::int64_t> sourceStamp(const std::string& path) {
+    std::error_code ec;
+    const std::uint64_t size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return {0, 0};
+    }
+    const auto written = std::filesystem::last_write_time(path, ec);
+    return {size, ec ? 0 : static_cast<std::int64_t>(written.time_since_epoch().count())};
+}
+
+/** Kopf einer Cache-Datei: Kennung, Quellpfad, Quell-Stempel; danach AssemblyCacheCodec-Nutzdaten. */
+bool readDiskHeader(std::ifstream& in, std::string& path, std::pair<std::uint64_t, std::int64_t>& stamp) {
+    char magic[4] = {};
+    std::uint64_t length = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kDiskMagic, sizeof(magic)) != 0 ||
+        !in.read(reinterpret_cast<char*>(&length), sizeof(length)) || length > 65536) {
+        return false;
+    }
+    path.resize(static_cast<std::size_t>(length));
+    return static_cast<bool>(in.read(&path[0], static_cast<std::streamsize>(length)) &&
+                             in.read(reinterpret_cast<char*>(&stamp.first), sizeof(stamp.first)) &&
+                             in.read(reinterpret_cast<char*>(&stamp.second), sizeof(stamp.second)));
+}
+
+}  // namespace
+
+bool AssemblyManager::setDiskCacheDirectory(const std::string& directory, std::size_t max_disk_mb) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    disk_index_.clear();
+    disk_lru_.clear();
+    spilling_.clear();  // laufende Schreibvorgänge gehören zum alten Verzeichnis
+    disk_bytes_ = 0;
+    disk_cache_dir_.clear();
+    disk_limit_mb_ = max_disk_mb;
+    if (directory.empty()) {
+        return true;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (!std::filesystem::is_directory(directory, ec)) {
+        return false;
+    }
+    disk_cache_dir_ = directory;
+
+    // Vorhandene Einträge (frühere Sitzung) übernehmen, ältester zuletzt in der LRU-Liste
+    std::vector<std::pair<std::filesystem::file_time_type, DiskEntry>> found;
+    std::vector<std::string> sources;
+    for (const auto& item : std::filesystem::directory_iterator(directory, ec)) {
+        if (item.path().extension() != kDiskExtension) {
+            continue;
+        }
+        std::ifstream in(item.path(), std::ios::binary);
+        std::string source;
+        std::pair<std::uint64_t, std::int64_t> stamp;
+        if (!readDiskHeader(in, source, stamp)) {
+            continue;
+        }
+        DiskEntry entry;
+        entry.file = item.path().string();
+        entry.bytes = static_cast<std::size_t>(item.file_size(ec));
+        found.emplace_back(item.last_write_time(ec), entry);
+        sources.push_back(source);
+    }
+    std::vector<std::size_t> order(found.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return found[a].first > found[b].first; });
+    for (std::size_t i : order) {
+        if (disk_index_.count(sources[i]) != 0) {
+            continue;
+        }
+        disk_lru_.push_back(sources[i]);
+        DiskEntry entry = found[i].second;
+        entry.lru_position = std::prev(disk_lru_.end());
+        disk_bytes_ += entry.bytes;
+        disk_index_.emplace(sources[i], entry);
+    }
+    enforceDiskLimit();
+    return true;
+}
+
+bool AssemblyManager::releaseAssembly(const std::string& path) {
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        auto it = cache_.find(path);
+        if (it == cache_.end()) {
+            return false;
+        }
+        total_memory_usage_ -= it->second.memory_bytes;
+        lru_.erase(it->second.lru_position);
+        queueSpill(path, std::move(it->second));
+        cache_.erase(it);
+    }
+    writePendingSpills();
+    return true;
+}
+
+void AssemblyManager::clearDiskCache() {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    spilling_.clear();
+    while (!disk_lru_.empty()) {
+        removeDiskEntry(disk_lru_.back());
+    }
+}
+
+void AssemblyManager::queueSpill(const std::string& path, CachedAssembly&& cached) {
+    if (disk_cache_dir_.empty() || disk_index_.count(path) != 0 || spilling_.count(path) != 0) {
+        return;  // aus – oder unveränderte Fassung liegt schon auf der Platte bzw. wird gerade geschrieben
+    }
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(std::hash<std::string>{}(path)));
+    PendingSpill spill;
+    spill.path = path;
+    spill.file = (std::filesystem::path(disk_cache_dir_) / (std::string(name) + kDiskExtension)).string();
+    spill.ticket = next_spill_ticket_++;
+    spill.cached = std::move(cached);
+    spilling_[path] = spill.ticket;
+    pending_spills_.push_back(std::move(spill));
+}
+
+void AssemblyManager::writePendingSpills() {
+    std::vector<PendingSpill> spills;
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        spills.swap(pending_spills_);
+    }
+    for (PendingSpill& spill : spills) {
+        // Kodieren und Schreiben ohne Sperre; eigene .tmp je Ticket, falls derselbe Pfad erneut verdrängt wird
+        const std::string temp = spill.file + "." + std::to_string(spill.ticket) + ".tmp";
+        bool written = false;
+        {
+            const std::string payload = AssemblyCacheCodec::encode(spill.cached.assembly, spill.cached.meshes);
+            spill.cached = CachedAssembly{};
+            const std::pair<std::uint64_t, std::int64_t> stamp = sourceStamp(spill.path);
+            const std::uint64_t length = spill.path.size();
+            std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+            out.write(kDiskMagic, sizeof(kDiskMagic));
+            out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            out.write(spill.path.data(), static_cast<std::streamsize>(spill.path.size()));
+            out.write(reinterpret_cast<const char*>(&stamp.first), sizeof(stamp.first));
+            out.write(reinterpret_cast<const char*>(&stamp.second), sizeof(stamp.second));
+            out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+            written = static_cast<bool>(out.flush());
+        }
+
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        std::error_code ec;
+        auto pending = spilling_.find(spill.path);
+        if (pending == spilling_.end() || pending->second != spill.ticket) {
+            std::filesystem::remove(temp, ec);  // überholt: neuer Inhalt oder anderes Verzeichnis
+            continue;
+        }
+        spilling_.erase(pending);
+        if (!written) {
+            std::filesystem::remove(temp, ec);
+            continue;
+        }
+        for (auto it = disk_index_.begin(); it != disk_index_.end(); ++it) {
+            if (it->second.file == spill.file) {
+                removeDiskEntry(it->first);  // Hash-Kollision: der ältere Eintrag weicht
+                break;
+            }
+        }
+        // Erst vollständig schreiben, dann umbenennen: abgebrochene Schreibvorgänge hinterlassen nur .tmp
+        std::filesystem::rename(temp, spill.file, ec);
+        if (ec) {
+            std::filesystem::remove(temp, ec);
+            continue;
+        }
+        disk_lru_.push_front(spill.path);
+        DiskEntry entry;
+        entry.file = spill.file;
+        entry.bytes = static_cast<std::size_t>(std::filesystem::file_size(spill.file, ec));
+        entry.lru_position = disk_lru_.begin();
+        disk_bytes_ += entry.bytes;
+        disk_index_.emplace(spill.path, entry);
+        spilled_count_++;
+        enforceDiskLimit();
+    }
+}
+
+bool AssemblyManager::loadFromDisk(const std::string& path, CachedAssembly& cached) {
+    auto it = disk_index_.find(path);
+    if (it == disk_index_.end()) {
+        return false;
+    }
+    std::ifstream in(it->second.file, std::ios::binary);
+    std::string stored_path;
+    std::pair<std::uint64_t, std::int64_t> stamp;
+    if (!readDiskHeader(in, stored_path, stamp) || stored_path != path || stamp != sourceStamp(path)) {
+        removeDiskEntry(path);  // fremd, beschädigt oder Quelle inzwischen geändert
+        return false;
+    }
+    const std::streamoff header = in.tellg();
+    in.seekg(0, std::ios::end);
+    std::string payload(static_cast<std::size_t>(in.tellg() - header), '\0');
+    in.seekg(header);
+    in.read(&payload[0], static_cast<std::streamsize>(payload.size()));
+    if (!AssemblyCacheCodec::decode(payload, cached.assembly, cached.meshes)) {
+        removeDiskEntry(path);
+        return false;
+    }
+    disk_lru_.splice(disk_lru_.begin(), disk_lru_, it->second.lru_position);
+    cached.component_count = cached.assembly.components().size();
+    cached.cached_lod = lod_mode_;
+    cached.memory_bytes =
+        AssemblyCacheCodec::footprint(cached.assembly) + AssemblyCacheCodec::footprint(cached.meshes);
+    return true;
+}
+
+void AssemblyManager::removeDiskEntry(const std::string& path) {
+    auto it = disk_index_.find(path);
+    if (it == disk_index_.end()) {
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::remove(it->second.file, ec);
+    disk_bytes_ -= it->second.bytes;
+    disk_lru_.erase(it->second.lru_position);
+    disk_index_.erase(it);
+}
+
+void AssemblyManager::enforceDiskLimit() {
+    while (!disk_lru_.empty() && disk_bytes_ > disk_limit_mb_ * 1024 * 1024) {
+        removeDiskEntry(disk_lru_.back());
     }
 }
 
@@ -354,12 +859,8 @@ void AssemblyManager::enableAdaptiveLod(bool enabled) {
 }
 
 void AssemblyManager::preloadAssembly(const std::string& path) {
-    // Preload assembly in background
-    if (multi_threaded_loading_) {
-        loadAssemblyAsync(path);
-    } else {
-        enqueueLoad(path);
-    }
+    // Vorausladen läuft immer im Hintergrund und nur, wenn sonst nichts ansteht
+    startLoad(path, TaskPriority::Low, true);
 }
 
 void AssemblyManager::enableMultiThreadedLoading(bool enabled) {
@@ -368,6 +869,12 @@ void AssemblyManager::enableMultiThreadedLoading(bool enabled) {
 
 void AssemblyManager::setThreadPoolSize(std::size_t thread_count) {
     thread_pool_size_ = thread_count > 0 ? thread_count : 4;
+    if (loader_pool_ && loader_pool_->threadCount() != thread_pool_size_) {
+        // Laufende Aufträge halten den alten Pool; neuer Pool beim nächsten Start
+        waitForLoadCompletion();
+        std::lock_guard<std::mutex> lock(load_mutex_);
+        loader_pool_.reset();
+    }
 }
 
 std::future<AssemblyLoadStats> AssemblyManager::loadAssemblyAsync(const std::string& path) {
@@ -377,32 +884,85 @@ std::future<AssemblyLoadStats> AssemblyManager::loadAssemblyAsync(const std::str
         promise.set_value(loadAssembly(path));
         return future;
     }
-    
-    auto future = std::async(std::launch::async, [this, path]() {
+    return startLoad(path, TaskPriority::Normal, true)->promise.get_future();
+}
+
+void AssemblyManager::waitForLoadCompletion() {
+    std::vector<std::shared_ptr<LoadJobState>> jobs;
+    {
         std::lock_guard<std::mutex> lock(load_mutex_);
-        return loadAssembly(path);
-    });
-    
-    active_loads_.push_back(std::move(future));
-    
-    if (active_loads_.size() > thread_pool_size_) {
-        active_loads_.front().wait();
-        active_loads_.erase(active_loads_.begin());
+        jobs = active_loads_;
     }
-    
-    return future;
+    for (const auto& job : jobs) {
+        std::unique_lock<std::mutex> job_lock(job->mutex);
+        job->done.wait(job_lock, [&]() { return job->finished; });
+    }
+    std::lock_guard<std::mutex> lock(load_mutex_);
+    active_loads_.erase(std::remove_if(active_loads_.begin(), active_loads_.end(),
+                                       [&](const std::shared_ptr<LoadJobState>& job) {
+                                           return std::find(jobs.begin(), jobs.end(), job) != jobs.end();
+                                       }),
+                        active_loads_.end());
 }
 
-void AssemblyManager::waitForLoadCompletion() {
-    for (auto& future : active_loads_) {
-        if (future.valid()) {
-            future.wait();
+void AssemblyManager::setTessellator(Tessellator tessellator) {
+    tessellator_ = std::move(tessellator);
+}
+
+bool AssemblyManager::readStructure(const std::string& path, Assembly& assembly) const {
+    cad::interop::ImportExportService io_service;
+    const cad::interop::FileFormat format = io_service.detectFileFormat(path);
+    if (format == cad::interop::FileFormat::Step) {
+        assembly = io_service.importStepToAssembly(path);
+        return !assembly.components().empty();
+    }
+    cad::interop::ImportRequest request;
+    request.path = path;
+    request.format = format;
+    const cad::interop::IoResult result = io_service.importModel(request);
+    std::error_code ec;
+    const std::uintmax_t file_size = std::filesystem::file_size(path, ec);
+    if (!result.success || ec) {
+        return false;
+    }
+    // Gleiche Schätzung wie der Datei-Schritt des Ladeauftrags
+    std::size_t count = static_cast<std::size_t>(file_size / 10240);
+    count = std::max<std::size_t>(std::min(count, max_components_), 1);
+    const std::size_t path_hash = std::hash<std::string>{}(path);
+    for (std::size_t i = 0; i < count; ++i) {
+        assembly.addComponent(PartRef(Part("Part_" + std::to_string(i + 1))), syntheticTransform(path_hash, i));
+    }
+    return true;
+}
+
+std::unique_ptr<AssemblyStream> AssemblyManager::openStreaming(const std::string& path) {
+    Assembly assembly;
+    AssemblyMeshes meshes;
+    bool hit = false;
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        const CachedAssembly* cached = findCached(path);
+        hit = cached != nullptr;
+        if (hit) {
+            cache_hits_++;
+            assembly = cached->assembly;
+            meshes = cached->meshes;
+        } else {
+            cache_misses_++;
         }
     }
-    active_loads_.clear();
+    writePendingSpills();
+    if (!hit && !readStructure(path, assembly)) {
+        return nullptr;
+    }
+    auto stream = std::make_unique<AssemblyStream>(std::move(assembly), std::move(meshes), tessellator_);
+    stream->setMemoryBudget(memory_limit_mb_ * 1024 * 1024);
+    stream->setLodGovernor(lod_governor_);
+    return stream;
 }
 
 double AssemblyManager::getCacheHitRate() const {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
     std::size_t total_requests = cache_hits_ + cache_misses_;
     if (total_requests == 0) {
         return 0.0;
@@ -411,14 +971,12 @@ double AssemblyManager::getCacheHitRate() const {
 }
 
 std::size_t AssemblyManager::getMemoryUsage() const {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
     return total_memory_usage_;
 }
 
 std::size_t AssemblyManager::estimateAssemblyMemory(const Assembly& assembly) const {
-    // Estimate memory usage: base size + component overhead
-    std::size_t base_size = 1024;  // Base assembly structure
-    std::size_t component_size = 256;  // Per component overhead
-    return base_size + (assembly.components().size() * component_size);
+    return AssemblyCacheCodec::footprint(assembly);
 }
 
 void AssemblyManager::reduceGeometryComplexity(const std::string& part_id, double reduction_factor) const {
@@ -428,14 +986,6 @@ void AssemblyManager::reduceGeometryComplexity(const std::string& part_id, doubl
     (void)reduction_factor;
 }
 
-double AssemblyManager::calculatePriorityScore(const CachedAssembly& cached) const {
-    // Priority = access_count * 0.6 + recency * 0.4
-    // Higher score = higher priority (less likely to be evicted)
-    double recency_factor = (current_time_ - cached.last_access_time + 1.0) / 1000.0;  // Normalize
-    double access_factor = static_cast<double>(cached.access_count);
-    return (access_factor * 0.6) + (recency_factor * 0.4);
-}
-
 LodMode AssemblyManager::adaptiveLodRecommendation() const {
     // Adaptive LOD based on measured performance and component count
     if (measured_fps_ < target_fps_ * 0.8) {
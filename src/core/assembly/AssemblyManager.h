@@ -2,15 +2,25 @@
 
 #include <atomic>
 #include <cstddef>
+#include <condition_variable>
 #include <deque>
+#include <functional>
 #include <future>
+#include <list>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "../Modeler/Assembly.h"
+#include "../parallel/ThreadPool.h"
+#include "../perf/PerformanceMonitor.h"
+#include "AssemblyCacheCodec.h"
+#include "AssemblyStream.h"
+#include "LodGovernor.h"
 
 namespace cad {
 namespace core {
@@ -23,12 +33,11 @@ struct CacheStats {
     double hit_rate{0.0};
     std::size_t memory_usage_bytes{0};
     std::size_t evicted_entries{0};
-};
-
-enum class LodMode {
-    Full,
-    Simplified,
-    BoundingBoxes
+    /** Disk-Tier: ausgelagerte Einträge, belegte Bytes, Treffer (in cache_hits enthalten). */
+    std::size_t disk_entries{0};
+    std::size_t disk_bytes{0};
+    std::size_t disk_hits{0};
+    std::size_t spilled_entries{0};
 };
 
 struct AssemblyLoadStats {
@@ -39,25 +48,56 @@ struct AssemblyLoadStats {
     std::size_t visible_components{0};
     double estimated_memory_mb{0.0};
     bool from_cache{false};
+    /** Abgebrochen (cancelLoad): nichts gecacht, Baugruppe unvollständig. */
+    bool cancelled{false};
+    /** Regenerierte bzw. tessellierte Part-Definitionen (geteilte Definitionen einmal). */
+    std::size_t regenerated_definitions{0};
 };
 
+/** Schnappschuss eines Ladeauftrags; progress = erledigte / alle Teilaufgaben (Datei, Komponenten, Definitionen). */
 struct AssemblyLoadJob {
     std::string path;
     int progress{0};
+    std::uint64_t id{0};
+    std::size_t completed_tasks{0};
+    std::size_t total_tasks{0};
+    bool finished{false};
+    bool cancelled{false};
 };
 
 struct CachedAssembly {
     Assembly assembly;
+    AssemblyMeshes meshes;
     std::size_t component_count{0};
     LodMode cached_lod{LodMode::Full};
     std::size_t access_count{0};
     double last_access_time{0.0};
-    std::size_t estimated_memory_bytes{0};
-    double priority_score{0.0};  // Combined score for eviction
+    /** Belegter Speicher laut AssemblyCacheCodec::footprint (Baugruppe, Definitionen, Netze). */
+    std::size_t memory_bytes{0};
+    /** Position in der LRU-Liste (vorn = zuletzt benutzt). */
+    std::list<std::string>::iterator lru_position;
 };
 
+/**
+ * Laden, Caching und LOD großer Baugruppen. Ladeaufträge laufen als Aufgabengraph auf einem eigenen
+ * Work-Stealing-Pool (thread_pool_size_): Datei lesen → je Komponente parsen → je Part-Definition
+ * regenerieren und tessellieren. Komponenten innerhalb des LOD-Sichtbarkeitslimits laufen mit Vorrang,
+ * Vorausladen (preloadAssembly) mit niedriger Priorität; Abbruch kooperativ je Auftrag.
+ * Cache zweistufig: LRU im Speicher (O(1), Limit nach Einträgen und echten Bytes); verdrängte oder
+ * freigegebene Einträge werden binär in ein lokales Verzeichnis ausgelagert und beim nächsten Öffnen
+ * von dort gelesen, solange die Quelldatei unverändert ist.
+ */
 class AssemblyManager {
 public:
+    /** Tessellierung einer regenerierten Definition; true = mesh gefüllt (wird mitgecacht). Läuft auf Pool-Threads. */
+    using Tessellator = std::function<bool(const Part& part, LodMode lod, TriangleMesh& mesh)>;
+
+    AssemblyManager() = default;
+    ~AssemblyManager();
+
+    AssemblyManager(const AssemblyManager&) = delete;
+    AssemblyManager& operator=(const AssemblyManager&) = delete;
+
     void setLodMode(LodMode mode);
     void setTargetFps(double fps);
     void setMaxComponents(std::size_t max_components);
@@ -65,15 +105,31 @@ public:
     CacheStats cacheStats() const;
     void setCacheLimit(std::size_t max_entries);
     void enableBackgroundLoading(bool enabled);
-    void enqueueLoad(const std::string& path);
+    /** Startet das Laden im Hintergrund (bei aktivem Background-Loading) und reiht es für pollLoadProgress ein. */
+    std::uint64_t enqueueLoad(const std::string& path);
+    /** Fortschritt des ältesten eingereihten Auftrags; ein abgeschlossener wird dabei entnommen. */
     AssemblyLoadJob pollLoadProgress();
+    /** Bricht einen Auftrag ab (laufende Teilaufgaben enden, ausstehende entfallen); false = unbekannt/fertig. */
+    bool cancelLoad(std::uint64_t job_id);
+    void cancelAllLoads();
     LodMode recommendedLod() const;
     
     // Cache management
-    void cacheAssembly(const std::string& path, const Assembly& assembly);
-    bool getCachedAssembly(const std::string& path, Assembly& out_assembly) const;
+    void cacheAssembly(const std::string& path, const Assembly& assembly, const AssemblyMeshes& meshes = {});
+    /** Speicher, sonst Disk-Tier (wird dabei in den Speicher geholt); zählt als zuletzt benutzt. */
+    bool getCachedAssembly(const std::string& path, Assembly& out_assembly);
+    bool getCachedMeshes(const std::string& path, AssemblyMeshes& out_meshes);
+    /** Leert den Speicher-Cache; der Disk-Tier bleibt erhalten. */
     void clearCache();
     std::vector<std::string> getCachedPaths() const;
+    /**
+     * Disk-Tier aktivieren (leer = aus). Vorhandene Einträge im Verzeichnis werden übernommen,
+     * überzählige (max_disk_mb) nach Alter gelöscht.
+     */
+    bool setDiskCacheDirectory(const std::string& directory, std::size_t max_disk_mb = 4096);
+    /** Dokument geschlossen: Eintrag aus dem Speicher in den Disk-Tier verschieben. */
+    bool releaseAssembly(const std::string& path);
+    void clearDiskCache();
     
     // LOD filtering
     std::size_t getVisibleComponentCount(const Assembly& assembly, LodMode lod) const;
@@ -91,13 +147,67 @@ public:
     void setThreadPoolSize(std::size_t thread_count);
     std::future<AssemblyLoadStats> loadAssemblyAsync(const std::string& path);
     void waitForLoadCompletion();
+    void setTessellator(Tessellator tessellator);
+
+    /**
+     * Streaming-Öffnen: liest nur die Struktur (Cache, STEP-Baugruppe oder synthetisch) und übergibt sie
+     * mit Tessellator und Speicherlimit an einen AssemblyStream, der Geometrie nach Sichtbarkeit nachlädt.
+     * nullptr, wenn die Datei nicht gelesen werden kann. Kein LOD-Kürzen der Komponentenliste.
+     */
+    std::unique_ptr<AssemblyStream> openStreaming(const std::string& path);
+
+    // Bildraten-Regelung
+    /**
+     * Vom Renderer je Bild: speist PerformanceMonitor (gemessene Bildrate für adaptiveLodRecommendation)
+     * und den LodGovernor, der daraus die Pixel-Toleranz der LOD-Auswahl nachführt.
+     */
+    void recordFrame(double frame_ms);
+    double measuredFps() const { return measured_fps_; }
+    const PerformanceMonitor& performanceMonitor() const { return performance_monitor_; }
+    /** Geteilt mit den Streams aus openStreaming (dort LOD je Komponente). */
+    LodGovernor& lodGovernor() { return *lod_governor_; }
 
 private:
-    void evictOldestCacheEntry();
-    void evictLowPriorityEntries();
+    struct LoadJobState;
+
+    std::shared_ptr<LoadJobState> startLoad(const std::string& path, TaskPriority priority, bool pooled);
+    void dispatch(const std::shared_ptr<LoadJobState>& job, std::function<void()> task, TaskPriority priority);
+    void runFileStage(const std::shared_ptr<LoadJobState>& job);
+    void runComponentStage(const std::shared_ptr<LoadJobState>& job, std::size_t index);
+    void runDefinitionStage(const std::shared_ptr<LoadJobState>& job, std::size_t definition, bool tessellate,
+                            TaskPriority priority);
+    void completeTasks(const std::shared_ptr<LoadJobState>& job, std::size_t count);
+    void finishLoad(const std::shared_ptr<LoadJobState>& job);
+    AssemblyLoadJob snapshot(const LoadJobState& job) const;
+    /** Struktur ohne Regeneration; false bei unlesbarer Datei. */
+    bool readStructure(const std::string& path, Assembly& assembly) const;
+    struct DiskEntry {
+        std::string file;
+        std::size_t bytes{0};
+        std::list<std::string>::iterator lru_position;
+    };
+    /** Verdrängter Eintrag auf dem Weg in den Disk-Tier (Ticket erkennt überholte Schreibvorgänge). */
+    struct PendingSpill {
+        std::string path;
+        std::string file;
+        std::uint64_t ticket{0};
+        CachedAssembly cached;
+    };
+
+    // Cache-Hilfen; Aufrufer hält cache_mutex_
+    CachedAssembly* findCached(const std::string& path);
+    void insertCached(const std::string& path, CachedAssembly cached);
+    void evictLeastRecentlyUsed();
+    void enforceCacheLimits();
+    void queueSpill(const std::string& path, CachedAssembly&& cached);
+    bool loadFromDisk(const std::string& path, CachedAssembly& cached);
+    void removeDiskEntry(const std::string& path);
+    void enforceDiskLimit();
+    /** Ohne gehaltenes cache_mutex_: kodiert und schreibt vorgemerkte Einträge, trägt sie danach ein. */
+    void writePendingSpills();
+
     std::size_t calculateLodComponentLimit(LodMode lod) const;
     std::size_t estimateAssemblyMemory(const Assembly& assembly) const;
-    double calculatePriorityScore(const CachedAssembly& cached) const;
     LodMode adaptiveLodRecommendation() const;
     std::size_t reduceGeometryForLod(const Assembly& assembly, LodMode lod) const;
     void optimizeCache();
@@ -112,20 +222,39 @@ private:
     bool adaptive_lod_{true};
     bool multi_threaded_loading_{false};
     std::size_t thread_pool_size_{4};
-    std::deque<AssemblyLoadJob> load_queue_{};
-    std::vector<std::future<AssemblyLoadStats>> active_loads_{};
+    /** Über enqueueLoad gestartete Aufträge in Reihenfolge (pollLoadProgress). */
+    std::deque<std::shared_ptr<LoadJobState>> load_queue_{};
+    /** Alle laufenden Aufträge (waitForLoadCompletion, Abbruch). */
+    std::vector<std::shared_ptr<LoadJobState>> active_loads_{};
+    std::uint64_t next_job_id_{1};
+    std::unique_ptr<ThreadPool> loader_pool_;
+    Tessellator tessellator_;
     mutable std::mutex cache_mutex_;
     std::mutex load_mutex_;
     
     // Cache storage
-    std::map<std::string, CachedAssembly> cache_;
-    mutable std::size_t cache_hits_{0};
-    mutable std::size_t cache_misses_{0};
-    mutable std::size_t evicted_count_{0};
-    mutable std::size_t total_memory_usage_{0};
-    double current_time_{0.0};
+    std::unordered_map<std::string, CachedAssembly> cache_;
+    std::list<std::string> lru_;
+    std::size_t cache_hits_{0};
+    std::size_t cache_misses_{0};
+    std::size_t evicted_count_{0};
+    std::size_t total_memory_usage_{0};
+    // Disk-Tier
+    std::string disk_cache_dir_;
+    std::size_t disk_limit_mb_{4096};
+    std::unordered_map<std::string, DiskEntry> disk_index_;
+    std::list<std::string> disk_lru_;
+    std::size_t disk_bytes_{0};
+    std::size_t disk_hits_{0};
+    std::size_t spilled_count_{0};
+    /** Verdrängt, aber noch nicht geschrieben; Pfad -> Ticket des laufenden Schreibvorgangs. */
+    std::vector<PendingSpill> pending_spills_;
+    std::unordered_map<std::string, std::uint64_t> spilling_;
+    std::uint64_t next_spill_ticket_{1};
     double last_performance_check_{0.0};
     double measured_fps_{30.0};
+    PerformanceMonitor performance_monitor_;
+    std::shared_ptr<LodGovernor> lod_governor_{std::make_shared<LodGovernor>()};
 };
 
 }  // namespace core
@@ -0,0 +1,411 @@
+#include "AssemblyStream.h"
+#include "Modeler/Modeler.h"
+#include "Modeler/Part.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <utility>
+
+namespace cad {
+namespace core {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+BoundingBox meshBounds(const TriangleMesh& mesh) {
+    BoundingBox box;
+    if (mesh.vertices.size() < 3) {
+        return box;
+    }
+    box.min_x = box.min_y = box.min_z = std::numeric_limits<double>::max();
+    box.max_x = box.max_y = box.max_z = std::numeric_limits<double>::lowest();
+    for (std::size_t i = 0; i + 2 < mesh.vertices.size(); i += 3) {
+        box.min_x = std::min(box.min_x, mesh.vertices[i]);
+        box.max_x = std::max(box.max_x, mesh.vertices[i]);
+        box.min_y = std::min(box.min_y, mesh.vertices[i + 1]);
+        box.max_y = std::max(box.max_y, mesh.vertices[i + 1]);
+        box.min_z = std::min(box.min_z, mesh.vertices[i + 2]);
+        box.max_z = std::max(box.max_z, mesh.vertices[i + 2]);
+    }
+    return box;
+}
+
+/** Box ohne Regeneration: 10 mm Würfel, Extrusionen in z nach ihrer Tiefe (grob, wird nach dem Laden ersetzt). */
+BoundingBox estimateBounds(const Part& part) {
+    double depth = 10.0;
+    for (const auto& feature : part.features()) {
+        if (feature.type == FeatureType::Extrude && !feature.suppressed && feature.depth > 0.0) {
+            depth = std::max(depth, feature.depth);
+        }
+    }
+    return BoundingBox{-5.0, -5.0, 0.0, 5.0, 5.0, depth};
+}
+
+std::size_t meshBytes(const TriangleMesh& mesh) {
+    return sizeof(TriangleMesh) + mesh.vertices.capacity() * sizeof(double) +
+           mesh.indices.capacity() * sizeof(unsigned int);
+}
+
+}  // namespace
+
+AssemblyStream::AssemblyStream(Assembly assembly, AssemblyMeshes meshes, Tessellator tessellator, ThreadPool* pool)
+    : assembly_(std::move(assembly)), tessellator_(std::move(tessellator)),
+      pool_(pool ? pool : &ThreadPool::shared()) {
+    max_in_flight_ = std::max<std::size_t>(1, 2 * pool_->threadCount());
+
+    // Nur Struktur: Definitionen werden hier weder regeneriert noch tesselliert
+    const auto& components = assembly_.components();
+    assembly_.worldTransforms();
+    std::unordered_map<const Part*, std::uint32_t> definition_index;
+    std::unordered_map<std::string, std::shared_ptr<const TriangleMesh>> known_meshes;
+    instances_.resize(components.size());
+    index_of_.reserve(components.size());
+    for (std::size_t i = 0; i < components.size(); ++i) {
+        std::shared_ptr<const Part> part = components[i].part.shared();
+        auto inserted = definition_index.emplace(part.get(), static_cast<std::uint32_t>(definitions_.size()));
+        if (inserted.second) {
+            Definition definition;
+            definition.part = part;
+            auto cached = meshes.find(part->name());
+            if (cached != meshes.end() && !cached->second.indices.empty()) {
+                std::shared_ptr<const TriangleMesh>& shared = known_meshes[part->name()];
+                if (!shared) {
+                    shared = std::make_shared<const TriangleMesh>(std::move(cached->second));
+                }
+                definition.mesh = shared;
+                definition.mesh_lod = LodMode::Full;
+                definition.bytes = meshBytes(*shared);
+                definition.local_bounds = meshBounds(*shared);
+                resident_bytes_ += definition.bytes;
+            } else {
+                definition.local_bounds = estimateBounds(*part);
+            }
+            definitions_.push_back(std::move(definition));
+        }
+        Instance& instance = instances_[i];
+        instance.id = components[i].id;
+        instance.definition = inserted.first->second;
+        instance.frame = RigidFrame::fromTransform(assembly_.worldTransform(components[i].id));
+        index_of_.emplace(instance.id, static_cast<std::uint32_t>(i));
+        definitions_[instance.definition].instances.push_back(static_cast<std::uint32_t>(i));
+    }
+    for (std::size_t d = 0; d < definitions_.size(); ++d) {
+        placeInstances(static_cast<std::uint32_t>(d));
+    }
+}
+
+AssemblyStream::~AssemblyStream() {
+    token_.cancel();
+    std::unique_lock<std::mutex> lock(mutex_);
+    pending_.clear();
+    idle_.wait(lock, [&]() { return in_flight_ == 0; });
+}
+
+void AssemblyStream::setMemoryBudget(std::size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    memory_budget_ = bytes;
+}
+
+void AssemblyStream::setMinScreenPixels(double pixels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    min_screen_pixels_ = std::max(0.0, pixels);
+}
+
+void AssemblyStream::setFullDetailPixels(double pixels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    full_detail_pixels_ = std::max(0.0, pixels);
+}
+
+void AssemblyStream::setMaxInFlight(std::size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_in_flight_ = std::max<std::size_t>(1, count);
+    dispatchLocked();
+}
+
+void AssemblyStream::setLodGovernor(std::shared_ptr<const LodGovernor> governor) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    governor_ = std::move(governor);
+}
+
+void AssemblyStream::placeInstances(std::uint32_t definition) {
+    const BoundingBox& local = definitions_[definition].local_bounds;
+    const double local_min[3] = {local.min_x, local.min_y, local.min_z};
+    const double local_max[3] = {local.max_x, local.max_y, local.max_z};
+    for (std::uint32_t index : definitions_[definition].instances) {
+        Instance& instance = instances_[index];
+        double world_min[3];
+        double world_max[3];
+        instance.frame.applyBox(local_min, local_max, world_min, world_max);
+        instance.world = BoundingBox{world_min[0], world_min[1], world_min[2], world_max[0], world_max[1], world_max[2]};
+    }
+}
+
+StreamingStats AssemblyStream::update(const StreamingView& view) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++frame_;
+
+    double dir[3] = {view.target.x - view.eye.x, view.target.y - view.eye.y, view.target.z - view.eye.z};
+    const double dir_length = std::sqrt(dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2]);
+    if (dir_length > 0.0) {
+        dir[0] /= dir_length;
+        dir[1] /= dir_length;
+        dir[2] /= dir_length;
+    } else {
+        dir[0] = 0.0;
+        dir[1] = 0.0;
+        dir[2] = -1.0;
+    }
+    const double tan_half = std::tan(std::clamp(view.fov_y_degrees, 1.0, 179.0) * kPi / 360.0);
+    // Sichtkegel um die Bilddiagonale: konservativ, ein Vergleich je Kugel
+    const double cone_half_angle = std::atan(tan_half * std::sqrt(1.0 + view.aspect * view.aspect));
+    const double half_height = 0.5 * static_cast<double>(std::max(1, view.viewport_height));
+    const double pixel_scale = half_height / tan_half;
+
+    for (auto& definition : definitions_) {
+        definition.screen_pixels = 0.0;
+        definition.wanted_lod = LodMode::BoundingBoxes;
+    }
+    visible_components_ = 0;
+    lod_switches_ = 0;
+    for (Instance& instance : instances_) {
+        const BoundingBox& box = instance.world;
+        const double half[3] = {0.5 * (box.max_x - box.min_x), 0.5 * (box.max_y - box.min_y),
+                                0.5 * (box.max_z - box.min_z)};
+        const double radius = std::sqrt(half[0] * half[0] + half[1] * half[1] + half[2] * half[2]);
+        const double v[3] = {box.min_x + half[0] - view.eye.x, box.min_y + half[1] - view.eye.y,
+                             box.min_z + half[2] - view.eye.z};
+        const double distance = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        double pixels = 0.0;
+        if (distance <= radius) {
+            pixels = 2.0 * half_height;  // Kamera in der Box
+        } else {
+            const double cos_angle = std::clamp((v[0] * dir[0] + v[1] * dir[1] + v[2] * dir[2]) / distance, -1.0, 1.0);
+            if (std::acos(cos_angle) - std::asin(radius / distance) > cone_half_angle) {
+                continue;
+            }
+            pixels = radius / (distance * tan_half) * half_height;
+        }
+        ++visible_components_;
+        LodMode lod = LodMode::BoundingBoxes;
+        if (governor_) {
+            lod = governor_->select(instance.lod, radius, distance, pixel_scale);
+        } else if (pixels >= full_detail_pixels_) {
+            lod = LodMode::Full;
+        } else if (pixels >= min_screen_pixels_) {
+            lod = LodMode::Simplified;
+        }
+        if (lod != instance.lod) {
+            instance.lod = lod;
+            ++lod_switches_;
+        }
+        Definition& definition = definitions_[instance.definition];
+        definition.screen_pixels = std::max(definition.screen_pixels, pixels);
+        definition.wanted_lod = std::min(definition.wanted_lod, lod);
+        definition.last_visible_frame = frame_;
+    }
+
+    // Anforderungen: sichtbar, mehr als eine Box verlangt, noch ohne (ausreichend feines) Netz
+    pending_.clear();
+    for (std::size_t d = 0; d < definitions_.size(); ++d) {
+        Definition& definition = definitions_[d];
+        definition.queued = !definition.failed && !definition.loading &&
+                            definition.wanted_lod != LodMode::BoundingBoxes &&
+                            definition.screen_pixels >= min_screen_pixels_ &&
+                            (!definition.mesh || definition.wanted_lod < definition.mesh_lod);
+        if (definition.queued) {
+            pending_.push_back(static_cast<std::uint32_t>(d));
+        }
+    }
+    // Aufsteigend sortiert, dispatchLocked nimmt von hinten (größte Bildschirmgröße zuerst)
+    std::sort(pending_.begin(), pending_.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return definitions_[a].screen_pixels < definitions_[b].screen_pixels;
+    });
+
+    // Speicherdruck: unsichtbare Netze auslagern, am längsten unsichtbare zuerst; mit offenen
+    // Anforderungen so weit, dass wieder geladen werden darf
+    const bool wants_room = !pending_.empty();
+    auto over_budget = [&]() {
+        return wants_room ? resident_bytes_ >= memory_budget_ : resident_bytes_ > memory_budget_;
+    };
+    if (over_budget()) {
+        std::vector<std::uint32_t> victims;
+        for (std::size_t d = 0; d < definitions_.size(); ++d) {
+            const Definition& definition = definitions_[d];
+            if (definition.mesh && !definition.loading && definition.last_visible_frame != frame_) {
+                victims.push_back(static_cast<std::uint32_t>(d));
+            }
+        }
+        std::sort(victims.begin(), victims.end(), [&](std::uint32_t a, std::uint32_t b) {
+            return definitions_[a].last_visible_frame < definitions_[b].last_visible_frame;
+        });
+        for (std::uint32_t d : victims) {
+            if (!over_budget()) {
+                break;
+            }
+            dropMeshLocked(definitions_[d]);
+            ++paged_out_;
+        }
+    }
+
+    dispatchLocked();
+    return statsLocked();
+}
+
+void AssemblyStream::dispatchLocked() {
+    while (in_flight_ < max_in_flight_ && !pending_.empty() && resident_bytes_ < memory_budget_ &&
+           !token_.cancelled()) {
+        const std::uint32_t d = pending_.back();
+        pending_.pop_back();
+        Definition& definition = definitions_[d];
+        definition.queued = false;
+        definition.loading = true;
+        ++in_flight_;
+        const LodMode lod = definition.wanted_lod;
+        const TaskPriority priority =
+            definition.screen_pixels >= full_detail_pixels_ ? TaskPriority::High : TaskPriority::Normal;
+        pool_->submit([this, d, lod]() { load(d, lod); }, priority);
+    }
+}
+
+void AssemblyStream::load(std::uint32_t d, LodMode lod) {
+    std::shared_ptr<const Part> source;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        source = definitions_[d].part;
+    }
+    auto mesh = std::make_shared<TriangleMesh>();
+    bool ok = false;
+    if (!token_.cancelled() && tessellator_) {
+        // Regeneration auf einer Kopie: die Struktur-Definition wird parallel gelesen
+        Part part(*source);
+        Modeler modeler;
+        modeler.evaluatePartParameters(part);
+        modeler.evaluatePartRules(part);
+        ok = tessellator_(part, lod, *mesh) && !mesh->indices.empty();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Definition& definition = definitions_[d];
+    definition.loading = false;
+    --in_flight_;
+    if (!token_.cancelled()) {
+        if (ok) {
+            resident_bytes_ -= definition.bytes;
+            definition.bytes = meshBytes(*mesh);
+            resident_bytes_ += definition.bytes;
+            definition.local_bounds = meshBounds(*mesh);
+            definition.mesh = std::move(mesh);
+            definition.mesh_lod = lod;
+            ++loaded_;
+            placeInstances(d);
+        } else {
+            definition.failed = true;
+        }
+        dispatchLocked();
+    }
+    // Letzter Zugriff auf den Stream: danach darf der Destruktor weiterlaufen
+    idle_.notify_all();
+}
+
+void AssemblyStream::dropMeshLocked(Definition& definition) {
+    resident_bytes_ -= definition.bytes;
+    definition.bytes = 0;
+    definition.mesh.reset();
+}
+
+StreamState AssemblyStream::stateLocked(const Definition& definition) const {
+    if (definition.mesh) {
+        return StreamState::Resident;
+    }
+    if (definition.loading) {
+        return StreamState::Loading;
+    }
+    return definition.queued ? StreamState::Queued : StreamState::Unloaded;
+}
+
+StreamState AssemblyStream::state(std::uint64_t component_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_of_.find(component_id);
+    if (it == index_of_.end()) {
+        return StreamState::Unloaded;
+    }
+    return stateLocked(definitions_[instances_[it->second].definition]);
+}
+
+std::shared_ptr<const TriangleMesh> AssemblyStream::mesh(std::uint64_t component_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_of_.find(component_id);
+    if (it == index_of_.end()) {
+        return nullptr;
+    }
+    return definitions_[instances_[it->second].definition].mesh;
+}
+
+LodMode AssemblyStream::lod(std::uint64_t component_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_of_.find(component_id);
+    if (it == index_of_.end()) {
+        return LodMode::BoundingBoxes;
+    }
+    const Instance& instance = instances_[it->second];
+    const Definition& definition = definitions_[instance.definition];
+    if (!definition.mesh) {
+        return LodMode::BoundingBoxes;
+    }
+    return std::max(instance.lod, definition.mesh_lod);
+}
+
+BoundingBox AssemblyStream::worldBounds(std::uint64_t component_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_of_.find(component_id);
+    if (it == index_of_.end()) {
+        return BoundingBox{};
+    }
+    return instances_[it->second].world;
+}
+
+void AssemblyStream::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // Über dem Budget bleiben Anforderungen liegen, bis update() auslagert – darauf nicht warten
+    idle_.wait(lock, [&]() {
+        return in_flight_ == 0 && (pending_.empty() || resident_bytes_ >= memory_budget_);
+    });
+}
+
+StreamingStats AssemblyStream::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return statsLocked();
+}
+
+StreamingStats AssemblyStream::statsLocked() const {
+    StreamingStats stats;
+    stats.components = instances_.size();
+    stats.definitions = definitions_.size();
+    stats.visible_components = visible_components_;
+    for (const auto& definition : definitions_) {
+        switch (stateLocked(definition)) {
+            case StreamState::Resident:
+                ++stats.resident_definitions;
+                break;
+            case StreamState::Queued:
+                ++stats.queued_definitions;
+                break;
+            case StreamState::Loading:
+                ++stats.loading_definitions;
+                break;
+            default:
+                break;
+        }
+    }
+    stats.resident_bytes = resident_bytes_;
+    stats.loaded_definitions = loaded_;
+    stats.paged_out_definitions = paged_out_;
+    stats.lod_switches = lod_switches_;
+    return stats;
+}
+
+}  // namespace core
+}  // namespace cad
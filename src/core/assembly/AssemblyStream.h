@@ -0,0 +1,165 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "../Modeler/Assembly.h"
+#include "../analysis/TriangleBvh.h"
+#include "../parallel/ThreadPool.h"
+#include "AssemblyCacheCodec.h"
+#include "LodGovernor.h"
+
+namespace cad {
+namespace core {
+
+/** Kamera für die Priorisierung (Weltkoordinaten); Sichtbarkeit über den Sichtkegel des Frustums. */
+struct StreamingView {
+    Point3D eye{0.0, 0.0, 100.0};
+    Point3D target{0.0, 0.0, 0.0};
+    double fov_y_degrees{45.0};
+    double aspect{16.0 / 9.0};
+    int viewport_height{1080};
+};
+
+/** Zustand der Geometrie einer Komponente (je geteilter Definition). */
+enum class StreamState {
+    /** Nur Struktur und Box. */
+    Unloaded,
+    /** Angefordert, wartet auf einen freien Ladeplatz. */
+    Queued,
+    Loading,
+    /** Netz vorhanden (ggf. wird parallel eine feinere Stufe geladen). */
+    Resident
+};
+
+struct StreamingStats {
+    std::size_t components{0};
+    std::size_t definitions{0};
+    std::size_t visible_components{0};
+    std::size_t resident_definitions{0};
+    std::size_t queued_definitions{0};
+    std::size_t loading_definitions{0};
+    std::size_t resident_bytes{0};
+    /** Seit dem Öffnen: geladene bzw. wegen Speicherdruck ausgelagerte Definitionen. */
+    std::size_t loaded_definitions{0};
+    std::size_t paged_out_definitions{0};
+    /** Stufenwechsel sichtbarer Komponenten im letzten update() (Maß für „Popping“). */
+    std::size_t lod_switches{0};
+};
+
+/**
+ * Streaming-Öffnen großer Baugruppen: Struktur und Boxen stehen sofort bereit, Geometrie (Regeneration
+ * + Tessellierung je geteilter Definition) wird erst angefordert, wenn eine Instanz im Sichtkegel liegt
+ * und auf dem Bildschirm mindestens min_screen_pixels groß ist – größte zuerst, höchstens max_in_flight
+ * gleichzeitig auf dem Pool. Die Stufe je Komponente wählt ein LodGovernor nach Bildschirmfehler (ohne:
+ * groß → LodMode::Full, klein → Simplified); geladen wird je Definition die feinste Stufe ihrer
+ * sichtbaren Instanzen, beim Heranzoomen wird nachgeladen. Über dem Speicherbudget werden nicht
+ * sichtbare Netze ausgelagert, am längsten unsichtbare zuerst; sichtbare bleiben, dann wird nur nichts
+ * Neues mehr angefordert.
+ * update() und die Abfragen aus dem UI-Thread, Laden auf dem Pool; thread-sicher.
+ */
+class AssemblyStream {
+public:
+    using Tessellator = std::function<bool(const Part& part, LodMode lod, TriangleMesh& mesh)>;
+
+    /** pool == nullptr → ThreadPool::shared(); meshes: bereits vorhandene Netze (z.B. aus dem Cache). */
+    AssemblyStream(Assembly assembly, AssemblyMeshes meshes, Tessellator tessellator, ThreadPool* pool = nullptr);
+    /** Bricht ausstehende Ladevorgänge ab und wartet auf laufende. */
+    ~AssemblyStream();
+
+    AssemblyStream(const AssemblyStream&) = delete;
+    AssemblyStream& operator=(const AssemblyStream&) = delete;
+
+    void setMemoryBudget(std::size_t bytes);
+    void setMinScreenPixels(double pixels);
+    void setFullDetailPixels(double pixels);
+    void setMaxInFlight(std::size_t count);
+    /** LOD-Auswahl je Komponente (mit Hysterese); nullptr → feste Schwellen nach Bildschirmgröße. */
+    void setLodGovernor(std::shared_ptr<const LodGovernor> governor);
+
+    /** Sichtbarkeit und Bildschirmgröße neu bewerten, Anforderungen umsortieren, bei Bedarf auslagern. */
+    StreamingStats update(const StreamingView& view);
+
+    /** Struktur (Komponenten, Lagen, unregenerierte Definitionen). */
+    const Assembly& assembly() const { return assembly_; }
+    StreamState state(std::uint64_t component_id) const;
+    /** Netz der Definition (lokale Koordinaten) oder nullptr, solange nur die Box vorliegt. */
+    std::shared_ptr<const TriangleMesh> mesh(std::uint64_t component_id) const;
+    /** Darzustellende Stufe: Auswahl des letzten update(), gröber, solange das passende Netz fehlt. */
+    LodMode lod(std::uint64_t component_id) const;
+    /** Weltbox; nach dem Laden aus dem Netz, vorher geschätzt. */
+    BoundingBox worldBounds(std::uint64_t component_id) const;
+    /** Wartet, bis keine Anforderung mehr aussteht oder läuft. */
+    void waitIdle();
+    StreamingStats stats() const;
+
+private:
+    struct Definition {
+        std::shared_ptr<const Part> part;
+        BoundingBox local_bounds;
+        std::shared_ptr<const TriangleMesh> mesh;
+        LodMode mesh_lod{LodMode::Full};
+        std::size_t bytes{0};
+        /** Größte Bildschirmgröße einer sichtbaren Instanz im letzten update(), 0 = unsichtbar. */
+        double screen_pixels{0.0};
+        /** Feinste Stufe einer sichtbaren Instanz im letzten update(). */
+        LodMode wanted_lod{LodMode::BoundingBoxes};
+        std::uint64_t last_visible_frame{0};
+        bool queued{false};
+        bool loading{false};
+        /** Tessellierung lieferte nichts: nicht erneut anfordern. */
+        bool failed{false};
+        std::vector<std::uint32_t> instances;
+    };
+    struct Instance {
+        std::uint64_t id{0};
+        std::uint32_t definition{0};
+        RigidFrame frame;
+        BoundingBox world;
+        LodMode lod{LodMode::BoundingBoxes};
+    };
+
+    void placeInstances(std::uint32_t definition);
+    /** Startet Anforderungen aus pending_ bis max_in_flight; Aufrufer hält mutex_. */
+    void dispatchLocked();
+    void load(std::uint32_t definition, LodMode lod);
+    void dropMeshLocked(Definition& definition);
+    StreamState stateLocked(const Definition& definition) const;
+    StreamingStats statsLocked() const;
+
+    Assembly assembly_;
+    Tessellator tessellator_;
+    ThreadPool* pool_{nullptr};
+    CancellationToken token_;
+    std::shared_ptr<const LodGovernor> governor_;
+
+    std::vector<Definition> definitions_;
+    std::vector<Instance> instances_;
+    std::unordered_map<std::uint64_t, std::uint32_t> index_of_;
+    /** Angeforderte Definitionen, wichtigste vorn. */
+    std::vector<std::uint32_t> pending_;
+
+    std::size_t memory_budget_{512ull * 1024 * 1024};
+    double min_screen_pixels_{2.0};
+    double full_detail_pixels_{64.0};
+    std::size_t max_in_flight_{0};
+    std::size_t in_flight_{0};
+    std::size_t resident_bytes_{0};
+    std::size_t visible_components_{0};
+    std::size_t loaded_{0};
+    std::size_t paged_out_{0};
+    std::size_t lod_switches_{0};
+    std::uint64_t frame_{0};
+
+    mutable std::mutex mutex_;
+    std::condition_variable idle_;
+};
+
+}  // namespace core
+}  // namespace cad
@@ -0,0 +1,105 @@
+#include "LodGovernor.h"
+#include "perf/PerformanceMonitor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace cad {
+namespace core {
+
+LodGovernor::LodGovernor(double target_fps) {
+    setTargetFps(target_fps);
+}
+
+void LodGovernor::setTargetFps(double fps) {
+    target_fps_ = fps <= 0.0 ? 30.0 : fps;
+}
+
+void LodGovernor::setPixelTolerance(double pixels) {
+    pixel_tolerance_ = std::clamp(pixels, min_tolerance_, max_tolerance_);
+}
+
+void LodGovernor::setToleranceRange(double min_pixels, double max_pixels) {
+    min_tolerance_ = std::max(1e-3, min_pixels);
+    max_tolerance_ = std::max(min_tolerance_, max_pixels);
+    pixel_tolerance_ = std::clamp(pixel_tolerance_, min_tolerance_, max_tolerance_);
+}
+
+void LodGovernor::setHysteresis(double fraction) {
+    hysteresis_ = std::clamp(fraction, 0.0, 0.9);
+}
+
+void LodGovernor::setDeadband(double fraction) {
+    deadband_ = std::clamp(fraction, 0.0, 0.9);
+}
+
+void LodGovernor::setAdaptInterval(std::size_t frames) {
+    adapt_interval_ = std::max<std::size_t>(1, frames);
+}
+
+void LodGovernor::setRelativeError(LodMode lod, double fraction) {
+    relative_error_[static_cast<int>(lod)] = std::max(0.0, fraction);
+}
+
+double LodGovernor::adapt(const PerformanceMonitor& monitor) {
+    if (++frames_since_adapt_ < adapt_interval_) {
+        return pixel_tolerance_;
+    }
+    const double fps = monitor.fps();
+    if (fps <= 0.0) {
+        return pixel_tolerance_;
+    }
+    frames_since_adapt_ = 0;
+    // > 1: zu langsam → gröber; < 1: Reserve → feiner. Schritt je Eingriff auf Faktor 2 begrenzt.
+    const double ratio = target_fps_ / fps;
+    if (ratio > 1.0 + deadband_ || ratio < 1.0 - deadband_) {
+        pixel_tolerance_ = std::clamp(pixel_tolerance_ * std::clamp(ratio, 0.5, 2.0), min_tolerance_, max_tolerance_);
+    }
+    return pixel_tolerance_;
+}
+
+double LodGovernor::pixelScale(double fov_y_degrees, int viewport_height) {
+    const double tan_half = std::tan(std::clamp(fov_y_degrees, 1.0, 179.0) * 3.14159265358979323846 / 360.0);
+    return 0.5 * static_cast<double>(std::max(1, viewport_height)) / tan_half;
+}
+
+double LodGovernor::projectedError(LodMode lod, double radius, double distance, double pixel_scale) const {
+    const double error = radius * relative_error_[static_cast<int>(lod)];
+    if (distance <= radius) {
+        // Kamera in der Hüllkugel: jede Vereinfachung ist sichtbar
+        return error > 0.0 ? std::numeric_limits<double>::infinity() : 0.0;
+    }
+    return error / distance * pixel_scale;
+}
+
+LodMode LodGovernor::select(LodMode current, double radius, double distance, double pixel_scale) const {
+    // Gröbste Stufe unter der Toleranz
+    LodMode target = LodMode::Full;
+    for (LodMode lod : {LodMode::BoundingBoxes, LodMode::Simplified}) {
+        if (projectedError(lod, radius, distance, pixel_scale) <= pixel_tolerance_) {
+            target = lod;
+            break;
+        }
+    }
+    if (target > current) {
+        // Vergröbern nur mit Abstand zur Grenze
+        for (LodMode lod : {LodMode::BoundingBoxes, LodMode::Simplified}) {
+            if (lod > current &&
+                projectedError(lod, radius, distance, pixel_scale) <= pixel_tolerance_ * (1.0 - hysteresis_)) {
+                return lod;
+            }
+        }
+        return current;
+    }
+    if (target < current) {
+        // Verfeinern erst, wenn die aktuelle Stufe deutlich über der Toleranz liegt
+        return projectedError(current, radius, distance, pixel_scale) > pixel_tolerance_ * (1.0 + hysteresis_)
+                   ? target
+                   : current;
+    }
+    return current;
+}
+
+}  // namespace core
+}  // namespace cad
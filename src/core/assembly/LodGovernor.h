@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+
+namespace cad {
+namespace core {
+
+class PerformanceMonitor;
+
+/** Detailstufen, fein → grob (Vergleich über den Zahlenwert: kleiner = feiner). */
+enum class LodMode {
+    Full,
+    Simplified,
+    BoundingBoxes
+};
+
+/**
+ * LOD-Auswahl je Komponente nach projiziertem Bildschirmfehler plus Regler auf die Bildrate.
+ * Objektfehler je Stufe relativ zum Radius der Hüllkugel (Full: Sehnenfehler der Tessellierung,
+ * Simplified: vereinfachtes Netz, BoundingBoxes: Box statt Form); gewählt wird die gröbste Stufe,
+ * deren Fehler auf dem Bildschirm unter pixelTolerance() bleibt. Hysterese: vergröbert wird erst bei
+ * Fehler < Toleranz·(1 − h), verfeinert erst bei > Toleranz·(1 + h) – kein Flackern an der Grenze.
+ * adapt() verschiebt die Toleranz multiplikativ, bis die gemessene Bildrate im Totband um
+ * target_fps liegt. Nicht thread-sicher (UI-Thread).
+ */
+class LodGovernor {
+public:
+    explicit LodGovernor(double target_fps = 30.0);
+
+    void setTargetFps(double fps);
+    double targetFps() const { return target_fps_; }
+    /** Aktuelle Toleranz in Pixeln (Startwert; der Regler bewegt sie innerhalb von [min, max]). */
+    void setPixelTolerance(double pixels);
+    double pixelTolerance() const { return pixel_tolerance_; }
+    void setToleranceRange(double min_pixels, double max_pixels);
+    /** Hysterese als Anteil der Toleranz (0.25 = ±25 %). */
+    void setHysteresis(double fraction);
+    /** Totband um die Ziel-Bildrate, in dem der Regler nichts tut (0.1 = ±10 %). */
+    void setDeadband(double fraction);
+    /** Regler greift höchstens alle interval Bilder (Messfenster soll die eigene Änderung sehen). */
+    void setAdaptInterval(std::size_t frames);
+    /** Objektfehler je Stufe relativ zum Hüllkugelradius. */
+    void setRelativeError(LodMode lod, double fraction);
+
+    /** Einmal je Bild mit dem Monitor des Renderers; liefert die (ggf. angepasste) Toleranz. */
+    double adapt(const PerformanceMonitor& monitor);
+
+    /** pixel_scale = halbe Viewport-Höhe / tan(halber vertikaler Öffnungswinkel). */
+    static double pixelScale(double fov_y_degrees, int viewport_height);
+    /** Fehler der Stufe in Pixeln für eine Hüllkugel (radius) im Abstand distance. */
+    double projectedError(LodMode lod, double radius, double distance, double pixel_scale) const;
+    /** Neue Stufe einer Komponente, die bisher current zeigt (mit Hysterese). */
+    LodMode select(LodMode current, double radius, double distance, double pixel_scale) const;
+
+private:
+    double target_fps_{30.0};
+    double pixel_tolerance_{1.0};
+    double min_tolerance_{0.25};
+    double max_tolerance_{64.0};
+    double hysteresis_{0.25};
+    double deadband_{0.1};
+    std::size_t adapt_interval_{10};
+    std::size_t frames_since_adapt_{0};
+    double relative_error_[3]{0.002, 0.05, 1.0};
+};
+
+}  // namespace core
+}  // namespace cad
@@ -0,0 +1,242 @@
+#include "FamilyTableEvaluator.h"
+#include "KernelBridge.h"
+#include "PartHash.h"
+#include "io/MeshGenerator.h"
+#include "core/Modeler/Modeler.h"
+#include "core/Modeler/Part.h"
+#include "core/Modeler/Sketch.h"
+#include "core/parallel/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+
+namespace cad {
+namespace kernel {
+
+namespace {
+
+/** Hash über auf 1e-6 mm quantisierte Vertices + Indizes (stabil gegen Rundungsrauschen). */
+std::uint64_t hashMesh(const io::TriangleMesh& mesh) {
+    Hasher h;
+    for (double v : mesh.vertices) {
+        h.add(static_cast<std::int64_t>(std::llround(v * 1e6)));
+    }
+    for (unsigned int i : mesh.indices) {
+        h.add(static_cast<std::uint64_t>(i));
+    }
+    return h.value();
+}
+
+/** Volumen eines geschlossenen Netzes (Divergenzsatz, Vorzeichen unabhängig von der Orientierung). */
+double meshVolume(const io::TriangleMesh& mesh) {
+    double sum = 0.0;
+    const auto& v = mesh.vertices;
+    for (std::size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+        const double* a = &v[3 * mesh.indices[t]];
+        const double* b = &v[3 * mesh.indices[t + 1]];
+        const double* c = &v[3 * mesh.indices[t + 2]];
+        sum += a[0] * (b[1] * c[2] - b[2] * c[1])
+             - a[1] * (b[0] * c[2] - b[2] * c[0])
+             + a[2] * (b[0] * c[1] - b[1] * c[0]);
+    }
+    return std::abs(sum) / 6.0;
+}
+
+}  // namespace
+
+template <typename T>
+T RegenCache::lookup(std::unordered_map<std::uint64_t, std::shared_future<T>>& table, std::uint64_t key,
+                     const std::function<T()>& build, bool* hit) {
+    std::promise<T> promise;
+    std::shared_future<T> future;
+    bool owner = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = table.find(key);
+        if (it != table.end()) {
+            ++hits_;
+            future = it->second;
+        } else {
+            ++misses_;
+            owner = true;
+            future = promise.get_future().share();
+            table.emplace(key, future);
+        }
+    }
+    if (owner) {
+        try {
+            promise.set_value(build());
+        } catch (...) {
+            // Fehler nicht cachen: nur bereits Wartende sehen ihn, spätere Anfragen bauen neu
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                table.erase(key);
+            }
+            promise.set_exception(std::current_exception());
+        }
+    }
+    if (hit) *hit = !owner;
+    return future.get();
+}
+
+RegenCache::SolidPtr RegenCache::base(std::uint64_t key, const std::function<SolidPtr()>& build, bool* hit) {
+    return lookup(bases_, key, build, hit);
+}
+
+RegenCache::VariantPtr RegenCache::variant(std::uint64_t key, const std::function<VariantPtr()>& build, bool* hit) {
+    return lookup(variants_, key, build, hit);
+}
+
+std::size_t RegenCache::hits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+std::size_t RegenCache::misses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+std::size_t RegenCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bases_.size() + variants_.size();
+}
+
+void RegenCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bases_.clear();
+    variants_.clear();
+    hits_ = 0;
+    misses_ = 0;
+}
+
+FamilyTableEvaluator::FamilyTableEvaluator(cad::core::ThreadPool* pool)
+    : pool_(pool ? pool : &cad::core::ThreadPool::shared()) {}
+
+std::vector<FamilyVariantResult> FamilyTableEvaluator::evaluate(const cad::core::Part& part,
+                                                                const FamilyTableOptions& options) {
+    return evaluate(part, part.configurations(), options);
+}
+
+std::vector<FamilyVariantResult> FamilyTableEvaluator::evaluate(const cad::core::Part& part,
+                                                                const std::vector<cad::core::Configuration>& rows,
+                                                                const FamilyTableOptions& options) {
+    std::vector<FamilyVariantResult> results(rows.size());
+    pool_->parallelFor(rows.size(), [&](std::size_t i) {
+        results[i] = evaluateRow(part, rows[i], options);
+    });
+    return results;
+}
+
+FamilyVariantResult FamilyTableEvaluator::evaluateRow(const cad::core::Part& part,
+                                                      const cad::core::Configuration& row,
+                                                      const FamilyTableOptions& options) {
+    FamilyVariantResult result;
+    result.configuration = row.name;
+
+    // Copy-on-Write: nur Zeilen mit Overrides bekommen eine eigene Part-Kopie
+    std::optional<cad::core::Part> variantPart;
+    const cad::core::Part* effective = &part;
+    if (!row.parameter_overrides.empty()) {
+        variantPart.emplace(part);
+        cad::core::Modeler modeler;
+        if (!modeler.applyConfiguration(*variantPart, row)) {
+            result.message = "Konfiguration nicht anwendbar (unbekanntes Feature, Parameter oder Regel)";
+            return result;
+        }
+        effective = &*variantPart;
+    }
+
+    const int baseIdx = KernelBridge::findBaseFeature(*effective);
+    if (baseIdx < 0) {
+        result.message = "Kein Basis-Feature (Extrude/Revolve)";
+        return result;
+    }
+    const auto& features = effective->features();
+    const cad::core::Feature& baseFeat = features[static_cast<std::size_t>(baseIdx)];
+    const cad::core::Sketch* sketch = nullptr;
+    if (options.sketches) {
+        auto it = options.sketches->find(baseFeat.sketch_id);
+        if (it != options.sketches->end()) sketch = &it->second;
+    }
+    if (!sketch) {
+        result.message = "Skizze nicht gefunden: " + baseFeat.sketch_id;
+        return result;
+    }
+
+    Hasher baseHash;
+    hashFeature(baseHash, baseFeat);
+    hashSketch(baseHash, *sketch);
+    const std::uint64_t baseKey = baseHash.value();
+
+    // Der Cache überlebt evaluate()-Aufrufe: abhängige Skizzen gehen mit Inhalt ein, nicht nur per Id
+    Hasher variantHash;
+    variantHash.add(baseKey);
+    hashSketchRef(variantHash, baseFeat.path_sketch_id, options.sketches);
+    for (std::size_t i = 0; i < features.size(); ++i) {
+        if (static_cast<int>(i) == baseIdx || features[i].suppressed) continue;
+        hashFeature(variantHash, features[i]);
+        hashSketchRef(variantHash, features[i].sketch_id, options.sketches);
+        hashSketchRef(variantHash, features[i].path_sketch_id, options.sketches);
+    }
+
+    bool hit = false;
+    RegenCache::VariantPtr variant = cache_.variant(variantHash.value(), [&]() {
+        auto entry = std::make_shared<RegenCache::Variant>();
+        RegenCache::SolidPtr base = cache_.base(baseKey, [&]() {
+            return KernelBridge::buildBaseSolid(baseFeat, *sketch);
+        });
+        if (!base) {
+            entry->message = "Basis-Körper konnte nicht erzeugt werden";
+            return RegenCache::VariantPtr(entry);
+        }
+        std::shared_ptr<topology::Solid> solid = base;
+        for (std::size_t i = 0; i < features.size(); ++i) {
+            if (static_cast<int>(i) == baseIdx || features[i].suppressed) continue;
+            if (!KernelBridge::applyFeature(solid, features[i], options.sketches)) {
+                entry->message = "Feature fehlgeschlagen: " + features[i].name;
+                return RegenCache::VariantPtr(entry);
+            }
+        }
+        io::TriangleMesh mesh = io::triangulate(*solid);
+        if (mesh.vertices.empty()) {
+            solid->bounds(entry->bounds[0], entry->bounds[1], entry->bounds[2],
+                          entry->bounds[3], entry->bounds[4], entry->bounds[5]);
+            entry->volume = solid->volume();
+        } else {
+            double* b = entry->bounds;
+            b[0] = b[1] = b[2] = std::numeric_limits<double>::max();
+            b[3] = b[4] = b[5] = std::numeric_limits<double>::lowest();
+            for (std::size_t k = 0; k + 2 < mesh.vertices.size(); k += 3) {
+                for (int axis = 0; axis < 3; ++axis) {
+                    b[axis] = std::min(b[axis], mesh.vertices[k + axis]);
+                    b[axis + 3] = std::max(b[axis + 3], mesh.vertices[k + axis]);
+                }
+            }
+            entry->volume = meshVolume(mesh);
+        }
+        entry->mesh_hash = hashMesh(mesh);
+        entry->triangle_count = mesh.indices.size() / 3;
+        entry->success = true;
+        return RegenCache::VariantPtr(entry);
+    }, &hit);
+
+    result.cache_hit = hit;
+    result.success = variant->success;
+    result.message = variant->message;
+    result.min_x = variant->bounds[0];
+    result.min_y = variant->bounds[1];
+    result.min_z = variant->bounds[2];
+    result.max_x = variant->bounds[3];
+    result.max_y = variant->bounds[4];
+    result.max_z = variant->bounds[5];
+    result.volume = variant->volume;
+    result.mass = variant->volume * options.density;
+    result.mesh_hash = variant->mesh_hash;
+    result.triangle_count = variant->triangle_count;
+    return result;
+}
+
+}  // namespace kernel
+}  // namespace cad
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "topology/Solid.h"
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cad {
+namespace core {
+class Sketch;
+class Part;
+struct Configuration;
+class ThreadPool;
+}
+namespace kernel {
+
+/** Ergebnis einer Variante der Familientabelle (Konfiguration §19.6). */
+struct FamilyVariantResult {
+    std::string configuration;
+    bool success{false};
+    std::string message;
+    double min_x{0.0};
+    double min_y{0.0};
+    double min_z{0.0};
+    double max_x{0.0};
+    double max_y{0.0};
+    double max_z{0.0};
+    double volume{0.0};            // mm³ (aus geschlossenem Netz)
+    double mass{0.0};              // kg = volume * density
+    std::uint64_t mesh_hash{0};    // FNV-1a über quantisierte Vertices + Indizes
+    std::size_t triangle_count{0};
+    bool cache_hit{false};         // Geometrie aus RegenCache (andere Zeile identisch)
+};
+
+struct FamilyTableOptions {
+    double density{7.85e-6};  // kg/mm³ (Stahl)
+    const std::map<std::string, cad::core::Sketch>* sketches{nullptr};
+};
+
+/**
+ * Regenerations-Cache über Zeilen hinweg: Basis-Körper (Skizze + Extrude/Revolve) und fertig
+ * tessellierte Varianten nach Geometrie-Schlüssel. Gleichzeitige Anfragen desselben Schlüssels
+ * rechnen nur einmal (shared_future).
+ */
+class RegenCache {
+public:
+    struct Variant {
+        bool success{false};
+        std::string message;
+        double bounds[6]{0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        double volume{0.0};
+        std::uint64_t mesh_hash{0};
+        std::size_t triangle_count{0};
+    };
+    using SolidPtr = std::shared_ptr<topology::Solid>;  // geteilt, nur lesend verwenden
+    using VariantPtr = std::shared_ptr<const Variant>;
+
+    /**
+     * Liefert Eintrag; baut ihn über build() falls neu. hit = true wenn bereits vorhanden/in Arbeit.
+     * Wirft build(), erhalten gleichzeitig Wartende die Ausnahme; der Eintrag wird nicht behalten.
+     */
+    SolidPtr base(std::uint64_t key, const std::function<SolidPtr()>& build, bool* hit = nullptr);
+    VariantPtr variant(std::uint64_t key, const std::function<VariantPtr()>& build, bool* hit = nullptr);
+
+    std::size_t hits() const;
+    std::size_t misses() const;
+    std::size_t size() const;
+    void clear();
+
+private:
+    template <typename T>
+    T lookup(std::unordered_map<std::uint64_t, std::shared_future<T>>& table, std::uint64_t key,
+             const std::function<T()>& build, bool* hit);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::uint64_t, std::shared_future<SolidPtr>> bases_;
+    std::unordered_map<std::uint64_t, std::shared_future<VariantPtr>> variants_;
+    std::size_t hits_{0};
+    std::size_t misses_{0};
+};
+
+/**
+ * Batch-Auswertung einer Familientabelle: jede Zeile (Configuration) wird auf eine Copy-on-Write-Kopie
+ * des Parts angewendet, regeneriert und tesselliert – parallel auf dem ThreadPool, mit gemeinsamem RegenCache.
+ */
+class FamilyTableEvaluator {
+public:
+    /** pool == nullptr → core::ThreadPool::shared(). */
+    explicit FamilyTableEvaluator(cad::core::ThreadPool* pool = nullptr);
+
+    /** Alle Konfigurationen des Parts auswerten (Reihenfolge wie part.configurations()). */
+    std::vector<FamilyVariantResult> evaluate(const cad::core::Part& part,
+                                              const FamilyTableOptions& options = {});
+    /** Explizite Zeilen, z.B. aus CSV-Familientabelle. */
+    std::vector<FamilyVariantResult> evaluate(const cad::core::Part& part,
+                                              const std::vector<cad::core::Configuration>& rows,
+                                              const FamilyTableOptions& options = {});
+
+    RegenCache& cache() { return cache_; }
+    const RegenCache& cache() const { return cache_; }
+
+private:
+    FamilyVariantResult evaluateRow(const cad::core::Part& part, const cad::core::Configuration& row,
+                                    const FamilyTableOptions& options);
+
+    cad::core::ThreadPool* pool_{nullptr};
+    RegenCache cache_;
+};
+
+}  // namespace kernel
+}  // namespace cad
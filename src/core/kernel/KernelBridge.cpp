@@ -66,46 +66,38 @@ bool KernelBridge::applyFeature(std::shared_ptr<topology::Solid>& solid,
     }
 }
 
-bool KernelBridge::buildPartFromPart(const cad::core::Part& part,
-                                    const std::map<std::string, cad::core::Sketch>* sketches) {
-    if (!initialized_) return false;
-    lastSolid_.reset();
+int KernelBridge::findBaseFeature(const cad::core::Part& part) {
     const std::vector<cad::core::Feature>& features = part.features();
-    if (features.empty()) return false;
-
-    size_t baseIdx = static_cast<size_t>(-1);
     for (size_t i = 0; i < features.size(); ++i) {
+        if (features[i].suppressed) continue;
         if (features[i].type == cad::core::FeatureType::Extrude ||
             features[i].type == cad::core::FeatureType::Revolve) {
-            baseIdx = i;
-            break;
+            return static_cast<int>(i);
         }
     }
-    if (baseIdx >= features.size()) return false;
+    return -1;
+}
 
-    const cad::core::Feature& baseFeat = features[baseIdx];
-    const cad::core::Sketch* sketch = nullptr;
-    if (sketches) {
-        auto it = sketches->find(baseFeat.sketch_id);
-        if (it != sketches->end()) sketch = &it->second;
-    }
-    if (!sketch || sketch->geometry().empty()) return false;
-    geometry2d::Wire2D wire = builder::WireBuilder::build(*sketch);
-    if (wire.curves().empty()) return false;
+std::shared_ptr<topology::Solid> KernelBridge::buildBaseSolid(const cad::core::Feature& baseFeat,
+                                                              const cad::core::Sketch& sketch) {
+    if (sketch.geometry().empty()) return nullptr;
+    geometry2d::Wire2D wire = builder::WireBuilder::build(sketch);
+    if (wire.curves().empty()) return nullptr;
     auto face = builder::FaceBuilder::buildPlanarFace(wire, math::Point3(0, 0, 0), math::Vector3(0, 0, 1));
-    if (!face) return false;
+    if (!face) return nullptr;
 
+    std::shared_ptr<topology::Solid> solid;
     if (baseFeat.type == cad::core::FeatureType::Extrude) {
         double depth = baseFeat.depth > 0.0 ? baseFeat.depth : 10.0;
         math::Vector3 dir(0, 0, 1);
         if (baseFeat.symmetric) {
             depth *= 0.5;
             auto solidHalf = builder::SolidBuilder::extrude(face, math::Vector3(0, 0, -1), depth);
-            lastSolid_ = builder::SolidBuilder::extrude(face, math::Vector3(0, 0, 1), depth);
-            if (lastSolid_ && solidHalf)
-                lastSolid_ = boolean::fuse(lastSolid_, solidHalf);
+            solid = builder::SolidBuilder::extrude(face, math::Vector3(0, 0, 1), depth);
+            if (solid && solidHalf)
+                solid = boolean::fuse(solid, solidHalf);
         } else {
-            lastSolid_ = builder::SolidBuilder::extrude(face, dir, depth);
+            solid = builder::SolidBuilder::extrude(face, dir, depth);
         }
     } else {
         builder::Axis axis;
@@ -114,12 +106,33 @@ bool KernelBridge::buildPartFromPart(const cad::core::Part& part,
         if (baseFeat.axis == "X") axis.direction = math::Vector3(1, 0, 0);
         else if (baseFeat.axis == "Y") axis.direction = math::Vector3(0, 1, 0);
         double angleDeg = (baseFeat.angle > 0.0 && baseFeat.angle <= 360.0) ? baseFeat.angle : 360.0;
-        lastSolid_ = builder::SolidBuilder::revolve(face, axis, angleDeg);
+        solid = builder::SolidBuilder::revolve(face, axis, angleDeg);
+    }
+    return solid;
+}
+
+bool KernelBridge::buildPartFromPart(const cad::core::Part& part,
+                                    const std::map<std::string, cad::core::Sketch>* sketches) {
+    if (!initialized_) return false;
+    lastSolid_.reset();
+    const std::vector<cad::core::Feature>& features = part.features();
+    if (features.empty()) return false;
+
+    const int baseIdx = findBaseFeature(part);
+    if (baseIdx < 0) return false;
+
+    const cad::core::Feature& baseFeat = features[static_cast<size_t>(baseIdx)];
+    const cad::core::Sketch* sketch = nullptr;
+    if (sketches) {
+        auto it = sketches->find(baseFeat.sketch_id);
+        if (it != sketches->end()) sketch = &it->second;
     }
+    if (!sketch) return false;
+    lastSolid_ = buildBaseSolid(baseFeat, *sketch);
     if (!lastSolid_) return false;
 
     for (size_t i = 0; i < features.size(); ++i) {
-        if (i == baseIdx) continue;
+        if (static_cast<int>(i) == baseIdx || features[i].suppressed) continue;
         if (!applyFeature(lastSolid_, features[i], sketches)) return false;
     }
     return true;
@@ -26,10 +26,17 @@ public:
     std::shared_ptr<topology::Solid> getLastSolid() const { return lastSolid_; }
     io::TriangleMesh getLastSolidMesh() const;
     bool isAvailable() const { return initialized_; }
+
+    /** Index des Basis-Features (erstes aktives Extrude/Revolve) oder -1. Zustandslos, thread-sicher. */
+    static int findBaseFeature(const cad::core::Part& part);
+    /** Basis-Körper aus Skizze + Extrude/Revolve-Feature. Zustandslos, thread-sicher. */
+    static std::shared_ptr<topology::Solid> buildBaseSolid(const cad::core::Feature& baseFeature,
+                                                           const cad::core::Sketch& sketch);
+    /** Folge-Feature anwenden (Hole, Fillet, Chamfer, ...). Zustandslos, thread-sicher. */
+    static bool applyFeature(std::shared_ptr<topology::Solid>& solid,
+                             const cad::core::Feature& feature,
+                             const std::map<std::string, cad::core::Sketch>* sketches);
 private:
-    bool applyFeature(std::shared_ptr<topology::Solid>& solid,
-                     const cad::core::Feature& feature,
-                     const std::map<std::string, cad::core::Sketch>* sketches);
     bool initialized_{false};
     std::shared_ptr<topology::Solid> lastSolid_;
 };
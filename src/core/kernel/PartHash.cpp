@@ -0,0 +1,94 @@
+#include "PartHash.h"
+#include "core/Modeler/Part.h"
+#include "core/Modeler/Sketch.h"
+
+namespace cad {
+namespace kernel {
+
+void hashSketch(Hasher& h, const cad::core::Sketch& sketch) {
+    h.add(static_cast<std::uint64_t>(sketch.geometry().size()));
+    for (const auto& g : sketch.geometry()) {
+        h.add(g.id);
+        h.add(static_cast<int>(g.type));
+        h.add(g.start_point.x); h.add(g.start_point.y);
+        h.add(g.end_point.x); h.add(g.end_point.y);
+        h.add(g.center_point.x); h.add(g.center_point.y);
+        h.add(g.radius); h.add(g.start_angle); h.add(g.end_angle);
+        h.add(g.width); h.add(g.height);
+        h.add(g.text_content);
+        h.add(static_cast<std::uint64_t>(g.points.size()));
+        for (const auto& p : g.points) {
+            h.add(p.x); h.add(p.y);
+        }
+    }
+    // Bedingungen und Parameter: gleiche Geometrie, andere Bemaßung → andere Lösung
+    h.add(static_cast<std::uint64_t>(sketch.constraints().size()));
+    for (const auto& c : sketch.constraints()) {
+        h.add(static_cast<int>(c.type));
+        h.add(c.a); h.add(c.b); h.add(c.value);
+    }
+    h.add(static_cast<std::uint64_t>(sketch.parameters().size()));
+    for (const auto& p : sketch.parameters()) {
+        h.add(p.name); h.add(p.value); h.add(p.expression);
+    }
+}
+
+void hashSketchRef(Hasher& h, const std::string& sketch_id,
+                   const std::map<std::string, cad::core::Sketch>* sketches) {
+    if (sketch_id.empty()) return;
+    h.add(sketch_id);
+    const cad::core::Sketch* sketch = nullptr;
+    if (sketches) {
+        auto it = sketches->find(sketch_id);
+        if (it != sketches->end()) sketch = &it->second;
+    }
+    h.add(sketch != nullptr);
+    if (sketch) hashSketch(h, *sketch);
+}
+
+void hashFeature(Hasher& h, const cad::core::Feature& f) {
+    h.add(static_cast<int>(f.type));
+    h.add(f.sketch_id);
+    h.add(f.depth); h.add(f.symmetric); h.add(static_cast<int>(f.extrude_mode));
+    h.add(f.thin_wall); h.add(f.thin_thickness);
+    h.add(f.angle); h.add(f.axis);
+    h.add(f.diameter); h.add(f.hole_depth); h.add(f.through_all);
+    h.add(f.radius);
+    for (const auto& e : f.edge_ids) h.add(e);
+    h.add(f.count_x); h.add(f.count_y); h.add(f.count_z);
+    h.add(f.spacing_x); h.add(f.spacing_y); h.add(f.spacing_z);
+    h.add(f.circular_count); h.add(f.circular_angle); h.add(f.circular_axis);
+    h.add(f.path_sketch_id); h.add(f.path_count); h.add(f.path_equal_spacing);
+    h.add(f.twist_angle); h.add(f.scale_factor);
+    h.add(f.pitch); h.add(f.revolutions); h.add(f.clockwise);
+    h.add(f.wall_thickness);
+    for (const auto& id : f.face_ids) h.add(id);
+    h.add(f.draft_angle); h.add(f.draft_plane);
+    h.add(f.mirror_plane); h.add(f.merge_result);
+    h.add(f.thread_standard); h.add(f.thread_pitch); h.add(f.internal);
+    h.add(f.rib_thickness); h.add(f.rib_plane);
+    for (const auto& [key, value] : f.parameters) {
+        h.add(key);
+        h.add(value);
+    }
+}
+
+std::uint64_t partContentKey(const cad::core::Part& part,
+                             const std::map<std::string, cad::core::Sketch>* sketches,
+                             double tolerance) {
+    Hasher h;
+    h.add(tolerance);
+    std::uint64_t active = 0;
+    for (const auto& feature : part.features()) {
+        if (feature.suppressed) continue;
+        ++active;
+        hashFeature(h, feature);
+        hashSketchRef(h, feature.sketch_id, sketches);
+        hashSketchRef(h, feature.path_sketch_id, sketches);
+    }
+    h.add(active);
+    return h.value();
+}
+
+}  // namespace kernel
+}  // namespace cad
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+
+namespace cad {
+namespace core {
+class Sketch;
+class Part;
+struct Feature;
+}
+namespace kernel {
+
+/** FNV-1a (64 Bit), fortlaufend über heterogene Felder. */
+class Hasher {
+public:
+    void bytes(const void* data, std::size_t size) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            h_ ^= p[i];
+            h_ *= 1099511628211ull;
+        }
+    }
+    void add(double v) {
+        if (v == 0.0) v = 0.0;  // -0.0 == 0.0
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &v, sizeof(bits));
+        bytes(&bits, sizeof(bits));
+    }
+    void add(std::int64_t v) { bytes(&v, sizeof(v)); }
+    void add(std::uint64_t v) { bytes(&v, sizeof(v)); }
+    void add(int v) { add(static_cast<std::int64_t>(v)); }
+    void add(bool v) { add(static_cast<std::int64_t>(v ? 1 : 0)); }
+    void add(const std::string& s) {
+        add(static_cast<std::uint64_t>(s.size()));
+        bytes(s.data(), s.size());
+    }
+    std::uint64_t value() const { return h_; }
+private:
+    std::uint64_t h_{14695981039346656037ull};
+};
+
+/** Geometrie (samt Ids), Bedingungen und Parameter der Skizze. */
+void hashSketch(Hasher& h, const cad::core::Sketch& sketch);
+/** Skizzen-Id und, falls in sketches vorhanden, deren Inhalt (leere Id geht nicht ein). */
+void hashSketchRef(Hasher& h, const std::string& sketch_id,
+                   const std::map<std::string, cad::core::Sketch>* sketches);
+/** Alle geometrie-relevanten Feature-Felder (Name bewusst nicht – gleiche Maße = gleiche Geometrie). */
+void hashFeature(Hasher& h, const cad::core::Feature& feature);
+
+/**
+ * Inhaltsschlüssel eines Parts für den Tessellierungs-Cache: aktive Features in Reihenfolge, die
+ * referenzierten Skizzen und die Tessellierungstoleranz. Part- und Feature-Namen gehen nicht ein –
+ * inhaltsgleiche Teile teilen sich einen Eintrag. Stabil über Programmläufe (kein Zeiger, kein std::hash).
+ */
+std::uint64_t partContentKey(const cad::core::Part& part,
+                             const std::map<std::string, cad::core::Sketch>* sketches,
+                             double tolerance);
+
+}  // namespace kernel
+}  // namespace cad
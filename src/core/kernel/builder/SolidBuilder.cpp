@@ -146,6 +146,29 @@ std::shared_ptr<topology::Solid> SolidBuilder::extrude(
             auto plane = std::make_shared<geometry3d::PlaneSurface>(p0, p1 - p0, dir);
             shell->addFace(std::make_shared<topology::Face>(plane, std::make_shared<topology::Loop>(wire), std::vector<std::shared_ptr<topology::Loop>>{}, 0));
         }
+        // Deckflächen: Boden gegenläufig, Deckel in Profilrichtung → geschlossene, konsistent orientierte Hülle
+        const auto& profile = loop->wire()->edges();
+        if (profile.size() >= 3) {
+            std::vector<math::Point3> bottom, top;
+            for (const auto& edge : profile) {
+                bottom.push_back(edge->startVertex()->point());
+                top.push_back(tr.apply(edge->startVertex()->point()));
+            }
+            std::reverse(bottom.begin(), bottom.end());
+            for (const auto* ring : {&bottom, &top}) {
+                auto capWire = std::make_shared<topology::Wire>();
+                std::vector<std::shared_ptr<topology::Vertex>> verts;
+                for (const auto& p : *ring) verts.push_back(std::make_shared<topology::Vertex>(p, 0));
+                for (size_t i = 0; i < verts.size(); ++i) {
+                    const auto& a = verts[i];
+                    const auto& b = verts[(i + 1) % verts.size()];
+                    capWire->addEdge(std::make_shared<topology::Edge>(a, b, nullptr, 0, 1, 0));
+                }
+                auto capPlane = std::make_shared<geometry3d::PlaneSurface>((*ring)[0], (*ring)[1] - (*ring)[0],
+                                                                           (*ring)[2] - (*ring)[0]);
+                shell->addFace(std::make_shared<topology::Face>(capPlane, std::make_shared<topology::Loop>(capWire), std::vector<std::shared_ptr<topology::Loop>>{}, 0));
+            }
+        }
     }
     auto solid = std::make_shared<topology::Solid>();
     solid->setOuterShell(shell);
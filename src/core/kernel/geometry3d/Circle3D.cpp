@@ -35,6 +35,13 @@ math::Vector3 Circle3D::tangentAt(double t) const {
     ).normalized();
 }
 
+double Circle3D::parameterOf(const math::Point3& p) const {
+    const math::Vector3 d = p - center_;
+    double t = std::atan2(d.dot(vAxis_), d.dot(uAxis_));
+    if (t < 0.0) t += 2.0 * 3.14159265358979323846;
+    return t;
+}
+
 }  // namespace geometry3d
 }  // namespace kernel
 }  // namespace cad
@@ -14,6 +14,11 @@ public:
     math::Vector3 tangentAt(double t) const override;
     double tMin() const override { return 0.0; }
     double tMax() const override { return 2.0 * 3.14159265358979323846; }
+    /** Parameter in [0, 2π) des Kreispunkts, der p (in die Kreisebene projiziert) am nächsten liegt. */
+    double parameterOf(const math::Point3& p) const;
+    const math::Point3& center() const { return center_; }
+    double radius() const { return radius_; }
+    const math::Vector3& axis() const { return axis_; }
 private:
     math::Point3 center_;
     double radius_{0.0};
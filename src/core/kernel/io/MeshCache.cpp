@@ -0,0 +1,362 @@
+#include "io/MeshCache.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <tuple>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cad {
+namespace kernel {
+namespace io {
+
+namespace {
+
+constexpr char kMagic[4] = {'H', 'M', 'S', 'H'};
+constexpr std::uint32_t kVersion = 1;
+constexpr const char* kExtension = ".hmesh";
+
+/** Dateikopf; danach vertex_count * 3 double, index_count uint32 (Host-Byte-Layout, nur lokaler Cache). */
+struct FileHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t key;
+    std::int32_t lod;
+    std::uint32_t reserved;
+    std::uint64_t vertex_count;
+    std::uint64_t index_count;
+};
+static_assert(sizeof(FileHeader) == 40, "FileHeader muss 8-Byte-ausgerichtet bleiben");
+
+std::uint64_t payloadSize(std::uint64_t vertex_count, std::uint64_t index_count) {
+    return sizeof(FileHeader) + vertex_count * 3 * sizeof(double) + index_count * sizeof(std::uint32_t);
+}
+
+/** Kopf + Größe + Indexbereich prüfen; false = Datei unbrauchbar. */
+bool validate(const unsigned char* data, std::size_t size, std::uint64_t key, int lod,
+              const double*& vertices, const std::uint32_t*& indices,
+              std::size_t& vertex_count, std::size_t& index_count) {
+    if (size < sizeof(FileHeader)) return false;
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.key != key || header.lod != lod || header.index_count % 3 != 0) {
+        return false;
+    }
+    if (header.vertex_count > size / (3 * sizeof(double)) || header.index_count > size / sizeof(std::uint32_t) ||
+        payloadSize(header.vertex_count, header.index_count) != size) {
+        return false;
+    }
+    vertices = reinterpret_cast<const double*>(data + sizeof(FileHeader));
+    indices = reinterpret_cast<const std::uint32_t*>(data + sizeof(FileHeader) +
+                                                     header.vertex_count * 3 * sizeof(double));
+    vertex_count = static_cast<std::size_t>(header.vertex_count);
+    index_count = static_cast<std::size_t>(header.index_count);
+    for (std::size_t i = 0; i < index_count; ++i) {
+        if (indices[i] >= vertex_count) return false;
+    }
+    return true;
+}
+
+struct CellHash {
+    std::size_t operator()(const std::tuple<std::int64_t, std::int64_t, std::int64_t>& c) const {
+        std::uint64_t h = static_cast<std::uint64_t>(std::get<0>(c)) * 0x9E3779B97F4A7C15ull;
+        h ^= static_cast<std::uint64_t>(std::get<1>(c)) * 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+        h ^= static_cast<std::uint64_t>(std::get<2>(c)) * 0x165667B19E3779F9ull + (h << 6) + (h >> 2);
+        return static_cast<std::size_t>(h);
+    }
+};
+
+}  // namespace
+
+MappedMesh::~MappedMesh() {
+#ifndef _WIN32
+    if (mapping_) munmap(mapping_, mapping_size_);
+#endif
+}
+
+TriangleMesh MappedMesh::toTriangleMesh() const {
+    TriangleMesh mesh;
+    mesh.vertices.assign(vertices_, vertices_ + vertex_count_ * 3);
+    mesh.indices.assign(indices_, indices_ + index_count_);
+    return mesh;
+}
+
+MeshCache::MeshCache(std::string directory, std::uint64_t max_bytes)
+    : directory_(std::move(directory)), max_bytes_(max_bytes) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::create_directories(directory_, ec);
+    if (!fs::is_directory(directory_, ec)) return;
+    valid_ = true;
+
+    // Vorhandene Einträge nach Änderungszeit einsortieren → LRU-Reihenfolge des letzten Laufs
+    std::vector<std::tuple<fs::file_time_type, std::string, std::uint64_t>> found;
+    for (fs::directory_iterator it(directory_, ec), end; !ec && it != end; it.increment(ec)) {
+        if (!it->is_regular_file(ec)) continue;
+        const fs::path& path = it->path();
+        if (path.extension() == ".tmp") {
+            // Abgebrochener Schreibvorgang; junge Dateien können einem parallel laufenden Prozess gehören
+            if (fs::file_time_type::clock::now() - it->last_write_time(ec) > std::chrono::hours(1)) {
+                fs::remove(path, ec);
+            }
+            continue;
+        }
+        if (path.extension() != kExtension) continue;
+        const std::uint64_t size = it->file_size(ec);
+        const fs::file_time_type time = it->last_write_time(ec);
+        if (!ec) found.emplace_back(time, path.filename().string(), size);
+    }
+    std::sort(found.begin(), found.end());
+    for (const auto& [time, name, size] : found) {
+        entries_[name] = Entry{size, ++clock_};
+        total_bytes_ += size;
+    }
+    stats_.entries = entries_.size();
+    stats_.bytes = total_bytes_;
+    collectGarbageLocked();
+}
+
+std::string MeshCache::fileName(std::uint64_t key, int lod) const {
+    char name[48];
+    std::snprintf(name, sizeof(name), "%016llx-l%d%s", static_cast<unsigned long long>(key), lod, kExtension);
+    return name;
+}
+
+bool MeshCache::store(std::uint64_t key, const TriangleMesh& mesh, int lod) {
+    namespace fs = std::filesystem;
+    if (!valid_) return false;
+    const TriangleMesh welded = weld(mesh);
+
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.key = key;
+    header.lod = lod;
+    header.vertex_count = welded.vertices.size() / 3;
+    header.index_count = welded.indices.size();
+    std::vector<std::uint32_t> indices(welded.indices.begin(), welded.indices.end());
+
+    const std::string name = fileName(key, lod);
+    const fs::path target = fs::path(directory_) / name;
+    std::uint64_t sequence = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sequence = ++clock_;
+    }
+    const fs::path temp = fs::path(directory_) / (name + "." + std::to_string(sequence) + ".tmp");
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(welded.vertices.data()),
+                  static_cast<std::streamsize>(header.vertex_count * 3 * sizeof(double)));
+        out.write(reinterpret_cast<const char*>(indices.data()),
+                  static_cast<std::streamsize>(indices.size() * sizeof(std::uint32_t)));
+        if (!out) {
+            out.close();
+            std::error_code ec;
+            fs::remove(temp, ec);
+            return false;
+        }
+    }
+    std::error_code ec;
+    fs::rename(temp, target, ec);
+    if (ec) {
+        fs::remove(temp, ec);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::uint64_t size = payloadSize(header.vertex_count, header.index_count);
+    auto it = entries_.find(name);
+    if (it != entries_.end()) total_bytes_ -= it->second.bytes;
+    entries_[name] = Entry{size, ++clock_};
+    total_bytes_ += size;
+    ++stats_.stores;
+    collectGarbageLocked();
+    return true;
+}
+
+std::shared_ptr<const MappedMesh> MeshCache::load(std::uint64_t key, int lod) {
+    namespace fs = std::filesystem;
+    if (!valid_) return nullptr;
+    const std::string name = fileName(key, lod);
+    const std::string path = (fs::path(directory_) / name).string();
+
+    std::shared_ptr<MappedMesh> mesh(new MappedMesh());
+    const unsigned char* data = nullptr;
+    std::size_t size = 0;
+#ifndef _WIN32
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat info;
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            size = static_cast<std::size_t>(info.st_size);
+            void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                mesh->mapping_ = mapping;
+                mesh->mapping_size_ = size;
+                data = static_cast<const unsigned char*>(mapping);
+            }
+        }
+        ::close(fd);
+    }
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (in) {
+        size = static_cast<std::size_t>(in.tellg());
+        mesh->buffer_.resize((size + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+        in.seekg(0);
+        if (in.read(reinterpret_cast<char*>(mesh->buffer_.data()), static_cast<std::streamsize>(size))) {
+            data = reinterpret_cast<const unsigned char*>(mesh->buffer_.data());
+        }
+    }
+#endif
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!data) {
+        ++stats_.misses;
+        return nullptr;
+    }
+    if (!validate(data, size, key, lod, mesh->vertices_, mesh->indices_, mesh->vertex_count_, mesh->index_count_)) {
+        ++stats_.misses;
+        std::error_code ec;
+        fs::remove(path, ec);
+        auto it = entries_.find(name);
+        if (it != entries_.end()) {
+            total_bytes_ -= it->second.bytes;
+            entries_.erase(it);
+        }
+        return nullptr;
+    }
+    ++stats_.hits;
+    auto it = entries_.find(name);
+    if (it == entries_.end()) {
+        // Von einem anderen Prozess mit demselben Verzeichnis geschrieben
+        it = entries_.emplace(name, Entry{size, 0}).first;
+        total_bytes_ += size;
+    }
+    it->second.last_use = ++clock_;
+    touchLocked(name);
+    return mesh;
+}
+
+bool MeshCache::contains(std::uint64_t key, int lod) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.count(fileName(key, lod)) > 0;
+}
+
+void MeshCache::remove(std::uint64_t key, int lod) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::string name = fileName(key, lod);
+    std::error_code ec;
+    std::filesystem::remove(std::filesystem::path(directory_) / name, ec);
+    auto it = entries_.find(name);
+    if (it != entries_.end()) {
+        total_bytes_ -= it->second.bytes;
+        entries_.erase(it);
+    }
+}
+
+void MeshCache::touchLocked(const std::string& name) {
+    std::error_code ec;
+    std::filesystem::last_write_time(std::filesystem::path(directory_) / name,
+                                     std::filesystem::file_time_type::clock::now(), ec);
+}
+
+void MeshCache::setMaxBytes(std::uint64_t max_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_bytes_ = max_bytes;
+    collectGarbageLocked();
+}
+
+std::uint64_t MeshCache::maxBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return max_bytes_;
+}
+
+std::size_t MeshCache::collectGarbage() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return collectGarbageLocked();
+}
+
+std::size_t MeshCache::collectGarbageLocked() {
+    if (total_bytes_ <= max_bytes_) return 0;
+    std::vector<std::pair<std::uint64_t, std::string>> order;
+    order.reserve(entries_.size());
+    for (const auto& [name, entry] : entries_) order.emplace_back(entry.last_use, name);
+    std::sort(order.begin(), order.end());
+    std::size_t removed = 0;
+    for (const auto& [last_use, name] : order) {
+        if (total_bytes_ <= max_bytes_) break;
+        std::error_code ec;
+        std::filesystem::remove(std::filesystem::path(directory_) / name, ec);
+        total_bytes_ -= entries_[name].bytes;
+        entries_.erase(name);
+        ++removed;
+    }
+    stats_.collected += removed;
+    return removed;
+}
+
+void MeshCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [name, entry] : entries_) {
+        std::error_code ec;
+        std::filesystem::remove(std::filesystem::path(directory_) / name, ec);
+    }
+    entries_.clear();
+    total_bytes_ = 0;
+}
+
+MeshCacheStats MeshCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    MeshCacheStats result = stats_;
+    result.entries = entries_.size();
+    result.bytes = total_bytes_;
+    return result;
+}
+
+TriangleMesh MeshCache::weld(const TriangleMesh& mesh, double tolerance) {
+    TriangleMesh result;
+    const std::size_t count = mesh.vertices.size() / 3;
+    const double scale = tolerance > 0.0 ? 1.0 / tolerance : 1e6;
+    std::unordered_map<std::tuple<std::int64_t, std::int64_t, std::int64_t>, std::uint32_t, CellHash> cells;
+    cells.reserve(count);
+    std::vector<std::uint32_t> remap(count);
+    result.vertices.reserve(mesh.vertices.size());
+    for (std::size_t i = 0; i < count; ++i) {
+        const double* p = &mesh.vertices[3 * i];
+        const auto cell = std::make_tuple(std::llround(p[0] * scale), std::llround(p[1] * scale),
+                                          std::llround(p[2] * scale));
+        auto [it, inserted] = cells.emplace(cell, static_cast<std::uint32_t>(result.vertices.size() / 3));
+        if (inserted) result.vertices.insert(result.vertices.end(), p, p + 3);
+        remap[i] = it->second;
+    }
+    result.indices.reserve(mesh.indices.size());
+    for (std::size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+        if (mesh.indices[t] >= count || mesh.indices[t + 1] >= count || mesh.indices[t + 2] >= count) continue;
+        const unsigned int a = remap[mesh.indices[t]];
+        const unsigned int b = remap[mesh.indices[t + 1]];
+        const unsigned int c = remap[mesh.indices[t + 2]];
+        if (a == b || b == c || a == c) continue;
+        result.indices.push_back(a);
+        result.indices.push_back(b);
+        result.indices.push_back(c);
+    }
+    return result;
+}
+
+}  // namespace io
+}  // namespace kernel
+}  // namespace cad
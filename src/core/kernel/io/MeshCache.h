@@ -0,0 +1,116 @@
+#pragma once
+
+#include "io/MeshGenerator.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cad {
+namespace kernel {
+namespace io {
+
+/**
+ * Schreibgeschützte Sicht auf ein gecachtes Netz. Unter POSIX direkt auf die gemappte Datei
+ * (kein Kopieren, Zeiger bleiben gültig solange die Sicht lebt – auch wenn der Cache die Datei
+ * inzwischen löscht); sonst aus einem Lesepuffer.
+ */
+class MappedMesh {
+public:
+    ~MappedMesh();
+    MappedMesh(const MappedMesh&) = delete;
+    MappedMesh& operator=(const MappedMesh&) = delete;
+
+    /** xyz hintereinander, vertexCount() Punkte. */
+    const double* vertices() const { return vertices_; }
+    std::size_t vertexCount() const { return vertex_count_; }
+    const std::uint32_t* indices() const { return indices_; }
+    std::size_t indexCount() const { return index_count_; }
+    std::size_t triangleCount() const { return index_count_ / 3; }
+    bool isMapped() const { return mapping_ != nullptr; }
+
+    /** Kopie für Aufrufer, die eigene Felder brauchen. */
+    TriangleMesh toTriangleMesh() const;
+
+private:
+    friend class MeshCache;
+    MappedMesh() = default;
+
+    void* mapping_{nullptr};
+    std::size_t mapping_size_{0};
+    std::vector<std::uint64_t> buffer_;  // 8-Byte-ausgerichtet wie die Datei
+    const double* vertices_{nullptr};
+    const std::uint32_t* indices_{nullptr};
+    std::size_t vertex_count_{0};
+    std::size_t index_count_{0};
+};
+
+struct MeshCacheStats {
+    std::size_t entries{0};
+    std::uint64_t bytes{0};
+    std::size_t hits{0};
+    std::size_t misses{0};
+    std::size_t stores{0};
+    std::size_t collected{0};
+};
+
+/**
+ * Inhaltsadressierter Tessellierungs-Cache auf der Platte: je Schlüssel (partContentKey) und
+ * LOD-Stufe eine Datei mit verschweißtem Netz. Schreiben über temporäre Datei + Umbenennen,
+ * Lesen per mmap. Überschreitet der Verzeichnisinhalt max_bytes, werden die am längsten nicht
+ * gelesenen Einträge gelöscht (Zugriffszeit = Änderungszeit der Datei, übersteht Neustarts).
+ * Thread-sicher.
+ */
+class MeshCache {
+public:
+    static constexpr std::uint64_t kDefaultMaxBytes = 2048ull * 1024 * 1024;
+
+    /** Legt das Verzeichnis bei Bedarf an und liest vorhandene Einträge ein. */
+    explicit MeshCache(std::string directory, std::uint64_t max_bytes = kDefaultMaxBytes);
+
+    bool isValid() const { return valid_; }
+    const std::string& directory() const { return directory_; }
+
+    /** Verschweißt das Netz und legt es ab (ersetzt vorhandenen Eintrag). */
+    bool store(std::uint64_t key, const TriangleMesh& mesh, int lod = 0);
+    /** nullptr bei Fehltreffer oder beschädigter Datei (die dann entfernt wird). */
+    std::shared_ptr<const MappedMesh> load(std::uint64_t key, int lod = 0);
+    bool contains(std::uint64_t key, int lod = 0) const;
+    void remove(std::uint64_t key, int lod = 0);
+
+    void setMaxBytes(std::uint64_t max_bytes);
+    std::uint64_t maxBytes() const;
+    /** Löscht älteste Einträge bis max_bytes eingehalten ist; Anzahl gelöschter Dateien. */
+    std::size_t collectGarbage();
+    void clear();
+    MeshCacheStats stats() const;
+
+    /** Punkte im Abstand < tolerance zusammenführen (Raster), degenerierte Dreiecke verwerfen. */
+    static TriangleMesh weld(const TriangleMesh& mesh, double tolerance = 1e-6);
+
+private:
+    struct Entry {
+        std::uint64_t bytes{0};
+        std::uint64_t last_use{0};
+    };
+
+    std::string fileName(std::uint64_t key, int lod) const;
+    std::size_t collectGarbageLocked();
+    void touchLocked(const std::string& name);
+
+    std::string directory_;
+    bool valid_{false};
+    std::uint64_t max_bytes_{kDefaultMaxBytes};
+    std::uint64_t total_bytes_{0};
+    std::uint64_t clock_{0};
+    std::map<std::string, Entry> entries_;
+    MeshCacheStats stats_;
+    mutable std::mutex mutex_;
+};
+
+}  // namespace io
+}  // namespace kernel
+}  // namespace cad
@@ -0,0 +1,195 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace cad {
+namespace core {
+
+namespace {
+
+/** Pool und Worker-Index des aktuellen Threads (nullptr außerhalb eines Workers). */
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local std::size_t current_index = 0;
+
+}  // namespace
+
+ThreadPool::ThreadPool(std::size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    local_.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        local_.push_back(std::make_unique<WorkerQueue>());
+    }
+    workers_.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        workers_.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::enqueue(std::function<void()> task, TaskPriority priority) {
+    // Zähler vor dem Einreihen erhöhen: ein Worker, der ihn sieht, findet die Aufgabe spätestens gleich danach
+    pending_.fetch_add(1, std::memory_order_acq_rel);
+    if (priority == TaskPriority::Normal && current_pool == this) {
+        WorkerQueue& queue = *local_[current_index];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        // Schlafende Worker prüfen pending_ unter mutex_ → Benachrichtigung kann nicht verloren gehen
+        std::lock_guard<std::mutex> lock(mutex_);
+    } else {
+        std::lock_guard<std::mutex> lock(mutex_);
+        global_[static_cast<int>(priority)].push_back(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+bool ThreadPool::popGlobal(TaskPriority priority, std::function<void()>& task) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& queue = global_[static_cast<int>(priority)];
+    if (queue.empty()) {
+        return false;
+    }
+    task = std::move(queue.front());
+    queue.pop_front();
+    return true;
+}
+
+bool ThreadPool::take(std::size_t index, std::function<void()>& task) {
+    bool found = popGlobal(TaskPriority::High, task);
+    if (!found) {
+        // Eigene Deque LIFO: zuletzt erzeugte Teilaufgaben sind noch im Cache
+        WorkerQueue& own = *local_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+    if (!found) {
+        found = popGlobal(TaskPriority::Normal, task);
+    }
+    for (std::size_t k = 1; !found && k < local_.size(); ++k) {
+        // Stehlen FIFO: älteste (meist gröbste) Aufgaben eines anderen Workers
+        WorkerQueue& victim = *local_[(index + k) % local_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            stolen_.fetch_add(1, std::memory_order_relaxed);
+            found = true;
+        }
+    }
+    if (!found) {
+        found = popGlobal(TaskPriority::Low, task);
+    }
+    if (found) {
+        pending_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+    return found;
+}
+
+void ThreadPool::workerLoop(std::size_t index) {
+    current_pool = this;
+    current_index = index;
+    for (;;) {
+        std::function<void()> task;
+        if (take(index, task)) {
+            task();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return stopping_ || pending_.load(std::memory_order_acquire) > 0; });
+        if (stopping_ && pending_.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+namespace {
+
+/** Gemeinsamer Zustand eines parallelFor; überlebt Helfer, die erst nach Abschluss starten. */
+struct ParallelForState {
+    std::function<void(std::size_t)> body;
+    std::size_t count{0};
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> done{0};
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+
+    void drain() {
+        for (;;) {
+            const std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= count) {
+                return;
+            }
+            try {
+                body(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+            if (done.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.notify_all();
+            }
+        }
+    }
+};
+
+}  // namespace
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+    if (count == 1 || workers_.empty()) {
+        for (std::size_t i = 0; i < count; ++i) {
+            body(i);
+        }
+        return;
+    }
+    auto state = std::make_shared<ParallelForState>();
+    state->body = body;
+    state->count = count;
+    const std::size_t helpers = std::min(workers_.size(), count - 1);
+    for (std::size_t h = 0; h < helpers; ++h) {
+        enqueue([state]() { state->drain(); });
+    }
+    state->drain();
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->finished.wait(lock, [&]() { return state->done.load(std::memory_order_acquire) == count; });
+    }
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+}  // namespace core
+}  // namespace cad
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cad {
+namespace core {
+
+/**
+ * Vorrang einer Aufgabe: High vor allem anderen (z.B. sichtbare Komponenten), Low erst,
+ * wenn keine andere Arbeit mehr ansteht (Vorausladen).
+ */
+enum class TaskPriority {
+    High,
+    Normal,
+    Low
+};
+
+/** Kooperativer Abbruch: Kopien teilen den Zustand, Aufgaben prüfen cancelled() selbst. */
+class CancellationToken {
+public:
+    CancellationToken() : flag_(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void cancel() const { flag_->store(true, std::memory_order_relaxed); }
+    bool cancelled() const { return flag_->load(std::memory_order_relaxed); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> flag_;
+};
+
+/**
+ * Fester Worker-Pool für CPU-lastige Batch-Arbeit (Regeneration, Tessellierung, Laden).
+ * Work-Stealing: Aufgaben, die ein Worker selbst erzeugt (Normal), landen in seiner lokalen
+ * Deque und werden dort LIFO abgearbeitet; untätige Worker stehlen FIFO von den anderen.
+ * Aufgaben von außen sowie High/Low laufen über globale Warteschlangen je Priorität.
+ * thread_count == 0 → std::thread::hardware_concurrency().
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(std::size_t thread_count = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template <typename F>
+    auto submit(F&& task, TaskPriority priority = TaskPriority::Normal)
+        -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using R = std::invoke_result_t<std::decay_t<F>>;
+        auto packaged = std::make_shared<std::packaged_task<R()>>(std::forward<F>(task));
+        std::future<R> result = packaged->get_future();
+        enqueue([packaged]() { (*packaged)(); }, priority);
+        return result;
+    }
+
+    /**
+     * body(i) für i in [0, count). Der aufrufende Thread arbeitet mit, daher auch
+     * aus einem Worker heraus verschachtelbar ohne Deadlock. Erste Exception wird weitergereicht.
+     */
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& body);
+
+    std::size_t threadCount() const { return workers_.size(); }
+    /** Eingereihte, noch nicht gestartete Aufgaben. */
+    std::size_t pendingTasks() const { return pending_.load(std::memory_order_relaxed); }
+    /** Von anderen Workern übernommene Aufgaben seit dem Start (Diagnose). */
+    std::size_t stolenTasks() const { return stolen_.load(std::memory_order_relaxed); }
+
+    /** Prozessweiter Pool (lazy), für Dienste ohne eigenen Pool. */
+    static ThreadPool& shared();
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void enqueue(std::function<void()> task, TaskPriority priority = TaskPriority::Normal);
+    bool take(std::size_t index, std::function<void()>& task);
+    bool popGlobal(TaskPriority priority, std::function<void()>& task);
+    void workerLoop(std::size_t index);
+
+    std::vector<std::thread> workers_;
+    std::vector<std::unique_ptr<WorkerQueue>> local_;
+    std::deque<std::function<void()>> global_[3];
+    std::atomic<std::size_t> pending_{0};
+    std::atomic<std::size_t> stolen_{0};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_{false};
+};
+
+}  // namespace core
+}  // namespace cad
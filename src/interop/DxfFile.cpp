@@ -0,0 +1,976 @@
+#include "DxfFile.h"
+#include "MappedFile.h"
+#include "TextSink.h"
+#include "../core/perf/PerfSpan.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace cad {
+namespace interop {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kDegToRad = kPi / 180.0;
+constexpr int kMaxBlockDepth = 32;
+/** Obergrenze aufgelöster Blockvorkommen je flattenDxf (gegen Explosion durch Raster/Mehrfach-INSERT). */
+constexpr std::size_t kMaxBlockInstances = 1u << 22;
+
+inline std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) text.remove_suffix(1);
+    return text;
+}
+
+double toReal(std::string_view text) {
+    text = trim(text);
+    if (!text.empty() && text.front() == '+') text.remove_prefix(1);
+    double value = 0.0;
+    std::from_chars(text.data(), text.data() + text.size(), value);
+    return value;
+}
+
+int toInt(std::string_view text) {
+    text = trim(text);
+    if (!text.empty() && text.front() == '+') text.remove_prefix(1);
+    int value = 0;
+    std::from_chars(text.data(), text.data() + text.size(), value);
+    return value;
+}
+
+/** Gruppe (Code, Wert) eines ASCII-DXF; value zeigt in den Eingabepuffer. */
+struct Group {
+    int code{-1};
+    std::string_view value;
+};
+
+/** Liest Gruppen als Zeilenpaare (\n oder \r\n); Codes dürfen mit Leerzeichen aufgefüllt sein. */
+class GroupStream {
+public:
+    GroupStream(const char* begin, const char* end) : p_(begin), end_(end) {}
+
+    /** false am Ende der Eingabe oder bei ungültigem Code (bad()). */
+    bool next(Group& group) {
+        std::string_view code_line;
+        do {
+            if (!line(code_line)) return false;
+            code_line = trim(code_line);
+        } while (code_line.empty() && p_ >= end_);
+        const char* e = code_line.data() + code_line.size();
+        const auto result = std::from_chars(code_line.data(), e, group.code);
+        if (result.ec != std::errc() || result.ptr != e || !line(group.value)) {
+            bad_ = true;
+            return false;
+        }
+        return true;
+    }
+    bool bad() const { return bad_; }
+    std::size_t lineNumber() const { return lines_; }
+
+private:
+    bool line(std::string_view& out) {
+        if (p_ >= end_) return false;
+        const char* newline = static_cast<const char*>(std::memchr(p_, '\n', static_cast<std::size_t>(end_ - p_)));
+        const char* stop = newline ? newline : end_;
+        const char* e = stop;
+        if (e > p_ && e[-1] == '\r') --e;
+        out = std::string_view(p_, static_cast<std::size_t>(e - p_));
+        p_ = newline ? newline + 1 : end_;
+        ++lines_;
+        return true;
+    }
+
+    const char* p_;
+    const char* end_;
+    std::size_t lines_{0};
+    bool bad_{false};
+};
+
+/** Gruppen einer Entity bis zum nächsten Code 0; die Vektoren werden über alle Entities wiederverwendet. */
+struct EntityData {
+    std::string_view type;
+    std::string_view name;
+    std::string_view text;
+    /** 10/20: Punkt, Mittelpunkt, Einfügepunkt bzw. alle Ecken (LWPOLYLINE) und Kontrollpunkte (SPLINE). */
+    std::vector<core::Point2D> points;
+    /** 11/21: Endpunkt (LINE), Hauptachse (ELLIPSE), Fitpunkte (SPLINE). */
+    std::vector<core::Point2D> second;
+    /** 42 je Ecke (LWPOLYLINE). */
+    std::vector<double> bulges;
+    double v40{0.0};
+    double v41{std::numeric_limits<double>::quiet_NaN()};
+    double v42{std::numeric_limits<double>::quiet_NaN()};
+    double v44{0.0};
+    double v45{0.0};
+    double v50{0.0};
+    double v51{360.0};
+    int v70{0};
+    int v71{0};
+    double extrusion_z{1.0};
+    bool paper_space{false};
+    bool lwpolyline{false};
+
+    void reset(std::string_view entity_type) {
+        type = entity_type;
+        name = {};
+        text = {};
+        points.clear();
+        second.clear();
+        bulges.clear();
+        v40 = 0.0;
+        v41 = std::numeric_limits<double>::quiet_NaN();
+        v42 = std::numeric_limits<double>::quiet_NaN();
+        v44 = v45 = v50 = 0.0;
+        v51 = 360.0;
+        v70 = v71 = 0;
+        extrusion_z = 1.0;
+        paper_space = false;
+        lwpolyline = entity_type == "LWPOLYLINE";
+    }
+
+    void add(const Group& group) {
+        switch (group.code) {
+            case 1: text = group.value; break;
+            case 2: name = trim(group.value); break;
+            case 10:
+                points.push_back({toReal(group.value), 0.0});
+                if (lwpolyline) bulges.push_back(0.0);
+                break;
+            case 20:
+                if (!points.empty()) points.back().y = toReal(group.value);
+                break;
+            case 11: second.push_back({toReal(group.value), 0.0}); break;
+            case 21:
+                if (!second.empty()) second.back().y = toReal(group.value);
+                break;
+            case 40: v40 = toReal(group.value); break;
+            case 41: v41 = toReal(group.value); break;
+            case 42:
+                if (lwpolyline) {
+                    if (!bulges.empty()) bulges.back() = toReal(group.value);
+                } else {
+                    v42 = toReal(group.value);
+                }
+                break;
+            case 44: v44 = toReal(group.value); break;
+            case 45: v45 = toReal(group.value); break;
+            case 50: v50 = toReal(group.value); break;
+            case 51: v51 = toReal(group.value); break;
+            case 67: paper_space = toInt(group.value) != 0; break;
+            case 70: v70 = toInt(group.value); break;
+            case 71: v71 = toInt(group.value); break;
+            case 230: extrusion_z = toReal(group.value); break;
+            default: break;
+        }
+    }
+
+    core::Point2D point(std::size_t i = 0) const { return i < points.size() ? points[i] : core::Point2D{}; }
+};
+
+/** Offene POLYLINE bis SEQEND (R12-Stil mit VERTEX-Entities). */
+struct PolylineData {
+    bool open{false};
+    bool closed{false};
+    bool mirrored{false};
+    std::vector<core::Point2D> points;
+    std::vector<double> bulges;
+};
+
+/** Ziel der Entities: Modellbereich oder aktueller Block. */
+struct Target {
+    std::vector<core::GeometryEntity>* entities;
+    std::vector<DxfInsert>* inserts;
+};
+
+inline double orDefault(double value, double fallback) {
+    return std::isnan(value) ? fallback : value;
+}
+
+inline double normalizeDegrees(double angle) {
+    angle = std::fmod(angle, 360.0);
+    return angle < 0.0 ? angle + 360.0 : angle;
+}
+
+core::GeometryEntity makeLine(const core::Point2D& a, const core::Point2D& b) {
+    core::GeometryEntity entity;
+    entity.type = core::GeometryType::Line;
+    entity.start_point = a;
+    entity.end_point = b;
+    return entity;
+}
+
+/** Bogen aus einem Bulge-Segment a → b (bulge = tan(Öffnungswinkel/4), > 0 gegen den Uhrzeigersinn). */
+core::GeometryEntity makeBulgeArc(const core::Point2D& a, const core::Point2D& b, double bulge) {
+    const double dx = b.x - a.x;
+    const double dy = b.y - a.y;
+    const double chord = std::hypot(dx, dy);
+    if (chord <= 0.0) {
+        return makeLine(a, b);
+    }
+    const double half = chord * 0.5;
+    const double offset = half * (1.0 - bulge * bulge) / (2.0 * bulge);
+    core::GeometryEntity entity;
+    entity.type = core::GeometryType::Arc;
+    entity.center_point = {(a.x + b.x) * 0.5 - dy / chord * offset, (a.y + b.y) * 0.5 + dx / chord * offset};
+    entity.radius = half * (1.0 + bulge * bulge) / (2.0 * std::fabs(bulge));
+    const double angle_a = normalizeDegrees(std::atan2(a.y - entity.center_point.y, a.x - entity.center_point.x) / kDegToRad);
+    const double angle_b = normalizeDegrees(std::atan2(b.y - entity.center_point.y, b.x - entity.center_point.x) / kDegToRad);
+    entity.start_angle = bulge > 0.0 ? angle_a : angle_b;
+    entity.end_angle = bulge > 0.0 ? angle_b : angle_a;
+    return entity;
+}
+
+/** Ohne Bulges ein Polygon (geschlossen: erster Punkt wird wiederholt), sonst Linien und Bögen je Segment. */
+void emitPolyline(const std::vector<core::Point2D>& points, const std::vector<double>& bulges, bool closed,
+                  std::vector<core::GeometryEntity>& out) {
+    if (points.empty()) {
+        return;
+    }
+    const bool curved = std::any_of(bulges.begin(), bulges.end(), [](double b) { return b != 0.0; });
+    if (!curved) {
+        core::GeometryEntity entity;
+        entity.type = core::GeometryType::Polygon;
+        entity.points.reserve(points.size() + 1);
+        entity.points.assign(points.begin(), points.end());
+        if (closed && points.size() > 2) {
+            entity.points.push_back(points.front());
+        }
+        entity.start_point = entity.points.front();
+        entity.end_point = entity.points.back();
+        out.push_back(std::move(entity));
+        return;
+    }
+    const std::size_t count = closed ? points.size() : points.size() - 1;
+    for (std::size_t i = 0; i < count; ++i) {
+        const core::Point2D& a = points[i];
+        const core::Point2D& b = points[(i + 1) % points.size()];
+        const double bulge = i < bulges.size() ? bulges[i] : 0.0;
+        out.push_back(bulge != 0.0 ? makeBulgeArc(a, b, bulge) : makeLine(a, b));
+    }
+}
+
+/** Übersetzt eine vollständige Entity; false = nicht unterstützt. */
+bool emitEntity(EntityData& data, PolylineData& polyline, const Target& target, DxfReadStats& stats) {
+    // Extrusion (0,0,-1): OCS ist an der Y-Achse gespiegelt
+    const bool mirrored = data.extrusion_z < 0.0;
+    if (mirrored) {
+        for (auto& p : data.points) p.x = -p.x;
+        for (auto& p : data.second) p.x = -p.x;
+        for (auto& b : data.bulges) b = -b;
+    }
+    const std::string_view type = data.type;
+    std::vector<core::GeometryEntity>& out = *target.entities;
+    core::GeometryEntity entity;
+    if (type == "LINE") {
+        entity = makeLine(data.point(), data.second.empty() ? data.point() : data.second.front());
+    } else if (type == "POINT") {
+        entity.type = core::GeometryType::Point;
+        entity.start_point = data.point();
+    } else if (type == "CIRCLE") {
+        entity.type = core::GeometryType::Circle;
+        entity.center_point = data.point();
+        entity.radius = data.v40;
+    } else if (type == "ARC") {
+        entity.type = core::GeometryType::Arc;
+        entity.center_point = data.point();
+        entity.radius = data.v40;
+        entity.start_angle = mirrored ? normalizeDegrees(180.0 - data.v51) : data.v50;
+        entity.end_angle = mirrored ? normalizeDegrees(180.0 - data.v50) : data.v51;
+    } else if (type == "ELLIPSE") {
+        const core::Point2D axis = data.second.empty() ? core::Point2D{} : data.second.front();
+        const double major = std::hypot(axis.x, axis.y);
+        const double minor = major * data.v40;
+        entity.type = core::GeometryType::Ellipse;
+        entity.center_point = data.point();
+        const bool along_x = std::fabs(axis.x) >= std::fabs(axis.y);
+        entity.radius = along_x ? major : minor;
+        entity.width = along_x ? minor : major;
+    } else if (type == "TEXT" || type == "MTEXT") {
+        entity.type = core::GeometryType::Text;
+        entity.start_point = data.point();
+        entity.text_content = std::string(data.text);
+    } else if (type == "LWPOLYLINE") {
+        const std::size_t before = out.size();
+        emitPolyline(data.points, data.bulges, (data.v70 & 1) != 0, out);
+        stats.entities += out.size() - before;
+        return true;
+    } else if (type == "SPLINE") {
+        const std::vector<core::Point2D>& source = data.points.empty() ? data.second : data.points;
+        if (source.empty()) {
+            return false;
+        }
+        entity.type = core::GeometryType::Spline;
+        entity.points = source;
+        entity.start_point = source.front();
+        entity.end_point = source.back();
+    } else if (type == "INSERT") {
+        DxfInsert insert;
+        insert.block = std::string(data.name);
+        insert.position = data.point();
+        insert.scale_x = orDefault(data.v41, 1.0) * (mirrored ? -1.0 : 1.0);
+        insert.scale_y = orDefault(data.v42, 1.0);
+        insert.rotation = mirrored ? -data.v50 : data.v50;
+        insert.columns = std::max(1, data.v70);
+        insert.rows = std::max(1, data.v71);
+        insert.column_spacing = mirrored ? -data.v44 : data.v44;
+        insert.row_spacing = data.v45;
+        target.inserts->push_back(std::move(insert));
+        ++stats.inserts;
+        return true;
+    } else if (type == "POLYLINE") {
+        // 16/64: Polygon- bzw. Polyface-Netz, keine Kontur
+        if ((data.v70 & (16 | 64)) != 0) {
+            return false;
+        }
+        polyline.open = true;
+        polyline.closed = (data.v70 & 1) != 0;
+        polyline.mirrored = mirrored;
+        polyline.points.clear();
+        polyline.bulges.clear();
+        return true;
+    } else if (type == "VERTEX") {
+        if (!polyline.open) {
+            return false;
+        }
+        // Ecken liegen im OCS der POLYLINE
+        core::Point2D p = data.point();
+        const double bulge = orDefault(data.v42, 0.0);
+        if (mirrored) p.x = -p.x;
+        if (polyline.mirrored) p.x = -p.x;
+        polyline.points.push_back(p);
+        polyline.bulges.push_back(polyline.mirrored ? -bulge : bulge);
+        return true;
+    } else if (type == "SEQEND") {
+        if (polyline.open) {
+            const std::size_t before = out.size();
+            emitPolyline(polyline.points, polyline.bulges, polyline.closed, out);
+            stats.entities += out.size() - before;
+            polyline.open = false;
+        }
+        return true;
+    } else {
+        return false;
+    }
+    out.push_back(std::move(entity));
+    ++stats.entities;
+    return true;
+}
+
+double unitToMm(int insunits) {
+    switch (insunits) {
+        case 1: return 25.4;
+        case 2: return 304.8;
+        case 5: return 10.0;
+        case 6: return 1000.0;
+        case 8: return 25.4e-6;
+        case 9: return 25.4e-3;
+        case 10: return 914.4;
+        case 13: return 1e-3;
+        case 14: return 100.0;
+        default: return 1.0;
+    }
+}
+
+int insunitsFor(double unit_to_mm) {
+    struct Unit {
+        double mm;
+        int code;
+    };
+    static const Unit units[] = {{25.4, 1}, {304.8, 2}, {10.0, 5}, {1000.0, 6}, {914.4, 10}, {1e-3, 13}, {100.0, 14}};
+    for (const Unit& unit : units) {
+        if (std::fabs(unit_to_mm - unit.mm) <= unit.mm * 1e-9) {
+            return unit.code;
+        }
+    }
+    return 4;
+}
+
+}  // namespace
+
+bool DxfReader::readFile(const std::string& path) {
+    MappedFile input(path);
+    if (!input.ok()) {
+        drawing_ = DxfDrawing{};
+        stats_ = DxfReadStats{};
+        error_ = "Could not open file: " + path;
+        return false;
+    }
+    return parse(input.data(), input.size());
+}
+
+bool DxfReader::readText(std::string_view text) {
+    return parse(text.data(), text.size());
+}
+
+bool DxfReader::parse(const char* data, std::size_t size) {
+    core::PerfTimer timer("dxf.parse");
+    drawing_ = DxfDrawing{};
+    stats_ = DxfReadStats{};
+    error_.clear();
+    auto fail = [&](const std::string& message) {
+        error_ = message;
+        drawing_ = DxfDrawing{};
+        return false;
+    };
+    static constexpr char kBinarySentinel[] = "AutoCAD Binary DXF";
+    if (size >= sizeof(kBinarySentinel) - 1 && std::memcmp(data, kBinarySentinel, sizeof(kBinarySentinel) - 1) == 0) {
+        return fail("Binary DXF is not supported");
+    }
+
+    enum class Section { None, Header, Blocks, Entities, Other };
+    Section section = Section::None;
+    bool expect_section_name = false;
+    bool seen_section = false;
+    std::string_view header_variable;
+    // Laufende Entity (type leer = keine); BLOCK-Kopf und ENDBLK werden wie Entities gesammelt
+    EntityData entity;
+    PolylineData polyline;
+    constexpr std::size_t kNoBlock = static_cast<std::size_t>(-1);
+    std::size_t block = kNoBlock;
+    const Target model{&drawing_.entities, &drawing_.inserts};
+
+    auto finish = [&]() {
+        if (entity.type.empty()) {
+            return;
+        }
+        if (entity.type == "BLOCK") {
+            DxfBlock& definition = drawing_.blocks[block];
+            definition.name = std::string(entity.name);
+            definition.base = entity.point();
+        } else if (entity.type != "ENDBLK") {
+            const bool in_block = block != kNoBlock;
+            if (!in_block && entity.paper_space) {
+                ++stats_.skipped;
+            } else {
+                const Target target =
+                    in_block ? Target{&drawing_.blocks[block].entities, &drawing_.blocks[block].inserts} : model;
+                if (!emitEntity(entity, polyline, target, stats_)) {
+                    ++stats_.skipped;
+                }
+            }
+        }
+        entity.type = {};
+    };
+
+    GroupStream in(data, data + size);
+    Group group;
+    while (in.next(group)) {
+        if (group.code == 0) {
+            finish();
+            const std::string_view value = trim(group.value);
+            if (value == "SECTION") {
+                expect_section_name = true;
+                seen_section = true;
+                section = Section::Other;
+            } else if (value == "ENDSEC") {
+                section = Section::None;
+                block = kNoBlock;
+            } else if (value == "EOF") {
+                break;
+            } else if (section == Section::Blocks && value == "BLOCK") {
+                drawing_.blocks.emplace_back();
+                block = drawing_.blocks.size() - 1;
+                ++stats_.blocks;
+                entity.reset(value);
+            } else if (section == Section::Blocks && value == "ENDBLK") {
+                block = kNoBlock;
+                entity.reset(value);
+            } else if (section == Section::Entities || (section == Section::Blocks && block != kNoBlock)) {
+                entity.reset(value);
+            }
+            continue;
+        }
+        if (expect_section_name && group.code == 2) {
+            expect_section_name = false;
+            const std::string_view name = trim(group.value);
+            section = name == "HEADER"     ? Section::Header
+                      : name == "BLOCKS"   ? Section::Blocks
+                      : name == "ENTITIES" ? Section::Entities
+                                           : Section::Other;
+        } else if (section == Section::Header) {
+            if (group.code == 9) {
+                header_variable = trim(group.value);
+            } else if (group.code == 70 && header_variable == "$INSUNITS") {
+                drawing_.unit_to_mm = unitToMm(toInt(group.value));
+            }
+        } else if (!entity.type.empty()) {
+            entity.add(group);
+        }
+    }
+    finish();
+    if (in.bad()) {
+        return fail("Invalid group code at line " + std::to_string(in.lineNumber()));
+    }
+    if (!seen_section) {
+        return fail("Not a DXF file (SECTION missing)");
+    }
+    stats_.parse_ms = timer.finish().elapsed_ms;
+    return true;
+}
+
+namespace {
+
+/** Affine 2D-Abbildung x' = a·x + b·y + tx, y' = c·x + d·y + ty. */
+struct Affine2 {
+    double a{1.0}, b{0.0}, c{0.0}, d{1.0}, tx{0.0}, ty{0.0};
+
+    core::Point2D apply(const core::Point2D& p) const { return {a * p.x + b * p.y + tx, c * p.x + d * p.y + ty}; }
+    double det() const { return a * d - b * c; }
+    /** this ∘ other */
+    Affine2 operator*(const Affine2& o) const {
+        return {a * o.a + b * o.c, a * o.b + b * o.d, c * o.a + d * o.c,
+                c * o.b + d * o.d, a * o.tx + b * o.ty + tx, c * o.tx + d * o.ty + ty};
+    }
+    bool isIdentity() const { return a == 1.0 && b == 0.0 && c == 0.0 && d == 1.0 && tx == 0.0 && ty == 0.0; }
+    /** Winkeltreu (Drehung, gleichmäßiger Maßstab, ggf. gespiegelt). */
+    bool isConformal() const {
+        const double sx = a * a + c * c;
+        const double sy = b * b + d * d;
+        return std::fabs(sx - sy) <= 1e-9 * std::max(sx, sy) && std::fabs(a * b + c * d) <= 1e-9 * std::max(sx, sy);
+    }
+    /** Richtung eines Winkels (Grad) nach der Abbildung, in Grad. */
+    double mapAngle(double degrees) const {
+        const double x = std::cos(degrees * kDegToRad);
+        const double y = std::sin(degrees * kDegToRad);
+        return normalizeDegrees(std::atan2(c * x + d * y, a * x + b * y) / kDegToRad);
+    }
+};
+
+class Flattener {
+public:
+    Flattener(const DxfDrawing& drawing, std::vector<core::GeometryEntity>& out, DxfFlattenStats& stats)
+        : out_(out), stats_(stats) {
+        blocks_.reserve(drawing.blocks.size());
+        for (const DxfBlock& block : drawing.blocks) {
+            blocks_.emplace(block.name, &block);
+        }
+    }
+
+    void expand(const std::vector<core::GeometryEntity>& entities, const std::vector<DxfInsert>& inserts,
+                const Affine2& m, int depth) {
+        const bool identity = m.isIdentity();
+        for (const core::GeometryEntity& entity : entities) {
+            if (identity) {
+                out_.push_back(entity);
+            } else {
+                transform(entity, m);
+            }
+        }
+        for (const DxfInsert& insert : inserts) {
+            if (stats_.truncated) {
+                return;
+            }
+            const auto it = blocks_.find(insert.block);
+            // Block schon auf dem aktuellen Pfad: Zyklus, nicht erst an der Tiefengrenze abbrechen
+            if (it == blocks_.end() || depth >= kMaxBlockDepth ||
+                std::find(path_.begin(), path_.end(), it->second) != path_.end()) {
+                ++stats_.unresolved;
+                continue;
+            }
+            const DxfBlock& block = *it->second;
+            path_.push_back(&block);
+            const double cos_r = std::cos(insert.rotation * kDegToRad);
+            const double sin_r = std::sin(insert.rotation * kDegToRad);
+            // Drehung · Maßstab · Verschiebung um den Basispunkt
+            Affine2 local{cos_r * insert.scale_x, -sin_r * insert.scale_y, sin_r * insert.scale_x,
+                          cos_r * insert.scale_y, 0.0, 0.0};
+            local.tx = -(local.a * block.base.x + local.b * block.base.y);
+            local.ty = -(local.c * block.base.x + local.d * block.base.y);
+            for (int row = 0; row < std::max(1, insert.rows); ++row) {
+                for (int column = 0; column < std::max(1, insert.columns); ++column) {
+                    const double ox = column * insert.column_spacing;
+                    const double oy = row * insert.row_spacing;
+                    Affine2 cell = local;
+                    cell.tx += insert.position.x + cos_r * ox - sin_r * oy;
+                    cell.ty += insert.position.y + sin_r * ox + cos_r * oy;
+                    if (stats_.instances >= kMaxBlockInstances) {
+                        stats_.truncated = true;
+                        path_.pop_back();
+                        return;
+                    }
+                    ++stats_.instances;
+                    expand(block.entities, block.inserts, m * cell, depth + 1);
+                }
+            }
+            path_.pop_back();
+        }
+    }
+
+private:
+    void transform(const core::GeometryEntity& source, const Affine2& m) {
+        core::GeometryEntity entity = source;
+        const double scale = std::sqrt(std::fabs(m.det()));
+        switch (source.type) {
+            case core::GeometryType::Point:
+            case core::GeometryType::Text:
+                entity.start_point = m.apply(source.start_point);
+                break;
+            case core::GeometryType::Line:
+            case core::GeometryType::Polygon:
+            case core::GeometryType::Spline:
+                entity.start_point = m.apply(source.start_point);
+                entity.end_point = m.apply(source.end_point);
+                for (core::Point2D& p : entity.points) {
+                    p = m.apply(p);
+                }
+                break;
+            case core::GeometryType::Rectangle: {
+                const core::Point2D corners[4] = {
+                    source.start_point,
+                    {source.start_point.x + source.width, source.start_point.y},
+                    {source.start_point.x + source.width, source.start_point.y + source.height},
+                    {source.start_point.x, source.start_point.y + source.height}};
+                if (m.b == 0.0 && m.c == 0.0) {
+                    const core::Point2D p0 = m.apply(corners[0]);
+                    const core::Point2D p2 = m.apply(corners[2]);
+                    entity.start_point = {std::min(p0.x, p2.x), std::min(p0.y, p2.y)};
+                    entity.width = std::fabs(p2.x - p0.x);
+                    entity.height = std::fabs(p2.y - p0.y);
+                } else {
+                    entity.type = core::GeometryType::Polygon;
+                    entity.points.clear();
+                    for (const core::Point2D& corner : corners) {
+                        entity.points.push_back(m.apply(corner));
+                    }
+                    entity.points.push_back(entity.points.front());
+                    entity.start_point = entity.end_point = entity.points.front();
+                    entity.width = entity.height = 0.0;
+                }
+                break;
+            }
+            case core::GeometryType::Circle:
+                entity.center_point = m.apply(source.center_point);
+                entity.radius = source.radius * scale;
+                if (!m.isConformal()) ++stats_.approximated;
+                break;
+            case core::GeometryType::Arc: {
+                entity.center_point = m.apply(source.center_point);
+                entity.radius = source.radius * scale;
+                double sweep = source.end_angle - source.start_angle;
+                sweep = sweep > 0.0 && sweep <= 360.0 ? sweep : normalizeDegrees(sweep);
+                // Spiegelung kehrt den Umlaufsinn um: der Endpunkt wird zum Start
+                entity.start_angle = m.mapAngle(m.det() < 0.0 ? source.end_angle : source.start_angle);
+                entity.end_angle = entity.start_angle + sweep;
+                if (sweep < 360.0) entity.end_angle = normalizeDegrees(entity.end_angle);
+                if (!m.isConformal()) ++stats_.approximated;
+                break;
+            }
+            case core::GeometryType::Ellipse:
+                entity.center_point = m.apply(source.center_point);
+                entity.radius = source.radius * scale;
+                entity.width = source.width * scale;
+                if (!m.isConformal() || m.b != 0.0 || m.c != 0.0) ++stats_.approximated;
+                break;
+        }
+        out_.push_back(std::move(entity));
+    }
+
+    std::vector<core::GeometryEntity>& out_;
+    DxfFlattenStats& stats_;
+    std::unordered_map<std::string, const DxfBlock*> blocks_;
+    /** Blöcke auf dem Pfad von der Wurzel zum aktuell aufgelösten Vorkommen. */
+    std::vector<const DxfBlock*> path_;
+};
+
+}  // namespace
+
+std::vector<core::GeometryEntity> flattenDxf(const DxfDrawing& drawing, DxfFlattenStats* stats) {
+    core::PerfTimer timer("dxf.flatten");
+    DxfFlattenStats local;
+    DxfFlattenStats& s = stats ? *stats : local;
+    s = DxfFlattenStats{};
+    std::vector<core::GeometryEntity> out;
+    out.reserve(drawing.entities.size());
+    Flattener flattener(drawing, out, s);
+    const double unit = drawing.unit_to_mm > 0.0 ? drawing.unit_to_mm : 1.0;
+    flattener.expand(drawing.entities, drawing.inserts, Affine2{unit, 0.0, 0.0, unit, 0.0, 0.0}, 0);
+    s.entities = out.size();
+    return out;
+}
+
+std::size_t appendDxfToSketch(const DxfDrawing& drawing, core::Sketch& sketch, DxfFlattenStats* stats) {
+    return sketch.appendGeometry(flattenDxf(drawing, stats));
+}
+
+namespace {
+
+/** Gruppenweise Ausgabe; Werte ohne Zeilenumbrüche. */
+class GroupWriter {
+public:
+    GroupWriter(TextSink& out, std::string_view layer) : out_(out), layer_(layer) {}
+
+    void text(int code, std::string_view value) {
+        code_(code);
+        for (char c : value) {
+            out_.put(c == '\n' || c == '\r' ? ' ' : c);
+        }
+        out_.put('\n');
+    }
+    void real(int code, double value) {
+        code_(code);
+        out_.real(value);
+        out_.put('\n');
+    }
+    void integer(int code, std::uint64_t value) {
+        code_(code);
+        out_.integer(value);
+        out_.put('\n');
+    }
+    void point(int code, const core::Point2D& p) {
+        real(code, p.x);
+        real(code + 10, p.y);
+        real(code + 20, 0.0);
+    }
+    /** "0 TYPE", Layer und Unterklassen AcDbEntity/subclass. */
+    void begin(std::string_view type, std::string_view subclass) {
+        text(0, type);
+        text(100, "AcDbEntity");
+        text(8, layer_);
+        text(100, subclass);
+    }
+
+    void entity(const core::GeometryEntity& entity, double text_height) {
+        switch (entity.type) {
+            case core::GeometryType::Point:
+                begin("POINT", "AcDbPoint");
+                point(10, entity.start_point);
+                break;
+            case core::GeometryType::Line:
+                begin("LINE", "AcDbLine");
+                point(10, entity.start_point);
+                point(11, entity.end_point);
+                break;
+            case core::GeometryType::Circle:
+                begin("CIRCLE", "AcDbCircle");
+                point(10, entity.center_point);
+                real(40, entity.radius);
+                break;
+            case core::GeometryType::Arc:
+                begin("ARC", "AcDbCircle");
+                point(10, entity.center_point);
+                real(40, entity.radius);
+                text(100, "AcDbArc");
+                real(50, entity.start_angle);
+                real(51, entity.end_angle);
+                break;
+            case core::GeometryType::Ellipse: {
+                // Hauptachse muss die längere sein (Verhältnis ≤ 1)
+                const bool along_x = entity.radius >= entity.width;
+                const double major = along_x ? entity.radius : entity.width;
+                begin("ELLIPSE", "AcDbEllipse");
+                point(10, entity.center_point);
+                point(11, along_x ? core::Point2D{major, 0.0} : core::Point2D{0.0, major});
+                real(40, major > 0.0 ? (along_x ? entity.width : entity.radius) / major : 1.0);
+                real(41, 0.0);
+                real(42, 2.0 * kPi);
+                break;
+            }
+            case core::GeometryType::Rectangle: {
+                const core::Point2D& p = entity.start_point;
+                const core::Point2D corners[4] = {
+                    p, {p.x + entity.width, p.y}, {p.x + entity.width, p.y + entity.height}, {p.x, p.y + entity.height}};
+                polyline(corners, 4, true);
+                break;
+            }
+            case core::GeometryType::Polygon: {
+                const core::Point2D ends[2] = {entity.start_point, entity.end_point};
+                const core::Point2D* points = entity.points.empty() ? ends : entity.points.data();
+                std::size_t count = entity.points.empty() ? 2 : entity.points.size();
+                const bool closed = count > 3 && points[0].x == points[count - 1].x && points[0].y == points[count - 1].y;
+                polyline(points, closed ? count - 1 : count, closed);
+                break;
+            }
+            case core::GeometryType::Spline: {
+                const core::Point2D ends[2] = {entity.start_point, entity.end_point};
+                const core::Point2D* points = entity.points.empty() ? ends : entity.points.data();
+                const std::size_t count = entity.points.empty() ? 2 : entity.points.size();
+                spline(points, count);
+                break;
+            }
+            case core::GeometryType::Text:
+                begin("TEXT", "AcDbText");
+                point(10, entity.start_point);
+                real(40, text_height);
+                text(1, entity.text_content);
+                text(100, "AcDbText");
+                break;
+        }
+    }
+
+    void insert(const DxfInsert& insert) {
+        begin("INSERT", "AcDbBlockReference");
+        text(2, insert.block);
+        point(10, insert.position);
+        if (insert.scale_x != 1.0 || insert.scale_y != 1.0) {
+            real(41, insert.scale_x);
+            real(42, insert.scale_y);
+            real(43, 1.0);
+        }
+        if (insert.rotation != 0.0) {
+            real(50, insert.rotation);
+        }
+        if (insert.columns > 1 || insert.rows > 1) {
+            integer(70, static_cast<std::uint64_t>(std::max(1, insert.columns)));
+            integer(71, static_cast<std::uint64_t>(std::max(1, insert.rows)));
+            real(44, insert.column_spacing);
+            real(45, insert.row_spacing);
+        }
+    }
+
+private:
+    void code_(int code) {
+        out_.integer(static_cast<std::uint64_t>(code));
+        out_.put('\n');
+    }
+
+    void polyline(const core::Point2D* points, std::size_t count, bool closed) {
+        begin("LWPOLYLINE", "AcDbPolyline");
+        integer(90, count);
+        integer(70, closed ? 1 : 0);
+        for (std::size_t i = 0; i < count; ++i) {
+            real(10, points[i].x);
+            real(20, points[i].y);
+        }
+    }
+
+    void spline(const core::Point2D* points, std::size_t count) {
+        const std::size_t degree = std::min<std::size_t>(3, count > 1 ? count - 1 : 1);
+        const std::size_t knots = count + degree + 1;
+        const std::size_t spans = count > degree ? count - degree : 1;
+        begin("SPLINE", "AcDbSpline");
+        integer(70, 8);
+        integer(71, degree);
+        integer(72, knots);
+        integer(73, count);
+        integer(74, 0);
+        for (std::size_t k = 0; k < knots; ++k) {
+            const std::size_t interior = k <= degree ? 0 : std::min(k - degree, spans);
+            real(40, static_cast<double>(interior) / static_cast<double>(spans));
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            point(10, points[i]);
+        }
+    }
+
+    TextSink& out_;
+    std::string_view layer_;
+};
+
+}  // namespace
+
+DxfWriter::DxfWriter(DxfWriteOptions options) : options_(std::move(options)) {}
+
+bool DxfWriter::writeDrawing(const std::string& path, const DxfDrawing& drawing) {
+    return write(path, drawing.entities, &drawing);
+}
+
+bool DxfWriter::writeSketch(const std::string& path, const core::Sketch& sketch) {
+    return write(path, sketch.geometry(), nullptr);
+}
+
+bool DxfWriter::write(const std::string& path, const std::vector<core::GeometryEntity>& entities,
+                      const DxfDrawing* drawing) {
+    core::PerfTimer timer("dxf.write");
+    stats_ = DxfWriteStats{};
+    error_.clear();
+    if (drawing) {
+        std::unordered_set<std::string_view> names;
+        for (const DxfBlock& block : drawing->blocks) {
+            if (block.name.empty() || !names.insert(block.name).second) {
+                error_ = "Invalid or duplicate block name: '" + block.name + "'";
+                return false;
+            }
+        }
+        auto known = [&](const std::vector<DxfInsert>& inserts) {
+            for (const DxfInsert& insert : inserts) {
+                if (names.count(insert.block) == 0) {
+                    error_ = "Unknown block: " + insert.block;
+                    return false;
+                }
+            }
+            return true;
+        };
+        if (!known(drawing->inserts)) {
+            return false;
+        }
+        for (const DxfBlock& block : drawing->blocks) {
+            if (!known(block.inserts)) {
+                return false;
+            }
+        }
+    }
+    std::ofstream file(path, std::ios::binary);
+    if (path.empty() || !file.is_open()) {
+        error_ = "Could not create file: " + path;
+        return false;
+    }
+    TextSink out(file, options_.buffer_bytes);
+    GroupWriter groups(out, options_.layer.empty() ? std::string_view("0") : std::string_view(options_.layer));
+
+    groups.text(0, "SECTION");
+    groups.text(2, "HEADER");
+    groups.text(9, "$ACADVER");
+    groups.text(1, "AC1015");
+    groups.text(9, "$INSUNITS");
+    groups.integer(70, static_cast<std::uint64_t>(insunitsFor(drawing ? drawing->unit_to_mm : 1.0)));
+    groups.text(0, "ENDSEC");
+
+    if (drawing && !drawing->blocks.empty()) {
+        groups.text(0, "SECTION");
+        groups.text(2, "BLOCKS");
+        for (const DxfBlock& block : drawing->blocks) {
+            groups.begin("BLOCK", "AcDbBlockBegin");
+            groups.text(2, block.name);
+            groups.integer(70, 0);
+            groups.point(10, block.base);
+            groups.text(3, block.name);
+            for (const core::GeometryEntity& entity : block.entities) {
+                groups.entity(entity, options_.text_height);
+            }
+            for (const DxfInsert& insert : block.inserts) {
+                groups.insert(insert);
+            }
+            groups.begin("ENDBLK", "AcDbBlockEnd");
+            stats_.entities += block.entities.size();
+            stats_.inserts += block.inserts.size();
+            ++stats_.blocks;
+        }
+        groups.text(0, "ENDSEC");
+    }
+
+    groups.text(0, "SECTION");
+    groups.text(2, "ENTITIES");
+    for (const core::GeometryEntity& entity : entities) {
+        groups.entity(entity, options_.text_height);
+    }
+    stats_.entities += entities.size();
+    if (drawing) {
+        for (const DxfInsert& insert : drawing->inserts) {
+            groups.insert(insert);
+        }
+        stats_.inserts += drawing->inserts.size();
+    }
+    groups.text(0, "ENDSEC");
+    groups.text(0, "EOF");
+
+    const bool ok = out.flush();
+    file.close();
+    stats_.bytes = out.bytes();
+    stats_.write_ms = timer.finish().elapsed_ms;
+    if (!ok || !file) {
+        error_ = "Write failed: " + path;
+        return false;
+    }
+    return true;
+}
+
+}  // namespace interop
+}  // namespace cad
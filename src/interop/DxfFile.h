@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../core/Modeler/Sketch.h"
+
+namespace cad {
+namespace interop {
+
+/** Blockreferenz (INSERT); columns × rows als rechteckiges Raster im gedrehten System der Referenz. */
+struct DxfInsert {
+    std::string block;
+    core::Point2D position;
+    double scale_x{1.0};
+    double scale_y{1.0};
+    /** Grad, gegen den Uhrzeigersinn. */
+    double rotation{0.0};
+    int columns{1};
+    int rows{1};
+    double column_spacing{0.0};
+    double row_spacing{0.0};
+};
+
+/** Blockdefinition (BLOCKS): Geometrie relativ zum Basispunkt, auch verschachtelte Referenzen. */
+struct DxfBlock {
+    std::string name;
+    core::Point2D base;
+    std::vector<core::GeometryEntity> entities;
+    std::vector<DxfInsert> inserts;
+};
+
+/**
+ * Zeichnung mit Blöcken: Modellbereich (entities + inserts) und Blockdefinitionen. Wiederholte
+ * Geometrie (Teile einer Schachtelung, Normteile) steht einmal als Block und je Vorkommen als INSERT.
+ * Skizzengeometrie ohne Ids; Polygone mit points (geschlossen: letzter Punkt == erster).
+ */
+struct DxfDrawing {
+    std::vector<core::GeometryEntity> entities;
+    std::vector<DxfInsert> inserts;
+    std::vector<DxfBlock> blocks;
+    /** Zeichnungseinheit in mm ($INSUNITS; 1 = mm oder ohne Einheit). */
+    double unit_to_mm{1.0};
+};
+
+struct DxfReadStats {
+    /** Gelesene Geometrie (Modellbereich und Blöcke), Blockdefinitionen, INSERT-Entities. */
+    std::size_t entities{0};
+    std::size_t blocks{0};
+    std::size_t inserts{0};
+    /** Nicht unterstützte Entities (HATCH, DIMENSION, …) und Papierbereich. */
+    std::size_t skipped{0};
+    double parse_ms{0.0};
+};
+
+struct DxfFlattenStats {
+    std::size_t entities{0};
+    /** Aufgelöste Blockvorkommen (Rasterzellen einzeln, verschachtelt mitgezählt). */
+    std::size_t instances{0};
+    /** Unbekannte Blöcke, zyklische Referenzen (Block auf dem eigenen Pfad) bzw. zu tiefe Verschachtelung. */
+    std::size_t unresolved{0};
+    /** Abbruch nach zu vielen Blockvorkommen; die Ausgabe ist unvollständig. */
+    bool truncated{false};
+    /** Kreise/Bögen/Ellipsen unter ungleichmäßigem Maßstab oder Drehung (nur angenähert). */
+    std::size_t approximated{0};
+};
+
+/**
+ * DXF-Leser (ASCII, R12 bis 2018): streamt die Gruppencodes direkt aus der gemappten Datei
+ * (Werte als string_view, Zahlen per std::from_chars, kein Zeilenpuffer). LINE, ARC, CIRCLE, ELLIPSE
+ * (achsparallel), POINT, TEXT, LWPOLYLINE und POLYLINE/VERTEX (Bulges werden Bögen), SPLINE
+ * (Kontroll- bzw. Fitpunkte) und INSERT; Extrusion (0,0,-1) wird gespiegelt. HEADER liefert
+ * nur $INSUNITS, TABLES/OBJECTS werden übersprungen.
+ */
+class DxfReader {
+public:
+    /** false bei unlesbarer Datei, Binär-DXF oder fehlerhaften Gruppencodes (error()). */
+    bool readFile(const std::string& path);
+    bool readText(std::string_view text);
+
+    const DxfDrawing& drawing() const { return drawing_; }
+    DxfDrawing takeDrawing() { return std::move(drawing_); }
+    const DxfReadStats& stats() const { return stats_; }
+    const std::string& error() const { return error_; }
+
+private:
+    bool parse(const char* data, std::size_t size);
+
+    DxfDrawing drawing_;
+    DxfReadStats stats_;
+    std::string error_;
+};
+
+/**
+ * Modellbereich mit aufgelösten Blockreferenzen (verschachtelt, Raster, Maßstab, Drehung, Spiegelung)
+ * in mm. Gedrehte oder gespiegelte Rechtecke werden geschlossene Polygone.
+ */
+std::vector<core::GeometryEntity> flattenDxf(const DxfDrawing& drawing, DxfFlattenStats* stats = nullptr);
+
+/** flattenDxf und ein einziges Sketch::appendGeometry; Anzahl angehängter Elemente. */
+std::size_t appendDxfToSketch(const DxfDrawing& drawing, core::Sketch& sketch, DxfFlattenStats* stats = nullptr);
+
+struct DxfWriteOptions {
+    std::size_t buffer_bytes{1u * 1024 * 1024};
+    std::string layer{"0"};
+    /** Schrifthöhe für TEXT. */
+    double text_height{2.5};
+};
+
+struct DxfWriteStats {
+    /** Geschriebene Entities (Blockinhalte einmal), Blockdefinitionen, INSERTs. */
+    std::size_t entities{0};
+    std::size_t blocks{0};
+    std::size_t inserts{0};
+    std::size_t bytes{0};
+    double write_ms{0.0};
+};
+
+/**
+ * DXF-Schreiber (AC1015, $INSUNITS aus unit_to_mm): gepufferte Ausgabe über TextSink mit std::to_chars.
+ * Blöcke werden einmal definiert, Wiederholungen sind INSERTs; Polygone und Rechtecke werden LWPOLYLINE,
+ * Splines SPLINE (geklemmter, gleichmäßiger Knotenvektor, Grad ≤ 3).
+ */
+class DxfWriter {
+public:
+    explicit DxfWriter(DxfWriteOptions options = {});
+
+    /** false bei Schreibfehler oder INSERT auf einen unbekannten Block (error()). */
+    bool writeDrawing(const std::string& path, const DxfDrawing& drawing);
+    bool writeSketch(const std::string& path, const core::Sketch& sketch);
+
+    const DxfWriteStats& stats() const { return stats_; }
+    const std::string& error() const { return error_; }
+
+private:
+    bool write(const std::string& path, const std::vector<core::GeometryEntity>& entities,
+               const DxfDrawing* drawing);
+
+    DxfWriteOptions options_;
+    DxfWriteStats stats_;
+    std::string error_;
+};
+
+}  // namespace interop
+}  // namespace cad
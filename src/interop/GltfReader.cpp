@@ -0,0 +1,946 @@
+#include "GltfReader.h"
+#include "MappedFile.h"
+#include "../core/Modeler/Transform.h"
+#include "../core/parallel/ThreadPool.h"
+#include "../core/perf/PerfSpan.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+namespace cad {
+namespace interop {
+
+namespace {
+
+/** Minimaler JSON-Baum für den glTF-Kopf (Puffer bleiben binär). */
+struct Json {
+    enum class Kind : std::uint8_t { Null, Bool, Number, String, Array, Object };
+    Kind kind{Kind::Null};
+    bool boolean{false};
+    double number{0.0};
+    std::string text;
+    std::vector<Json> items;
+    std::vector<std::pair<std::string, Json>> members;
+
+    const Json& operator[](std::string_view key) const {
+        for (const auto& member : members) {
+            if (member.first == key) {
+                return member.second;
+            }
+        }
+        return null();
+    }
+    const Json& operator[](std::size_t index) const { return index < items.size() ? items[index] : null(); }
+    bool has(std::string_view key) const { return (*this)[key].kind != Kind::Null; }
+    std::size_t size() const { return items.size(); }
+    double number_or(double fallback) const { return kind == Kind::Number ? number : fallback; }
+    /** Nicht-negativer Index bis 2^53 (exakt als double darstellbar) oder npos. */
+    std::size_t index() const {
+        constexpr double kMaxIndex = 9007199254740992.0;
+        return kind == Kind::Number && number >= 0.0 && number <= kMaxIndex ? static_cast<std::size_t>(number)
+                                                                             : std::string::npos;
+    }
+
+    static const Json& null() {
+        static const Json value;
+        return value;
+    }
+};
+
+class JsonParser {
+public:
+    JsonParser(const char* begin, const char* end) : begin_(begin), p_(begin), e_(end) {}
+
+    bool parse(Json& root) {
+        if (!value(root, 0)) {
+            return false;
+        }
+        skip();
+        return p_ == e_ || fail("trailing characters after JSON document");
+    }
+    const std::string& error() const { return error_; }
+
+private:
+    static constexpr int kMaxDepth = 256;
+
+    bool fail(const char* message) {
+        if (error_.empty()) {
+            error_ = std::string("Invalid JSON at byte ") + std::to_string(p_ - begin_) + ": " + message;
+        }
+        return false;
+    }
+    void skip() {
+        while (p_ < e_ && (*p_ == ' ' || *p_ == '\t' || *p_ == '\n' || *p_ == '\r')) ++p_;
+    }
+    bool literal(const char* word) {
+        const std::size_t length = std::strlen(word);
+        if (static_cast<std::size_t>(e_ - p_) < length || std::memcmp(p_, word, length) != 0) {
+            return fail("unknown literal");
+        }
+        p_ += length;
+        return true;
+    }
+    static void appendUtf8(std::string& out, std::uint32_t code) {
+        if (code < 0x80) {
+            out.push_back(static_cast<char>(code));
+        } else if (code < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else if (code < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+    }
+    bool hex4(std::uint32_t& code) {
+        if (e_ - p_ < 4) {
+            return fail("incomplete \\u escape");
+        }
+        const auto result = std::from_chars(p_, p_ + 4, code, 16);
+        if (result.ptr != p_ + 4) {
+            return fail("invalid \\u escape");
+        }
+        p_ += 4;
+        return true;
+    }
+    bool string(std::string& out) {
+        ++p_;  // '"'
+        out.clear();
+        while (true) {
+            const char* start = p_;
+            while (p_ < e_ && *p_ != '"' && *p_ != '\\') ++p_;
+            out.append(start, p_);
+            if (p_ >= e_) {
+                return fail("unterminated string");
+            }
+            if (*p_ == '"') {
+                ++p_;
+                return true;
+            }
+            if (++p_ >= e_) {
+                return fail("unterminated string");
+            }
+            const char escape = *p_++;
+            switch (escape) {
+                case '"': out.push_back('"'); break;
+                case '\\': out.push_back('\\'); break;
+                case '/': out.push_back('/'); break;
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'n': out.push_back('\n'); break;
+                case 'r': out.push_back('\r'); break;
+                case 't': out.push_back('\t'); break;
+                case 'u': {
+                    std::uint32_t code = 0;
+                    if (!hex4(code)) {
+                        return false;
+                    }
+                    // Ersatzpaar
+                    if (code >= 0xD800 && code < 0xDC00 && e_ - p_ >= 6 && p_[0] == '\\' && p_[1] == 'u') {
+                        p_ += 2;
+                        std::uint32_t low = 0;
+                        if (!hex4(low)) {
+                            return false;
+                        }
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(out, code);
+                    break;
+                }
+                default: return fail("invalid escape sequence");
+            }
+        }
+    }
+    bool value(Json& out, int depth) {
+        if (depth > kMaxDepth) {
+            return fail("nesting too deep");
+        }
+        skip();
+        if (p_ >= e_) {
+            return fail("unexpected end");
+        }
+        switch (*p_) {
+            case '{': {
+                out.kind = Json::Kind::Object;
+                ++p_;
+                skip();
+                if (p_ < e_ && *p_ == '}') {
+                    ++p_;
+                    return true;
+                }
+                while (true) {
+                    skip();
+                    if (p_ >= e_ || *p_ != '"') {
+                        return fail("expected key");
+                    }
+                    out.members.emplace_back();
+                    if (!string(out.members.back().first)) {
+                        return false;
+                    }
+                    skip();
+                    if (p_ >= e_ || *p_ != ':') {
+                        return fail("expected ':'");
+                    }
+                    ++p_;
+                    if (!value(out.members.back().second, depth + 1)) {
+                        return false;
+                    }
+                    skip();
+                    if (p_ < e_ && *p_ == ',') {
+                        ++p_;
+                        continue;
+                    }
+                    if (p_ < e_ && *p_ == '}') {
+                        ++p_;
+                        return true;
+                    }
+                    return fail("expected ',' or '}'");
+                }
+            }
+            case '[': {
+                out.kind = Json::Kind::Array;
+                ++p_;
+                skip();
+                if (p_ < e_ && *p_ == ']') {
+                    ++p_;
+                    return true;
+                }
+                while (true) {
+                    out.items.emplace_back();
+                    if (!value(out.items.back(), depth + 1)) {
+                        return false;
+                    }
+                    skip();
+                    if (p_ < e_ && *p_ == ',') {
+                        ++p_;
+                        continue;
+                    }
+                    if (p_ < e_ && *p_ == ']') {
+                        ++p_;
+                        return true;
+                    }
+                    return fail("expected ',' or ']'");
+                }
+            }
+            case '"':
+                out.kind = Json::Kind::String;
+                return string(out.text);
+            case 't':
+                out.kind = Json::Kind::Bool;
+                out.boolean = true;
+                return literal("true");
+            case 'f':
+                out.kind = Json::Kind::Bool;
+                return literal("false");
+            case 'n':
+                return literal("null");
+            default: {
+                out.kind = Json::Kind::Number;
+                const auto result = std::from_chars(p_, e_, out.number);
+                if (result.ec != std::errc() || result.ptr == p_) {
+                    return fail("expected number");
+                }
+                p_ = result.ptr;
+                return true;
+            }
+        }
+    }
+
+    const char* begin_;
+    const char* p_;
+    const char* e_;
+    std::string error_;
+};
+
+struct Span {
+    const char* data{nullptr};
+    std::size_t size{0};
+};
+
+bool decodeBase64(std::string_view text, std::string& out) {
+    static const auto table = [] {
+        std::array<signed char, 256> t{};
+        t.fill(-1);
+        const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (int i = 0; i < 64; ++i) {
+            t[static_cast<unsigned char>(alphabet[i])] = static_cast<signed char>(i);
+        }
+        return t;
+    }();
+    out.clear();
+    out.reserve(text.size() / 4 * 3);
+    std::uint32_t bits = 0;
+    int count = 0;
+    for (char c : text) {
+        if (c == '=') {
+            break;
+        }
+        const int v = table[static_cast<unsigned char>(c)];
+        if (v < 0) {
+            return false;
+        }
+        bits = (bits << 6) | static_cast<std::uint32_t>(v);
+        if (++count == 4) {
+            out.push_back(static_cast<char>(bits >> 16));
+            out.push_back(static_cast<char>(bits >> 8));
+            out.push_back(static_cast<char>(bits));
+            bits = 0;
+            count = 0;
+        }
+    }
+    if (count == 2) {
+        out.push_back(static_cast<char>(bits >> 4));
+    } else if (count == 3) {
+        out.push_back(static_cast<char>(bits >> 10));
+        out.push_back(static_cast<char>(bits >> 2));
+    }
+    return count != 1;
+}
+
+std::string decodeUri(const std::string& uri) {
+    std::string out;
+    for (std::size_t i = 0; i < uri.size(); ++i) {
+        unsigned value = 0;
+        if (uri[i] == '%' && i + 2 < uri.size() &&
+            std::from_chars(uri.data() + i + 1, uri.data() + i + 3, value, 16).ptr == uri.data() + i + 3) {
+            out.push_back(static_cast<char>(value));
+            i += 2;
+        } else {
+            out.push_back(uri[i]);
+        }
+    }
+    return out;
+}
+
+std::uint32_t readUint32(const char* p) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(p);
+    return static_cast<std::uint32_t>(bytes[0]) | static_cast<std::uint32_t>(bytes[1]) << 8 |
+           static_cast<std::uint32_t>(bytes[2]) << 16 | static_cast<std::uint32_t>(bytes[3]) << 24;
+}
+
+std::size_t componentSize(int type) {
+    switch (type) {
+        case 5120:
+        case 5121: return 1;
+        case 5122:
+        case 5123: return 2;
+        case 5125:
+        case 5126: return 4;
+        default: return 0;
+    }
+}
+
+/** Ein Wert nach glTF-Regeln (normalized: vorzeichenbehaftet max(c / MAX, -1), sonst c / MAX). */
+double loadComponent(const char* p, int type, bool normalized) {
+    switch (type) {
+        case 5120: {
+            std::int8_t v;
+            std::memcpy(&v, p, 1);
+            return normalized ? std::max(v / 127.0, -1.0) : v;
+        }
+        case 5121: {
+            std::uint8_t v;
+            std::memcpy(&v, p, 1);
+            return normalized ? v / 255.0 : v;
+        }
+        case 5122: {
+            std::int16_t v;
+            std::memcpy(&v, p, 2);
+            return normalized ? std::max(v / 32767.0, -1.0) : v;
+        }
+        case 5123: {
+            std::uint16_t v;
+            std::memcpy(&v, p, 2);
+            return normalized ? v / 65535.0 : v;
+        }
+        case 5125: {
+            std::uint32_t v;
+            std::memcpy(&v, p, 4);
+            return v;
+        }
+        default: {
+            float v;
+            std::memcpy(&v, p, 4);
+            return v;
+        }
+    }
+}
+
+/** Spaltenweise 4×4 wie in glTF. */
+struct Matrix {
+    double m[16]{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+
+    friend Matrix operator*(const Matrix& a, const Matrix& b) {
+        Matrix out;
+        for (int c = 0; c < 4; ++c) {
+            for (int r = 0; r < 4; ++r) {
+                double sum = 0.0;
+                for (int k = 0; k < 4; ++k) {
+                    sum += a.m[k * 4 + r] * b.m[c * 4 + k];
+                }
+                out.m[c * 4 + r] = sum;
+            }
+        }
+        return out;
+    }
+
+    /** T · R · S (q = x, y, z, w). */
+    static Matrix trs(const double t[3], const double q[4], const double s[3]) {
+        const double x = q[0], y = q[1], z = q[2], w = q[3];
+        Matrix out;
+        const double r[9] = {1 - 2 * (y * y + z * z), 2 * (x * y + w * z),     2 * (x * z - w * y),
+                             2 * (x * y - w * z),     1 - 2 * (x * x + z * z), 2 * (y * z + w * x),
+                             2 * (x * z + w * y),     2 * (y * z - w * x),     1 - 2 * (x * x + y * y)};
+        for (int c = 0; c < 3; ++c) {
+            for (int row = 0; row < 3; ++row) {
+                out.m[c * 4 + row] = r[c * 3 + row] * s[c];
+            }
+        }
+        out.m[12] = t[0];
+        out.m[13] = t[1];
+        out.m[14] = t[2];
+        return out;
+    }
+
+    /** Starre Lage + Maßstab je Achse (Spiegelung als negatives x); Scherung wird ignoriert. */
+    void decompose(core::Transform& rigid, double scale[3]) const {
+        double axes[3][3];
+        for (int c = 0; c < 3; ++c) {
+            scale[c] = std::sqrt(m[c * 4] * m[c * 4] + m[c * 4 + 1] * m[c * 4 + 1] + m[c * 4 + 2] * m[c * 4 + 2]);
+            for (int row = 0; row < 3; ++row) {
+                axes[c][row] = scale[c] > 0.0 ? m[c * 4 + row] / scale[c] : (row == c ? 1.0 : 0.0);
+            }
+        }
+        const double det = axes[0][0] * (axes[1][1] * axes[2][2] - axes[1][2] * axes[2][1]) -
+                           axes[1][0] * (axes[0][1] * axes[2][2] - axes[0][2] * axes[2][1]) +
+                           axes[2][0] * (axes[0][1] * axes[1][2] - axes[0][2] * axes[1][1]);
+        if (det < 0.0) {
+            scale[0] = -scale[0];
+            for (double& v : axes[0]) v = -v;
+        }
+        rigid = core::Transform{};
+        rigid.tx = m[12];
+        rigid.ty = m[13];
+        rigid.tz = m[14];
+        const core::Quaternion q = core::normalized(core::quaternionFromBasis(axes[0], axes[1], axes[2]));
+        if (!core::isIdentity(q)) {
+            core::setOrientation(rigid, q);
+        }
+    }
+};
+
+bool nearlyEqual(double a, double b) {
+    return std::abs(a - b) <= 1e-6 * std::max(std::abs(a), std::abs(b));
+}
+
+/** Dekodiertes glTF-Netz (alle Dreiecks-Primitive zusammengefasst). */
+struct SourceMesh {
+    core::TriangleMesh mesh;
+    std::vector<double> normals;
+    std::size_t skipped{0};
+    std::string error;
+    bool used{false};
+};
+
+/** Definition = glTF-Netz × Maßstab. */
+struct Variant {
+    std::size_t source{0};
+    double scale[3]{1.0, 1.0, 1.0};
+};
+
+/** Obergrenze für Accessoren ohne bufferView (werden mit Nullen gefüllt). */
+constexpr std::size_t kMaxZeroFilledElements = std::size_t{1} << 24;
+
+/** Zustand eines Lesevorgangs: JSON, Puffer-Sichten, Accessoren. */
+class Document {
+public:
+    Json root;
+    std::vector<Span> buffers;
+    /** Besitz für data:-Puffer und gemappte externe Dateien. */
+    std::vector<std::string> decoded;
+    std::vector<std::unique_ptr<MappedFile>> mapped;
+
+    /** count × components Werte; false bei ungültigem oder zu kurzem Accessor. */
+    bool accessor(std::size_t index, std::size_t components, std::vector<double>& out, std::string& error) const {
+        const Json& a = root["accessors"][index];
+        if (a.kind != Json::Kind::Object) {
+            error = "Accessor " + std::to_string(index) + " missing";
+            return false;
+        }
+        const std::size_t count = a["count"].index();
+        const int type = static_cast<int>(a["componentType"].number_or(0));
+        const std::size_t width = componentSize(type);
+        static const std::pair<const char*, std::size_t> kTypes[] = {
+            {"SCALAR", 1}, {"VEC2", 2}, {"VEC3", 3}, {"VEC4", 4}};
+        std::size_t declared = 0;
+        for (const auto& t : kTypes) {
+            if (a["type"].text == t.first) declared = t.second;
+        }
+        if (count == std::string::npos || width == 0 || declared != components) {
+            error = "Accessor " + std::to_string(index) + " invalid";
+            return false;
+        }
+        const std::size_t element = width * components;
+        const std::size_t view_index = a["bufferView"].index();
+        if (view_index == std::string::npos) {
+            // ohne bufferView: Nullen, aber keine beliebig großen Anforderungen aus der Datei
+            if (count > kMaxZeroFilledElements) {
+                error = "Accessor " + std::to_string(index) + " without bufferView too large";
+                return false;
+            }
+            out.assign(count * components, 0.0);
+            return true;
+        }
+        const Json& view = root["bufferViews"][view_index];
+        const std::size_t buffer = view["buffer"].index();
+        const std::size_t view_offset = view.has("byteOffset") ? view["byteOffset"].index() : 0;
+        const std::size_t view_length = view["byteLength"].index();
+        const std::size_t stride = view.has("byteStride") ? view["byteStride"].index() : element;
+        const std::size_t offset = a.has("byteOffset") ? a["byteOffset"].index() : 0;
+        // Ohne Überlauf: Sicht im Puffer, letztes Element in der Sicht
+        if (buffer >= buffers.size() || view_offset == std::string::npos || view_length == std::string::npos ||
+            stride == std::string::npos || offset == std::string::npos || stride < element ||
+            view_offset > buffers[buffer].size || view_length > buffers[buffer].size - view_offset ||
+            (count > 0 && (offset > view_length || view_length - offset < element ||
+                           count - 1 > (view_length - offset - element) / stride))) {
+            error = "Accessor " + std::to_string(index) + " out of buffer range";
+            return false;
+        }
+        out.assign(count * components, 0.0);
+        const char* base = buffers[buffer].data + view_offset + offset;
+        const bool normalized = a["normalized"].boolean;
+        if (type == 5126 && stride == element) {
+            // Dicht gepackte floats: direkt aus der Sicht
+            const std::size_t n = count * components;
+            for (std::size_t i = 0; i < n; ++i) {
+                float v;
+                std::memcpy(&v, base + i * 4, 4);
+                out[i] = v;
+            }
+            return true;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            const char* p = base + i * stride;
+            for (std::size_t c = 0; c < components; ++c) {
+                out[i * components + c] = loadComponent(p + c * width, type, normalized);
+            }
+        }
+        return true;
+    }
+
+    bool indices(std::size_t index, std::vector<std::uint32_t>& out, std::string& error) const {
+        std::vector<double> values;
+        if (!accessor(index, 1, values, error)) {
+            return false;
+        }
+        out.resize(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            out[i] = static_cast<std::uint32_t>(values[i]);
+        }
+        return true;
+    }
+
+    /** Alle Dreiecks-Primitive eines Netzes; Streifen und Fächer werden aufgelöst. */
+    void decodeMesh(std::size_t index, SourceMesh& target) const {
+        const Json& primitives = root["meshes"][index]["primitives"];
+        bool all_normals = true;
+        std::vector<double> positions;
+        std::vector<double> normals;
+        std::vector<std::uint32_t> order;
+        for (const Json& primitive : primitives.items) {
+            const int mode = static_cast<int>(primitive["mode"].number_or(4));
+            const Json& attributes = primitive["attributes"];
+            const std::size_t position = attributes["POSITION"].index();
+            if (mode < 4 || mode > 6 || position == std::string::npos ||
+                root["accessors"][position].has("sparse")) {
+                ++target.skipped;
+                continue;
+            }
+            if (!accessor(position, 3, positions, target.error)) {
+                return;
+            }
+            const std::size_t count = positions.size() / 3;
+            const std::size_t normal = attributes["NORMAL"].index();
+            if (normal == std::string::npos) {
+                all_normals = false;
+                normals.clear();
+            } else if (!accessor(normal, 3, normals, target.error)) {
+                return;
+            }
+            if (primitive.has("indices")) {
+                if (!indices(primitive["indices"].index(), order, target.error)) {
+                    return;
+                }
+            } else {
+                order.resize(count);
+                for (std::size_t i = 0; i < count; ++i) order[i] = static_cast<std::uint32_t>(i);
+            }
+            const auto base = static_cast<std::uint32_t>(target.mesh.vertices.size() / 3);
+            for (std::uint32_t i : order) {
+                if (i >= count) {
+                    target.error = "Index out of vertex range in mesh " + std::to_string(index);
+                    return;
+                }
+            }
+            target.mesh.vertices.insert(target.mesh.vertices.end(), positions.begin(), positions.end());
+            if (all_normals) {
+                target.normals.insert(target.normals.end(), normals.begin(), normals.end());
+            }
+            auto triangle = [&](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+                target.mesh.indices.push_back(base + a);
+                target.mesh.indices.push_back(base + b);
+                target.mesh.indices.push_back(base + c);
+            };
+            if (mode == 4) {
+                for (std::size_t i = 0; i + 2 < order.size(); i += 3) triangle(order[i], order[i + 1], order[i + 2]);
+            } else if (mode == 5) {
+                for (std::size_t i = 0; i + 2 < order.size(); ++i) {
+                    if (i % 2 == 0) triangle(order[i], order[i + 1], order[i + 2]);
+                    else triangle(order[i + 1], order[i], order[i + 2]);
+                }
+            } else {
+                for (std::size_t i = 1; i + 1 < order.size(); ++i) triangle(order[0], order[i], order[i + 1]);
+            }
+        }
+        if (!all_normals) {
+            target.normals.clear();
+        }
+    }
+};
+
+/** Definition mit eingerechnetem Maßstab; Spiegelungen drehen den Umlaufsinn. */
+void bake(const SourceMesh& source, const Variant& variant, GltfMesh& out) {
+    out.mesh.indices = source.mesh.indices;
+    out.mesh.vertices.resize(source.mesh.vertices.size());
+    for (std::size_t i = 0; i < source.mesh.vertices.size(); ++i) {
+        out.mesh.vertices[i] = source.mesh.vertices[i] * variant.scale[i % 3];
+    }
+    if (!source.normals.empty()) {
+        out.normals.resize(source.normals.size());
+        for (std::size_t v = 0; v + 2 < source.normals.size(); v += 3) {
+            double n[3];
+            for (int k = 0; k < 3; ++k) {
+                n[k] = variant.scale[k] != 0.0 ? source.normals[v + k] / variant.scale[k] : 0.0;
+            }
+            const double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            for (int k = 0; k < 3; ++k) {
+                out.normals[v + k] = length > 0.0 ? n[k] / length : 0.0;
+            }
+        }
+    }
+    if (variant.scale[0] * variant.scale[1] * variant.scale[2] < 0.0) {
+        for (std::size_t t = 0; t + 2 < out.mesh.indices.size(); t += 3) {
+            std::swap(out.mesh.indices[t + 1], out.mesh.indices[t + 2]);
+        }
+    }
+}
+
+}  // namespace
+
+GltfReader::GltfReader(GltfImportOptions options) : options_(options) {}
+
+bool GltfReader::readFile(const std::string& path) {
+    core::PerfTimer timer("gltf.read");
+    stats_ = GltfReadStats{};
+    error_.clear();
+    assembly_ = core::Assembly{};
+    meshes_.clear();
+    auto fail = [&](const std::string& message) {
+        error_ = message;
+        assembly_ = core::Assembly{};
+        meshes_.clear();
+        return false;
+    };
+
+    MappedFile input(path);
+    if (!input.ok()) {
+        return fail("Could not open file: " + path);
+    }
+    const char* json_begin = input.data();
+    const char* json_end = input.data() + input.size();
+    Span binary_chunk;
+    if (input.size() >= 12 && std::memcmp(input.data(), "glTF", 4) == 0) {
+        // GLB: Kopf, JSON-Chunk, optional BIN-Chunk (Sicht in die gemappte Datei)
+        const std::uint32_t version = readUint32(input.data() + 4);
+        const std::size_t length = std::min<std::size_t>(readUint32(input.data() + 8), input.size());
+        if (version != 2) {
+            return fail("Unsupported GLB version: " + std::to_string(version));
+        }
+        std::size_t offset = 12;
+        bool has_json = false;
+        while (offset + 8 <= length) {
+            const std::size_t chunk_length = readUint32(input.data() + offset);
+            const char* type = input.data() + offset + 4;
+            if (chunk_length > length - offset - 8) {
+                return fail("GLB chunk truncated");
+            }
+            const char* chunk = input.data() + offset + 8;
+            if (std::memcmp(type, "JSON", 4) == 0 && !has_json) {
+                json_begin = chunk;
+                json_end = chunk + chunk_length;
+                has_json = true;
+            } else if (std::memcmp(type, "BIN\0", 4) == 0 && !binary_chunk.data) {
+                binary_chunk = Span{chunk, chunk_length};
+            }
+            offset += 8 + ((chunk_length + 3) & ~std::size_t{3});
+        }
+        if (!has_json) {
+            return fail("GLB without JSON chunk");
+        }
+    }
+
+    Document document;
+    JsonParser parser(json_begin, json_end);
+    if (!parser.parse(document.root)) {
+        return fail(parser.error());
+    }
+    const Json& root = document.root;
+    if (root.kind != Json::Kind::Object || root["asset"]["version"].text.compare(0, 2, "2.") != 0) {
+        return fail("Not a glTF 2.0 file");
+    }
+
+    // Puffer: GLB-BIN, data:-URI oder externe Datei (gemappt)
+    const std::string directory = path.substr(0, path.find_last_of("/\\") + 1);
+    for (std::size_t b = 0; b < root["buffers"].size(); ++b) {
+        const Json& buffer = root["buffers"][b];
+        const std::size_t length = buffer["byteLength"].index();
+        Span span;
+        if (!buffer.has("uri")) {
+            span = binary_chunk;
+        } else if (buffer["uri"].text.compare(0, 5, "data:") == 0) {
+            const std::string& uri = buffer["uri"].text;
+            const std::size_t comma = uri.find(',');
+            document.decoded.emplace_back();
+            if (comma == std::string::npos || uri.rfind(";base64", comma) == std::string::npos ||
+                !decodeBase64(std::string_view(uri).substr(comma + 1), document.decoded.back())) {
+                return fail("Invalid data: URI in buffer " + std::to_string(b));
+            }
+            span = Span{document.decoded.back().data(), document.decoded.back().size()};
+        } else {
+            const std::string file = directory + decodeUri(buffer["uri"].text);
+            document.mapped.push_back(std::make_unique<MappedFile>(file, false));
+            if (!document.mapped.back()->ok()) {
+                return fail("Could not read buffer: " + file);
+            }
+            span = Span{document.mapped.back()->data(), document.mapped.back()->size()};
+        }
+        if (length == std::string::npos || span.size < length) {
+            return fail("Buffer " + std::to_string(b) + " shorter than byteLength");
+        }
+        span.size = length;
+        document.buffers.push_back(span);
+    }
+
+    // Knoten der Szene (Szene "scene", sonst 0; ohne Szenen alle Wurzelknoten)
+    const Json& nodes = root["nodes"];
+    std::vector<std::size_t> roots;
+    const Json& scenes = root["scenes"];
+    if (scenes.size() > 0) {
+        std::size_t scene = root["scene"].index();
+        if (scene == std::string::npos || scene >= scenes.size()) scene = 0;
+        for (const Json& node : scenes[scene]["nodes"].items) roots.push_back(node.index());
+    } else {
+        std::vector<bool> child(nodes.size(), false);
+        for (const Json& node : nodes.items) {
+            for (const Json& c : node["children"].items) {
+                if (c.index() < child.size()) child[c.index()] = true;
+            }
+        }
+        for (std::size_t n = 0; n < nodes.size(); ++n) {
+            if (!child[n]) roots.push_back(n);
+        }
+    }
+
+    Matrix convert;
+    if (options_.y_up) {
+        // Y oben → Z oben: +90° um x
+        const double t[3] = {0.0, 0.0, 0.0};
+        const double q[4] = {0.7071067811865476, 0.0, 0.0, 0.7071067811865476};
+        const double s[3] = {options_.unit_scale, options_.unit_scale, options_.unit_scale};
+        convert = Matrix::trs(t, q, s);
+    } else {
+        for (int k = 0; k < 3; ++k) convert.m[k * 5] = options_.unit_scale;
+    }
+
+    // Hierarchie ablaufen; Netz-Definitionen je (Netz, Maßstab) nur vormerken
+    const std::size_t mesh_count = root["meshes"].size();
+    std::vector<SourceMesh> sources(mesh_count);
+    std::vector<Variant> variants;
+    std::vector<std::vector<std::size_t>> variants_of(mesh_count);
+    auto definition = [&](std::size_t mesh, const double scale[3]) {
+        for (std::size_t v : variants_of[mesh]) {
+            if (nearlyEqual(variants[v].scale[0], scale[0]) && nearlyEqual(variants[v].scale[1], scale[1]) &&
+                nearlyEqual(variants[v].scale[2], scale[2])) {
+                return v;
+            }
+        }
+        Variant variant;
+        variant.source = mesh;
+        for (int k = 0; k < 3; ++k) {
+            variant.scale[k] = nearlyEqual(scale[k], 1.0) ? 1.0 : scale[k];
+        }
+        const std::string& name = root["meshes"][mesh]["name"].text;
+        GltfMesh out;
+        out.name = name.empty() ? "Mesh " + std::to_string(mesh) : name;
+        out.part = core::PartRef(core::Part(out.name));
+        sources[mesh].used = true;
+        variants_of[mesh].push_back(variants.size());
+        variants.push_back(variant);
+        meshes_.push_back(std::move(out));
+        return variants.size() - 1;
+    };
+
+    struct Pending {
+        std::size_t node;
+        Matrix world;
+        std::uint64_t parent;
+        core::Transform parent_rigid;
+    };
+    std::vector<Pending> stack;
+    for (auto it = roots.rbegin(); it != roots.rend(); ++it) {
+        stack.push_back(Pending{*it, convert, 0, core::Transform{}});
+    }
+    std::vector<bool> visited(nodes.size(), false);
+    while (!stack.empty()) {
+        const Pending pending = stack.back();
+        stack.pop_back();
+        if (pending.node >= nodes.size() || visited[pending.node]) {
+            continue;  // ungültig oder Zyklus
+        }
+        visited[pending.node] = true;
+        ++stats_.nodes;
+        const Json& node = nodes[pending.node];
+        Matrix local;
+        if (node.has("matrix") && node["matrix"].size() == 16) {
+            for (int k = 0; k < 16; ++k) local.m[k] = node["matrix"][k].number_or(local.m[k]);
+        } else {
+            double t[3] = {0.0, 0.0, 0.0};
+            double q[4] = {0.0, 0.0, 0.0, 1.0};
+            double s[3] = {1.0, 1.0, 1.0};
+            for (int k = 0; k < 3; ++k) t[k] = node["translation"][k].number_or(t[k]);
+            for (int k = 0; k < 4; ++k) q[k] = node["rotation"][k].number_or(q[k]);
+            for (int k = 0; k < 3; ++k) s[k] = node["scale"][k].number_or(s[k]);
+            local = Matrix::trs(t, q, s);
+        }
+        const Matrix world = pending.world * local;
+        core::Transform rigid;
+        double scale[3];
+        world.decompose(rigid, scale);
+
+        const std::size_t mesh = node["mesh"].index();
+        const bool has_mesh = mesh < mesh_count;
+        const Json& instancing = node["extensions"]["EXT_mesh_gpu_instancing"]["attributes"];
+        const bool instanced = has_mesh && instancing.kind == Json::Kind::Object;
+        const bool leaf = node["children"].size() == 0;
+        if (!has_mesh && leaf) {
+            continue;  // Kamera, Licht, leere Gruppe
+        }
+        core::PartRef part;
+        if (has_mesh && !instanced) {
+            part = meshes_[definition(mesh, scale)].part;
+            ++stats_.instances;
+        } else {
+            const std::string& name = node["name"].text;
+            part = core::PartRef(core::Part(name.empty() ? "Node " + std::to_string(pending.node) : name));
+        }
+        const std::uint64_t id =
+            assembly_.addComponent(part, core::compose(core::inverse(pending.parent_rigid), rigid), pending.parent);
+
+        if (instanced) {
+            // Instanzen als Kinder des Knotens
+            std::vector<double> translations;
+            std::vector<double> rotations;
+            std::vector<double> scales;
+            std::string error;
+            auto attribute = [&](const char* key, std::size_t components, std::vector<double>& out) {
+                return !instancing.has(key) || document.accessor(instancing[key].index(), components, out, error);
+            };
+            if (!attribute("TRANSLATION", 3, translations) || !attribute("ROTATION", 4, rotations) ||
+                !attribute("SCALE", 3, scales)) {
+                return fail(error);
+            }
+            // Alle vorhandenen Attribute müssen dieselbe Anzahl Instanzen liefern (Spezifikation)
+            const std::size_t count =
+                std::max({translations.size() / 3, rotations.size() / 4, scales.size() / 3});
+            if ((instancing.has("TRANSLATION") && translations.size() / 3 != count) ||
+                (instancing.has("ROTATION") && rotations.size() / 4 != count) ||
+                (instancing.has("SCALE") && scales.size() / 3 != count)) {
+                return fail("EXT_mesh_gpu_instancing attribute counts differ in node " +
+                            std::to_string(pending.node));
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                double t[3] = {0.0, 0.0, 0.0};
+                double q[4] = {0.0, 0.0, 0.0, 1.0};
+                double s[3] = {1.0, 1.0, 1.0};
+                if (!translations.empty()) std::copy_n(&translations[i * 3], 3, t);
+                if (!rotations.empty()) std::copy_n(&rotations[i * 4], 4, q);
+                if (!scales.empty()) std::copy_n(&scales[i * 3], 3, s);
+                core::Transform instance_rigid;
+                double instance_scale[3];
+                (world * Matrix::trs(t, q, s)).decompose(instance_rigid, instance_scale);
+                assembly_.addComponent(meshes_[definition(mesh, instance_scale)].part,
+                                       core::compose(core::inverse(rigid), instance_rigid), id);
+                ++stats_.instances;
+            }
+        }
+        const Json& children = node["children"];
+        for (std::size_t c = children.size(); c-- > 0;) {
+            stack.push_back(Pending{children[c].index(), world, id, rigid});
+        }
+    }
+
+    // Netze parallel dekodieren, dann Maßstäbe je Definition einrechnen
+    core::ThreadPool& pool = pool_ ? *pool_ : core::ThreadPool::shared();
+    pool.parallelFor(mesh_count, [&](std::size_t m) {
+        if (sources[m].used) {
+            document.decodeMesh(m, sources[m]);
+        }
+    });
+    for (std::size_t m = 0; m < mesh_count; ++m) {
+        if (!sources[m].error.empty()) {
+            return fail(sources[m].error);
+        }
+        if (sources[m].used) {
+            stats_.skipped_primitives += sources[m].skipped;
+        }
+    }
+    // Erst skalierte Varianten aus der Quelle backen; danach übernimmt die (je Quelle höchstens eine)
+    // unskalierte Variante die Quelldaten ohne Kopie
+    auto unscaled = [](const Variant& variant) {
+        return variant.scale[0] == 1.0 && variant.scale[1] == 1.0 && variant.scale[2] == 1.0;
+    };
+    pool.parallelFor(variants.size(), [&](std::size_t v) {
+        if (!unscaled(variants[v])) {
+            bake(sources[variants[v].source], variants[v], meshes_[v]);
+        }
+    });
+    for (std::size_t v = 0; v < variants.size(); ++v) {
+        if (unscaled(variants[v])) {
+            SourceMesh& source = sources[variants[v].source];
+            meshes_[v].mesh = std::move(source.mesh);
+            meshes_[v].normals = std::move(source.normals);
+        }
+    }
+    stats_.meshes = meshes_.size();
+    for (const GltfMesh& mesh : meshes_) {
+        stats_.vertices += mesh.mesh.vertices.size() / 3;
+        stats_.triangles += mesh.mesh.indices.size() / 3;
+    }
+    stats_.parse_ms = timer.finish().elapsed_ms;
+    return true;
+}
+
+}  // namespace interop
+}  // namespace cad
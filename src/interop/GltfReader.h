@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "../core/Modeler/Assembly.h"
+#include "../core/analysis/TriangleBvh.h"
+
+namespace cad {
+namespace core {
+class ThreadPool;
+}  // namespace core
+
+namespace interop {
+
+/** Netz einer Part-Definition; part ist die in der Baugruppe geteilte Definition. */
+struct GltfMesh {
+    std::string name;
+    core::PartRef part;
+    core::TriangleMesh mesh;
+    /** xyz je Eckpunkt oder leer. */
+    std::vector<double> normals;
+};
+
+struct GltfImportOptions {
+    /** glTF in m, Y oben → Modell in mm, Z oben (vor die Szenen-Wurzeln gesetzt). */
+    double unit_scale{1000.0};
+    bool y_up{true};
+};
+
+struct GltfReadStats {
+    /** Gelesene glTF-Knoten bzw. erzeugte Komponenten mit Netz (inkl. EXT_mesh_gpu_instancing). */
+    std::size_t nodes{0};
+    std::size_t instances{0};
+    /** Part-Definitionen (je glTF-Netz und Maßstab eine). */
+    std::size_t meshes{0};
+    std::size_t vertices{0};
+    std::size_t triangles{0};
+    /** Primitive ohne Dreiecke (Punkte/Linien) oder mit sparse-Accessoren. */
+    std::size_t skipped_primitives{0};
+    double parse_ms{0.0};
+};
+
+/**
+ * glTF-2.0-Leser (.gltf mit externen oder data:-Puffern, .glb). Die Datei und externe Puffer werden
+ * gemappt; Accessoren werden direkt aus den gemappten bufferViews gelesen, ohne Text zu zerlegen.
+ * Die Knotenhierarchie wird zur Baugruppe (Komponenten mit starren Lagen relativ zum Elternknoten,
+ * Instanzen aus EXT_mesh_gpu_instancing als Kinder). Jedes glTF-Netz wird eine geteilte Part-Definition;
+ * Maßstäbe der Knoten werden je Netz und Maßstab einmal in die Eckpunkte eingerechnet. Netze werden
+ * parallel dekodiert.
+ */
+class GltfReader {
+public:
+    explicit GltfReader(GltfImportOptions options = {});
+
+    /** pool == nullptr → ThreadPool::shared(). */
+    void setThreadPool(core::ThreadPool* pool) { pool_ = pool; }
+
+    /** false bei Lesefehler, ungültigem JSON/GLB oder Accessor außerhalb des Puffers (error()). */
+    bool readFile(const std::string& path);
+
+    const core::Assembly& assembly() const { return assembly_; }
+    core::Assembly takeAssembly() { return std::move(assembly_); }
+    const std::vector<GltfMesh>& meshes() const { return meshes_; }
+    std::vector<GltfMesh> takeMeshes() { return std::move(meshes_); }
+    const GltfReadStats& stats() const { return stats_; }
+    const std::string& error() const { return error_; }
+
+private:
+    GltfImportOptions options_;
+    core::ThreadPool* pool_{nullptr};
+    core::Assembly assembly_;
+    std::vector<GltfMesh> meshes_;
+    GltfReadStats stats_;
+    std::string error_;
+};
+
+}  // namespace interop
+}  // namespace cad
@@ -0,0 +1,590 @@
+#include "GltfWriter.h"
+#include "../core/Modeler/Transform.h"
+#include "../core/parallel/ThreadPool.h"
+#include "../core/perf/PerfSpan.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+
+namespace cad {
+namespace interop {
+
+namespace {
+
+constexpr int kByte = 5120;
+constexpr int kShort = 5122;
+constexpr int kUnsignedShort = 5123;
+constexpr int kUnsignedInt = 5125;
+constexpr int kFloat = 5126;
+constexpr int kArrayBuffer = 34962;
+constexpr int kElementArrayBuffer = 34963;
+
+constexpr double kQuantMax = 32767.0;
+
+/** Netz einer Part-Definition nach dem Verschweißen, in Definitionskoordinaten. */
+struct Definition {
+    const core::Part* part{nullptr};
+    core::TriangleMesh source;
+    /** Indizes in assembly.components(). */
+    std::vector<std::size_t> components;
+
+    std::vector<double> positions;
+    std::vector<double> normals;
+    std::vector<std::uint32_t> indices;
+    /** Entquantisierung p = center + scale * q (ohne Quantisierung: 0 bzw. 1). */
+    double center[3]{0.0, 0.0, 0.0};
+    double scale{1.0};
+    std::vector<std::int16_t> quantized_positions;
+    std::vector<std::int8_t> quantized_normals;
+};
+
+struct PositionKey {
+    double x;
+    double y;
+    double z;
+    bool operator==(const PositionKey& other) const { return x == other.x && y == other.y && z == other.z; }
+};
+
+struct PositionKeyHash {
+    std::size_t operator()(const PositionKey& key) const {
+        std::uint64_t bits[3];
+        std::memcpy(bits, &key, sizeof(bits));
+        std::uint64_t h = bits[0] * 0x9E3779B97F4A7C15ull;
+        h ^= bits[1] + 0x7F4A7C159E3779B9ull + (h << 6) + (h >> 2);
+        h ^= bits[2] + 0x94D049BB133111EBull + (h << 6) + (h >> 2);
+        return static_cast<std::size_t>(h);
+    }
+};
+
+/**
+ * Gleiche Lagen zusammenfassen; je Lage Normalen-Gruppen: eine Ecke schließt sich der ersten Gruppe an,
+ * deren erste Flächennormale weniger als der Knickwinkel abweicht. Entartete Dreiecke entfallen.
+ */
+void weld(Definition& definition, double cos_crease) {
+    const core::TriangleMesh& mesh = definition.source;
+    const std::size_t vertex_count = mesh.vertices.size() / 3;
+    std::unordered_map<PositionKey, std::uint32_t, PositionKeyHash> lookup;
+    lookup.reserve(vertex_count);
+    std::vector<std::uint32_t> position_of(vertex_count);
+    std::vector<std::size_t> first_vertex;
+    for (std::size_t v = 0; v < vertex_count; ++v) {
+        const PositionKey key{mesh.vertices[v * 3], mesh.vertices[v * 3 + 1], mesh.vertices[v * 3 + 2]};
+        auto inserted = lookup.emplace(key, static_cast<std::uint32_t>(first_vertex.size()));
+        if (inserted.second) {
+            first_vertex.push_back(v);
+        }
+        position_of[v] = inserted.first->second;
+    }
+
+    struct Group {
+        double face[3];
+        double sum[3];
+        std::uint32_t output;
+        std::int64_t next;
+    };
+    std::vector<Group> groups;
+    std::vector<std::int64_t> head(first_vertex.size(), -1);
+    definition.indices.clear();
+    definition.indices.reserve(mesh.indices.size());
+    for (std::size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+        const std::uint32_t corner[3] = {mesh.indices[t], mesh.indices[t + 1], mesh.indices[t + 2]};
+        if (corner[0] >= vertex_count || corner[1] >= vertex_count || corner[2] >= vertex_count) {
+            continue;
+        }
+        const double* a = &mesh.vertices[corner[0] * 3];
+        const double* b = &mesh.vertices[corner[1] * 3];
+        const double* c = &mesh.vertices[corner[2] * 3];
+        const double e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        const double e2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        // Flächengewichtete Normale
+        const double n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+        const double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (length <= 0.0 || position_of[corner[0]] == position_of[corner[1]] ||
+            position_of[corner[1]] == position_of[corner[2]] || position_of[corner[0]] == position_of[corner[2]]) {
+            continue;
+        }
+        const double unit[3] = {n[0] / length, n[1] / length, n[2] / length};
+        for (std::uint32_t vertex : corner) {
+            const std::uint32_t position = position_of[vertex];
+            std::int64_t g = head[position];
+            for (; g >= 0; g = groups[static_cast<std::size_t>(g)].next) {
+                const Group& group = groups[static_cast<std::size_t>(g)];
+                if (group.face[0] * unit[0] + group.face[1] * unit[1] + group.face[2] * unit[2] >= cos_crease) {
+                    break;
+                }
+            }
+            if (g < 0) {
+                Group group{{unit[0], unit[1], unit[2]}, {0.0, 0.0, 0.0},
+                            static_cast<std::uint32_t>(definition.positions.size() / 3), head[position]};
+                const double* p = &mesh.vertices[first_vertex[position] * 3];
+                definition.positions.insert(definition.positions.end(), p, p + 3);
+                g = static_cast<std::int64_t>(groups.size());
+                groups.push_back(group);
+                head[position] = g;
+            }
+            Group& group = groups[static_cast<std::size_t>(g)];
+            for (int k = 0; k < 3; ++k) {
+                group.sum[k] += n[k];
+            }
+            definition.indices.push_back(group.output);
+        }
+    }
+    definition.normals.resize(definition.positions.size());
+    for (const Group& group : groups) {
+        const double length =
+            std::sqrt(group.sum[0] * group.sum[0] + group.sum[1] * group.sum[1] + group.sum[2] * group.sum[2]);
+        for (int k = 0; k < 3; ++k) {
+            definition.normals[group.output * 3 + k] = length > 0.0 ? group.sum[k] / length : group.face[k];
+        }
+    }
+    definition.source = core::TriangleMesh{};
+}
+
+/** Positionen int16 um die Boxmitte mit einheitlichem Maßstab, Normalen int8 (je auf 4 Byte aufgefüllt). */
+void quantize(Definition& definition) {
+    const std::size_t count = definition.positions.size() / 3;
+    double lo[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                    std::numeric_limits<double>::max()};
+    double hi[3] = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(),
+                    std::numeric_limits<double>::lowest()};
+    for (std::size_t v = 0; v < count; ++v) {
+        for (int k = 0; k < 3; ++k) {
+            lo[k] = std::min(lo[k], definition.positions[v * 3 + k]);
+            hi[k] = std::max(hi[k], definition.positions[v * 3 + k]);
+        }
+    }
+    double half = 0.0;
+    for (int k = 0; k < 3; ++k) {
+        definition.center[k] = 0.5 * (lo[k] + hi[k]);
+        half = std::max(half, 0.5 * (hi[k] - lo[k]));
+    }
+    definition.scale = half > 0.0 ? half / kQuantMax : 1.0;
+    definition.quantized_positions.assign(count * 4, 0);
+    definition.quantized_normals.assign(count * 4, 0);
+    for (std::size_t v = 0; v < count; ++v) {
+        for (int k = 0; k < 3; ++k) {
+            const double q = std::round((definition.positions[v * 3 + k] - definition.center[k]) / definition.scale);
+            definition.quantized_positions[v * 4 + k] = static_cast<std::int16_t>(std::clamp(q, -kQuantMax, kQuantMax));
+            definition.quantized_normals[v * 4 + k] =
+                static_cast<std::int8_t>(std::clamp(std::round(definition.normals[v * 3 + k] * 127.0), -127.0, 127.0));
+        }
+    }
+}
+
+void appendNumber(std::string& out, double value) {
+    char buffer[32];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void appendInteger(std::string& out, std::uint64_t value) {
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void appendString(std::string& out, const std::string& value) {
+    out.push_back('"');
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out.push_back('\\');
+            out.push_back(c);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            static const char hex[] = "0123456789abcdef";
+            out += "\\u00";
+            out.push_back(hex[(c >> 4) & 0xF]);
+            out.push_back(hex[c & 0xF]);
+        } else {
+            out.push_back(c);
+        }
+    }
+    out.push_back('"');
+}
+
+void appendArray(std::string& out, const double* values, int count) {
+    out.push_back('[');
+    for (int i = 0; i < count; ++i) {
+        if (i > 0) out.push_back(',');
+        appendNumber(out, values[i]);
+    }
+    out.push_back(']');
+}
+
+/** Binärpuffer mit bufferViews und accessors (JSON-Text je Liste). */
+struct Document {
+    std::string bin;
+    std::string views;
+    std::string accessors;
+    std::size_t view_count{0};
+    std::size_t accessor_count{0};
+
+    std::size_t view(const void* data, std::size_t bytes, std::size_t stride, int target) {
+        bin.append((4 - bin.size() % 4) % 4, '\0');
+        if (view_count > 0) views.push_back(',');
+        views += "{\"buffer\":0,\"byteOffset\":";
+        appendInteger(views, bin.size());
+        views += ",\"byteLength\":";
+        appendInteger(views, bytes);
+        if (stride > 0) {
+            views += ",\"byteStride\":";
+            appendInteger(views, stride);
+        }
+        if (target > 0) {
+            views += ",\"target\":";
+            appendInteger(views, static_cast<std::uint64_t>(target));
+        }
+        views.push_back('}');
+        bin.append(static_cast<const char*>(data), bytes);
+        return view_count++;
+    }
+
+    std::size_t accessor(std::size_t view_index, int component_type, std::size_t count, const char* type,
+                         bool normalized, const double* min = nullptr, const double* max = nullptr, int components = 0) {
+        if (accessor_count > 0) accessors.push_back(',');
+        accessors += "{\"bufferView\":";
+        appendInteger(accessors, view_index);
+        accessors += ",\"componentType\":";
+        appendInteger(accessors, static_cast<std::uint64_t>(component_type));
+        if (normalized) {
+            accessors += ",\"normalized\":true";
+        }
+        accessors += ",\"count\":";
+        appendInteger(accessors, count);
+        accessors += ",\"type\":\"";
+        accessors += type;
+        accessors.push_back('"');
+        if (min && max) {
+            accessors += ",\"min\":";
+            appendArray(accessors, min, components);
+            accessors += ",\"max\":";
+            appendArray(accessors, max, components);
+        }
+        accessors.push_back('}');
+        return accessor_count++;
+    }
+};
+
+std::string base64(const std::string& data) {
+    static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.reserve((data.size() + 2) / 3 * 4);
+    std::size_t i = 0;
+    for (; i + 2 < data.size(); i += 3) {
+        const std::uint32_t n = (static_cast<unsigned char>(data[i]) << 16) |
+                                (static_cast<unsigned char>(data[i + 1]) << 8) | static_cast<unsigned char>(data[i + 2]);
+        out.push_back(table[(n >> 18) & 63]);
+        out.push_back(table[(n >> 12) & 63]);
+        out.push_back(table[(n >> 6) & 63]);
+        out.push_back(table[n & 63]);
+    }
+    if (i < data.size()) {
+        std::uint32_t n = static_cast<unsigned char>(data[i]) << 16;
+        if (i + 1 < data.size()) {
+            n |= static_cast<unsigned char>(data[i + 1]) << 8;
+        }
+        out.push_back(table[(n >> 18) & 63]);
+        out.push_back(table[(n >> 12) & 63]);
+        out.push_back(i + 1 < data.size() ? table[(n >> 6) & 63] : '=');
+        out.push_back('=');
+    }
+    return out;
+}
+
+void appendUint32(std::string& out, std::uint32_t value) {
+    const unsigned char bytes[4] = {static_cast<unsigned char>(value), static_cast<unsigned char>(value >> 8),
+                                    static_cast<unsigned char>(value >> 16), static_cast<unsigned char>(value >> 24)};
+    out.append(reinterpret_cast<const char*>(bytes), 4);
+}
+
+/** Lage eines Vorkommens samt Entquantisierung: T(t + R c) · R · S(scale). */
+void instanceTrs(const core::Transform& world, const Definition& definition, double translation[3], double rotation[4]) {
+    const core::Quaternion q = core::orientationOf(world);
+    double c[3] = {definition.center[0], definition.center[1], definition.center[2]};
+    core::rotateVector(q, c[0], c[1], c[2]);
+    translation[0] = world.tx + c[0];
+    translation[1] = world.ty + c[1];
+    translation[2] = world.tz + c[2];
+    rotation[0] = q.x;
+    rotation[1] = q.y;
+    rotation[2] = q.z;
+    rotation[3] = q.w;
+}
+
+}  // namespace
+
+GltfWriter::GltfWriter(GltfWriteOptions options) : options_(options) {}
+
+bool GltfWriter::writeAssembly(const std::string& path, const core::Assembly& assembly, const Tessellator& tessellator) {
+    core::PerfTimer timer("gltf.write");
+    stats_ = GltfWriteStats{};
+    error_.clear();
+    std::ofstream file(path, std::ios::binary);
+    if (path.empty() || !file.is_open()) {
+        error_ = "Could not create file: " + path;
+        return false;
+    }
+
+    // Je Definition einmal tessellieren (Reihenfolge des ersten Vorkommens)
+    std::vector<Definition> definitions;
+    std::unordered_map<const core::Part*, std::size_t> index_of;
+    const std::vector<core::AssemblyComponent>& components = assembly.components();
+    for (std::size_t c = 0; c < components.size(); ++c) {
+        const core::Part* part = &components[c].part.get();
+        auto it = index_of.find(part);
+        if (it == index_of.end()) {
+            Definition definition;
+            definition.part = part;
+            if (!tessellator || !tessellator(*part, definition.source)) {
+                definition.source = core::TriangleMesh{};
+            }
+            it = index_of.emplace(part, definitions.size()).first;
+            definitions.push_back(std::move(definition));
+        }
+        definitions[it->second].components.push_back(c);
+    }
+
+    const double cos_crease = std::cos(options_.crease_angle_deg * 3.14159265358979323846 / 180.0);
+    const bool quantized = options_.quantize;
+    core::ThreadPool& pool = pool_ ? *pool_ : core::ThreadPool::shared();
+    pool.parallelFor(definitions.size(), [&](std::size_t d) {
+        weld(definitions[d], cos_crease);
+        if (quantized && !definitions[d].indices.empty()) {
+            quantize(definitions[d]);
+        }
+    });
+
+    Document document;
+    std::string meshes;
+    std::string nodes;
+    std::vector<std::size_t> roots;
+    bool instancing_used = false;
+    auto beginNode = [&]() {
+        if (stats_.nodes > 0) nodes.push_back(',');
+        roots.push_back(stats_.nodes++);
+    };
+
+    for (Definition& definition : definitions) {
+        if (definition.indices.empty()) {
+            continue;
+        }
+        const std::size_t count = definition.positions.size() / 3;
+        std::size_t position_accessor = 0;
+        std::size_t normal_accessor = 0;
+        if (quantized) {
+            double lo[3] = {kQuantMax, kQuantMax, kQuantMax};
+            double hi[3] = {-kQuantMax, -kQuantMax, -kQuantMax};
+            for (std::size_t v = 0; v < count; ++v) {
+                for (int k = 0; k < 3; ++k) {
+                    lo[k] = std::min<double>(lo[k], definition.quantized_positions[v * 4 + k]);
+                    hi[k] = std::max<double>(hi[k], definition.quantized_positions[v * 4 + k]);
+                }
+            }
+            const std::size_t positions = document.view(definition.quantized_positions.data(), count * 8, 8, kArrayBuffer);
+            position_accessor = document.accessor(positions, kShort, count, "VEC3", false, lo, hi, 3);
+            const std::size_t normals = document.view(definition.quantized_normals.data(), count * 4, 4, kArrayBuffer);
+            normal_accessor = document.accessor(normals, kByte, count, "VEC3", true);
+        } else {
+            std::vector<float> data(definition.positions.begin(), definition.positions.end());
+            double lo[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                            std::numeric_limits<double>::max()};
+            double hi[3] = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(),
+                            std::numeric_limits<double>::lowest()};
+            for (std::size_t v = 0; v < count; ++v) {
+                for (int k = 0; k < 3; ++k) {
+                    lo[k] = std::min<double>(lo[k], data[v * 3 + k]);
+                    hi[k] = std::max<double>(hi[k], data[v * 3 + k]);
+                }
+            }
+            const std::size_t positions = document.view(data.data(), data.size() * sizeof(float), 0, kArrayBuffer);
+            position_accessor = document.accessor(positions, kFloat, count, "VEC3", false, lo, hi, 3);
+            data.assign(definition.normals.begin(), definition.normals.end());
+            const std::size_t normals = document.view(data.data(), data.size() * sizeof(float), 0, kArrayBuffer);
+            normal_accessor = document.accessor(normals, kFloat, count, "VEC3", false);
+        }
+        std::size_t index_accessor = 0;
+        if (count <= 65535) {
+            std::vector<std::uint16_t> narrow(definition.indices.begin(), definition.indices.end());
+            const std::size_t view = document.view(narrow.data(), narrow.size() * 2, 0, kElementArrayBuffer);
+            index_accessor = document.accessor(view, kUnsignedShort, narrow.size(), "SCALAR", false);
+        } else {
+            const std::size_t view =
+                document.view(definition.indices.data(), definition.indices.size() * 4, 0, kElementArrayBuffer);
+            index_accessor = document.accessor(view, kUnsignedInt, definition.indices.size(), "SCALAR", false);
+        }
+
+        const std::size_t mesh_index = stats_.meshes++;
+        if (mesh_index > 0) meshes.push_back(',');
+        meshes += "{\"name\":";
+        appendString(meshes, definition.part->name());
+        meshes += ",\"primitives\":[{\"attributes\":{\"POSITION\":";
+        appendInteger(meshes, position_accessor);
+        meshes += ",\"NORMAL\":";
+        appendInteger(meshes, normal_accessor);
+        meshes += "},\"indices\":";
+        appendInteger(meshes, index_accessor);
+        meshes += ",\"mode\":4}]}";
+        stats_.vertices += count;
+        stats_.triangles += definition.indices.size() / 3;
+        stats_.instances += definition.components.size();
+
+        const bool instanced = options_.gpu_instancing && definition.components.size() >= options_.min_instances;
+        if (instanced) {
+            // Ein Knoten, Vorkommen als TRANSLATION/ROTATION(/SCALE) je Instanz
+            const std::size_t instances = definition.components.size();
+            std::vector<float> translations(instances * 3);
+            std::vector<float> rotations(instances * 4);
+            for (std::size_t i = 0; i < instances; ++i) {
+                double t[3];
+                double r[4];
+                instanceTrs(assembly.worldTransform(components[definition.components[i]].id), definition, t, r);
+                std::copy(t, t + 3, &translations[i * 3]);
+                std::copy(r, r + 4, &rotations[i * 4]);
+            }
+            const std::size_t t_view = document.view(translations.data(), translations.size() * 4, 0, 0);
+            const std::size_t t_accessor = document.accessor(t_view, kFloat, instances, "VEC3", false);
+            const std::size_t r_view = document.view(rotations.data(), rotations.size() * 4, 0, 0);
+            const std::size_t r_accessor = document.accessor(r_view, kFloat, instances, "VEC4", false);
+            beginNode();
+            nodes += "{\"name\":";
+            appendString(nodes, definition.part->name());
+            nodes += ",\"mesh\":";
+            appendInteger(nodes, mesh_index);
+            nodes += ",\"extensions\":{\"EXT_mesh_gpu_instancing\":{\"attributes\":{\"TRANSLATION\":";
+            appendInteger(nodes, t_accessor);
+            nodes += ",\"ROTATION\":";
+            appendInteger(nodes, r_accessor);
+            if (quantized) {
+                const std::vector<float> scales(instances * 3, static_cast<float>(definition.scale));
+                const std::size_t s_view = document.view(scales.data(), scales.size() * 4, 0, 0);
+                nodes += ",\"SCALE\":";
+                appendInteger(nodes, document.accessor(s_view, kFloat, instances, "VEC3", false));
+            }
+            nodes += "}}}}";
+            instancing_used = true;
+            continue;
+        }
+        for (std::size_t c : definition.components) {
+            double t[3];
+            double r[4];
+            instanceTrs(assembly.worldTransform(components[c].id), definition, t, r);
+            beginNode();
+            nodes += "{\"name\":";
+            appendString(nodes, definition.part->name() + "_" + std::to_string(components[c].id));
+            nodes += ",\"mesh\":";
+            appendInteger(nodes, mesh_index);
+            nodes += ",\"translation\":";
+            appendArray(nodes, t, 3);
+            if (r[0] != 0.0 || r[1] != 0.0 || r[2] != 0.0) {
+                nodes += ",\"rotation\":";
+                appendArray(nodes, r, 4);
+            }
+            if (quantized) {
+                const double s[3] = {definition.scale, definition.scale, definition.scale};
+                nodes += ",\"scale\":";
+                appendArray(nodes, s, 3);
+            }
+            nodes.push_back('}');
+        }
+    }
+
+    // Wurzel: Einheiten und Achsen
+    const std::size_t root = stats_.nodes++;
+    if (root > 0) nodes.push_back(',');
+    nodes += "{\"name\":\"Hydra CAD\"";
+    if (!roots.empty()) {
+        nodes += ",\"children\":[";
+        for (std::size_t i = 0; i < roots.size(); ++i) {
+            if (i > 0) nodes.push_back(',');
+            appendInteger(nodes, roots[i]);
+        }
+        nodes.push_back(']');
+    }
+    if (options_.z_up) {
+        const double half_sqrt2 = 0.7071067811865476;
+        const double rotation[4] = {-half_sqrt2, 0.0, 0.0, half_sqrt2};
+        nodes += ",\"rotation\":";
+        appendArray(nodes, rotation, 4);
+    }
+    if (options_.unit_scale != 1.0) {
+        const double s[3] = {options_.unit_scale, options_.unit_scale, options_.unit_scale};
+        nodes += ",\"scale\":";
+        appendArray(nodes, s, 3);
+    }
+    nodes.push_back('}');
+
+    std::string json = "{\"asset\":{\"version\":\"2.0\",\"generator\":\"Hydra CAD\"}";
+    std::string used;
+    if (quantized && stats_.meshes > 0) used += "\"KHR_mesh_quantization\"";
+    if (instancing_used) {
+        if (!used.empty()) used.push_back(',');
+        used += "\"EXT_mesh_gpu_instancing\"";
+    }
+    if (!used.empty()) {
+        // Ohne die Erweiterungen wäre die Datei falsch dargestellt → auch "required"
+        json += ",\"extensionsUsed\":[" + used + "],\"extensionsRequired\":[" + used + "]";
+    }
+    json += ",\"scene\":0,\"scenes\":[{\"nodes\":[";
+    appendInteger(json, root);
+    json += "]}],\"nodes\":[" + nodes + "]";
+    if (stats_.meshes > 0) {
+        json += ",\"meshes\":[" + meshes + "],\"accessors\":[" + document.accessors + "],\"bufferViews\":[" +
+                document.views + "]";
+    }
+    document.bin.append((4 - document.bin.size() % 4) % 4, '\0');
+    if (!document.bin.empty()) {
+        json += ",\"buffers\":[{\"byteLength\":";
+        appendInteger(json, document.bin.size());
+        if (!options_.binary) {
+            json += ",\"uri\":\"data:application/octet-stream;base64," + base64(document.bin) + "\"";
+        }
+        json += "}]";
+    }
+    json += "}";
+
+    if (options_.binary) {
+        // GLB: Kopf, JSON-Chunk (mit Leerzeichen aufgefüllt), BIN-Chunk
+        json.append((4 - json.size() % 4) % 4, ' ');
+        const std::size_t total = 12 + 8 + json.size() + (document.bin.empty() ? 0 : 8 + document.bin.size());
+        // Längenfelder im GLB sind 32 Bit; größere Dateien wären stillschweigend abgeschnitten
+        constexpr std::size_t kMaxGlb = std::numeric_limits<std::uint32_t>::max();
+        if (total > kMaxGlb) {
+            error_ = "GLB exceeds 4 GiB limit (" + std::to_string(total) + " bytes): " + path;
+            return false;
+        }
+        std::string head;
+        head += "glTF";
+        appendUint32(head, 2);
+        appendUint32(head, static_cast<std::uint32_t>(total));
+        appendUint32(head, static_cast<std::uint32_t>(json.size()));
+        head += "JSON";
+        file.write(head.data(), static_cast<std::streamsize>(head.size()));
+        file.write(json.data(), static_cast<std::streamsize>(json.size()));
+        if (!document.bin.empty()) {
+            std::string chunk;
+            appendUint32(chunk, static_cast<std::uint32_t>(document.bin.size()));
+            chunk += std::string("BIN\0", 4);
+            file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            file.write(document.bin.data(), static_cast<std::streamsize>(document.bin.size()));
+        }
+        stats_.bytes = total;
+    } else {
+        file.write(json.data(), static_cast<std::streamsize>(json.size()));
+        stats_.bytes = json.size();
+    }
+    file.close();
+    stats_.write_ms = timer.finish().elapsed_ms;
+    if (!file) {
+        error_ = "Write failed: " + path;
+        return false;
+    }
+    return true;
+}
+
+}  // namespace interop
+}  // namespace cad
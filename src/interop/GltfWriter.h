@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include "../core/Modeler/Assembly.h"
+#include "../core/analysis/TriangleBvh.h"
+
+namespace cad {
+namespace core {
+class ThreadPool;
+}  // namespace core
+
+namespace interop {
+
+struct GltfWriteOptions {
+    /** GLB (ein Binär-Chunk) oder .gltf mit eingebettetem base64-Puffer. */
+    bool binary{true};
+    /** KHR_mesh_quantization: Positionen int16, Normalen int8 (normiert, Entquantisierung über die Lage). */
+    bool quantize{false};
+    /** EXT_mesh_gpu_instancing für Definitionen mit mindestens min_instances Vorkommen. */
+    bool gpu_instancing{true};
+    std::size_t min_instances{2};
+    /** Eckpunkte gleicher Lage teilen sich die Normale, solange die Flächen weniger abknicken. */
+    double crease_angle_deg{30.0};
+    /** Modell in mm, Z oben → glTF in m, Y oben (Wurzelknoten). */
+    double unit_scale{0.001};
+    bool z_up{true};
+};
+
+struct GltfWriteStats {
+    /** Geschriebene Netze (je Part-Definition eines) und Knoten. */
+    std::size_t meshes{0};
+    std::size_t nodes{0};
+    /** Vorkommen über EXT_mesh_gpu_instancing bzw. als eigener Knoten. */
+    std::size_t instances{0};
+    std::size_t vertices{0};
+    std::size_t triangles{0};
+    std::size_t bytes{0};
+    double write_ms{0.0};
+};
+
+/**
+ * glTF-2.0-Schreiber für Baugruppen: jede Part-Definition wird einmal tesselliert, verschweißt (gleiche
+ * Lage, Normalen nach Knickwinkel) und als ein Netz in einen gemeinsamen Binärpuffer geschrieben.
+ * Mehrfach verwendete Definitionen werden über EXT_mesh_gpu_instancing als ein Knoten mit
+ * Vorkommen-Lagen ausgegeben, übrige als eigener Knoten. Verschweißen und Quantisieren laufen je
+ * Definition parallel; der Tessellierer wird nacheinander aufgerufen.
+ */
+class GltfWriter {
+public:
+    using Tessellator = std::function<bool(const core::Part& part, core::TriangleMesh& mesh)>;
+
+    explicit GltfWriter(GltfWriteOptions options = {});
+
+    /** pool == nullptr → ThreadPool::shared(). */
+    void setThreadPool(core::ThreadPool* pool) { pool_ = pool; }
+
+    /** Teile ohne Netz werden übersprungen; false bei Schreibfehler (error()). */
+    bool writeAssembly(const std::string& path, const core::Assembly& assembly, const Tessellator& tessellator);
+
+    const GltfWriteStats& stats() const { return stats_; }
+    const std::string& error() const { return error_; }
+
+private:
+    GltfWriteOptions options_;
+    core::ThreadPool* pool_{nullptr};
+    GltfWriteStats stats_;
+    std::string error_;
+};
+
+}  // namespace interop
+}  // namespace cad
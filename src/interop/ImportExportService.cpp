@@ -1,7 +1,10 @@
 #include "ImportExportService.h"
+#include "StepAssemblyWriter.h"
 #include "StepFileParser.h"
+#include "../core/perf/PerfSpan.h"
 #include "../core/Modeler/Part.h"
 #include "../core/Modeler/Transform.h"
+#include <atomic>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
@@ -9,8 +12,12 @@
 #include <cmath>
 #include <cstring>
 #include <ctime>
+#include <filesystem>
+#include <functional>
 #include <map>
-#include <regex>
+#include <mutex>
+#include <set>
+#include <thread>
 #include <tuple>
 
 #ifndef M_PI
@@ -22,6 +29,10 @@ namespace {
         double normal[3];
         double vertices[3][3];
     };
+
+    bool isStepBrep(const cad::interop::StepEntity& entity) {
+        return entity.type == "MANIFOLD_SOLID_BREP" || entity.type == "BREP_WITH_VOIDS";
+    }
 }
 
 namespace cad {
@@ -182,7 +193,7 @@ IoResult ImportExportService::importStep(const std::string& path) const {
     if (file_size > 0 && is_step_file) {
         StepFileParser parser;
         if (parser.parseFile(path)) {
-            std::vector<StepEntity> entities = parser.getEntities();
+            const std::vector<StepEntity>& entities = parser.getEntities();
             
             int geometry_count = 0;
             int assembly_count = 0;
@@ -205,7 +216,7 @@ IoResult ImportExportService::importStep(const std::string& path) const {
                            std::to_string(assembly_count) + " assemblies";
         } else {
             result.success = false;
-            result.message = "Failed to parse STEP file";
+            result.message = "Failed to parse STEP file: " + parser.error();
         }
     } else if (file_size == 0) {
         result.success = false;
@@ -362,42 +373,45 @@ IoResult ImportExportService::importDxf(const std::string& path) const {
         return result;
     }
     
-    std::ifstream file(path);
-    if (!file.is_open()) {
+    DxfReader reader;
+    if (!reader.readFile(path)) {
         result.success = false;
-        result.message = "Could not open file: " + path;
+        result.message = "Invalid DXF file format: " + reader.error();
         return result;
     }
     
-    std::string line;
-    bool has_section = false;
-    bool has_entities = false;
-    int entity_count = 0;
+    const DxfReadStats& stats = reader.stats();
+    result.success = true;
+    result.message = "DXF file imported successfully: " + std::to_string(stats.entities) + " entities, " +
+                     std::to_string(stats.blocks) + " blocks, " + std::to_string(stats.inserts) + " inserts";
+    return result;
+}
+
+IoResult ImportExportService::importDxfToSketch(const std::string& path, cad::core::Sketch& sketch,
+                                                DxfDrawing* drawing) const {
+    IoResult result;
     
-    while (std::getline(file, line)) {
-        if (line.find("SECTION") != std::string::npos) {
-            has_section = true;
-        }
-        if (line.find("ENTITIES") != std::string::npos) {
-            has_entities = true;
-        }
-        if (has_entities && (line.find("LINE") != std::string::npos || 
-                           line.find("CIRCLE") != std::string::npos ||
-                           line.find("ARC") != std::string::npos ||
-                           line.find("POLYLINE") != std::string::npos)) {
-            entity_count++;
-        }
+    if (path.empty()) {
+        result.success = false;
+        result.message = "No file path specified";
+        return result;
     }
     
-    file.close();
-    
-    if (has_section && has_entities) {
-        result.success = true;
-        result.message = "DXF file imported successfully: " + std::to_string(entity_count) + " entities";
-    } else {
+    DxfReader reader;
+    if (!reader.readFile(path)) {
         result.success = false;
-        result.message = "Invalid DXF file format";
+        result.message = "Invalid DXF file format: " + reader.error();
+        return result;
+    }
+    
+    DxfFlattenStats flatten;
+    const std::size_t added = appendDxfToSketch(reader.drawing(), sketch, &flatten);
+    if (drawing) {
+        *drawing = reader.takeDrawing();
     }
+    result.success = true;
+    result.message = "DXF file imported: " + std::to_string(added) + " sketch entities, " +
+                     std::to_string(flatten.instances) + " block instances";
     return result;
 }
 
@@ -742,6 +756,11 @@ IoResult ImportExportService::exportDwg(const std::string& path) const {
 }
 
 IoResult ImportExportService::exportDxf(const std::string& path) const {
+    return exportDrawingToDxf(path, DxfDrawing{});
+}
+
+IoResult ImportExportService::exportSketchToDxf(const std::string& path, const cad::core::Sketch& sketch,
+                                                const DxfWriteOptions& options) const {
     IoResult result;
     
     if (path.empty()) {
@@ -750,24 +769,20 @@ IoResult ImportExportService::exportDxf(const std::string& path) const {
         return result;
     }
     
-    std::ofstream file(path);
-    if (!file.is_open()) {
+    DxfWriter writer(options);
+    if (!writer.writeSketch(path, sketch)) {
         result.success = false;
-        result.message = "Could not create file: " + path;
+        result.message = writer.error();
         return result;
     }
     
-    file << "0\nSECTION\n2\nHEADER\n9\n$ACADVER\n1\nAC1015\n0\nENDSEC\n";
-    file << "0\nSECTION\n2\nENTITIES\n";
-    file << "0\nENDSEC\n0\nEOF\n";
-    
-    file.close();
     result.success = true;
-    result.message = "DXF file exported successfully";
+    result.message = "DXF file exported successfully: " + std::to_string(writer.stats().entities) + " entities";
     return result;
 }
 
-IoResult ImportExportService::importObj(const std::string& path) const {
+IoResult ImportExportService::exportDrawingToDxf(const std::string& path, const DxfDrawing& drawing,
+                                                 const DxfWriteOptions& options) const {
     IoResult result;
     
     if (path.empty()) {
@@ -776,36 +791,54 @@ IoResult ImportExportService::importObj(const std::string& path) const {
         return result;
     }
     
-    std::ifstream file(path);
-    if (!file.is_open()) {
+    DxfWriter writer(options);
+    if (!writer.writeDrawing(path, drawing)) {
         result.success = false;
-        result.message = "Could not open file: " + path;
+        result.message = writer.error();
         return result;
     }
     
-    std::string line;
-    int vertex_count = 0;
-    int face_count = 0;
+    const DxfWriteStats& stats = writer.stats();
+    result.success = true;
+    result.message = "DXF file exported successfully: " + std::to_string(stats.entities) + " entities, " +
+                     std::to_string(stats.blocks) + " blocks, " + std::to_string(stats.inserts) + " inserts";
+    return result;
+}
+
+IoResult ImportExportService::importObj(const std::string& path) const {
+    std::vector<ObjBody> bodies;
+    return importObjBodies(path, bodies);
+}
+
+IoResult ImportExportService::importObjBodies(const std::string& path, std::vector<ObjBody>& bodies) const {
+    IoResult result;
     
-    while (std::getline(file, line)) {
-        if (line.empty() || line[0] == '#') {
-            continue;
-        }
-        
-        if (line[0] == 'v' && line[1] == ' ') {
-            vertex_count++;
-        } else if (line[0] == 'f' && line[1] == ' ') {
-            face_count++;
-        }
+    if (path.empty()) {
+        result.success = false;
+        result.message = "No file path specified";
+        return result;
     }
     
-    file.close();
+    ObjReader reader;
+    if (!reader.readFile(path)) {
+        result.success = false;
+        result.message = "Could not import OBJ file: " + reader.error();
+        return result;
+    }
+    
+    const ObjStats& stats = reader.stats();
+    bodies = reader.takeBodies();
     result.success = true;
-    result.message = "OBJ file imported: " + std::to_string(vertex_count) + " vertices, " + std::to_string(face_count) + " faces";
+    result.message = "OBJ file imported: " + std::to_string(stats.positions) + " vertices, " +
+                     std::to_string(stats.faces) + " faces, " + std::to_string(bodies.size()) + " bodies";
     return result;
 }
 
 IoResult ImportExportService::exportObj(const std::string& path) const {
+    return exportObj(path, {});
+}
+
+IoResult ImportExportService::exportObj(const std::string& path, const std::vector<ObjBody>& bodies) const {
     IoResult result;
     
     if (path.empty()) {
@@ -814,27 +847,20 @@ IoResult ImportExportService::exportObj(const std::string& path) const {
         return result;
     }
     
-    std::ofstream file(path);
-    if (!file.is_open()) {
+    ObjWriter writer;
+    if (!writer.writeBodies(path, bodies)) {
         result.success = false;
-        result.message = "Could not create file: " + path;
+        result.message = writer.error();
         return result;
     }
     
-    file << "# OBJ file exported from Hydra CAD\n";
-    file << "v 0.0 0.0 0.0\n";
-    file << "v 1.0 0.0 0.0\n";
-    file << "v 1.0 1.0 0.0\n";
-    file << "v 0.0 1.0 0.0\n";
-    file << "f 1 2 3 4\n";
-    
-    file.close();
     result.success = true;
-    result.message = "OBJ file exported successfully";
+    result.message = "OBJ file exported successfully: " + std::to_string(writer.stats().bodies) + " bodies";
     return result;
 }
 
-IoResult ImportExportService::importPly(const std::string& path) const {
+IoResult ImportExportService::exportAssemblyToObj(const std::string& path, const cad::core::Assembly& assembly,
+                                                  const ObjWriter::Tessellator& tessellator) const {
     IoResult result;
     
     if (path.empty()) {
@@ -843,41 +869,56 @@ IoResult ImportExportService::importPly(const std::string& path) const {
         return result;
     }
     
-    std::ifstream file(path, std::ios::binary);
-    if (!file.is_open()) {
+    ObjWriter writer;
+    if (!writer.writeAssembly(path, assembly, tessellator)) {
         result.success = false;
-        result.message = "Could not open file: " + path;
+        result.message = writer.error();
         return result;
     }
     
-    std::string line;
-    bool in_header = true;
-    int vertex_count = 0;
-    int face_count = 0;
+    result.success = true;
+    result.message = "OBJ file exported successfully: " + std::to_string(writer.stats().bodies) + " bodies, " +
+                     std::to_string(writer.stats().triangles) + " triangles";
+    return result;
+}
+
+IoResult ImportExportService::importPly(const std::string& path) const {
+    PlyData data;
+    return importPlyData(path, data);
+}
+
+IoResult ImportExportService::importPlyData(const std::string& path, PlyData& data) const {
+    IoResult result;
     
-    while (std::getline(file, line)) {
-        if (in_header) {
-            if (line.find("element vertex") != std::string::npos) {
-                std::istringstream iss(line);
-                std::string token;
-                iss >> token >> token >> vertex_count;
-            } else if (line.find("element face") != std::string::npos) {
-                std::istringstream iss(line);
-                std::string token;
-                iss >> token >> token >> face_count;
-            } else if (line == "end_header") {
-                in_header = false;
-            }
-        }
+    if (path.empty()) {
+        result.success = false;
+        result.message = "No file path specified";
+        return result;
     }
     
-    file.close();
+    PlyReader reader;
+    if (!reader.readFile(path, data)) {
+        result.success = false;
+        result.message = "Could not import PLY file: " + reader.error();
+        return result;
+    }
+    
+    const PlyStats& stats = reader.stats();
     result.success = true;
-    result.message = "PLY file imported: " + std::to_string(vertex_count) + " vertices, " + std::to_string(face_count) + " faces";
+    result.message = "PLY file imported: " + std::to_string(stats.vertices) + " vertices, " +
+                     std::to_string(stats.faces) + " faces";
+    if (data.isPointCloud()) {
+        result.message += " (point cloud)";
+    }
     return result;
 }
 
 IoResult ImportExportService::exportPly(const std::string& path) const {
+    return exportPly(path, PlyData{});
+}
+
+IoResult ImportExportService::exportPly(const std::string& path, const PlyData& data,
+                                        const PlyWriteOptions& options) const {
     IoResult result;
     
     if (path.empty()) {
@@ -886,35 +927,25 @@ IoResult ImportExportService::exportPly(const std::string& path) const {
         return result;
     }
     
-    std::ofstream file(path);
-    if (!file.is_open()) {
+    std::string error;
+    if (!writePly(path, data, options, &error)) {
         result.success = false;
-        result.message = "Could not create file: " + path;
+        result.message = error;
         return result;
     }
     
-    file << "ply\n";
-    file << "format ascii 1.0\n";
-    file << "element vertex 4\n";
-    file << "property float x\n";
-    file << "property float y\n";
-    file << "property float z\n";
-    file << "element face 1\n";
-    file << "property list uchar int vertex_indices\n";
-    file << "end_header\n";
-    file << "0.0 0.0 0.0\n";
-    file << "1.0 0.0 0.0\n";
-    file << "1.0 1.0 0.0\n";
-    file << "0.0 1.0 0.0\n";
-    file << "3 0 1 2\n";
-    
-    file.close();
     result.success = true;
-    result.message = "PLY file exported successfully";
+    result.message = "PLY file exported successfully: " + std::to_string(data.pointCount()) + " vertices";
     return result;
 }
 
 IoResult ImportExportService::import3mf(const std::string& path) const {
+    cad::core::Assembly assembly;
+    return import3mfToAssembly(path, assembly);
+}
+
+IoResult ImportExportService::import3mfToAssembly(const std::string& path, cad::core::Assembly& assembly,
+                                                  std::vector<ThreeMfMesh>* meshes) const {
     IoResult result;
     
     if (path.empty()) {
@@ -923,25 +954,31 @@ IoResult ImportExportService::import3mf(const std::string& path) const {
         return result;
     }
     
-    std::ifstream file(path, std::ios::binary);
-    if (!file.is_open()) {
+    ThreeMfReader reader;
+    if (!reader.readFile(path)) {
         result.success = false;
-        result.message = "Could not open file: " + path;
+        result.message = "Could not import 3MF file: " + reader.error();
         return result;
     }
     
-    char header[8];
-    file.read(header, 8);
-    file.close();
-    
-    bool is_zip = (header[0] == 'P' && header[1] == 'K');
-    
+    const ThreeMfReadStats& stats = reader.stats();
+    assembly = reader.takeAssembly();
+    if (meshes) {
+        *meshes = reader.takeMeshes();
+    }
     result.success = true;
-    result.message = "3MF file imported (ZIP-based: " + std::string(is_zip ? "yes" : "no") + ")";
+    result.message = "3MF file imported: " + std::to_string(stats.meshes) + " meshes, " +
+                     std::to_string(stats.instances) + " instances";
     return result;
 }
 
 IoResult ImportExportService::export3mf(const std::string& path) const {
+    return exportAssemblyTo3mf(path, cad::core::Assembly{}, nullptr);
+}
+
+IoResult ImportExportService::exportAssemblyTo3mf(const std::string& path, const cad::core::Assembly& assembly,
+                                                  const ThreeMfWriter::Tessellator& tessellator,
+                                                  const ThreeMfWriteOptions& options) const {
     IoResult result;
     
     if (path.empty()) {
@@ -950,22 +987,27 @@ IoResult ImportExportService::export3mf(const std::string& path) const {
         return result;
     }
     
-    std::ofstream file(path, std::ios::binary);
-    if (!file.is_open()) {
+    ThreeMfWriter writer(options);
+    if (!writer.writeAssembly(path, assembly, tessellator)) {
         result.success = false;
-        result.message = "Could not create file: " + path;
+        result.message = writer.error();
         return result;
     }
     
-    file << "PK\x03\x04";
-    file.close();
-    
+    const ThreeMfWriteStats& stats = writer.stats();
     result.success = true;
-    result.message = "3MF file exported successfully";
+    result.message = "3MF file exported successfully: " + std::to_string(stats.mesh_objects) + " meshes, " +
+                     std::to_string(stats.build_items) + " build items";
     return result;
 }
 
 IoResult ImportExportService::importGltf(const std::string& path) const {
+    cad::core::Assembly assembly;
+    return importGltfToAssembly(path, assembly);
+}
+
+IoResult ImportExportService::importGltfToAssembly(const std::string& path, cad::core::Assembly& assembly,
+                                                   std::vector<GltfMesh>* meshes) const {
     IoResult result;
     
     if (path.empty()) {
@@ -974,33 +1016,33 @@ IoResult ImportExportService::importGltf(const std::string& path) const {
         return result;
     }
     
-    std::ifstream file(path);
-    if (!file.is_open()) {
+    GltfReader reader;
+    if (!reader.readFile(path)) {
         result.success = false;
-        result.message = "Could not open file: " + path;
+        result.message = "Could not import GLTF file: " + reader.error();
         return result;
     }
     
-    std::string line;
-    bool has_gltf = false;
-    bool has_scenes = false;
-    
-    while (std::getline(file, line)) {
-        if (line.find("\"glTF\"") != std::string::npos) {
-            has_gltf = true;
-        }
-        if (line.find("\"scenes\"") != std::string::npos) {
-            has_scenes = true;
-        }
+    const GltfReadStats& stats = reader.stats();
+    assembly = reader.takeAssembly();
+    if (meshes) {
+        *meshes = reader.takeMeshes();
     }
-    
-    file.close();
-    result.success = has_gltf;
-    result.message = has_gltf ? "GLTF file imported successfully" : "Invalid GLTF file format";
+    result.success = true;
+    result.message = "GLTF file imported: " + std::to_string(stats.meshes) + " meshes, " +
+                     std::to_string(stats.instances) + " instances";
     return result;
 }
 
 IoResult ImportExportService::exportGltf(const std::string& path, bool binary) const {
+    GltfWriteOptions options;
+    options.binary = binary;
+    return exportAssemblyToGltf(path, cad::core::Assembly{}, nullptr, options);
+}
+
+IoResult ImportExportService::exportAssemblyToGltf(const std::string& path, const cad::core::Assembly& assembly,
+                                                   const GltfWriter::Tessellator& tessellator,
+                                                   const GltfWriteOptions& options) const {
     IoResult result;
     
     if (path.empty()) {
@@ -1009,88 +1051,222 @@ IoResult ImportExportService::exportGltf(const std::string& path, bool binary) c
         return result;
     }
     
-    if (binary) {
-        std::ofstream file(path, std::ios::binary);
-        if (!file.is_open()) {
-            result.success = false;
-            result.message = "Could not create file: " + path;
-            return result;
-        }
-        
-        file << "glTF";
-        file.close();
-    } else {
-        std::ofstream file(path);
-        if (!file.is_open()) {
-            result.success = false;
-            result.message = "Could not create file: " + path;
-            return result;
-        }
-        
-        file << "{\n";
-        file << "  \"asset\": {\n";
-        file << "    \"version\": \"2.0\",\n";
-        file << "    \"generator\": \"Hydra CAD\"\n";
-        file << "  },\n";
-        file << "  \"scenes\": [{\n";
-        file << "    \"nodes\": [0]\n";
-        file << "  }],\n";
-        file << "  \"nodes\": [{\n";
-        file << "    \"mesh\": 0\n";
-        file << "  }],\n";
-        file << "  \"meshes\": [{\n";
-        file << "    \"primitives\": [{\n";
-        file << "      \"attributes\": {\n";
-        file << "        \"POSITION\": 0\n";
-        file << "      }\n";
-        file << "    }]\n";
-        file << "  }]\n";
-        file << "}\n";
-        
-        file.close();
+    GltfWriter writer(options);
+    if (!writer.writeAssembly(path, assembly, tessellator)) {
+        result.success = false;
+        result.message = writer.error();
+        return result;
     }
     
+    const GltfWriteStats& stats = writer.stats();
     result.success = true;
-    result.message = "GLTF file exported successfully (" + std::string(binary ? "binary" : "JSON") + ")";
+    result.message = "GLTF file exported successfully (" + std::string(options.binary ? "binary" : "JSON") + "): " +
+                     std::to_string(stats.meshes) + " meshes, " + std::to_string(stats.instances) + " instances";
     return result;
 }
 
-IoResult ImportExportService::importMultiple(const std::vector<ImportRequest>& requests) const {
+IoResult ImportExportService::importFile(const std::string& path, FileFormat format) const {
+    switch (format) {
+        case FileFormat::Step: return importStep(path);
+        case FileFormat::Iges: return importIges(path);
+        case FileFormat::Stl: return importStl(path);
+        case FileFormat::Dwg: return importDwg(path);
+        case FileFormat::Dxf: return importDxf(path);
+        case FileFormat::Sat: return importSat(path);
+        case FileFormat::Parasolid: return importParasolid(path);
+        case FileFormat::Jt: return importJt(path);
+        case FileFormat::Fbx: return importFbx(path);
+        case FileFormat::Obj: return importObj(path);
+        case FileFormat::Ply: return importPly(path);
+        case FileFormat::ThreeMf: return import3mf(path);
+        case FileFormat::Gltf:
+        case FileFormat::Glb: return importGltf(path);
+        case FileFormat::SldPrt: return importSldPrt(path);
+        case FileFormat::SldAsm: return importSldAsm(path);
+        case FileFormat::CreoPrt: return importCreoPrt(path);
+        case FileFormat::CreoAsm: return importCreoAsm(path);
+        case FileFormat::CatPart: return importCatPart(path);
+        case FileFormat::CatProduct: return importCatProduct(path);
+        default: break;
+    }
     IoResult result;
-    result.success = true;
-    int success_count = 0;
-    
-    for (const auto& request : requests) {
-        IoResult single_result = importModel(request);
-        if (single_result.success) {
-            success_count++;
+    result.success = false;
+    result.message = "Import not supported for " + formatLabel(format);
+    return result;
+}
+
+IoResult ImportExportService::exportFile(const std::string& path, FileFormat format) const {
+    switch (format) {
+        case FileFormat::Step: return exportStep(path, true);
+        case FileFormat::Iges: return exportIges(path);
+        case FileFormat::Stl: return exportStl(path, false);
+        case FileFormat::Dwg: return exportDwg(path);
+        case FileFormat::Dxf: return exportDxf(path);
+        case FileFormat::Rfa: return exportBimRfa(path);
+        case FileFormat::Obj: return exportObj(path);
+        case FileFormat::Ply: return exportPly(path);
+        case FileFormat::ThreeMf: return export3mf(path);
+        case FileFormat::Gltf: return exportGltf(path, false);
+        case FileFormat::Glb: return exportGltf(path, true);
+        default: break;
+    }
+    IoResult result;
+    result.success = false;
+    result.message = "Export without model not supported for " + formatLabel(format);
+    return result;
+}
+
+bool ImportExportService::isCpuBoundFormat(FileFormat format) const {
+    switch (format) {
+        case FileFormat::Step:
+        case FileFormat::Iges:
+        case FileFormat::Obj:
+        case FileFormat::Ply:
+        case FileFormat::ThreeMf:
+        case FileFormat::Gltf:
+        case FileFormat::Glb:
+            return true;
+        default:
+            return false;
+    }
+}
+
+namespace {
+
+/**
+ * Gemeinsamer Batch-Ablauf: je Spur (0 = I/O, 1 = CPU) höchstens limit Dateien gleichzeitig; jede
+ * Spur holt sich die nächste Datei ihrer Klasse, bis keine mehr übrig ist.
+ */
+BatchResult runBatch(std::vector<BatchFileResult> files, const BatchOptions& options, bool largest_first,
+                     const std::function<IoResult(const std::string&, FileFormat)>& run) {
+    cad::core::PerfTimer timer("io.batch");
+    std::vector<std::size_t> queue[2];
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        queue[files[i].cpu_bound ? 1 : 0].push_back(i);
+    }
+    if (largest_first) {
+        // Lange Dateien zuerst, sonst bestimmt die letzte große Datei die Laufzeit
+        std::vector<std::uintmax_t> size(files.size(), 0);
+        for (std::size_t i : queue[1]) {
+            std::error_code ec;
+            const std::uintmax_t bytes = std::filesystem::file_size(files[i].path, ec);
+            size[i] = ec ? 0 : bytes;
+        }
+        std::stable_sort(queue[1].begin(), queue[1].end(),
+                         [&size](std::size_t a, std::size_t b) { return size[a] > size[b]; });
+    }
+    const std::size_t hardware = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    const std::size_t limit[2] = {options.io_concurrency ? options.io_concurrency : hardware,
+                                  options.cpu_concurrency ? options.cpu_concurrency : hardware};
+    std::vector<int> lanes;
+    for (int c = 0; c < 2; ++c) {
+        lanes.insert(lanes.end(), std::min(limit[c], queue[c].size()), c);
+    }
+
+    std::atomic<std::size_t> next[2];
+    next[0].store(0);
+    next[1].store(0);
+    std::mutex progress_mutex;
+    std::size_t done = 0;
+    auto lane = [&](std::size_t l) {
+        const int c = lanes[l];
+        for (std::size_t k = next[c].fetch_add(1); k < queue[c].size(); k = next[c].fetch_add(1)) {
+            BatchFileResult& file = files[queue[c][k]];
+            if (options.cancel.cancelled()) {
+                file.cancelled = true;
+                file.result.message = "Cancelled";
+            } else {
+                cad::core::PerfTimer file_timer("io.batch.file");
+                file.result = run(file.path, file.format);
+                file.elapsed_ms = file_timer.finish().elapsed_ms;
+            }
+            std::lock_guard<std::mutex> lock(progress_mutex);
+            ++done;
+            if (options.on_progress) {
+                options.on_progress(file, done, files.size());
+            }
+        }
+    };
+    if (options.pool) {
+        options.pool->parallelFor(lanes.size(), lane);
+    } else if (!lanes.empty()) {
+        // Der aufrufende Thread arbeitet mit
+        cad::core::ThreadPool pool(std::max<std::size_t>(1, lanes.size() - 1));
+        pool.parallelFor(lanes.size(), lane);
+    }
+
+    BatchResult batch;
+    for (const BatchFileResult& file : files) {
+        if (file.cancelled) {
+            ++batch.cancelled;
+        } else if (file.result.success) {
+            ++batch.succeeded;
         } else {
-            result.message += "Failed: " + request.path + "; ";
+            ++batch.failed;
         }
     }
-    
-    result.message = "Imported " + std::to_string(success_count) + " of " + std::to_string(requests.size()) + " files";
-    return result;
+    batch.files = std::move(files);
+    batch.elapsed_ms = timer.finish().elapsed_ms;
+    return batch;
 }
 
-IoResult ImportExportService::exportMultiple(const std::vector<ExportRequest>& requests) const {
+/** "Imported 3 of 4 files; failed: a.step" (höchstens zehn Pfade). */
+IoResult summarizeBatch(const BatchResult& batch, const std::string& verb) {
     IoResult result;
-    result.success = true;
-    int success_count = 0;
-    
-    for (const auto& request : requests) {
-        IoResult single_result = exportModel(request);
-        if (single_result.success) {
-            success_count++;
-        } else {
-            result.message += "Failed: " + request.path + "; ";
+    result.success = batch.failed == 0 && batch.cancelled == 0;
+    result.message = verb + " " + std::to_string(batch.succeeded) + " of " + std::to_string(batch.files.size()) +
+                     " files";
+    std::size_t listed = 0;
+    for (const BatchFileResult& file : batch.files) {
+        if (file.cancelled || file.result.success) {
+            continue;
         }
+        if (listed == 10) {
+            result.message += ", ...";
+            break;
+        }
+        result.message += (listed++ == 0 ? "; failed: " : ", ") + file.path;
+    }
+    if (batch.cancelled > 0) {
+        result.message += "; " + std::to_string(batch.cancelled) + " cancelled";
     }
-    
-    result.message = "Exported " + std::to_string(success_count) + " of " + std::to_string(requests.size()) + " files";
     return result;
 }
 
+}  // namespace
+
+IoResult ImportExportService::importMultiple(const std::vector<ImportRequest>& requests) const {
+    return summarizeBatch(importBatch(requests), "Imported");
+}
+
+IoResult ImportExportService::exportMultiple(const std::vector<ExportRequest>& requests) const {
+    return summarizeBatch(exportBatch(requests), "Exported");
+}
+
+BatchResult ImportExportService::importBatch(const std::vector<ImportRequest>& requests,
+                                             const BatchOptions& options) const {
+    std::vector<BatchFileResult> files(requests.size());
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        files[i].path = requests[i].path;
+        files[i].format = requests[i].format;
+        files[i].cpu_bound = isCpuBoundFormat(requests[i].format);
+    }
+    return runBatch(std::move(files), options, true,
+                    [this](const std::string& path, FileFormat format) { return importFile(path, format); });
+}
+
+BatchResult ImportExportService::exportBatch(const std::vector<ExportRequest>& requests,
+                                             const BatchOptions& options) const {
+    std::vector<BatchFileResult> files(requests.size());
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        files[i].path = requests[i].path;
+        files[i].format = requests[i].format;
+        files[i].cpu_bound = isCpuBoundFormat(requests[i].format);
+    }
+    return runBatch(std::move(files), options, false,
+                    [this](const std::string& path, FileFormat format) { return exportFile(path, format); });
+}
+
 bool ImportExportService::validateFileFormat(const std::string& path, FileFormat expected_format) const {
     FileFormat detected = detectFileFormat(path);
     if (detected == expected_format) {
@@ -1146,7 +1322,248 @@ FileFormat ImportExportService::detectFileFormat(const std::string& path) const
     return FileFormat::Step;
 }
 
-cad::core::Assembly ImportExportService::importStepToAssembly(const std::string& path) const {
+namespace {
+
+/** AXIS2_PLACEMENT_3D als Lage (axis/ref optional). */
+bool readStepPlacement(const StepFileParser& parser, std::uint32_t id, cad::core::Transform& transform) {
+    auto triple = [&](std::string_view parameter, const char* type, double xyz[3]) {
+        std::uint32_t ref = 0;
+        const StepEntity* entity = StepFileParser::asReference(parameter, ref) ? parser.find(ref) : nullptr;
+        if (!entity || entity->type != type) {
+            return false;
+        }
+        const std::vector<std::string_view> values = StepFileParser::splitList(entity->parameter(1));
+        for (std::size_t i = 0; i < values.size() && i < 3; ++i) {
+            StepFileParser::asReal(values[i], xyz[i]);
+        }
+        return true;
+    };
+    const StepEntity* entity = parser.find(id);
+    if (!entity || entity->type != "AXIS2_PLACEMENT_3D") {
+        return false;
+    }
+    double p[3] = {0.0, 0.0, 0.0};
+    double z[3] = {0.0, 0.0, 1.0};
+    double x[3] = {1.0, 0.0, 0.0};
+    if (!triple(entity->parameter(1), "CARTESIAN_POINT", p)) {
+        return false;
+    }
+    triple(entity->parameter(2), "DIRECTION", z);
+    triple(entity->parameter(3), "DIRECTION", x);
+    // Orthonormale Basis (x, y = z × x, z) → Quaternion
+    const double zl = std::sqrt(z[0] * z[0] + z[1] * z[1] + z[2] * z[2]);
+    if (zl < 1e-12) {
+        return false;
+    }
+    for (double& c : z) c /= zl;
+    const double d = x[0] * z[0] + x[1] * z[1] + x[2] * z[2];
+    for (int i = 0; i < 3; ++i) x[i] -= d * z[i];
+    const double xl = std::sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
+    if (xl < 1e-12) {
+        return false;
+    }
+    for (double& c : x) c /= xl;
+    const double y[3] = {z[1] * x[2] - z[2] * x[1], z[2] * x[0] - z[0] * x[2], z[0] * x[1] - z[1] * x[0]};
+    const cad::core::Quaternion q = cad::core::quaternionFromBasis(x, y, z);
+    transform = cad::core::Transform{};
+    transform.tx = p[0];
+    transform.ty = p[1];
+    transform.tz = p[2];
+    if (!cad::core::isIdentity(q)) {
+        cad::core::setOrientation(transform, q);
+    }
+    return true;
+}
+
+/**
+ * Produktstruktur (NEXT_ASSEMBLY_USAGE_OCCURRENCE, Lage über CONTEXT_DEPENDENT_SHAPE_REPRESENTATION →
+ * ITEM_DEFINED_TRANSFORMATION). Je PRODUCT_DEFINITION eine geteilte Part-Definition; false ohne NAUO.
+ * solid_parts (optional): B-rep-Id → Part-Definition, deren Darstellung den Körper enthält.
+ */
+bool readStepProductStructure(const StepFileParser& parser, cad::core::Assembly& assembly,
+                              std::map<std::uint32_t, cad::core::PartRef>* solid_parts) {
+    struct Occurrence {
+        std::uint32_t id{0};
+        std::uint32_t parent{0};
+        std::uint32_t child{0};
+        cad::core::Transform transform;
+    };
+    std::vector<Occurrence> occurrences;
+    std::map<std::uint32_t, std::size_t> occurrence_of;
+    std::map<std::uint32_t, std::uint32_t> shape_of;
+    for (const StepEntity& entity : parser.getEntities()) {
+        if (entity.type == "NEXT_ASSEMBLY_USAGE_OCCURRENCE") {
+            Occurrence occurrence;
+            occurrence.id = entity.id;
+            if (StepFileParser::asReference(entity.parameter(3), occurrence.parent) &&
+                StepFileParser::asReference(entity.parameter(4), occurrence.child)) {
+                occurrence_of[entity.id] = occurrences.size();
+                occurrences.push_back(occurrence);
+            }
+        } else if (entity.type == "PRODUCT_DEFINITION_SHAPE") {
+            std::uint32_t definition = 0;
+            if (StepFileParser::asReference(entity.parameter(2), definition)) {
+                shape_of[entity.id] = definition;
+            }
+        }
+    }
+    if (occurrences.empty()) {
+        return false;
+    }
+    
+    // Lagen: CDSR(relationship, shape) → Beziehung mit ITEM_DEFINED_TRANSFORMATION(…, item_1, item_2)
+    for (const StepEntity& entity : parser.getEntities()) {
+        if (entity.type != "CONTEXT_DEPENDENT_SHAPE_REPRESENTATION") {
+            continue;
+        }
+        std::uint32_t relationship_id = 0;
+        std::uint32_t shape_id = 0;
+        if (!StepFileParser::asReference(entity.parameter(0), relationship_id) ||
+            !StepFileParser::asReference(entity.parameter(1), shape_id)) {
+            continue;
+        }
+        auto shape = shape_of.find(shape_id);
+        auto occurrence = shape != shape_of.end() ? occurrence_of.find(shape->second) : occurrence_of.end();
+        const StepEntity* relationship = parser.find(relationship_id);
+        if (occurrence == occurrence_of.end() || !relationship) {
+            continue;
+        }
+        std::uint32_t transformation_id = 0;
+        if (relationship->isComplex()) {
+            std::string_view type;
+            std::vector<std::string_view> parameters;
+            for (std::uint32_t i = 0; i < relationship->parameter_count; ++i) {
+                if (StepFileParser::splitRecord(relationship->parameters[i], type, parameters) &&
+                    type == "REPRESENTATION_RELATIONSHIP_WITH_TRANSFORMATION" && !parameters.empty()) {
+                    StepFileParser::asReference(parameters[0], transformation_id);
+                }
+            }
+        } else if (relationship->type == "REPRESENTATION_RELATIONSHIP_WITH_TRANSFORMATION") {
+            StepFileParser::asReference(relationship->parameter(4), transformation_id);
+        }
+        const StepEntity* transformation = parser.find(transformation_id);
+        std::uint32_t from_id = 0;
+        std::uint32_t to_id = 0;
+        cad::core::Transform from;
+        cad::core::Transform to;
+        if (transformation && transformation->type == "ITEM_DEFINED_TRANSFORMATION" &&
+            StepFileParser::asReference(transformation->parameter(2), from_id) &&
+            StepFileParser::asReference(transformation->parameter(3), to_id) &&
+            readStepPlacement(parser, from_id, from) && readStepPlacement(parser, to_id, to)) {
+            occurrences[occurrence->second].transform = cad::core::compose(to, cad::core::inverse(from));
+        }
+    }
+    
+    // PRODUCT_DEFINITION → FORMATION → PRODUCT: Name
+    std::map<std::uint32_t, cad::core::PartRef> definitions;
+    auto definition = [&](std::uint32_t id) -> const cad::core::PartRef& {
+        auto it = definitions.find(id);
+        if (it != definitions.end()) {
+            return it->second;
+        }
+        std::string name;
+        std::uint32_t formation_id = 0;
+        std::uint32_t product_id = 0;
+        const StepEntity* entity = parser.find(id);
+        const StepEntity* formation = entity && StepFileParser::asReference(entity->parameter(2), formation_id)
+                                          ? parser.find(formation_id) : nullptr;
+        const StepEntity* product = formation && StepFileParser::asReference(formation->parameter(2), product_id)
+                                        ? parser.find(product_id) : nullptr;
+        if (product && product->type == "PRODUCT" &&
+            (!StepFileParser::asString(product->parameter(1), name) || name.empty())) {
+            StepFileParser::asString(product->parameter(0), name);
+        }
+        if (name.empty()) {
+            name = "Part_" + std::to_string(id);
+        }
+        return definitions.emplace(id, cad::core::PartRef(cad::core::Part(name))).first->second;
+    };
+    
+    // Wurzeln: Definitionen, die nie als Kind vorkommen; Unterbaugruppen je Vorkommen aufklappen
+    std::map<std::uint32_t, std::vector<std::size_t>> children;
+    std::set<std::uint32_t> used_as_child;
+    for (std::size_t i = 0; i < occurrences.size(); ++i) {
+        children[occurrences[i].parent].push_back(i);
+        used_as_child.insert(occurrences[i].child);
+    }
+    std::vector<std::uint32_t> path;
+    std::function<void(std::uint32_t, std::uint64_t)> expand = [&](std::uint32_t parent, std::uint64_t parent_component) {
+        auto it = children.find(parent);
+        if (it == children.end() || path.size() > 64 ||
+            std::find(path.begin(), path.end(), parent) != path.end()) {
+            return;
+        }
+        path.push_back(parent);
+        for (std::size_t index : it->second) {
+            const Occurrence& occurrence = occurrences[index];
+            const std::uint64_t component =
+                assembly.addComponent(definition(occurrence.child), occurrence.transform, parent_component);
+            expand(occurrence.child, component);
+        }
+        path.pop_back();
+    };
+    for (const auto& entry : children) {
+        if (used_as_child.count(entry.first) == 0) {
+            expand(entry.first, 0);
+        }
+    }
+    
+    // Körper je Definition: PDS → SHAPE_DEFINITION_REPRESENTATION → Darstellung, weiter über
+    // SHAPE_REPRESENTATION_RELATIONSHIP (ohne Lage) bis zur Darstellung, die die B-reps aufzählt
+    if (solid_parts) {
+        std::map<std::uint32_t, std::uint32_t> definition_of_representation;
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> links;
+        for (const StepEntity& entity : parser.getEntities()) {
+            std::uint32_t first = 0;
+            std::uint32_t second = 0;
+            if (entity.type == "SHAPE_DEFINITION_REPRESENTATION" &&
+                StepFileParser::asReference(entity.parameter(0), first) &&
+                StepFileParser::asReference(entity.parameter(1), second)) {
+                auto shape = shape_of.find(first);
+                if (shape != shape_of.end() && definitions.count(shape->second)) {
+                    definition_of_representation.emplace(second, shape->second);
+                }
+            } else if (entity.type == "SHAPE_REPRESENTATION_RELATIONSHIP" &&
+                       StepFileParser::asReference(entity.parameter(2), first) &&
+                       StepFileParser::asReference(entity.parameter(3), second)) {
+                links.emplace_back(first, second);
+            }
+        }
+        for (bool changed = !links.empty(); changed;) {
+            changed = false;
+            for (const auto& link : links) {
+                auto a = definition_of_representation.find(link.first);
+                auto b = definition_of_representation.find(link.second);
+                if (a != definition_of_representation.end() && b == definition_of_representation.end()) {
+                    definition_of_representation.emplace(link.second, a->second);
+                    changed = true;
+                } else if (a == definition_of_representation.end() && b != definition_of_representation.end()) {
+                    definition_of_representation.emplace(link.first, b->second);
+                    changed = true;
+                }
+            }
+        }
+        for (const auto& entry : definition_of_representation) {
+            const StepEntity* representation = parser.find(entry.first);
+            if (!representation) {
+                continue;
+            }
+            for (std::string_view item : StepFileParser::splitList(representation->parameter(1))) {
+                std::uint32_t item_id = 0;
+                const StepEntity* brep = StepFileParser::asReference(item, item_id) ? parser.find(item_id) : nullptr;
+                if (brep && isStepBrep(*brep)) {
+                    solid_parts->emplace(item_id, definitions.at(entry.second));
+                }
+            }
+        }
+    }
+    return !assembly.components().empty();
+}
+
+}  // namespace
+
+cad::core::Assembly ImportExportService::importStepToAssembly(
+    const std::string& path, std::map<std::uint32_t, cad::core::PartRef>* solid_parts) const {
     cad::core::Assembly assembly;
     
     if (path.empty()) {
@@ -1154,56 +1571,52 @@ cad::core::Assembly ImportExportService::importStepToAssembly(const std::string&
     }
     
     StepFileParser parser;
-    if (!parser.parseFile(path)) {
+    if (!parser.parseFile(path) && parser.size() == 0) {
+        return assembly;
+    }
+    
+    if (readStepProductStructure(parser, assembly, solid_parts)) {
         return assembly;
     }
     
-    std::vector<StepEntity> entities = parser.getEntities();
+    const std::vector<StepEntity>& entities = parser.getEntities();
     std::map<int, cad::core::Part> part_map;
     std::map<int, cad::core::Transform> transform_map;
     std::map<int, std::vector<int>> assembly_relations;
     
+    // Mit B-rep-Körpern je Körper ein Teil, sonst je Instanz mit SHAPE/SOLID im Namen
+    const bool has_breps = std::any_of(entities.begin(), entities.end(), [](const StepEntity& entity) {
+        return isStepBrep(entity);
+    });
+    
     for (const auto& entity : entities) {
-        if (entity.type.find("SHAPE") != std::string::npos || 
-            entity.type.find("SOLID") != std::string::npos ||
-            entity.type.find("MANIFOLD") != std::string::npos) {
+        const bool is_part = has_breps ? isStepBrep(entity)
+                                       : (entity.type.find("SHAPE") != std::string::npos ||
+                                          entity.type.find("SOLID") != std::string::npos ||
+                                          entity.type.find("MANIFOLD") != std::string::npos);
+        if (is_part) {
             
-            std::string part_name = "Part_" + std::to_string(entity.id);
-            auto param_it = entity.parameters.find("name");
-            if (param_it != entity.parameters.end()) {
-                part_name = param_it->second;
+            std::string part_name;
+            if (!StepFileParser::asString(entity.parameter(0), part_name) || part_name.empty()) {
+                part_name = "Part_" + std::to_string(entity.id);
             }
             
-            part_map.emplace(entity.id, cad::core::Part(part_name));
+            part_map.emplace(static_cast<int>(entity.id), cad::core::Part(part_name));
         }
         
         if (entity.type.find("CARTESIAN_POINT") != std::string::npos) {
-            double x = 0.0, y = 0.0, z = 0.0;
-            auto param_it = entity.parameters.find("coordinates");
-            if (param_it != entity.parameters.end()) {
-                std::string coords = param_it->second;
-                std::regex coord_regex(R"([-+]?[0-9]*\.?[0-9]+)");
-                std::sregex_iterator iter(coords.begin(), coords.end(), coord_regex);
-                std::sregex_iterator end;
-                
-                if (iter != end) {
-                    x = std::stod(iter->str());
-                    ++iter;
-                    if (iter != end) {
-                        y = std::stod(iter->str());
-                        ++iter;
-                        if (iter != end) {
-                            z = std::stod(iter->str());
-                        }
-                    }
-                }
+            // CARTESIAN_POINT('name', (x, y, z))
+            double coords[3] = {0.0, 0.0, 0.0};
+            const std::vector<std::string_view> values = StepFileParser::splitList(entity.parameter(1));
+            for (std::size_t i = 0; i < values.size() && i < 3; ++i) {
+                StepFileParser::asReal(values[i], coords[i]);
             }
             
             cad::core::Transform transform;
-            transform.tx = x;
-            transform.ty = y;
-            transform.tz = z;
-            transform_map[entity.id] = transform;
+            transform.tx = coords[0];
+            transform.ty = coords[1];
+            transform.tz = coords[2];
+            transform_map[static_cast<int>(entity.id)] = transform;
         }
         
         if (entity.type.find("AXIS2_PLACEMENT_3D") != std::string::npos ||
@@ -1215,25 +1628,21 @@ cad::core::Assembly ImportExportService::importStepToAssembly(const std::string&
             transform.rx = 0.0;
             transform.ry = 0.0;
             transform.rz = 0.0;
-            transform_map[entity.id] = transform;
+            transform_map[static_cast<int>(entity.id)] = transform;
         }
         
         if (entity.type.find("ASSEMBLY") != std::string::npos ||
             entity.type.find("PRODUCT") != std::string::npos ||
             entity.type.find("NEXT_ASSEMBLY_USAGE_OCCURRENCE") != std::string::npos) {
             std::vector<int> related_ids;
-            for (const auto& param : entity.parameters) {
-                if (param.first.find("id") != std::string::npos || 
-                    param.first.find("ref") != std::string::npos) {
-                    try {
-                        int ref_id = std::stoi(param.second);
-                        related_ids.push_back(ref_id);
-                    } catch (...) {
-                    }
+            for (std::uint32_t i = 0; i < entity.parameter_count; ++i) {
+                std::uint32_t ref_id = 0;
+                if (StepFileParser::asReference(entity.parameters[i], ref_id)) {
+                    related_ids.push_back(static_cast<int>(ref_id));
                 }
             }
             if (!related_ids.empty()) {
-                assembly_relations[entity.id] = related_ids;
+                assembly_relations[static_cast<int>(entity.id)] = related_ids;
             }
         }
     }
@@ -1276,92 +1685,52 @@ cad::core::Assembly ImportExportService::importStepToAssembly(const std::string&
             }
             
             assembly.addComponent(part_entry.second, transform);
+            if (solid_parts && has_breps) {
+                solid_parts->emplace(static_cast<std::uint32_t>(part_entry.first), assembly.components().back().part);
+            }
         }
     }
     
     return assembly;
 }
 
-IoResult ImportExportService::exportAssemblyToStep(const std::string& path, const cad::core::Assembly& assembly, bool ascii_mode) const {
-    IoResult result;
-    
+#ifdef CAD_USE_EIGENER_KERN
+std::vector<StepSolid> ImportExportService::importStepSolids(const std::string& path, StepBrepStats* stats) const {
+    std::vector<StepSolid> solids;
     if (path.empty()) {
-        result.success = false;
-        result.message = "No file path specified";
-        return result;
+        return solids;
     }
     
-    std::ofstream file(path);
-    if (!file.is_open()) {
-        result.success = false;
-        result.message = "Could not create file: " + path;
-        return result;
+    cad::core::PerfTimer parse_timer("step.parse");
+    StepFileParser parser;
+    if (!parser.parseFile(path) && parser.size() == 0) {
+        return solids;
     }
+    const double parse_ms = parse_timer.finish().elapsed_ms;
     
-    file << "ISO-10303-21;\n";
-    file << "HEADER;\n";
-    file << "FILE_DESCRIPTION(('Hydra CAD Export'), '2;1');\n";
-    std::time_t now = std::time(nullptr);
-    char time_str[64];
-    std::strftime(time_str, sizeof(time_str), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
-    
-    std::string filename = path;
-    size_t last_slash = path.find_last_of("/\\");
-    if (last_slash != std::string::npos) {
-        filename = path.substr(last_slash + 1);
+    StepBrepTranslator translator(parser);
+    solids = translator.translate();
+    if (stats) {
+        *stats = translator.stats();
+        stats->parse_ms = parse_ms;
     }
+    return solids;
+}
+#endif
+
+IoResult ImportExportService::exportAssemblyToStep(const std::string& path, const cad::core::Assembly& assembly, bool ascii_mode) const {
+    IoResult result;
     
-    file << "FILE_NAME('" << filename << "', '" << time_str << "', ('Hydra CAD'), ('Hydra CAD'), 'Hydra CAD Export', 'Hydra CAD', '');\n";
-    file << "FILE_SCHEMA(('AUTOMOTIVE_DESIGN'));\n";
-    file << "ENDSEC;\n";
-    file << "DATA;\n";
-    
-    int entity_id = 1;
-    std::map<std::uint64_t, int> component_id_map;
-    
-    const auto& components = assembly.components();
-    for (const auto& component : components) {
-        component_id_map[component.id] = entity_id;
-        
-        file << "#" << entity_id << " = CARTESIAN_POINT('', (" 
-             << component.transform.tx << ", " 
-             << component.transform.ty << ", " 
-             << component.transform.tz << "));\n";
-        entity_id++;
-        
-        file << "#" << entity_id << " = DIRECTION('', (" << 1.0 << ", " << 0.0 << ", " << 0.0 << "));\n";
-        entity_id++;
-        file << "#" << entity_id << " = DIRECTION('', (" << 0.0 << ", " << 1.0 << ", " << 0.0 << "));\n";
-        entity_id++;
-        file << "#" << entity_id << " = AXIS2_PLACEMENT_3D('', #" << (entity_id - 3) << ", #" << (entity_id - 2) << ", #" << (entity_id - 1) << ");\n";
-        entity_id++;
-        
-        std::string part_name = component.part.name();
-        std::replace(part_name.begin(), part_name.end(), ' ', '_');
-        file << "#" << entity_id << " = MANIFOLD_SOLID_BREP('" << part_name << "', #" << (entity_id - 1) << ");\n";
-        entity_id++;
-    }
-    
-    if (!components.empty()) {
-        file << "#" << entity_id << " = PRODUCT('Assembly', 'Assembly', '', (#";
-        bool first = true;
-        for (const auto& component : components) {
-            auto it = component_id_map.find(component.id);
-            if (it != component_id_map.end()) {
-                if (!first) file << ", ";
-                file << "#" << (it->second + 4);
-                first = false;
-            }
-        }
-        file << "));\n";
+    StepAssemblyWriter writer;
+    if (!writer.write(path, assembly)) {
+        result.success = false;
+        result.message = writer.error();
+        return result;
     }
     
-    file << "ENDSEC;\n";
-    file << "END-ISO-10303-21;\n";
-    
-    file.close();
     result.success = true;
-    result.message = "STEP file exported successfully: " + std::to_string(components.size()) + " components";
+    result.message = "STEP file exported successfully: " + std::to_string(writer.stats().instances) + " components, " +
+                     std::to_string(writer.stats().definitions) + " definitions";
     if (ascii_mode) {
         result.message += " (ASCII mode)";
     }
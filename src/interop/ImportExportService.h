@@ -1,8 +1,22 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <string>
 #include <vector>
 #include "../core/Modeler/Assembly.h"
+#include "../core/parallel/ThreadPool.h"
+#include "DxfFile.h"
+#include "GltfReader.h"
+#include "GltfWriter.h"
+#include "ObjFile.h"
+#include "PlyFile.h"
+#include "ThreeMfFile.h"
+#ifdef CAD_USE_EIGENER_KERN
+#include "StepBrepTranslator.h"
+#endif
 
 namespace cad {
 namespace interop {
@@ -53,6 +67,40 @@ struct IoResult {
     std::string message;
 };
 
+/** Ergebnis einer Datei im Batch (Index wie im Auftrag). */
+struct BatchFileResult {
+    std::string path;
+    FileFormat format{FileFormat::Step};
+    IoResult result;
+    double elapsed_ms{0.0};
+    /** Lief in der CPU-Spur (siehe isCpuBoundFormat). */
+    bool cpu_bound{false};
+    /** Vor dem Start abgebrochen (nicht bearbeitet). */
+    bool cancelled{false};
+};
+
+struct BatchOptions {
+    /** Gleichzeitige Dateien je Spur: I/O-lastige Formate (Stubs, STL, DXF, ...) bzw. CPU-lastige
+     *  (STEP, IGES, OBJ, PLY, 3MF, glTF); 0 → std::thread::hardware_concurrency(). */
+    std::size_t io_concurrency{16};
+    std::size_t cpu_concurrency{0};
+    /** Kooperativ: laufende Dateien werden fertig, ausstehende nicht mehr gestartet. */
+    cad::core::CancellationToken cancel;
+    /** Nach jeder Datei (aus einem Worker, nacheinander): done von total erledigt. */
+    std::function<void(const BatchFileResult& file, std::size_t done, std::size_t total)> on_progress;
+    /** nullptr → eigener Pool mit so vielen Threads wie Spuren. */
+    cad::core::ThreadPool* pool{nullptr};
+};
+
+struct BatchResult {
+    /** In Auftragsreihenfolge. */
+    std::vector<BatchFileResult> files;
+    std::size_t succeeded{0};
+    std::size_t failed{0};
+    std::size_t cancelled{0};
+    double elapsed_ms{0.0};
+};
+
 class ImportExportService {
 public:
     IoResult importModel(const ImportRequest& request) const;
@@ -69,30 +117,81 @@ public:
     IoResult importStl(const std::string& path) const;
     IoResult importDwg(const std::string& path) const;
     IoResult importDxf(const std::string& path) const;
+    /** Modellbereich mit aufgelösten Blockreferenzen in einem Schritt in die Skizze (Blöcke optional in drawing). */
+    IoResult importDxfToSketch(const std::string& path, cad::core::Sketch& sketch,
+                               DxfDrawing* drawing = nullptr) const;
     IoResult exportStep(const std::string& path, bool ascii_mode) const;
     IoResult exportIges(const std::string& path) const;
     IoResult exportStl(const std::string& path, bool ascii_mode) const;
     IoResult exportDwg(const std::string& path) const;
     IoResult exportDxf(const std::string& path) const;
+    IoResult exportSketchToDxf(const std::string& path, const cad::core::Sketch& sketch,
+                               const DxfWriteOptions& options = {}) const;
+    /** Blöcke einmal, Wiederholungen (z.B. Teile einer Schachtelung) als INSERT. */
+    IoResult exportDrawingToDxf(const std::string& path, const DxfDrawing& drawing,
+                                const DxfWriteOptions& options = {}) const;
     IoResult importObj(const std::string& path) const;
+    /** Gruppen/Objekte als eigene Körper (Fächer-Triangulierung, Normalen und UVs je Eckpunkt). */
+    IoResult importObjBodies(const std::string& path, std::vector<ObjBody>& bodies) const;
     IoResult exportObj(const std::string& path) const;
+    IoResult exportObj(const std::string& path, const std::vector<ObjBody>& bodies) const;
+    /** Tesselliert jede Part-Definition einmal und schreibt jede Komponente in Weltlage. */
+    IoResult exportAssemblyToObj(const std::string& path, const cad::core::Assembly& assembly,
+                                 const ObjWriter::Tessellator& tessellator) const;
     IoResult importPly(const std::string& path) const;
+    /** Netz oder Punktwolke (nur "element vertex") samt Normalen und Farben. */
+    IoResult importPlyData(const std::string& path, PlyData& data) const;
     IoResult exportPly(const std::string& path) const;
+    IoResult exportPly(const std::string& path, const PlyData& data, const PlyWriteOptions& options = {}) const;
     IoResult import3mf(const std::string& path) const;
+    /** Build-Items als Komponenten, Komponenten-Objekte als Unterbaugruppen (Netze optional in meshes). */
+    IoResult import3mfToAssembly(const std::string& path, cad::core::Assembly& assembly,
+                                 std::vector<ThreeMfMesh>* meshes = nullptr) const;
     IoResult export3mf(const std::string& path) const;
+    /** Je Part-Definition ein Netz-Objekt; Kopien nur als Build-Item bzw. Komponente mit Lage. */
+    IoResult exportAssemblyTo3mf(const std::string& path, const cad::core::Assembly& assembly,
+                                 const ThreeMfWriter::Tessellator& tessellator,
+                                 const ThreeMfWriteOptions& options = {}) const;
     IoResult importGltf(const std::string& path) const;
+    /** Knoten als Komponenten, je glTF-Netz eine geteilte Part-Definition (Netze optional in meshes). */
+    IoResult importGltfToAssembly(const std::string& path, cad::core::Assembly& assembly,
+                                  std::vector<GltfMesh>* meshes = nullptr) const;
     IoResult exportGltf(const std::string& path, bool binary = false) const;
+    /** Je Part-Definition ein Netz; Mehrfachvorkommen über EXT_mesh_gpu_instancing, optional quantisiert. */
+    IoResult exportAssemblyToGltf(const std::string& path, const cad::core::Assembly& assembly,
+                                  const GltfWriter::Tessellator& tessellator, const GltfWriteOptions& options = {}) const;
     
+    /** Import/Export einer Datei über den Leser bzw. Schreiber ihres Formats. */
+    IoResult importFile(const std::string& path, FileFormat format) const;
+    IoResult exportFile(const std::string& path, FileFormat format) const;
+    /** Parsen/Tessellieren dominiert (eigene Leser), sonst I/O bzw. Stub. */
+    bool isCpuBoundFormat(FileFormat format) const;
+
     // Batch operations
     IoResult importMultiple(const std::vector<ImportRequest>& requests) const;
     IoResult exportMultiple(const std::vector<ExportRequest>& requests) const;
+    /**
+     * Batch auf einem begrenzten Pool: zwei Spuren (I/O- und CPU-lastige Formate) mit eigener
+     * Obergrenze, je Datei Ergebnis und Zeit. CPU-lastige Importe größte Datei zuerst.
+     */
+    BatchResult importBatch(const std::vector<ImportRequest>& requests, const BatchOptions& options = {}) const;
+    BatchResult exportBatch(const std::vector<ExportRequest>& requests, const BatchOptions& options = {}) const;
     
     // Format validation
     bool validateFileFormat(const std::string& path, FileFormat expected_format) const;
     FileFormat detectFileFormat(const std::string& path) const;
     
     // Assembly import/export
-    cad::core::Assembly importStepToAssembly(const std::string& path) const;
+    /**
+     * solid_parts (optional): je B-rep-Id (MANIFOLD_SOLID_BREP/BREP_WITH_VOIDS) die Part-Definition, zu
+     * der der Körper gehört – über die Produktstruktur bzw. ohne sie das Teil je Körper.
+     */
+    cad::core::Assembly importStepToAssembly(const std::string& path,
+                                             std::map<std::uint32_t, cad::core::PartRef>* solid_parts = nullptr) const;
+#ifdef CAD_USE_EIGENER_KERN
+    /** B-rep-Körper einer STEP-Datei als Kern-Solids (parallel übersetzt); stats optional mit Zeiten. */
+    std::vector<StepSolid> importStepSolids(const std::string& path, StepBrepStats* stats = nullptr) const;
+#endif
     IoResult exportAssemblyToStep(const std::string& path, const cad::core::Assembly& assembly, bool ascii_mode = true) const;
     cad::core::Part importStlToPart(const std::string& path) const;
     IoResult exportPartToStl(const std::string& path, const cad::core::Part& part, bool ascii_mode = true) const;
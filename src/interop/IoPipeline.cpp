@@ -1,4 +1,29 @@
 #include "IoPipeline.h"
+#include "GltfReader.h"
+#include "GltfWriter.h"
+#include "ImportExportService.h"
+#include "ObjFile.h"
+#include "PlyFile.h"
+#include "ThreeMfFile.h"
+#include "../core/parallel/ThreadPool.h"
+#include "../core/perf/PerfSpan.h"
+#ifdef CAD_USE_EIGENER_KERN
+#include "../core/kernel/io/MeshCache.h"
+#include "../core/kernel/io/MeshGenerator.h"
+#include "../core/kernel/io/StlReader.h"
+#include "../core/kernel/io/StlWriter.h"
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace cad {
 namespace interop {
@@ -42,5 +67,459 @@ bool IoPipeline::supportsFormat(const std::string& format, bool is_export) const
     return false;
 }
 
+namespace {
+
+enum class MeshFormat { Unknown, Gltf, Glb, ThreeMf, Obj, Ply, Stl, Step, Project };
+
+MeshFormat formatOf(const std::string& path) {
+    std::string extension = std::filesystem::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (extension == ".gltf") return MeshFormat::Gltf;
+    if (extension == ".glb") return MeshFormat::Glb;
+    if (extension == ".3mf") return MeshFormat::ThreeMf;
+    if (extension == ".obj") return MeshFormat::Obj;
+    if (extension == ".ply") return MeshFormat::Ply;
+    if (extension == ".stl") return MeshFormat::Stl;
+    if (extension == ".step" || extension == ".stp") return MeshFormat::Step;
+    if (extension == ".hcasm" || extension == ".hcad" || extension == ".cad") return MeshFormat::Project;
+    return MeshFormat::Unknown;
+}
+
+std::size_t fileBytes(const std::string& path) {
+    std::error_code ec;
+    const std::uintmax_t bytes = std::filesystem::file_size(path, ec);
+    return ec ? 0 : static_cast<std::size_t>(bytes);
+}
+
+/** Zwischenstand: Baugruppe und je Part-Definition (Adresse der geteilten Definition) ein lokales Netz. */
+struct Scene {
+    core::Assembly assembly;
+    std::unordered_map<const core::Part*, core::TriangleMesh> meshes;
+
+    void addBody(const std::string& name, core::TriangleMesh mesh) {
+        const core::PartRef part{core::Part(name)};
+        assembly.addComponent(part, core::Transform{});
+        meshes.emplace(&part.get(), std::move(mesh));
+    }
+
+    /** Netz an eine Definition anhängen; mehrere Körper derselben Definition werden zusammengeführt. */
+    void attach(const core::Part& part, core::TriangleMesh mesh) {
+        core::TriangleMesh& target = meshes[&part];
+        if (target.vertices.empty()) {
+            target = std::move(mesh);
+            return;
+        }
+        const unsigned base = static_cast<unsigned>(target.vertices.size() / 3);
+        target.vertices.insert(target.vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+        for (unsigned index : mesh.indices) {
+            target.indices.push_back(base + index);
+        }
+    }
+
+    bool lookup(const core::Part& part, core::TriangleMesh& mesh) const {
+        const auto found = meshes.find(&part);
+        if (found == meshes.end()) {
+            return false;
+        }
+        mesh = found->second;
+        return true;
+    }
+
+    /** Alle Komponenten mit Netz in Weltlage zu einem Netz (PLY/STL). */
+    core::TriangleMesh merged() const {
+        core::TriangleMesh out;
+        for (const core::AssemblyComponent& component : assembly.components()) {
+            const auto found = meshes.find(&component.part.get());
+            if (found == meshes.end()) {
+                continue;
+            }
+            const core::RigidFrame frame = core::RigidFrame::fromTransform(assembly.worldTransform(component.id));
+            const unsigned base = static_cast<unsigned>(out.vertices.size() / 3);
+            const std::vector<double>& vertices = found->second.vertices;
+            for (std::size_t v = 0; v + 2 < vertices.size(); v += 3) {
+                double world[3];
+                frame.apply(&vertices[v], world);
+                out.vertices.insert(out.vertices.end(), world, world + 3);
+            }
+            for (unsigned index : found->second.indices) {
+                out.indices.push_back(base + index);
+            }
+        }
+        return out;
+    }
+};
+
+bool readScene(const std::string& path, MeshFormat format, const IoPipeline::ProjectLoader& project_loader,
+               Scene& scene, IoPipeline::Tessellator& tessellator, std::string& error) {
+    const std::string stem = std::filesystem::path(path).stem().string();
+    switch (format) {
+        case MeshFormat::Gltf:
+        case MeshFormat::Glb: {
+            GltfReader reader;
+            if (!reader.readFile(path)) {
+                error = reader.error();
+                return false;
+            }
+            scene.assembly = reader.takeAssembly();
+            for (GltfMesh& mesh : reader.takeMeshes()) {
+                scene.meshes.emplace(&mesh.part.get(), std::move(mesh.mesh));
+            }
+            return true;
+        }
+        case MeshFormat::ThreeMf: {
+            ThreeMfReader reader;
+            if (!reader.readFile(path)) {
+                error = reader.error();
+                return false;
+            }
+            scene.assembly = reader.takeAssembly();
+            for (ThreeMfMesh& mesh : reader.takeMeshes()) {
+                scene.meshes.emplace(&mesh.part.get(), std::move(mesh.mesh));
+            }
+            return true;
+        }
+        case MeshFormat::Obj: {
+            ObjReader reader;
+            if (!reader.readFile(path)) {
+                error = reader.error();
+                return false;
+            }
+            for (ObjBody& body : reader.takeBodies()) {
+                scene.addBody(body.name.empty() ? stem : body.name, std::move(body.mesh));
+            }
+            return true;
+        }
+        case MeshFormat::Ply: {
+            PlyReader reader;
+            PlyData data;
+            if (!reader.readFile(path, data)) {
+                error = reader.error();
+                return false;
+            }
+            if (data.isPointCloud()) {
+                error = "Point cloud without triangles: " + path;
+                return false;
+            }
+            scene.addBody(stem, std::move(data.mesh));
+            return true;
+        }
+        case MeshFormat::Stl: {
+#ifdef CAD_USE_EIGENER_KERN
+            kernel::io::TriangleMesh soup = kernel::io::readStlMesh(path);
+            if (soup.indices.empty()) {
+                error = "Could not open file: " + path;
+                return false;
+            }
+            kernel::io::TriangleMesh welded = kernel::io::MeshCache::weld(soup);
+            core::TriangleMesh mesh;
+            mesh.vertices = std::move(welded.vertices);
+            mesh.indices = std::move(welded.indices);
+            scene.addBody(stem, std::move(mesh));
+            return true;
+#else
+            error = "STL import requires the native kernel";
+            return false;
+#endif
+        }
+        case MeshFormat::Step: {
+            // Produktstruktur (NAUO/CDSR) übernehmen; Körper ohne sie je B-rep ein Teil an Identität
+            ImportExportService service;
+            std::map<std::uint32_t, core::PartRef> solid_parts;
+            scene.assembly = service.importStepToAssembly(path, &solid_parts);
+#ifdef CAD_USE_EIGENER_KERN
+            // B-reps parallel tessellieren und an ihre Part-Definition hängen (geteilt über alle Vorkommen)
+            std::vector<StepSolid> solids = service.importStepSolids(path);
+            std::vector<core::TriangleMesh> meshes(solids.size());
+            core::ThreadPool::shared().parallelFor(solids.size(), [&](std::size_t i) {
+                kernel::io::TriangleMesh solid_mesh = kernel::io::triangulate(*solids[i].solid);
+                meshes[i].vertices = std::move(solid_mesh.vertices);
+                meshes[i].indices = std::move(solid_mesh.indices);
+            });
+            for (std::size_t i = 0; i < solids.size(); ++i) {
+                const auto part = solid_parts.find(solids[i].id);
+                if (part != solid_parts.end()) {
+                    scene.attach(part->second.get(), std::move(meshes[i]));
+                } else {
+                    scene.addBody(solids[i].name.empty() ? "Solid_" + std::to_string(solids[i].id) : solids[i].name,
+                                  std::move(meshes[i]));
+                }
+            }
+#endif
+            if (scene.assembly.components().empty()) {
+                error = "No solids or product structure: " + path;
+                return false;
+            }
+            return true;
+        }
+        case MeshFormat::Project:
+            if (!project_loader) {
+                error = "Projects require a ProjectLoader: " + path;
+                return false;
+            }
+            if (!project_loader(path, scene.assembly, tessellator)) {
+                error = "Could not read project: " + path;
+                return false;
+            }
+            return true;
+        case MeshFormat::Unknown:
+            break;
+    }
+    error = "Unsupported source format: " + path;
+    return false;
+}
+
+bool writeScene(const std::string& path, MeshFormat format, const Scene& scene, std::string& error) {
+    const auto lookup = [&scene](const core::Part& part, core::TriangleMesh& mesh) { return scene.lookup(part, mesh); };
+    switch (format) {
+        case MeshFormat::Gltf:
+        case MeshFormat::Glb: {
+            GltfWriteOptions options;
+            options.binary = format == MeshFormat::Glb;
+            GltfWriter writer(options);
+            if (!writer.writeAssembly(path, scene.assembly, lookup)) {
+                error = writer.error();
+                return false;
+            }
+            return true;
+        }
+        case MeshFormat::ThreeMf: {
+            ThreeMfWriter writer;
+            if (!writer.writeAssembly(path, scene.assembly, lookup)) {
+                error = writer.error();
+                return false;
+            }
+            return true;
+        }
+        case MeshFormat::Obj: {
+            ObjWriter writer;
+            if (!writer.writeAssembly(path, scene.assembly, lookup)) {
+                error = writer.error();
+                return false;
+            }
+            return true;
+        }
+        case MeshFormat::Ply: {
+            PlyData data;
+            data.mesh = scene.merged();
+            return writePly(path, data, {}, &error);
+        }
+        case MeshFormat::Stl: {
+#ifdef CAD_USE_EIGENER_KERN
+            core::TriangleMesh merged = scene.merged();
+            kernel::io::TriangleMesh mesh;
+            mesh.vertices = std::move(merged.vertices);
+            mesh.indices = std::move(merged.indices);
+            if (!kernel::io::writeStlMesh(mesh, path, true)) {
+                error = "Could not create file: " + path;
+                return false;
+            }
+            return true;
+#else
+            error = "STL export requires the native kernel";
+            return false;
+#endif
+        }
+        case MeshFormat::Step: {
+            const IoResult result = ImportExportService().exportAssemblyToStep(path, scene.assembly);
+            if (!result.success) {
+                error = result.message;
+            }
+            return result.success;
+        }
+        case MeshFormat::Project:
+        case MeshFormat::Unknown:
+            break;
+    }
+    error = "Unsupported target format: " + path;
+    return false;
+}
+
+/** Anführungszeichen-Feld oder Wort ab pos; false, wenn keins mehr folgt. */
+bool nextField(const std::string& line, std::size_t& pos, std::string& field) {
+    while (pos < line.size() && std::isspace(static_cast<unsigned char>(line[pos]))) ++pos;
+    if (pos >= line.size() || line[pos] == '#') {
+        return false;
+    }
+    field.clear();
+    if (line[pos] == '"') {
+        const std::size_t end = line.find('"', pos + 1);
+        if (end == std::string::npos) {
+            return false;
+        }
+        field = line.substr(pos + 1, end - pos - 1);
+        pos = end + 1;
+        return true;
+    }
+    const std::size_t start = pos;
+    while (pos < line.size() && !std::isspace(static_cast<unsigned char>(line[pos]))) ++pos;
+    field = line.substr(start, pos - start);
+    return true;
+}
+
+}  // namespace
+
+ConversionResult IoPipeline::convert(const ConversionJob& job) const {
+    core::PerfTimer total("io.convert");
+    ConversionResult result;
+    result.job = job;
+    const MeshFormat input_format = formatOf(job.input);
+    const MeshFormat output_format = formatOf(job.output);
+    if (output_format == MeshFormat::Unknown || output_format == MeshFormat::Project) {
+        result.message = "Unsupported target format: " + job.output;
+        result.total_ms = total.finish().elapsed_ms;
+        return result;
+    }
+    result.input_bytes = fileBytes(job.input);
+
+    Scene scene;
+    std::string error;
+    core::PerfTimer read("io.convert.read");
+    Tessellator tessellator = tessellator_;
+    if (!readScene(job.input, input_format, project_loader_, scene, tessellator, error)) {
+        result.message = error;
+        result.total_ms = total.finish().elapsed_ms;
+        return result;
+    }
+    // Teile ohne Netz (Projekte, STEP-Struktur) einmal je Definition tessellieren
+    if (tessellator) {
+        std::vector<const core::Part*> missing;
+        std::unordered_set<const core::Part*> seen;
+        for (const core::AssemblyComponent& component : scene.assembly.components()) {
+            const core::Part* part = &component.part.get();
+            if (!scene.meshes.count(part) && seen.insert(part).second) {
+                missing.push_back(part);
+            }
+        }
+        std::vector<core::TriangleMesh> meshes(missing.size());
+        std::vector<char> ok(missing.size(), 0);
+        core::ThreadPool::shared().parallelFor(missing.size(), [&](std::size_t i) {
+            ok[i] = tessellator(*missing[i], meshes[i]) && !meshes[i].indices.empty();
+        });
+        for (std::size_t i = 0; i < missing.size(); ++i) {
+            if (ok[i]) {
+                scene.meshes.emplace(missing[i], std::move(meshes[i]));
+            }
+        }
+    }
+    result.read_ms = read.finish().elapsed_ms;
+    result.meshes = scene.meshes.size();
+    result.components = scene.assembly.components().size();
+
+    core::PerfTimer write("io.convert.write");
+    if (!writeScene(job.output, output_format, scene, error)) {
+        result.message = error;
+        result.total_ms = total.finish().elapsed_ms;
+        return result;
+    }
+    result.write_ms = write.finish().elapsed_ms;
+    result.output_bytes = fileBytes(job.output);
+    result.success = true;
+    result.message = std::to_string(result.components) + " components, " + std::to_string(result.meshes) + " meshes";
+    result.total_ms = total.finish().elapsed_ms;
+    return result;
+}
+
+std::vector<ConversionResult> IoPipeline::convertAll(const std::vector<ConversionJob>& jobs, std::size_t concurrency,
+                                                     const Progress& progress) const {
+    std::vector<ConversionResult> results(jobs.size());
+    if (jobs.empty()) {
+        return results;
+    }
+    if (concurrency == 0) {
+        concurrency = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    concurrency = std::min(concurrency, jobs.size());
+    std::mutex progress_mutex;
+    std::size_t done = 0;
+    auto body = [&](std::size_t i) {
+        results[i] = convert(jobs[i]);
+        std::lock_guard<std::mutex> lock(progress_mutex);
+        ++done;
+        if (progress) {
+            progress(results[i], done, jobs.size());
+        }
+    };
+    // Eigener Pool: Aufträge warten viel auf die Platte, das Parsen darin nutzt den gemeinsamen Pool
+    if (concurrency == 1) {
+        for (std::size_t i = 0; i < jobs.size(); ++i) body(i);
+    } else {
+        core::ThreadPool pool(concurrency - 1);
+        pool.parallelFor(jobs.size(), body);
+    }
+    return results;
+}
+
+ConversionStats IoPipeline::summarize(const std::vector<ConversionResult>& results, double wall_ms) {
+    ConversionStats stats;
+    stats.jobs = results.size();
+    stats.wall_ms = wall_ms;
+    if (results.empty()) {
+        return stats;
+    }
+    std::vector<double> latencies;
+    latencies.reserve(results.size());
+    double input_bytes = 0.0;
+    for (const ConversionResult& result : results) {
+        if (result.success) {
+            ++stats.succeeded;
+        } else {
+            ++stats.failed;
+        }
+        latencies.push_back(result.total_ms);
+        stats.latency_mean_ms += result.total_ms;
+        input_bytes += static_cast<double>(result.input_bytes);
+    }
+    std::sort(latencies.begin(), latencies.end());
+    // Nächstgelegener Rang
+    auto percentile = [&latencies](double p) {
+        const std::size_t rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(latencies.size())));
+        return latencies[std::min(latencies.size(), std::max<std::size_t>(rank, 1)) - 1];
+    };
+    stats.latency_mean_ms /= static_cast<double>(latencies.size());
+    stats.latency_p50_ms = percentile(0.50);
+    stats.latency_p95_ms = percentile(0.95);
+    stats.latency_max_ms = latencies.back();
+    if (wall_ms > 0.0) {
+        stats.jobs_per_second = 1000.0 * static_cast<double>(stats.jobs) / wall_ms;
+        stats.megabytes_per_second = input_bytes / 1e6 / (wall_ms / 1000.0);
+    }
+    return stats;
+}
+
+bool IoPipeline::readManifest(const std::string& path, std::vector<ConversionJob>& jobs, std::string& error) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        error = "Could not open file: " + path;
+        return false;
+    }
+    const std::filesystem::path base = std::filesystem::path(path).parent_path();
+    auto resolve = [&base](const std::string& field) {
+        const std::filesystem::path p(field);
+        return p.is_absolute() || base.empty() ? field : (base / p).string();
+    };
+    std::string line;
+    std::size_t number = 0;
+    while (std::getline(file, line)) {
+        ++number;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        std::size_t pos = 0;
+        std::string input;
+        std::string output;
+        if (!nextField(line, pos, input)) {
+            continue;
+        }
+        std::string extra;
+        if (!nextField(line, pos, output) || nextField(line, pos, extra)) {
+            error = "Manifest line " + std::to_string(number) + ": expected \"source target\"";
+            return false;
+        }
+        jobs.push_back(ConversionJob{resolve(input), resolve(output)});
+    }
+    return true;
+}
+
 }  // namespace interop
 }  // namespace cad
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <string>
 #include <vector>
 
+#include "../core/Modeler/Assembly.h"
+#include "../core/analysis/TriangleBvh.h"
+
 namespace cad {
 namespace interop {
 
@@ -22,12 +27,83 @@ struct IoJobResult {
     std::string message;
 };
 
+/** Konvertierung Quelle → Ziel; Formate aus den Dateiendungen. */
+struct ConversionJob {
+    std::string input;
+    std::string output;
+};
+
+struct ConversionResult {
+    ConversionJob job;
+    bool success{false};
+    std::string message;
+    /** Part-Definitionen mit Netz bzw. Komponenten der Zwischenbaugruppe. */
+    std::size_t meshes{0};
+    std::size_t components{0};
+    std::size_t input_bytes{0};
+    std::size_t output_bytes{0};
+    double read_ms{0.0};
+    double write_ms{0.0};
+    double total_ms{0.0};
+};
+
+/** Durchsatz und Latenz (total_ms je Auftrag) eines Konvertierungslaufs. */
+struct ConversionStats {
+    std::size_t jobs{0};
+    std::size_t succeeded{0};
+    std::size_t failed{0};
+    double wall_ms{0.0};
+    double jobs_per_second{0.0};
+    /** Eingelesene MB (10^6 Byte) je Sekunde Wandzeit. */
+    double megabytes_per_second{0.0};
+    double latency_mean_ms{0.0};
+    double latency_p50_ms{0.0};
+    double latency_p95_ms{0.0};
+    double latency_max_ms{0.0};
+};
+
 class IoPipeline {
 public:
+    /** Netz für Teile ohne Netz aus der Quelle (z.B. Projekt-Teile über den Kern); false = ohne Netz. */
+    using Tessellator = std::function<bool(const core::Part& part, core::TriangleMesh& mesh)>;
+    /**
+     * Lädt ein natives Projekt (.hcasm/.hcad/.cad); interop kennt den Projektdienst der App nicht.
+     * tessellator kann für die Teile dieses Projekts gesetzt werden (z.B. mit seinen Skizzen).
+     */
+    using ProjectLoader = std::function<bool(const std::string& path, core::Assembly& assembly, Tessellator& tessellator)>;
+    using Progress = std::function<void(const ConversionResult& result, std::size_t done, std::size_t total)>;
+
     IoJobResult importJob(const IoJob& job) const;
     IoJobResult exportJob(const IoJob& job) const;
     std::vector<IoFormatSupport> supportedFormats() const;
     bool supportsFormat(const std::string& format, bool is_export) const;
+
+    void setProjectLoader(ProjectLoader loader) { project_loader_ = std::move(loader); }
+    void setTessellator(Tessellator tessellator) { tessellator_ = std::move(tessellator); }
+
+    /**
+     * Liest die Quelle in eine Baugruppe mit je Part-Definition einem Netz und schreibt sie im Zielformat.
+     * Quellen: glTF/GLB, 3MF, OBJ, PLY, STL und STEP (Netze nur mit eigenem Kern), Projekte über den
+     * ProjectLoader. Ziele: glTF/GLB, 3MF, OBJ, PLY, STL (mit Kern) und STEP (Produktstruktur).
+     */
+    ConversionResult convert(const ConversionJob& job) const;
+    /**
+     * Aufträge parallel auf einem eigenen Pool (concurrency 0 → hardware_concurrency); Ergebnisse in
+     * Auftragsreihenfolge, progress nach jedem Auftrag (aus einem Worker, nacheinander).
+     */
+    std::vector<ConversionResult> convertAll(const std::vector<ConversionJob>& jobs, std::size_t concurrency = 0,
+                                             const Progress& progress = nullptr) const;
+
+    static ConversionStats summarize(const std::vector<ConversionResult>& results, double wall_ms);
+    /**
+     * Manifest: je Zeile "quelle ziel" (Pfade mit Leerzeichen in Anführungszeichen), '#' leitet einen
+     * Kommentar ein. Relative Pfade gelten relativ zum Verzeichnis des Manifests.
+     */
+    static bool readManifest(const std::string& path, std::vector<ConversionJob>& jobs, std::string& error);
+
+private:
+    ProjectLoader project_loader_;
+    Tessellator tessellator_;
 };
 
 }  // namespace interop
@@ -0,0 +1,61 @@
+#include "MappedFile.h"
+
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cad {
+namespace interop {
+
+MappedFile::MappedFile(const std::string& path, bool sequential) {
+#ifndef _WIN32
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    ok_ = true;
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+        const std::size_t size = static_cast<std::size_t>(info.st_size);
+        void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            ::madvise(mapping, size, sequential ? MADV_SEQUENTIAL : MADV_WILLNEED);
+            mapping_ = mapping;
+            data_ = static_cast<const char*>(mapping);
+            size_ = size;
+        }
+    }
+    ::close(fd);
+    if (data_) {
+        return;
+    }
+#else
+    (void)sequential;
+#endif
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        ok_ = false;
+        return;
+    }
+    ok_ = true;
+    buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (mapping_) {
+        ::munmap(mapping_, size_);
+    }
+#endif
+}
+
+}  // namespace interop
+}  // namespace cad
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace cad {
+namespace interop {
+
+/**
+ * Nur lesend gemappte Datei (Fallback: eingelesener Puffer, z.B. unter Windows oder für Pipes).
+ * Die Sicht data()/size() bleibt bis zur Zerstörung gültig.
+ */
+class MappedFile {
+public:
+    /** sequential: Hinweis an das System, dass vorwärts gelesen wird (sonst WILLNEED). */
+    explicit MappedFile(const std::string& path, bool sequential = true);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /** false, wenn die Datei nicht lesbar ist (leere Dateien sind ok). */
+    bool ok() const { return ok_; }
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    void* mapping_{nullptr};
+    std::string buffer_;
+    const char* data_{nullptr};
+    std::size_t size_{0};
+    bool ok_{false};
+};
+
+}  // namespace interop
+}  // namespace cad
@@ -0,0 +1,494 @@
+#include "ObjFile.h"
+#include "MappedFile.h"
+#include "TextSink.h"
+#include "../core/parallel/ThreadPool.h"
+#include "../core/perf/PerfSpan.h"
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace cad {
+namespace interop {
+
+namespace {
+
+constexpr std::int64_t kMissing = std::numeric_limits<std::int64_t>::min();
+
+/** Index einer Ecke: absolut (0-basiert) oder relativ zum Stück (negativer OBJ-Index). */
+struct Corner {
+    std::int64_t index[3]{kMissing, kMissing, kMissing};
+    std::uint8_t relative{0};
+};
+
+inline bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline const char* skipBlank(const char* p, const char* e) {
+    while (p < e && isBlank(*p)) ++p;
+    return p;
+}
+
+/** Schlüssel (v, vt, vn) eines Eckpunkts je Körper. */
+struct CornerKey {
+    std::int64_t v;
+    std::int64_t t;
+    std::int64_t n;
+    bool operator==(const CornerKey& other) const { return v == other.v && t == other.t && n == other.n; }
+};
+
+struct CornerKeyHash {
+    std::size_t operator()(const CornerKey& key) const {
+        std::uint64_t h = static_cast<std::uint64_t>(key.v) * 0x9E3779B97F4A7C15ull;
+        h ^= static_cast<std::uint64_t>(key.t) + 0x7F4A7C15ull + (h << 6) + (h >> 2);
+        h ^= static_cast<std::uint64_t>(key.n) + 0x9E3779B9ull + (h << 6) + (h >> 2);
+        return static_cast<std::size_t>(h);
+    }
+};
+
+}  // namespace
+
+/** Ergebnis eines Stücks; Indizes erst beim Zusammenführen global. */
+struct ObjReader::Chunk {
+    const char* begin{nullptr};
+    const char* end{nullptr};
+    std::vector<double> positions;
+    std::vector<double> texcoords;
+    std::vector<double> normals;
+    std::vector<Corner> corners;
+    std::vector<std::uint32_t> face_sizes;
+    /** Gruppenwechsel vor Fläche Nr. (im Stück). */
+    std::vector<std::pair<std::size_t, std::string>> groups;
+    /** Erste fehlerhafte Stelle oder nullptr. */
+    const char* error_at{nullptr};
+
+    void parse();
+};
+
+void ObjReader::Chunk::parse() {
+    auto readReals = [&](const char*& p, const char* e, double* out, int count) {
+        int read = 0;
+        for (; read < count; ++read) {
+            p = skipBlank(p, e);
+            const auto result = std::from_chars(p, e, out[read]);
+            if (result.ec != std::errc()) {
+                break;
+            }
+            p = result.ptr;
+        }
+        return read;
+    };
+
+    const char* p = begin;
+    while (p < end && !error_at) {
+        const char* line_end = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        if (!line_end) {
+            line_end = end;
+        }
+        const char* q = skipBlank(p, line_end);
+        if (q + 1 < line_end && q[0] == 'v' && isBlank(q[1])) {
+            double xyz[3] = {0.0, 0.0, 0.0};
+            q += 2;
+            if (readReals(q, line_end, xyz, 3) != 3) {
+                error_at = q;
+                break;
+            }
+            positions.insert(positions.end(), xyz, xyz + 3);
+        } else if (q + 2 < line_end && q[0] == 'v' && q[1] == 't' && isBlank(q[2])) {
+            double uv[2] = {0.0, 0.0};
+            q += 3;
+            if (readReals(q, line_end, uv, 2) < 1) {
+                error_at = q;
+                break;
+            }
+            texcoords.insert(texcoords.end(), uv, uv + 2);
+        } else if (q + 2 < line_end && q[0] == 'v' && q[1] == 'n' && isBlank(q[2])) {
+            double xyz[3] = {0.0, 0.0, 0.0};
+            q += 3;
+            if (readReals(q, line_end, xyz, 3) != 3) {
+                error_at = q;
+                break;
+            }
+            normals.insert(normals.end(), xyz, xyz + 3);
+        } else if (q + 1 < line_end && q[0] == 'f' && isBlank(q[1])) {
+            q += 2;
+            std::uint32_t count = 0;
+            const std::int64_t counts[3] = {static_cast<std::int64_t>(positions.size() / 3),
+                                            static_cast<std::int64_t>(texcoords.size() / 2),
+                                            static_cast<std::int64_t>(normals.size() / 3)};
+            while (true) {
+                q = skipBlank(q, line_end);
+                if (q >= line_end || *q == '#') {
+                    break;
+                }
+                Corner corner;
+                for (int slot = 0; slot < 3; ++slot) {
+                    if (slot > 0) {
+                        if (q >= line_end || *q != '/') {
+                            break;
+                        }
+                        ++q;
+                        if (q < line_end && *q == '/') {
+                            // "v//n": vt fehlt
+                            continue;
+                        }
+                    }
+                    std::int64_t value = 0;
+                    const auto result = std::from_chars(q, line_end, value);
+                    if (result.ec != std::errc() || value == 0) {
+                        error_at = q;
+                        break;
+                    }
+                    q = result.ptr;
+                    if (value > 0) {
+                        corner.index[slot] = value - 1;
+                    } else {
+                        corner.index[slot] = counts[slot] + value;
+                        corner.relative |= static_cast<std::uint8_t>(1u << slot);
+                    }
+                }
+                if (error_at) {
+                    break;
+                }
+                corners.push_back(corner);
+                ++count;
+            }
+            if (error_at) {
+                break;
+            }
+            face_sizes.push_back(count);
+        } else if (q < line_end && (q[0] == 'g' || q[0] == 'o') && (q + 1 == line_end || isBlank(q[1]))) {
+            const char* name_begin = skipBlank(q + 1, line_end);
+            const char* name_end = line_end;
+            while (name_end > name_begin && isBlank(name_end[-1])) --name_end;
+            groups.emplace_back(face_sizes.size(), std::string(name_begin, name_end));
+        }
+        p = line_end + 1;
+    }
+}
+
+bool ObjReader::readFile(const std::string& path) {
+    MappedFile input(path);
+    if (!input.ok()) {
+        bodies_.clear();
+        stats_ = ObjStats{};
+        error_ = "Could not open file: " + path;
+        return false;
+    }
+    return parse(input.data(), input.size());
+}
+
+bool ObjReader::readText(const std::string& text) {
+    return parse(text.data(), text.size());
+}
+
+bool ObjReader::parse(const char* data, std::size_t size) {
+    core::PerfTimer timer("obj.parse");
+    bodies_.clear();
+    stats_ = ObjStats{};
+    error_.clear();
+
+    // Stücke an Zeilengrenzen
+    std::vector<Chunk> chunks;
+    const char* end = data + size;
+    for (const char* p = data; p < end;) {
+        const char* cut = static_cast<std::size_t>(end - p) > chunk_bytes_ ? p + chunk_bytes_ : end;
+        if (cut < end) {
+            const char* line_end = static_cast<const char*>(std::memchr(cut, '\n', static_cast<std::size_t>(end - cut)));
+            cut = line_end ? line_end + 1 : end;
+        }
+        Chunk chunk;
+        chunk.begin = p;
+        chunk.end = cut;
+        chunks.push_back(std::move(chunk));
+        p = cut;
+    }
+    core::ThreadPool& pool = pool_ ? *pool_ : core::ThreadPool::shared();
+    pool.parallelFor(chunks.size(), [&](std::size_t i) { chunks[i].parse(); });
+    stats_.chunks = chunks.size();
+
+    for (const Chunk& chunk : chunks) {
+        if (chunk.error_at) {
+            error_ = "Invalid line at byte " + std::to_string(chunk.error_at - data);
+            return false;
+        }
+    }
+
+    // Globale Felder in Dateireihenfolge
+    std::vector<double> positions;
+    std::vector<double> texcoords;
+    std::vector<double> normals;
+    std::vector<std::int64_t> offsets(chunks.size() * 3);
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        offsets[i * 3] = static_cast<std::int64_t>(positions.size() / 3);
+        offsets[i * 3 + 1] = static_cast<std::int64_t>(texcoords.size() / 2);
+        offsets[i * 3 + 2] = static_cast<std::int64_t>(normals.size() / 3);
+        positions.insert(positions.end(), chunks[i].positions.begin(), chunks[i].positions.end());
+        texcoords.insert(texcoords.end(), chunks[i].texcoords.begin(), chunks[i].texcoords.end());
+        normals.insert(normals.end(), chunks[i].normals.begin(), chunks[i].normals.end());
+    }
+    const std::int64_t totals[3] = {static_cast<std::int64_t>(positions.size() / 3),
+                                    static_cast<std::int64_t>(texcoords.size() / 2),
+                                    static_cast<std::int64_t>(normals.size() / 3)};
+    stats_.positions = static_cast<std::size_t>(totals[0]);
+    stats_.texcoords = static_cast<std::size_t>(totals[1]);
+    stats_.normals = static_cast<std::size_t>(totals[2]);
+
+    // Körper je Gruppenname; Eckpunkte je Körper nach (v, vt, vn) zusammengefasst
+    struct Builder {
+        std::unordered_map<CornerKey, std::uint32_t, CornerKeyHash> index;
+        std::vector<CornerKey> keys;
+        bool has_uv{false};
+        bool has_normal{false};
+    };
+    std::vector<Builder> builders;
+    std::unordered_map<std::string, std::size_t> body_of;
+    std::size_t current = std::numeric_limits<std::size_t>::max();
+    std::string pending = "default";
+    auto select = [&](const std::string& name) {
+        pending = name.empty() ? std::string("default") : name;
+        current = std::numeric_limits<std::size_t>::max();
+    };
+    std::vector<std::uint32_t> face;
+    for (std::size_t c = 0; c < chunks.size(); ++c) {
+        const Chunk& chunk = chunks[c];
+        std::size_t group = 0;
+        std::size_t corner = 0;
+        for (std::size_t f = 0; f <= chunk.face_sizes.size(); ++f) {
+            while (group < chunk.groups.size() && chunk.groups[group].first == f) {
+                select(chunk.groups[group].second);
+                ++group;
+            }
+            if (f == chunk.face_sizes.size()) {
+                break;
+            }
+            const std::uint32_t count = chunk.face_sizes[f];
+            ++stats_.faces;
+            if (current == std::numeric_limits<std::size_t>::max()) {
+                auto it = body_of.find(pending);
+                if (it == body_of.end()) {
+                    it = body_of.emplace(pending, bodies_.size()).first;
+                    bodies_.emplace_back();
+                    bodies_.back().name = pending;
+                    builders.emplace_back();
+                }
+                current = it->second;
+            }
+            ObjBody& body = bodies_[current];
+            Builder& builder = builders[current];
+            face.clear();
+            for (std::uint32_t k = 0; k < count; ++k, ++corner) {
+                const Corner& raw = chunk.corners[corner];
+                std::int64_t resolved[3];
+                for (int slot = 0; slot < 3; ++slot) {
+                    resolved[slot] = raw.index[slot];
+                    if (resolved[slot] == kMissing) {
+                        continue;
+                    }
+                    if (raw.relative & (1u << slot)) {
+                        resolved[slot] += offsets[c * 3 + slot];
+                    }
+                    if (resolved[slot] < 0 || resolved[slot] >= totals[slot]) {
+                        error_ = "Invalid index in face " + std::to_string(stats_.faces);
+                        bodies_.clear();
+                        return false;
+                    }
+                }
+                if (resolved[0] == kMissing) {
+                    error_ = "Face without vertices (face " + std::to_string(stats_.faces) + ")";
+                    bodies_.clear();
+                    return false;
+                }
+                const CornerKey key{resolved[0], resolved[1], resolved[2]};
+                auto inserted = builder.index.emplace(key, static_cast<std::uint32_t>(builder.keys.size()));
+                if (inserted.second) {
+                    builder.keys.push_back(key);
+                    body.mesh.vertices.insert(body.mesh.vertices.end(), positions.begin() + key.v * 3,
+                                              positions.begin() + key.v * 3 + 3);
+                    builder.has_uv = builder.has_uv || key.t != kMissing;
+                    builder.has_normal = builder.has_normal || key.n != kMissing;
+                }
+                face.push_back(inserted.first->second);
+            }
+            // Fächer ab der ersten Ecke
+            for (std::size_t k = 1; k + 1 < face.size(); ++k) {
+                body.mesh.indices.push_back(face[0]);
+                body.mesh.indices.push_back(face[k]);
+                body.mesh.indices.push_back(face[k + 1]);
+                ++stats_.triangles;
+            }
+        }
+    }
+
+    for (std::size_t b = 0; b < bodies_.size(); ++b) {
+        const Builder& builder = builders[b];
+        ObjBody& body = bodies_[b];
+        if (builder.has_uv) {
+            body.uvs.reserve(builder.keys.size() * 2);
+            for (const CornerKey& key : builder.keys) {
+                body.uvs.push_back(key.t == kMissing ? 0.0 : texcoords[key.t * 2]);
+                body.uvs.push_back(key.t == kMissing ? 0.0 : texcoords[key.t * 2 + 1]);
+            }
+        }
+        if (builder.has_normal) {
+            body.normals.reserve(builder.keys.size() * 3);
+            for (const CornerKey& key : builder.keys) {
+                for (int k = 0; k < 3; ++k) {
+                    body.normals.push_back(key.n == kMissing ? 0.0 : normals[key.n * 3 + k]);
+                }
+            }
+        }
+    }
+    stats_.parse_ms = timer.finish().elapsed_ms;
+    return true;
+}
+
+namespace {
+
+void writeBody(TextSink& out, const std::string& name, const std::vector<double>& vertices,
+               const std::vector<unsigned int>& indices, const std::vector<double>* normals,
+               const std::vector<double>* uvs, std::size_t& written, ObjWriteStats& stats) {
+    auto line = [&](const char* tag, const double* values, int count) {
+        out.text(tag);
+        for (int k = 0; k < count; ++k) {
+            out.put(' ');
+            out.real(values[k]);
+        }
+        out.text("\n");
+    };
+    const std::size_t vertex_count = vertices.size() / 3;
+    const bool with_uv = uvs && uvs->size() == vertex_count * 2;
+    const bool with_normal = normals && normals->size() == vertex_count * 3;
+    out.text("o ");
+    for (char c : name) {
+        out.put(c == '\n' || c == '\r' ? ' ' : c);
+    }
+    out.text("\n");
+    for (std::size_t i = 0; i < vertex_count; ++i) {
+        line("v", &vertices[i * 3], 3);
+    }
+    for (std::size_t i = 0; with_uv && i < vertex_count; ++i) {
+        line("vt", &(*uvs)[i * 2], 2);
+    }
+    for (std::size_t i = 0; with_normal && i < vertex_count; ++i) {
+        line("vn", &(*normals)[i * 3], 3);
+    }
+    for (std::size_t t = 0; t + 2 < indices.size(); t += 3) {
+        out.put('f');
+        for (int k = 0; k < 3; ++k) {
+            const std::uint64_t index = written + indices[t + k] + 1;
+            out.put(' ');
+            out.integer(index);
+            if (with_uv || with_normal) {
+                out.put('/');
+                if (with_uv) {
+                    out.integer(index);
+                }
+                if (with_normal) {
+                    out.put('/');
+                    out.integer(index);
+                }
+            }
+        }
+        out.text("\n");
+    }
+    written += vertex_count;
+    ++stats.bodies;
+    stats.vertices += vertex_count;
+    stats.triangles += indices.size() / 3;
+}
+
+}  // namespace
+
+bool ObjWriter::writeBodies(const std::string& path, const std::vector<ObjBody>& bodies) {
+    core::PerfTimer timer("obj.write");
+    stats_ = ObjWriteStats{};
+    error_.clear();
+    std::ofstream file(path, std::ios::binary);
+    if (path.empty() || !file.is_open()) {
+        error_ = "Could not create file: " + path;
+        return false;
+    }
+    TextSink out(file, buffer_bytes_);
+    out.text("# OBJ file exported from Hydra CAD\n");
+    std::size_t written = 0;
+    for (const ObjBody& body : bodies) {
+        writeBody(out, body.name, body.mesh.vertices, body.mesh.indices, &body.normals, &body.uvs, written, stats_);
+    }
+    const bool ok = out.flush();
+    file.close();
+    stats_.bytes = out.bytes();
+    stats_.write_ms = timer.finish().elapsed_ms;
+    if (!ok || !file) {
+        error_ = "Write failed: " + path;
+        return false;
+    }
+    return true;
+}
+
+bool ObjWriter::writeAssembly(const std::string& path, const core::Assembly& assembly, const Tessellator& tessellator) {
+    core::PerfTimer timer("obj.write");
+    stats_ = ObjWriteStats{};
+    error_.clear();
+    std::ofstream file(path, std::ios::binary);
+    if (path.empty() || !file.is_open()) {
+        error_ = "Could not create file: " + path;
+        return false;
+    }
+    TextSink out(file, buffer_bytes_);
+    out.text("# OBJ file exported from Hydra CAD\n");
+
+    // Unterbaugruppen (Komponenten mit Kindern) sind Gruppierung, geschrieben werden nur Blätter
+    std::unordered_set<std::uint64_t> parents;
+    for (const core::AssemblyComponent& component : assembly.components()) {
+        if (component.parent_id != 0) {
+            parents.insert(component.parent_id);
+        }
+    }
+    // Je Definition einmal tessellieren; leere Netze merken, um nicht erneut zu fragen
+    std::unordered_map<const core::Part*, core::TriangleMesh> meshes;
+    std::vector<double> world;
+    std::size_t written = 0;
+    for (const core::AssemblyComponent& component : assembly.components()) {
+        if (parents.count(component.id)) {
+            continue;
+        }
+        const core::Part* definition = &component.part.get();
+        auto it = meshes.find(definition);
+        if (it == meshes.end()) {
+            core::TriangleMesh mesh;
+            if (!tessellator || !tessellator(*definition, mesh)) {
+                mesh = core::TriangleMesh{};
+            }
+            it = meshes.emplace(definition, std::move(mesh)).first;
+        }
+        const core::TriangleMesh& mesh = it->second;
+        if (mesh.indices.empty()) {
+            continue;
+        }
+        const core::RigidFrame frame = core::RigidFrame::fromTransform(assembly.worldTransform(component.id));
+        world.resize(mesh.vertices.size());
+        for (std::size_t i = 0; i + 2 < mesh.vertices.size(); i += 3) {
+            frame.apply(&mesh.vertices[i], &world[i]);
+        }
+        writeBody(out, definition->name() + "_" + std::to_string(component.id), world, mesh.indices, nullptr, nullptr,
+                  written, stats_);
+    }
+    const bool ok = out.flush();
+    file.close();
+    stats_.bytes = out.bytes();
+    stats_.write_ms = timer.finish().elapsed_ms;
+    if (!ok || !file) {
+        error_ = "Write failed: " + path;
+        return false;
+    }
+    return true;
+}
+
+}  // namespace interop
+}  // namespace cad
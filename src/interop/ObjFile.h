@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../core/Modeler/Assembly.h"
+#include "../core/analysis/TriangleBvh.h"
+
+namespace cad {
+namespace core {
+class ThreadPool;
+}  // namespace core
+
+namespace interop {
+
+/** Körper einer OBJ-Datei (Gruppe bzw. Objekt); normals/uvs je Eckpunkt von mesh oder leer. */
+struct ObjBody {
+    std::string name;
+    core::TriangleMesh mesh;
+    /** xyz je Eckpunkt. */
+    std::vector<double> normals;
+    /** uv je Eckpunkt. */
+    std::vector<double> uvs;
+};
+
+struct ObjStats {
+    /** Zeilen v, vt, vn und f der Datei. */
+    std::size_t positions{0};
+    std::size_t texcoords{0};
+    std::size_t normals{0};
+    std::size_t faces{0};
+    std::size_t triangles{0};
+    std::size_t chunks{0};
+    double parse_ms{0.0};
+};
+
+/**
+ * OBJ-Leser: Datei gemappt, an Zeilengrenzen in Stücke geteilt und parallel mit std::from_chars zerlegt.
+ * Unterstützt v/vt/vn, Flächen mit beliebig vielen Ecken (Fächer), negative (relative) Indizes,
+ * Ecken "v", "v/t", "v//n", "v/t/n" sowie g/o als eigene Körper (gleichnamige Gruppen werden
+ * zusammengeführt). Eckpunkte werden je Körper nach (v, vt, vn) zusammengefasst.
+ */
+class ObjReader {
+public:
+    static constexpr std::size_t kDefaultChunkBytes = 4u * 1024 * 1024;
+
+    /** pool == nullptr → ThreadPool::shared(). */
+    void setThreadPool(core::ThreadPool* pool) { pool_ = pool; }
+    void setChunkBytes(std::size_t bytes) { chunk_bytes_ = bytes == 0 ? 1 : bytes; }
+
+    /** false bei Lesefehler oder ungültigem Index (error()). */
+    bool readFile(const std::string& path);
+    bool readText(const std::string& text);
+
+    const std::vector<ObjBody>& bodies() const { return bodies_; }
+    std::vector<ObjBody> takeBodies() { return std::move(bodies_); }
+    const ObjStats& stats() const { return stats_; }
+    const std::string& error() const { return error_; }
+
+private:
+    struct Chunk;
+
+    bool parse(const char* data, std::size_t size);
+
+    core::ThreadPool* pool_{nullptr};
+    std::size_t chunk_bytes_{kDefaultChunkBytes};
+    std::vector<ObjBody> bodies_;
+    ObjStats stats_;
+    std::string error_;
+};
+
+struct ObjWriteStats {
+    std::size_t bodies{0};
+    std::size_t vertices{0};
+    std::size_t triangles{0};
+    std::size_t bytes{0};
+    double write_ms{0.0};
+};
+
+/**
+ * OBJ-Schreiber über einen großen Puffer (Zahlen per std::to_chars). Körper werden als "o name"
+ * nacheinander geschrieben; Baugruppen je Komponente in Weltlage, jede Part-Definition wird nur einmal
+ * tesselliert.
+ */
+class ObjWriter {
+public:
+    using Tessellator = std::function<bool(const core::Part& part, core::TriangleMesh& mesh)>;
+
+    explicit ObjWriter(std::size_t buffer_bytes = 4u * 1024 * 1024) : buffer_bytes_(buffer_bytes) {}
+
+    bool writeBodies(const std::string& path, const std::vector<ObjBody>& bodies);
+    /** Komponenten ohne Kinder als "o <Teil>_<Id>"; Teile ohne Netz werden übersprungen. */
+    bool writeAssembly(const std::string& path, const core::Assembly& assembly, const Tessellator& tessellator);
+
+    const ObjWriteStats& stats() const { return stats_; }
+    const std::string& error() const { return error_; }
+
+private:
+    std::size_t buffer_bytes_;
+    ObjWriteStats stats_;
+    std::string error_;
+};
+
+}  // namespace interop
+}  // namespace cad
@@ -0,0 +1,592 @@
+#include "PlyFile.h"
+#include "MappedFile.h"
+#include "TextSink.h"
+#include "../core/parallel/ThreadPool.h"
+#include "../core/perf/PerfSpan.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+
+namespace cad {
+namespace interop {
+
+namespace {
+
+enum class Scalar : std::uint8_t { Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64 };
+
+struct Property {
+    std::string name;
+    Scalar type{Scalar::Float32};
+    bool list{false};
+    Scalar count_type{Scalar::UInt8};
+    /** Byte-Versatz im Satz (nur bei Elementen ohne Listen). */
+    std::size_t offset{0};
+};
+
+struct Element {
+    std::string name;
+    std::size_t count{0};
+    std::vector<Property> properties;
+    /** Feste Satzlänge (keine Listen). */
+    bool fixed{true};
+    std::size_t stride{0};
+};
+
+/** Vertex-Eigenschaften, die übernommen werden; -1 = fehlt. */
+enum Role { X, Y, Z, NX, NY, NZ, Red, Green, Blue, RoleCount };
+
+constexpr std::size_t kVertexBlock = 64 * 1024;
+
+bool scalarFromName(const std::string& name, Scalar& type) {
+    if (name == "char" || name == "int8") type = Scalar::Int8;
+    else if (name == "uchar" || name == "uint8") type = Scalar::UInt8;
+    else if (name == "short" || name == "int16") type = Scalar::Int16;
+    else if (name == "ushort" || name == "uint16") type = Scalar::UInt16;
+    else if (name == "int" || name == "int32") type = Scalar::Int32;
+    else if (name == "uint" || name == "uint32") type = Scalar::UInt32;
+    else if (name == "float" || name == "float32") type = Scalar::Float32;
+    else if (name == "double" || name == "float64") type = Scalar::Float64;
+    else return false;
+    return true;
+}
+
+std::size_t scalarSize(Scalar type) {
+    switch (type) {
+        case Scalar::Int8:
+        case Scalar::UInt8: return 1;
+        case Scalar::Int16:
+        case Scalar::UInt16: return 2;
+        case Scalar::Int32:
+        case Scalar::UInt32:
+        case Scalar::Float32: return 4;
+        case Scalar::Float64: return 8;
+    }
+    return 0;
+}
+
+bool hostLittleEndian() {
+    const std::uint16_t probe = 1;
+    unsigned char first = 0;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+template <typename T>
+T loadRaw(const char* p, bool swap) {
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, p, sizeof(T));
+    if (swap) {
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+double loadReal(const char* p, Scalar type, bool swap) {
+    switch (type) {
+        case Scalar::Int8: return static_cast<double>(loadRaw<std::int8_t>(p, false));
+        case Scalar::UInt8: return static_cast<double>(loadRaw<std::uint8_t>(p, false));
+        case Scalar::Int16: return static_cast<double>(loadRaw<std::int16_t>(p, swap));
+        case Scalar::UInt16: return static_cast<double>(loadRaw<std::uint16_t>(p, swap));
+        case Scalar::Int32: return static_cast<double>(loadRaw<std::int32_t>(p, swap));
+        case Scalar::UInt32: return static_cast<double>(loadRaw<std::uint32_t>(p, swap));
+        case Scalar::Float32: return static_cast<double>(loadRaw<float>(p, swap));
+        case Scalar::Float64: return loadRaw<double>(p, swap);
+    }
+    return 0.0;
+}
+
+std::int64_t loadInteger(const char* p, Scalar type, bool swap) {
+    switch (type) {
+        case Scalar::Int8: return loadRaw<std::int8_t>(p, false);
+        case Scalar::UInt8: return loadRaw<std::uint8_t>(p, false);
+        case Scalar::Int16: return loadRaw<std::int16_t>(p, swap);
+        case Scalar::UInt16: return loadRaw<std::uint16_t>(p, swap);
+        case Scalar::Int32: return loadRaw<std::int32_t>(p, swap);
+        case Scalar::UInt32: return loadRaw<std::uint32_t>(p, swap);
+        case Scalar::Float32: return static_cast<std::int64_t>(loadRaw<float>(p, swap));
+        case Scalar::Float64: return static_cast<std::int64_t>(loadRaw<double>(p, swap));
+    }
+    return 0;
+}
+
+bool isIntegral(Scalar type) {
+    return type != Scalar::Float32 && type != Scalar::Float64;
+}
+
+int roleOf(const std::string& name) {
+    static const char* const names[][3] = {{"x", nullptr, nullptr},
+                                           {"y", nullptr, nullptr},
+                                           {"z", nullptr, nullptr},
+                                           {"nx", "normal_x", nullptr},
+                                           {"ny", "normal_y", nullptr},
+                                           {"nz", "normal_z", nullptr},
+                                           {"red", "r", "diffuse_red"},
+                                           {"green", "g", "diffuse_green"},
+                                           {"blue", "b", "diffuse_blue"}};
+    for (int role = 0; role < RoleCount; ++role) {
+        for (const char* candidate : names[role]) {
+            if (candidate && name == candidate) {
+                return role;
+            }
+        }
+    }
+    return -1;
+}
+
+/** Farbe aus Ganzzahl (0..255) oder Gleitkomma (0..1). */
+std::uint8_t colorByte(double value, Scalar type) {
+    const double scaled = isIntegral(type) ? value : value * 255.0;
+    return static_cast<std::uint8_t>(std::clamp(scaled + (isIntegral(type) ? 0.0 : 0.5), 0.0, 255.0));
+}
+
+/** Leerzeichen-getrennte Werte des ASCII-Rumpfs. */
+class Tokens {
+public:
+    Tokens(const char* p, const char* e) : p_(p), e_(e) {}
+
+    bool next(std::string_view& token) {
+        while (p_ < e_ && (*p_ == ' ' || *p_ == '\t' || *p_ == '\r' || *p_ == '\n')) ++p_;
+        if (p_ >= e_) {
+            return false;
+        }
+        const char* start = p_;
+        while (p_ < e_ && *p_ != ' ' && *p_ != '\t' && *p_ != '\r' && *p_ != '\n') ++p_;
+        token = std::string_view(start, static_cast<std::size_t>(p_ - start));
+        return true;
+    }
+    bool real(double& value) {
+        std::string_view token;
+        if (!next(token)) {
+            return false;
+        }
+        const auto result = std::from_chars(token.data(), token.data() + token.size(), value);
+        return result.ec == std::errc() && result.ptr == token.data() + token.size();
+    }
+    const char* position() const { return p_; }
+
+private:
+    const char* p_;
+    const char* e_;
+};
+
+}  // namespace
+
+bool PlyReader::readFile(const std::string& path, PlyData& data) {
+    MappedFile input(path);
+    if (!input.ok()) {
+        stats_ = PlyStats{};
+        error_ = "Could not open file: " + path;
+        return false;
+    }
+    return parse(input.data(), input.size(), data);
+}
+
+bool PlyReader::readText(const std::string& text, PlyData& data) {
+    return parse(text.data(), text.size(), data);
+}
+
+bool PlyReader::parse(const char* begin, std::size_t size, PlyData& data) {
+    core::PerfTimer timer("ply.parse");
+    stats_ = PlyStats{};
+    error_.clear();
+    data = PlyData{};
+    const char* end = begin + size;
+    auto fail = [&](const std::string& message) {
+        error_ = message;
+        data = PlyData{};
+        return false;
+    };
+
+    // Kopf zeilenweise bis end_header
+    std::vector<Element> elements;
+    bool has_format = false;
+    const char* p = begin;
+    bool header_done = false;
+    bool first_line = true;
+    while (p < end && !header_done) {
+        const char* line_end = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        if (!line_end) {
+            return fail("PLY header without end_header");
+        }
+        std::string line(p, line_end);
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        p = line_end + 1;
+        std::vector<std::string> words;
+        for (std::size_t i = 0; i < line.size();) {
+            while (i < line.size() && (line[i] == ' ' || line[i] == '\t')) ++i;
+            std::size_t j = i;
+            while (j < line.size() && line[j] != ' ' && line[j] != '\t') ++j;
+            if (j > i) {
+                words.emplace_back(line, i, j - i);
+            }
+            i = j;
+        }
+        if (first_line) {
+            if (words.size() != 1 || words[0] != "ply") {
+                return fail("Not a PLY file");
+            }
+            first_line = false;
+            continue;
+        }
+        if (words.empty() || words[0] == "comment" || words[0] == "obj_info") {
+            continue;
+        }
+        if (words[0] == "format" && words.size() >= 2) {
+            if (words[1] == "ascii") stats_.format = PlyFormat::Ascii;
+            else if (words[1] == "binary_little_endian") stats_.format = PlyFormat::BinaryLittleEndian;
+            else if (words[1] == "binary_big_endian") stats_.format = PlyFormat::BinaryBigEndian;
+            else return fail("Unknown PLY format: " + words[1]);
+            has_format = true;
+        } else if (words[0] == "element" && words.size() == 3) {
+            Element element;
+            element.name = words[1];
+            const auto result = std::from_chars(words[2].data(), words[2].data() + words[2].size(), element.count);
+            if (result.ec != std::errc()) {
+                return fail("Invalid count in: " + line);
+            }
+            elements.push_back(std::move(element));
+        } else if (words[0] == "property" && !elements.empty()) {
+            Property property;
+            Element& element = elements.back();
+            if (words.size() == 5 && words[1] == "list") {
+                property.list = true;
+                if (!scalarFromName(words[2], property.count_type) || !scalarFromName(words[3], property.type)) {
+                    return fail("Unknown type in: " + line);
+                }
+                property.name = words[4];
+                element.fixed = false;
+            } else if (words.size() == 3 && scalarFromName(words[1], property.type)) {
+                property.name = words[2];
+                property.offset = element.stride;
+                element.stride += scalarSize(property.type);
+            } else {
+                return fail("Invalid property: " + line);
+            }
+            element.properties.push_back(std::move(property));
+        } else if (words[0] == "end_header") {
+            header_done = true;
+        } else {
+            return fail("Unknown header line: " + line);
+        }
+    }
+    if (!header_done || !has_format) {
+        return fail("Incomplete PLY header");
+    }
+
+    const bool binary = stats_.format != PlyFormat::Ascii;
+    const bool swap = binary && ((stats_.format == PlyFormat::BinaryLittleEndian) != hostLittleEndian());
+    Tokens tokens(p, end);
+
+    for (const Element& element : elements) {
+        const bool is_vertex = element.name == "vertex";
+        const bool is_face = element.name == "face";
+        if (!is_vertex && !is_face) {
+            ++stats_.skipped_elements;
+        }
+
+        // Rollen der Punkt-Eigenschaften bzw. Index-Liste der Flächen
+        int roles[RoleCount];
+        std::fill(roles, roles + RoleCount, -1);
+        int index_list = -1;
+        for (std::size_t i = 0; i < element.properties.size(); ++i) {
+            const Property& property = element.properties[i];
+            if (is_vertex && !property.list) {
+                const int role = roleOf(property.name);
+                if (role >= 0 && roles[role] < 0) {
+                    roles[role] = static_cast<int>(i);
+                }
+            } else if (is_face && property.list && index_list < 0 &&
+                       (property.name == "vertex_indices" || property.name == "vertex_index")) {
+                index_list = static_cast<int>(i);
+            }
+        }
+        // Anzahl aus dem Kopf gegen die restlichen Bytes, bevor etwas angelegt wird (jeder Satz ≥ 1 Byte)
+        const std::size_t remaining = static_cast<std::size_t>(end - p);
+        const std::size_t min_record = binary && element.fixed ? element.stride : 1;
+        if (min_record > 0 && element.count > remaining / min_record) {
+            return fail("PLY data truncated (element " + element.name + ": " + std::to_string(element.count) +
+                        " records)");
+        }
+        if (is_vertex) {
+            if (roles[X] < 0 || roles[Y] < 0 || roles[Z] < 0) {
+                return fail("Vertices without x/y/z");
+            }
+            stats_.vertices = element.count;
+            data.mesh.vertices.resize(element.count * 3);
+            if (roles[NX] >= 0 && roles[NY] >= 0 && roles[NZ] >= 0) {
+                data.normals.resize(element.count * 3);
+            }
+            if (roles[Red] >= 0 && roles[Green] >= 0 && roles[Blue] >= 0) {
+                data.colors.resize(element.count * 3);
+            }
+        }
+
+        if (binary && element.fixed) {
+            const std::size_t bytes = element.stride * element.count;
+            if (static_cast<std::size_t>(end - p) < bytes) {
+                return fail("PLY data truncated (element " + element.name + ")");
+            }
+            if (is_vertex) {
+                // Satzlänge fest: Blöcke direkt aus der Sicht parallel umwandeln
+                const char* base = p;
+                const std::size_t stride = element.stride;
+                const std::size_t blocks = (element.count + kVertexBlock - 1) / kVertexBlock;
+                core::ThreadPool& pool = pool_ ? *pool_ : core::ThreadPool::shared();
+                pool.parallelFor(blocks, [&](std::size_t block) {
+                    const std::size_t first = block * kVertexBlock;
+                    const std::size_t last = std::min(first + kVertexBlock, element.count);
+                    for (std::size_t v = first; v < last; ++v) {
+                        const char* record = base + v * stride;
+                        for (int axis = 0; axis < 3; ++axis) {
+                            const Property& property = element.properties[static_cast<std::size_t>(roles[X + axis])];
+                            data.mesh.vertices[v * 3 + axis] = loadReal(record + property.offset, property.type, swap);
+                        }
+                        if (!data.normals.empty()) {
+                            for (int axis = 0; axis < 3; ++axis) {
+                                const Property& property = element.properties[static_cast<std::size_t>(roles[NX + axis])];
+                                data.normals[v * 3 + axis] = loadReal(record + property.offset, property.type, swap);
+                            }
+                        }
+                        if (!data.colors.empty()) {
+                            for (int channel = 0; channel < 3; ++channel) {
+                                const Property& property = element.properties[static_cast<std::size_t>(roles[Red + channel])];
+                                data.colors[v * 3 + channel] =
+                                    colorByte(loadReal(record + property.offset, property.type, swap), property.type);
+                            }
+                        }
+                    }
+                });
+            }
+            p += bytes;
+            continue;
+        }
+
+        // Listen (binär) bzw. ASCII: Satz für Satz
+        std::vector<std::uint32_t> polygon;
+        double values[RoleCount];
+        for (std::size_t item = 0; item < element.count; ++item) {
+            polygon.clear();
+            for (std::size_t i = 0; i < element.properties.size(); ++i) {
+                const Property& property = element.properties[i];
+                if (!property.list) {
+                    double value = 0.0;
+                    if (binary) {
+                        const std::size_t width = scalarSize(property.type);
+                        if (static_cast<std::size_t>(end - p) < width) {
+                            return fail("PLY data truncated (element " + element.name + ")");
+                        }
+                        value = loadReal(p, property.type, swap);
+                        p += width;
+                    } else if (!tokens.real(value)) {
+                        return fail("Invalid value in element " + element.name + " at byte " +
+                                    std::to_string(tokens.position() - begin));
+                    }
+                    if (is_vertex) {
+                        for (int role = 0; role < RoleCount; ++role) {
+                            if (roles[role] == static_cast<int>(i)) {
+                                values[role] = value;
+                            }
+                        }
+                    }
+                    continue;
+                }
+                std::int64_t count = 0;
+                if (binary) {
+                    const std::size_t width = scalarSize(property.count_type);
+                    if (static_cast<std::size_t>(end - p) < width) {
+                        return fail("PLY data truncated (element " + element.name + ")");
+                    }
+                    count = loadInteger(p, property.count_type, swap);
+                    p += width;
+                } else {
+                    double value = 0.0;
+                    if (!tokens.real(value)) {
+                        return fail("Invalid list length in element " + element.name);
+                    }
+                    count = static_cast<std::int64_t>(value);
+                }
+                if (count < 0) {
+                    return fail("Invalid list length in element " + element.name);
+                }
+                const bool keep = static_cast<int>(i) == index_list;
+                const std::size_t width = scalarSize(property.type);
+                if (binary && static_cast<std::uint64_t>(count) > static_cast<std::size_t>(end - p) / width) {
+                    return fail("PLY data truncated (element " + element.name + ")");
+                }
+                for (std::int64_t k = 0; k < count; ++k) {
+                    std::int64_t index = 0;
+                    if (binary) {
+                        index = keep ? loadInteger(p, property.type, swap) : 0;
+                        p += width;
+                    } else {
+                        double value = 0.0;
+                        if (!tokens.real(value)) {
+                            return fail("Invalid list value in element " + element.name);
+                        }
+                        index = static_cast<std::int64_t>(value);
+                    }
+                    if (keep) {
+                        if (index < 0 || static_cast<std::size_t>(index) >= stats_.vertices) {
+                            return fail("Invalid vertex index in face " + std::to_string(item));
+                        }
+                        polygon.push_back(static_cast<std::uint32_t>(index));
+                    }
+                }
+            }
+            if (is_vertex) {
+                for (int axis = 0; axis < 3; ++axis) {
+                    data.mesh.vertices[item * 3 + axis] = values[X + axis];
+                }
+                if (!data.normals.empty()) {
+                    for (int axis = 0; axis < 3; ++axis) {
+                        data.normals[item * 3 + axis] = values[NX + axis];
+                    }
+                }
+                if (!data.colors.empty()) {
+                    for (int channel = 0; channel < 3; ++channel) {
+                        const Property& property = element.properties[static_cast<std::size_t>(roles[Red + channel])];
+                        data.colors[item * 3 + channel] = colorByte(values[Red + channel], property.type);
+                    }
+                }
+            } else if (is_face) {
+                ++stats_.faces;
+                // Fächer ab der ersten Ecke
+                for (std::size_t k = 1; k + 1 < polygon.size(); ++k) {
+                    data.mesh.indices.push_back(polygon[0]);
+                    data.mesh.indices.push_back(polygon[k]);
+                    data.mesh.indices.push_back(polygon[k + 1]);
+                    ++stats_.triangles;
+                }
+            }
+        }
+    }
+    stats_.parse_ms = timer.finish().elapsed_ms;
+    return true;
+}
+
+namespace {
+
+/** Rohwert in Dateireihenfolge anhängen. */
+template <typename T>
+void appendRaw(TextSink& out, T value, bool swap) {
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    if (swap) {
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+    out.text(std::string_view(reinterpret_cast<const char*>(bytes), sizeof(T)));
+}
+
+}  // namespace
+
+bool writePly(const std::string& path, const PlyData& data, const PlyWriteOptions& options, std::string* error) {
+    auto fail = [&](const std::string& message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+    std::ofstream file(path, std::ios::binary);
+    if (path.empty() || !file.is_open()) {
+        return fail("Could not create file: " + path);
+    }
+    const std::size_t count = data.pointCount();
+    const bool with_normals = data.normals.size() == count * 3 && count > 0;
+    const bool with_colors = data.colors.size() == count * 3 && count > 0;
+    const std::size_t triangles = data.mesh.indices.size() / 3;
+    const bool binary = options.format != PlyFormat::Ascii;
+    const bool swap = binary && ((options.format == PlyFormat::BinaryLittleEndian) != hostLittleEndian());
+    const char* real_type = options.double_precision ? "double" : "float";
+
+    TextSink out(file, options.buffer_bytes);
+    out.text("ply\nformat ");
+    out.text(options.format == PlyFormat::Ascii ? "ascii" :
+             options.format == PlyFormat::BinaryLittleEndian ? "binary_little_endian" : "binary_big_endian");
+    out.text(" 1.0\ncomment Hydra CAD\nelement vertex ");
+    out.integer(count);
+    out.text("\n");
+    for (const char* name : {"x", "y", "z"}) {
+        out.text("property ");
+        out.text(real_type);
+        out.put(' ');
+        out.text(name);
+        out.text("\n");
+    }
+    if (with_normals) {
+        for (const char* name : {"nx", "ny", "nz"}) {
+            out.text("property ");
+            out.text(real_type);
+            out.put(' ');
+            out.text(name);
+            out.text("\n");
+        }
+    }
+    if (with_colors) {
+        out.text("property uchar red\nproperty uchar green\nproperty uchar blue\n");
+    }
+    if (triangles > 0) {
+        out.text("element face ");
+        out.integer(triangles);
+        out.text("\nproperty list uchar int vertex_indices\n");
+    }
+    out.text("end_header\n");
+
+    auto real = [&](double value) {
+        if (!binary) {
+            out.real(value);
+        } else if (options.double_precision) {
+            appendRaw<double>(out, value, swap);
+        } else {
+            appendRaw<float>(out, static_cast<float>(value), swap);
+        }
+    };
+    for (std::size_t v = 0; v < count; ++v) {
+        for (int axis = 0; axis < 3; ++axis) {
+            if (!binary && axis > 0) out.put(' ');
+            real(data.mesh.vertices[v * 3 + axis]);
+        }
+        for (int axis = 0; with_normals && axis < 3; ++axis) {
+            if (!binary) out.put(' ');
+            real(data.normals[v * 3 + axis]);
+        }
+        for (int channel = 0; with_colors && channel < 3; ++channel) {
+            if (binary) {
+                appendRaw<std::uint8_t>(out, data.colors[v * 3 + channel], false);
+            } else {
+                out.put(' ');
+                out.integer(data.colors[v * 3 + channel]);
+            }
+        }
+        if (!binary) out.text("\n");
+    }
+    for (std::size_t t = 0; t < triangles; ++t) {
+        if (binary) {
+            appendRaw<std::uint8_t>(out, 3, false);
+            for (int k = 0; k < 3; ++k) {
+                appendRaw<std::int32_t>(out, static_cast<std::int32_t>(data.mesh.indices[t * 3 + k]), swap);
+            }
+        } else {
+            out.put('3');
+            for (int k = 0; k < 3; ++k) {
+                out.put(' ');
+                out.integer(data.mesh.indices[t * 3 + k]);
+            }
+            out.text("\n");
+        }
+    }
+    const bool ok = out.flush();
+    file.close();
+    if (!ok || !file) {
+        return fail("Write failed: " + path);
+    }
+    return true;
+}
+
+}  // namespace interop
+}  // namespace cad
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../core/analysis/TriangleBvh.h"
+
+namespace cad {
+namespace core {
+class ThreadPool;
+}  // namespace core
+
+namespace interop {
+
+enum class PlyFormat {
+    Ascii,
+    BinaryLittleEndian,
+    BinaryBigEndian
+};
+
+/** Netz oder Punktwolke (indices leer); normals/colors je Punkt oder leer. */
+struct PlyData {
+    core::TriangleMesh mesh;
+    /** nx, ny, nz je Punkt. */
+    std::vector<double> normals;
+    /** r, g, b je Punkt (0..255). */
+    std::vector<std::uint8_t> colors;
+
+    std::size_t pointCount() const { return mesh.vertices.size() / 3; }
+    bool isPointCloud() const { return mesh.indices.empty(); }
+};
+
+struct PlyStats {
+    PlyFormat format{PlyFormat::Ascii};
+    std::size_t vertices{0};
+    std::size_t faces{0};
+    std::size_t triangles{0};
+    /** Übersprungene Elemente (z.B. edge, material). */
+    std::size_t skipped_elements{0};
+    double parse_ms{0.0};
+};
+
+/**
+ * PLY-Leser (ASCII, binär little/big endian). Die Datei wird gemappt; das Layout der Elemente wird
+ * einmal aus dem Kopf bestimmt. Binäre Punkte (feste Satzlänge) werden direkt aus der Sicht blockweise
+ * parallel umgewandelt, Flächen (Listen) sequentiell gelesen und als Fächer trianguliert. Dateien nur mit
+ * "element vertex" ergeben eine Punktwolke.
+ */
+class PlyReader {
+public:
+    /** pool == nullptr → ThreadPool::shared(). */
+    void setThreadPool(core::ThreadPool* pool) { pool_ = pool; }
+
+    /** false bei Lesefehler, ungültigem Kopf oder abgeschnittenen Daten (error()). */
+    bool readFile(const std::string& path, PlyData& data);
+    bool readText(const std::string& text, PlyData& data);
+
+    const PlyStats& stats() const { return stats_; }
+    const std::string& error() const { return error_; }
+
+private:
+    bool parse(const char* begin, std::size_t size, PlyData& data);
+
+    core::ThreadPool* pool_{nullptr};
+    PlyStats stats_;
+    std::string error_;
+};
+
+struct PlyWriteOptions {
+    PlyFormat format{PlyFormat::BinaryLittleEndian};
+    /** float (Standard der Scanner) oder double für die Koordinaten. */
+    bool double_precision{false};
+    std::size_t buffer_bytes{4u * 1024 * 1024};
+};
+
+/** Schreibt PlyData; Normalen/Farben nur, wenn je Punkt vorhanden, Flächen nur bei Netzen. */
+bool writePly(const std::string& path, const PlyData& data, const PlyWriteOptions& options = {},
+              std::string* error = nullptr);
+
+}  // namespace interop
+}  // namespace cad
@@ -0,0 +1,392 @@
+#include "StepAssemblyWriter.h"
+#include "TextSink.h"
+#include "../core/perf/PerfSpan.h"
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cad {
+namespace interop {
+
+namespace {
+
+/** TextSink mit Part-21-Schreibweisen für Verweise, Zahlen und Zeichenketten. */
+class StepSink : public TextSink {
+public:
+    using TextSink::TextSink;
+
+    void ref(std::uint32_t id) {
+        put('#');
+        integer(id);
+    }
+
+    /** Kürzeste exakte Darstellung; STEP verlangt den Punkt ("1.", "1.E-07"). */
+    void real(double value) {
+        char digits[32];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        char* end = result.ptr;
+        char* exponent = static_cast<char*>(std::memchr(digits, 'e', static_cast<std::size_t>(end - digits)));
+        if (exponent) {
+            *exponent = 'E';
+        }
+        char* mantissa_end = exponent ? exponent : end;
+        std::string& out = buffer();
+        if (!std::memchr(digits, '.', static_cast<std::size_t>(mantissa_end - digits))) {
+            out.append(digits, mantissa_end);
+            out.push_back('.');
+            out.append(mantissa_end, end);
+        } else {
+            out.append(digits, end);
+        }
+    }
+
+    /** '...' mit '' und \\; Nicht-ASCII als \X2\..\X0\ bzw. \X4\..\X0\, Steuerzeichen als \X\hh. */
+    void string(std::string_view value) {
+        static const char hex[] = "0123456789ABCDEF";
+        std::string& out = buffer();
+        auto hexDigits = [&](std::uint32_t code, int count) {
+            for (int shift = 4 * (count - 1); shift >= 0; shift -= 4) {
+                out.push_back(hex[(code >> shift) & 0xF]);
+            }
+        };
+        out.push_back('\'');
+        for (std::size_t i = 0; i < value.size();) {
+            const unsigned char c = static_cast<unsigned char>(value[i]);
+            if (c >= 0x20 && c < 0x7F) {
+                if (c == '\'' || c == '\\') {
+                    out.push_back(static_cast<char>(c));
+                }
+                out.push_back(static_cast<char>(c));
+                ++i;
+                continue;
+            }
+            std::uint32_t code = 0;
+            std::size_t length = 0;
+            if (c >= 0xC0 && c < 0xE0) {
+                code = c & 0x1F;
+                length = 2;
+            } else if (c >= 0xE0 && c < 0xF0) {
+                code = c & 0x0F;
+                length = 3;
+            } else if (c >= 0xF0 && c < 0xF8) {
+                code = c & 0x07;
+                length = 4;
+            }
+            bool valid = length != 0 && i + length <= value.size();
+            for (std::size_t k = 1; valid && k < length; ++k) {
+                const unsigned char next = static_cast<unsigned char>(value[i + k]);
+                valid = (next & 0xC0) == 0x80;
+                code = (code << 6) | (next & 0x3F);
+            }
+            if (!valid) {
+                out.append("\\X\\");
+                hexDigits(c, 2);
+                ++i;
+                continue;
+            }
+            out.append(code > 0xFFFF ? "\\X4\\" : "\\X2\\");
+            hexDigits(code, code > 0xFFFF ? 8 : 4);
+            out.append("\\X0\\");
+            i += length;
+        }
+        out.push_back('\'');
+    }
+};
+
+/** Produktknoten: geteilte Definition oder Unterbaugruppe. */
+struct ProductIds {
+    std::uint32_t definition{0};
+    std::uint32_t representation{0};
+};
+
+}  // namespace
+
+StepAssemblyWriter::StepAssemblyWriter(StepWriteOptions options) : options_(std::move(options)) {}
+
+bool StepAssemblyWriter::write(const std::string& path, const core::Assembly& assembly) {
+    core::PerfTimer timer("step.write");
+    stats_ = StepWriteStats{};
+    error_.clear();
+    if (path.empty()) {
+        error_ = "No file path specified";
+        return false;
+    }
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        error_ = "Could not create file: " + path;
+        return false;
+    }
+    StepSink out(file, options_.buffer_bytes);
+    const bool ap242 = options_.schema == StepSchema::Ap242;
+
+    std::string filename = path;
+    const std::size_t last_slash = path.find_last_of("/\\");
+    if (last_slash != std::string::npos) {
+        filename = path.substr(last_slash + 1);
+    }
+    const std::time_t now = std::time(nullptr);
+    char time_str[64];
+    std::strftime(time_str, sizeof(time_str), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    out.text("ISO-10303-21;\nHEADER;\nFILE_DESCRIPTION((");
+    out.string(options_.description);
+    out.text("),'2;1');\nFILE_NAME(");
+    out.string(filename);
+    out.text(",'");
+    out.text(time_str);
+    out.text("',('Hydra CAD'),('Hydra CAD'),'Hydra CAD Export','Hydra CAD','');\n");
+    out.text(ap242 ? "FILE_SCHEMA(('AP242_MANAGED_MODEL_BASED_3D_ENGINEERING_MIM_LF { 1 0 10303 442 1 1 4 }'));\n"
+                   : "FILE_SCHEMA(('AUTOMOTIVE_DESIGN'));\n");
+    out.text("ENDSEC;\nDATA;\n");
+
+    std::uint32_t next = 1;
+    auto begin = [&]() {
+        const std::uint32_t id = next++;
+        out.ref(id);
+        out.text("=");
+        return id;
+    };
+
+    // Kontexte, Einheiten (mm, rad), Ursprung
+    const std::uint32_t application = begin();
+    out.text(ap242 ? "APPLICATION_CONTEXT('managed model based 3d engineering');\n"
+                   : "APPLICATION_CONTEXT('automotive design');\n");
+    begin();
+    out.text(ap242 ? "APPLICATION_PROTOCOL_DEFINITION('international standard','ap242_managed_model_based_3d_engineering',2014,"
+                   : "APPLICATION_PROTOCOL_DEFINITION('international standard','automotive_design',2001,");
+    out.ref(application);
+    out.text(");\n");
+    const std::uint32_t product_context = begin();
+    out.text("PRODUCT_CONTEXT('',");
+    out.ref(application);
+    out.text(",'mechanical');\n");
+    const std::uint32_t definition_context = begin();
+    out.text("PRODUCT_DEFINITION_CONTEXT('part definition',");
+    out.ref(application);
+    out.text(",'design');\n");
+    const std::uint32_t length_unit = begin();
+    out.text("(LENGTH_UNIT()NAMED_UNIT(*)SI_UNIT(.MILLI.,.METRE.));\n");
+    const std::uint32_t angle_unit = begin();
+    out.text("(NAMED_UNIT(*)PLANE_ANGLE_UNIT()SI_UNIT($,.RADIAN.));\n");
+    const std::uint32_t solid_angle_unit = begin();
+    out.text("(NAMED_UNIT(*)SI_UNIT($,.STERADIAN.)SOLID_ANGLE_UNIT());\n");
+    const std::uint32_t uncertainty = begin();
+    out.text("UNCERTAINTY_MEASURE_WITH_UNIT(LENGTH_MEASURE(1.E-07),");
+    out.ref(length_unit);
+    out.text(",'distance_accuracy_value','confusion accuracy');\n");
+    const std::uint32_t geometry_context = begin();
+    out.text("(GEOMETRIC_REPRESENTATION_CONTEXT(3)GLOBAL_UNCERTAINTY_ASSIGNED_CONTEXT((");
+    out.ref(uncertainty);
+    out.text("))GLOBAL_UNIT_ASSIGNED_CONTEXT((");
+    out.ref(length_unit);
+    out.text(",");
+    out.ref(angle_unit);
+    out.text(",");
+    out.ref(solid_angle_unit);
+    out.text("))REPRESENTATION_CONTEXT('',''));\n");
+
+    // Richtungen werden über alle Lagen geteilt (Normteile stehen meist achsparallel)
+    std::map<std::array<double, 3>, std::uint32_t> directions;
+    auto direction = [&](double x, double y, double z) {
+        const std::array<double, 3> key{x + 0.0, y + 0.0, z + 0.0};
+        auto it = directions.find(key);
+        if (it != directions.end()) {
+            return it->second;
+        }
+        const std::uint32_t id = begin();
+        out.text("DIRECTION('',(");
+        out.real(key[0]);
+        out.text(",");
+        out.real(key[1]);
+        out.text(",");
+        out.real(key[2]);
+        out.text("));\n");
+        directions.emplace(key, id);
+        return id;
+    };
+    auto placement = [&](const core::Transform& transform) {
+        const core::Quaternion q = core::orientationOf(transform);
+        double ax = 0.0, ay = 0.0, az = 1.0;
+        double rx = 1.0, ry = 0.0, rz = 0.0;
+        core::rotateVector(q, ax, ay, az);
+        core::rotateVector(q, rx, ry, rz);
+        const std::uint32_t axis = direction(ax, ay, az);
+        const std::uint32_t ref = direction(rx, ry, rz);
+        const std::uint32_t point = begin();
+        out.text("CARTESIAN_POINT('',(");
+        out.real(transform.tx);
+        out.text(",");
+        out.real(transform.ty);
+        out.text(",");
+        out.real(transform.tz);
+        out.text("));\n");
+        const std::uint32_t id = begin();
+        out.text("AXIS2_PLACEMENT_3D('',");
+        out.ref(point);
+        out.text(",");
+        out.ref(axis);
+        out.text(",");
+        out.ref(ref);
+        out.text(");\n");
+        return id;
+    };
+    const std::uint32_t origin = placement(core::Transform{});
+
+    // PRODUCT … SHAPE_DEFINITION_REPRESENTATION; items: Ursprung + Lagen der Kinder
+    auto product = [&](const std::string& name, const std::vector<std::uint32_t>& items) {
+        const std::uint32_t product_id = begin();
+        out.text("PRODUCT(");
+        out.string(name);
+        out.text(",");
+        out.string(name);
+        out.text(",'',(");
+        out.ref(product_context);
+        out.text("));\n");
+        const std::uint32_t formation = begin();
+        out.text("PRODUCT_DEFINITION_FORMATION('','',");
+        out.ref(product_id);
+        out.text(");\n");
+        ProductIds ids;
+        ids.definition = begin();
+        out.text("PRODUCT_DEFINITION('design','',");
+        out.ref(formation);
+        out.text(",");
+        out.ref(definition_context);
+        out.text(");\n");
+        const std::uint32_t shape = begin();
+        out.text("PRODUCT_DEFINITION_SHAPE('','',");
+        out.ref(ids.definition);
+        out.text(");\n");
+        ids.representation = begin();
+        out.text("SHAPE_REPRESENTATION(");
+        out.string(name);
+        out.text(",(");
+        out.ref(origin);
+        for (std::uint32_t item : items) {
+            out.text(",");
+            out.ref(item);
+        }
+        out.text("),");
+        out.ref(geometry_context);
+        out.text(");\n");
+        begin();
+        out.text("SHAPE_DEFINITION_REPRESENTATION(");
+        out.ref(shape);
+        out.text(",");
+        out.ref(ids.representation);
+        out.text(");\n");
+        ++stats_.definitions;
+        return ids;
+    };
+
+    const std::vector<core::AssemblyComponent>& components = assembly.components();
+    std::unordered_map<std::uint64_t, std::size_t> index_of;
+    index_of.reserve(components.size());
+    for (std::size_t i = 0; i < components.size(); ++i) {
+        index_of.emplace(components[i].id, i);
+    }
+    // Kinder je Komponente; components.size() = Wurzel
+    std::vector<std::vector<std::size_t>> children(components.size() + 1);
+    std::vector<std::size_t> parent_of(components.size(), components.size());
+    for (std::size_t i = 0; i < components.size(); ++i) {
+        auto it = components[i].parent_id != 0 ? index_of.find(components[i].parent_id) : index_of.end();
+        if (it != index_of.end() && it->second != i) {
+            parent_of[i] = it->second;
+        }
+        children[parent_of[i]].push_back(i);
+    }
+
+    // Geteilte Definitionen der Blätter, je PartRef einmal
+    std::vector<ProductIds> node(components.size() + 1);
+    std::unordered_map<const core::Part*, ProductIds> shared;
+    for (std::size_t i = 0; i < components.size(); ++i) {
+        if (!children[i].empty()) {
+            continue;
+        }
+        const core::Part* definition = &components[i].part.get();
+        auto it = shared.find(definition);
+        if (it == shared.end()) {
+            it = shared.emplace(definition, product(definition->name(), {})).first;
+        }
+        node[i] = it->second;
+    }
+
+    // Unterbaugruppen und Wurzel mit den Lagen ihrer Kinder
+    std::vector<std::uint32_t> placement_of(components.size(), 0);
+    for (std::size_t n = 0; n <= components.size(); ++n) {
+        if (children[n].empty() && n != components.size()) {
+            continue;
+        }
+        std::vector<std::uint32_t> items;
+        items.reserve(children[n].size());
+        for (std::size_t child : children[n]) {
+            placement_of[child] = placement(components[child].transform);
+            items.push_back(placement_of[child]);
+        }
+        node[n] = product(n == components.size() ? std::string("Assembly") : components[n].part->name(), items);
+    }
+
+    // Vorkommen: NAUO + Lage über CONTEXT_DEPENDENT_SHAPE_REPRESENTATION
+    for (std::size_t i = 0; i < components.size(); ++i) {
+        const ProductIds& parent = node[parent_of[i]];
+        const ProductIds& child = node[i];
+        const std::uint32_t transformation = begin();
+        out.text("ITEM_DEFINED_TRANSFORMATION('','',");
+        out.ref(origin);
+        out.text(",");
+        out.ref(placement_of[i]);
+        out.text(");\n");
+        const std::uint32_t occurrence = begin();
+        out.text("NEXT_ASSEMBLY_USAGE_OCCURRENCE('");
+        out.integer(components[i].id);
+        out.text("',");
+        out.string(components[i].part->name());
+        out.text(",'',");
+        out.ref(parent.definition);
+        out.text(",");
+        out.ref(child.definition);
+        out.text(",$);\n");
+        const std::uint32_t shape = begin();
+        out.text("PRODUCT_DEFINITION_SHAPE('','',");
+        out.ref(occurrence);
+        out.text(");\n");
+        const std::uint32_t relationship = begin();
+        out.text("(REPRESENTATION_RELATIONSHIP('','',");
+        out.ref(child.representation);
+        out.text(",");
+        out.ref(parent.representation);
+        out.text(")REPRESENTATION_RELATIONSHIP_WITH_TRANSFORMATION(");
+        out.ref(transformation);
+        out.text(")SHAPE_REPRESENTATION_RELATIONSHIP());\n");
+        begin();
+        out.text("CONTEXT_DEPENDENT_SHAPE_REPRESENTATION(");
+        out.ref(relationship);
+        out.text(",");
+        out.ref(shape);
+        out.text(");\n");
+        ++stats_.instances;
+    }
+
+    out.text("ENDSEC;\nEND-ISO-10303-21;\n");
+    const bool ok = out.flush();
+    file.close();
+    stats_.entities = next - 1;
+    stats_.bytes = out.bytes();
+    stats_.write_ms = timer.finish().elapsed_ms;
+    if (!ok || !file) {
+        error_ = "Write failed: " + path;
+        return false;
+    }
+    return true;
+}
+
+}  // namespace interop
+}  // namespace cad
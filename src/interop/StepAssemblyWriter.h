@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "../core/Modeler/Assembly.h"
+
+namespace cad {
+namespace interop {
+
+enum class StepSchema {
+    /** AUTOMOTIVE_DESIGN */
+    Ap214,
+    /** AP242_MANAGED_MODEL_BASED_3D_ENGINEERING_MIM_LF */
+    Ap242
+};
+
+struct StepWriteOptions {
+    StepSchema schema{StepSchema::Ap214};
+    /** Puffergröße vor dem Schreiben in die Datei. */
+    std::size_t buffer_bytes{4u * 1024 * 1024};
+    std::string description{"Hydra CAD Export"};
+};
+
+struct StepWriteStats {
+    /** Geschriebene Produktdefinitionen (geteilte Teile + Unterbaugruppen) bzw. Vorkommen (NAUO). */
+    std::size_t definitions{0};
+    std::size_t instances{0};
+    std::size_t entities{0};
+    std::size_t bytes{0};
+    double write_ms{0.0};
+};
+
+/**
+ * Schreibt eine Baugruppe als STEP-Produktstruktur (AP214/AP242) in einem Durchlauf: jede geteilte
+ * Part-Definition (PartRef) wird genau einmal als PRODUCT/PRODUCT_DEFINITION/SHAPE_REPRESENTATION
+ * ausgegeben, jede Komponente als NEXT_ASSEMBLY_USAGE_OCCURRENCE mit CONTEXT_DEPENDENT_SHAPE_REPRESENTATION
+ * und ITEM_DEFINED_TRANSFORMATION auf ihre Lage. Komponenten mit Kindern (parent_id) werden eigene
+ * Unterbaugruppen-Produkte. Gleiche Richtungen werden geteilt, Zahlen über std::to_chars formatiert,
+ * die Ausgabe läuft über einen großen Puffer.
+ */
+class StepAssemblyWriter {
+public:
+    explicit StepAssemblyWriter(StepWriteOptions options = {});
+
+    /** false bei Schreibfehler (error()). */
+    bool write(const std::string& path, const core::Assembly& assembly);
+
+    const StepWriteStats& stats() const { return stats_; }
+    const std::string& error() const { return error_; }
+
+private:
+    StepWriteOptions options_;
+    StepWriteStats stats_;
+    std::string error_;
+};
+
+}  // namespace interop
+}  // namespace cad
@@ -0,0 +1,512 @@
+#include "StepBrepTranslator.h"
+#include "../core/parallel/ThreadPool.h"
+#include "../core/perf/PerfSpan.h"
+#include "../core/kernel/geometry3d/Circle3D.h"
+#include "../core/kernel/geometry3d/CylinderSurface.h"
+#include "../core/kernel/geometry3d/Line3D.h"
+#include "../core/kernel/geometry3d/PlaneSurface.h"
+#include "../core/kernel/geometry3d/SphereSurface.h"
+#include "../core/kernel/topology/Edge.h"
+#include "../core/kernel/topology/Face.h"
+#include "../core/kernel/topology/Loop.h"
+#include "../core/kernel/topology/Shell.h"
+#include "../core/kernel/topology/Solid.h"
+#include "../core/kernel/topology/Vertex.h"
+#include "../core/kernel/topology/Wire.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+namespace cad {
+namespace interop {
+
+namespace {
+
+using kernel::math::Point3;
+using kernel::math::Vector3;
+
+constexpr double kTwoPi = 2.0 * 3.14159265358979323846;
+
+/** Lage eines AXIS2_PLACEMENT_3D; axis und ref normiert und orthogonal. */
+struct Placement {
+    Point3 origin{0.0, 0.0, 0.0};
+    Vector3 axis{0.0, 0.0, 1.0};
+    Vector3 ref{1.0, 0.0, 0.0};
+};
+
+bool isType(const StepEntity* entity, std::string_view type) {
+    return entity && entity->type == type;
+}
+
+bool readTriple(std::string_view list, Vector3& value) {
+    const std::vector<std::string_view> items = StepFileParser::splitList(list);
+    if (items.size() < 2) {
+        return false;
+    }
+    double xyz[3] = {0.0, 0.0, 0.0};
+    for (std::size_t i = 0; i < items.size() && i < 3; ++i) {
+        if (!StepFileParser::asReal(items[i], xyz[i])) {
+            return false;
+        }
+    }
+    value = Vector3(xyz[0], xyz[1], xyz[2]);
+    return true;
+}
+
+/** Eigenschaft als Referenz auf eine Instanz der Datei. */
+const StepEntity* resolve(const StepFileParser& parser, std::string_view parameter) {
+    std::uint32_t id = 0;
+    return StepFileParser::asReference(parameter, id) ? parser.find(id) : nullptr;
+}
+
+bool readPoint(const StepFileParser& parser, std::string_view parameter, Point3& point) {
+    const StepEntity* entity = resolve(parser, parameter);
+    return isType(entity, "CARTESIAN_POINT") && readTriple(entity->parameter(1), point);
+}
+
+bool readDirection(const StepFileParser& parser, std::string_view parameter, Vector3& direction) {
+    const StepEntity* entity = resolve(parser, parameter);
+    if (!isType(entity, "DIRECTION") || !readTriple(entity->parameter(1), direction)) {
+        return false;
+    }
+    if (direction.length() <= 0.0) {
+        return false;
+    }
+    direction = direction.normalized();
+    return true;
+}
+
+bool readPlacement(const StepFileParser& parser, std::string_view parameter, Placement& placement) {
+    const StepEntity* entity = resolve(parser, parameter);
+    if (!isType(entity, "AXIS2_PLACEMENT_3D") || !readPoint(parser, entity->parameter(1), placement.origin)) {
+        return false;
+    }
+    // axis und ref_direction sind optional ($)
+    readDirection(parser, entity->parameter(2), placement.axis);
+    Vector3 ref = std::abs(placement.axis.x) < 0.9 ? Vector3(1.0, 0.0, 0.0) : Vector3(0.0, 1.0, 0.0);
+    readDirection(parser, entity->parameter(3), ref);
+    ref = ref - placement.axis * ref.dot(placement.axis);
+    if (ref.length() < 1e-12) {
+        ref = std::abs(placement.axis.x) < 0.9 ? Vector3(1.0, 0.0, 0.0) : Vector3(0.0, 1.0, 0.0);
+        ref = ref - placement.axis * ref.dot(placement.axis);
+    }
+    placement.ref = ref.normalized();
+    return true;
+}
+
+bool readFlag(std::string_view parameter, bool fallback) {
+    std::string_view value;
+    if (!StepFileParser::asEnumeration(parameter, value)) {
+        return fallback;
+    }
+    return value != "F";
+}
+
+/** Kurve ohne Flächenbezug: SURFACE_CURVE/SEAM_CURVE(name, curve_3d, ...) auspacken. */
+const StepEntity* curveGeometry(const StepFileParser& parser, const StepEntity* curve) {
+    for (int depth = 0; depth < 4 && curve; ++depth) {
+        if (curve->type != "SURFACE_CURVE" && curve->type != "SEAM_CURVE" && curve->type != "INTERSECTION_CURVE") {
+            return curve;
+        }
+        curve = resolve(parser, curve->parameter(1));
+    }
+    return curve;
+}
+
+/** Ebene durch ein Polygon (Newell-Normale); Drehsinn = Normale. */
+std::shared_ptr<kernel::geometry3d::Surface> fitPlane(const std::vector<Point3>& ring) {
+    if (ring.size() < 3) {
+        return nullptr;
+    }
+    Vector3 normal;
+    Point3 centroid;
+    for (std::size_t i = 0; i < ring.size(); ++i) {
+        const Point3& a = ring[i];
+        const Point3& b = ring[(i + 1) % ring.size()];
+        normal = normal + Vector3((a.y - b.y) * (a.z + b.z), (a.z - b.z) * (a.x + b.x), (a.x - b.x) * (a.y + b.y));
+        centroid = centroid + a;
+    }
+    if (normal.length() < 1e-12) {
+        return nullptr;
+    }
+    normal = normal.normalized();
+    centroid = centroid * (1.0 / static_cast<double>(ring.size()));
+    Vector3 u = std::abs(normal.x) < 0.9 ? Vector3(1.0, 0.0, 0.0) : Vector3(0.0, 1.0, 0.0);
+    u = (u - normal * u.dot(normal)).normalized();
+    return std::make_shared<kernel::geometry3d::PlaneSurface>(centroid, u, normal.cross(u));
+}
+
+/** Ebene bzw. Kugel einer Fläche; Ebenen in beiden Richtungen (Flächenrichtung entgegen → gedreht). */
+struct SurfacePair {
+    std::shared_ptr<kernel::geometry3d::Surface> along;
+    std::shared_ptr<kernel::geometry3d::Surface> against;
+};
+
+}  // namespace
+
+/** Memo einer Instanz; value ist erst nach ready gültig. */
+struct StepBrepTranslator::Slot {
+    std::once_flag once;
+    std::atomic<bool> ready{false};
+    std::shared_ptr<void> value;
+};
+
+/** Kante in beiden Durchlaufrichtungen; hält die Kurve, auf die beide Edge-Objekte zeigen. */
+struct StepBrepTranslator::EdgeRecord {
+    std::shared_ptr<kernel::geometry3d::Curve3D> curve;
+    std::shared_ptr<kernel::topology::Edge> forward;
+    std::shared_ptr<kernel::topology::Edge> reversed;
+};
+
+/** Speicher eines Körpers; das zurückgegebene Solid teilt sich die Lebensdauer (Aliasing). */
+struct StepBrepTranslator::SolidHolder {
+    kernel::topology::Solid solid;
+    std::vector<std::shared_ptr<const EdgeRecord>> edges;
+};
+
+StepBrepTranslator::StepBrepTranslator(const StepFileParser& parser, core::ThreadPool* pool)
+    : parser_(parser),
+      pool_(pool),
+      slots_(std::make_unique<Slot[]>(parser.getEntities().size())) {}
+
+StepBrepTranslator::~StepBrepTranslator() = default;
+
+template <typename T, typename Build>
+std::shared_ptr<T> StepBrepTranslator::memo(const StepEntity& entity, Build build) {
+    Slot& slot = slots_[static_cast<std::size_t>(&entity - parser_.getEntities().data())];
+    if (slot.ready.load(std::memory_order_acquire)) {
+        shared_hits_.fetch_add(1, std::memory_order_relaxed);
+        return std::static_pointer_cast<T>(slot.value);
+    }
+    // Wer nicht selbst gebaut hat, zählt als Treffer (auch beim Warten auf einen anderen Thread)
+    bool built = false;
+    std::call_once(slot.once, [&]() {
+        slot.value = build();
+        slot.ready.store(true, std::memory_order_release);
+        built = true;
+    });
+    if (!built) {
+        shared_hits_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return std::static_pointer_cast<T>(slot.value);
+}
+
+std::vector<StepSolid> StepBrepTranslator::translate() {
+    core::PerfTimer timer("step.brep");
+    std::vector<const StepEntity*> breps;
+    for (const StepEntity& entity : parser_.getEntities()) {
+        if (entity.type == "MANIFOLD_SOLID_BREP" || entity.type == "BREP_WITH_VOIDS") {
+            breps.push_back(&entity);
+        }
+    }
+    std::vector<StepSolid> results(breps.size());
+    std::vector<char> ok(breps.size(), 0);
+    core::ThreadPool& pool = pool_ ? *pool_ : core::ThreadPool::shared();
+    pool.parallelFor(breps.size(), [&](std::size_t i) { ok[i] = translateEntity(*breps[i], results[i]) ? 1 : 0; });
+
+    std::vector<StepSolid> solids;
+    solids.reserve(breps.size());
+    for (std::size_t i = 0; i < breps.size(); ++i) {
+        if (ok[i]) {
+            solids.push_back(std::move(results[i]));
+        }
+    }
+    solids_ += solids.size();
+    translate_ms_ += timer.finish().elapsed_ms;
+    return solids;
+}
+
+bool StepBrepTranslator::translateSolid(std::uint32_t id, StepSolid& solid) {
+    const StepEntity* entity = parser_.find(id);
+    if (!entity || (entity->type != "MANIFOLD_SOLID_BREP" && entity->type != "BREP_WITH_VOIDS")) {
+        return false;
+    }
+    core::PerfTimer timer("step.brep");
+    const bool ok = translateEntity(*entity, solid);
+    solids_ += ok ? 1 : 0;
+    translate_ms_ += timer.finish().elapsed_ms;
+    return ok;
+}
+
+StepBrepStats StepBrepTranslator::stats() const {
+    StepBrepStats stats;
+    stats.solids = solids_;
+    stats.failed_solids = failed_.load();
+    stats.faces = faces_.load();
+    stats.edges = edges_.load();
+    stats.vertices = vertices_.load();
+    stats.shared_hits = shared_hits_.load();
+    stats.approximated_curves = approximated_curves_.load();
+    stats.approximated_surfaces = approximated_surfaces_.load();
+    stats.translate_ms = translate_ms_;
+    return stats;
+}
+
+bool StepBrepTranslator::translateEntity(const StepEntity& entity, StepSolid& solid) {
+    auto holder = std::make_shared<SolidHolder>();
+    // MANIFOLD_SOLID_BREP(name, outer); BREP_WITH_VOIDS(name, outer, (voids))
+    std::uint32_t outer_id = 0;
+    std::shared_ptr<kernel::topology::Shell> outer;
+    if (StepFileParser::asReference(entity.parameter(1), outer_id)) {
+        outer = shell(outer_id, *holder);
+    }
+    if (!outer || outer->faces().empty()) {
+        failed_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    holder->solid.setOuterShell(outer);
+    if (entity.type == "BREP_WITH_VOIDS") {
+        for (std::string_view item : StepFileParser::splitList(entity.parameter(2))) {
+            std::uint32_t void_id = 0;
+            if (StepFileParser::asReference(item, void_id)) {
+                if (auto inner = shell(void_id, *holder)) {
+                    holder->solid.addInnerShell(inner);
+                }
+            }
+        }
+    }
+    std::sort(holder->edges.begin(), holder->edges.end());
+    holder->edges.erase(std::unique(holder->edges.begin(), holder->edges.end()), holder->edges.end());
+
+    solid.id = entity.id;
+    if (!StepFileParser::asString(entity.parameter(0), solid.name) || solid.name.empty()) {
+        solid.name = "Solid_" + std::to_string(entity.id);
+    }
+    solid.solid = std::shared_ptr<kernel::topology::Solid>(holder, &holder->solid);
+    return true;
+}
+
+std::shared_ptr<kernel::topology::Shell> StepBrepTranslator::shell(std::uint32_t id, SolidHolder& holder) {
+    const StepEntity* entity = parser_.find(id);
+    // ORIENTED_CLOSED_SHELL(name, *, shell, orientation): Flächen der Basis-Hülle
+    for (int depth = 0; depth < 4 && entity && entity->type == "ORIENTED_CLOSED_SHELL"; ++depth) {
+        entity = resolve(parser_, entity->parameter(2));
+    }
+    if (!isType(entity, "CLOSED_SHELL") && !isType(entity, "OPEN_SHELL")) {
+        return nullptr;
+    }
+    auto result = std::make_shared<kernel::topology::Shell>();
+    for (std::string_view item : StepFileParser::splitList(entity->parameter(1))) {
+        const StepEntity* face_entity = resolve(parser_, item);
+        if (!face_entity) {
+            continue;
+        }
+        if (auto built = face(*face_entity, holder)) {
+            result->addFace(built);
+            faces_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    return result;
+}
+
+std::shared_ptr<kernel::topology::Face> StepBrepTranslator::face(const StepEntity& entity, SolidHolder& holder) {
+    // ADVANCED_FACE/FACE_SURFACE(name, (bounds), surface, same_sense)
+    if (entity.type != "ADVANCED_FACE" && entity.type != "FACE_SURFACE") {
+        return nullptr;
+    }
+    std::shared_ptr<kernel::topology::Loop> outer;
+    std::vector<std::shared_ptr<kernel::topology::Loop>> inner;
+    std::vector<Point3> outer_ring;
+    for (std::string_view item : StepFileParser::splitList(entity.parameter(1))) {
+        // FACE_OUTER_BOUND/FACE_BOUND(name, loop, orientation)
+        const StepEntity* bound = resolve(parser_, item);
+        if (!isType(bound, "FACE_OUTER_BOUND") && !isType(bound, "FACE_BOUND")) {
+            continue;
+        }
+        const StepEntity* loop = resolve(parser_, bound->parameter(1));
+        if (!isType(loop, "EDGE_LOOP")) {
+            // VERTEX_LOOP (z.B. Kegelspitze): keine Kante
+            continue;
+        }
+        const bool bound_sense = readFlag(bound->parameter(2), true);
+        std::vector<std::shared_ptr<kernel::topology::Edge>> edges;
+        for (std::string_view oriented_item : StepFileParser::splitList(loop->parameter(1))) {
+            // ORIENTED_EDGE(name, *, *, edge_element, orientation)
+            const StepEntity* oriented = resolve(parser_, oriented_item);
+            if (!isType(oriented, "ORIENTED_EDGE")) {
+                continue;
+            }
+            std::uint32_t edge_id = 0;
+            if (!StepFileParser::asReference(oriented->parameter(3), edge_id)) {
+                continue;
+            }
+            std::shared_ptr<const EdgeRecord> record = edge(edge_id);
+            if (!record) {
+                continue;
+            }
+            holder.edges.push_back(record);
+            const bool along = readFlag(oriented->parameter(4), true) == bound_sense;
+            edges.push_back(along ? record->forward : record->reversed);
+        }
+        if (edges.empty()) {
+            continue;
+        }
+        if (!bound_sense) {
+            std::reverse(edges.begin(), edges.end());
+        }
+        auto wire = std::make_shared<kernel::topology::Wire>();
+        for (auto& e : edges) {
+            wire->addEdge(e);
+        }
+        auto built = std::make_shared<kernel::topology::Loop>(wire);
+        if (!outer && bound->type == "FACE_OUTER_BOUND") {
+            outer = built;
+            for (const auto& e : edges) {
+                outer_ring.push_back(e->startVertex()->point());
+            }
+        } else {
+            inner.push_back(built);
+        }
+    }
+    if (!outer && !inner.empty()) {
+        // Ohne FACE_OUTER_BOUND: erste Schleife außen
+        outer = inner.front();
+        inner.erase(inner.begin());
+        for (const auto& e : outer->wire()->edges()) {
+            outer_ring.push_back(e->startVertex()->point());
+        }
+    }
+    if (!outer) {
+        return nullptr;
+    }
+
+    const bool same_sense = readFlag(entity.parameter(3), true);
+    std::shared_ptr<kernel::geometry3d::Surface> surface;
+    const StepEntity* surface_entity = resolve(parser_, entity.parameter(2));
+    Placement placement;
+    double radius = 0.0;
+    if (isType(surface_entity, "CYLINDRICAL_SURFACE") && readPlacement(parser_, surface_entity->parameter(1), placement) &&
+        StepFileParser::asReal(surface_entity->parameter(2), radius)) {
+        // v-Bereich je Fläche aus den Randpunkten (CylinderSurface beginnt bei v = 0)
+        double v_min = 0.0;
+        double v_max = 0.0;
+        for (std::size_t i = 0; i < outer_ring.size(); ++i) {
+            const double v = (outer_ring[i] - placement.origin).dot(placement.axis);
+            v_min = i == 0 ? v : std::min(v_min, v);
+            v_max = i == 0 ? v : std::max(v_max, v);
+        }
+        auto cylinder = std::make_shared<kernel::geometry3d::CylinderSurface>(
+            placement.origin + placement.axis * v_min, placement.axis, radius);
+        cylinder->setVMax(std::max(v_max - v_min, 0.0));
+        surface = cylinder;
+    } else if (surface_entity) {
+        surface = sharedSurface(*surface_entity, same_sense);
+    }
+    if (!surface) {
+        surface = fitPlane(outer_ring);
+        approximated_surfaces_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return std::make_shared<kernel::topology::Face>(surface, outer, std::move(inner), entity.id);
+}
+
+std::shared_ptr<kernel::geometry3d::Surface> StepBrepTranslator::sharedSurface(const StepEntity& entity, bool same_sense) {
+    if (entity.type != "PLANE" && entity.type != "SPHERICAL_SURFACE") {
+        return nullptr;
+    }
+    std::shared_ptr<SurfacePair> pair = memo<SurfacePair>(entity, [&]() -> std::shared_ptr<SurfacePair> {
+        Placement placement;
+        if (!readPlacement(parser_, entity.parameter(1), placement)) {
+            return nullptr;
+        }
+        auto result = std::make_shared<SurfacePair>();
+        if (entity.type == "PLANE") {
+            const Vector3 v = placement.axis.cross(placement.ref);
+            result->along = std::make_shared<kernel::geometry3d::PlaneSurface>(placement.origin, placement.ref, v);
+            result->against = std::make_shared<kernel::geometry3d::PlaneSurface>(placement.origin, v, placement.ref);
+            return result;
+        }
+        double radius = 0.0;
+        if (!StepFileParser::asReal(entity.parameter(2), radius)) {
+            return nullptr;
+        }
+        // Kugel ohne Orientierung: beide Richtungen teilen sich die Fläche
+        result->along = std::make_shared<kernel::geometry3d::SphereSurface>(placement.origin, radius);
+        result->against = result->along;
+        return result;
+    });
+    if (!pair) {
+        return nullptr;
+    }
+    return same_sense ? pair->along : pair->against;
+}
+
+std::shared_ptr<const StepBrepTranslator::EdgeRecord> StepBrepTranslator::edge(std::uint32_t id) {
+    const StepEntity* entity = parser_.find(id);
+    if (!isType(entity, "EDGE_CURVE")) {
+        return nullptr;
+    }
+    return memo<EdgeRecord>(*entity, [&]() -> std::shared_ptr<EdgeRecord> {
+        // EDGE_CURVE(name, start, end, curve, same_sense)
+        std::uint32_t start_id = 0;
+        std::uint32_t end_id = 0;
+        if (!StepFileParser::asReference(entity->parameter(1), start_id) ||
+            !StepFileParser::asReference(entity->parameter(2), end_id)) {
+            return nullptr;
+        }
+        std::shared_ptr<kernel::topology::Vertex> start = vertex(start_id);
+        std::shared_ptr<kernel::topology::Vertex> end = vertex(end_id);
+        if (!start || !end) {
+            return nullptr;
+        }
+        auto record = std::make_shared<EdgeRecord>();
+        const bool same_sense = readFlag(entity->parameter(4), true);
+        const StepEntity* curve = curveGeometry(parser_, resolve(parser_, entity->parameter(3)));
+        double t0 = 0.0;
+        double t1 = 1.0;
+        std::shared_ptr<kernel::geometry3d::Circle3D> arc = isType(curve, "CIRCLE") ? circle(*curve) : nullptr;
+        if (arc) {
+            // Kreisparameter aus den Ecken; Kurvenrichtung entgegen (same_sense = F) → fallend
+            t0 = arc->parameterOf(start->point());
+            const double t_end = arc->parameterOf(end->point());
+            double sweep = same_sense ? t_end - t0 : t0 - t_end;
+            if (sweep <= 1e-12) {
+                sweep += kTwoPi;
+            }
+            t1 = same_sense ? t0 + sweep : t0 - sweep;
+            record->curve = arc;
+        } else {
+            // LINE exakt als Strecke zwischen den Ecken, alles andere als Sehne
+            if (!isType(curve, "LINE")) {
+                approximated_curves_.fetch_add(1, std::memory_order_relaxed);
+            }
+            record->curve = std::make_shared<kernel::geometry3d::Line3D>(start->point(), end->point());
+        }
+        record->forward = std::make_shared<kernel::topology::Edge>(start, end, record->curve.get(), t0, t1, entity->id);
+        record->reversed = std::make_shared<kernel::topology::Edge>(end, start, record->curve.get(), t1, t0, entity->id);
+        edges_.fetch_add(1, std::memory_order_relaxed);
+        return record;
+    });
+}
+
+std::shared_ptr<kernel::topology::Vertex> StepBrepTranslator::vertex(std::uint32_t id) {
+    const StepEntity* entity = parser_.find(id);
+    if (!isType(entity, "VERTEX_POINT")) {
+        return nullptr;
+    }
+    return memo<kernel::topology::Vertex>(*entity, [&]() -> std::shared_ptr<kernel::topology::Vertex> {
+        // VERTEX_POINT(name, point)
+        Point3 point;
+        if (!readPoint(parser_, entity->parameter(1), point)) {
+            return nullptr;
+        }
+        vertices_.fetch_add(1, std::memory_order_relaxed);
+        return std::make_shared<kernel::topology::Vertex>(point, entity->id);
+    });
+}
+
+std::shared_ptr<kernel::geometry3d::Circle3D> StepBrepTranslator::circle(const StepEntity& entity) {
+    return memo<kernel::geometry3d::Circle3D>(entity, [&]() -> std::shared_ptr<kernel::geometry3d::Circle3D> {
+        // CIRCLE(name, position, radius)
+        Placement placement;
+        double radius = 0.0;
+        if (!readPlacement(parser_, entity.parameter(1), placement) ||
+            !StepFileParser::asReal(entity.parameter(2), radius) || radius <= 0.0) {
+            return nullptr;
+        }
+        return std::make_shared<kernel::geometry3d::Circle3D>(placement.origin, radius, placement.axis);
+    });
+}
+
+}  // namespace interop
+}  // namespace cad
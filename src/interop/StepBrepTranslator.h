@@ -0,0 +1,114 @@
+#pragma once
+
+#include "StepFileParser.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cad {
+namespace core {
+class ThreadPool;
+}  // namespace core
+
+namespace kernel {
+namespace geometry3d {
+class Circle3D;
+class Surface;
+}  // namespace geometry3d
+namespace topology {
+class Face;
+class Shell;
+class Solid;
+class Vertex;
+}  // namespace topology
+}  // namespace kernel
+
+namespace interop {
+
+struct StepSolid {
+    /** Id der MANIFOLD_SOLID_BREP- bzw. BREP_WITH_VOIDS-Instanz. */
+    std::uint32_t id{0};
+    std::string name;
+    /** Hält auch die Kurven seiner Kanten am Leben (Edge speichert nur einen Zeiger). */
+    std::shared_ptr<kernel::topology::Solid> solid;
+};
+
+struct StepBrepStats {
+    std::size_t solids{0};
+    /** B-reps ohne verwertbare Hülle. */
+    std::size_t failed_solids{0};
+    std::size_t faces{0};
+    /** Verschiedene EDGE_CURVE- bzw. VERTEX_POINT-Instanzen. */
+    std::size_t edges{0};
+    std::size_t vertices{0};
+    /** Verweise auf bereits übersetzte Geometrie (Kanten, Ecken, Kreise, Flächen). */
+    std::size_t shared_hits{0};
+    /** Nicht unterstützte Kurven als Sehne, Flächen als Ebene durch die Randpunkte. */
+    std::size_t approximated_curves{0};
+    std::size_t approximated_surfaces{0};
+    double parse_ms{0.0};
+    double translate_ms{0.0};
+};
+
+/**
+ * Übersetzt B-rep-Graphen aus STEP (MANIFOLD_SOLID_BREP, BREP_WITH_VOIDS, z.B. Elemente einer
+ * ADVANCED_BREP_SHAPE_REPRESENTATION) in topology::Solid: Punkte, Richtungen, Lagen, Kurven (LINE,
+ * CIRCLE, SURFACE_CURVE/SEAM_CURVE), Flächen (PLANE, CYLINDRICAL_SURFACE, SPHERICAL_SURFACE), Kanten,
+ * Schleifen, Flächen, Hüllen. Unabhängige Körper laufen parallel; Ecken, Kanten, Kreise und Flächen
+ * werden je Instanz genau einmal erzeugt und von allen Verweisen geteilt (auch über Körper hinweg),
+ * ShapeIds sind die STEP-Ids. Der Parser muss die Übersetzung überleben.
+ */
+class StepBrepTranslator {
+public:
+    /** pool == nullptr → ThreadPool::shared(). */
+    explicit StepBrepTranslator(const StepFileParser& parser, core::ThreadPool* pool = nullptr);
+    ~StepBrepTranslator();
+    StepBrepTranslator(const StepBrepTranslator&) = delete;
+    StepBrepTranslator& operator=(const StepBrepTranslator&) = delete;
+
+    /** Alle Körper in Dateireihenfolge (fehlgeschlagene fehlen, siehe stats()). */
+    std::vector<StepSolid> translate();
+    /** Einzelner Körper; false, wenn id kein B-rep ist oder keine Fläche liefert. */
+    bool translateSolid(std::uint32_t id, StepSolid& solid);
+
+    StepBrepStats stats() const;
+
+private:
+    struct Slot;
+    struct EdgeRecord;
+    struct SolidHolder;
+
+    /** Ergebnis je Instanz genau einmal bauen (thread-sicher), weitere Verweise zählen als Treffer. */
+    template <typename T, typename Build>
+    std::shared_ptr<T> memo(const StepEntity& entity, Build build);
+
+    bool translateEntity(const StepEntity& entity, StepSolid& solid);
+    std::shared_ptr<kernel::topology::Shell> shell(std::uint32_t id, SolidHolder& holder);
+    std::shared_ptr<kernel::topology::Face> face(const StepEntity& entity, SolidHolder& holder);
+    std::shared_ptr<const EdgeRecord> edge(std::uint32_t id);
+    std::shared_ptr<kernel::topology::Vertex> vertex(std::uint32_t id);
+    std::shared_ptr<kernel::geometry3d::Circle3D> circle(const StepEntity& entity);
+    /** Analytische Fläche (Ebene in Flächenrichtung bzw. gedreht, Kugel); nullptr → Aufrufer nähert an. */
+    std::shared_ptr<kernel::geometry3d::Surface> sharedSurface(const StepEntity& entity, bool same_sense);
+
+    const StepFileParser& parser_;
+    core::ThreadPool* pool_{nullptr};
+    /** Je Instanz des Parsers (Index in getEntities()). */
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<std::size_t> failed_{0};
+    std::atomic<std::size_t> faces_{0};
+    std::atomic<std::size_t> edges_{0};
+    std::atomic<std::size_t> vertices_{0};
+    std::atomic<std::size_t> shared_hits_{0};
+    std::atomic<std::size_t> approximated_curves_{0};
+    std::atomic<std::size_t> approximated_surfaces_{0};
+    std::size_t solids_{0};
+    double translate_ms_{0.0};
+};
+
+}  // namespace interop
+}  // namespace cad
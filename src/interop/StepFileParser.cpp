@@ -1,115 +1,787 @@
 #include "StepFileParser.h"
+#include "MappedFile.h"
+#include "../core/parallel/ThreadPool.h"
 
-#include <fstream>
-#include <sstream>
 #include <algorithm>
-#include <cctype>
+#include <charconv>
+#include <cstring>
 
 namespace cad {
 namespace interop {
 
-bool StepFileParser::parseFile(const std::string& path) {
-    std::ifstream file(path);
-    if (!file.is_open()) {
+namespace {
+
+enum class Scan { Ok, Incomplete, Error };
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f' || c == '\v';
+}
+
+inline bool isKeywordStart(char c) {
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_' || c == '!';
+}
+
+inline bool isKeywordChar(char c) {
+    return isKeywordStart(c) || (c >= '0' && c <= '9') || c == '-';
+}
+
+std::string_view trim(const char* begin, const char* end) {
+    while (begin < end && isSpace(*begin)) ++begin;
+    while (end > begin && isSpace(end[-1])) --end;
+    return std::string_view(begin, static_cast<std::size_t>(end - begin));
+}
+
+std::string_view trim(std::string_view text) {
+    return trim(text.data(), text.data() + text.size());
+}
+
+/** p auf dem Kommentaranfang: hinter das Kommentarende; false, wenn es vor end nicht kommt. */
+bool skipComment(const char*& p, const char* end) {
+    for (const char* q = p + 2; q + 1 < end; ++q) {
+        q = static_cast<const char*>(std::memchr(q, '*', static_cast<std::size_t>(end - q)));
+        if (!q || q + 1 >= end) {
+            return false;
+        }
+        if (q[1] == '/') {
+            p = q + 2;
+            return true;
+        }
+    }
+    return false;
+}
+
+/** Leerraum und Kommentare; false, wenn ein Kommentar über end hinausläuft. */
+bool skipBlank(const char*& p, const char* end) {
+    while (p < end) {
+        if (isSpace(*p)) {
+            ++p;
+        } else if (*p == '/' && p + 1 < end && p[1] == '*') {
+            if (!skipComment(p, end)) {
+                return false;
+            }
+        } else {
+            break;
+        }
+    }
+    return true;
+}
+
+/** p auf dem öffnenden Zeichen von '..' bzw. "..": hinter das schließende ('' ist ein Zeichen). */
+bool skipQuoted(const char*& p, const char* end) {
+    const char quote = *p;
+    const char* q = p + 1;
+    for (;;) {
+        q = static_cast<const char*>(std::memchr(q, quote, static_cast<std::size_t>(end - q)));
+        if (!q) {
+            return false;
+        }
+        if (quote == '\'' && q + 1 < end && q[1] == '\'') {
+            q += 2;
+            continue;
+        }
+        if (quote == '\'' && q + 1 == end) {
+            // Könnte die erste Hälfte von '' sein
+            return false;
+        }
+        p = q + 1;
+        return true;
+    }
+}
+
+/**
+ * p auf '(' einer Parameterliste: Parameter der obersten Ebene nach out (falls gesetzt), p hinter
+ * die passende ')'. ';' außerhalb von Zeichenketten ist in Parametern nicht erlaubt.
+ */
+Scan scanList(const char*& p, const char* end, std::vector<std::string_view>* out) {
+    ++p;
+    const char* start = p;
+    int depth = 0;
+    bool separated = false;
+    while (p < end) {
+        switch (*p) {
+            case '\'':
+            case '"':
+                if (!skipQuoted(p, end)) {
+                    return Scan::Incomplete;
+                }
+                break;
+            case '/':
+                if (p + 1 >= end) {
+                    return Scan::Incomplete;
+                }
+                if (p[1] == '*') {
+                    if (!skipComment(p, end)) {
+                        return Scan::Incomplete;
+                    }
+                } else {
+                    ++p;
+                }
+                break;
+            case '(':
+                ++depth;
+                ++p;
+                break;
+            case ')':
+                if (depth == 0) {
+                    if (out) {
+                        std::string_view last = trim(start, p);
+                        if (!last.empty() || separated) {
+                            out->push_back(last);
+                        }
+                    }
+                    ++p;
+                    return Scan::Ok;
+                }
+                --depth;
+                ++p;
+                break;
+            case ',':
+                if (depth == 0) {
+                    if (out) {
+                        out->push_back(trim(start, p));
+                    }
+                    start = p + 1;
+                    separated = true;
+                }
+                ++p;
+                break;
+            case ';':
+                return Scan::Error;
+            default:
+                ++p;
+                break;
+        }
+    }
+    return Scan::Incomplete;
+}
+
+std::string_view readKeyword(const char*& p, const char* end) {
+    const char* start = p;
+    if (p < end && isKeywordStart(*p)) {
+        ++p;
+        while (p < end && isKeywordChar(*p)) ++p;
+    }
+    return std::string_view(start, static_cast<std::size_t>(p - start));
+}
+
+void appendUtf8(std::uint32_t code, std::string& out) {
+    if (code < 0x80) {
+        out.push_back(static_cast<char>(code));
+    } else if (code < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else if (code < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else if (code < 0x110000) {
+        out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+}
+
+bool parseHex(std::string_view text, std::uint32_t& value) {
+    if (text.empty()) {
         return false;
     }
-    
-    std::string line;
-    bool in_data_section = false;
-    
-    while (std::getline(file, line)) {
-        if (line.find("ISO-10303-21") != std::string::npos) {
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value, 16);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+/** "\X2\" bzw. "\X4\": Hex-Gruppen der Breite width bis "\X0\". */
+bool decodeWide(std::string_view text, std::size_t& i, std::size_t width, std::string& out) {
+    std::uint32_t pending_high = 0;
+    while (i + width <= text.size() && text[i] != '\\') {
+        std::uint32_t unit = 0;
+        if (!parseHex(text.substr(i, width), unit)) {
+            return false;
+        }
+        i += width;
+        if (width == 4 && unit >= 0xD800 && unit < 0xDC00) {
+            pending_high = unit;
             continue;
         }
-        if (line.find("HEADER;") != std::string::npos) {
+        if (width == 4 && unit >= 0xDC00 && unit < 0xE000 && pending_high != 0) {
+            unit = 0x10000 + ((pending_high - 0xD800) << 10) + (unit - 0xDC00);
+        }
+        pending_high = 0;
+        appendUtf8(unit, out);
+    }
+    if (text.substr(i, 4) != "\\X0\\") {
+        return false;
+    }
+    i += 4;
+    return true;
+}
+
+}  // namespace
+
+/** Ergebnis eines Stücks des DATA-Abschnitts. */
+struct StepFileParser::Chunk {
+    enum class Status { Clean, SectionEnd, Incomplete, Error };
+
+    std::size_t begin{0};
+    std::size_t end{0};
+    Status status{Status::Clean};
+    /** SectionEnd: hinter "ENDSEC;", sonst Fehlerposition. */
+    std::size_t stop{0};
+    std::vector<StepEntity> entities;
+    std::vector<std::string_view> parameters;
+
+    void parse(const char* data) {
+        const char* p = data + begin;
+        const char* e = data + end;
+        std::vector<std::uint32_t> first;
+        entities.reserve((end - begin) / 96);
+        parameters.reserve((end - begin) / 32);
+        first.reserve((end - begin) / 96);
+        auto fail = [&](Status s) {
+            status = s;
+            stop = static_cast<std::size_t>(p - data);
+        };
+        for (;;) {
+            if (!skipBlank(p, e)) {
+                fail(Status::Incomplete);
+                break;
+            }
+            if (p == e) {
+                status = Status::Clean;
+                break;
+            }
+            if (*p != '#') {
+                std::string_view keyword = readKeyword(p, e);
+                if (keyword == "ENDSEC") {
+                    if (!skipBlank(p, e) || p == e) {
+                        fail(Status::Incomplete);
+                    } else if (*p != ';') {
+                        fail(Status::Error);
+                    } else {
+                        status = Status::SectionEnd;
+                        stop = static_cast<std::size_t>(p + 1 - data);
+                    }
+                } else {
+                    fail(p == e ? Status::Incomplete : Status::Error);
+                }
+                break;
+            }
+            ++p;
+            std::uint64_t id = 0;
+            const char* digits = p;
+            while (p < e && *p >= '0' && *p <= '9' && id <= 0xFFFFFFFFull) {
+                id = id * 10 + static_cast<std::uint64_t>(*p - '0');
+                ++p;
+            }
+            if (p == e) {
+                fail(Status::Incomplete);
+                break;
+            }
+            if (p == digits || id == 0 || id > 0xFFFFFFFFull) {
+                fail(Status::Error);
+                break;
+            }
+            if (!skipBlank(p, e) || p == e) {
+                fail(Status::Incomplete);
+                break;
+            }
+            if (*p != '=') {
+                fail(Status::Error);
+                break;
+            }
+            ++p;
+            if (!skipBlank(p, e) || p == e) {
+                fail(Status::Incomplete);
+                break;
+            }
+            StepEntity entity;
+            entity.id = static_cast<std::uint32_t>(id);
+            const std::size_t offset = parameters.size();
+            Scan scan = Scan::Ok;
+            if (*p == '(') {
+                // Komplexe Instanz: Teile "A(..) B(..)" als Parameter
+                ++p;
+                for (;;) {
+                    if (!skipBlank(p, e) || p == e) {
+                        scan = Scan::Incomplete;
+                        break;
+                    }
+                    if (*p == ')') {
+                        ++p;
+                        break;
+                    }
+                    const char* record = p;
+                    if (readKeyword(p, e).empty()) {
+                        scan = p == e ? Scan::Incomplete : Scan::Error;
+                        break;
+                    }
+                    if (!skipBlank(p, e) || p == e) {
+                        scan = Scan::Incomplete;
+                        break;
+                    }
+                    if (*p != '(') {
+                        scan = Scan::Error;
+                        break;
+                    }
+                    scan = scanList(p, e, nullptr);
+                    if (scan != Scan::Ok) {
+                        break;
+                    }
+                    parameters.push_back(std::string_view(record, static_cast<std::size_t>(p - record)));
+                }
+            } else {
+                entity.type = readKeyword(p, e);
+                if (entity.type.empty()) {
+                    scan = Scan::Error;
+                } else if (!skipBlank(p, e) || p == e) {
+                    scan = Scan::Incomplete;
+                } else if (*p != '(') {
+                    scan = Scan::Error;
+                } else {
+                    scan = scanList(p, e, &parameters);
+                }
+            }
+            if (scan == Scan::Ok && (!skipBlank(p, e) || p == e)) {
+                scan = Scan::Incomplete;
+            }
+            if (scan == Scan::Ok && *p != ';') {
+                scan = Scan::Error;
+            }
+            if (scan != Scan::Ok) {
+                parameters.resize(offset);
+                fail(scan == Scan::Incomplete ? Status::Incomplete : Status::Error);
+                break;
+            }
+            ++p;
+            entity.parameter_count = static_cast<std::uint32_t>(parameters.size() - offset);
+            entities.push_back(entity);
+            first.push_back(static_cast<std::uint32_t>(offset));
+        }
+        // Zeiger erst jetzt: parameters wächst beim Zerlegen
+        for (std::size_t i = 0; i < entities.size(); ++i) {
+            entities[i].parameters = parameters.data() + first[i];
+        }
+    }
+};
+
+StepFileParser::StepFileParser() = default;
+StepFileParser::~StepFileParser() = default;
+
+void StepFileParser::reset() {
+    file_.reset();
+    buffer_.clear();
+    data_ = nullptr;
+    size_ = 0;
+    entities_.clear();
+    header_.clear();
+    parameter_blocks_.clear();
+    index_.clear();
+    sorted_.clear();
+    max_id_ = 0;
+    has_header_ = false;
+    has_data_ = false;
+    chunk_count_ = 0;
+    error_.clear();
+}
+
+bool StepFileParser::parseFile(const std::string& path) {
+    reset();
+    // Wahlfreier Zugriff (Stücke parallel): WILLNEED statt SEQUENTIAL
+    file_ = std::make_unique<MappedFile>(path, false);
+    if (!file_->ok()) {
+        error_ = "Datei nicht lesbar: " + path;
+        return false;
+    }
+    data_ = file_->data();
+    size_ = file_->size();
+    return parseBuffer();
+}
+
+bool StepFileParser::parseText(std::string text) {
+    reset();
+    buffer_ = std::move(text);
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    return parseBuffer();
+}
+
+bool StepFileParser::parseBuffer() {
+    const char* p = data_;
+    const char* e = data_ + size_;
+    auto fail = [&](const char* message) {
+        if (error_.empty()) {
+            error_ = std::string(message) + " bei Byte " + std::to_string(p - data_);
+        }
+        buildIndex();
+        return false;
+    };
+    auto expectSemicolon = [&]() {
+        if (!skipBlank(p, e) || p == e || *p != ';') {
+            return false;
+        }
+        ++p;
+        return true;
+    };
+
+    if (!skipBlank(p, e) || readKeyword(p, e) != "ISO-10303-21" || !expectSemicolon()) {
+        return fail("Kein ISO-10303-21-Kopf");
+    }
+    for (;;) {
+        if (!skipBlank(p, e)) {
+            return fail("Kommentar ohne Ende");
+        }
+        if (p == e) {
+            return fail("END-ISO-10303-21 fehlt");
+        }
+        const std::string_view keyword = readKeyword(p, e);
+        if (keyword == "END-ISO-10303-21") {
+            break;
+        }
+        if (keyword == "HEADER") {
+            if (!expectSemicolon()) {
+                return fail("HEADER ohne ';'");
+            }
             has_header_ = true;
+            std::vector<std::string_view> parameters;
+            std::vector<std::size_t> first;
+            for (;;) {
+                if (!skipBlank(p, e) || p == e) {
+                    return fail("HEADER ohne ENDSEC");
+                }
+                const char* record = p;
+                const std::string_view type = readKeyword(p, e);
+                if (type == "ENDSEC") {
+                    if (!expectSemicolon()) {
+                        return fail("ENDSEC ohne ';'");
+                    }
+                    break;
+                }
+                StepEntity entity;
+                entity.type = type;
+                const std::size_t offset = parameters.size();
+                if (type.empty() || !skipBlank(p, e) || p == e || *p != '(' ||
+                    scanList(p, e, &parameters) != Scan::Ok || !expectSemicolon()) {
+                    p = record;
+                    return fail("Fehlerhafter HEADER-Eintrag");
+                }
+                entity.parameter_count = static_cast<std::uint32_t>(parameters.size() - offset);
+                header_.push_back(entity);
+                first.push_back(offset);
+            }
+            for (std::size_t i = 0; i < header_.size(); ++i) {
+                header_[i].parameters = parameters.data() + first[i];
+            }
+            parameter_blocks_.push_back(std::move(parameters));
+        } else if (keyword == "DATA") {
+            // Edition 3: DATA('name',(schema));
+            if (!skipBlank(p, e) || p == e) {
+                return fail("DATA ohne ';'");
+            }
+            if (*p == '(' && scanList(p, e, nullptr) != Scan::Ok) {
+                return fail("Fehlerhafte DATA-Parameter");
+            }
+            if (!expectSemicolon()) {
+                return fail("DATA ohne ';'");
+            }
+            has_data_ = true;
+            std::size_t end = 0;
+            if (!parseDataSection(static_cast<std::size_t>(p - data_), end)) {
+                return fail("");
+            }
+            p = data_ + end;
+        } else if (keyword == "ANCHOR" || keyword == "REFERENCE" || keyword == "SIGNATURE") {
+            // Edition 3: nicht ausgewertet, Anweisungen bis ENDSEC überspringen
+            for (;;) {
+                if (!skipBlank(p, e) || p == e) {
+                    return fail("Abschnitt ohne ENDSEC");
+                }
+                const char* statement = p;
+                if (readKeyword(p, e) == "ENDSEC") {
+                    if (!expectSemicolon()) {
+                        return fail("ENDSEC ohne ';'");
+                    }
+                    break;
+                }
+                // Bis zum ';' außerhalb von Zeichenketten und Kommentaren
+                p = statement;
+                while (p < e && *p != ';') {
+                    if (*p == '\'' || *p == '"') {
+                        if (!skipQuoted(p, e)) {
+                            return fail("Zeichenkette ohne Ende");
+                        }
+                    } else if (*p == '/' && p + 1 < e && p[1] == '*') {
+                        if (!skipComment(p, e)) {
+                            return fail("Kommentar ohne Ende");
+                        }
+                    } else {
+                        ++p;
+                    }
+                }
+                if (p == e) {
+                    return fail("Abschnitt ohne ENDSEC");
+                }
+                ++p;
+            }
+        } else {
+            return fail("Unbekannter Abschnitt");
+        }
+    }
+    buildIndex();
+    return true;
+}
+
+bool StepFileParser::parseDataSection(std::size_t begin, std::size_t& end) {
+    core::ThreadPool& pool = pool_ ? *pool_ : core::ThreadPool::shared();
+    const std::size_t bytes = size_ - begin;
+    const std::size_t max_chunks = std::max<std::size_t>(1, pool.threadCount() * 4);
+    const std::size_t wanted = std::min(max_chunks, std::max<std::size_t>(1, bytes / chunk_bytes_));
+
+    // Schnitte nur vor Zeilen "#n=" (Vermutung; geprüft wird beim Zusammenfügen)
+    std::vector<std::size_t> cuts{begin};
+    for (std::size_t k = 1; k < wanted; ++k) {
+        std::size_t pos = std::max(begin + bytes / wanted * k, cuts.back() + 1);
+        while (pos < size_) {
+            const char* line = static_cast<const char*>(std::memchr(data_ + pos, '\n', size_ - pos));
+            if (!line) {
+                pos = size_;
+                break;
+            }
+            const char* p = line + 1;
+            const char* e = data_ + size_;
+            while (p < e && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+            const char* hash = p;
+            if (p < e && *p == '#') {
+                ++p;
+                const char* digits = p;
+                while (p < e && *p >= '0' && *p <= '9') ++p;
+                while (p < e && (*p == ' ' || *p == '\t')) ++p;
+                if (p > digits && p < e && *p == '=') {
+                    pos = static_cast<std::size_t>(hash - data_);
+                    break;
+                }
+            }
+            pos = static_cast<std::size_t>(line + 1 - data_);
+        }
+        if (pos >= size_) {
+            break;
+        }
+        cuts.push_back(pos);
+    }
+
+    std::vector<Chunk> chunks(cuts.size());
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        chunks[i].begin = cuts[i];
+        chunks[i].end = i + 1 < cuts.size() ? cuts[i + 1] : size_;
+    }
+    pool.parallelFor(chunks.size(), [&](std::size_t i) { chunks[i].parse(data_); });
+    chunk_count_ = std::max(chunk_count_, chunks.size());
+
+    auto take = [&](Chunk& chunk) {
+        entities_.insert(entities_.end(), chunk.entities.begin(), chunk.entities.end());
+        parameter_blocks_.push_back(std::move(chunk.parameters));
+    };
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        Chunk& chunk = chunks[i];
+        if (chunk.status == Chunk::Status::Clean && chunk.end < size_) {
+            take(chunk);
             continue;
         }
-        if (line.find("DATA;") != std::string::npos) {
-            in_data_section = true;
-            has_data_ = true;
+        if (chunk.status != Chunk::Status::SectionEnd && chunk.end < size_) {
+            // Schnitt lag in einer Zeichenkette/einem Kommentar oder echter Fehler: ab hier am Stück
+            Chunk rest;
+            rest.begin = chunk.begin;
+            rest.end = size_;
+            rest.parse(data_);
+            chunk = std::move(rest);
+        }
+        take(chunk);
+        if (chunk.status == Chunk::Status::SectionEnd) {
+            end = chunk.stop;
+            return true;
+        }
+        const char* message = chunk.status == Chunk::Status::Error ? "Syntaxfehler im DATA-Abschnitt"
+                              : chunk.status == Chunk::Status::Incomplete ? "Unvollständige Instanz am Dateiende"
+                                                                           : "DATA ohne ENDSEC";
+        error_ = std::string(message) + " bei Byte " + std::to_string(chunk.status == Chunk::Status::Clean ? size_ : chunk.stop);
+        return false;
+    }
+    error_ = "DATA ohne ENDSEC";
+    return false;
+}
+
+void StepFileParser::buildIndex() {
+    max_id_ = 0;
+    for (const StepEntity& entity : entities_) {
+        max_id_ = std::max(max_id_, entity.id);
+    }
+    // Dicht, solange die Tabelle nicht wesentlich größer als die Instanzliste wird
+    if (static_cast<std::size_t>(max_id_) <= entities_.size() * 4 + (1u << 20)) {
+        index_.assign(static_cast<std::size_t>(max_id_) + 1, 0);
+        for (std::size_t i = entities_.size(); i-- > 0;) {
+            index_[entities_[i].id] = static_cast<std::uint32_t>(i + 1);
+        }
+        return;
+    }
+    sorted_.reserve(entities_.size());
+    for (std::size_t i = 0; i < entities_.size(); ++i) {
+        sorted_.emplace_back(entities_[i].id, static_cast<std::uint32_t>(i));
+    }
+    std::stable_sort(sorted_.begin(), sorted_.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+}
+
+const StepEntity* StepFileParser::find(std::uint32_t id) const {
+    if (!index_.empty()) {
+        if (id >= index_.size() || index_[id] == 0) {
+            return nullptr;
+        }
+        return &entities_[index_[id] - 1];
+    }
+    auto it = std::lower_bound(sorted_.begin(), sorted_.end(), id,
+                               [](const auto& entry, std::uint32_t value) { return entry.first < value; });
+    if (it == sorted_.end() || it->first != id) {
+        return nullptr;
+    }
+    return &entities_[it->second];
+}
+
+std::vector<std::string_view> StepFileParser::splitList(std::string_view list) {
+    std::vector<std::string_view> items;
+    list = trim(list);
+    if (list.empty() || list == "$") {
+        return items;
+    }
+    const char* p = list.data();
+    const char* e = list.data() + list.size();
+    if (*p == '(') {
+        scanList(p, e, &items);
+        return items;
+    }
+    // Ohne äußere Klammern: an Kommas der obersten Ebene teilen
+    const char* start = p;
+    int depth = 0;
+    while (p < e) {
+        if (*p == '\'' || *p == '"') {
+            if (!skipQuoted(p, e)) break;
             continue;
         }
-        if (line.find("ENDSEC;") != std::string::npos) {
-            if (in_data_section) {
-                break;
+        if (*p == '(') ++depth;
+        if (*p == ')') --depth;
+        if (*p == ',' && depth == 0) {
+            items.push_back(trim(start, p));
+            start = p + 1;
+        }
+        ++p;
+    }
+    items.push_back(trim(start, e));
+    return items;
+}
+
+bool StepFileParser::splitRecord(std::string_view record, std::string_view& type,
+                                 std::vector<std::string_view>& parameters) {
+    record = trim(record);
+    const char* p = record.data();
+    const char* e = record.data() + record.size();
+    type = readKeyword(p, e);
+    if (type.empty() || !skipBlank(p, e) || p == e || *p != '(') {
+        return false;
+    }
+    parameters.clear();
+    if (scanList(p, e, &parameters) != Scan::Ok) {
+        return false;
+    }
+    return skipBlank(p, e) && p == e;
+}
+
+bool StepFileParser::asReference(std::string_view parameter, std::uint32_t& id) {
+    parameter = trim(parameter);
+    if (parameter.size() < 2 || parameter[0] != '#') {
+        return false;
+    }
+    auto result = std::from_chars(parameter.data() + 1, parameter.data() + parameter.size(), id);
+    return result.ec == std::errc() && result.ptr == parameter.data() + parameter.size() && id != 0;
+}
+
+bool StepFileParser::asReal(std::string_view parameter, double& value) {
+    parameter = trim(parameter);
+    std::string_view type;
+    std::vector<std::string_view> inner;
+    if (!parameter.empty() && isKeywordStart(parameter[0])) {
+        // Typisiert: LENGTH_MEASURE(2.)
+        if (!splitRecord(parameter, type, inner) || inner.size() != 1) {
+            return false;
+        }
+        return asReal(inner[0], value);
+    }
+    if (!parameter.empty() && parameter[0] == '+') {
+        parameter.remove_prefix(1);
+    }
+    if (parameter.empty()) {
+        return false;
+    }
+    auto result = std::from_chars(parameter.data(), parameter.data() + parameter.size(), value);
+    return result.ec == std::errc() && result.ptr == parameter.data() + parameter.size();
+}
+
+bool StepFileParser::asString(std::string_view parameter, std::string& value) {
+    parameter = trim(parameter);
+    if (parameter.size() < 2 || parameter.front() != '\'' || parameter.back() != '\'') {
+        return false;
+    }
+    const std::string_view text = parameter.substr(1, parameter.size() - 2);
+    value.clear();
+    value.reserve(text.size());
+    for (std::size_t i = 0; i < text.size();) {
+        const char c = text[i];
+        if (c == '\'') {
+            // '' steht für ein Apostroph
+            value.push_back('\'');
+            i += i + 1 < text.size() && text[i + 1] == '\'' ? 2 : 1;
+            continue;
+        }
+        if (c != '\\' || i + 1 >= text.size()) {
+            if (c != '\n' && c != '\r') {
+                value.push_back(c);
             }
+            ++i;
             continue;
         }
-        
-        if (in_data_section && line.find("=") != std::string::npos) {
-            StepEntity entity = parseEntity(line);
-            if (entity.id > 0) {
-                entities_.push_back(entity);
+        const std::string_view rest = text.substr(i);
+        std::uint32_t code = 0;
+        if (rest.substr(0, 2) == "\\\\") {
+            value.push_back('\\');
+            i += 2;
+        } else if (rest.size() >= 4 && rest.substr(0, 3) == "\\S\\") {
+            appendUtf8(static_cast<unsigned char>(rest[3]) + 128u, value);
+            i += 4;
+        } else if (rest.size() >= 5 && rest.substr(0, 3) == "\\X\\" && parseHex(rest.substr(3, 2), code)) {
+            appendUtf8(code, value);
+            i += 5;
+        } else if (rest.substr(0, 4) == "\\X2\\" || rest.substr(0, 4) == "\\X4\\") {
+            const std::size_t width = rest[2] == '2' ? 4 : 8;
+            i += 4;
+            if (!decodeWide(text, i, width, value)) {
+                return false;
             }
+        } else if (rest.size() >= 4 && rest[1] == 'P' && rest[3] == '\\') {
+            // Codepage-Umschaltung \PA\: nur Latin-1 unterstützt
+            i += 4;
+        } else {
+            value.push_back(c);
+            ++i;
         }
     }
-    
-    file.close();
     return true;
 }
 
-StepEntity StepFileParser::parseEntity(const std::string& line) {
-    StepEntity entity;
-    
-    size_t eq_pos = line.find("=");
-    if (eq_pos == std::string::npos) {
-        return entity;
-    }
-    
-    std::string id_str = line.substr(0, eq_pos);
-    id_str.erase(std::remove_if(id_str.begin(), id_str.end(), ::isspace), id_str.end());
-    id_str.erase(std::remove(id_str.begin(), id_str.end(), '#'), id_str.end());
-    
-    try {
-        entity.id = std::stoi(id_str);
-    } catch (...) {
-        return entity;
-    }
-    
-    std::string rest = line.substr(eq_pos + 1);
-    entity.type = extractEntityType(rest);
-    entity.parameters = extractParameters(rest);
-    
-    return entity;
-}
-
-std::string StepFileParser::extractEntityType(const std::string& line) {
-    size_t paren_pos = line.find("(");
-    if (paren_pos == std::string::npos) {
-        return "";
-    }
-    
-    std::string type = line.substr(0, paren_pos);
-    type.erase(std::remove_if(type.begin(), type.end(), ::isspace), type.end());
-    return type;
-}
-
-std::map<std::string, std::string> StepFileParser::extractParameters(const std::string& line) {
-    std::map<std::string, std::string> params;
-    
-    size_t open_paren = line.find("(");
-    size_t close_paren = line.find_last_of(")");
-    
-    if (open_paren == std::string::npos || close_paren == std::string::npos) {
-        return params;
-    }
-    
-    std::string param_str = line.substr(open_paren + 1, close_paren - open_paren - 1);
-    
-    std::istringstream iss(param_str);
-    std::string token;
-    int param_index = 0;
-    
-    while (std::getline(iss, token, ',')) {
-        token.erase(std::remove_if(token.begin(), token.end(), ::isspace), token.end());
-        token.erase(std::remove(token.begin(), token.end(), '\''), token.end());
-        params["param_" + std::to_string(param_index++)] = token;
-    }
-    
-    return params;
+bool StepFileParser::asEnumeration(std::string_view parameter, std::string_view& value) {
+    parameter = trim(parameter);
+    if (parameter.size() < 3 || parameter.front() != '.' || parameter.back() != '.') {
+        return false;
+    }
+    value = parameter.substr(1, parameter.size() - 2);
+    return true;
 }
 
 }  // namespace interop
 }  // namespace cad
-
@@ -1,35 +1,129 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
-#include <map>
 
 namespace cad {
+namespace core {
+class ThreadPool;
+}  // namespace core
+
 namespace interop {
 
+class MappedFile;
+
+/**
+ * Instanz aus einer Part-21-Datei. Alle Sichten zeigen in den Dateiinhalt des Parsers und bleiben
+ * gültig, solange dieser lebt (kein erneutes parse*()).
+ */
 struct StepEntity {
-    int id{0};
-    std::string type;
-    std::map<std::string, std::string> parameters;
+    /** 0 bei Einträgen des HEADER-Abschnitts. */
+    std::uint32_t id{0};
+    /** Schlüsselwort (z.B. CARTESIAN_POINT); leer bei komplexen Instanzen „#1=(A(..) B(..));“. */
+    std::string_view type;
+    /**
+     * Parameter der obersten Ebene als Rohtext ohne Leerraum an den Rändern, z.B. "'name'", "#12",
+     * "(0.,1.,2.)", ".T.", "$". Bei komplexen Instanzen je Teil ein Eintrag "A(..)" (splitRecord()).
+     */
+    const std::string_view* parameters{nullptr};
+    std::uint32_t parameter_count{0};
+
+    bool isComplex() const { return type.empty() && parameter_count > 0; }
+    std::string_view parameter(std::size_t index) const {
+        return index < parameter_count ? parameters[index] : std::string_view();
+    }
 };
 
+/**
+ * Tokenizer für STEP Part 21 (ISO 10303-21): Instanzen über beliebig viele Zeilen, Kommentare,
+ * Zeichenketten mit '' und Backslash-Kodierungen, verschachtelte Listen, typisierte Parameter,
+ * komplexe Instanzen, mehrere DATA-Abschnitte. Die Datei wird gemappt (ohne Kopie); der DATA-Abschnitt
+ * wird an Zeilen „#n=“ in Stücke geteilt und parallel zerlegt. Jedes Stück endet nur dann gültig, wenn
+ * es genau an einer Instanzgrenze aufhört – lag ein Schnitt doch in einer Zeichenkette oder einem
+ * Kommentar, wird ab dort sequentiell weitergeparst. Instanzen stehen danach in Dateireihenfolge in
+ * getEntities() und über find() in einer dichten Tabelle nach Id.
+ */
 class StepFileParser {
 public:
+    /** Unterhalb dieser Größe des DATA-Abschnitts wird nicht geteilt. */
+    static constexpr std::size_t kDefaultChunkBytes = 4u * 1024 * 1024;
+
+    StepFileParser();
+    ~StepFileParser();
+    StepFileParser(const StepFileParser&) = delete;
+    StepFileParser& operator=(const StepFileParser&) = delete;
+
+    /** pool == nullptr → ThreadPool::shared(). */
+    void setThreadPool(core::ThreadPool* pool) { pool_ = pool; }
+    void setChunkBytes(std::size_t bytes) { chunk_bytes_ = bytes == 0 ? 1 : bytes; }
+
+    /** false bei Lesefehler oder Syntaxfehler (error()); bereits gelesene Instanzen bleiben erhalten. */
     bool parseFile(const std::string& path);
-    std::vector<StepEntity> getEntities() const { return entities_; }
+    /** Wie parseFile() für Text im Speicher (wird übernommen). */
+    bool parseText(std::string text);
+
+    const std::vector<StepEntity>& getEntities() const { return entities_; }
+    const std::vector<StepEntity>& headerEntities() const { return header_; }
+    /** Instanz #id oder nullptr (bei doppelten Ids die erste). */
+    const StepEntity* find(std::uint32_t id) const;
+    std::uint32_t maxId() const { return max_id_; }
     bool hasHeader() const { return has_header_; }
     bool hasData() const { return has_data_; }
-    
+    /** Meldung mit Byte-Position des ersten Fehlers, sonst leer. */
+    const std::string& error() const { return error_; }
+    /** Größe des gelesenen Inhalts in Bytes (0 = nicht lesbar oder leer). */
+    std::size_t size() const { return size_; }
+    /** Stücke des letzten Laufs, die parallel zerlegt wurden (1 = sequentiell). */
+    std::size_t chunkCount() const { return chunk_count_; }
+
+    /** Elemente einer Liste "(a,b,(c))" bzw. ohne äußere Klammern; leer bei "()" oder "$". */
+    static std::vector<std::string_view> splitList(std::string_view list);
+    /** Teil "KEYWORD(p0,p1)" bzw. typisierter Parameter in Schlüsselwort und Parameter zerlegen. */
+    static bool splitRecord(std::string_view record, std::string_view& type, std::vector<std::string_view>& parameters);
+    /** "#123" → 123. */
+    static bool asReference(std::string_view parameter, std::uint32_t& id);
+    /** Zahl, auch "1.", "-2.5E-3" und typisiert "LENGTH_MEASURE(2.)". */
+    static bool asReal(std::string_view parameter, double& value);
+    /** "'It''s'" → "It's"; \\, \S\, \X\hh, \X2\..\X0\ und \X4\..\X0\ nach UTF-8. */
+    static bool asString(std::string_view parameter, std::string& value);
+    /** ".T." → "T". */
+    static bool asEnumeration(std::string_view parameter, std::string_view& value);
+
 private:
+    struct Chunk;
+
+    bool parseBuffer();
+    bool parseDataSection(std::size_t begin, std::size_t& end);
+    void buildIndex();
+    void reset();
+
+    // Dateiinhalt: gemappt (file_) oder aus buffer_ (parseText)
+    std::unique_ptr<MappedFile> file_;
+    std::string buffer_;
+    const char* data_{nullptr};
+    std::size_t size_{0};
+
+    core::ThreadPool* pool_{nullptr};
+    std::size_t chunk_bytes_{kDefaultChunkBytes};
+
     std::vector<StepEntity> entities_;
+    std::vector<StepEntity> header_;
+    /** Parameter der Instanzen, je Stück ein Block (Zeiger in StepEntity bleiben gültig). */
+    std::vector<std::vector<std::string_view>> parameter_blocks_;
+    /** id → Position in entities_ + 1 (0 = fehlt); dicht bis max_id_, bei sehr dünnen Ids sorted_. */
+    std::vector<std::uint32_t> index_;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> sorted_;
+    std::uint32_t max_id_{0};
     bool has_header_{false};
     bool has_data_{false};
-    
-    StepEntity parseEntity(const std::string& line);
-    std::string extractEntityType(const std::string& line);
-    std::map<std::string, std::string> extractParameters(const std::string& line);
+    std::size_t chunk_count_{0};
+    std::string error_;
 };
 
 }  // namespace interop
 }  // namespace cad
-
@@ -0,0 +1,44 @@
+#include "TextSink.h"
+
+#include <charconv>
+#include <utility>
+
+namespace cad {
+namespace interop {
+
+TextSink::TextSink(std::ofstream& file, std::size_t capacity)
+    : TextSink(
+          [&file](const char* data, std::size_t size) {
+              file.write(data, static_cast<std::streamsize>(size));
+              return static_cast<bool>(file);
+          },
+          capacity) {}
+
+TextSink::TextSink(Output output, std::size_t capacity)
+    : output_(std::move(output)), capacity_(capacity == 0 ? 1 : capacity) {
+    buffer_.reserve(capacity_ + 256);
+}
+
+void TextSink::integer(std::uint64_t value) {
+    char digits[24];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer_.append(digits, result.ptr);
+}
+
+void TextSink::real(double value) {
+    char digits[32];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer_.append(digits, result.ptr);
+}
+
+bool TextSink::flush() {
+    if (!buffer_.empty()) {
+        ok_ = output_(buffer_.data(), buffer_.size()) && ok_;
+        bytes_ += buffer_.size();
+        buffer_.clear();
+    }
+    return ok_;
+}
+
+}  // namespace interop
+}  // namespace cad
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace cad {
+namespace interop {
+
+/**
+ * Gepufferte Textausgabe für Exporter: sammelt bis capacity Bytes und schreibt dann in einem Block
+ * (in eine Datei oder an eine Ausgabefunktion, z.B. einen ZIP-Eintrag).
+ * Zahlen über std::to_chars (kürzeste exakte Darstellung, unabhängig von der Locale).
+ */
+class TextSink {
+public:
+    /** false bei Schreibfehler. */
+    using Output = std::function<bool(const char* data, std::size_t size)>;
+
+    TextSink(std::ofstream& file, std::size_t capacity);
+    TextSink(Output output, std::size_t capacity);
+
+    void text(std::string_view value) {
+        buffer_.append(value.data(), value.size());
+        if (buffer_.size() >= capacity_) {
+            flush();
+        }
+    }
+    void put(char c) { buffer_.push_back(c); }
+    void integer(std::uint64_t value);
+    /** z.B. "1", "0.1", "1e-07". */
+    void real(double value);
+    /** Rohpuffer für formatspezifische Ausgabe; danach text() oder flush() aufrufen. */
+    std::string& buffer() { return buffer_; }
+
+    /** false bei Schreibfehler (auch früherer automatischer Leerungen). */
+    bool flush();
+    std::size_t bytes() const { return bytes_ + buffer_.size(); }
+
+private:
+    Output output_;
+    std::size_t capacity_;
+    std::string buffer_;
+    std::size_t bytes_{0};
+    bool ok_{true};
+};
+
+}  // namespace interop
+}  // namespace cad
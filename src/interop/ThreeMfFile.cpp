@@ -0,0 +1,723 @@
+#include "ThreeMfFile.h"
+#include "TextSink.h"
+#include "ZipArchive.h"
+#include "../core/Modeler/Transform.h"
+#include "../core/perf/PerfSpan.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+
+namespace cad {
+namespace interop {
+
+namespace {
+
+constexpr const char* kModelPath = "3D/3dmodel.model";
+
+constexpr const char* kContentTypes =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">"
+    "<Default Extension=\"rels\" ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>"
+    "<Default Extension=\"model\" ContentType=\"application/vnd.ms-package.3dmanufacturing-3dmodel+xml\"/>"
+    "</Types>\n";
+
+constexpr const char* kRelationships =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+    "<Relationship Target=\"/3D/3dmodel.model\" Id=\"rel0\" "
+    "Type=\"http://schemas.microsoft.com/3dmanufacturing/2013/01/3dmodel\"/>"
+    "</Relationships>\n";
+
+void escaped(TextSink& out, const std::string& text) {
+    for (char c : text) {
+        switch (c) {
+            case '&': out.text("&amp;"); break;
+            case '<': out.text("&lt;"); break;
+            case '>': out.text("&gt;"); break;
+            case '"': out.text("&quot;"); break;
+            default: out.put(c);
+        }
+    }
+}
+
+/** " transform=..." in 3MF-Zeilenform (p' = p · M); Identität entfällt. */
+void transformAttribute(TextSink& out, const core::Transform& transform) {
+    const core::RigidFrame frame = core::RigidFrame::fromTransform(transform);
+    const bool identity = frame.t[0] == 0.0 && frame.t[1] == 0.0 && frame.t[2] == 0.0 && frame.m[0] == 1.0 &&
+                          frame.m[4] == 1.0 && frame.m[8] == 1.0;
+    if (identity) {
+        return;
+    }
+    out.text(" transform=\"");
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            out.real(frame.m[column * 3 + row]);
+            out.put(' ');
+        }
+    }
+    out.real(frame.t[0]);
+    out.put(' ');
+    out.real(frame.t[1]);
+    out.put(' ');
+    out.real(frame.t[2]);
+    out.put('"');
+}
+
+}  // namespace
+
+ThreeMfWriter::ThreeMfWriter(ThreeMfWriteOptions options) : options_(std::move(options)) {}
+
+bool ThreeMfWriter::writeAssembly(const std::string& path, const core::Assembly& assembly,
+                                  const Tessellator& tessellator) {
+    core::PerfTimer timer("3mf.write");
+    stats_ = ThreeMfWriteStats{};
+    error_.clear();
+    ZipWriter zip;
+    if (!zip.open(path)) {
+        error_ = zip.error();
+        return false;
+    }
+    zip.beginEntry("[Content_Types].xml", options_.compress);
+    zip.write(kContentTypes);
+    zip.beginEntry("_rels/.rels", options_.compress);
+    zip.write(kRelationships);
+    zip.beginEntry(kModelPath, options_.compress);
+    TextSink out([&zip](const char* data, std::size_t size) { return zip.write(data, size); },
+                 options_.buffer_bytes);
+
+    out.text("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+             "<model unit=\"millimeter\" xml:lang=\"en-US\" "
+             "xmlns=\"http://schemas.microsoft.com/3dmanufacturing/core/2015/02\">\n"
+             "<metadata name=\"Application\">Hydra CAD</metadata>\n");
+    if (!options_.title.empty()) {
+        out.text("<metadata name=\"Title\">");
+        escaped(out, options_.title);
+        out.text("</metadata>\n");
+    }
+    out.text("<resources>\n");
+
+    // Netz-Objekte: je Definition einmal tessellieren und sofort schreiben
+    const std::vector<core::AssemblyComponent>& components = assembly.components();
+    std::unordered_map<const core::Part*, std::uint64_t> mesh_object;
+    std::uint64_t next_id = 1;
+    core::TriangleMesh mesh;
+    for (const core::AssemblyComponent& component : components) {
+        const core::Part* part = &component.part.get();
+        if (mesh_object.count(part)) {
+            continue;
+        }
+        mesh = core::TriangleMesh{};
+        if (!tessellator || !tessellator(*part, mesh) || mesh.indices.size() < 3) {
+            mesh_object.emplace(part, 0);
+            continue;
+        }
+        const std::uint64_t id = next_id++;
+        mesh_object.emplace(part, id);
+        out.text("<object id=\"");
+        out.integer(id);
+        out.text("\" type=\"model\" name=\"");
+        escaped(out, part->name());
+        out.text("\">\n<mesh>\n<vertices>\n");
+        for (std::size_t v = 0; v + 2 < mesh.vertices.size(); v += 3) {
+            out.text("<vertex x=\"");
+            out.real(mesh.vertices[v]);
+            out.text("\" y=\"");
+            out.real(mesh.vertices[v + 1]);
+            out.text("\" z=\"");
+            out.real(mesh.vertices[v + 2]);
+            out.text("\"/>\n");
+        }
+        out.text("</vertices>\n<triangles>\n");
+        for (std::size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+            out.text("<triangle v1=\"");
+            out.integer(mesh.indices[t]);
+            out.text("\" v2=\"");
+            out.integer(mesh.indices[t + 1]);
+            out.text("\" v3=\"");
+            out.integer(mesh.indices[t + 2]);
+            out.text("\"/>\n");
+        }
+        out.text("</triangles>\n</mesh>\n</object>\n");
+        ++stats_.mesh_objects;
+        stats_.vertices += mesh.vertices.size() / 3;
+        stats_.triangles += mesh.indices.size() / 3;
+    }
+
+    // Unterbaugruppen als Komponenten-Objekte, Kinder vor Eltern (Verweise nur auf frühere Objekte)
+    std::unordered_map<std::uint64_t, std::vector<std::size_t>> children;
+    std::vector<std::size_t> top;
+    for (std::size_t c = 0; c < components.size(); ++c) {
+        if (components[c].parent_id == 0) {
+            top.push_back(c);
+        } else {
+            children[components[c].parent_id].push_back(c);
+        }
+    }
+    std::vector<std::uint64_t> reference(components.size(), 0);
+    std::vector<std::pair<std::size_t, bool>> stack;
+    for (auto it = top.rbegin(); it != top.rend(); ++it) stack.emplace_back(*it, false);
+    std::vector<bool> seen(components.size(), false);
+    while (!stack.empty()) {
+        const auto [index, expanded] = stack.back();
+        stack.pop_back();
+        const core::AssemblyComponent& component = components[index];
+        const auto kids = children.find(component.id);
+        const std::uint64_t own = mesh_object[&component.part.get()];
+        if (kids == children.end()) {
+            reference[index] = own;
+            continue;
+        }
+        if (!expanded) {
+            if (seen[index]) {
+                continue;  // Zyklus
+            }
+            seen[index] = true;
+            stack.emplace_back(index, true);
+            for (auto it = kids->second.rbegin(); it != kids->second.rend(); ++it) stack.emplace_back(*it, false);
+            continue;
+        }
+        bool any = own != 0;
+        for (std::size_t child : kids->second) any = any || reference[child] != 0;
+        if (!any) {
+            continue;
+        }
+        const std::uint64_t id = next_id++;
+        reference[index] = id;
+        out.text("<object id=\"");
+        out.integer(id);
+        out.text("\" type=\"model\" name=\"");
+        escaped(out, component.part->name());
+        out.text("\">\n<components>\n");
+        if (own != 0) {
+            out.text("<component objectid=\"");
+            out.integer(own);
+            out.text("\"/>\n");
+        }
+        for (std::size_t child : kids->second) {
+            if (reference[child] == 0) {
+                continue;
+            }
+            out.text("<component objectid=\"");
+            out.integer(reference[child]);
+            out.put('"');
+            transformAttribute(out, components[child].transform);
+            out.text("/>\n");
+        }
+        out.text("</components>\n</object>\n");
+        ++stats_.component_objects;
+    }
+
+    out.text("</resources>\n<build>\n");
+    for (std::size_t index : top) {
+        if (reference[index] == 0) {
+            continue;
+        }
+        out.text("<item objectid=\"");
+        out.integer(reference[index]);
+        out.put('"');
+        transformAttribute(out, components[index].transform);
+        out.text("/>\n");
+        ++stats_.build_items;
+    }
+    out.text("</build>\n</model>\n");
+    const bool ok = out.flush() && zip.finish();
+    stats_.bytes = zip.bytes();
+    stats_.write_ms = timer.finish().elapsed_ms;
+    if (!ok) {
+        error_ = zip.error().empty() ? "Write failed: " + path : zip.error();
+        return false;
+    }
+    return true;
+}
+
+namespace {
+
+/** Tag des XML-Stroms (ohne DOM); attributes ist der Text zwischen Name und '>' bzw. '/>'. */
+struct Tag {
+    std::string_view name;
+    std::string_view attributes;
+    bool closing{false};
+    bool self_closing{false};
+};
+
+class XmlScanner {
+public:
+    XmlScanner(const char* begin, const char* end) : begin_(begin), p_(begin), e_(end) {}
+
+    /** false am Ende; error() bei unvollständigem Tag. */
+    bool next(Tag& tag) {
+        while (true) {
+            const char* open = static_cast<const char*>(std::memchr(p_, '<', static_cast<std::size_t>(e_ - p_)));
+            if (!open) {
+                p_ = e_;
+                return false;
+            }
+            p_ = open + 1;
+            if (skip("!--", "-->") || skip("?", "?>") || skip("![CDATA[", "]]>") || skip("!", ">")) {
+                if (!error_.empty()) {
+                    return false;
+                }
+                continue;
+            }
+            const char* close = static_cast<const char*>(std::memchr(p_, '>', static_cast<std::size_t>(e_ - p_)));
+            if (!close) {
+                error_ = "Incomplete tag at byte " + std::to_string(open - begin_);
+                return false;
+            }
+            const char* start = p_;
+            tag.closing = *start == '/';
+            if (tag.closing) ++start;
+            tag.self_closing = close > start && close[-1] == '/';
+            const char* body_end = tag.self_closing ? close - 1 : close;
+            const char* name_end = start;
+            while (name_end < body_end && !std::isspace(static_cast<unsigned char>(*name_end))) ++name_end;
+            tag.name = std::string_view(start, static_cast<std::size_t>(name_end - start));
+            tag.attributes = std::string_view(name_end, static_cast<std::size_t>(body_end - name_end));
+            p_ = close + 1;
+            return true;
+        }
+    }
+
+    /** Text bis zum nächsten '<' (z.B. metadata). */
+    std::string_view text() const {
+        const char* open = static_cast<const char*>(std::memchr(p_, '<', static_cast<std::size_t>(e_ - p_)));
+        return std::string_view(p_, static_cast<std::size_t>((open ? open : e_) - p_));
+    }
+    const std::string& error() const { return error_; }
+
+private:
+    bool skip(const char* prefix, const char* terminator) {
+        const std::size_t length = std::strlen(prefix);
+        if (static_cast<std::size_t>(e_ - p_) < length || std::memcmp(p_, prefix, length) != 0) {
+            return false;
+        }
+        const std::string_view rest(p_, static_cast<std::size_t>(e_ - p_));
+        const std::size_t end = rest.find(terminator);
+        if (end == std::string_view::npos) {
+            error_ = "Incomplete XML at byte " + std::to_string(p_ - begin_);
+            p_ = e_;
+            return true;
+        }
+        p_ += end + std::strlen(terminator);
+        return true;
+    }
+
+    const char* begin_;
+    const char* p_;
+    const char* e_;
+    std::string error_;
+};
+
+/** Wert eines Attributs (ohne Entitäten-Auflösung). */
+bool attribute(std::string_view attributes, std::string_view key, std::string_view& value) {
+    std::size_t i = 0;
+    while (i < attributes.size()) {
+        while (i < attributes.size() && std::isspace(static_cast<unsigned char>(attributes[i]))) ++i;
+        const std::size_t name_start = i;
+        while (i < attributes.size() && attributes[i] != '=' && !std::isspace(static_cast<unsigned char>(attributes[i])))
+            ++i;
+        const std::string_view name = attributes.substr(name_start, i - name_start);
+        while (i < attributes.size() && attributes[i] != '"' && attributes[i] != '\'') ++i;
+        if (i >= attributes.size()) {
+            return false;
+        }
+        const char quote = attributes[i++];
+        const std::size_t value_end = attributes.find(quote, i);
+        if (value_end == std::string_view::npos) {
+            return false;
+        }
+        if (name == key) {
+            value = attributes.substr(i, value_end - i);
+            return true;
+        }
+        i = value_end + 1;
+    }
+    return false;
+}
+
+std::string unescape(std::string_view text) {
+    std::string out;
+    out.reserve(text.size());
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if (text[i] != '&') {
+            out.push_back(text[i]);
+            continue;
+        }
+        static const std::pair<const char*, char> kEntities[] = {
+            {"&amp;", '&'}, {"&lt;", '<'}, {"&gt;", '>'}, {"&quot;", '"'}, {"&apos;", '\''}};
+        bool matched = false;
+        for (const auto& entity : kEntities) {
+            const std::size_t length = std::strlen(entity.first);
+            if (text.compare(i, length, entity.first) == 0) {
+                out.push_back(entity.second);
+                i += length - 1;
+                matched = true;
+                break;
+            }
+        }
+        if (!matched) {
+            out.push_back('&');
+        }
+    }
+    return out;
+}
+
+template <typename T>
+bool number(std::string_view attributes, std::string_view key, T& value) {
+    std::string_view text;
+    if (!attribute(attributes, key, text)) {
+        return false;
+    }
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) text.remove_prefix(1);
+    if (!text.empty() && text.front() == '+') text.remove_prefix(1);
+    const auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc();
+}
+
+/** Affine Lage p' = r · p + t (r zeilenweise). */
+struct Affine {
+    double r[9]{1, 0, 0, 0, 1, 0, 0, 0, 1};
+    double t[3]{0, 0, 0};
+
+    friend Affine operator*(const Affine& a, const Affine& b) {
+        Affine out;
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                out.r[i * 3 + j] = a.r[i * 3] * b.r[j] + a.r[i * 3 + 1] * b.r[3 + j] + a.r[i * 3 + 2] * b.r[6 + j];
+            }
+            out.t[i] = a.r[i * 3] * b.t[0] + a.r[i * 3 + 1] * b.t[1] + a.r[i * 3 + 2] * b.t[2] + a.t[i];
+        }
+        return out;
+    }
+
+    /** 3MF "m00 m01 m02 m10 ... m32" (p' = p · M); false bei ungültigem Text. */
+    static bool parse(std::string_view text, Affine& out) {
+        double m[12];
+        const char* p = text.data();
+        const char* e = text.data() + text.size();
+        for (double& value : m) {
+            while (p < e && std::isspace(static_cast<unsigned char>(*p))) ++p;
+            if (p < e && *p == '+') ++p;
+            const auto result = std::from_chars(p, e, value);
+            if (result.ec != std::errc()) {
+                return false;
+            }
+            p = result.ptr;
+        }
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                out.r[i * 3 + j] = m[j * 3 + i];
+            }
+            out.t[i] = m[9 + i];
+        }
+        return true;
+    }
+
+    /** Starre Lage + Maßstab je Achse (Spiegelung als negatives x). */
+    void decompose(core::Transform& rigid, double scale[3]) const {
+        double axes[3][3];
+        for (int c = 0; c < 3; ++c) {
+            scale[c] = std::sqrt(r[c] * r[c] + r[3 + c] * r[3 + c] + r[6 + c] * r[6 + c]);
+            for (int row = 0; row < 3; ++row) {
+                axes[c][row] = scale[c] > 0.0 ? r[row * 3 + c] / scale[c] : (row == c ? 1.0 : 0.0);
+            }
+        }
+        const double det = axes[0][0] * (axes[1][1] * axes[2][2] - axes[1][2] * axes[2][1]) -
+                           axes[1][0] * (axes[0][1] * axes[2][2] - axes[0][2] * axes[2][1]) +
+                           axes[2][0] * (axes[0][1] * axes[1][2] - axes[0][2] * axes[1][1]);
+        if (det < 0.0) {
+            scale[0] = -scale[0];
+            for (double& v : axes[0]) v = -v;
+        }
+        rigid = core::Transform{};
+        rigid.tx = t[0];
+        rigid.ty = t[1];
+        rigid.tz = t[2];
+        const core::Quaternion q = core::normalized(core::quaternionFromBasis(axes[0], axes[1], axes[2]));
+        if (!core::isIdentity(q)) {
+            core::setOrientation(rigid, q);
+        }
+    }
+};
+
+double unitToMillimeter(std::string_view unit) {
+    if (unit == "micron") return 0.001;
+    if (unit == "centimeter") return 10.0;
+    if (unit == "inch") return 25.4;
+    if (unit == "foot") return 304.8;
+    if (unit == "meter") return 1000.0;
+    return 1.0;
+}
+
+bool nearlyEqual(double a, double b) {
+    return std::abs(a - b) <= 1e-6 * std::max(std::abs(a), std::abs(b));
+}
+
+struct ObjectRecord {
+    std::uint64_t id{0};
+    std::string name;
+    core::TriangleMesh mesh;
+    struct Reference {
+        std::uint64_t object;
+        Affine transform;
+    };
+    std::vector<Reference> components;
+};
+
+}  // namespace
+
+bool ThreeMfReader::readFile(const std::string& path) {
+    core::PerfTimer timer("3mf.read");
+    stats_ = ThreeMfReadStats{};
+    error_.clear();
+    assembly_ = core::Assembly{};
+    meshes_.clear();
+    auto fail = [&](const std::string& message) {
+        error_ = message;
+        assembly_ = core::Assembly{};
+        meshes_.clear();
+        return false;
+    };
+
+    ZipReader zip;
+    if (!zip.open(path)) {
+        return fail(zip.error());
+    }
+    // Modellteil aus der Paket-Beziehung, sonst Standardpfad
+    std::string model_path = kModelPath;
+    std::string text;
+    if (zip.read("_rels/.rels", text)) {
+        XmlScanner scanner(text.data(), text.data() + text.size());
+        Tag tag;
+        std::string_view type;
+        std::string_view target;
+        while (scanner.next(tag)) {
+            if (tag.name == "Relationship" && attribute(tag.attributes, "Type", type) &&
+                type.size() >= 7 && type.substr(type.size() - 7) == "3dmodel" &&
+                attribute(tag.attributes, "Target", target)) {
+                model_path = std::string(target.substr(target.size() > 0 && target[0] == '/' ? 1 : 0));
+                break;
+            }
+        }
+    }
+    if (!zip.read(model_path, text)) {
+        return fail(zip.error());
+    }
+
+    // Tag-Scanner über das Modell
+    std::vector<ObjectRecord> objects;
+    std::unordered_map<std::uint64_t, std::size_t> index_of;
+    std::vector<ObjectRecord::Reference> build;
+    double unit = 1.0;
+    // Index statt Zeiger: objects wächst während des Scans
+    constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+    std::size_t open_object = kNone;
+    XmlScanner scanner(text.data(), text.data() + text.size());
+    Tag tag;
+    while (scanner.next(tag)) {
+        if (tag.closing) {
+            if (tag.name == "object") {
+                open_object = kNone;
+            }
+            continue;
+        }
+        ObjectRecord* current = open_object != kNone ? &objects[open_object] : nullptr;
+        if (tag.name == "vertex" && current) {
+            double x = 0.0, y = 0.0, z = 0.0;
+            if (!number(tag.attributes, "x", x) || !number(tag.attributes, "y", y) || !number(tag.attributes, "z", z)) {
+                return fail("Invalid vertex index in object " + std::to_string(current->id));
+            }
+            current->mesh.vertices.insert(current->mesh.vertices.end(), {x, y, z});
+        } else if (tag.name == "triangle" && current) {
+            unsigned v1 = 0, v2 = 0, v3 = 0;
+            if (!number(tag.attributes, "v1", v1) || !number(tag.attributes, "v2", v2) ||
+                !number(tag.attributes, "v3", v3)) {
+                return fail("Invalid triangle in object " + std::to_string(current->id));
+            }
+            current->mesh.indices.insert(current->mesh.indices.end(), {v1, v2, v3});
+        } else if (tag.name == "component" || tag.name == "item") {
+            ObjectRecord::Reference reference{0, Affine{}};
+            std::string_view transform;
+            if (!number(tag.attributes, "objectid", reference.object) ||
+                (attribute(tag.attributes, "transform", transform) && !Affine::parse(transform, reference.transform))) {
+                return fail("Invalid reference: <" + std::string(tag.name) + std::string(tag.attributes) + ">");
+            }
+            if (tag.name == "item") {
+                build.push_back(reference);
+            } else if (current) {
+                current->components.push_back(reference);
+            }
+        } else if (tag.name == "object") {
+            ObjectRecord record;
+            std::string_view name;
+            if (!number(tag.attributes, "id", record.id)) {
+                return fail("Object without id");
+            }
+            if (open_object != kNone) {
+                return fail("Object " + std::to_string(record.id) + " nested inside object " +
+                            std::to_string(objects[open_object].id));
+            }
+            if (attribute(tag.attributes, "name", name)) {
+                record.name = unescape(name);
+            }
+            index_of[record.id] = objects.size();
+            objects.push_back(std::move(record));
+            open_object = tag.self_closing ? kNone : objects.size() - 1;
+        } else if (tag.name == "model") {
+            std::string_view value;
+            if (attribute(tag.attributes, "unit", value)) {
+                unit = unitToMillimeter(value);
+            }
+        }
+    }
+    if (!scanner.error().empty()) {
+        return fail(scanner.error());
+    }
+    if (open_object != kNone) {
+        return fail("Object " + std::to_string(objects[open_object].id) + " not closed");
+    }
+    // Indizes erst nach dem Scan prüfen: auch Objekte ohne (korrektes) </object> werden erfasst
+    for (const ObjectRecord& object : objects) {
+        const std::size_t count = object.mesh.vertices.size() / 3;
+        for (unsigned index : object.mesh.indices) {
+            if (index >= count) {
+                return fail("Invalid vertex index in object " + std::to_string(object.id));
+            }
+        }
+    }
+    stats_.objects = objects.size();
+    stats_.build_items = build.size();
+
+    // Build-Items ablaufen; Netz-Objekte je Maßstab einmal als geteilte Definition
+    struct Variant {
+        std::size_t object;
+        double scale[3];
+    };
+    std::vector<Variant> variants;
+    std::vector<std::vector<std::size_t>> variants_of(objects.size());
+    auto definition = [&](std::size_t object, const double scale[3]) {
+        for (std::size_t v : variants_of[object]) {
+            if (nearlyEqual(variants[v].scale[0], scale[0]) && nearlyEqual(variants[v].scale[1], scale[1]) &&
+                nearlyEqual(variants[v].scale[2], scale[2])) {
+                return v;
+            }
+        }
+        Variant variant{object, {}};
+        for (int k = 0; k < 3; ++k) {
+            variant.scale[k] = nearlyEqual(scale[k], 1.0) ? 1.0 : scale[k];
+        }
+        ThreeMfMesh mesh;
+        mesh.name = objects[object].name.empty() ? "Object " + std::to_string(objects[object].id) : objects[object].name;
+        mesh.part = core::PartRef(core::Part(mesh.name));
+        variants_of[object].push_back(variants.size());
+        variants.push_back(variant);
+        meshes_.push_back(std::move(mesh));
+        return variants.size() - 1;
+    };
+    Affine root;
+    for (int k = 0; k < 3; ++k) root.r[k * 4] = unit;
+
+    struct Pending {
+        std::size_t object;
+        Affine world;
+        std::uint64_t parent;
+        core::Transform parent_rigid;
+        int depth;
+    };
+    std::vector<Pending> stack;
+    for (auto it = build.rbegin(); it != build.rend(); ++it) {
+        const auto found = index_of.find(it->object);
+        if (found == index_of.end()) {
+            return fail("Build item references missing object " + std::to_string(it->object));
+        }
+        stack.push_back(Pending{found->second, root * it->transform, 0, core::Transform{}, 0});
+    }
+    // Zyklen vor dem Aufklappen finden: Objekte auf dem aktuellen Auflösungspfad markieren
+    // (0 offen, 1 auf dem Pfad, 2 erledigt); ein erneuter Besuch auf dem Pfad ist ein Zyklus
+    std::vector<char> state(objects.size(), 0);
+    std::vector<std::pair<std::size_t, std::size_t>> resolving;  // Objekt, nächste Komponente
+    for (const Pending& start : stack) {
+        if (state[start.object] != 0) {
+            continue;
+        }
+        state[start.object] = 1;
+        resolving.emplace_back(start.object, 0);
+        while (!resolving.empty()) {
+            const std::size_t object = resolving.back().first;
+            const std::size_t next = resolving.back().second++;
+            if (next == objects[object].components.size()) {
+                state[object] = 2;
+                resolving.pop_back();
+                continue;
+            }
+            const auto found = index_of.find(objects[object].components[next].object);
+            if (found == index_of.end() || state[found->second] == 2) {
+                continue;  // fehlendes Objekt meldet das Aufklappen
+            }
+            if (state[found->second] == 1) {
+                return fail("Component cycle through object " + std::to_string(objects[found->second].id));
+            }
+            state[found->second] = 1;
+            resolving.emplace_back(found->second, 0);
+        }
+    }
+    while (!stack.empty()) {
+        const Pending pending = stack.back();
+        stack.pop_back();
+        if (pending.depth > 64) {
+            return fail("Components nested too deeply");
+        }
+        const ObjectRecord& object = objects[pending.object];
+        core::Transform rigid;
+        double scale[3];
+        pending.world.decompose(rigid, scale);
+        const core::Transform local = core::compose(core::inverse(pending.parent_rigid), rigid);
+        if (object.components.empty()) {
+            if (object.mesh.indices.empty()) {
+                continue;
+            }
+            assembly_.addComponent(meshes_[definition(pending.object, scale)].part, local, pending.parent);
+            ++stats_.instances;
+            continue;
+        }
+        const std::string name = object.name.empty() ? "Object " + std::to_string(object.id) : object.name;
+        const std::uint64_t id = assembly_.addComponent(core::PartRef(core::Part(name)), local, pending.parent);
+        for (auto it = object.components.rbegin(); it != object.components.rend(); ++it) {
+            const auto found = index_of.find(it->object);
+            if (found == index_of.end()) {
+                return fail("Component references missing object " + std::to_string(it->object));
+            }
+            stack.push_back(Pending{found->second, pending.world * it->transform, id, rigid, pending.depth + 1});
+        }
+    }
+
+    // Maßstäbe einrechnen (Spiegelung dreht den Umlaufsinn)
+    for (std::size_t v = 0; v < variants.size(); ++v) {
+        const Variant& variant = variants[v];
+        const core::TriangleMesh& source = objects[variant.object].mesh;
+        core::TriangleMesh& mesh = meshes_[v].mesh;
+        mesh.indices = source.indices;
+        mesh.vertices.resize(source.vertices.size());
+        for (std::size_t i = 0; i < source.vertices.size(); ++i) {
+            mesh.vertices[i] = source.vertices[i] * variant.scale[i % 3];
+        }
+        if (variant.scale[0] * variant.scale[1] * variant.scale[2] < 0.0) {
+            for (std::size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+                std::swap(mesh.indices[t + 1], mesh.indices[t + 2]);
+            }
+        }
+        stats_.vertices += mesh.vertices.size() / 3;
+        stats_.triangles += mesh.indices.size() / 3;
+    }
+    stats_.meshes = meshes_.size();
+    stats_.parse_ms = timer.finish().elapsed_ms;
+    return true;
+}
+
+}  // namespace interop
+}  // namespace cad
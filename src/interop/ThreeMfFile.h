@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../core/Modeler/Assembly.h"
+#include "../core/analysis/TriangleBvh.h"
+
+namespace cad {
+namespace interop {
+
+struct ThreeMfWriteOptions {
+    /** Deflate (mit zlib), sonst gespeichert. */
+    bool compress{true};
+    std::size_t buffer_bytes{1u * 1024 * 1024};
+    /** Metadaten "Title" (leer = keine). */
+    std::string title;
+};
+
+struct ThreeMfWriteStats {
+    /** Netz-Objekte (je Part-Definition eines), Komponenten-Objekte (Unterbaugruppen), Build-Items. */
+    std::size_t mesh_objects{0};
+    std::size_t component_objects{0};
+    std::size_t build_items{0};
+    std::size_t vertices{0};
+    std::size_t triangles{0};
+    std::size_t bytes{0};
+    double write_ms{0.0};
+};
+
+/**
+ * 3MF-Schreiber (Core 2015/02, Einheit mm): Modell-XML wird beim Tessellieren direkt in den ZIP-Eintrag
+ * gestreamt, es wird nie die ganze Datei gepuffert. Jede Part-Definition wird einmal als Netz-Objekt
+ * geschrieben; Vorkommen sind Build-Items bzw. <component>-Verweise mit Lage, Unterbaugruppen
+ * (parent_id) werden Komponenten-Objekte. 1000 Kopien eines Teils kosten je eine Zeile.
+ */
+class ThreeMfWriter {
+public:
+    using Tessellator = std::function<bool(const core::Part& part, core::TriangleMesh& mesh)>;
+
+    explicit ThreeMfWriter(ThreeMfWriteOptions options = {});
+
+    /** Teile ohne Netz werden übersprungen; false bei Schreibfehler (error()). */
+    bool writeAssembly(const std::string& path, const core::Assembly& assembly, const Tessellator& tessellator);
+
+    const ThreeMfWriteStats& stats() const { return stats_; }
+    const std::string& error() const { return error_; }
+
+private:
+    ThreeMfWriteOptions options_;
+    ThreeMfWriteStats stats_;
+    std::string error_;
+};
+
+/** Netz einer Part-Definition; part ist die in der Baugruppe geteilte Definition. */
+struct ThreeMfMesh {
+    std::string name;
+    core::PartRef part;
+    core::TriangleMesh mesh;
+};
+
+struct ThreeMfReadStats {
+    /** Objekte und Build-Items der Datei. */
+    std::size_t objects{0};
+    std::size_t build_items{0};
+    /** Erzeugte Komponenten mit Netz und Part-Definitionen (je Objekt und Maßstab eine). */
+    std::size_t instances{0};
+    std::size_t meshes{0};
+    std::size_t vertices{0};
+    std::size_t triangles{0};
+    double parse_ms{0.0};
+};
+
+/**
+ * 3MF-Leser: entpackt das Modell aus dem ZIP (Pfad aus _rels/.rels) und zerlegt das XML mit einem
+ * Tag-Scanner ohne DOM (vertex/triangle direkt per std::from_chars). Build-Items werden Komponenten,
+ * Komponenten-Objekte Unterbaugruppen; jedes Netz-Objekt wird eine geteilte Part-Definition, Maßstäbe
+ * aus Lagen und Einheit werden je Objekt und Maßstab einmal eingerechnet. Ergebnis in mm.
+ */
+class ThreeMfReader {
+public:
+    /** false bei ZIP-/XML-Fehler oder ungültigem Verweis (error()). */
+    bool readFile(const std::string& path);
+
+    const core::Assembly& assembly() const { return assembly_; }
+    core::Assembly takeAssembly() { return std::move(assembly_); }
+    const std::vector<ThreeMfMesh>& meshes() const { return meshes_; }
+    std::vector<ThreeMfMesh> takeMeshes() { return std::move(meshes_); }
+    const ThreeMfReadStats& stats() const { return stats_; }
+    const std::string& error() const { return error_; }
+
+private:
+    core::Assembly assembly_;
+    std::vector<ThreeMfMesh> meshes_;
+    ThreeMfReadStats stats_;
+    std::string error_;
+};
+
+}  // namespace interop
+}  // namespace cad
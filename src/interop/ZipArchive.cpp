@@ -0,0 +1,450 @@
+#include "ZipArchive.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+
+#ifdef CAD_USE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace cad {
+namespace interop {
+
+namespace {
+
+constexpr std::uint32_t kLocalHeader = 0x04034b50;
+constexpr std::uint32_t kDataDescriptor = 0x08074b50;
+constexpr std::uint32_t kCentralHeader = 0x02014b50;
+constexpr std::uint32_t kEndOfCentral = 0x06054b50;
+/** Bit 3: Größen im Datendeskriptor; Bit 11: Namen in UTF-8. */
+constexpr std::uint16_t kFlags = 0x0008 | 0x0800;
+constexpr std::uint16_t kStored = 0;
+constexpr std::uint16_t kDeflated = 8;
+/** 1980-01-01 00:00 (reproduzierbare Archive). */
+constexpr std::uint16_t kDosDate = 0x0021;
+constexpr std::size_t kChunk = 64 * 1024;
+
+void put16(std::string& out, std::uint16_t value) {
+    out.push_back(static_cast<char>(value & 0xFF));
+    out.push_back(static_cast<char>(value >> 8));
+}
+
+void put32(std::string& out, std::uint32_t value) {
+    put16(out, static_cast<std::uint16_t>(value & 0xFFFF));
+    put16(out, static_cast<std::uint16_t>(value >> 16));
+}
+
+std::uint16_t get16(const char* p) {
+    const auto* b = reinterpret_cast<const unsigned char*>(p);
+    return static_cast<std::uint16_t>(b[0] | b[1] << 8);
+}
+
+std::uint32_t get32(const char* p) {
+    return static_cast<std::uint32_t>(get16(p)) | static_cast<std::uint32_t>(get16(p + 2)) << 16;
+}
+
+}  // namespace
+
+std::uint32_t crc32Update(std::uint32_t crc, const char* data, std::size_t size) {
+#ifdef CAD_USE_ZLIB
+    while (size > 0) {
+        const uInt block = static_cast<uInt>(std::min<std::size_t>(size, std::numeric_limits<uInt>::max()));
+        crc = static_cast<std::uint32_t>(::crc32(crc, reinterpret_cast<const Bytef*>(data), block));
+        data += block;
+        size -= block;
+    }
+    return crc;
+#else
+    static const auto table = [] {
+        std::array<std::uint32_t, 256> t{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+#endif
+}
+
+struct ZipWriter::Entry {
+    std::string name;
+    std::uint16_t method{kStored};
+    std::uint32_t crc{0};
+    std::uint64_t compressed{0};
+    std::uint64_t size{0};
+    std::uint64_t local_offset{0};
+};
+
+#ifdef CAD_USE_ZLIB
+struct ZipWriter::Deflater {
+    z_stream stream{};
+    std::string out = std::string(kChunk, '\0');
+    bool active{false};
+
+    ~Deflater() {
+        if (active) {
+            deflateEnd(&stream);
+        }
+    }
+};
+#else
+struct ZipWriter::Deflater {};
+#endif
+
+ZipWriter::ZipWriter() = default;
+
+ZipWriter::~ZipWriter() = default;
+
+bool ZipWriter::fail(const std::string& message) {
+    if (error_.empty()) {
+        error_ = message;
+    }
+    return false;
+}
+
+bool ZipWriter::emit(const char* data, std::size_t size) {
+    file_.write(data, static_cast<std::streamsize>(size));
+    offset_ += size;
+    if (!file_) {
+        return fail("Write failed in ZIP archive");
+    }
+    if (offset_ > std::numeric_limits<std::uint32_t>::max()) {
+        return fail("ZIP archive larger than 4 GiB (ZIP64 not supported)");
+    }
+    return true;
+}
+
+bool ZipWriter::open(const std::string& path) {
+    entries_.clear();
+    error_.clear();
+    offset_ = 0;
+    in_entry_ = false;
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (path.empty() || !file_.is_open()) {
+        return fail("Could not create file: " + path);
+    }
+    return true;
+}
+
+bool ZipWriter::beginEntry(const std::string& name, bool compress) {
+    if (in_entry_ && !endEntry()) {
+        return false;
+    }
+    if (!file_.is_open()) {
+        return fail("ZIP archive not open");
+    }
+    Entry entry;
+    entry.name = name;
+    entry.local_offset = offset_;
+#ifdef CAD_USE_ZLIB
+    if (compress) {
+        if (!deflater_) {
+            deflater_ = std::make_unique<Deflater>();
+        }
+        Deflater& d = *deflater_;
+        if (d.active) {
+            deflateReset(&d.stream);
+        } else if (deflateInit2(&d.stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) ==
+                   Z_OK) {
+            d.active = true;
+        } else {
+            return fail("deflateInit failed");
+        }
+        entry.method = kDeflated;
+    }
+#else
+    (void)compress;
+#endif
+    std::string header;
+    put32(header, kLocalHeader);
+    put16(header, 20);
+    put16(header, kFlags);
+    put16(header, entry.method);
+    put16(header, 0);
+    put16(header, kDosDate);
+    put32(header, 0);
+    put32(header, 0);
+    put32(header, 0);
+    put16(header, static_cast<std::uint16_t>(name.size()));
+    put16(header, 0);
+    header += name;
+    entries_.push_back(std::move(entry));
+    in_entry_ = true;
+    return emit(header.data(), header.size());
+}
+
+bool ZipWriter::write(const char* data, std::size_t size) {
+    if (!in_entry_) {
+        return fail("No open ZIP entry");
+    }
+    if (!error_.empty()) {
+        return false;
+    }
+    Entry& entry = entries_.back();
+    entry.crc = crc32Update(entry.crc, data, size);
+    entry.size += size;
+#ifdef CAD_USE_ZLIB
+    if (entry.method == kDeflated) {
+        Deflater& d = *deflater_;
+        while (size > 0) {
+            const std::size_t block = std::min<std::size_t>(size, std::numeric_limits<uInt>::max());
+            d.stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+            d.stream.avail_in = static_cast<uInt>(block);
+            do {
+                d.stream.next_out = reinterpret_cast<Bytef*>(&d.out[0]);
+                d.stream.avail_out = static_cast<uInt>(d.out.size());
+                deflate(&d.stream, Z_NO_FLUSH);
+                const std::size_t produced = d.out.size() - d.stream.avail_out;
+                entry.compressed += produced;
+                if (produced > 0 && !emit(d.out.data(), produced)) {
+                    return false;
+                }
+            } while (d.stream.avail_in > 0);
+            data += block;
+            size -= block;
+        }
+        return true;
+    }
+#endif
+    entry.compressed += size;
+    return emit(data, size);
+}
+
+bool ZipWriter::endEntry() {
+    if (!in_entry_) {
+        return true;
+    }
+    in_entry_ = false;
+    Entry& entry = entries_.back();
+#ifdef CAD_USE_ZLIB
+    if (entry.method == kDeflated) {
+        Deflater& d = *deflater_;
+        d.stream.next_in = nullptr;
+        d.stream.avail_in = 0;
+        int status = Z_OK;
+        do {
+            d.stream.next_out = reinterpret_cast<Bytef*>(&d.out[0]);
+            d.stream.avail_out = static_cast<uInt>(d.out.size());
+            status = deflate(&d.stream, Z_FINISH);
+            const std::size_t produced = d.out.size() - d.stream.avail_out;
+            entry.compressed += produced;
+            if (produced > 0 && !emit(d.out.data(), produced)) {
+                return false;
+            }
+        } while (status == Z_OK);
+        if (status != Z_STREAM_END) {
+            return fail("deflate failed");
+        }
+    }
+#endif
+    std::string descriptor;
+    put32(descriptor, kDataDescriptor);
+    put32(descriptor, entry.crc);
+    put32(descriptor, static_cast<std::uint32_t>(entry.compressed));
+    put32(descriptor, static_cast<std::uint32_t>(entry.size));
+    return emit(descriptor.data(), descriptor.size());
+}
+
+bool ZipWriter::finish() {
+    if (in_entry_ && !endEntry()) {
+        return false;
+    }
+    if (!file_.is_open() || !error_.empty()) {
+        return fail("ZIP archive not open");
+    }
+    const std::uint64_t central_offset = offset_;
+    std::string central;
+    for (const Entry& entry : entries_) {
+        put32(central, kCentralHeader);
+        put16(central, 20);
+        put16(central, 20);
+        put16(central, kFlags);
+        put16(central, entry.method);
+        put16(central, 0);
+        put16(central, kDosDate);
+        put32(central, entry.crc);
+        put32(central, static_cast<std::uint32_t>(entry.compressed));
+        put32(central, static_cast<std::uint32_t>(entry.size));
+        put16(central, static_cast<std::uint16_t>(entry.name.size()));
+        put16(central, 0);
+        put16(central, 0);
+        put16(central, 0);
+        put16(central, 0);
+        put32(central, 0);
+        put32(central, static_cast<std::uint32_t>(entry.local_offset));
+        central += entry.name;
+    }
+    const std::size_t central_size = central.size();
+    put32(central, kEndOfCentral);
+    put16(central, 0);
+    put16(central, 0);
+    put16(central, static_cast<std::uint16_t>(entries_.size()));
+    put16(central, static_cast<std::uint16_t>(entries_.size()));
+    put32(central, static_cast<std::uint32_t>(central_size));
+    put32(central, static_cast<std::uint32_t>(central_offset));
+    put16(central, 0);
+    const bool ok = emit(central.data(), central.size());
+    file_.close();
+    return ok && (file_ || fail("Write failed in ZIP archive"));
+}
+
+ZipReader::ZipReader() = default;
+
+ZipReader::~ZipReader() = default;
+
+bool ZipReader::open(const std::string& path) {
+    entries_.clear();
+    error_.clear();
+    file_ = std::make_unique<MappedFile>(path, false);
+    if (!file_->ok()) {
+        error_ = "Could not open file: " + path;
+        return false;
+    }
+    const char* data = file_->data();
+    const std::size_t size = file_->size();
+    // Ende des Zentralverzeichnisses: rückwärts suchen (Kommentar bis 64 KiB)
+    std::size_t end = std::string::npos;
+    for (std::size_t i = size >= 22 ? size - 22 + 1 : 0; i-- > 0 && size - i <= 22 + 0xFFFF;) {
+        if (get32(data + i) == kEndOfCentral) {
+            end = i;
+            break;
+        }
+    }
+    if (end == std::string::npos) {
+        error_ = "Not a ZIP archive: " + path;
+        return false;
+    }
+    const std::size_t count = get16(data + end + 10);
+    std::size_t offset = get32(data + end + 16);
+    if (offset + get32(data + end + 12) != end) {
+        error_ = "Corrupt central directory";
+        return false;
+    }
+    for (std::size_t e = 0; e < count; ++e) {
+        if (offset + 46 > size || get32(data + offset) != kCentralHeader) {
+            error_ = "Corrupt central directory";
+            return false;
+        }
+        Entry entry;
+        entry.method = get16(data + offset + 10);
+        entry.crc = get32(data + offset + 16);
+        entry.compressed = get32(data + offset + 20);
+        entry.size = get32(data + offset + 24);
+        const std::size_t name_length = get16(data + offset + 28);
+        const std::size_t extra_length = get16(data + offset + 30);
+        const std::size_t comment_length = get16(data + offset + 32);
+        entry.local_offset = get32(data + offset + 42);
+        if (offset + 46 + name_length > size) {
+            error_ = "Corrupt central directory";
+            return false;
+        }
+        entry.name.assign(data + offset + 46, name_length);
+        entries_.push_back(std::move(entry));
+        offset += 46 + name_length + extra_length + comment_length;
+    }
+    return true;
+}
+
+std::vector<std::string> ZipReader::names() const {
+    std::vector<std::string> out;
+    out.reserve(entries_.size());
+    for (const Entry& entry : entries_) {
+        out.push_back(entry.name);
+    }
+    return out;
+}
+
+const ZipReader::Entry* ZipReader::find(const std::string& name) const {
+    for (const Entry& entry : entries_) {
+        // OPC-Teilnamen beginnen teils mit '/'
+        if (entry.name == name || (!name.empty() && name[0] == '/' && entry.name == name.substr(1))) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+bool ZipReader::contains(const std::string& name) const {
+    return find(name) != nullptr;
+}
+
+bool ZipReader::read(const std::string& name, std::string& out) {
+    out.clear();
+    const Entry* entry = find(name);
+    if (!file_ || !entry) {
+        error_ = "Missing entry: " + name;
+        return false;
+    }
+    const char* data = file_->data();
+    const std::size_t size = file_->size();
+    if (entry->local_offset + 30 > size || get32(data + entry->local_offset) != kLocalHeader) {
+        error_ = "Corrupt local header: " + name;
+        return false;
+    }
+    const std::size_t start =
+        entry->local_offset + 30 + get16(data + entry->local_offset + 26) + get16(data + entry->local_offset + 28);
+    if (start + entry->compressed > size) {
+        error_ = "Truncated entry: " + name;
+        return false;
+    }
+    const char* payload = data + start;
+    // Deklarierte Größe aus dem Zentralverzeichnis erst nach Plausibilitätsprüfung allokieren:
+    // Deflate komprimiert höchstens etwa 1032:1
+    const bool size_plausible = entry->method == kStored
+                                    ? entry->size == entry->compressed
+                                    : entry->size <= entry->compressed * 1032 + 64;
+    if (!size_plausible) {
+        error_ = "Declared size " + std::to_string(entry->size) + " implausible for " +
+                 std::to_string(entry->compressed) + " compressed bytes: " + name;
+        return false;
+    }
+    if (entry->method == kStored) {
+        out.assign(payload, entry->compressed);
+    } else if (entry->method == kDeflated) {
+#ifdef CAD_USE_ZLIB
+        out.resize(entry->size);
+        z_stream stream{};
+        if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+            error_ = "inflateInit failed";
+            return false;
+        }
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(payload));
+        stream.avail_in = static_cast<uInt>(entry->compressed);
+        stream.next_out = reinterpret_cast<Bytef*>(out.empty() ? nullptr : &out[0]);
+        stream.avail_out = static_cast<uInt>(out.size());
+        const int status = inflate(&stream, Z_FINISH);
+        inflateEnd(&stream);
+        if (status != Z_STREAM_END || stream.total_out != entry->size) {
+            error_ = "Decompression failed: " + name;
+            out.clear();
+            return false;
+        }
+#else
+        error_ = "Deflate not supported without zlib: " + name;
+        return false;
+#endif
+    } else {
+        error_ = "Unsupported compression method " + std::to_string(entry->method) + ": " + name;
+        return false;
+    }
+    if (crc32Update(0, out.data(), out.size()) != entry->crc) {
+        error_ = "CRC mismatch: " + name;
+        out.clear();
+        return false;
+    }
+    return true;
+}
+
+}  // namespace interop
+}  // namespace cad
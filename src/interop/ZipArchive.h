@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cad {
+namespace interop {
+
+class MappedFile;
+
+/**
+ * Streamender ZIP-Schreiber (z.B. für 3MF): Einträge werden nacheinander geschrieben, CRC und Größen
+ * folgen im Datendeskriptor, es wird nie zurückgesprungen oder eine Datei ganz gepuffert. Deflate nur mit
+ * zlib (CAD_USE_ZLIB), sonst werden Einträge unkomprimiert gespeichert. Kein ZIP64 (Archiv < 4 GiB).
+ */
+class ZipWriter {
+public:
+    ZipWriter();
+    ~ZipWriter();
+    ZipWriter(const ZipWriter&) = delete;
+    ZipWriter& operator=(const ZipWriter&) = delete;
+
+    bool open(const std::string& path);
+    /** Beendet einen offenen Eintrag; compress wird ohne zlib ignoriert. */
+    bool beginEntry(const std::string& name, bool compress = true);
+    bool write(const char* data, std::size_t size);
+    bool write(std::string_view text) { return write(text.data(), text.size()); }
+    bool endEntry();
+    /** Zentralverzeichnis schreiben und Datei schließen. */
+    bool finish();
+
+    /** Bisher geschriebene Bytes der Archivdatei. */
+    std::size_t bytes() const { return offset_; }
+    const std::string& error() const { return error_; }
+
+private:
+    struct Entry;
+    struct Deflater;
+
+    bool emit(const char* data, std::size_t size);
+    bool fail(const std::string& message);
+
+    std::ofstream file_;
+    std::vector<Entry> entries_;
+    std::unique_ptr<Deflater> deflater_;
+    bool in_entry_{false};
+    std::uint64_t offset_{0};
+    std::string error_;
+};
+
+/** ZIP-Leser über die gemappte Datei; gespeicherte und (mit zlib) deflate-Einträge. */
+class ZipReader {
+public:
+    ZipReader();
+    ~ZipReader();
+
+    bool open(const std::string& path);
+    std::vector<std::string> names() const;
+    bool contains(const std::string& name) const;
+    /** Entpackt einen Eintrag (CRC wird geprüft). */
+    bool read(const std::string& name, std::string& out);
+
+    const std::string& error() const { return error_; }
+
+private:
+    struct Entry {
+        std::string name;
+        std::uint16_t method{0};
+        std::uint32_t crc{0};
+        std::uint64_t compressed{0};
+        std::uint64_t size{0};
+        std::uint64_t local_offset{0};
+    };
+
+    const Entry* find(const std::string& name) const;
+
+    std::unique_ptr<MappedFile> file_;
+    std::vector<Entry> entries_;
+    std::string error_;
+};
+
+/** CRC-32 (ZIP), fortsetzbar: crc32Update(crc32Update(0, a), b). */
+std::uint32_t crc32Update(std::uint32_t crc, const char* data, std::size_t size);
+
+}  // namespace interop
+}  // namespace cad
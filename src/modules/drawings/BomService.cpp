@@ -23,7 +23,7 @@ std::vector<BillOfMaterialsItem> BomService::buildBomFromAssembly(const cad::cor
     // Count parts and track first occurrence for part number generation
     int part_index = 1;
     for (const auto& component : assembly.components()) {
-        const std::string& part_name = component.part.name();
+        const std::string& part_name = component.part->name();
         part_counts[part_name]++;
         if (part_numbers.find(part_name) == part_numbers.end()) {
             part_numbers[part_name] = generatePartNumber(part_name, part_index++);
@@ -1,9 +1,9 @@
 #include "SheetMetalService.h"
+#include "interop/DxfFile.h"
 
 #define _USE_MATH_DEFINES
 #include <algorithm>
 #include <cmath>
-#include <fstream>
 #include <map>
 #include <sstream>
 
@@ -357,27 +357,23 @@ bool SheetMetalService::exportFlatPatternToDxf(const std::string& part_id, const
     if (!fp.success) {
         return false;
     }
-    std::ofstream file(path);
-    if (!file.is_open()) {
-        return false;
-    }
-    file << "0\nSECTION\n2\nHEADER\n9\n$ACADVER\n1\nAC1015\n0\nENDSEC\n";
-    file << "0\nSECTION\n2\nENTITIES\n";
-    double L = fp.flat_pattern_length;
-    double W = fp.flat_pattern_width;
-    auto writeLine = [&file](double x1, double y1, double x2, double y2) {
-        file << "0\nLINE\n8\n0\n10\n" << x1 << "\n20\n" << y1 << "\n30\n0\n11\n" << x2 << "\n21\n" << y2 << "\n31\n0\n";
-    };
-    writeLine(0, 0, L, 0);
-    writeLine(L, 0, L, W);
-    writeLine(L, W, 0, W);
-    writeLine(0, W, 0, 0);
+    // Kontur als geschlossene Polylinie (eine Schneidbahn), Biegelinien als Linien
+    const double L = fp.flat_pattern_length;
+    const double W = fp.flat_pattern_width;
+    interop::DxfDrawing drawing;
+    core::GeometryEntity outline;
+    outline.type = core::GeometryType::Polygon;
+    outline.points = {{0.0, 0.0}, {L, 0.0}, {L, W}, {0.0, W}, {0.0, 0.0}};
+    outline.start_point = outline.end_point = outline.points.front();
+    drawing.entities.push_back(std::move(outline));
     for (const auto& bl : fp.resulting_bend_lines) {
-        writeLine(bl.x1, bl.y1, bl.x2, bl.y2);
+        core::GeometryEntity line;
+        line.type = core::GeometryType::Line;
+        line.start_point = {bl.x1, bl.y1};
+        line.end_point = {bl.x2, bl.y2};
+        drawing.entities.push_back(std::move(line));
     }
-    file << "0\nENDSEC\n0\nEOF\n";
-    file.close();
-    return true;
+    return interop::DxfWriter().writeDrawing(path, drawing);
 }
 
 SheetMetalResult SheetMetalService::createCut(const SheetMetalRequest& request) const {
@@ -55,6 +55,42 @@ SimulationResult SimulationService::runFeaAnalysis(const SimulationRequest& requ
 
 SimulationResult SimulationService::runMotionAnalysis(const SimulationRequest& request) const {
     SimulationResult result;
+    if (request.assembly && !request.assembly->joints().empty()) {
+        // Mehrkörperdynamik über die Gelenke der Baugruppe
+        cad::simulation::MultibodyOptions options;
+        if (request.time_step > 0.0) options.time_step = request.time_step;
+        if (request.duration > 0.0) options.duration = request.duration;
+        options.joint_drives = request.joint_drives;
+        auto mass_it = request.material_properties.find("mass");
+        if (mass_it != request.material_properties.end()) options.default_body.mass = mass_it->second;
+        auto gravity_it = request.material_properties.find("gravity");
+        if (gravity_it != request.material_properties.end()) options.gravity_z = -gravity_it->second;
+
+        cad::simulation::MultibodyResult mb = cad::simulation::MultibodySystem::simulate(*request.assembly, options);
+        result.success = mb.success;
+        result.message = mb.message;
+        result.warnings = mb.warnings;
+        result.computation_time = mb.wall_seconds;
+
+        MotionResult& motion = result.motion_result;
+        motion.simulation_time = mb.simulated_time;
+        motion.max_constraint_error = mb.max_constraint_error;
+        const std::size_t joint = mb.driven_joints.empty() ? 0 : mb.driven_joints.front();
+        const cad::simulation::MotionTimeSeries& series = mb.series;
+        for (std::size_t s = 0; s < series.sampleCount(); ++s) {
+            motion.positions.push_back(series.jointValue(s, joint));
+            motion.velocities.push_back(series.jointRate(s, joint));
+            double acceleration = 0.0;
+            if (s > 0 && series.time(s) > series.time(s - 1)) {
+                acceleration = (series.jointRate(s, joint) - series.jointRate(s - 1, joint)) /
+                               (series.time(s) - series.time(s - 1));
+            }
+            motion.accelerations.push_back(acceleration);
+        }
+        motion.trajectories = std::move(mb.series);
+        return result;
+    }
+
     result.success = true;
     result.message = "Motion analysis completed";
     
@@ -535,9 +571,10 @@ bool SimulationService::exportMotionReport(const SimulationResult& result, const
     const std::vector<double>& pos = result.motion_result.positions;
     const std::vector<double>& vel = result.motion_result.velocities;
     const std::vector<double>& acc = result.motion_result.accelerations;
+    const cad::simulation::MotionTimeSeries& series = result.motion_result.trajectories;
     double dt = result.motion_result.simulation_time / static_cast<double>(pos.empty() ? 1 : pos.size());
     for (size_t i = 0; i < pos.size(); ++i) {
-        double t = static_cast<double>(i) * dt;
+        double t = series.sampleCount() == pos.size() ? series.time(i) : static_cast<double>(i) * dt;
         double v = (i < vel.size()) ? vel[i] : 0.0;
         double a = (i < acc.size()) ? acc[i] : 0.0;
         file << t << "\t" << pos[i] << "\t" << v << "\t" << a << "\n";
@@ -4,6 +4,8 @@
 #include <vector>
 #include <map>
 
+#include "simulation/MultibodySystem.h"
+
 namespace cad {
 namespace modules {
 
@@ -30,10 +32,14 @@ struct FeaResult {
 };
 
 struct MotionResult {
+    /** Koordinate des ersten angetriebenen Gelenks (sonst Gelenk 1) je Sample. */
     std::vector<double> positions;
     std::vector<double> velocities;
     std::vector<double> accelerations;
     double simulation_time{0.0};
+    /** Mehrkörperdynamik: Trajektorien aller Körper + Gelenkkoordinaten (leer ohne Baugruppe). */
+    cad::simulation::MotionTimeSeries trajectories;
+    double max_constraint_error{0.0};
 };
 
 /** Joint-Antrieb für dynamische Simulation (17.7): Gelenkname -> Winkelgeschwindigkeit [rad/s] oder Geschwindigkeit [m/s]. */
@@ -46,6 +52,8 @@ struct SimulationRequest {
     std::map<std::string, double> material_properties;
     /** Antriebe pro Gelenk (z.B. "Revolute1" -> 1.0 für 1 rad/s). */
     std::map<std::string, double> joint_drives;
+    /** Motion: Baugruppe mit Gelenken → Mehrkörperdynamik; nullptr = analytisches Ein-Freiheitsgrad-Modell. */
+    const cad::core::Assembly* assembly{nullptr};
 };
 
 struct SimulationResult {
@@ -0,0 +1,631 @@
+#include "MultibodySystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace cad {
+namespace simulation {
+
+void MotionTimeSeries::reset(std::vector<std::uint64_t> body_ids, std::size_t joint_count,
+                             std::size_t reserve_samples) {
+    body_ids_ = std::move(body_ids);
+    joint_count_ = joint_count;
+    times_.clear();
+    data_.clear();
+    times_.reserve(reserve_samples);
+    data_.reserve(reserve_samples * frameSize());
+}
+
+void MotionTimeSeries::append(double time, const std::vector<float>& frame) {
+    times_.push_back(time);
+    data_.insert(data_.end(), frame.begin(), frame.begin() + static_cast<std::ptrdiff_t>(frameSize()));
+}
+
+core::Transform MotionTimeSeries::transform(std::size_t sample, std::size_t body) const {
+    const float* f = &data_[sample * frameSize() + body * kBodyChannels];
+    core::Transform t;
+    t.tx = f[0];
+    t.ty = f[1];
+    t.tz = f[2];
+    core::setOrientation(t, core::Quaternion{f[3], f[4], f[5], f[6]});
+    return t;
+}
+
+double MotionTimeSeries::jointValue(std::size_t sample, std::size_t joint) const {
+    return data_[sample * frameSize() + body_ids_.size() * kBodyChannels + joint * kJointChannels];
+}
+
+double MotionTimeSeries::jointRate(std::size_t sample, std::size_t joint) const {
+    return data_[sample * frameSize() + body_ids_.size() * kBodyChannels + joint * kJointChannels + 1];
+}
+
+std::size_t MotionTimeSeries::memoryBytes() const {
+    return times_.size() * sizeof(double) + data_.size() * sizeof(float);
+}
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kInf = std::numeric_limits<double>::infinity();
+
+struct V3 {
+    double x{0.0};
+    double y{0.0};
+    double z{0.0};
+};
+
+inline V3 operator+(const V3& a, const V3& b) { return V3{a.x + b.x, a.y + b.y, a.z + b.z}; }
+inline V3 operator-(const V3& a, const V3& b) { return V3{a.x - b.x, a.y - b.y, a.z - b.z}; }
+inline V3 operator-(const V3& a) { return V3{-a.x, -a.y, -a.z}; }
+inline V3 operator*(const V3& a, double s) { return V3{a.x * s, a.y * s, a.z * s}; }
+inline double dot(const V3& a, const V3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+inline V3 cross(const V3& a, const V3& b) {
+    return V3{a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+inline double norm(const V3& a) { return std::sqrt(dot(a, a)); }
+inline V3 unit(const V3& a) {
+    const double n = norm(a);
+    return n > 1e-12 ? a * (1.0 / n) : V3{};
+}
+
+inline V3 rotate(const core::Quaternion& q, V3 v) {
+    core::rotateVector(q, v.x, v.y, v.z);
+    return v;
+}
+
+inline V3 rotateInv(const core::Quaternion& q, V3 v) {
+    core::rotateVector(core::conjugate(q), v.x, v.y, v.z);
+    return v;
+}
+
+inline double wrapAngle(double a) {
+    a = std::fmod(a, 2.0 * kPi);
+    if (a > kPi) a -= 2.0 * kPi;
+    if (a <= -kPi) a += 2.0 * kPi;
+    return a;
+}
+
+/** Orthonormale Ergänzung t1, t2 zu n (|n| = 1). */
+void basis(const V3& n, V3& t1, V3& t2) {
+    const V3 helper = std::abs(n.x) < 0.9 ? V3{1.0, 0.0, 0.0} : V3{0.0, 1.0, 0.0};
+    t1 = unit(cross(n, helper));
+    t2 = cross(n, t1);
+}
+
+struct Body {
+    V3 x;
+    core::Quaternion q;
+    V3 v;
+    V3 w;
+    double inv_mass{0.0};
+    double inv_inertia{0.0};
+};
+
+/** Zwangszeile J v + bias = 0 (bilateral) bzw. ≥ 0 mit lambda in [lo, hi]. */
+struct Row {
+    int a{0};
+    int b{0};
+    V3 lin_a;
+    V3 ang_a;
+    V3 lin_b;
+    V3 ang_b;
+    double bias{0.0};
+    double inv_eff{0.0};
+    double lambda{0.0};
+    double lo{-kInf};
+    double hi{kInf};
+};
+
+enum class Coordinate { None, Angle, Travel };
+
+struct JointState {
+    core::JointType type{core::JointType::Rigid};
+    int a{0};
+    int b{0};
+    V3 ra, rb;          // Anker lokal in A bzw. B
+    V3 axis_a, axis_b;  // Achse lokal
+    V3 perp_a, perp_b;  // Referenz-Senkrechte für den Drehwinkel
+    V3 slot_a;          // Schlitzrichtung lokal in A (PinSlot)
+    core::Quaternion rel0;
+    Coordinate coordinate{Coordinate::None};
+    bool driven{false};
+    double drive_rate{0.0};
+    bool limited{false};
+    double low{0.0};
+    double high{0.0};
+    double value{0.0};
+    double prev_wrapped{0.0};
+};
+
+/** Weltgrößen eines Gelenks bei aktueller Lage. */
+struct Frame {
+    V3 raw, rbw;
+    V3 d;
+    V3 aw, bw;
+    V3 travel_dir;
+};
+
+const char* jointTypeName(core::JointType type) {
+    switch (type) {
+        case core::JointType::Rigid: return "Rigid";
+        case core::JointType::Revolute: return "Revolute";
+        case core::JointType::Slider: return "Slider";
+        case core::JointType::Cylindrical: return "Cylindrical";
+        case core::JointType::Planar: return "Planar";
+        case core::JointType::PinSlot: return "PinSlot";
+    }
+    return "Joint";
+}
+
+class Engine {
+public:
+    Engine(const MultibodyOptions& options, MultibodyResult& result) : options_(options), result_(result) {}
+
+    bool build(const core::Assembly& assembly);
+    void run();
+
+private:
+    Frame frameOf(const JointState& j) const;
+    void updateCoordinate(JointState& j) const;
+    double coordinateRate(const JointState& j, const Frame& f) const;
+    void coordinateRow(const JointState& j, const Frame& f, Row& row) const;
+    void linearRow(const JointState& j, const Frame& f, const V3& t, bool attached, Row& row) const;
+    void angularRow(const JointState& j, const V3& t, Row& row) const;
+    void pushBilateral(Row row, double error);
+    void buildRows(double time);
+    void finalizeRow(Row& row) const;
+    void applyImpulse(const Row& row, double impulse);
+    double velocityOf(const Row& row) const;
+    void record(double time);
+
+    const MultibodyOptions& options_;
+    MultibodyResult& result_;
+    std::vector<Body> bodies_;
+    std::vector<std::uint64_t> body_ids_;
+    std::vector<JointState> joints_;
+    std::vector<Row> rows_;
+    std::vector<double> warm_;
+    std::vector<float> frame_;
+    double dt_{0.001};
+    double step_error_{0.0};
+};
+
+Frame Engine::frameOf(const JointState& j) const {
+    const Body& A = bodies_[static_cast<std::size_t>(j.a)];
+    const Body& B = bodies_[static_cast<std::size_t>(j.b)];
+    Frame f;
+    f.raw = rotate(A.q, j.ra);
+    f.rbw = rotate(B.q, j.rb);
+    f.d = (B.x + f.rbw) - (A.x + f.raw);
+    f.aw = rotate(A.q, j.axis_a);
+    f.bw = rotate(B.q, j.axis_b);
+    f.travel_dir = j.type == core::JointType::PinSlot ? rotate(A.q, j.slot_a) : f.aw;
+    return f;
+}
+
+void Engine::updateCoordinate(JointState& j) const {
+    const Frame f = frameOf(j);
+    if (j.coordinate == Coordinate::Angle) {
+        const V3 pa = rotate(bodies_[static_cast<std::size_t>(j.a)].q, j.perp_a);
+        const V3 pb = rotate(bodies_[static_cast<std::size_t>(j.b)].q, j.perp_b);
+        const double wrapped = std::atan2(dot(f.aw, cross(pa, pb)), dot(pa, pb));
+        j.value += wrapAngle(wrapped - j.prev_wrapped);
+        j.prev_wrapped = wrapped;
+    } else if (j.coordinate == Coordinate::Travel) {
+        j.value = dot(f.travel_dir, f.d);
+    }
+}
+
+void Engine::linearRow(const JointState& j, const Frame& f, const V3& t, bool attached, Row& row) const {
+    // d/dt (t·d); bei attached dreht t mit A: zusätzlicher Term (ωA × t)·d
+    row.a = j.a;
+    row.b = j.b;
+    row.lin_a = -t;
+    row.ang_a = -cross(attached ? f.raw + f.d : f.raw, t);
+    row.lin_b = t;
+    row.ang_b = cross(f.rbw, t);
+}
+
+void Engine::angularRow(const JointState& j, const V3& t, Row& row) const {
+    row.a = j.a;
+    row.b = j.b;
+    row.ang_a = -t;
+    row.ang_b = t;
+}
+
+void Engine::coordinateRow(const JointState& j, const Frame& f, Row& row) const {
+    if (j.coordinate == Coordinate::Angle) {
+        angularRow(j, f.aw, row);
+    } else {
+        linearRow(j, f, f.travel_dir, true, row);
+    }
+}
+
+double Engine::coordinateRate(const JointState& j, const Frame& f) const {
+    if (j.coordinate == Coordinate::None) {
+        return 0.0;
+    }
+    Row row;
+    coordinateRow(j, f, row);
+    return velocityOf(row);
+}
+
+void Engine::finalizeRow(Row& row) const {
+    const Body& A = bodies_[static_cast<std::size_t>(row.a)];
+    const Body& B = bodies_[static_cast<std::size_t>(row.b)];
+    const double k = A.inv_mass * dot(row.lin_a, row.lin_a) + A.inv_inertia * dot(row.ang_a, row.ang_a) +
+                     B.inv_mass * dot(row.lin_b, row.lin_b) + B.inv_inertia * dot(row.ang_b, row.ang_b);
+    row.inv_eff = k > 1e-15 ? 1.0 / k : 0.0;
+}
+
+void Engine::pushBilateral(Row row, double error) {
+    row.bias = options_.baumgarte / dt_ * error;
+    step_error_ = std::max(step_error_, std::abs(error));
+    finalizeRow(row);
+    rows_.push_back(row);
+}
+
+void Engine::buildRows(double time) {
+    rows_.clear();
+    step_error_ = 0.0;
+    const V3 world_axes[3] = {V3{1.0, 0.0, 0.0}, V3{0.0, 1.0, 0.0}, V3{0.0, 0.0, 1.0}};
+    for (JointState& j : joints_) {
+        updateCoordinate(j);
+        const Frame f = frameOf(j);
+        V3 t1, t2;
+        basis(f.aw, t1, t2);
+        const V3 misalign = cross(f.aw, f.bw);
+        Row row;
+
+        switch (j.type) {
+            case core::JointType::Revolute:
+            case core::JointType::Rigid:
+                for (const V3& e : world_axes) {
+                    row = Row{};
+                    linearRow(j, f, e, false, row);
+                    pushBilateral(row, dot(e, f.d));
+                }
+                break;
+            case core::JointType::Slider:
+            case core::JointType::Cylindrical:
+                for (const V3& t : {t1, t2}) {
+                    row = Row{};
+                    linearRow(j, f, t, true, row);
+                    pushBilateral(row, dot(t, f.d));
+                }
+                break;
+            case core::JointType::Planar:
+                row = Row{};
+                linearRow(j, f, f.aw, true, row);
+                pushBilateral(row, dot(f.aw, f.d));
+                break;
+            case core::JointType::PinSlot: {
+                const V3 across = unit(cross(f.aw, f.travel_dir));
+                for (const V3& t : {f.aw, across}) {
+                    row = Row{};
+                    linearRow(j, f, t, true, row);
+                    pushBilateral(row, dot(t, f.d));
+                }
+                break;
+            }
+        }
+
+        if (j.type == core::JointType::Rigid) {
+            const core::Quaternion& qa = bodies_[static_cast<std::size_t>(j.a)].q;
+            const core::Quaternion& qb = bodies_[static_cast<std::size_t>(j.b)].q;
+            core::Quaternion qd = core::multiply(qb, core::conjugate(core::multiply(qa, j.rel0)));
+            const double sign = qd.w < 0.0 ? -2.0 : 2.0;
+            const double err[3] = {qd.x * sign, qd.y * sign, qd.z * sign};
+            for (int k = 0; k < 3; ++k) {
+                row = Row{};
+                angularRow(j, world_axes[k], row);
+                pushBilateral(row, err[k]);
+            }
+        } else {
+            // Achsen fluchten (2 Drehfreiheitsgrade sperren)
+            for (const V3& t : {t1, t2}) {
+                row = Row{};
+                angularRow(j, t, row);
+                pushBilateral(row, dot(t, misalign));
+            }
+        }
+        if (j.type == core::JointType::Slider) {
+            const V3 pa = rotate(bodies_[static_cast<std::size_t>(j.a)].q, j.perp_a);
+            const V3 pb = rotate(bodies_[static_cast<std::size_t>(j.b)].q, j.perp_b);
+            row = Row{};
+            angularRow(j, f.aw, row);
+            pushBilateral(row, std::atan2(dot(f.aw, cross(pa, pb)), dot(pa, pb)));
+        }
+
+        if (j.coordinate == Coordinate::None) {
+            continue;
+        }
+        if (j.driven) {
+            // Rheonome Zwangsbedingung: value(t) = drive_rate * t
+            row = Row{};
+            coordinateRow(j, f, row);
+            row.bias = -j.drive_rate + options_.baumgarte / dt_ * (j.value - j.drive_rate * time);
+            finalizeRow(row);
+            rows_.push_back(row);
+        }
+        if (j.limited) {
+            // Einseitig: value - low ≥ 0 und high - value ≥ 0 (spekulativ, solange frei)
+            for (int side = 0; side < 2; ++side) {
+                row = Row{};
+                coordinateRow(j, f, row);
+                const double gap = side == 0 ? j.value - j.low : j.high - j.value;
+                if (side == 1) {
+                    row.lin_a = -row.lin_a;
+                    row.ang_a = -row.ang_a;
+                    row.lin_b = -row.lin_b;
+                    row.ang_b = -row.ang_b;
+                }
+                row.bias = gap >= 0.0 ? gap / dt_ : options_.baumgarte / dt_ * gap;
+                row.lo = 0.0;
+                finalizeRow(row);
+                rows_.push_back(row);
+            }
+        }
+    }
+}
+
+double Engine::velocityOf(const Row& row) const {
+    const Body& A = bodies_[static_cast<std::size_t>(row.a)];
+    const Body& B = bodies_[static_cast<std::size_t>(row.b)];
+    return dot(row.lin_a, A.v) + dot(row.ang_a, A.w) + dot(row.lin_b, B.v) + dot(row.ang_b, B.w);
+}
+
+void Engine::applyImpulse(const Row& row, double impulse) {
+    Body& A = bodies_[static_cast<std::size_t>(row.a)];
+    Body& B = bodies_[static_cast<std::size_t>(row.b)];
+    A.v = A.v + row.lin_a * (A.inv_mass * impulse);
+    A.w = A.w + row.ang_a * (A.inv_inertia * impulse);
+    B.v = B.v + row.lin_b * (B.inv_mass * impulse);
+    B.w = B.w + row.ang_b * (B.inv_inertia * impulse);
+}
+
+void Engine::record(double time) {
+    std::size_t k = 0;
+    for (const Body& body : bodies_) {
+        frame_[k++] = static_cast<float>(body.x.x);
+        frame_[k++] = static_cast<float>(body.x.y);
+        frame_[k++] = static_cast<float>(body.x.z);
+        frame_[k++] = static_cast<float>(body.q.w);
+        frame_[k++] = static_cast<float>(body.q.x);
+        frame_[k++] = static_cast<float>(body.q.y);
+        frame_[k++] = static_cast<float>(body.q.z);
+    }
+    for (JointState& j : joints_) {
+        updateCoordinate(j);
+        frame_[k++] = static_cast<float>(j.value);
+        frame_[k++] = static_cast<float>(coordinateRate(j, frameOf(j)));
+    }
+    result_.series.append(time, frame_);
+    if (options_.on_sample) {
+        options_.on_sample(result_.series, result_.series.sampleCount() - 1);
+    }
+}
+
+bool Engine::build(const core::Assembly& assembly) {
+    const auto& joints = assembly.joints();
+    if (joints.empty()) {
+        result_.message = "Keine Gelenke in der Baugruppe";
+        return false;
+    }
+    if (!(options_.time_step > 0.0) || !(options_.duration > 0.0)) {
+        result_.message = "Ungültiger Zeitschritt oder Dauer";
+        return false;
+    }
+    dt_ = options_.time_step;
+    // Fixiert wird ein tatsächlicher Körper: Komponenten ohne Gelenk werden nie zu Körpern
+    std::unordered_set<std::uint64_t> jointed;
+    for (const core::Joint& src : joints) {
+        jointed.insert(src.component_a);
+        jointed.insert(src.component_b);
+    }
+    std::uint64_t ground_id = options_.ground_component;
+    if (ground_id == 0) {
+        for (const auto& component : assembly.components()) {
+            if (jointed.count(component.id) != 0) {
+                ground_id = component.id;
+                break;
+            }
+        }
+    } else if (jointed.count(ground_id) == 0) {
+        result_.message = "Fixierte Komponente " + std::to_string(ground_id) + " ist an keinem Gelenk beteiligt";
+        return false;
+    }
+
+    std::unordered_map<std::uint64_t, int> body_index;
+    auto bodyFor = [&](std::uint64_t id) -> int {
+        auto it = body_index.find(id);
+        if (it != body_index.end()) return it->second;
+        if (!assembly.findComponent(id)) return -1;
+        const core::Transform world = assembly.worldTransform(id);
+        Body body;
+        body.x = V3{world.tx, world.ty, world.tz};
+        body.q = core::normalized(core::orientationOf(world));
+        if (id != ground_id) {
+            auto props = options_.bodies.find(id);
+            const BodyProperties& p = props != options_.bodies.end() ? props->second : options_.default_body;
+            if (p.mass > 0.0) {
+                body.inv_mass = 1.0 / p.mass;
+                const double k = std::max(p.radius_of_gyration, 1e-6);
+                body.inv_inertia = 1.0 / (p.mass * k * k);
+            }
+        }
+        const int index = static_cast<int>(bodies_.size());
+        bodies_.push_back(body);
+        body_ids_.push_back(id);
+        body_index.emplace(id, index);
+        return index;
+    };
+
+    std::map<std::string, bool> drive_used;
+    for (const auto& [name, rate] : options_.joint_drives) {
+        (void)rate;
+        drive_used[name] = false;
+    }
+
+    for (std::size_t i = 0; i < joints.size(); ++i) {
+        const core::Joint& src = joints[i];
+        JointState j;
+        j.type = src.type;
+        j.a = bodyFor(src.component_a);
+        j.b = bodyFor(src.component_b);
+        if (j.a < 0 || j.b < 0 || j.a == j.b) {
+            result_.message = "Gelenk " + std::to_string(i + 1) + ": ungültige Komponenten";
+            return false;
+        }
+        const V3 axis = unit(V3{src.axis_direction.x, src.axis_direction.y, src.axis_direction.z});
+        if (norm(axis) < 0.5) {
+            result_.message = "Gelenk " + std::to_string(i + 1) + ": Achse ist Nullvektor";
+            return false;
+        }
+        const Body& A = bodies_[static_cast<std::size_t>(j.a)];
+        const Body& B = bodies_[static_cast<std::size_t>(j.b)];
+        const V3 origin{src.axis_origin.x, src.axis_origin.y, src.axis_origin.z};
+        V3 t1, t2;
+        basis(axis, t1, t2);
+        V3 slot = unit(V3{src.slot_direction.x, src.slot_direction.y, src.slot_direction.z});
+        slot = unit(slot - axis * dot(slot, axis));
+        if (norm(slot) < 0.5) slot = t1;
+
+        j.ra = rotateInv(A.q, origin - A.x);
+        j.rb = rotateInv(B.q, origin - B.x);
+        j.axis_a = rotateInv(A.q, axis);
+        j.axis_b = rotateInv(B.q, axis);
+        j.perp_a = rotateInv(A.q, t1);
+        j.perp_b = rotateInv(B.q, t1);
+        j.slot_a = rotateInv(A.q, slot);
+        j.rel0 = core::multiply(core::conjugate(A.q), B.q);
+
+        switch (src.type) {
+            case core::JointType::Revolute:
+            case core::JointType::Cylindrical:
+                j.coordinate = Coordinate::Angle;
+                break;
+            case core::JointType::Slider:
+            case core::JointType::PinSlot:
+                j.coordinate = Coordinate::Travel;
+                break;
+            case core::JointType::Planar:
+            case core::JointType::Rigid:
+                break;
+        }
+        j.limited = j.coordinate != Coordinate::None && std::isfinite(src.limit_low) &&
+                    std::isfinite(src.limit_high) && src.limit_low < src.limit_high;
+        j.low = src.limit_low;
+        j.high = src.limit_high;
+
+        const std::string type_name = jointTypeName(src.type);
+        const std::string n = std::to_string(i + 1);
+        for (const std::string& name : {type_name + "_" + n, type_name + n}) {
+            auto drive = options_.joint_drives.find(name);
+            if (drive == options_.joint_drives.end()) continue;
+            drive_used[name] = true;
+            if (j.coordinate == Coordinate::None) {
+                result_.warnings.push_back("Antrieb auf Gelenk ohne Koordinate ignoriert: " + name);
+                continue;
+            }
+            if (!j.driven) result_.driven_joints.push_back(i);
+            j.driven = true;
+            j.drive_rate = drive->second;
+        }
+        joints_.push_back(j);
+    }
+    for (const auto& [name, used] : drive_used) {
+        if (!used) result_.warnings.push_back("Antrieb ohne passendes Gelenk: " + name);
+    }
+    return true;
+}
+
+void Engine::run() {
+    const std::size_t steps = std::max<std::size_t>(1, static_cast<std::size_t>(std::llround(options_.duration / dt_)));
+    std::size_t stride = options_.sample_stride;
+    if (stride == 0) {
+        const std::size_t max_samples = std::max<std::size_t>(1, options_.max_samples);
+        stride = std::max<std::size_t>(1, (steps + max_samples - 1) / max_samples);
+    }
+    result_.series.reset(body_ids_, joints_.size(), steps / stride + 2);
+    frame_.assign(result_.series.frameSize(), 0.0f);
+    record(0.0);
+
+    const V3 gravity{options_.gravity_x, options_.gravity_y, options_.gravity_z};
+    const int iterations = std::max(1, options_.solver_iterations);
+    for (std::size_t n = 1; n <= steps; ++n) {
+        const double time = static_cast<double>(n - 1) * dt_;
+        for (Body& body : bodies_) {
+            if (body.inv_mass > 0.0) body.v = body.v + gravity * dt_;
+        }
+
+        buildRows(time);
+        result_.max_constraint_error = std::max(result_.max_constraint_error, step_error_);
+        warm_.resize(rows_.size(), 0.0);
+        for (std::size_t r = 0; r < rows_.size(); ++r) {
+            Row& row = rows_[r];
+            if (row.inv_eff == 0.0) continue;
+            row.lambda = std::min(row.hi, std::max(row.lo, warm_[r]));
+            applyImpulse(row, row.lambda);
+        }
+        for (int it = 0; it < iterations; ++it) {
+            for (Row& row : rows_) {
+                if (row.inv_eff == 0.0) continue;
+                const double delta = -(velocityOf(row) + row.bias) * row.inv_eff;
+                const double next = std::min(row.hi, std::max(row.lo, row.lambda + delta));
+                applyImpulse(row, next - row.lambda);
+                row.lambda = next;
+            }
+        }
+        for (std::size_t r = 0; r < rows_.size(); ++r) {
+            warm_[r] = rows_[r].lambda;
+        }
+
+        for (Body& body : bodies_) {
+            if (body.inv_mass == 0.0) continue;
+            body.x = body.x + body.v * dt_;
+            const core::Quaternion spin{0.0, body.w.x, body.w.y, body.w.z};
+            const core::Quaternion dq = core::multiply(spin, body.q);
+            body.q = core::normalized(core::Quaternion{body.q.w + 0.5 * dt_ * dq.w, body.q.x + 0.5 * dt_ * dq.x,
+                                                       body.q.y + 0.5 * dt_ * dq.y, body.q.z + 0.5 * dt_ * dq.z});
+            if (!std::isfinite(body.x.x + body.x.y + body.x.z + body.v.x + body.v.y + body.v.z)) {
+                result_.message = "Integration instabil bei t = " + std::to_string(time) + " s";
+                result_.steps = n;
+                return;
+            }
+        }
+        for (JointState& j : joints_) {
+            updateCoordinate(j);
+        }
+        if (n % stride == 0 || n == steps) {
+            record(static_cast<double>(n) * dt_);
+        }
+    }
+    result_.steps = steps;
+    result_.simulated_time = static_cast<double>(steps) * dt_;
+    result_.success = true;
+    result_.message = "Motion analysis completed (" + std::to_string(steps) + " steps, " +
+                      std::to_string(bodies_.size()) + " bodies, " + std::to_string(joints_.size()) + " joints)";
+}
+
+}  // namespace
+
+MultibodyResult MultibodySystem::simulate(const core::Assembly& assembly, const MultibodyOptions& options) {
+    MultibodyResult result;
+    const auto start = std::chrono::steady_clock::now();
+    Engine engine(options, result);
+    if (engine.build(assembly)) {
+        engine.run();
+    }
+    result.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+}  // namespace simulation
+}  // namespace cad
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "core/Modeler/Assembly.h"
+
+namespace cad {
+namespace simulation {
+
+/** Masseneigenschaften eines Körpers (Einheiten: kg, mm). Trägheit isotrop: I = m * k². */
+struct BodyProperties {
+    double mass{1.0};
+    double radius_of_gyration{50.0};
+};
+
+class MotionTimeSeries;
+
+struct MultibodyOptions {
+    double time_step{0.001};  // s
+    double duration{1.0};     // s
+    /** Schwerkraft in mm/s² (Baugruppen-Koordinaten). */
+    double gravity_x{0.0};
+    double gravity_y{0.0};
+    double gravity_z{-9810.0};
+    BodyProperties default_body{};
+    /** Fixierte Komponente; 0 = erste Komponente der Baugruppe, die an einem Gelenk beteiligt ist. */
+    std::uint64_t ground_component{0};
+    /** Komponenten-ID -> Masseneigenschaften (sonst default_body). */
+    std::map<std::uint64_t, BodyProperties> bodies;
+    /** Antriebe je Gelenk ("Revolute_1" wie von createRevolute, oder "Revolute1"): rad/s bzw. mm/s. */
+    std::map<std::string, double> joint_drives;
+    /** Gauss-Seidel-Iterationen je Schritt über die dünnbesetzten Zwangszeilen. */
+    int solver_iterations{30};
+    /** Baumgarte-Stabilisierung (Anteil des Positionsfehlers, der pro Schritt korrigiert wird). */
+    double baumgarte{0.2};
+    /** Nur jeden n-ten Schritt aufzeichnen; 0 = automatisch, sodass höchstens max_samples entstehen. */
+    std::size_t sample_stride{0};
+    std::size_t max_samples{4096};
+    /** Streaming: wird nach jedem aufgezeichneten Sample aufgerufen (z.B. Animation während der Rechnung). */
+    std::function<void(const MotionTimeSeries&, std::size_t sample)> on_sample;
+};
+
+/**
+ * Kompakter Zeitreihen-Puffer (float): je Sample pro Körper Position (3) + Quaternion (4) und
+ * pro Gelenk Koordinate + Geschwindigkeit (rad bzw. mm, rad/s bzw. mm/s).
+ */
+class MotionTimeSeries {
+public:
+    static constexpr std::size_t kBodyChannels = 7;
+    static constexpr std::size_t kJointChannels = 2;
+
+    void reset(std::vector<std::uint64_t> body_ids, std::size_t joint_count, std::size_t reserve_samples = 0);
+    void append(double time, const std::vector<float>& frame);
+
+    std::size_t sampleCount() const { return times_.size(); }
+    std::size_t bodyCount() const { return body_ids_.size(); }
+    std::size_t jointCount() const { return joint_count_; }
+    const std::vector<std::uint64_t>& bodyIds() const { return body_ids_; }
+    /** Werte je Sample (Körper-Kanäle, dann Gelenk-Kanäle). */
+    std::size_t frameSize() const { return body_ids_.size() * kBodyChannels + joint_count_ * kJointChannels; }
+
+    double time(std::size_t sample) const { return times_[sample]; }
+    core::Transform transform(std::size_t sample, std::size_t body) const;
+    double jointValue(std::size_t sample, std::size_t joint) const;
+    double jointRate(std::size_t sample, std::size_t joint) const;
+    std::size_t memoryBytes() const;
+
+private:
+    std::vector<std::uint64_t> body_ids_;
+    std::size_t joint_count_{0};
+    std::vector<double> times_;
+    std::vector<float> data_;
+};
+
+struct MultibodyResult {
+    bool success{false};
+    std::string message;
+    std::vector<std::string> warnings;
+    std::size_t steps{0};
+    double simulated_time{0.0};
+    /** Größter Zwangsfehler (mm bzw. rad) der bilateralen Gelenkbedingungen über alle Schritte. */
+    double max_constraint_error{0.0};
+    double wall_seconds{0.0};
+    /** Indizes (in Assembly::joints()) der angetriebenen Gelenke. */
+    std::vector<std::size_t> driven_joints;
+    MotionTimeSeries series;
+};
+
+/**
+ * Mehrkörperdynamik (§17.7): jede an Gelenken beteiligte Komponente ist ein Starrkörper, fixiert ist
+ * ground_component bzw. die erste an einem Gelenk beteiligte Komponente der Baugruppe. Gelenke (Revolute, Slider, Cylindrical, Planar, PinSlot, Rigid)
+ * und Antriebe werden als Zwangszeilen in Maximalkoordinaten formuliert; Integration semi-implizit
+ * (symplektisches Euler) mit Baumgarte-stabilisierter Geschwindigkeitsprojektion, gelöst per
+ * projiziertem Gauss-Seidel (warm gestartet) über die dünnbesetzten Zeilen. Limits als einseitige Zeilen.
+ * Gelenkachsen/-ursprünge gelten in Baugruppenkoordinaten zum Startzeitpunkt.
+ */
+class MultibodySystem {
+public:
+    static MultibodyResult simulate(const core::Assembly& assembly, const MultibodyOptions& options);
+};
+
+}  // namespace simulation
+}  // namespace cad
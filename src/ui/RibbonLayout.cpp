@@ -24,7 +24,7 @@ void RibbonLayout::configureDefaultTabs() {
                              "RigidPipe", "FlexibleHose", "BentTube", "RouteBOM",
                              "Weld", "WeldBOM", "Simplify"};
     commands_["Drawing"] = {"BaseView", "Section", "DetailView", "Dimension", "PartsList"};
-    commands_["Inspect"] = {"Measure", "Interference", "SectionAnalysis",
+    commands_["Inspect"] = {"Measure", "Interference", "Clearance", "SectionAnalysis",
                             "Simulation", "StressAnalysis", "ExportFEAReport", "ExportMotionReport"};
     commands_["Manage"] = {"Parameters", "iLogic", "Styles", "AddIns", "Import", "Export", "ExportRFA", "MbdNote"};
     commands_["View"] = {"Visibility", "Appearance", "Environment",
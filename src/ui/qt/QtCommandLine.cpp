@@ -183,7 +183,7 @@ void QtCommandLine::initializeValidCommands() {
         "LoadAssembly", "Place", "Mate", "Flush", "Angle", "Parallel", "Distance", "Pattern", "ExplosionView",
         "RigidPipe", "FlexibleHose", "BentTube", "RouteBOM", "Weld", "WeldBOM", "Simplify",
         "BaseView", "Section", "DetailView", "Dimension", "PartsList",
-        "Measure", "Interference", "SectionAnalysis",
+        "Measure", "Interference", "Clearance", "SectionAnalysis",
         "Simulation", "StressAnalysis", "ExportFEAReport", "ExportMotionReport",
         "Styles", "AddIns", "Import", "Export", "ExportRFA", "MbdNote",
         "Visibility", "Appearance", "Environment",
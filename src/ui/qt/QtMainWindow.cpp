@@ -51,7 +51,7 @@ QString categoryForCommand(const QString& command) {
     const QSet<QString> assembly = {"Place", "Mate", "Flush", "Angle", "Parallel", "Distance", "Pattern",
                                     "RigidPipe", "FlexibleHose", "BentTube", "RouteBOM", "Weld", "WeldBOM", "Simplify"};
     const QSet<QString> drawing = {"BaseView", "Section", "Dimension", "PartsList"};
-    const QSet<QString> inspect = {"Measure", "Interference", "SectionAnalysis",
+    const QSet<QString> inspect = {"Measure", "Interference", "Clearance", "SectionAnalysis",
                                    "Simulation", "StressAnalysis", "ExportFEAReport", "ExportMotionReport"};
     const QSet<QString> manage = {"Parameters", "iLogic", "Styles", "AddIns", "Import",
                                   "Export", "ExportRFA", "MbdNote"};
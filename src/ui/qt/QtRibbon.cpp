@@ -53,7 +53,7 @@ QtRibbon::QtRibbon(QWidget* parent) : QTabWidget(parent) {
          {{tr("Views"), {"BaseView", "Section", "DetailView", "Dimension", "PartsList"}}},
          tr("Create drawings and annotations")},
         {tr("Inspect"),
-         {{tr("Analysis"), {"Measure", "Interference", "SectionAnalysis"}},
+         {{tr("Analysis"), {"Measure", "Interference", "Clearance", "SectionAnalysis"}},
           {tr("Simulation"), {"Simulation", "StressAnalysis", "ExportFEAReport", "ExportMotionReport"}}},
          tr("Inspect and simulate models")},
         {tr("Manage"),
@@ -141,6 +141,7 @@ void QtRibbon::registerDefaultActions() {
         {"PartsList", tr("Parts List")},
         {"Measure", tr("Measure")},
         {"Interference", tr("Interference")},
+        {"Clearance", tr("Clearance")},
         {"SectionAnalysis", tr("Section Analysis")},
         {"Simulation", tr("Simulation")},
         {"StressAnalysis", tr("Stress Analysis")},
@@ -296,6 +297,7 @@ QIcon QtRibbon::getIcon(const QString& commandId) {
         // Inspect
         {"Measure", {"measure", "zoom-original"}},
         {"Interference", {"dialog-warning", "process-stop"}},
+        {"Clearance", {"measure", "zoom-fit-best"}},
         {"SectionAnalysis", {"document-properties", "view-split-left-right"}},
         {"Simulation", {"media-playback-start", "system-run"}},
         {"StressAnalysis", {"dialog-warning", "system-run"}},
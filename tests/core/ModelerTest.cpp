@@ -1,8 +1,27 @@
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <future>
 #include <iostream>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
 #include "core/Modeler/Modeler.h"
 #include "core/Modeler/Sketch.h"
 #include "core/Modeler/Part.h"
+#include "core/analysis/InterferenceChecker.h"
+#include "core/assembly/AssemblyCacheCodec.h"
+#include "core/assembly/AssemblyManager.h"
+#include "core/assembly/AssemblyStream.h"
+#include "core/parallel/ThreadPool.h"
+#include "core/perf/PerformanceMonitor.h"
 
 using namespace cad::core;
 
@@ -105,9 +124,10 @@ void testAssemblyMates() {
     assert(!angle_name.empty());
     assert(assembly.mates().size() == 3);
     
-    // Test solving mates
+    // Test solving mates: Mate(5) widerspricht Flush(0), Angle der parallelen x-Achse aus Flush
     bool solved = assembly.solveMates();
-    assert(solved);
+    assert(!solved);
+    assert(!assembly.lastMateSolveReport().conflicting_mates.empty());
     
     // Verify transforms were updated
     const AssemblyComponent* compB = assembly.findComponent(idB);
@@ -139,6 +159,1132 @@ void testConstraintSolver() {
     std::cout << "  ✓ Constraint Solver tests passed" << std::endl;
 }
 
+void testMateSolverGlobal() {
+    std::cout << "Testing Global Mate Solver..." << std::endl;
+
+    // Insert + Angle legen B vollständig fest → starre Gruppe, B koaxial auf A, um z verdreht
+    {
+        Assembly assembly;
+        Transform tb;
+        tb.tx = 7.0;
+        tb.ty = -3.0;
+        tb.rx = 0.2;
+        std::uint64_t a = assembly.addComponent(Part("Base"), Transform{});
+        std::uint64_t b = assembly.addComponent(Part("Pin"), tb);
+        assembly.createInsert(a, b);
+        assembly.createAngle(a, b, 0.5);
+        bool solved = assembly.solveMates();
+        assert(solved);
+        const MateSolveReport& report = assembly.lastMateSolveReport();
+        assert(report.conflicting_mates.empty());
+        assert(report.degrees_of_freedom == 0);
+        assert(report.rigid_groups.size() == 1);
+        const Transform& t = assembly.findComponent(b)->transform;
+        assert(std::abs(t.tx) < 1e-6 && std::abs(t.ty) < 1e-6 && std::abs(t.tz) < 1e-6);
+        assert(std::abs(t.rx) < 1e-6 && std::abs(t.ry) < 1e-6);
+        assert(std::abs(t.rz - 0.5) < 1e-6);
+        assert(!assembly.isUnderConstrained());
+    }
+
+    // Mate in eine Unterbaugruppe: gelöst in Weltlagen, zurückgeschrieben relativ zum Eltern-Teil
+    {
+        Assembly assembly;
+        Transform carrier_pose;
+        carrier_pose.tx = 100.0;
+        carrier_pose.rz = 0.3;
+        Transform pin_pose;
+        pin_pose.tx = 7.0;
+        pin_pose.ty = -3.0;
+        pin_pose.rx = 0.2;
+        std::uint64_t a = assembly.addComponent(Part("Base"), Transform{});
+        std::uint64_t carrier = assembly.addComponent(Part("Carrier"), carrier_pose);
+        std::uint64_t pin = assembly.addComponent(Part("Pin"), pin_pose, carrier);
+        assembly.createInsert(a, pin);
+        assembly.createAngle(a, pin, 0.5);
+        bool solved = assembly.solveMates();
+        assert(solved);
+        const Transform world = assembly.worldTransform(pin);
+        assert(std::abs(world.tx) < 1e-6 && std::abs(world.ty) < 1e-6 && std::abs(world.tz) < 1e-6);
+        assert(std::abs(world.rz - 0.5) < 1e-6);
+        // Träger bleibt, lokale Lage des Stifts gleicht dessen Drehung und Versatz aus
+        assert(std::abs(assembly.worldTransform(carrier).tx - 100.0) < 1e-12);
+        const Transform& local = assembly.findComponent(pin)->transform;
+        assert(std::abs(local.rz - 0.2) < 1e-6);
+        assert(std::abs(local.tx + 100.0 * std::cos(0.3)) < 1e-6 && std::abs(local.ty - 100.0 * std::sin(0.3)) < 1e-6);
+        assert(assembly.analyzeMates().degrees_of_freedom == 6);  // nur der freie Träger
+    }
+
+    // Concentric allein: Drehung um und Verschiebung entlang der Achse bleiben frei
+    {
+        Assembly assembly;
+        Transform tb;
+        tb.tx = 2.0;
+        tb.ty = 1.0;
+        std::uint64_t a = assembly.addComponent(Part("Shaft"), Transform{});
+        std::uint64_t b = assembly.addComponent(Part("Wheel"), tb);
+        assembly.createConcentric(a, b);
+        bool solved = assembly.solveMates();
+        assert(solved);
+        assert(assembly.lastMateSolveReport().degrees_of_freedom == 2);
+        assert(assembly.getDegreesOfFreedom() == 2);
+        assert(assembly.isUnderConstrained());
+        const auto& under = assembly.lastMateSolveReport().under_constrained_components;
+        assert(under.size() == 1 && under[0] == b);
+    }
+
+    // Widerspruch: Tangent(0) gegen Tangent(4) → überbestimmt, nicht gelöst, beide Mates gemeldet
+    {
+        Assembly assembly;
+        std::uint64_t a = assembly.addComponent(Part("A"), Transform{});
+        std::uint64_t b = assembly.addComponent(Part("B"), Transform{});
+        assembly.createTangent(a, b, 0.0);
+        assembly.createTangent(a, b, 4.0);
+        bool solved = assembly.solveMates();
+        assert(!solved);
+        const MateSolveReport& report = assembly.lastMateSolveReport();
+        assert(report.conflicting_mates.size() == 2);
+        assert(report.redundant_equations == 1);
+        assert(assembly.isOverConstrained());
+    }
+
+    // Große Kette: 2000 Insert-Mates, dünnbesetzt global gelöst
+    {
+        Assembly assembly;
+        const int count = 2001;
+        std::vector<std::uint64_t> ids;
+        for (int i = 0; i < count; ++i) {
+            Transform t;
+            t.tx = 0.3 * std::sin(i * 1.7);
+            t.ty = 0.3 * std::cos(i * 0.9);
+            t.tz = 0.1 * i;
+            t.rx = 0.05 * std::sin(i * 0.3);
+            ids.push_back(assembly.addComponent(Part("Link" + std::to_string(i)), t));
+        }
+        for (int i = 0; i + 1 < count; ++i) {
+            assembly.createInsert(ids[static_cast<std::size_t>(i)], ids[static_cast<std::size_t>(i + 1)]);
+        }
+        bool solved = assembly.solveMates();
+        assert(solved);
+        const MateSolveReport& report = assembly.lastMateSolveReport();
+        assert(report.max_residual < 1e-6);
+        assert(report.conflicting_mates.empty());
+        assert(report.degrees_of_freedom == count - 1);
+        std::cout << "    2000 mates solved in " << report.solve_ms << " ms (" << report.iterations
+                  << " iterations)" << std::endl;
+    }
+
+    std::cout << "  ✓ Global Mate Solver tests passed" << std::endl;
+}
+
+void testSharedPartDefinitions() {
+    std::cout << "Testing Shared Part Definitions..." << std::endl;
+
+    Part bolt("Bolt");
+    Feature shaft;
+    shaft.name = "Shaft";
+    shaft.type = FeatureType::Extrude;
+    shaft.depth = 40.0;
+    bolt.addFeature(shaft);
+
+    Assembly assembly;
+    std::uint64_t first = assembly.addComponent(bolt, Transform{});
+    for (int i = 1; i < 1000; ++i) {
+        Transform t;
+        t.tx = 10.0 * i;
+        assert(assembly.addInstance(first, t) != 0);
+    }
+    assert(assembly.addInstance(9999, Transform{}) == 0);
+    assert(assembly.components().size() == 1000);
+    assert(assembly.uniquePartDefinitionCount() == 1);
+    assert(assembly.components()[0].part.sharesWith(assembly.components()[999].part));
+
+    // Kopie der Baugruppe teilt die Definitionen
+    Assembly copy = assembly;
+    assert(copy.components()[0].part.sharesWith(assembly.components()[0].part));
+
+    // Copy-on-Write: Bearbeitung im Kontext löst nur diese Komponente
+    std::uint64_t edited_id = assembly.components()[5].id;
+    Part* edited = assembly.editComponentPart(edited_id);
+    assert(edited != nullptr);
+    edited->setFeatureSuppressed("Shaft", true);
+    assert(assembly.uniquePartDefinitionCount() == 2);
+    assert(assembly.findComponent(edited_id)->part->features()[0].suppressed);
+    assert(!assembly.components()[0].part->features()[0].suppressed);
+    assert(!copy.components()[5].part->features()[0].suppressed);
+    assert(copy.uniquePartDefinitionCount() == 1);
+
+    std::cout << "  ✓ Shared Part Definition tests passed" << std::endl;
+}
+
+void testAssemblyHierarchy() {
+    std::cout << "Testing Assembly Hierarchy / World Transforms..." << std::endl;
+    const double pi = 3.14159265358979323846;
+
+    // compose: Rotation wird berücksichtigt
+    Transform parent;
+    parent.tx = 10.0;
+    setOrientation(parent, quaternionFromEuler(0.0, 0.0, pi / 2.0));
+    Transform local;
+    local.tx = 5.0;
+    Transform world = compose(parent, local);
+    assert(std::abs(world.tx - 10.0) < 1e-9);
+    assert(std::abs(world.ty - 5.0) < 1e-9);
+    assert(std::abs(world.rz - pi / 2.0) < 1e-9);
+    Transform identity = compose(world, inverse(world));
+    assert(std::abs(identity.tx) < 1e-9 && std::abs(identity.ty) < 1e-9 && std::abs(identity.rz) < 1e-9);
+
+    // Zwei Unterbaugruppen mit je 100 Teilen
+    Assembly assembly;
+    std::uint64_t frame = assembly.addComponent(Part("Frame"), Transform{});
+    std::uint64_t sub_a = assembly.addComponent(Part("SubA"), parent, frame);
+    std::uint64_t sub_b = assembly.addComponent(Part("SubB"), Transform{}, frame);
+    std::uint64_t first_a = 0;
+    for (int i = 0; i < 100; ++i) {
+        Transform t;
+        t.tx = 5.0;
+        std::uint64_t id_a = assembly.addComponent(Part("A" + std::to_string(i)), t, sub_a);
+        assembly.addComponent(Part("B" + std::to_string(i)), t, sub_b);
+        if (i == 0) first_a = id_a;
+    }
+    assert(assembly.addComponent(Part("Orphan"), Transform{}, 9999) == 0);
+    assert(assembly.childComponents(sub_a).size() == 100);
+    assert(assembly.findComponent(first_a)->parent_id == sub_a);
+
+    Transform w = assembly.worldTransform(first_a);
+    assert(std::abs(w.tx - 10.0) < 1e-9 && std::abs(w.ty - 5.0) < 1e-9);
+    assembly.worldTransforms();
+    const std::size_t before = assembly.worldTransformRecomputations();
+
+    // Nachschlagen (auch nicht-const) verwirft den Welt-Cache nicht
+    assert(assembly.findComponent(frame) != nullptr);
+    assembly.worldTransforms();
+    assert(assembly.worldTransformRecomputations() == before);
+
+    // Verschieben von SubB invalidiert nur dessen Teilbaum (1 + 100 Einträge)
+    Transform moved;
+    moved.tz = 3.0;
+    bool placed = assembly.setComponentTransform(sub_b, moved);
+    assert(placed);
+    const WorldTransformArrays& arrays = assembly.worldTransforms();
+    assert(assembly.worldTransformRecomputations() - before == 101);
+    assert(arrays.tz.size() == assembly.components().size());
+    assert(std::abs(assembly.worldTransform(first_a).tx - 10.0) < 1e-9);
+    assert(std::abs(assembly.getDisplayTransform(assembly.childComponents(sub_b)[0]).tz - 3.0) < 1e-9);
+
+    // Zyklen werden abgelehnt, Umhängen aktualisiert die Welt-Lage
+    bool reparented = assembly.setComponentParent(frame, first_a);
+    assert(!reparented);
+    reparented = assembly.setComponentParent(first_a, sub_b);
+    assert(reparented);
+    assert(std::abs(assembly.worldTransform(first_a).tz - 3.0) < 1e-9);
+    assert(std::abs(assembly.worldTransform(first_a).tx - 5.0) < 1e-9);
+    assert(assembly.childComponents(sub_a).size() == 99);
+
+    std::cout << "  ✓ Assembly Hierarchy tests passed" << std::endl;
+}
+
+void testInterferenceBroadPhase() {
+    std::cout << "Testing Interference Broad Phase..." << std::endl;
+
+    // Pseudozufällige Lagen: Ergebnis muss dem Brute-Force-Paarvergleich entsprechen
+    Assembly scattered;
+    std::vector<BoundingBox> boxes;
+    unsigned int seed = 12345u;
+    auto next = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<double>((seed >> 8) % 10000) / 10000.0;
+    };
+    for (int i = 0; i < 1500; ++i) {
+        Transform t;
+        t.tx = next() * 400.0;
+        t.ty = next() * 400.0;
+        t.tz = next() * 40.0;
+        scattered.addComponent(Part("P" + std::to_string(i)), t);
+        boxes.push_back(BoundingBox{t.tx - 5.0, t.ty - 5.0, t.tz - 5.0, t.tx + 5.0, t.ty + 5.0, t.tz + 5.0});
+    }
+    int expected = 0;
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+        for (std::size_t j = i + 1; j < boxes.size(); ++j) {
+            const BoundingBox& a = boxes[i];
+            const BoundingBox& b = boxes[j];
+            if (a.min_x <= b.max_x && a.max_x >= b.min_x && a.min_y <= b.max_y && a.max_y >= b.min_y &&
+                a.min_z <= b.max_z && a.max_z >= b.min_z) {
+                ++expected;
+            }
+        }
+    }
+    InterferenceChecker checker;
+    checker.setDetectionMode(CollisionDetectionMode::BoundingBox);
+    InterferenceResult boxed = checker.checkAssembly(scattered);
+    assert(static_cast<int>(InterferenceChecker::overlappingPairs(boxes).size()) == expected);
+    checker.setDetectionMode(CollisionDetectionMode::FeatureBased);
+    InterferenceResult featured = checker.checkAssembly(scattered);
+    assert(featured.overlap_count == expected);
+    assert(featured.candidate_pairs == static_cast<std::size_t>(expected));
+    assert(boxed.candidate_pairs <= static_cast<std::size_t>(scattered.components().size() * 4));
+    for (std::size_t k = 1; k < featured.interference_pairs.size(); ++k) {
+        const auto& p = featured.interference_pairs[k - 1];
+        const auto& q = featured.interference_pairs[k];
+        assert(p.component_a_id < q.component_a_id ||
+               (p.component_a_id == q.component_a_id && p.component_b_id < q.component_b_id));
+    }
+
+    // Anlagenlayout: 10k Komponenten im Raster (geteilte Definition), ein Störteil überlappt einen Nachbarn
+    Assembly plant;
+    std::uint64_t first = plant.addComponent(Part("Pump"), Transform{});
+    for (int i = 1; i < 10000; ++i) {
+        Transform t;
+        t.tx = 20.0 * (i % 100);
+        t.ty = 20.0 * (i / 100);
+        plant.addInstance(first, t);
+    }
+    Transform clash;
+    clash.tx = 28.0;
+    clash.ty = 22.0;
+    plant.addInstance(first, clash);
+    const auto start = std::chrono::steady_clock::now();
+    InterferenceResult layout = checker.checkAssembly(plant);
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    assert(layout.overlap_count == 1);
+    assert(layout.candidate_pairs == 1);
+    assert(layout.interference_pairs[0].component_b_id == plant.components().back().id);
+    std::cout << "    10k components checked in " << ms << " ms" << std::endl;
+
+    std::cout << "  ✓ Interference Broad Phase tests passed" << std::endl;
+}
+
+void testPreciseInterference() {
+    std::cout << "Testing Precise Interference..." << std::endl;
+
+    // Würfel mit Kantenlänge 10 um den Ursprung, "Pin" mit Kantenlänge 2
+    std::atomic<int> meshed{0};
+    InterferenceChecker checker;
+    checker.setDetectionMode(CollisionDetectionMode::Precise);
+    checker.setMeshProvider([&meshed](const Part& part, TriangleMesh& mesh) {
+        ++meshed;
+        const double h = part.name() == "Pin" ? 1.0 : 5.0;
+        for (int corner = 0; corner < 8; ++corner) {
+            mesh.vertices.push_back((corner & 1) ? h : -h);
+            mesh.vertices.push_back((corner & 2) ? h : -h);
+            mesh.vertices.push_back((corner & 4) ? h : -h);
+        }
+        mesh.indices = {0, 2, 1, 1, 2, 3, 4, 5, 6, 5, 7, 6, 0, 1, 4, 1, 5, 4,
+                        2, 6, 3, 3, 6, 7, 0, 4, 2, 2, 4, 6, 1, 3, 5, 3, 7, 5};
+        return true;
+    });
+
+    // Versetzte Würfel: Schnittkörper 5 x 7.5 x 7, Durchdringungskurve aus sechs Kanten (Länge 39)
+    Assembly offset;
+    std::uint64_t block = offset.addComponent(Part("Block"), Transform{});
+    Transform shifted;
+    shifted.tx = 5.0;
+    shifted.ty = 2.5;
+    shifted.tz = 3.0;
+    offset.addInstance(block, shifted);
+    InterferenceResult result = checker.checkAssembly(offset);
+    assert(result.overlap_count == 1);
+    const InterferencePair& pair = result.interference_pairs[0];
+    assert(std::abs(pair.overlap_volume - 262.5) < 1e-6);
+    double length = 0.0;
+    for (const auto& segment : pair.contact_curves) {
+        const double dx = segment.end.x - segment.start.x;
+        const double dy = segment.end.y - segment.start.y;
+        const double dz = segment.end.z - segment.start.z;
+        length += std::sqrt(dx * dx + dy * dy + dz * dz);
+        // Kontaktpunkte liegen auf beiden Oberflächen, also im Schnittkörper
+        assert(segment.start.x >= -1e-9 && segment.start.x <= 5.0 + 1e-9);
+        assert(segment.start.y >= -2.5 - 1e-9 && segment.start.y <= 5.0 + 1e-9);
+    }
+    assert(std::abs(length - 39.0) < 1e-6);
+    assert(meshed == 1);  // eine geteilte Definition → ein Netz
+
+    // Um 45° gedrehter Würfel: Schnitt = Achteck (2 * 10² * (√2 - 1)) x 10
+    Assembly rotated;
+    rotated.addComponent(Part("Block"), Transform{});
+    Transform turned;
+    setOrientation(turned, quaternionFromEuler(0.0, 0.0, 0.78539816339744831));
+    rotated.addComponent(Part("Block"), turned);
+    result = checker.checkAssembly(rotated);
+    assert(result.overlap_count == 1);
+    const double octagon = 2.0 * 100.0 * (std::sqrt(2.0) - 1.0) * 10.0;
+    assert(std::abs(result.interference_pairs[0].overlap_volume - octagon) < 0.01 * octagon);
+    assert(!result.interference_pairs[0].contact_curves.empty());
+
+    // Flächig anliegende Würfel berühren sich nur → keine Kollision, obwohl die Boxen sich berühren
+    Assembly touching;
+    touching.addComponent(Part("Block"), Transform{});
+    Transform beside;
+    beside.tx = 10.0;
+    touching.addComponent(Part("Block"), beside);
+    result = checker.checkAssembly(touching);
+    assert(result.candidate_pairs == 1);
+    assert(!result.has_interference);
+
+    // Vollständig eingeschlossener Stift: keine Oberflächen-Durchdringung, aber Volumen 2³
+    Assembly enclosed;
+    enclosed.addComponent(Part("Block"), Transform{});
+    enclosed.addComponent(Part("Pin"), Transform{});
+    result = checker.checkAssembly(enclosed);
+    assert(result.overlap_count == 1);
+    assert(result.interference_pairs[0].contact_curves.empty());
+    assert(std::abs(result.interference_pairs[0].overlap_volume - 8.0) < 1e-6);
+
+    // Ohne Netzquelle: Quader der Feature-Schätzung (10 x 10 x 10)
+    InterferenceChecker fallback;
+    fallback.setDetectionMode(CollisionDetectionMode::Precise);
+    result = fallback.checkAssembly(offset);
+    assert(result.overlap_count == 1);
+    assert(std::abs(result.interference_pairs[0].overlap_volume - 262.5) < 1e-6);
+
+    std::cout << "  ✓ Precise Interference tests passed" << std::endl;
+}
+
+void testInterferenceSession() {
+    std::cout << "Testing Interference Session..." << std::endl;
+
+    // 5k Pumpen im 20er-Raster (Boxen 10 x 10 x 10), zunächst kollisionsfrei
+    Assembly plant;
+    std::uint64_t first = plant.addComponent(Part("Pump"), Transform{});
+    std::vector<std::uint64_t> ids{first};
+    for (int i = 1; i < 5000; ++i) {
+        Transform t;
+        t.tx = 20.0 * (i % 100);
+        t.ty = 20.0 * (i / 100);
+        ids.push_back(plant.addInstance(first, t));
+    }
+    InterferenceChecker checker;
+    InterferenceSession session(checker);
+    bool interfering = session.begin(plant).has_interference;
+    assert(!interfering);
+    assert(session.active());
+
+    // Drag: Komponente 250 (Raster 50/2) Schritt für Schritt auf den Nachbarn 251 zu
+    const std::uint64_t dragged = ids[250];
+    double total_ms = 0.0;
+    for (int step = 1; step <= 10; ++step) {
+        Transform t;
+        t.tx = 1000.0 + 1.2 * step;
+        t.ty = 40.0;
+        plant.setComponentTransform(dragged, t);
+        const auto start = std::chrono::steady_clock::now();
+        const InterferenceResult& live = session.update(plant, {dragged});
+        total_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        assert(live.candidate_pairs <= 2);  // nur Paare mit dem bewegten Teil werden neu geprüft
+        assert(live.overlap_count == (1.2 * step >= 10.0 ? 1 : 0));
+    }
+    assert(session.result().interference_pairs[0].component_a_id == dragged);
+    assert(session.result().interference_pairs[0].component_b_id == ids[251]);
+    std::cout << "    10 drag updates on 5k components in " << total_ms << " ms" << std::endl;
+
+    // Zufällige Verschiebungen: Ergebnis stets identisch zur vollständigen Prüfung
+    unsigned int seed = 777u;
+    auto next = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<double>((seed >> 8) % 10000) / 10000.0;
+    };
+    for (int round = 0; round < 20; ++round) {
+        std::vector<std::uint64_t> moved;
+        for (int k = 0; k < 3; ++k) {
+            const std::uint64_t id = ids[static_cast<std::size_t>(next() * 5000.0) % ids.size()];
+            Transform t;
+            t.tx = next() * 2000.0;
+            t.ty = next() * 1000.0;
+            t.tz = next() * 8.0;
+            plant.setComponentTransform(id, t);
+            moved.push_back(id);
+        }
+        const InterferenceResult& live = session.update(plant, moved);
+        const InterferenceResult full = checker.checkAssembly(plant);
+        assert(live.overlap_count == full.overlap_count);
+        for (std::size_t p = 0; p < full.interference_pairs.size(); ++p) {
+            assert(live.interference_pairs[p].component_a_id == full.interference_pairs[p].component_a_id);
+            assert(live.interference_pairs[p].component_b_id == full.interference_pairs[p].component_b_id);
+        }
+    }
+
+    // Unterbaugruppe: Eltern-Teil ziehen bewegt das Kind mit
+    Assembly group;
+    std::uint64_t base = group.addComponent(Part("Base"), Transform{});
+    Transform far;
+    far.tx = 100.0;
+    std::uint64_t carrier = group.addComponent(Part("Carrier"), far);
+    Transform offset;
+    offset.tx = 30.0;
+    group.addComponent(Part("Tool"), offset, carrier);
+    InterferenceSession nested;
+    interfering = nested.begin(group).has_interference;
+    assert(!interfering);
+    Transform closer;
+    closer.tx = -25.0;
+    group.setComponentTransform(carrier, closer);
+    const InterferenceResult& moved = nested.update(group, {carrier});
+    assert(moved.overlap_count == 1);
+    assert(moved.interference_pairs[0].component_a_id == base);
+    assert(moved.interference_pairs[0].part_b_name == "Tool");
+
+    // Neue Komponente → vollständiger Neuaufbau (Cover überlappt Base und Tool)
+    group.addComponent(Part("Cover"), Transform{});
+    std::size_t overlaps = nested.update(group, {}).overlap_count;
+    assert(overlaps == 3);
+
+    // Neue Definition einer unbewegten Komponente (Copy-on-Write) → Neuaufbau, Namen aktuell
+    Part* tool = group.editComponentPart(group.components()[2].id);
+    assert(tool != nullptr);
+    *tool = Part("Cutter");
+    const InterferenceResult& renamed = nested.update(group, {});
+    assert(renamed.overlap_count == 3);
+    bool cutter_named = false;
+    for (const auto& pair : renamed.interference_pairs) {
+        cutter_named = cutter_named || pair.part_a_name == "Cutter" || pair.part_b_name == "Cutter";
+    }
+    assert(cutter_named);
+
+    std::cout << "  ✓ Interference Session tests passed" << std::endl;
+}
+
+/** Würfel mit Kantenlänge 2h um den Ursprung, jede Seite in n x n Quadrate (je 2 Dreiecke) zerlegt. */
+TriangleMesh subdividedCube(double h, int n) {
+    TriangleMesh mesh;
+    for (int axis = 0; axis < 3; ++axis) {
+        for (int side = 0; side < 2; ++side) {
+            const unsigned int base = static_cast<unsigned int>(mesh.vertices.size() / 3);
+            for (int u = 0; u <= n; ++u) {
+                for (int v = 0; v <= n; ++v) {
+                    double p[3];
+                    p[axis] = side ? h : -h;
+                    p[(axis + 1) % 3] = -h + 2.0 * h * u / n;
+                    p[(axis + 2) % 3] = -h + 2.0 * h * v / n;
+                    mesh.vertices.insert(mesh.vertices.end(), p, p + 3);
+                }
+            }
+            for (int u = 0; u < n; ++u) {
+                for (int v = 0; v < n; ++v) {
+                    const unsigned int i0 = base + static_cast<unsigned int>(u * (n + 1) + v);
+                    const unsigned int i1 = i0 + static_cast<unsigned int>(n + 1);
+                    mesh.indices.insert(mesh.indices.end(), {i0, i1, i0 + 1, i0 + 1, i1, i1 + 1});
+                }
+            }
+        }
+    }
+    return mesh;
+}
+
+void testClearance() {
+    std::cout << "Testing Clearance Analysis..." << std::endl;
+
+    InterferenceChecker checker;
+    checker.setMeshProvider([](const Part& part, TriangleMesh& mesh) {
+        mesh = subdividedCube(5.0, part.name() == "Fine" ? 24 : 1);
+        return true;
+    });
+
+    // Spalt 3 entlang x: nächste Punkte auf den zugewandten Flächen
+    Assembly pair;
+    std::uint64_t a = pair.addComponent(Part("Block"), Transform{});
+    Transform gap;
+    gap.tx = 13.0;
+    std::uint64_t b = pair.addComponent(Part("Block"), gap);
+    ClearancePair measured = checker.minimumDistance(pair, a, b);
+    assert(std::abs(measured.distance - 3.0) < 1e-9);
+    assert(std::abs(measured.point_a.x - 5.0) < 1e-9 && std::abs(measured.point_b.x - 8.0) < 1e-9);
+
+    // Um 45° gedreht: Kante zeigt auf a → Abstand 15 - 5√2
+    Transform turned;
+    turned.tx = 20.0;
+    setOrientation(turned, quaternionFromEuler(0.0, 0.0, 0.78539816339744831));
+    pair.setComponentTransform(b, turned);
+    measured = checker.minimumDistance(pair, a, b);
+    assert(std::abs(measured.distance - (15.0 - 5.0 * std::sqrt(2.0))) < 1e-9);
+    assert(std::abs(measured.point_b.x - (20.0 - 5.0 * std::sqrt(2.0))) < 1e-9);
+
+    // Durchdringung → 0; Gruppenabfrage wählt das nächste Paar
+    Transform far;
+    far.tx = 100.0;
+    std::uint64_t c = pair.addComponent(Part("Block"), far);
+    Transform inside;
+    inside.tx = 8.0;
+    inside.ty = 1.0;
+    std::uint64_t d = pair.addComponent(Part("Block"), inside);
+    measured = checker.minimumDistance(pair, {a}, {b, c, d});
+    assert(measured.component_b_id == d);
+    assert(measured.distance == 0.0);
+    const ClearancePair missing = checker.minimumDistance(pair, {a}, {999});
+    assert(missing.distance == std::numeric_limits<double>::infinity());
+
+    // Fein vernetzte Würfel (je 3456 Dreiecke): parallele Teilsuchen, gleiches Ergebnis
+    Assembly fine;
+    std::uint64_t f1 = fine.addComponent(Part("Fine"), Transform{});
+    Transform offset;
+    offset.tx = 11.5;
+    offset.ty = 3.0;
+    offset.tz = -2.0;
+    std::uint64_t f2 = fine.addComponent(Part("Fine"), offset);
+    measured = checker.minimumDistance(fine, f1, f2);
+    assert(std::abs(measured.distance - 1.5) < 1e-9);
+
+    // Raster 30 x 30 mit Spalt 1.5: alle direkten Nachbarn < 2 mm, Diagonalen (2.12 mm) nicht
+    Assembly grid;
+    std::uint64_t first = grid.addComponent(Part("Block"), Transform{});
+    for (int i = 1; i < 900; ++i) {
+        Transform t;
+        t.tx = 11.5 * (i % 30);
+        t.ty = 11.5 * (i / 30);
+        grid.addInstance(first, t);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    ClearanceReport report = checker.checkClearance(grid, 2.0);
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    assert(report.pairs.size() == 2u * 30u * 29u);
+    assert(report.candidate_pairs > report.pairs.size());
+    for (const auto& close : report.pairs) {
+        assert(std::abs(close.distance - 1.5) < 1e-9);
+    }
+    const ClearanceReport tight = checker.checkClearance(grid, 1.0);
+    assert(tight.pairs.empty());
+    std::cout << "    900 components clearance < 2 mm in " << ms << " ms" << std::endl;
+
+    std::cout << "  ✓ Clearance Analysis tests passed" << std::endl;
+}
+
+void testAssemblyLoading() {
+    std::cout << "Testing assembly loading (work-stealing pool)..." << std::endl;
+
+    // Priorität: ein blockierter Worker arbeitet danach High vor Normal vor Low ab
+    {
+        ThreadPool pool(1);
+        std::promise<void> gate;
+        std::shared_future<void> open = gate.get_future().share();
+        pool.submit([open]() { open.wait(); });
+        std::mutex order_mutex;
+        std::vector<int> order;
+        auto record = [&](int value) {
+            return [&, value]() {
+                std::lock_guard<std::mutex> lock(order_mutex);
+                order.push_back(value);
+            };
+        };
+        std::vector<std::future<void>> done;
+        done.push_back(pool.submit(record(2), TaskPriority::Low));
+        done.push_back(pool.submit(record(1), TaskPriority::Normal));
+        done.push_back(pool.submit(record(0), TaskPriority::High));
+        gate.set_value();
+        for (auto& future : done) {
+            future.wait();
+        }
+        assert((order == std::vector<int>{0, 1, 2}));
+    }
+
+    // Stehlen: Teilaufgaben eines Workers landen in seiner Deque und werden von anderen übernommen
+    {
+        ThreadPool pool(4);
+        std::mutex ids_mutex;
+        std::set<std::thread::id> ids;
+        std::atomic<int> finished{0};
+        pool.submit([&]() {
+            for (int i = 0; i < 64; ++i) {
+                pool.submit([&]() {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    std::lock_guard<std::mutex> lock(ids_mutex);
+                    ids.insert(std::this_thread::get_id());
+                    finished++;
+                });
+            }
+        }).wait();
+        while (finished.load() < 64) {
+            std::this_thread::yield();
+        }
+        assert(pool.stolenTasks() > 0);
+        assert(ids.size() > 1);
+    }
+
+    // 300 Komponenten (Dateigröße / 10 KB), Teilaufgaben: Datei + 300 parsen + 2 * 300 Definitionen
+    const std::string path = "modeler_test_load.stl";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << std::string(300 * 10240, ' ');
+    }
+    std::atomic<int> tessellated{0};
+    {
+        AssemblyManager manager;
+        manager.enableAdaptiveLod(false);
+        manager.enableMultiThreadedLoading(true);
+        manager.setThreadPoolSize(4);
+        manager.setTessellator([&](const Part&, LodMode, TriangleMesh&) {
+            tessellated++;
+            return false;
+        });
+
+        std::uint64_t id = manager.enqueueLoad(path);
+        assert(id != 0);
+        AssemblyLoadJob job;
+        int last_progress = 0;
+        do {
+            job = manager.pollLoadProgress();
+            assert(job.path == path);
+            assert(job.progress >= last_progress);
+            last_progress = job.progress;
+        } while (!job.finished);
+        assert(job.progress == 100);
+        assert(job.total_tasks == 1 + 300 + 2 * 300);
+        assert(job.completed_tasks == job.total_tasks);
+        job = manager.pollLoadProgress();
+        assert(job.path.empty());
+        assert(tessellated.load() == 300);
+
+        Assembly loaded;
+        bool cached_hit = manager.getCachedAssembly(path, loaded);
+        assert(cached_hit);
+        assert(loaded.components().size() == 300u);
+        assert(loaded.components()[0].part->name() == "Part_1");
+        assert(std::abs(loaded.components()[0].transform.tx) <= 50.0);
+
+        // Zweiter Aufruf aus dem Cache, Async liefert ein gültiges Future
+        std::future<AssemblyLoadStats> async = manager.loadAssemblyAsync(path);
+        assert(async.valid());
+        AssemblyLoadStats cached = async.get();
+        assert(cached.from_cache);
+        assert(cached.component_count == 300u);
+
+        // Abbruch: nichts gecacht, Auftrag endet trotzdem
+        manager.clearCache();
+        std::promise<void> gate;
+        std::shared_future<void> open = gate.get_future().share();
+        manager.setTessellator([open](const Part&, LodMode, TriangleMesh&) {
+            open.wait();
+            return false;
+        });
+        std::uint64_t cancelled_id = manager.enqueueLoad(path);
+        bool cancelled = manager.cancelLoad(cancelled_id);
+        assert(cancelled);
+        gate.set_value();
+        manager.waitForLoadCompletion();
+        job = manager.pollLoadProgress();
+        assert(job.finished && job.cancelled);
+        cached_hit = manager.getCachedAssembly(path, loaded);
+        assert(!cached_hit);
+        cancelled = manager.cancelLoad(cancelled_id);
+        assert(!cancelled);
+
+        // Synchron, ohne Pool: gleiche Baugruppe
+        manager.enableMultiThreadedLoading(false);
+        AssemblyLoadStats stats = manager.loadAssembly(path);
+        assert(!stats.cancelled && !stats.from_cache);
+        assert(stats.component_count == 300u);
+        assert(stats.regenerated_definitions == 300u);
+
+        // Vorausladen läuft im Hintergrund; Destruktor bricht ab und wartet
+        manager.clearCache();
+        manager.preloadAssembly(path);
+    }
+    std::remove(path.c_str());
+
+    std::cout << "  ✓ Assembly loading tests passed" << std::endl;
+}
+
+void testAssemblyCache() {
+    std::cout << "Testing assembly cache (LRU + disk tier)..." << std::endl;
+
+    // Binärformat: Rundreise inkl. geteilter Definitionen, Hierarchie, Mates, Gelenke, Netze
+    Part bolt("Bolt");
+    bolt.createExtrude("Sketch1", 12.0);
+    bolt.createHole(4.0, 10.0);
+    bolt.addUserParameter(Parameter{"Length", 12.0, "Diameter*3"});
+    bolt.addWorkPlane("Mid", Point3D{0, 0, 6}, Vector3D{0, 0, 1});
+    bolt.addConfiguration(Configuration{"Long", {{"Length", 20.0}}});
+    Assembly source;
+    Transform t;
+    t.tx = 5.0;
+    std::uint64_t frame = source.addComponent(Part("Frame"), Transform{});
+    std::uint64_t first = source.addComponent(bolt, t, frame);
+    t.ty = 7.0;
+    std::uint64_t second = source.addInstance(first, t);
+    source.setComponentLightweight(second, true);
+    source.setExplosionOffset(second, 0.0, 0.0, 30.0);
+    source.createMate(frame, first, 1.5);
+    source.createRevolute(frame, second, 0.0, 0.0, 1.0);
+    AssemblyMeshes meshes;
+    meshes["Bolt"] = subdividedCube(1.0, 1);
+
+    std::string encoded = AssemblyCacheCodec::encode(source, meshes);
+    Assembly decoded;
+    AssemblyMeshes decoded_meshes;
+    bool decoded_ok = AssemblyCacheCodec::decode(encoded, decoded, decoded_meshes);
+    assert(decoded_ok);
+    assert(decoded.components().size() == 3u);
+    assert(decoded.uniquePartDefinitionCount() == 2u);
+    const AssemblyComponent* copy = decoded.findComponent(second);
+    assert(copy && copy->lightweight_display && copy->transform.ty == 7.0);
+    assert(decoded.findComponent(first)->parent_id == frame);
+    assert(std::abs(decoded.worldTransform(first).tx - 5.0) < 1e-12);
+    assert(decoded.getExplosionOffset(second).z == 30.0);
+    const Part& restored = copy->part.get();
+    assert(restored.features().size() == 2u && restored.features()[1].diameter == 4.0);
+    assert(restored.findParameter("Length") && restored.findParameter("Length")->expression == "Diameter*3");
+    assert(restored.workPlanes().size() == 1u && restored.workPlanes()[0].name == "Mid");
+    assert(restored.configurations().size() == 1u);
+    assert(decoded.mates().size() == 1u && decoded.mates()[0].value == 1.5);
+    assert(decoded.joints().size() == 1u && decoded.joints()[0].type == JointType::Revolute);
+    assert(decoded_meshes["Bolt"].indices == meshes["Bolt"].indices);
+    // Abgeschnitten oder fremd → abgelehnt
+    decoded_ok = AssemblyCacheCodec::decode(encoded.substr(0, encoded.size() - 3), decoded, decoded_meshes);
+    assert(!decoded_ok);
+    decoded_ok = AssemblyCacheCodec::decode("not a cache", decoded, decoded_meshes);
+    assert(!decoded_ok);
+
+    // Echte Bytes: geteilte Definitionen zählen einmal, Netze und Features zählen mit
+    Assembly shared;
+    Assembly unique;
+    std::uint64_t base = shared.addComponent(bolt, Transform{});
+    for (int i = 0; i < 100; ++i) {
+        shared.addInstance(base, Transform{});
+        unique.addComponent(bolt, Transform{});
+    }
+    assert(AssemblyCacheCodec::footprint(unique) > AssemblyCacheCodec::footprint(shared) + 90 * sizeof(Feature));
+    assert(AssemblyCacheCodec::footprint(meshes) >= 8 * 3 * sizeof(double) + 36 * sizeof(unsigned int));
+
+    // LRU: zuletzt benutzter Eintrag überlebt
+    AssemblyManager manager;
+    manager.setCacheLimit(2);
+    manager.cacheAssembly("a", source);
+    manager.cacheAssembly("b", source);
+    Assembly out;
+    bool hit = manager.getCachedAssembly("a", out);
+    assert(hit);
+    manager.cacheAssembly("c", source);
+    assert((manager.getCachedPaths() == std::vector<std::string>{"c", "a"}));
+    hit = manager.getCachedAssembly("b", out);
+    assert(!hit);
+    assert(manager.cacheStats().evicted_entries == 1u);
+    assert(manager.getMemoryUsage() == 2 * AssemblyCacheCodec::footprint(source));
+
+    // Speicherlimit nach Bytes (1 MB): große Netze verdrängen ältere Einträge
+    AssemblyMeshes big;
+    big["Bolt"].vertices.resize(100000);
+    manager.setCacheLimit(100);
+    manager.setMemoryLimit(1);
+    manager.cacheAssembly("big1", source, big);
+    manager.cacheAssembly("big2", source, big);
+    assert(manager.getCachedPaths().front() == "big2");
+    hit = manager.getCachedAssembly("big1", out);
+    assert(!hit);
+    assert(manager.getMemoryUsage() <= 1024u * 1024u);
+
+    // Disk-Tier: 5000 Komponenten laden, freigeben, erneut öffnen
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "modeler_test_assembly_cache";
+    std::filesystem::remove_all(dir);
+    const std::string path = (std::filesystem::temp_directory_path() / "modeler_test_cache.stl").string();
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << std::string(5000 * 10240, ' ');
+    }
+    AssemblyManager loader;
+    loader.enableAdaptiveLod(false);
+    loader.setMaxComponents(5000);
+    loader.setMemoryLimit(4096);
+    bool disk_ready = loader.setDiskCacheDirectory(dir.string());
+    assert(disk_ready);
+    loader.setTessellator([](const Part&, LodMode, TriangleMesh& mesh) {
+        mesh = subdividedCube(2.0, 1);
+        return true;
+    });
+    AssemblyLoadStats full = loader.loadAssembly(path);
+    assert(full.component_count == 5000u && !full.from_cache);
+    assert(full.estimated_memory_mb > 0.0);
+    bool released = loader.releaseAssembly(path);
+    assert(released);
+    assert(loader.cacheStats().entries == 0u && loader.cacheStats().disk_entries == 1u);
+
+    auto start = std::chrono::steady_clock::now();
+    AssemblyLoadStats reopened = loader.loadAssembly(path);
+    const double reopen_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    assert(reopened.from_cache && reopened.component_count == 5000u);
+    assert(loader.cacheStats().disk_hits == 1u);
+    AssemblyMeshes loaded_meshes;
+    hit = loader.getCachedMeshes(path, loaded_meshes);
+    assert(hit && loaded_meshes.size() == 5000u);
+    std::cout << "    5000 components: load " << full.load_seconds * 1000.0 << " ms, reopen from disk "
+              << reopen_ms << " ms" << std::endl;
+
+    // Neue Sitzung übernimmt den Disk-Tier; geänderte Quelle macht den Eintrag ungültig
+    loader.releaseAssembly(path);
+    {
+        AssemblyManager next_session;
+        next_session.enableAdaptiveLod(false);
+        next_session.setMaxComponents(5000);
+        disk_ready = next_session.setDiskCacheDirectory(dir.string());
+        assert(disk_ready);
+        assert(next_session.cacheStats().disk_entries == 1u);
+        hit = next_session.getCachedAssembly(path, out);
+        assert(hit && out.components().size() == 5000u);
+        next_session.releaseAssembly(path);
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::app);
+            file << std::string(10240, ' ');
+        }
+        AssemblyLoadStats stale = next_session.loadAssembly(path);
+        assert(!stale.from_cache);
+        next_session.clearDiskCache();
+        assert(next_session.cacheStats().disk_entries == 0u);
+    }
+    std::filesystem::remove(path);
+    std::filesystem::remove_all(dir);
+
+    std::cout << "  ✓ Assembly cache tests passed" << std::endl;
+}
+
+void testAssemblyStreaming() {
+    std::cout << "Testing streaming assembly open..." << std::endl;
+
+    // 100k Komponenten: 1000 Definitionen (Spalten in x) à 100 Instanzen (Zeilen in y), Raster 20 mm
+    Assembly plant;
+    std::vector<std::shared_ptr<Part>> definitions;
+    for (int d = 0; d < 1000; ++d) {
+        definitions.push_back(std::make_shared<Part>(Part("Def_" + std::to_string(d))));
+    }
+    std::vector<std::uint64_t> ids;
+    for (int d = 0; d < 1000; ++d) {
+        for (int k = 0; k < 100; ++k) {
+            Transform t;
+            t.tx = d * 20.0;
+            t.ty = k * 20.0;
+            ids.push_back(plant.addComponent(PartRef(definitions[d]), t));
+        }
+    }
+    std::mutex lods_mutex;
+    std::vector<LodMode> lods;
+    auto tessellator = [&](const Part&, LodMode lod, TriangleMesh& mesh) {
+        std::lock_guard<std::mutex> lock(lods_mutex);
+        lods.push_back(lod);
+        mesh = subdividedCube(2.0, lod == LodMode::Full ? 4 : 1);
+        return true;
+    };
+    auto component = [&](int d, int k) { return ids[static_cast<std::size_t>(d) * 100 + k]; };
+
+    ThreadPool pool(4);
+    auto start = std::chrono::steady_clock::now();
+    AssemblyStream stream(plant, {}, tessellator, &pool);
+    StreamingView view;
+    view.eye = Point3D{100.0, 1000.0, 200.0};
+    view.target = Point3D{100.0, 1000.0, 0.0};
+    StreamingStats stats = stream.update(view);
+    const double open_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "    100000 components: structure + first frame " << open_ms << " ms" << std::endl;
+    assert(stats.components == 100000u && stats.definitions == 1000u);
+    assert(stats.visible_components > 0 && stats.visible_components < 1000u);
+
+    // Nur sichtbare Definitionen werden geladen, klein auf dem Bildschirm → vereinfacht
+    stream.waitIdle();
+    stats = stream.stats();
+    assert(stats.resident_definitions > 0 && stats.resident_definitions < 30u);
+    assert(stats.loaded_definitions == stats.resident_definitions);
+    const std::size_t first_view_bytes = stats.resident_bytes;
+    assert(lods.size() == stats.loaded_definitions);
+    for (LodMode lod : lods) {
+        assert(lod == LodMode::Simplified);
+    }
+    assert(stream.state(component(5, 50)) == StreamState::Resident);
+    assert(stream.mesh(component(5, 50)) != nullptr);
+    assert(stream.state(component(999, 50)) == StreamState::Unloaded);
+    assert(stream.mesh(component(999, 50)) == nullptr);
+    // Box vor dem Laden geschätzt (10 mm), danach aus dem Netz (4 mm)
+    BoundingBox loaded_box = stream.worldBounds(component(5, 50));
+    assert(std::abs(loaded_box.max_x - loaded_box.min_x - 4.0) < 1e-9);
+    BoundingBox estimated_box = stream.worldBounds(component(999, 50));
+    assert(std::abs(estimated_box.max_x - estimated_box.min_x - 10.0) < 1e-9);
+
+    // Aus großer Entfernung: alles unter min_screen_pixels, nichts Neues
+    StreamingView far_view = view;
+    far_view.eye.z = 1e6;
+    stats = stream.update(far_view);
+    assert(stats.queued_definitions == 0u && stats.loading_definitions == 0u);
+
+    // Heranzoomen: sichtbare Definitionen in voller Auflösung nachladen
+    StreamingView near_view = view;
+    near_view.eye.z = 40.0;
+    stream.update(near_view);
+    stream.waitIdle();
+    std::size_t full = 0;
+    {
+        std::lock_guard<std::mutex> lock(lods_mutex);
+        full = static_cast<std::size_t>(std::count(lods.begin(), lods.end(), LodMode::Full));
+    }
+    assert(full > 0);
+    assert(stream.mesh(component(5, 50))->vertices.size() > subdividedCube(2.0, 1).vertices.size());
+
+    // Speicherdruck: Budget für eine Ansicht, Kamera wandert → Unsichtbares wird ausgelagert
+    assert(stream.stats().resident_bytes > first_view_bytes);
+    stream.setMemoryBudget(first_view_bytes);
+    StreamingView moved = view;
+    moved.eye.x = moved.target.x = 15000.0;
+    stats = stream.update(moved);
+    assert(stats.paged_out_definitions > 0);
+    // Je Bild wird nur so viel ausgelagert, dass wieder geladen werden darf
+    for (int frame = 0; frame < 100 && stream.state(component(5, 50)) != StreamState::Unloaded; ++frame) {
+        stream.waitIdle();
+        stream.update(moved);
+    }
+    stream.waitIdle();
+    assert(stream.state(component(750, 50)) == StreamState::Resident);
+    assert(stream.state(component(5, 50)) == StreamState::Unloaded);
+
+    // Manager: nur Struktur lesen, Geometrie erst nach update()
+    const std::string path = "modeler_test_stream.stl";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << std::string(300 * 10240, ' ');
+    }
+    {
+        AssemblyManager manager;
+        std::atomic<int> calls{0};
+        manager.setTessellator([&](const Part&, LodMode, TriangleMesh& mesh) {
+            calls++;
+            mesh = subdividedCube(1.0, 1);
+            return true;
+        });
+        std::unique_ptr<AssemblyStream> opened = manager.openStreaming(path);
+        assert(opened);
+        assert(opened->assembly().components().size() == 300u);
+        assert(opened->stats().resident_definitions == 0u && calls.load() == 0);
+        StreamingView overview;
+        overview.eye = Point3D{0.0, 0.0, 300.0};
+        opened->update(overview);
+        opened->waitIdle();
+        assert(opened->stats().resident_definitions == static_cast<std::size_t>(calls.load()));
+        assert(calls.load() > 0);
+        std::unique_ptr<AssemblyStream> missing = manager.openStreaming("does_not_exist.stl");
+        assert(!missing);
+
+        // Destruktor bricht ausstehende Anforderungen ab und wartet auf laufende
+        std::unique_ptr<AssemblyStream> closing = manager.openStreaming(path);
+        closing->update(overview);
+    }
+    std::remove(path.c_str());
+
+    std::cout << "  ✓ Streaming assembly open tests passed" << std::endl;
+}
+
+void testLodGovernor() {
+    std::cout << "Testing screen-space-error LOD governor..." << std::endl;
+
+    // 45° / 1080 px; Radius 10: Fehler Full 26/d, Simplified 652/d, Boxen 13037/d Pixel
+    const double scale = LodGovernor::pixelScale(45.0, 1080);
+    assert(std::abs(scale - 540.0 / std::tan(22.5 * 3.14159265358979323846 / 180.0)) < 1e-9);
+    LodGovernor governor(30.0);
+    assert(governor.select(LodMode::BoundingBoxes, 10.0, 20.0, scale) == LodMode::Full);
+    assert(governor.select(LodMode::BoundingBoxes, 10.0, 1000.0, scale) == LodMode::Simplified);
+    assert(governor.select(LodMode::Full, 10.0, 20000.0, scale) == LodMode::BoundingBoxes);
+    assert(governor.select(LodMode::Full, 10.0, 5.0, scale) == LodMode::Full);
+
+    // Hysterese um die Grenze Simplified/Full bei d ≈ 652
+    assert(governor.select(LodMode::Simplified, 10.0, 600.0, scale) == LodMode::Simplified);
+    assert(governor.select(LodMode::Simplified, 10.0, 500.0, scale) == LodMode::Full);
+    assert(governor.select(LodMode::Full, 10.0, 700.0, scale) == LodMode::Full);
+    assert(governor.select(LodMode::Full, 10.0, 900.0, scale) == LodMode::Simplified);
+
+    // Regler: zu langsam → Toleranz steigt, Reserve → sinkt, im Totband unverändert
+    {
+        PerformanceMonitor monitor;
+        monitor.setWindowSize(10);
+        LodGovernor slow(30.0);
+        for (int i = 0; i < 10; ++i) {
+            monitor.recordFrame(50.0);
+            slow.adapt(monitor);
+        }
+        assert(std::abs(slow.pixelTolerance() - 1.5) < 1e-9);
+        for (int i = 0; i < 10; ++i) {
+            monitor.recordFrame(10.0);
+            slow.adapt(monitor);
+        }
+        assert(std::abs(slow.pixelTolerance() - 0.75) < 1e-9);
+        for (int i = 0; i < 10; ++i) {
+            monitor.recordFrame(32.0);
+            slow.adapt(monitor);
+        }
+        assert(std::abs(slow.pixelTolerance() - 0.75) < 1e-9);
+    }
+
+    // Geschlossener Kreis: Bildzeit = Summe der Kosten je Stufe, 2000 Komponenten in 20..4020 mm
+    {
+        PerformanceMonitor monitor;
+        monitor.setWindowSize(10);
+        LodGovernor loop(30.0);
+        const double cost_ms[3] = {0.1, 0.02, 0.002};
+        std::vector<LodMode> current(2000, LodMode::BoundingBoxes);
+        double frame_ms = 0.0;
+        std::size_t late_switches = 0;
+        for (int frame = 0; frame < 200; ++frame) {
+            frame_ms = 0.0;
+            for (std::size_t i = 0; i < current.size(); ++i) {
+                LodMode next = loop.select(current[i], 10.0, 20.0 + 2.0 * static_cast<double>(i), scale);
+                if (frame >= 100 && next != current[i]) {
+                    ++late_switches;
+                }
+                current[i] = next;
+                frame_ms += cost_ms[static_cast<int>(next)];
+            }
+            monitor.recordFrame(frame_ms);
+            loop.adapt(monitor);
+        }
+        const double fps = 1000.0 / frame_ms;
+        std::cout << "    closed loop: " << fps << " fps at " << loop.pixelTolerance() << " px" << std::endl;
+        assert(fps > 27.0 && fps < 33.0);
+        assert(loop.pixelTolerance() > 1.0);
+        assert(late_switches == 0u);
+    }
+
+    // Manager: Bildzeiten des Renderers speisen Bildrate und Regler
+    {
+        AssemblyManager manager;
+        manager.setTargetFps(60.0);
+        assert(std::abs(manager.lodGovernor().targetFps() - 60.0) < 1e-9);
+        for (int i = 0; i < 20; ++i) {
+            manager.recordFrame(40.0);
+        }
+        assert(std::abs(manager.measuredFps() - 25.0) < 1e-9);
+        assert(manager.lodGovernor().pixelTolerance() > 1.0);
+    }
+
+    // Stream: Stufe je Komponente, geladen wird die feinste sichtbare je Definition
+    {
+        Assembly row;
+        auto part = std::make_shared<Part>(Part("Bolt"));
+        std::vector<std::uint64_t> ids;
+        for (int k = 0; k < 3; ++k) {
+            Transform t;
+            t.tx = 0.0;
+            t.ty = 0.0;
+            t.tz = -std::pow(10.0, k + 1);
+            ids.push_back(row.addComponent(PartRef(part), t));
+        }
+        std::mutex lods_mutex;
+        std::vector<LodMode> lods;
+        auto tessellator = [&](const Part&, LodMode lod, TriangleMesh& mesh) {
+            std::lock_guard<std::mutex> lock(lods_mutex);
+            lods.push_back(lod);
+            mesh = subdividedCube(10.0, lod == LodMode::Full ? 4 : 1);
+            return true;
+        };
+        ThreadPool pool(2);
+        AssemblyStream stream(row, {}, tessellator, &pool);
+        auto shared = std::make_shared<LodGovernor>(30.0);
+        stream.setLodGovernor(shared);
+        StreamingView view;
+        view.eye = Point3D{0.0, 0.0, 0.0};
+        view.target = Point3D{0.0, 0.0, -1.0};
+        StreamingStats stats = stream.update(view);
+        assert(stats.visible_components == 3u && stats.lod_switches == 3u);
+        stream.waitIdle();
+        assert(lods.size() == 1u && lods[0] == LodMode::Full);
+        assert(stream.lod(ids[0]) == LodMode::Full);
+        assert(stream.lod(ids[2]) != LodMode::Full);
+        // Ruhige Kamera: keine Stufenwechsel
+        stats = stream.update(view);
+        assert(stats.lod_switches == 0u);
+    }
+
+    std::cout << "  ✓ LOD governor tests passed" << std::endl;
+}
+
 int main() {
     std::cout << "Running Core Modeler Tests..." << std::endl;
     std::cout << std::endl;
@@ -147,6 +1293,17 @@ int main() {
         testSketchGeometry();
         testPartFeatures();
         testAssemblyMates();
+        testMateSolverGlobal();
+        testSharedPartDefinitions();
+        testAssemblyHierarchy();
+        testInterferenceBroadPhase();
+        testPreciseInterference();
+        testInterferenceSession();
+        testClearance();
+        testAssemblyLoading();
+        testAssemblyCache();
+        testAssemblyStreaming();
+        testLodGovernor();
         testConstraintSolver();
         
         std::cout << std::endl;
@@ -1,7 +1,33 @@
 #include <gtest/gtest.h>
 #include "interop/ImportExportService.h"
+#include "interop/IoPipeline.h"
+#include "interop/StepAssemblyWriter.h"
+#include "interop/StepFileParser.h"
+#include "interop/ZipArchive.h"
+#include "core/parallel/ThreadPool.h"
+#ifdef CAD_USE_EIGENER_KERN
+#include "interop/StepBrepTranslator.h"
+#include "core/kernel/geometry3d/CylinderSurface.h"
+#include "core/kernel/io/MeshGenerator.h"
+#include "core/kernel/topology/Edge.h"
+#include "core/kernel/topology/Face.h"
+#include "core/kernel/topology/Solid.h"
+#include "core/kernel/topology/Vertex.h"
+#include <array>
+#include <map>
+#include <sstream>
+#endif
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <fstream>
 #include <cstdio>
+#include <cmath>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <utility>
 
 using namespace cad::interop;
 
@@ -72,3 +98,1847 @@ TEST(ImportExportIntegrationTest, GltfImportExport) {
     std::remove(test_file.c_str());
     std::remove("test_export.gltf");
 }
+
+TEST(ImportExportIntegrationTest, StepParserMultiLineEntities) {
+    const std::string text =
+        "ISO-10303-21;\n"
+        "HEADER;\n"
+        "FILE_DESCRIPTION(('Hydra CAD test'),'2;1');\n"
+        "FILE_NAME('bracket.stp','2026-01-01T00:00:00',('A. Author'),(''),'','','');\n"
+        "FILE_SCHEMA(('AUTOMOTIVE_DESIGN { 1 0 10303 214 1 1 1 1 }'));\n"
+        "ENDSEC;\n"
+        "DATA;\n"
+        "/* Kommentar mit #99=FAKE(); */\n"
+        "#1 = CARTESIAN_POINT ( 'Origin' ,\n"
+        "   ( 1.5, -2.E-1 ,\n"
+        "     3. ) ) ;\n"
+        "#2=DIRECTION('',(0.,0.,1.));\n"
+        "#3=MANIFOLD_SOLID_BREP('It''s; a \\X2\\00C400FC\\X0\\ \\X\\E9 part',#4);\n"
+        "#4=CLOSED_SHELL('',(#5,\n"
+        "#6));\n"
+        "#7=(GEOMETRIC_REPRESENTATION_CONTEXT(3)\n"
+        "GLOBAL_UNIT_ASSIGNED_CONTEXT((#8,#9))\n"
+        "REPRESENTATION_CONTEXT('ctx','3D'));\n"
+        "#10=MEASURE_REPRESENTATION_ITEM('len',LENGTH_MEASURE(25.4),#11);\n"
+        "#12=SURFACE_SIDE_STYLE('',(),.T.,$,*);\n"
+        "ENDSEC;\n"
+        "END-ISO-10303-21;\n";
+
+    StepFileParser parser;
+    ASSERT_TRUE(parser.parseText(text)) << parser.error();
+    EXPECT_TRUE(parser.hasHeader());
+    EXPECT_TRUE(parser.hasData());
+    ASSERT_EQ(parser.headerEntities().size(), 3u);
+    EXPECT_EQ(parser.headerEntities()[2].type, "FILE_SCHEMA");
+    ASSERT_EQ(parser.getEntities().size(), 7u);
+    EXPECT_EQ(parser.maxId(), 12u);
+    EXPECT_EQ(parser.find(99), nullptr);
+    EXPECT_EQ(parser.find(5), nullptr);
+
+    const StepEntity* point = parser.find(1);
+    ASSERT_NE(point, nullptr);
+    EXPECT_EQ(point->type, "CARTESIAN_POINT");
+    ASSERT_EQ(point->parameter_count, 2u);
+    std::vector<std::string_view> coords = StepFileParser::splitList(point->parameter(1));
+    ASSERT_EQ(coords.size(), 3u);
+    double value = 0.0;
+    ASSERT_TRUE(StepFileParser::asReal(coords[1], value));
+    EXPECT_DOUBLE_EQ(value, -0.2);
+    ASSERT_TRUE(StepFileParser::asReal(coords[2], value));
+    EXPECT_DOUBLE_EQ(value, 3.0);
+
+    std::string name;
+    ASSERT_TRUE(StepFileParser::asString(parser.find(3)->parameter(0), name));
+    EXPECT_EQ(name, "It's; a \xC3\x84\xC3\xBC \xC3\xA9 part");
+    std::uint32_t ref = 0;
+    ASSERT_TRUE(StepFileParser::asReference(parser.find(3)->parameter(1), ref));
+    EXPECT_EQ(ref, 4u);
+    EXPECT_EQ(StepFileParser::splitList(parser.find(4)->parameter(1)).size(), 2u);
+
+    const StepEntity* context = parser.find(7);
+    ASSERT_NE(context, nullptr);
+    EXPECT_TRUE(context->isComplex());
+    ASSERT_EQ(context->parameter_count, 3u);
+    std::string_view part_type;
+    std::vector<std::string_view> part_parameters;
+    ASSERT_TRUE(StepFileParser::splitRecord(context->parameter(2), part_type, part_parameters));
+    EXPECT_EQ(part_type, "REPRESENTATION_CONTEXT");
+    ASSERT_EQ(part_parameters.size(), 2u);
+    EXPECT_EQ(part_parameters[1], "'3D'");
+
+    ASSERT_TRUE(StepFileParser::asReal(parser.find(10)->parameter(1), value));
+    EXPECT_DOUBLE_EQ(value, 25.4);
+    const StepEntity* style = parser.find(12);
+    ASSERT_EQ(style->parameter_count, 5u);
+    EXPECT_TRUE(StepFileParser::splitList(style->parameter(1)).empty());
+    std::string_view flag;
+    ASSERT_TRUE(StepFileParser::asEnumeration(style->parameter(2), flag));
+    EXPECT_EQ(flag, "T");
+    EXPECT_EQ(style->parameter(3), "$");
+    EXPECT_EQ(style->parameter(4), "*");
+}
+
+TEST(ImportExportIntegrationTest, StepParserErrors) {
+    StepFileParser parser;
+    EXPECT_FALSE(parser.parseFile("does_not_exist.stp"));
+    EXPECT_FALSE(parser.parseText("solid cube\nendsolid\n"));
+    EXPECT_FALSE(parser.error().empty());
+
+    // Abgeschnittene Datei: gelesene Instanzen bleiben, Fehler mit Position
+    EXPECT_FALSE(parser.parseText("ISO-10303-21;\nDATA;\n#1=A(1);\n#2=B('open\n"));
+    EXPECT_NE(parser.error().find("Byte"), std::string::npos);
+    ASSERT_EQ(parser.getEntities().size(), 1u);
+    EXPECT_NE(parser.find(1), nullptr);
+
+    // Sehr dünne Ids: Tabelle über Suche statt dicht
+    ASSERT_TRUE(parser.parseText("ISO-10303-21;\nDATA;\n#4000000000=A(1);\n#7=B(2);\nENDSEC;\nEND-ISO-10303-21;\n"))
+        << parser.error();
+    ASSERT_NE(parser.find(4000000000u), nullptr);
+    EXPECT_EQ(parser.find(4000000000u)->type, "A");
+    EXPECT_EQ(parser.find(7)->type, "B");
+    EXPECT_EQ(parser.find(8), nullptr);
+}
+
+TEST(ImportExportIntegrationTest, StepParserParallelMatchesSequential) {
+    // Zeichenketten über Zeilen mit „#n=“ am Zeilenanfang: falsche Schnittstellen für die Teilung
+    std::string text = "ISO-10303-21;\nHEADER;\nFILE_SCHEMA(('CONFIG_CONTROL_DESIGN'));\nENDSEC;\nDATA;\n";
+    const int count = 200000;
+    for (int i = 1; i <= count; ++i) {
+        const std::string id = std::to_string(i);
+        if (i % 997 == 0) {
+            text += "#" + id + "=PRODUCT('p" + id + "','text\n#" + std::to_string(i + 1) + "=FAKE(1);\n',(#" +
+                    std::to_string(i - 1) + "));\n";
+        } else if (i % 1009 == 0) {
+            text += "#" + id + "=NOTE(/* Kommentar\n#" + std::to_string(i + 1) + "=FAKE(1);\n*/ 'x');\n";
+        } else {
+            text += "#" + id + "=CARTESIAN_POINT('',\n  (" + std::to_string(i) + ".,0.5,-1.E-3));\n";
+        }
+    }
+    text += "ENDSEC;\nEND-ISO-10303-21;\n";
+
+    StepFileParser sequential;
+    sequential.setChunkBytes(text.size());
+    ASSERT_TRUE(sequential.parseText(text)) << sequential.error();
+    EXPECT_EQ(sequential.chunkCount(), 1u);
+
+    cad::core::ThreadPool pool(4);
+    StepFileParser parallel;
+    parallel.setThreadPool(&pool);
+    parallel.setChunkBytes(64 * 1024);
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(parallel.parseText(text)) << parallel.error();
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "    " << text.size() / (1024 * 1024) << " MB, " << count << " entities: " << ms << " ms in "
+              << parallel.chunkCount() << " chunks" << std::endl;
+    EXPECT_GT(parallel.chunkCount(), 1u);
+
+    ASSERT_EQ(parallel.getEntities().size(), static_cast<std::size_t>(count));
+    ASSERT_EQ(sequential.getEntities().size(), parallel.getEntities().size());
+    for (std::size_t i = 0; i < parallel.getEntities().size(); ++i) {
+        const StepEntity& a = sequential.getEntities()[i];
+        const StepEntity& b = parallel.getEntities()[i];
+        ASSERT_EQ(a.id, b.id);
+        ASSERT_EQ(b.id, i + 1);
+        ASSERT_EQ(a.type, b.type);
+        ASSERT_EQ(a.parameter_count, b.parameter_count);
+        for (std::uint32_t k = 0; k < a.parameter_count; ++k) {
+            ASSERT_EQ(a.parameters[k], b.parameters[k]);
+        }
+    }
+    EXPECT_EQ(parallel.find(997)->type, "PRODUCT");
+    EXPECT_EQ(parallel.find(1009)->type, "NOTE");
+    double x = 0.0;
+    ASSERT_TRUE(StepFileParser::asReal(StepFileParser::splitList(parallel.find(12345)->parameter(1))[0], x));
+    EXPECT_DOUBLE_EQ(x, 12345.0);
+}
+
+TEST(ImportExportIntegrationTest, StepAssemblyFromMultiLineEntities) {
+    std::string test_file = "test_multiline.step";
+    {
+        std::ofstream file(test_file);
+        file << "ISO-10303-21;\nHEADER;\nENDSEC;\nDATA;\n";
+        file << "#1=MANIFOLD_SOLID_BREP(\n'Bracket',\n#2);\n";
+        file << "#3=MANIFOLD_SOLID_BREP('Pin'\n,#2);\n";
+        file << "ENDSEC;\nEND-ISO-10303-21;\n";
+    }
+    ImportExportService service;
+    cad::core::Assembly assembly = service.importStepToAssembly(test_file);
+    ASSERT_EQ(assembly.components().size(), 2u);
+    EXPECT_EQ(assembly.components()[0].part->name(), "Bracket");
+    EXPECT_EQ(assembly.components()[1].part->name(), "Pin");
+    std::remove(test_file.c_str());
+}
+
+TEST(ImportExportIntegrationTest, StepAssemblyWriterSharesDefinitions) {
+    // 500 Schrauben + 500 Muttern an einer Platte, dazu eine Unterbaugruppe mit eigener Lage
+    cad::core::PartRef bolt(cad::core::Part("Bolt M6"));
+    cad::core::PartRef nut(cad::core::Part("Nut 'M6'"));
+    cad::core::Assembly assembly;
+    assembly.addComponent(cad::core::Part("Plate"), cad::core::Transform{});
+    for (int i = 0; i < 500; ++i) {
+        cad::core::Transform at;
+        at.tx = 0.1 * i;
+        at.ty = -2.5;
+        at.tz = 1e-7 * i;
+        assembly.addComponent(bolt, at);
+        cad::core::setOrientation(at, cad::core::quaternionFromEuler(3.14159265358979323846, 0.0, 0.01 * i));
+        assembly.addComponent(nut, at);
+    }
+    cad::core::Transform group_at;
+    group_at.tx = 100.0;
+    cad::core::setOrientation(group_at, cad::core::quaternionFromEuler(0.0, 0.0, 1.5707963267948966));
+    const std::uint64_t group = assembly.addComponent(cad::core::Part("Bracket"), group_at);
+    cad::core::Transform inner_at;
+    inner_at.tx = 5.0;
+    assembly.addComponent(bolt, inner_at, group);
+
+    const std::string test_file = "test_instances.step";
+    StepWriteOptions options;
+    options.buffer_bytes = 4096;
+    StepAssemblyWriter writer(options);
+    ASSERT_TRUE(writer.write(test_file, assembly));
+    EXPECT_EQ(writer.stats().instances, assembly.components().size());
+    // Bolt, Nut, Plate, Bracket (Unterbaugruppe), Wurzel
+    EXPECT_EQ(writer.stats().definitions, 5u);
+    EXPECT_LT(writer.stats().bytes / assembly.components().size(), 1024u);
+
+    StepFileParser parser;
+    ASSERT_TRUE(parser.parseFile(test_file));
+    EXPECT_EQ(parser.size(), writer.stats().bytes);
+    EXPECT_EQ(parser.maxId(), writer.stats().entities);
+    std::size_t products = 0;
+    std::size_t occurrences = 0;
+    for (const StepEntity& entity : parser.getEntities()) {
+        products += entity.type == "PRODUCT" ? 1 : 0;
+        occurrences += entity.type == "NEXT_ASSEMBLY_USAGE_OCCURRENCE" ? 1 : 0;
+    }
+    EXPECT_EQ(products, 5u);
+    EXPECT_EQ(occurrences, assembly.components().size());
+
+    ImportExportService service;
+    cad::core::Assembly imported = service.importStepToAssembly(test_file);
+    const auto& original = assembly.components();
+    const auto& read = imported.components();
+    ASSERT_EQ(read.size(), original.size());
+    for (std::size_t i = 0; i < read.size(); ++i) {
+        EXPECT_EQ(read[i].part->name(), original[i].part->name());
+        // to_chars: kürzeste Darstellung, exakt zurückgelesen
+        EXPECT_EQ(read[i].transform.tx, original[i].transform.tx);
+        EXPECT_EQ(read[i].transform.tz, original[i].transform.tz);
+        const cad::core::Quaternion a = cad::core::orientationOf(read[i].transform);
+        const cad::core::Quaternion b = cad::core::orientationOf(original[i].transform);
+        EXPECT_NEAR(std::abs(a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z), 1.0, 1e-12);
+        EXPECT_EQ(read[i].parent_id != 0, original[i].parent_id != 0);
+    }
+    // Geteilte Definitionen bleiben nach dem Import geteilt
+    EXPECT_TRUE(read[1].part.sharesWith(read[3].part));
+    EXPECT_TRUE(read[1].part.sharesWith(read.back().part));
+    EXPECT_FALSE(read[1].part.sharesWith(read[2].part));
+
+    IoResult result = service.exportAssemblyToStep(test_file, assembly, true);
+    EXPECT_TRUE(result.success);
+    std::remove(test_file.c_str());
+}
+
+TEST(ImportExportIntegrationTest, ObjReaderFacesGroupsAndIndices) {
+    const std::string text =
+        "# Kommentar\n"
+        "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+        "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+        "vn 0 0 1\n"
+        "g plate\n"
+        "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+        "o wedge\n"
+        "v 0 0 1\r\nv 2 0 1\nv 2 2 1\nv 1 3 1\nv 0 2 1\n"
+        "f -5 -4 -3 -2 -1 # Fünfeck, relativ\n"
+        "g plate\n"
+        "f 1//1 3//1 4//1\n";
+    ObjReader reader;
+    ASSERT_TRUE(reader.readText(text)) << reader.error();
+    const std::vector<ObjBody>& bodies = reader.bodies();
+    ASSERT_EQ(bodies.size(), 2u);
+    EXPECT_EQ(bodies[0].name, "plate");
+    EXPECT_EQ(bodies[1].name, "wedge");
+    EXPECT_EQ(reader.stats().positions, 9u);
+    EXPECT_EQ(reader.stats().faces, 3u);
+    EXPECT_EQ(reader.stats().triangles, 2u + 3u + 1u);
+
+    // plate: Viereck mit v/t/n, dazu ein Dreieck v//n (andere Ecken, da ohne UV)
+    const ObjBody& plate = bodies[0];
+    EXPECT_EQ(plate.mesh.indices.size(), 9u);
+    EXPECT_EQ(plate.mesh.vertices.size(), 7u * 3);
+    ASSERT_EQ(plate.uvs.size(), 7u * 2);
+    ASSERT_EQ(plate.normals.size(), 7u * 3);
+    EXPECT_DOUBLE_EQ(plate.uvs[2 * 2], 1.0);
+    EXPECT_DOUBLE_EQ(plate.uvs[2 * 2 + 1], 1.0);
+    EXPECT_DOUBLE_EQ(plate.normals[6 * 3 + 2], 1.0);
+
+    // wedge: Fächer 0-1-2, 0-2-3, 0-3-4 über die Punkte 5..9
+    const ObjBody& wedge = bodies[1];
+    ASSERT_EQ(wedge.mesh.indices.size(), 9u);
+    EXPECT_EQ(wedge.mesh.indices[3], 0u);
+    EXPECT_EQ(wedge.mesh.indices[4], 2u);
+    EXPECT_EQ(wedge.mesh.indices[5], 3u);
+    EXPECT_DOUBLE_EQ(wedge.mesh.vertices[3 * 3 + 1], 3.0);
+    EXPECT_TRUE(wedge.uvs.empty());
+    EXPECT_TRUE(wedge.normals.empty());
+
+    EXPECT_FALSE(reader.readText("v 0 0 0\nv 1 0 0\nf 1 2 3\n"));
+    EXPECT_NE(reader.error().find("index"), std::string::npos);
+    EXPECT_FALSE(reader.readText("v 0 0 0\nv 1 x 0\n"));
+    EXPECT_NE(reader.error().find("byte 12"), std::string::npos);
+    EXPECT_FALSE(reader.readFile("does_not_exist.obj"));
+}
+
+TEST(ImportExportIntegrationTest, ObjReaderParallelMatchesSequential) {
+    // Gitter aus 400 Streifen, relative und absolute Indizes, eine Gruppe je 50 Streifen
+    std::string text;
+    std::size_t written = 0;
+    for (int strip = 0; strip < 400; ++strip) {
+        if (strip % 50 == 0) {
+            text += "g strip" + std::to_string(strip / 50) + "\n";
+        }
+        for (int i = 0; i < 64; ++i) {
+            text += "v " + std::to_string(i * 0.5) + " " + std::to_string(strip) + " " + std::to_string(i % 3) + "\n";
+            text += "v " + std::to_string(i * 0.5) + " " + std::to_string(strip + 1) + " 0.25\n";
+        }
+        written += 128;
+        for (int i = 0; i + 1 < 64; ++i) {
+            if (i % 2) {
+                text += "f -" + std::to_string(128 - 2 * i) + " -" + std::to_string(126 - 2 * i) + " -" +
+                        std::to_string(125 - 2 * i) + " -" + std::to_string(127 - 2 * i) + "\n";
+            } else {
+                const std::size_t base = written - 128 + 2 * i + 1;
+                text += "f " + std::to_string(base) + " " + std::to_string(base + 2) + " " +
+                        std::to_string(base + 3) + " " + std::to_string(base + 1) + "\n";
+            }
+        }
+    }
+
+    ObjReader sequential;
+    ASSERT_TRUE(sequential.readText(text)) << sequential.error();
+    EXPECT_EQ(sequential.stats().chunks, 1u);
+
+    cad::core::ThreadPool pool(4);
+    ObjReader parallel;
+    parallel.setThreadPool(&pool);
+    parallel.setChunkBytes(text.size() / 16);
+    ASSERT_TRUE(parallel.readText(text)) << parallel.error();
+    EXPECT_GE(parallel.stats().chunks, 16u);
+
+    ASSERT_EQ(parallel.bodies().size(), 8u);
+    ASSERT_EQ(parallel.bodies().size(), sequential.bodies().size());
+    EXPECT_EQ(parallel.stats().triangles, 400u * 63 * 2);
+    for (std::size_t b = 0; b < parallel.bodies().size(); ++b) {
+        EXPECT_EQ(parallel.bodies()[b].name, sequential.bodies()[b].name);
+        EXPECT_EQ(parallel.bodies()[b].mesh.vertices, sequential.bodies()[b].mesh.vertices);
+        EXPECT_EQ(parallel.bodies()[b].mesh.indices, sequential.bodies()[b].mesh.indices);
+        EXPECT_EQ(parallel.bodies()[b].mesh.vertices.size(), 50u * 128 * 3);
+    }
+}
+
+TEST(ImportExportIntegrationTest, ObjWriterBodiesAndAssembly) {
+    ObjBody body;
+    body.name = "quad";
+    body.mesh.vertices = {0.0, 0.0, 0.0, 0.1, 0.0, 0.0, 0.1, 1e-9, 0.0, 0.0, 1.0 / 3.0, 0.0};
+    body.mesh.indices = {0, 1, 2, 0, 2, 3};
+    body.normals = {0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0};
+    body.uvs = {0.0, 0.0, 1.0, 0.0, 1.0, 1.0, 0.0, 1.0};
+    ObjBody plain = body;
+    plain.name = "plain";
+    plain.normals.clear();
+    plain.uvs.clear();
+
+    ImportExportService service;
+    const std::string test_file = "test_bodies.obj";
+    ASSERT_TRUE(service.exportObj(test_file, {body, plain}).success);
+    std::vector<ObjBody> read;
+    ASSERT_TRUE(service.importObjBodies(test_file, read).success);
+    ASSERT_EQ(read.size(), 2u);
+    EXPECT_EQ(read[0].name, "quad");
+    // to_chars: exakt zurückgelesen
+    EXPECT_EQ(read[0].mesh.vertices, body.mesh.vertices);
+    EXPECT_EQ(read[0].mesh.indices, body.mesh.indices);
+    EXPECT_EQ(read[0].normals, body.normals);
+    EXPECT_EQ(read[0].uvs, body.uvs);
+    EXPECT_EQ(read[1].mesh.vertices, plain.mesh.vertices);
+    EXPECT_TRUE(read[1].normals.empty());
+
+    // Baugruppe: 100 Vorkommen einer Definition, ein Teil ohne Netz
+    cad::core::PartRef screw(cad::core::Part("Screw"));
+    cad::core::Assembly assembly;
+    for (int i = 0; i < 100; ++i) {
+        cad::core::Transform at;
+        at.tx = 10.0 * i;
+        assembly.addComponent(screw, at);
+    }
+    // Unterbaugruppe mit Netz-Definition: nur ihr Kind wird geschrieben, in Weltlage
+    cad::core::Transform rack_at;
+    rack_at.tx = 5000.0;
+    const std::uint64_t rack = assembly.addComponent(screw, rack_at);
+    assembly.addComponent(screw, cad::core::Transform{}, rack);
+    assembly.addComponent(cad::core::Part("Empty"), cad::core::Transform{});
+    int tessellations = 0;
+    ObjWriter::Tessellator tessellator = [&](const cad::core::Part& part, cad::core::TriangleMesh& mesh) {
+        ++tessellations;
+        if (part.name() != "Screw") {
+            return false;
+        }
+        mesh.vertices = {0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0};
+        mesh.indices = {0, 1, 2};
+        return true;
+    };
+    IoResult result = service.exportAssemblyToObj(test_file, assembly, tessellator);
+    ASSERT_TRUE(result.success) << result.message;
+    EXPECT_EQ(tessellations, 2);
+    ASSERT_TRUE(service.importObjBodies(test_file, read).success);
+    ASSERT_EQ(read.size(), 101u);
+    EXPECT_EQ(read[0].name, "Screw_" + std::to_string(assembly.components()[0].id));
+    EXPECT_DOUBLE_EQ(read[99].mesh.vertices[3], 991.0);
+    EXPECT_EQ(read[100].name, "Screw_" + std::to_string(assembly.components()[101].id));
+    EXPECT_DOUBLE_EQ(read[100].mesh.vertices[0], 5000.0);
+
+    ASSERT_TRUE(service.importObj(test_file).success);
+    std::remove(test_file.c_str());
+}
+
+TEST(ImportExportIntegrationTest, PlyReaderAsciiMeshAndSkippedElements) {
+    const std::string text =
+        "ply\r\n"
+        "format ascii 1.0\n"
+        "comment Scanner\n"
+        "element vertex 4\n"
+        "property float x\nproperty float y\nproperty float z\n"
+        "property float nx\nproperty float ny\nproperty float nz\n"
+        "property uchar red\nproperty uchar green\nproperty uchar blue\n"
+        "property float confidence\n"
+        "element face 1\n"
+        "property uchar flags\n"
+        "property list uchar int vertex_indices\n"
+        "element edge 1\n"
+        "property int vertex1\nproperty int vertex2\n"
+        "end_header\n"
+        "0 0 0 0 0 1 255 0 0 0.5\n"
+        "1 0 0 0 0 1 0 255 0 0.5\n"
+        "1 1 0 0 0 1 0 0 255 0.5\n"
+        "0 1 0.25 0 0 1 10 20 30 0.5\n"
+        "7 4 0 1 2 3\n"
+        "0 1\n";
+    PlyReader reader;
+    PlyData data;
+    ASSERT_TRUE(reader.readText(text, data)) << reader.error();
+    EXPECT_EQ(reader.stats().format, PlyFormat::Ascii);
+    EXPECT_EQ(reader.stats().vertices, 4u);
+    EXPECT_EQ(reader.stats().faces, 1u);
+    EXPECT_EQ(reader.stats().triangles, 2u);
+    EXPECT_EQ(reader.stats().skipped_elements, 1u);
+    EXPECT_FALSE(data.isPointCloud());
+    EXPECT_EQ(data.mesh.indices, (std::vector<unsigned>{0, 1, 2, 0, 2, 3}));
+    EXPECT_DOUBLE_EQ(data.mesh.vertices[11], 0.25);
+    ASSERT_EQ(data.normals.size(), 12u);
+    EXPECT_DOUBLE_EQ(data.normals[2], 1.0);
+    ASSERT_EQ(data.colors.size(), 12u);
+    EXPECT_EQ(data.colors[4], 255);
+    EXPECT_EQ(data.colors[11], 30);
+
+    // Index außerhalb der Punkte
+    std::string bad = text;
+    bad.replace(bad.find("7 4 0 1 2 3"), 11, "7 3 0 1 9");
+    EXPECT_FALSE(reader.readText(bad, data));
+    EXPECT_NE(reader.error().find("vertex index"), std::string::npos);
+    EXPECT_TRUE(data.mesh.vertices.empty());
+
+    // Anzahl im Kopf, deren count * 3 überläuft bzw. die weit über die Daten hinausgeht
+    for (const char* count : {"element vertex 6148914691236517718", "element vertex 4000000000"}) {
+        bad = text;
+        bad.replace(bad.find("element vertex 4"), 16, count);
+        EXPECT_FALSE(reader.readText(bad, data));
+        EXPECT_NE(reader.error().find("truncated"), std::string::npos) << reader.error();
+    }
+}
+
+TEST(ImportExportIntegrationTest, PlyBinaryRoundTripBothEndians) {
+    PlyData mesh;
+    mesh.mesh.vertices = {0.0, 0.0, 0.0, 0.1, 0.0, 0.0, 0.1, 1e-9, 0.0, 0.0, 1.0 / 3.0, -2.5};
+    mesh.mesh.indices = {0, 1, 2, 0, 2, 3};
+    mesh.normals = {0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0};
+    mesh.colors = {255, 0, 0, 0, 255, 0, 0, 0, 255, 10, 20, 30};
+
+    ImportExportService service;
+    const std::string test_file = "test_mesh.ply";
+    for (PlyFormat format : {PlyFormat::BinaryLittleEndian, PlyFormat::BinaryBigEndian, PlyFormat::Ascii}) {
+        for (bool double_precision : {false, true}) {
+            PlyWriteOptions options;
+            options.format = format;
+            options.double_precision = double_precision;
+            ASSERT_TRUE(service.exportPly(test_file, mesh, options).success);
+
+            PlyReader reader;
+            PlyData read;
+            ASSERT_TRUE(reader.readFile(test_file, read)) << reader.error();
+            EXPECT_EQ(reader.stats().format, format);
+            EXPECT_EQ(read.mesh.indices, mesh.mesh.indices);
+            EXPECT_EQ(read.colors, mesh.colors);
+            EXPECT_EQ(read.normals, mesh.normals);
+            ASSERT_EQ(read.mesh.vertices.size(), mesh.mesh.vertices.size());
+            for (std::size_t i = 0; i < mesh.mesh.vertices.size(); ++i) {
+                // float: exakt der gerundete Wert; double und ASCII: exakt
+                const double expected = double_precision || format == PlyFormat::Ascii
+                                            ? mesh.mesh.vertices[i]
+                                            : static_cast<double>(static_cast<float>(mesh.mesh.vertices[i]));
+                EXPECT_EQ(read.mesh.vertices[i], expected);
+            }
+        }
+    }
+
+    // Abgeschnittene Binärdaten
+    ASSERT_TRUE(service.exportPly(test_file, mesh).success);
+    std::string bytes;
+    {
+        std::ifstream in(test_file, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    PlyReader reader;
+    PlyData read;
+    EXPECT_FALSE(reader.readText(bytes.substr(0, bytes.size() - 5), read));
+    EXPECT_NE(reader.error().find("truncated"), std::string::npos);
+    EXPECT_FALSE(reader.readText(bytes.substr(0, bytes.find("end_header")), read));
+    std::string crafted = bytes;
+    crafted.replace(crafted.find("element vertex 4"), 16, "element vertex 6148914691236517718");
+    EXPECT_FALSE(reader.readText(crafted, read));
+    EXPECT_NE(reader.error().find("truncated"), std::string::npos);
+    crafted = bytes;
+    crafted.replace(crafted.find("element face 2"), 14, "element face 4000000000");
+    EXPECT_FALSE(reader.readText(crafted, read));
+    EXPECT_NE(reader.error().find("truncated"), std::string::npos);
+
+    IoResult result = service.importPly(test_file);
+    EXPECT_TRUE(result.success) << result.message;
+    EXPECT_EQ(result.message, "PLY file imported: 4 vertices, 2 faces");
+    std::remove(test_file.c_str());
+}
+
+TEST(ImportExportIntegrationTest, PlyPointCloudParallelBlocks) {
+    // Mehrere Punktblöcke, damit die Umwandlung parallel läuft
+    const std::size_t count = 300000;
+    PlyData cloud;
+    cloud.mesh.vertices.resize(count * 3);
+    cloud.colors.resize(count * 3);
+    for (std::size_t i = 0; i < count; ++i) {
+        cloud.mesh.vertices[i * 3] = static_cast<double>(i);
+        cloud.mesh.vertices[i * 3 + 1] = 0.5 * static_cast<double>(i % 1000);
+        cloud.mesh.vertices[i * 3 + 2] = -0.25;
+        cloud.colors[i * 3] = static_cast<std::uint8_t>(i % 256);
+    }
+    ImportExportService service;
+    const std::string test_file = "test_cloud.ply";
+    PlyWriteOptions options;
+    options.format = PlyFormat::BinaryBigEndian;
+    options.double_precision = true;
+    ASSERT_TRUE(service.exportPly(test_file, cloud, options).success);
+
+    PlyData read;
+    IoResult result = service.importPlyData(test_file, read);
+    ASSERT_TRUE(result.success) << result.message;
+    EXPECT_NE(result.message.find("point cloud"), std::string::npos);
+    EXPECT_TRUE(read.isPointCloud());
+    EXPECT_TRUE(read.normals.empty());
+
+    cad::core::ThreadPool pool(4);
+    PlyReader reader;
+    reader.setThreadPool(&pool);
+    PlyData parallel;
+    ASSERT_TRUE(reader.readFile(test_file, parallel)) << reader.error();
+    EXPECT_EQ(parallel.mesh.vertices, cloud.mesh.vertices);
+    EXPECT_EQ(parallel.colors, cloud.colors);
+    EXPECT_EQ(read.mesh.vertices, parallel.mesh.vertices);
+    std::remove(test_file.c_str());
+}
+
+TEST(ImportExportIntegrationTest, GltfAssemblyInstancedAndQuantized) {
+    // 50 Vorkommen einer Schraube + ein Einzelteil; Würfel als Dreieckssuppe (36 Ecken)
+    cad::core::PartRef bolt(cad::core::Part("Bolt"));
+    cad::core::Assembly assembly;
+    for (int i = 0; i < 50; ++i) {
+        cad::core::Transform at;
+        at.tx = 20.0 * i;
+        at.rz = 0.1 * i;
+        assembly.addComponent(bolt, at);
+    }
+    assembly.addComponent(cad::core::Part("Bracket"), cad::core::Transform{});
+    int tessellations = 0;
+    GltfWriter::Tessellator tessellator = [&](const cad::core::Part&, cad::core::TriangleMesh& mesh) {
+        ++tessellations;
+        const double corner[8][3] = {{0, 0, 0}, {2, 0, 0}, {2, 1, 0}, {0, 1, 0},
+                                     {0, 0, 1}, {2, 0, 1}, {2, 1, 1}, {0, 1, 1}};
+        const unsigned faces[12][3] = {{0, 2, 1}, {0, 3, 2}, {4, 5, 6}, {4, 6, 7}, {0, 1, 5}, {0, 5, 4},
+                                       {1, 2, 6}, {1, 6, 5}, {2, 3, 7}, {2, 7, 6}, {3, 0, 4}, {3, 4, 7}};
+        for (const auto& face : faces) {
+            for (unsigned v : face) {
+                mesh.vertices.insert(mesh.vertices.end(), corner[v], corner[v] + 3);
+                mesh.indices.push_back(static_cast<unsigned>(mesh.indices.size()));
+            }
+        }
+        return true;
+    };
+    auto readFile = [](const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    };
+    auto readUint32 = [](const std::string& bytes, std::size_t at) {
+        return static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[at])) |
+               static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[at + 1])) << 8 |
+               static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[at + 2])) << 16 |
+               static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[at + 3])) << 24;
+    };
+
+    const std::string test_file = "test_assembly.glb";
+    GltfWriter plain;
+    ASSERT_TRUE(plain.writeAssembly(test_file, assembly, tessellator)) << plain.error();
+    EXPECT_EQ(tessellations, 2);
+    // Verschweißt: 8 Ecken × 3 Flächenrichtungen
+    EXPECT_EQ(plain.stats().meshes, 2u);
+    EXPECT_EQ(plain.stats().vertices, 48u);
+    EXPECT_EQ(plain.stats().triangles, 24u);
+    EXPECT_EQ(plain.stats().instances, 51u);
+    EXPECT_EQ(plain.stats().nodes, 3u);
+    std::string bytes = readFile(test_file);
+    ASSERT_GE(bytes.size(), 20u);
+    EXPECT_EQ(bytes.substr(0, 4), "glTF");
+    EXPECT_EQ(readUint32(bytes, 4), 2u);
+    EXPECT_EQ(readUint32(bytes, 8), bytes.size());
+    const std::uint32_t json_length = readUint32(bytes, 12);
+    EXPECT_EQ(json_length % 4, 0u);
+    const std::string json = bytes.substr(20, json_length);
+    EXPECT_NE(json.find("\"EXT_mesh_gpu_instancing\":{\"attributes\":{\"TRANSLATION\""), std::string::npos);
+    EXPECT_EQ(json.find("KHR_mesh_quantization"), std::string::npos);
+    EXPECT_EQ(bytes.substr(20 + json_length + 4, 4), std::string("BIN\0", 4));
+
+    GltfWriteOptions options;
+    options.quantize = true;
+    GltfWriter quantized(options);
+    ASSERT_TRUE(quantized.writeAssembly(test_file, assembly, tessellator)) << quantized.error();
+    bytes = readFile(test_file);
+    const std::string quantized_json = bytes.substr(20, readUint32(bytes, 12));
+    EXPECT_NE(quantized_json.find("\"extensionsRequired\":[\"KHR_mesh_quantization\",\"EXT_mesh_gpu_instancing\"]"),
+              std::string::npos);
+    // Einheitlicher Maßstab: längste Achse nutzt den vollen int16-Bereich
+    EXPECT_NE(quantized_json.find("\"min\":[-32767,-16384,-16384],\"max\":[32767,16384,16384]"), std::string::npos);
+    EXPECT_NE(quantized_json.find("\"SCALE\""), std::string::npos);
+
+    // Ohne Instanzierung: ein Knoten je Vorkommen, eingebetteter Puffer
+    options.gpu_instancing = false;
+    options.binary = false;
+    ImportExportService service;
+    const std::string json_file = "test_assembly.gltf";
+    IoResult result = service.exportAssemblyToGltf(json_file, assembly, tessellator, options);
+    ASSERT_TRUE(result.success) << result.message;
+    EXPECT_EQ(result.message, "GLTF file exported successfully (JSON): 2 meshes, 51 instances");
+    const std::string text = readFile(json_file);
+    EXPECT_EQ(text.find("EXT_mesh_gpu_instancing"), std::string::npos);
+    EXPECT_NE(text.find("\"uri\":\"data:application/octet-stream;base64,"), std::string::npos);
+    EXPECT_NE(text.find("\"name\":\"Bolt_" + std::to_string(assembly.components()[49].id) + "\""), std::string::npos);
+
+    // Dichtes Netz: Ecke 12 + 12 → 8 + 4 Byte (Position, Normale), Indizes unverändert
+    cad::core::Assembly surface;
+    surface.addComponent(cad::core::Part("Surface"), cad::core::Transform{});
+    GltfWriter::Tessellator grid = [](const cad::core::Part&, cad::core::TriangleMesh& mesh) {
+        const unsigned n = 64;
+        for (unsigned j = 0; j < n; ++j) {
+            for (unsigned i = 0; i < n; ++i) {
+                mesh.vertices.insert(mesh.vertices.end(), {i * 1.0, j * 1.0, std::sin(i * 0.1) * std::cos(j * 0.1)});
+            }
+        }
+        for (unsigned j = 0; j + 1 < n; ++j) {
+            for (unsigned i = 0; i + 1 < n; ++i) {
+                const unsigned a = j * n + i;
+                mesh.indices.insert(mesh.indices.end(), {a, a + 1, a + n + 1, a, a + n + 1, a + n});
+            }
+        }
+        return true;
+    };
+    GltfWriter full;
+    ASSERT_TRUE(full.writeAssembly(test_file, surface, grid));
+    EXPECT_EQ(full.stats().vertices, 64u * 64);
+    GltfWriteOptions small_options;
+    small_options.quantize = true;
+    GltfWriter small(small_options);
+    ASSERT_TRUE(small.writeAssembly(test_file, surface, grid));
+    EXPECT_EQ(small.stats().vertices, 64u * 64);
+    EXPECT_LT(small.stats().bytes * 10, full.stats().bytes * 7);
+
+    EXPECT_TRUE(service.exportGltf(test_file, true).success);
+    EXPECT_EQ(readFile(test_file).substr(0, 4), "glTF");
+    std::remove(test_file.c_str());
+    std::remove(json_file.c_str());
+}
+
+TEST(ImportExportIntegrationTest, GltfReaderRoundTripSharesDefinitions) {
+    cad::core::PartRef bolt(cad::core::Part("Bolt"));
+    cad::core::Assembly assembly;
+    for (int i = 0; i < 40; ++i) {
+        cad::core::Transform at;
+        at.tx = 25.0 * i;
+        at.ty = -3.0 * i;
+        at.rz = 0.2 * i;
+        assembly.addComponent(bolt, at);
+    }
+    cad::core::Transform tilted;
+    tilted.tz = 50.0;
+    tilted.rx = 0.5;
+    assembly.addComponent(cad::core::Part("Bracket"), tilted);
+    GltfWriter::Tessellator tessellator = [](const cad::core::Part&, cad::core::TriangleMesh& mesh) {
+        mesh.vertices = {0, 0, 0, 2, 0, 0, 2, 1, 0, 0, 1, 0, 0, 0, 1, 2, 0, 1, 2, 1, 1, 0, 1, 1};
+        mesh.indices = {0, 2, 1, 0, 3, 2, 4, 5, 6, 4, 6, 7, 0, 1, 5, 0, 5, 4,
+                        1, 2, 6, 1, 6, 5, 2, 3, 7, 2, 7, 6, 3, 0, 4, 3, 4, 7};
+        return true;
+    };
+    // Mittelpunkte aller Körper in Weltlage, sortiert
+    auto centers = [](const cad::core::Assembly& a, const std::vector<GltfMesh>* meshes) {
+        std::vector<std::array<double, 3>> out;
+        for (const cad::core::AssemblyComponent& component : a.components()) {
+            const cad::core::TriangleMesh* mesh = nullptr;
+            if (meshes) {
+                for (const GltfMesh& m : *meshes) {
+                    if (m.part.sharesWith(component.part)) mesh = &m.mesh;
+                }
+                if (!mesh) continue;
+            }
+            double lo[3] = {1e300, 1e300, 1e300};
+            double hi[3] = {-1e300, -1e300, -1e300};
+            const std::vector<double> box = {0, 0, 0, 2, 0, 0, 2, 1, 0, 0, 1, 0, 0, 0, 1, 2, 0, 1, 2, 1, 1, 0, 1, 1};
+            const std::vector<double>& vertices = mesh ? mesh->vertices : box;
+            const cad::core::RigidFrame frame = cad::core::RigidFrame::fromTransform(a.worldTransform(component.id));
+            for (std::size_t v = 0; v + 2 < vertices.size(); v += 3) {
+                double w[3];
+                frame.apply(&vertices[v], w);
+                for (int k = 0; k < 3; ++k) {
+                    lo[k] = std::min(lo[k], w[k]);
+                    hi[k] = std::max(hi[k], w[k]);
+                }
+            }
+            out.push_back({0.5 * (lo[0] + hi[0]), 0.5 * (lo[1] + hi[1]), 0.5 * (lo[2] + hi[2])});
+        }
+        std::sort(out.begin(), out.end());
+        return out;
+    };
+    const auto expected = centers(assembly, nullptr);
+
+    ImportExportService service;
+    for (int variant = 0; variant < 3; ++variant) {
+        GltfWriteOptions options;
+        options.quantize = variant == 1;
+        options.gpu_instancing = variant != 2;
+        options.binary = variant != 2;
+        const std::string test_file = options.binary ? "test_roundtrip.glb" : "test_roundtrip.gltf";
+        ASSERT_TRUE(service.exportAssemblyToGltf(test_file, assembly, tessellator, options).success);
+
+        cad::core::ThreadPool pool(4);
+        GltfReader reader;
+        reader.setThreadPool(&pool);
+        ASSERT_TRUE(reader.readFile(test_file)) << reader.error();
+        // Geteilte Definitionen bleiben geteilt: ein Netz je Teil
+        EXPECT_EQ(reader.stats().meshes, 2u) << "variant " << variant;
+        EXPECT_EQ(reader.stats().instances, 41u);
+        EXPECT_EQ(reader.stats().triangles, 24u);
+        ASSERT_EQ(reader.meshes().size(), 2u);
+        EXPECT_EQ(reader.meshes()[0].name, "Bolt");
+        EXPECT_EQ(reader.meshes()[0].normals.size(), reader.meshes()[0].mesh.vertices.size());
+        EXPECT_EQ(reader.meshes()[0].part.useCount(), 41);
+        const auto actual = centers(reader.assembly(), &reader.meshes());
+        ASSERT_EQ(actual.size(), expected.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            for (int k = 0; k < 3; ++k) {
+                EXPECT_NEAR(actual[i][k], expected[i][k], 1e-3) << "variant " << variant << " body " << i;
+            }
+        }
+        cad::core::Assembly imported;
+        std::vector<GltfMesh> meshes;
+        IoResult result = service.importGltfToAssembly(test_file, imported, &meshes);
+        ASSERT_TRUE(result.success) << result.message;
+        EXPECT_EQ(result.message, "GLTF file imported: 2 meshes, 41 instances");
+        EXPECT_EQ(meshes.size(), 2u);
+        std::remove(test_file.c_str());
+    }
+}
+
+TEST(ImportExportIntegrationTest, GltfReaderHierarchyScaleAndExternalBuffer) {
+    // Vier Punkte als Dreiecksstreifen in externer .bin-Datei
+    const float positions[12] = {0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 0};
+    {
+        std::ofstream bin("test_scene.bin", std::ios::binary);
+        bin.write(reinterpret_cast<const char*>(positions), sizeof(positions));
+    }
+    const std::string json =
+        "{\"asset\":{\"version\":\"2.0\"},\"scene\":0,\"scenes\":[{\"nodes\":[0]}],"
+        "\"nodes\":[{\"name\":\"Group\",\"translation\":[10,0,0],\"children\":[1,2,3,4]},"
+        "{\"name\":\"Big\",\"mesh\":0,\"scale\":[2,2,2]},"
+        "{\"name\":\"Turned\",\"mesh\":0,\"matrix\":[0,1,0,0,-1,0,0,0,0,0,1,0,5,0,0,1]},"
+        "{\"name\":\"Mirrored\",\"mesh\":0,\"scale\":[-1,1,1]},"
+        "{\"name\":\"Camera\"}],"
+        "\"meshes\":[{\"name\":\"Quad\",\"primitives\":[{\"attributes\":{\"POSITION\":0},\"mode\":5},"
+        "{\"attributes\":{\"POSITION\":0},\"mode\":1}]}],"
+        "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":4,\"type\":\"VEC3\"}],"
+        "\"bufferViews\":[{\"buffer\":0,\"byteLength\":48}],"
+        "\"buffers\":[{\"byteLength\":48,\"uri\":\"test_scene.bin\"}]}";
+    const std::string test_file = "test_scene.gltf";
+    {
+        std::ofstream out(test_file);
+        out << json;
+    }
+    GltfImportOptions options;
+    options.unit_scale = 1.0;
+    options.y_up = false;
+    GltfReader reader(options);
+    ASSERT_TRUE(reader.readFile(test_file)) << reader.error();
+    EXPECT_EQ(reader.stats().nodes, 5u);
+    EXPECT_EQ(reader.stats().instances, 3u);
+    EXPECT_EQ(reader.stats().skipped_primitives, 1u);
+    // Maßstab 2 und Spiegelung als eigene Definitionen, Drehung bleibt in der Lage
+    ASSERT_EQ(reader.meshes().size(), 3u);
+    EXPECT_EQ(reader.stats().triangles, 6u);
+    const GltfMesh& big = reader.meshes()[0];
+    EXPECT_EQ(big.mesh.indices, (std::vector<unsigned>{0, 1, 2, 2, 1, 3}));
+    EXPECT_DOUBLE_EQ(big.mesh.vertices[9], 2.0);
+    const GltfMesh& plain = reader.meshes()[1];
+    EXPECT_DOUBLE_EQ(plain.mesh.vertices[9], 1.0);
+    const GltfMesh& mirrored = reader.meshes()[2];
+    EXPECT_DOUBLE_EQ(mirrored.mesh.vertices[3], -1.0);
+    EXPECT_EQ(mirrored.mesh.indices, (std::vector<unsigned>{0, 2, 1, 2, 3, 1}));
+
+    const cad::core::Assembly& assembly = reader.assembly();
+    ASSERT_EQ(assembly.components().size(), 4u);
+    EXPECT_EQ(assembly.components()[0].part->name(), "Group");
+    const cad::core::AssemblyComponent& turned = assembly.components()[2];
+    EXPECT_EQ(turned.parent_id, assembly.components()[0].id);
+    EXPECT_TRUE(turned.part.sharesWith(plain.part));
+    const cad::core::RigidFrame frame = cad::core::RigidFrame::fromTransform(assembly.worldTransform(turned.id));
+    const double corner[3] = {1.0, 0.0, 0.0};
+    double world[3];
+    frame.apply(corner, world);
+    EXPECT_NEAR(world[0], 15.0, 1e-12);
+    EXPECT_NEAR(world[1], 1.0, 1e-12);
+
+    // Accessor länger als die Sicht
+    std::string broken = json;
+    broken.replace(broken.find("\"count\":4"), 9, "\"count\":5");
+    {
+        std::ofstream out(test_file);
+        out << broken;
+    }
+    EXPECT_FALSE(reader.readFile(test_file));
+    EXPECT_NE(reader.error().find("out of buffer range"), std::string::npos);
+    EXPECT_TRUE(reader.assembly().components().empty());
+
+    // Präparierte Accessoren: count jenseits von 2^53, riesiger count ohne Allokation, Nullen ohne bufferView
+    const std::string accessor = "{\"bufferView\":0,\"componentType\":5126,\"count\":4,\"type\":\"VEC3\"}";
+    const std::pair<std::string, std::string> malformed[] = {
+        {"{\"bufferView\":0,\"componentType\":5123,\"count\":4611686018427387904,\"type\":\"VEC3\"}",
+         "invalid"},
+        {"{\"bufferView\":0,\"componentType\":5123,\"count\":4503599627370496,\"type\":\"VEC3\"}",
+         "out of buffer range"},
+        {"{\"bufferView\":0,\"componentType\":5126,\"count\":1e300,\"type\":\"VEC3\"}", "invalid"},
+        {"{\"componentType\":5126,\"count\":1000000000000,\"type\":\"VEC3\"}", "too large"},
+        {"{\"bufferView\":0,\"byteOffset\":18446744073709551615,\"componentType\":5126,\"count\":1,"
+         "\"type\":\"VEC3\"}",
+         "out of buffer range"}};
+    for (const auto& [replacement, message] : malformed) {
+        std::string crafted = json;
+        crafted.replace(crafted.find(accessor), accessor.size(), replacement);
+        {
+            std::ofstream out(test_file);
+            out << crafted;
+        }
+        EXPECT_FALSE(reader.readFile(test_file)) << replacement;
+        EXPECT_NE(reader.error().find(message), std::string::npos) << reader.error();
+    }
+
+    // Instanzierung mit vier Verschiebungen, aber drei Maßstäben: nicht auffüllen, ablehnen
+    std::string instanced = json;
+    const std::string big_node = "\"mesh\":0,\"scale\":[2,2,2]";
+    instanced.replace(instanced.find(big_node), big_node.size(),
+                      "\"mesh\":0,\"extensions\":{\"EXT_mesh_gpu_instancing\":{\"attributes\":"
+                      "{\"TRANSLATION\":0,\"SCALE\":1}}}");
+    instanced.replace(instanced.find(accessor), accessor.size(),
+                      accessor + ",{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"}");
+    {
+        std::ofstream out(test_file);
+        out << instanced;
+    }
+    EXPECT_FALSE(reader.readFile(test_file));
+    EXPECT_NE(reader.error().find("counts differ"), std::string::npos) << reader.error();
+    std::remove(test_file.c_str());
+    std::remove("test_scene.bin");
+}
+
+TEST(ImportExportIntegrationTest, ThreeMfRoundTripSharesDefinitions) {
+    cad::core::PartRef bolt(cad::core::Part("Bolt"));
+    cad::core::Assembly assembly;
+    for (int i = 0; i < 1000; ++i) {
+        cad::core::Transform at;
+        at.tx = 12.0 * (i % 40);
+        at.ty = 12.0 * (i / 40);
+        at.rz = 0.01 * i;
+        assembly.addComponent(bolt, at);
+    }
+    // Unterbaugruppe ohne eigenes Netz: Platte und zwei Bolzen
+    cad::core::Transform frame_at;
+    frame_at.tz = 100.0;
+    frame_at.rx = 0.5;
+    const std::uint64_t frame = assembly.addComponent(cad::core::Part("Frame"), frame_at);
+    assembly.addComponent(cad::core::Part("Plate"), cad::core::Transform{}, frame);
+    for (int i = 0; i < 2; ++i) {
+        cad::core::Transform at;
+        at.tx = 5.0 + 10.0 * i;
+        at.ry = 0.3;
+        assembly.addComponent(bolt, at, frame);
+    }
+    const std::vector<double> box = {0, 0, 0, 2, 0, 0, 2, 1, 0, 0, 1, 0, 0, 0, 1, 2, 0, 1, 2, 1, 1, 0, 1, 1};
+    ThreeMfWriter::Tessellator tessellator = [&box](const cad::core::Part& part, cad::core::TriangleMesh& mesh) {
+        if (part.name() == "Frame") {
+            return false;
+        }
+        mesh.vertices = box;
+        mesh.indices = {0, 2, 1, 0, 3, 2, 4, 5, 6, 4, 6, 7, 0, 1, 5, 0, 5, 4,
+                        1, 2, 6, 1, 6, 5, 2, 3, 7, 2, 7, 6, 3, 0, 4, 3, 4, 7};
+        return true;
+    };
+    // Mittelpunkte aller Körper in Weltlage, sortiert
+    auto centers = [&box](const cad::core::Assembly& a, const std::vector<ThreeMfMesh>* meshes) {
+        std::vector<std::array<double, 3>> out;
+        for (const cad::core::AssemblyComponent& component : a.components()) {
+            const std::vector<double>* vertices = &box;
+            if (meshes) {
+                vertices = nullptr;
+                for (const ThreeMfMesh& m : *meshes) {
+                    if (m.part.sharesWith(component.part)) vertices = &m.mesh.vertices;
+                }
+            } else if (component.part->name() == "Frame") {
+                vertices = nullptr;
+            }
+            if (!vertices) continue;
+            double lo[3] = {1e300, 1e300, 1e300};
+            double hi[3] = {-1e300, -1e300, -1e300};
+            const cad::core::RigidFrame frame = cad::core::RigidFrame::fromTransform(a.worldTransform(component.id));
+            for (std::size_t v = 0; v + 2 < vertices->size(); v += 3) {
+                double w[3];
+                frame.apply(&(*vertices)[v], w);
+                for (int k = 0; k < 3; ++k) {
+                    lo[k] = std::min(lo[k], w[k]);
+                    hi[k] = std::max(hi[k], w[k]);
+                }
+            }
+            out.push_back({0.5 * (lo[0] + hi[0]), 0.5 * (lo[1] + hi[1]), 0.5 * (lo[2] + hi[2])});
+        }
+        std::sort(out.begin(), out.end());
+        return out;
+    };
+    const auto expected = centers(assembly, nullptr);
+
+    ImportExportService service;
+    for (const bool compress : {true, false}) {
+        const std::string test_file = "test_roundtrip.3mf";
+        ThreeMfWriteOptions options;
+        options.compress = compress;
+        options.buffer_bytes = 4096;
+        ThreeMfWriter writer(options);
+        ASSERT_TRUE(writer.writeAssembly(test_file, assembly, tessellator)) << writer.error();
+        EXPECT_EQ(writer.stats().mesh_objects, 2u);
+        EXPECT_EQ(writer.stats().component_objects, 1u);
+        EXPECT_EQ(writer.stats().build_items, 1001u);
+        EXPECT_EQ(writer.stats().triangles, 24u);
+        // Kopien kosten je ein Build-Item, keine Netzdaten
+        EXPECT_LT(writer.stats().bytes, 200000u);
+
+        ZipReader zip;
+        ASSERT_TRUE(zip.open(test_file)) << zip.error();
+        EXPECT_TRUE(zip.contains("[Content_Types].xml"));
+        EXPECT_TRUE(zip.contains("_rels/.rels"));
+        std::string model;
+        ASSERT_TRUE(zip.read("/3D/3dmodel.model", model)) << zip.error();
+        EXPECT_NE(model.find("<components>"), std::string::npos);
+        std::size_t vertex_lines = 0;
+        for (std::size_t at = model.find("<vertex "); at != std::string::npos; at = model.find("<vertex ", at + 1)) {
+            ++vertex_lines;
+        }
+        EXPECT_EQ(vertex_lines, 16u);
+
+        cad::core::Assembly imported;
+        std::vector<ThreeMfMesh> meshes;
+        const IoResult result = service.import3mfToAssembly(test_file, imported, &meshes);
+        ASSERT_TRUE(result.success) << result.message;
+        ASSERT_EQ(meshes.size(), 2u);
+        EXPECT_EQ(meshes[0].name, "Bolt");
+        EXPECT_EQ(meshes[0].part.useCount(), 1003u);
+        const auto actual = centers(imported, &meshes);
+        ASSERT_EQ(actual.size(), expected.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            for (int k = 0; k < 3; ++k) {
+                EXPECT_NEAR(actual[i][k], expected[i][k], 1e-9);
+            }
+        }
+        std::remove(test_file.c_str());
+    }
+}
+
+TEST(ImportExportIntegrationTest, ThreeMfReaderUnitsAndReferences) {
+    const std::string test_file = "test_units.3mf";
+    auto writePackage = [&test_file](const std::string& items) {
+        ZipWriter zip;
+        ASSERT_TRUE(zip.open(test_file));
+        zip.beginEntry("_rels/.rels");
+        zip.write("<Relationships><Relationship Target=\"/3D/part.model\" Id=\"r\" "
+                  "Type=\"http://schemas.microsoft.com/3dmanufacturing/2013/01/3dmodel\"/></Relationships>");
+        zip.beginEntry("3D/part.model");
+        zip.write("<?xml version=\"1.0\"?>\n<!-- Einheit cm -->\n<model unit=\"centimeter\"><resources>"
+                  "<object id=\"7\" name=\"Tri &amp; Co\"><mesh><vertices>"
+                  "<vertex x=\"0\" y=\"0\" z=\"0\"/><vertex x=\"1\" y=\"0\" z=\"0\"/><vertex x=\"0\" y=\"1\" z=\"0\"/>"
+                  "</vertices><triangles><triangle v1=\"0\" v2=\"1\" v3=\"2\"/></triangles></mesh></object>"
+                  "</resources><build>" + items + "</build></model>");
+        ASSERT_TRUE(zip.finish()) << zip.error();
+    };
+    // Maßstab 2 mit Verschiebung und gespiegelte Kopie
+    writePackage("<item objectid=\"7\" transform=\"2 0 0 0 2 0 0 0 2 1 0 0\"/>"
+                 "<item objectid=\"7\" transform=\"-1 0 0 0 1 0 0 0 1 0 0 0\"/>");
+    ThreeMfReader reader;
+    ASSERT_TRUE(reader.readFile(test_file)) << reader.error();
+    EXPECT_EQ(reader.stats().objects, 1u);
+    EXPECT_EQ(reader.stats().instances, 2u);
+    ASSERT_EQ(reader.meshes().size(), 2u);
+    EXPECT_EQ(reader.meshes()[0].name, "Tri & Co");
+    EXPECT_DOUBLE_EQ(reader.meshes()[0].mesh.vertices[3], 20.0);
+    EXPECT_DOUBLE_EQ(reader.meshes()[1].mesh.vertices[3], -10.0);
+    EXPECT_EQ(reader.meshes()[1].mesh.indices, (std::vector<unsigned>{0, 2, 1}));
+    const cad::core::Assembly& assembly = reader.assembly();
+    ASSERT_EQ(assembly.components().size(), 2u);
+    EXPECT_DOUBLE_EQ(assembly.components()[0].transform.tx, 10.0);
+
+    writePackage("<item objectid=\"8\"/>");
+    EXPECT_FALSE(reader.readFile(test_file));
+    EXPECT_NE(reader.error().find("missing object 8"), std::string::npos);
+    EXPECT_TRUE(reader.assembly().components().empty());
+    std::remove(test_file.c_str());
+}
+
+TEST(ImportExportIntegrationTest, ThreeMfReaderRejectsMalformedObjects) {
+    const std::string test_file = "test_malformed.3mf";
+    auto writeModel = [&test_file](const std::string& resources) {
+        ZipWriter zip;
+        ASSERT_TRUE(zip.open(test_file));
+        zip.beginEntry("3D/3dmodel.model");
+        zip.write("<model unit=\"millimeter\"><resources>" + resources +
+                  "</resources><build><item objectid=\"1\"/></build></model>");
+        ASSERT_TRUE(zip.finish()) << zip.error();
+    };
+    const std::string vertices = "<vertices><vertex x=\"0\" y=\"0\" z=\"0\"/><vertex x=\"1\" y=\"0\" z=\"0\"/>"
+                                 "<vertex x=\"0\" y=\"1\" z=\"0\"/></vertices>";
+    ThreeMfReader reader;
+
+    // Ohne </object>: Index 9 darf nicht ungeprüft durchrutschen
+    writeModel("<object id=\"1\"><mesh>" + vertices +
+               "<triangles><triangle v1=\"0\" v2=\"1\" v3=\"9\"/></triangles></mesh>");
+    EXPECT_FALSE(reader.readFile(test_file));
+    EXPECT_NE(reader.error().find("not closed"), std::string::npos) << reader.error();
+
+    // Zweites <object> vor dem Schließen des ersten
+    writeModel("<object id=\"1\"><mesh>" + vertices + "</mesh><object id=\"2\"><mesh>" + vertices +
+               "</mesh></object></object>");
+    EXPECT_FALSE(reader.readFile(test_file));
+    EXPECT_NE(reader.error().find("nested inside object 1"), std::string::npos) << reader.error();
+
+    // Geschlossenes Objekt mit Index außerhalb
+    writeModel("<object id=\"1\"><mesh>" + vertices +
+               "<triangles><triangle v1=\"0\" v2=\"3\" v3=\"1\"/></triangles></mesh></object>");
+    EXPECT_FALSE(reader.readFile(test_file));
+    EXPECT_NE(reader.error().find("Invalid vertex index in object 1"), std::string::npos) << reader.error();
+    EXPECT_TRUE(reader.meshes().empty());
+
+    // Komponenten 1 → 2 → 3 → 2: Zyklus, nicht erst an der Tiefengrenze
+    writeModel("<object id=\"1\"><components><component objectid=\"2\"/></components></object>"
+               "<object id=\"2\"><components><component objectid=\"3\"/><component objectid=\"4\"/>"
+               "</components></object>"
+               "<object id=\"3\"><components><component objectid=\"2\"/></components></object>"
+               "<object id=\"4\"><mesh>" + vertices +
+               "<triangles><triangle v1=\"0\" v2=\"1\" v3=\"2\"/></triangles></mesh></object>");
+    EXPECT_FALSE(reader.readFile(test_file));
+    EXPECT_NE(reader.error().find("cycle through object 2"), std::string::npos) << reader.error();
+
+    writeModel("<object id=\"1\"><mesh>" + vertices +
+               "<triangles><triangle v1=\"0\" v2=\"1\" v3=\"2\"/></triangles></mesh></object>");
+    EXPECT_TRUE(reader.readFile(test_file)) << reader.error();
+    std::remove(test_file.c_str());
+}
+
+TEST(ImportExportIntegrationTest, ZipReaderRejectsImplausibleDeclaredSize) {
+    const std::string test_file = "test_zip_size.zip";
+    {
+        ZipWriter zip;
+        ASSERT_TRUE(zip.open(test_file));
+        zip.beginEntry("a.txt");
+        zip.write(std::string(4096, 'a'));
+        ASSERT_TRUE(zip.finish()) << zip.error();
+    }
+    std::string bytes;
+    {
+        std::ifstream in(test_file, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    const std::size_t central = bytes.find(std::string("PK\x01\x02", 4));
+    ASSERT_NE(central, std::string::npos);
+    ZipReader zip;
+    ASSERT_TRUE(zip.open(test_file)) << zip.error();
+    std::string content;
+    ASSERT_TRUE(zip.read("a.txt", content)) << zip.error();
+    EXPECT_EQ(content.size(), 4096u);
+
+    // Unkomprimierte Größe im Zentralverzeichnis auf ~4 GiB gefälscht: keine Riesenallokation, klarer Fehler
+    bytes[central + 24] = '\xF0';
+    bytes[central + 25] = '\xFF';
+    bytes[central + 26] = '\xFF';
+    bytes[central + 27] = '\xFF';
+    {
+        std::ofstream out(test_file, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    ASSERT_TRUE(zip.open(test_file)) << zip.error();
+    EXPECT_FALSE(zip.read("a.txt", content));
+    EXPECT_NE(zip.error().find("implausible"), std::string::npos) << zip.error();
+    EXPECT_TRUE(content.empty());
+    std::remove(test_file.c_str());
+}
+
+TEST(ImportExportIntegrationTest, BatchImportPerFileResultsAndCancellation) {
+    // Je Datei ein Dreieck als OBJ, dazu eine fehlende Datei und ein STL-Stub (I/O-Spur)
+    std::vector<ImportRequest> requests;
+    for (int i = 0; i < 12; ++i) {
+        const std::string path = "test_batch_" + std::to_string(i) + ".obj";
+        std::ofstream out(path);
+        out << "v 0 0 0\nv 1 0 0\nv 0 1 " << i << "\nf 1 2 3\n";
+        requests.push_back({path, FileFormat::Obj});
+    }
+    {
+        std::ofstream out("test_batch.stl");
+        out << "solid s\nendsolid s\n";
+    }
+    requests.push_back({"test_batch.stl", FileFormat::Stl});
+    requests.push_back({"test_batch_missing.obj", FileFormat::Obj});
+
+    ImportExportService service;
+    EXPECT_TRUE(service.isCpuBoundFormat(FileFormat::Obj));
+    EXPECT_FALSE(service.isCpuBoundFormat(FileFormat::Stl));
+    BatchOptions options;
+    options.io_concurrency = 1;
+    options.cpu_concurrency = 3;
+    std::mutex mutex;
+    std::vector<std::size_t> reported;
+    options.on_progress = [&](const BatchFileResult&, std::size_t done, std::size_t total) {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_EQ(total, requests.size());
+        reported.push_back(done);
+    };
+    const BatchResult batch = service.importBatch(requests, options);
+    ASSERT_EQ(batch.files.size(), requests.size());
+    EXPECT_EQ(batch.succeeded, 13u);
+    EXPECT_EQ(batch.failed, 1u);
+    EXPECT_EQ(batch.cancelled, 0u);
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        EXPECT_EQ(batch.files[i].path, requests[i].path);
+        EXPECT_GE(batch.files[i].elapsed_ms, 0.0);
+    }
+    EXPECT_TRUE(batch.files[12].result.success) << batch.files[12].result.message;
+    EXPECT_FALSE(batch.files[12].cpu_bound);
+    EXPECT_FALSE(batch.files[13].result.success);
+    // Fortschritt genau einmal je Datei, nacheinander gemeldet
+    ASSERT_EQ(reported.size(), requests.size());
+    for (std::size_t i = 0; i < reported.size(); ++i) {
+        EXPECT_EQ(reported[i], i + 1);
+    }
+
+    const IoResult summary = service.importMultiple(requests);
+    EXPECT_FALSE(summary.success);
+    EXPECT_EQ(summary.message, "Imported 13 of 14 files; failed: test_batch_missing.obj");
+
+    // Abbruch nach der ersten Datei: laufende werden fertig, der Rest nicht mehr gestartet
+    cad::core::ThreadPool pool(2);
+    BatchOptions cancelling;
+    cancelling.pool = &pool;
+    cancelling.io_concurrency = 1;
+    cancelling.cpu_concurrency = 1;
+    cancelling.on_progress = [&cancelling](const BatchFileResult&, std::size_t, std::size_t) {
+        cancelling.cancel.cancel();
+    };
+    const BatchResult cancelled = service.importBatch(requests, cancelling);
+    EXPECT_LE(cancelled.succeeded + cancelled.failed, 3u);
+    EXPECT_GE(cancelled.cancelled, requests.size() - 3);
+    for (const BatchFileResult& file : cancelled.files) {
+        if (file.cancelled) {
+            EXPECT_EQ(file.result.message, "Cancelled");
+        }
+    }
+    for (const ImportRequest& request : requests) {
+        std::remove(request.path.c_str());
+    }
+}
+
+TEST(ImportExportIntegrationTest, IoPipelineConvertManifestInParallel) {
+    {
+        std::ofstream out("test_convert_src.obj");
+        out << "o Quad\nv 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nf 1 2 3 4\n";
+    }
+    {
+        std::ofstream out("test_convert.manifest");
+        out << "# OBJ -> GLB -> 3MF -> PLY\n"
+            << "test_convert_src.obj \"test_convert.glb\"\n"
+            << "\n"
+            << "test_convert_src.obj test_convert.3mf   # Kommentar\n"
+            << "test_convert_src.obj test_convert.ply\n"
+            << "test_convert_missing.obj test_convert_missing.glb\n"
+            << "test_convert_src.obj test_convert.xyz\n";
+    }
+    std::vector<ConversionJob> jobs;
+    std::string error;
+    ASSERT_TRUE(IoPipeline::readManifest("test_convert.manifest", jobs, error)) << error;
+    ASSERT_EQ(jobs.size(), 5u);
+    EXPECT_EQ(jobs[0].output, "test_convert.glb");
+
+    IoPipeline pipeline;
+    std::size_t reported = 0;
+    const std::vector<ConversionResult> results =
+        pipeline.convertAll(jobs, 3, [&reported](const ConversionResult&, std::size_t done, std::size_t total) {
+            EXPECT_EQ(done, ++reported);
+            EXPECT_EQ(total, 5u);
+        });
+    ASSERT_EQ(results.size(), 5u);
+    for (std::size_t i = 0; i < 3; ++i) {
+        EXPECT_TRUE(results[i].success) << results[i].job.output << ": " << results[i].message;
+        EXPECT_EQ(results[i].meshes, 1u);
+        EXPECT_GT(results[i].output_bytes, 0u);
+        EXPECT_GT(results[i].input_bytes, 0u);
+    }
+    EXPECT_FALSE(results[3].success);
+    EXPECT_FALSE(results[4].success);
+    EXPECT_NE(results[4].message.find("target format"), std::string::npos);
+
+    // Weiter aus den Zwischenformaten: GLB → OBJ, 3MF → GLB
+    const ConversionResult back = pipeline.convert({"test_convert.glb", "test_convert_back.obj"});
+    ASSERT_TRUE(back.success) << back.message;
+    ObjReader reader;
+    ASSERT_TRUE(reader.readFile("test_convert_back.obj")) << reader.error();
+    EXPECT_EQ(reader.stats().triangles, 2u);
+    EXPECT_TRUE(pipeline.convert({"test_convert.3mf", "test_convert_3mf.glb"}).success);
+
+    // Projekte nur über den Loader; Teile ohne Netz über dessen Tessellator
+    EXPECT_FALSE(pipeline.convert({"test_convert.hcasm", "test_convert_project.3mf"}).success);
+    pipeline.setProjectLoader([](const std::string&, cad::core::Assembly& assembly,
+                                 IoPipeline::Tessellator& tessellator) {
+        const cad::core::PartRef plate(cad::core::Part("Plate"));
+        for (int i = 0; i < 4; ++i) {
+            cad::core::Transform at;
+            at.tx = 10.0 * i;
+            assembly.addComponent(plate, at);
+        }
+        tessellator = [](const cad::core::Part&, cad::core::TriangleMesh& mesh) {
+            mesh.vertices = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+            mesh.indices = {0, 1, 2};
+            return true;
+        };
+        return true;
+    });
+    const ConversionResult project = pipeline.convert({"test_convert.hcasm", "test_convert_project.3mf"});
+    ASSERT_TRUE(project.success) << project.message;
+    EXPECT_EQ(project.components, 4u);
+    EXPECT_EQ(project.meshes, 1u);
+
+    const ConversionStats stats = IoPipeline::summarize(results, 100.0);
+    EXPECT_EQ(stats.jobs, 5u);
+    EXPECT_EQ(stats.succeeded, 3u);
+    EXPECT_EQ(stats.failed, 2u);
+    EXPECT_DOUBLE_EQ(stats.jobs_per_second, 50.0);
+    EXPECT_LE(stats.latency_p50_ms, stats.latency_p95_ms);
+    EXPECT_LE(stats.latency_p95_ms, stats.latency_max_ms);
+
+    {
+        std::ofstream out("test_convert.manifest");
+        out << "only_one_field.obj\n";
+    }
+    std::vector<ConversionJob> broken;
+    EXPECT_FALSE(IoPipeline::readManifest("test_convert.manifest", broken, error));
+    EXPECT_NE(error.find("line 1"), std::string::npos);
+    for (const char* path : {"test_convert_src.obj", "test_convert.manifest", "test_convert.glb", "test_convert.3mf",
+                             "test_convert.ply", "test_convert_back.obj", "test_convert_3mf.glb",
+                             "test_convert_project.3mf"}) {
+        std::remove(path);
+    }
+}
+
+TEST(ImportExportIntegrationTest, DxfNestRoundTripWithBlockReferences) {
+    const std::string test_file = "test_nest.dxf";
+    // Teil mit 20 Elementen als Block, 5000 Vorkommen → 100k Elemente in der Skizze
+    DxfDrawing nest;
+    DxfBlock part;
+    part.name = "PART_A";
+    cad::core::GeometryEntity outline;
+    outline.type = cad::core::GeometryType::Polygon;
+    outline.points = {{0.0, 0.0}, {80.0, 0.0}, {80.0, 40.0}, {0.0, 40.0}, {0.0, 0.0}};
+    part.entities.push_back(outline);
+    for (int i = 0; i < 12; ++i) {
+        cad::core::GeometryEntity hole;
+        hole.type = cad::core::GeometryType::Circle;
+        hole.center_point = {5.0 + 6.0 * i, 20.0};
+        hole.radius = 2.5;
+        part.entities.push_back(hole);
+    }
+    for (int i = 0; i < 4; ++i) {
+        cad::core::GeometryEntity arc;
+        arc.type = cad::core::GeometryType::Arc;
+        arc.center_point = {20.0 * i + 10.0, 35.0};
+        arc.radius = 3.0;
+        arc.start_angle = 0.0;
+        arc.end_angle = 180.0;
+        part.entities.push_back(arc);
+    }
+    for (int i = 0; i < 2; ++i) {
+        cad::core::GeometryEntity line;
+        line.type = cad::core::GeometryType::Line;
+        line.start_point = {1.0, 1.0 + i};
+        line.end_point = {79.0, 1.0 + i};
+        part.entities.push_back(line);
+    }
+    cad::core::GeometryEntity spline;
+    spline.type = cad::core::GeometryType::Spline;
+    spline.points = {{10.0, 5.0}, {20.0, 15.0}, {30.0, 5.0}, {40.0, 15.0}};
+    part.entities.push_back(spline);
+    ASSERT_EQ(part.entities.size(), 20u);
+    nest.blocks.push_back(part);
+    for (int i = 0; i < 5000; ++i) {
+        DxfInsert insert;
+        insert.block = "PART_A";
+        insert.position = {100.0 * (i % 100), 100.0 * (i / 100)};
+        insert.rotation = i % 2 == 0 ? 0.0 : 90.0;
+        nest.inserts.push_back(insert);
+    }
+
+    ImportExportService service;
+    IoResult exported = service.exportDrawingToDxf(test_file, nest);
+    ASSERT_TRUE(exported.success) << exported.message;
+    std::ifstream in(test_file);
+    const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::size_t blocks = 0;
+    for (std::size_t pos = text.find("\nBLOCK\n"); pos != std::string::npos; pos = text.find("\nBLOCK\n", pos + 1)) {
+        ++blocks;
+    }
+    EXPECT_EQ(blocks, 1u);
+
+    cad::core::Sketch sketch("nest");
+    DxfDrawing drawing;
+    IoResult imported = service.importDxfToSketch(test_file, sketch, &drawing);
+    ASSERT_TRUE(imported.success) << imported.message;
+    ASSERT_EQ(drawing.blocks.size(), 1u);
+    EXPECT_EQ(drawing.inserts.size(), 5000u);
+    const auto& geometry = sketch.geometry();
+    ASSERT_EQ(geometry.size(), 100000u);
+    EXPECT_EQ(geometry.front().id, "geom_1");
+    EXPECT_EQ(geometry.back().id, "geom_100000");
+    // Vorkommen 1 ist um 90° gedreht: (80, 0) → (100, 80)
+    const cad::core::GeometryEntity& rotated = geometry[20];
+    ASSERT_EQ(rotated.type, cad::core::GeometryType::Polygon);
+    ASSERT_EQ(rotated.points.size(), 5u);
+    EXPECT_NEAR(rotated.points[1].x, 100.0, 1e-9);
+    EXPECT_NEAR(rotated.points[1].y, 80.0, 1e-9);
+    const cad::core::GeometryEntity& arc = geometry[20 + 13];
+    ASSERT_EQ(arc.type, cad::core::GeometryType::Arc);
+    EXPECT_NEAR(arc.start_angle, 90.0, 1e-9);
+    EXPECT_NEAR(arc.end_angle, 270.0, 1e-9);
+    EXPECT_EQ(geometry[20 + 19].type, cad::core::GeometryType::Spline);
+    EXPECT_EQ(geometry[20 + 19].points.size(), 4u);
+
+    // Flache Skizze mit 100k Linien: Koordinaten exakt (kürzeste Darstellung per to_chars)
+    cad::core::Sketch lines("lines");
+    for (int i = 0; i < 100000; ++i) {
+        lines.addLine({i * 0.1, 1.0 / 3.0}, {i * 0.1 + 0.05, -2.0 / 7.0});
+    }
+    exported = service.exportSketchToDxf(test_file, lines);
+    ASSERT_TRUE(exported.success) << exported.message;
+    DxfReader reader;
+    ASSERT_TRUE(reader.readFile(test_file)) << reader.error();
+    ASSERT_EQ(reader.drawing().entities.size(), 100000u);
+    EXPECT_EQ(reader.stats().skipped, 0u);
+    const cad::core::GeometryEntity& last = reader.drawing().entities.back();
+    EXPECT_EQ(last.start_point.x, lines.geometry().back().start_point.x);
+    EXPECT_EQ(last.start_point.y, 1.0 / 3.0);
+    EXPECT_EQ(last.end_point.y, -2.0 / 7.0);
+    std::remove(test_file.c_str());
+}
+
+TEST(ImportExportIntegrationTest, DxfReaderPolylinesUnitsAndOcs) {
+    // Zoll, CRLF und eingerückte Codes wie aus älteren CAM-Systemen
+    std::string text =
+        "  0\r\nSECTION\r\n  2\r\nHEADER\r\n  9\r\n$INSUNITS\r\n 70\r\n     1\r\n  0\r\nENDSEC\r\n"
+        "  0\r\nSECTION\r\n  2\r\nBLOCKS\r\n  0\r\nBLOCK\r\n  2\r\nBOLT\r\n 10\r\n1.0\r\n 20\r\n0.0\r\n"
+        "  0\r\nCIRCLE\r\n 10\r\n1.0\r\n 20\r\n0.0\r\n 40\r\n0.5\r\n  0\r\nENDBLK\r\n  0\r\nENDSEC\r\n"
+        "  0\r\nSECTION\r\n  2\r\nENTITIES\r\n"
+        "  0\r\nLWPOLYLINE\r\n 90\r\n2\r\n 70\r\n0\r\n 10\r\n0\r\n 20\r\n0\r\n 42\r\n1\r\n 10\r\n2\r\n 20\r\n0\r\n"
+        "  0\r\nPOLYLINE\r\n 70\r\n1\r\n  0\r\nVERTEX\r\n 10\r\n0\r\n 20\r\n0\r\n  0\r\nVERTEX\r\n 10\r\n1\r\n 20\r\n0\r\n"
+        "  0\r\nVERTEX\r\n 10\r\n1\r\n 20\r\n1\r\n  0\r\nSEQEND\r\n"
+        "  0\r\nARC\r\n 10\r\n2\r\n 20\r\n0\r\n 40\r\n1\r\n 50\r\n0\r\n 51\r\n90\r\n230\r\n-1\r\n"
+        "  0\r\nCIRCLE\r\n 67\r\n1\r\n 10\r\n0\r\n 20\r\n0\r\n 40\r\n1\r\n"
+        "  0\r\nHATCH\r\n  2\r\nSOLID\r\n"
+        "  0\r\nINSERT\r\n  2\r\nBOLT\r\n 10\r\n10\r\n 20\r\n0\r\n 50\r\n90\r\n"
+        "  0\r\nINSERT\r\n  2\r\nMISSING\r\n 10\r\n0\r\n 20\r\n0\r\n"
+        "  0\r\nENDSEC\r\n  0\r\nEOF\r\n";
+    DxfReader reader;
+    ASSERT_TRUE(reader.readText(text)) << reader.error();
+    EXPECT_EQ(reader.stats().entities, 4u);
+    EXPECT_EQ(reader.stats().blocks, 1u);
+    EXPECT_EQ(reader.stats().inserts, 2u);
+    EXPECT_EQ(reader.stats().skipped, 2u);
+    EXPECT_DOUBLE_EQ(reader.drawing().unit_to_mm, 25.4);
+
+    DxfFlattenStats stats;
+    const std::vector<cad::core::GeometryEntity> flat = flattenDxf(reader.drawing(), &stats);
+    ASSERT_EQ(flat.size(), 4u);
+    EXPECT_EQ(stats.instances, 1u);
+    EXPECT_EQ(stats.unresolved, 1u);
+    // Bulge 1: Halbkreis unterhalb der Sehne
+    EXPECT_EQ(flat[0].type, cad::core::GeometryType::Arc);
+    EXPECT_NEAR(flat[0].center_point.x, 25.4, 1e-9);
+    EXPECT_NEAR(flat[0].radius, 25.4, 1e-9);
+    EXPECT_NEAR(flat[0].start_angle, 180.0, 1e-9);
+    EXPECT_NEAR(flat[0].end_angle, 0.0, 1e-9);
+    // Geschlossene POLYLINE: erster Punkt wiederholt
+    ASSERT_EQ(flat[1].type, cad::core::GeometryType::Polygon);
+    ASSERT_EQ(flat[1].points.size(), 4u);
+    EXPECT_NEAR(flat[1].points[2].y, 25.4, 1e-9);
+    // Extrusion (0,0,-1): Bogen an der Y-Achse gespiegelt
+    EXPECT_NEAR(flat[2].center_point.x, -2.0 * 25.4, 1e-9);
+    EXPECT_NEAR(flat[2].start_angle, 90.0, 1e-9);
+    EXPECT_NEAR(flat[2].end_angle, 180.0, 1e-9);
+    // Blockreferenz um den Basispunkt (1, 0)
+    EXPECT_EQ(flat[3].type, cad::core::GeometryType::Circle);
+    EXPECT_NEAR(flat[3].center_point.x, 254.0, 1e-9);
+    EXPECT_NEAR(flat[3].center_point.y, 0.0, 1e-9);
+    EXPECT_NEAR(flat[3].radius, 12.7, 1e-9);
+
+    EXPECT_FALSE(reader.readText("0\nSECTION\nxx\nENTITIES\n"));
+    EXPECT_NE(reader.error().find("line 3"), std::string::npos);
+    EXPECT_TRUE(reader.drawing().entities.empty());
+}
+
+TEST(ImportExportIntegrationTest, DxfFlattenStopsAtCyclesAndInstanceLimit) {
+    // SELF fügt sich zweimal selbst ein: ohne Pfadprüfung 2^32 Vorkommen bis zur Tiefengrenze
+    const std::string text =
+        "0\nSECTION\n2\nBLOCKS\n"
+        "0\nBLOCK\n2\nSELF\n10\n0\n20\n0\n"
+        "0\nLINE\n10\n0\n20\n0\n11\n1\n21\n0\n"
+        "0\nINSERT\n2\nSELF\n10\n1\n20\n0\n"
+        "0\nINSERT\n2\nSELF\n10\n0\n20\n1\n"
+        "0\nENDBLK\n"
+        "0\nBLOCK\n2\nEMPTY\n10\n0\n20\n0\n0\nENDBLK\n"
+        "0\nENDSEC\n"
+        "0\nSECTION\n2\nENTITIES\n"
+        "0\nINSERT\n2\nSELF\n10\n5\n20\n5\n"
+        "0\nENDSEC\n0\nEOF\n";
+    DxfReader reader;
+    ASSERT_TRUE(reader.readText(text)) << reader.error();
+    DxfFlattenStats stats;
+    std::vector<cad::core::GeometryEntity> flat = flattenDxf(reader.drawing(), &stats);
+    ASSERT_EQ(flat.size(), 1u);
+    EXPECT_NEAR(flat[0].start_point.x, 5.0, 1e-9);
+    EXPECT_EQ(stats.instances, 1u);
+    EXPECT_EQ(stats.unresolved, 2u);
+    EXPECT_FALSE(stats.truncated);
+
+    // Azyklisch, aber 32767 × 32767 Rasterzellen: Abbruch an der Vorkommensgrenze
+    DxfDrawing grid = reader.drawing();
+    grid.inserts.clear();
+    DxfInsert array;
+    array.block = "EMPTY";
+    array.rows = 32767;
+    array.columns = 32767;
+    array.row_spacing = array.column_spacing = 1.0;
+    grid.inserts.push_back(array);
+    flat = flattenDxf(grid, &stats);
+    EXPECT_TRUE(flat.empty());
+    EXPECT_TRUE(stats.truncated);
+    EXPECT_LT(stats.instances, 32767u * 32767u);
+}
+
+#ifdef CAD_USE_EIGENER_KERN
+namespace {
+
+/** Würfel als B-rep (Ecken, 12 LINE-Kanten, 6 ADVANCED_FACE auf PLANE); liefert die Id der Hülle. */
+std::uint32_t writeBoxShell(std::ostream& out, std::uint32_t& next, double x, double y, double z, double size) {
+    auto point = [&](double px, double py, double pz) {
+        const std::uint32_t id = next++;
+        out << "#" << id << "=CARTESIAN_POINT('',(" << px << "," << py << "," << pz << "));\n";
+        return id;
+    };
+    auto direction = [&](double dx, double dy, double dz) {
+        const std::uint32_t id = next++;
+        out << "#" << id << "=DIRECTION('',(" << dx << "," << dy << "," << dz << "));\n";
+        return id;
+    };
+    std::array<std::array<double, 3>, 8> corners;
+    std::array<std::uint32_t, 8> vertices;
+    for (int i = 0; i < 8; ++i) {
+        corners[i] = {x + size * (i & 1), y + size * ((i >> 1) & 1), z + size * ((i >> 2) & 1)};
+        const std::uint32_t p = point(corners[i][0], corners[i][1], corners[i][2]);
+        vertices[i] = next++;
+        out << "#" << vertices[i] << "=VERTEX_POINT('',#" << p << ");\n";
+    }
+    // Flächen gegen den Uhrzeigersinn von außen
+    const int faces[6][4] = {{0, 2, 3, 1}, {4, 5, 7, 6}, {0, 1, 5, 4}, {2, 6, 7, 3}, {0, 4, 6, 2}, {1, 3, 7, 5}};
+    std::map<std::pair<int, int>, std::uint32_t> edges;
+    for (const auto& face : faces) {
+        for (int k = 0; k < 4; ++k) {
+            const int a = std::min(face[k], face[(k + 1) % 4]);
+            const int b = std::max(face[k], face[(k + 1) % 4]);
+            if (edges.count({a, b})) {
+                continue;
+            }
+            const std::uint32_t origin = point(corners[a][0], corners[a][1], corners[a][2]);
+            const std::uint32_t dir = direction(corners[b][0] - corners[a][0], corners[b][1] - corners[a][1],
+                                                corners[b][2] - corners[a][2]);
+            out << "#" << next << "=VECTOR('',#" << dir << ",1.);\n";
+            out << "#" << next + 1 << "=LINE('',#" << origin << ",#" << next << ");\n";
+            out << "#" << next + 2 << "=EDGE_CURVE('',#" << vertices[a] << ",#" << vertices[b] << ",#" << next + 1
+                << ",.T.);\n";
+            edges[{a, b}] = next + 2;
+            next += 3;
+        }
+    }
+    std::vector<std::uint32_t> face_ids;
+    for (const auto& face : faces) {
+        const auto& p0 = corners[face[0]];
+        const auto& p1 = corners[face[1]];
+        const auto& p3 = corners[face[3]];
+        const double u[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+        const double v[3] = {p3[0] - p0[0], p3[1] - p0[1], p3[2] - p0[2]};
+        const std::uint32_t origin = point(p0[0], p0[1], p0[2]);
+        const std::uint32_t axis = direction(u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]);
+        const std::uint32_t ref = direction(u[0], u[1], u[2]);
+        out << "#" << next << "=AXIS2_PLACEMENT_3D('',#" << origin << ",#" << axis << ",#" << ref << ");\n";
+        out << "#" << next + 1 << "=PLANE('',#" << next << ");\n";
+        const std::uint32_t plane = next + 1;
+        next += 2;
+        std::string loop = "(";
+        for (int k = 0; k < 4; ++k) {
+            const int a = face[k];
+            const int b = face[(k + 1) % 4];
+            out << "#" << next << "=ORIENTED_EDGE('',*,*,#" << edges[{std::min(a, b), std::max(a, b)}] << ","
+                << (a < b ? ".T." : ".F.") << ");\n";
+            loop += (k ? ",#" : "#") + std::to_string(next++);
+        }
+        out << "#" << next << "=EDGE_LOOP(''," << loop << "));\n";
+        out << "#" << next + 1 << "=FACE_OUTER_BOUND('',#" << next << ",.T.);\n";
+        out << "#" << next + 2 << "=ADVANCED_FACE('',(#" << next + 1 << "),#" << plane << ",.T.);\n";
+        face_ids.push_back(next + 2);
+        next += 3;
+    }
+    const std::uint32_t shell = next++;
+    out << "#" << shell << "=CLOSED_SHELL('',(";
+    for (std::size_t i = 0; i < face_ids.size(); ++i) {
+        out << (i ? ",#" : "#") << face_ids[i];
+    }
+    out << "));\n";
+    return shell;
+}
+
+std::string stepFile(const std::string& data) {
+    return "ISO-10303-21;\nHEADER;\nENDSEC;\nDATA;\n" + data + "ENDSEC;\nEND-ISO-10303-21;\n";
+}
+
+}  // namespace
+
+TEST(ImportExportIntegrationTest, StepBrepBox) {
+    std::ostringstream data;
+    std::uint32_t next = 1;
+    const std::uint32_t shell = writeBoxShell(data, next, 1.0, 2.0, 3.0, 10.0);
+    data << "#" << next << "=MANIFOLD_SOLID_BREP('Block',#" << shell << ");\n";
+
+    StepFileParser parser;
+    ASSERT_TRUE(parser.parseText(stepFile(data.str())));
+    StepBrepTranslator translator(parser);
+    std::vector<StepSolid> solids = translator.translate();
+    ASSERT_EQ(solids.size(), 1u);
+    EXPECT_EQ(solids[0].name, "Block");
+    EXPECT_EQ(solids[0].id, next);
+
+    const StepBrepStats stats = translator.stats();
+    EXPECT_EQ(stats.faces, 6u);
+    EXPECT_EQ(stats.edges, 12u);
+    EXPECT_EQ(stats.vertices, 8u);
+    // Jede Kante von zwei Flächen, jede Ecke von drei Kanten
+    EXPECT_EQ(stats.shared_hits, 12u + 16u);
+    EXPECT_EQ(stats.approximated_curves, 0u);
+    EXPECT_EQ(stats.approximated_surfaces, 0u);
+
+    const cad::kernel::topology::Solid& solid = *solids[0].solid;
+    double min_x, min_y, min_z, max_x, max_y, max_z;
+    solid.bounds(min_x, min_y, min_z, max_x, max_y, max_z);
+    EXPECT_DOUBLE_EQ(min_x, 1.0);
+    EXPECT_DOUBLE_EQ(min_y, 2.0);
+    EXPECT_DOUBLE_EQ(min_z, 3.0);
+    EXPECT_DOUBLE_EQ(max_x, 11.0);
+    EXPECT_DOUBLE_EQ(max_y, 12.0);
+    EXPECT_DOUBLE_EQ(max_z, 13.0);
+
+    // Geschlossene Schleifen, Flächennormalen und Dreiecke zeigen nach außen
+    for (const auto& face : solid.outerShell()->faces()) {
+        EXPECT_TRUE(face->outerLoop()->isClosed());
+        const cad::kernel::math::Point3 p = face->outerLoop()->wire()->edges()[0]->startVertex()->point();
+        const cad::kernel::math::Vector3 n = face->normalAt(0.0, 0.0);
+        EXPECT_GT(n.dot(p - cad::kernel::math::Point3(6.0, 7.0, 8.0)), 0.0);
+    }
+    const cad::kernel::io::TriangleMesh mesh = cad::kernel::io::triangulate(solid);
+    ASSERT_EQ(mesh.indices.size(), 36u);
+    for (std::size_t t = 0; t < mesh.indices.size(); t += 3) {
+        cad::kernel::math::Point3 p[3];
+        for (int k = 0; k < 3; ++k) {
+            const std::size_t i = mesh.indices[t + k] * 3;
+            p[k] = cad::kernel::math::Point3(mesh.vertices[i], mesh.vertices[i + 1], mesh.vertices[i + 2]);
+        }
+        const cad::kernel::math::Vector3 n = (p[1] - p[0]).cross(p[2] - p[0]);
+        const cad::kernel::math::Point3 c = (p[0] + p[1] + p[2]) * (1.0 / 3.0);
+        EXPECT_GT(n.dot(c - cad::kernel::math::Point3(6.0, 7.0, 8.0)), 0.0);
+    }
+}
+
+TEST(ImportExportIntegrationTest, StepBrepCylinder) {
+    // Zylinder r = 5, h = 20: zwei Vollkreise, eine Naht, Boden/Deckel eben
+    const std::string text = stepFile(
+        "#1=CARTESIAN_POINT('',(0.,0.,0.));\n#2=CARTESIAN_POINT('',(0.,0.,20.));\n"
+        "#3=CARTESIAN_POINT('',(5.,0.,0.));\n#4=CARTESIAN_POINT('',(5.,0.,20.));\n"
+        "#5=DIRECTION('',(0.,0.,1.));\n#6=DIRECTION('',(1.,0.,0.));\n#7=DIRECTION('',(0.,0.,-1.));\n"
+        "#8=AXIS2_PLACEMENT_3D('',#1,#5,#6);\n#9=AXIS2_PLACEMENT_3D('',#2,#5,#6);\n"
+        "#10=AXIS2_PLACEMENT_3D('',#1,#7,#6);\n"
+        "#11=VERTEX_POINT('',#3);\n#12=VERTEX_POINT('',#4);\n"
+        "#13=CIRCLE('',#8,5.);\n#14=CIRCLE('',#9,5.);\n"
+        "#15=VECTOR('',#5,1.);\n#16=LINE('',#3,#15);\n"
+        "#17=EDGE_CURVE('',#11,#11,#13,.T.);\n#18=EDGE_CURVE('',#12,#12,#14,.T.);\n"
+        "#19=EDGE_CURVE('',#11,#12,#20,.T.);\n#20=SEAM_CURVE('',#16,(#24,#24),.PCURVE_S1.);\n"
+        "#21=ORIENTED_EDGE('',*,*,#17,.T.);\n#22=ORIENTED_EDGE('',*,*,#19,.T.);\n"
+        "#23=ORIENTED_EDGE('',*,*,#18,.F.);\n#24=CYLINDRICAL_SURFACE('',#8,5.);\n"
+        "#25=ORIENTED_EDGE('',*,*,#19,.F.);\n#26=EDGE_LOOP('',(#21,#22,#23,#25));\n"
+        "#27=FACE_OUTER_BOUND('',#26,.T.);\n#28=ADVANCED_FACE('',(#27),#24,.T.);\n"
+        "#29=PLANE('',#10);\n#30=ORIENTED_EDGE('',*,*,#17,.F.);\n#31=EDGE_LOOP('',(#30));\n"
+        "#32=FACE_BOUND('',#31,.T.);\n#33=ADVANCED_FACE('',(#32),#29,.T.);\n"
+        "#34=PLANE('',#9);\n#35=ORIENTED_EDGE('',*,*,#18,.T.);\n#36=EDGE_LOOP('',(#35));\n"
+        "#37=FACE_OUTER_BOUND('',#36,.T.);\n#38=ADVANCED_FACE('',(#37),#34,.T.);\n"
+        "#39=CLOSED_SHELL('',(#28,#33,#38));\n#40=MANIFOLD_SOLID_BREP('Bolt',#39);\n");
+
+    StepFileParser parser;
+    ASSERT_TRUE(parser.parseText(text));
+    StepBrepTranslator translator(parser);
+    StepSolid solid;
+    ASSERT_TRUE(translator.translateSolid(40, solid));
+    EXPECT_FALSE(translator.translateSolid(39, solid));
+
+    const StepBrepStats stats = translator.stats();
+    EXPECT_EQ(stats.solids, 1u);
+    EXPECT_EQ(stats.faces, 3u);
+    EXPECT_EQ(stats.edges, 3u);
+    EXPECT_EQ(stats.vertices, 2u);
+    EXPECT_EQ(stats.approximated_curves, 0u);
+    EXPECT_EQ(stats.approximated_surfaces, 0u);
+
+    const auto& faces = solid.solid->outerShell()->faces();
+    ASSERT_EQ(faces.size(), 3u);
+    EXPECT_EQ(faces[0]->id(), 28u);
+    const auto* cylinder = dynamic_cast<const cad::kernel::geometry3d::CylinderSurface*>(faces[0]->surface());
+    ASSERT_NE(cylinder, nullptr);
+
+    // Vollkreis: halber Parameter gegenüber der Ecke, Gegenrichtung im Uhrzeigersinn
+    const auto& edges = faces[0]->outerLoop()->wire()->edges();
+    ASSERT_EQ(edges.size(), 4u);
+    const cad::kernel::math::Point3 half = edges[0]->pointAt(0.5);
+    EXPECT_NEAR(half.x, -5.0, 1e-9);
+    EXPECT_NEAR(half.y, 0.0, 1e-9);
+    const cad::kernel::math::Point3 quarter = edges[2]->pointAt(0.25);
+    EXPECT_NEAR(quarter.y, -5.0, 1e-9);
+    EXPECT_NEAR(quarter.z, 20.0, 1e-9);
+    EXPECT_NEAR(edges[1]->pointAt(0.5).z, 10.0, 1e-9);
+    // Kreis- und Nahtkante sind dieselben Objekte wie in Boden und Deckel
+    EXPECT_EQ(edges[0]->curve(), faces[1]->outerLoop()->wire()->edges()[0]->curve());
+    EXPECT_DOUBLE_EQ(faces[1]->normalAt(0.0, 0.0).z, -1.0);
+}
+
+TEST(ImportExportIntegrationTest, StepBrepParallelSharedGeometry) {
+    // 64 Körper, je zwei teilen sich eine Hülle; dazu ein B-rep mit Hohlraum
+    std::ostringstream data;
+    std::uint32_t next = 1;
+    std::vector<std::uint32_t> shells;
+    for (int i = 0; i < 32; ++i) {
+        shells.push_back(writeBoxShell(data, next, 20.0 * i, 0.0, 0.0, 5.0 + i));
+    }
+    for (int i = 0; i < 64; ++i) {
+        data << "#" << next++ << "=MANIFOLD_SOLID_BREP('Box" << i << "',#" << shells[i / 2] << ");\n";
+    }
+    const std::uint32_t outer = writeBoxShell(data, next, 0.0, 100.0, 0.0, 30.0);
+    const std::uint32_t inner = writeBoxShell(data, next, 10.0, 110.0, 10.0, 10.0);
+    data << "#" << next++ << "=ORIENTED_CLOSED_SHELL('',*,#" << inner << ",.F.);\n";
+    data << "#" << next << "=BREP_WITH_VOIDS('Hollow',#" << outer << ",(#" << next - 1 << "));\n";
+    const std::string text = stepFile(data.str());
+
+    StepFileParser parser;
+    ASSERT_TRUE(parser.parseText(text));
+
+    cad::core::ThreadPool single(1);
+    StepBrepTranslator sequential(parser, &single);
+    const std::vector<StepSolid> expected = sequential.translate();
+
+    cad::core::ThreadPool pool(4);
+    StepBrepTranslator parallel(parser, &pool);
+    const std::vector<StepSolid> solids = parallel.translate();
+
+    ASSERT_EQ(solids.size(), 65u);
+    ASSERT_EQ(expected.size(), solids.size());
+    for (std::size_t i = 0; i < solids.size(); ++i) {
+        EXPECT_EQ(solids[i].id, expected[i].id);
+        EXPECT_EQ(solids[i].name, expected[i].name);
+        double a[6], b[6];
+        solids[i].solid->bounds(a[0], a[1], a[2], a[3], a[4], a[5]);
+        expected[i].solid->bounds(b[0], b[1], b[2], b[3], b[4], b[5]);
+        for (int k = 0; k < 6; ++k) {
+            EXPECT_DOUBLE_EQ(a[k], b[k]);
+        }
+    }
+    EXPECT_EQ(solids[0].name, "Box0");
+    EXPECT_EQ(solids[64].name, "Hollow");
+
+    // Geteilte Hülle: dieselben Kanten- und Eckobjekte in beiden Körpern
+    const auto& first = solids[0].solid->outerShell()->faces();
+    const auto& second = solids[1].solid->outerShell()->faces();
+    ASSERT_EQ(first.size(), second.size());
+    EXPECT_EQ(first[0]->outerLoop()->wire()->edges()[0], second[0]->outerLoop()->wire()->edges()[0]);
+    EXPECT_NE(first[0], second[0]);
+
+    const StepBrepStats stats = parallel.stats();
+    const StepBrepStats reference = sequential.stats();
+    EXPECT_EQ(stats.solids, 65u);
+    EXPECT_EQ(stats.failed_solids, 0u);
+    EXPECT_EQ(stats.faces, 64u * 6 + 12);
+    EXPECT_EQ(stats.edges, 34u * 12);
+    EXPECT_EQ(stats.vertices, 34u * 8);
+    EXPECT_EQ(stats.edges, reference.edges);
+    EXPECT_EQ(stats.vertices, reference.vertices);
+    EXPECT_EQ(stats.shared_hits, reference.shared_hits);
+    EXPECT_GT(stats.shared_hits, 32u * (12 + 24 + 16));
+
+    // Unbekannte Flächengeometrie: Ebene durch den Rand
+    std::ostringstream spline;
+    next = 1;
+    const std::uint32_t shell = writeBoxShell(spline, next, 0.0, 0.0, 0.0, 1.0);
+    spline << "#" << next << "=MANIFOLD_SOLID_BREP('',#" << shell << ");\n";
+    std::string replaced = spline.str();
+    const std::size_t plane = replaced.find("=PLANE(");
+    ASSERT_NE(plane, std::string::npos);
+    replaced.replace(plane + 1, 5, "CONICAL_SURFACE");
+    StepFileParser approximate_parser;
+    ASSERT_TRUE(approximate_parser.parseText(stepFile(replaced)));
+    StepBrepTranslator approximate(approximate_parser);
+    const std::vector<StepSolid> approximated = approximate.translate();
+    ASSERT_EQ(approximated.size(), 1u);
+    EXPECT_EQ(approximated[0].name, "Solid_" + std::to_string(next));
+    EXPECT_EQ(approximate.stats().approximated_surfaces, 1u);
+    EXPECT_EQ(approximated[0].solid->outerShell()->faces().size(), 6u);
+}
+
+TEST(ImportExportIntegrationTest, StepBrepAssemblyAndStats) {
+    std::ostringstream data;
+    std::uint32_t next = 1;
+    const std::uint32_t shell = writeBoxShell(data, next, 0.0, 0.0, 0.0, 2.0);
+    data << "#" << next << "=MANIFOLD_SOLID_BREP('Left',#" << shell << ");\n";
+    data << "#" << next + 1 << "=MANIFOLD_SOLID_BREP('Right',#" << shell << ");\n";
+    data << "#" << next + 2 << "=SHAPE_REPRESENTATION('',(#" << next << ",#" << next + 1 << "),$);\n";
+    std::string test_file = "test_brep.step";
+    {
+        std::ofstream file(test_file);
+        file << stepFile(data.str());
+    }
+    ImportExportService service;
+    cad::core::Assembly assembly = service.importStepToAssembly(test_file);
+    ASSERT_EQ(assembly.components().size(), 2u);
+    EXPECT_EQ(assembly.components()[0].part->name(), "Left");
+    EXPECT_EQ(assembly.components()[1].part->name(), "Right");
+
+    StepBrepStats stats;
+    const std::vector<StepSolid> solids = service.importStepSolids(test_file, &stats);
+    ASSERT_EQ(solids.size(), 2u);
+    EXPECT_EQ(stats.solids, 2u);
+    EXPECT_EQ(stats.faces, 12u);
+    EXPECT_GE(stats.parse_ms, 0.0);
+    EXPECT_GE(stats.translate_ms, 0.0);
+    std::remove(test_file.c_str());
+}
+
+TEST(ImportExportIntegrationTest, IoPipelineStepKeepsProductStructure) {
+    // Ein Würfel als Teil "Cube", zweimal über NAUO/CDSR bei x = 10 und x = 50 in "Root" platziert
+    std::ostringstream data;
+    std::uint32_t next = 1;
+    const std::uint32_t shell = writeBoxShell(data, next, 0.0, 0.0, 0.0, 2.0);
+    const std::uint32_t brep = next++;
+    data << "#" << brep << "=MANIFOLD_SOLID_BREP('Cube body',#" << shell << ");\n";
+    auto definition = [&](const char* name) {
+        data << "#" << next << "=PRODUCT('" << name << "','" << name << "','',());\n";
+        data << "#" << next + 1 << "=PRODUCT_DEFINITION_FORMATION('','',#" << next << ");\n";
+        data << "#" << next + 2 << "=PRODUCT_DEFINITION('design','',#" << next + 1 << ",$);\n";
+        next += 3;
+        return next - 1;
+    };
+    auto placement = [&](double x) {
+        data << "#" << next << "=CARTESIAN_POINT('',(" << x << ",0.,0.));\n";
+        data << "#" << next + 1 << "=AXIS2_PLACEMENT_3D('',#" << next << ",$,$);\n";
+        next += 2;
+        return next - 1;
+    };
+    const std::uint32_t root = definition("Root");
+    const std::uint32_t cube = definition("Cube");
+    const std::uint32_t origin = placement(0.0);
+    const std::uint32_t root_rep = next++;
+    data << "#" << root_rep << "=SHAPE_REPRESENTATION('',(#" << origin << "),$);\n";
+    const std::uint32_t cube_rep = next++;
+    data << "#" << cube_rep << "=SHAPE_REPRESENTATION('',(#" << origin << "),$);\n";
+    data << "#" << next << "=PRODUCT_DEFINITION_SHAPE('','',#" << cube << ");\n";
+    data << "#" << next + 1 << "=SHAPE_DEFINITION_REPRESENTATION(#" << next << ",#" << cube_rep << ");\n";
+    data << "#" << next + 2 << "=ADVANCED_BREP_SHAPE_REPRESENTATION('',(#" << brep << "),$);\n";
+    data << "#" << next + 3 << "=SHAPE_REPRESENTATION_RELATIONSHIP('','',#" << cube_rep << ",#" << next + 2 << ");\n";
+    next += 4;
+    for (double x : {10.0, 50.0}) {
+        const std::uint32_t at = placement(x);
+        data << "#" << next << "=NEXT_ASSEMBLY_USAGE_OCCURRENCE('','Cube','',#" << root << ",#" << cube << ",$);\n";
+        data << "#" << next + 1 << "=PRODUCT_DEFINITION_SHAPE('','',#" << next << ");\n";
+        data << "#" << next + 2 << "=ITEM_DEFINED_TRANSFORMATION('','',#" << origin << ",#" << at << ");\n";
+        data << "#" << next + 3 << "=(REPRESENTATION_RELATIONSHIP('','',#" << cube_rep << ",#" << root_rep
+             << ")REPRESENTATION_RELATIONSHIP_WITH_TRANSFORMATION(#" << next + 2 << ")SHAPE_REPRESENTATION_RELATIONSHIP());\n";
+        data << "#" << next + 4 << "=CONTEXT_DEPENDENT_SHAPE_REPRESENTATION(#" << next + 3 << ",#" << next + 1 << ");\n";
+        next += 5;
+    }
+    const std::string test_file = "test_pipeline_structure.step";
+    {
+        std::ofstream file(test_file);
+        file << stepFile(data.str());
+    }
+
+    IoPipeline pipeline;
+    const ConversionResult result = pipeline.convert({test_file, "test_pipeline_structure.ply"});
+    ASSERT_TRUE(result.success) << result.message;
+    EXPECT_EQ(result.components, 2u);
+    EXPECT_EQ(result.meshes, 1u);
+    PlyReader reader;
+    PlyData ply;
+    ASSERT_TRUE(reader.readFile("test_pipeline_structure.ply", ply)) << reader.error();
+    ASSERT_EQ(ply.mesh.indices.size(), 72u);
+    double min_x = 1e9;
+    double max_x = -1e9;
+    for (std::size_t v = 0; v < ply.mesh.vertices.size(); v += 3) {
+        min_x = std::min(min_x, ply.mesh.vertices[v]);
+        max_x = std::max(max_x, ply.mesh.vertices[v]);
+    }
+    EXPECT_DOUBLE_EQ(min_x, 10.0);
+    EXPECT_DOUBLE_EQ(max_x, 52.0);
+    std::remove(test_file.c_str());
+    std::remove("test_pipeline_structure.ply");
+}
+#endif
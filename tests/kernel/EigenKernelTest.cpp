@@ -6,8 +6,10 @@
 
 #include <gtest/gtest.h>
 #include <cmath>
+#include <filesystem>
 #include <fstream>
 #include <map>
+#include <stdexcept>
 #include "core/Modeler/Part.h"
 #include "core/kernel/math/Vector2.h"
 #include "core/kernel/math/Vector3.h"
@@ -42,6 +44,10 @@
 #include "core/kernel/io/StlWriter.h"
 #include "core/kernel/io/StlReader.h"
 #include "core/kernel/KernelBridge.h"
+#include "core/kernel/FamilyTableEvaluator.h"
+#include "core/kernel/PartHash.h"
+#include "core/kernel/io/MeshCache.h"
+#include "core/parallel/ThreadPool.h"
 #include "core/Modeler/Sketch.h"
 
 using namespace cad::kernel;
@@ -353,4 +359,204 @@ TEST(EigenKernel, KernelBridgeBuildPartFromPart) {
     EXPECT_GT(mesh.vertices.size(), 0u);
 }
 
+// --- Familientabelle: parallele Batch-Auswertung ---
+TEST(EigenKernel, FamilyTableEvaluatorBatch) {
+    cad::core::Sketch sketch("Sketch1");
+    sketch.addRectangle({0, 0}, 10, 5);
+    std::map<std::string, cad::core::Sketch> sketches;
+    sketches.insert(std::make_pair(sketch.name(), sketch));
+    cad::core::Part part("Block");
+    std::string extrude = part.createExtrude(sketch.name(), 4.0, false);
+    part.addUserParameter(cad::core::Parameter{"Height", 4.0, ""});
+    part.addUserParameter(cad::core::Parameter{extrude + ".depth", 4.0, "Height*2"});
+
+    std::vector<cad::core::Configuration> rows;
+    rows.push_back({"Short", {{extrude + ".depth", 10.0}}});
+    rows.push_back({"Long", {{extrude + ".depth", 20.0}}});
+    rows.push_back({"ShortAgain", {{extrude + ".depth", 10.0}}});
+    rows.push_back({"Driven", {{"Height", 15.0}}});
+    rows.push_back({"Broken", {{"Missing1.depth", 1.0}}});
+    rows.push_back({"Typo", {{"Heigth", 15.0}}});
+
+    cad::core::ThreadPool pool(4);
+    FamilyTableEvaluator evaluator(&pool);
+    FamilyTableOptions options;
+    options.sketches = &sketches;
+    options.density = 1e-3;
+    auto results = evaluator.evaluate(part, rows, options);
+    ASSERT_EQ(results.size(), rows.size());
+
+    ASSERT_TRUE(results[0].success);
+    EXPECT_EQ(results[0].configuration, "Short");
+    EXPECT_NEAR((results[0].max_x - results[0].min_x) * (results[0].max_y - results[0].min_y), 50.0, 1e-6);
+    EXPECT_NEAR(results[0].max_z - results[0].min_z, 10.0, 1e-6);
+    EXPECT_NEAR(results[0].volume, 500.0, 1e-6);
+    EXPECT_NEAR(results[0].mass, 0.5, 1e-9);
+    ASSERT_TRUE(results[1].success);
+    EXPECT_NEAR(results[1].volume, 1000.0, 1e-6);
+    EXPECT_NE(results[0].mesh_hash, results[1].mesh_hash);
+    EXPECT_EQ(results[0].mesh_hash, results[2].mesh_hash);
+    EXPECT_TRUE(results[0].cache_hit || results[2].cache_hit);
+    ASSERT_TRUE(results[3].success);
+    EXPECT_NEAR(results[3].max_z - results[3].min_z, 30.0, 1e-6);
+    EXPECT_FALSE(results[4].success);
+    EXPECT_FALSE(results[5].success);  // unbekannter Parameter legt keinen neuen an
+    EXPECT_GT(evaluator.cache().hits(), 0u);
+
+    // Basis-Part bleibt unverändert (Copy-on-Write)
+    EXPECT_DOUBLE_EQ(part.findFeature(extrude)->depth, 4.0);
+}
+
+TEST(EigenKernel, FamilyTableCacheTracksSketchContent) {
+    cad::core::Sketch base("Sketch1");
+    const std::string edge = base.addRectangle({0, 0}, 10, 5);
+    cad::core::Sketch pocket("Sketch2");
+    pocket.addCircle({2, 2}, 1);
+    std::map<std::string, cad::core::Sketch> sketches;
+    sketches.insert(std::make_pair(base.name(), base));
+    sketches.insert(std::make_pair(pocket.name(), pocket));
+    cad::core::Part part("Block");
+    std::string extrude = part.createExtrude(base.name(), 4.0, false);
+    part.createExtrude(pocket.name(), 2.0, false);  // abhängiges Feature auf eigener Skizze
+
+    const std::vector<cad::core::Configuration> rows{{"Deep", {{extrude + ".depth", 6.0}}}};
+    cad::core::ThreadPool pool(2);
+    FamilyTableEvaluator evaluator(&pool);
+    FamilyTableOptions options;
+    options.sketches = &sketches;
+    ASSERT_TRUE(evaluator.evaluate(part, rows, options)[0].success);
+    EXPECT_TRUE(evaluator.evaluate(part, rows, options)[0].cache_hit);
+
+    // Gleiche Ids, anderer Inhalt: der Cache über Aufrufe hinweg darf nicht treffen
+    sketches.at(pocket.name()).addCircle({6, 2}, 1);
+    EXPECT_FALSE(evaluator.evaluate(part, rows, options)[0].cache_hit);
+    sketches.at(base.name()).addConstraint(cad::core::Constraint{cad::core::ConstraintType::Horizontal, edge, "", 0.0});
+    EXPECT_FALSE(evaluator.evaluate(part, rows, options)[0].cache_hit);
+    EXPECT_TRUE(evaluator.evaluate(part, rows, options)[0].cache_hit);
+
+    // Fehlgeschlagene Regel wird wie ein unbekanntes Feature gemeldet
+    part.addUserParameter(cad::core::Parameter{"Height", 4.0, ""});
+    cad::core::Rule rule;
+    rule.condition_expression = "Height > 1";
+    rule.then_parameter = "Missing";
+    rule.then_value_expression = "2";
+    part.addRule(rule);
+    const FamilyVariantResult broken = evaluator.evaluate(part, rows, options)[0];
+    EXPECT_FALSE(broken.success);
+    EXPECT_NE(broken.message.find("Regel"), std::string::npos);
+}
+
+TEST(EigenKernel, RegenCacheDoesNotKeepFailures) {
+    RegenCache cache;
+    auto failing = []() -> RegenCache::SolidPtr { throw std::runtime_error("regen failed"); };
+    EXPECT_THROW(cache.base(7, failing), std::runtime_error);
+    EXPECT_EQ(cache.size(), 0u);
+    bool hit = true;
+    auto solid = std::make_shared<Solid>();
+    EXPECT_EQ(cache.base(7, [&solid] { return solid; }, &hit), solid);
+    EXPECT_FALSE(hit);
+    EXPECT_EQ(cache.base(7, failing, &hit), solid);
+    EXPECT_TRUE(hit);
+}
+
+// --- Tessellierungs-Cache auf der Platte ---
+TEST(EigenKernel, PartContentKeyStable) {
+    cad::core::Sketch sketch("Sketch1");
+    sketch.addRectangle({0, 0}, 8, 4);
+    std::map<std::string, cad::core::Sketch> sketches;
+    sketches.insert(std::make_pair(sketch.name(), sketch));
+    cad::core::Part a("A");
+    a.createExtrude(sketch.name(), 6.0, false);
+    cad::core::Part b("B");
+    b.createExtrude(sketch.name(), 6.0, false);
+
+    const std::uint64_t key = partContentKey(a, &sketches, 0.01);
+    EXPECT_EQ(key, partContentKey(b, &sketches, 0.01));  // Name geht nicht ein
+    EXPECT_NE(key, partContentKey(a, &sketches, 0.1));   // Toleranz schon
+    EXPECT_NE(key, partContentKey(a, nullptr, 0.01));
+
+    const std::string hole = b.createHole(3.0, 5.0);
+    EXPECT_NE(key, partContentKey(b, &sketches, 0.01));
+    b.setFeatureSuppressed(hole, true);
+    EXPECT_EQ(key, partContentKey(b, &sketches, 0.01));
+
+    std::map<std::string, cad::core::Sketch> changed;
+    cad::core::Sketch wider("Sketch1");
+    wider.addRectangle({0, 0}, 9, 4);
+    changed.insert(std::make_pair(wider.name(), wider));
+    EXPECT_NE(key, partContentKey(a, &changed, 0.01));
+
+    // Bedingungen gehören zum Inhalt
+    changed = sketches;
+    changed.at("Sketch1").addConstraint(cad::core::Constraint{cad::core::ConstraintType::Horizontal, "a", "", 0.0});
+    EXPECT_NE(key, partContentKey(a, &changed, 0.01));
+}
+
+TEST(EigenKernel, MeshCacheRoundTripAndCollect) {
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "eigen_kernel_test_mesh_cache";
+    fs::remove_all(dir);
+
+    TriangleMesh box = triangulate(*SolidBuilder::box(2, 3, 4));
+    TriangleMesh welded = MeshCache::weld(box);
+    EXPECT_EQ(welded.vertices.size(), 8u * 3);  // Fächer je Fläche → 24 Punkte, verschweißt 8
+    EXPECT_EQ(welded.indices.size(), box.indices.size());
+
+    std::size_t entry_bytes = 0;
+    {
+        MeshCache cache(dir.string());
+        ASSERT_TRUE(cache.isValid());
+        EXPECT_EQ(cache.load(42), nullptr);
+        ASSERT_TRUE(cache.store(42, box));
+        ASSERT_TRUE(cache.store(42, box, 1));
+        EXPECT_TRUE(cache.contains(42, 1));
+        entry_bytes = static_cast<std::size_t>(cache.stats().bytes / 2);
+    }
+
+    // Neuer Lauf: Einträge werden aus dem Verzeichnis übernommen
+    MeshCache cache(dir.string());
+    EXPECT_EQ(cache.stats().entries, 2u);
+    auto mapped = cache.load(42);
+    ASSERT_NE(mapped, nullptr);
+#ifndef _WIN32
+    EXPECT_TRUE(mapped->isMapped());
+#endif
+    ASSERT_EQ(mapped->vertexCount(), 8u);
+    ASSERT_EQ(mapped->indexCount(), welded.indices.size());
+    for (std::size_t i = 0; i < welded.vertices.size(); ++i) {
+        EXPECT_DOUBLE_EQ(mapped->vertices()[i], welded.vertices[i]);
+    }
+    for (std::size_t i = 0; i < welded.indices.size(); ++i) {
+        EXPECT_EQ(mapped->indices()[i], welded.indices[i]);
+    }
+    EXPECT_EQ(cache.load(43), nullptr);
+    EXPECT_EQ(cache.stats().hits, 1u);
+
+    // Beschädigte Datei wird als Fehltreffer verworfen
+    for (const auto& file : fs::directory_iterator(dir)) {
+        if (file.path().filename().string().find("-l1") != std::string::npos) {
+            fs::resize_file(file.path(), 64);
+        }
+    }
+    EXPECT_EQ(cache.load(42, 1), nullptr);
+    EXPECT_FALSE(cache.contains(42, 1));
+
+    // GC: Limit für zwei Einträge, der zuletzt gelesene (42) überlebt
+    ASSERT_TRUE(cache.store(7, box));
+    cache.load(42);
+    cache.setMaxBytes(entry_bytes * 2);
+    ASSERT_TRUE(cache.store(8, box));
+    EXPECT_EQ(cache.stats().entries, 2u);
+    EXPECT_TRUE(cache.contains(42));
+    EXPECT_FALSE(cache.contains(7));
+    EXPECT_TRUE(cache.contains(8));
+    EXPECT_GE(cache.stats().collected, 1u);
+    // Gelöschte Datei bleibt über die bestehende Sicht lesbar
+    EXPECT_DOUBLE_EQ(mapped->vertices()[0], welded.vertices[0]);
+
+    cache.clear();
+    EXPECT_EQ(cache.stats().bytes, 0u);
+    fs::remove_all(dir);
+}
+
 #endif // CAD_USE_EIGENER_KERN
@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "modules/simulation/SimulationService.h"
+#include "core/Modeler/Assembly.h"
+
+using namespace cad::modules;
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+cad::core::Transform at(double x, double y, double z) {
+    cad::core::Transform t;
+    t.tx = x;
+    t.ty = y;
+    t.tz = z;
+    return t;
+}
+
+cad::core::Joint joint(std::uint64_t a, std::uint64_t b, cad::core::JointType type,
+                       double ox, double oy, double oz, double ax, double ay, double az) {
+    cad::core::Joint j;
+    j.component_a = a;
+    j.component_b = b;
+    j.type = type;
+    j.axis_origin = cad::core::Point3D{ox, oy, oz};
+    j.axis_direction = cad::core::Vector3D{ax, ay, az};
+    return j;
+}
+
+/** Schubkurbel: Kurbel r = 20 um y, Pleuel l = 60, Schieber entlang x. */
+cad::core::Assembly sliderCrank() {
+    cad::core::Assembly assembly;
+    std::uint64_t ground = assembly.addComponent(cad::core::Part("Ground"), at(0, 0, 0));
+    std::uint64_t crank = assembly.addComponent(cad::core::Part("Crank"), at(10, 0, 0));
+    std::uint64_t rod = assembly.addComponent(cad::core::Part("Rod"), at(50, 0, 0));
+    std::uint64_t slider = assembly.addComponent(cad::core::Part("Slider"), at(80, 0, 0));
+    assembly.addJoint(joint(ground, crank, cad::core::JointType::Revolute, 0, 0, 0, 0, 1, 0));
+    assembly.addJoint(joint(crank, rod, cad::core::JointType::Revolute, 20, 0, 0, 0, 1, 0));
+    assembly.addJoint(joint(rod, slider, cad::core::JointType::Revolute, 80, 0, 0, 0, 1, 0));
+    assembly.addJoint(joint(ground, slider, cad::core::JointType::Slider, 80, 0, 0, 1, 0, 0));
+    return assembly;
+}
+
+}  // namespace
+
+TEST(SimulationServiceTest, DrivenRevoluteFollowsDrive) {
+    cad::core::Assembly assembly;
+    std::uint64_t ground = assembly.addComponent(cad::core::Part("Ground"), at(0, 0, 0));
+    std::uint64_t crank = assembly.addComponent(cad::core::Part("Crank"), at(50, 0, 0));
+    assembly.createRevolute(ground, crank, 0.0, 1.0, 0.0);
+
+    SimulationService service;
+    SimulationRequest request;
+    request.targetAssembly = "Crank";
+    request.type = SimulationType::Motion;
+    request.time_step = 0.001;
+    request.duration = 1.0;
+    request.joint_drives["Revolute_1"] = 2.0 * kPi;
+    request.assembly = &assembly;
+
+    SimulationResult result = service.runSimulation(request);
+    ASSERT_TRUE(result.success) << result.message;
+    const auto& series = result.motion_result.trajectories;
+    ASSERT_EQ(series.bodyCount(), 2u);
+    ASSERT_EQ(series.jointCount(), 1u);
+    const std::size_t last = series.sampleCount() - 1;
+    EXPECT_NEAR(series.time(last), 1.0, 1e-9);
+    EXPECT_NEAR(series.jointValue(last, 0), 2.0 * kPi, 1e-2);
+    EXPECT_NEAR(series.jointRate(last, 0), 2.0 * kPi, 1e-2);
+    // Eine volle Umdrehung: Kurbel wieder bei (50, 0, 0)
+    cad::core::Transform end = series.transform(last, 1);
+    EXPECT_NEAR(end.tx, 50.0, 0.5);
+    EXPECT_NEAR(end.tz, 0.0, 0.5);
+    EXPECT_LT(result.motion_result.max_constraint_error, 0.1);
+    EXPECT_EQ(result.motion_result.positions.size(), series.sampleCount());
+}
+
+TEST(SimulationServiceTest, PendulumPeriod) {
+    // Kleine Auslenkung, Punktmasse (k = 1 mm): T = 2π sqrt(L/g)
+    const double length = 100.0;
+    const double theta0 = 0.05;
+    cad::core::Assembly assembly;
+    std::uint64_t ground = assembly.addComponent(cad::core::Part("Ground"), at(0, 0, 0));
+    std::uint64_t bob = assembly.addComponent(cad::core::Part("Bob"),
+                                              at(length * std::sin(theta0), 0, -length * std::cos(theta0)));
+    assembly.addJoint(joint(ground, bob, cad::core::JointType::Revolute, 0, 0, 0, 0, 1, 0));
+
+    cad::simulation::MultibodyOptions options;
+    options.time_step = 1e-4;
+    options.duration = 1.0;
+    options.default_body.radius_of_gyration = 1.0;
+    options.sample_stride = 1;
+    cad::simulation::MultibodyResult result = cad::simulation::MultibodySystem::simulate(assembly, options);
+    ASSERT_TRUE(result.success) << result.message;
+
+    // Nulldurchgänge von x (Körper 1) → halbe Perioden
+    std::vector<double> crossings;
+    for (std::size_t s = 1; s < result.series.sampleCount(); ++s) {
+        const double x0 = result.series.transform(s - 1, 1).tx;
+        const double x1 = result.series.transform(s, 1).tx;
+        if ((x0 > 0.0) != (x1 > 0.0)) {
+            crossings.push_back(result.series.time(s - 1) +
+                                (result.series.time(s) - result.series.time(s - 1)) * x0 / (x0 - x1));
+        }
+    }
+    ASSERT_GE(crossings.size(), 3u);
+    const double period = crossings[2] - crossings[0];
+    const double expected = 2.0 * kPi * std::sqrt((length * length + 1.0) / (9810.0 * length));
+    EXPECT_NEAR(period, expected, 0.01 * expected);
+    EXPECT_LT(result.max_constraint_error, 0.05);
+}
+
+TEST(SimulationServiceTest, GroundsFirstJointedComponent) {
+    // Erste Komponente ohne Gelenk (z.B. Gehäusedeckel): fixiert wird der Rahmen, an dem das Pendel hängt
+    cad::core::Assembly assembly;
+    assembly.addComponent(cad::core::Part("Cover"), at(0, 0, 200));
+    std::uint64_t frame = assembly.addComponent(cad::core::Part("Frame"), at(0, 0, 0));
+    std::uint64_t bob = assembly.addComponent(cad::core::Part("Bob"), at(100, 0, 0));
+    assembly.addJoint(joint(frame, bob, cad::core::JointType::Revolute, 0, 0, 0, 0, 1, 0));
+
+    cad::simulation::MultibodyOptions options;
+    options.time_step = 1e-3;
+    options.duration = 0.5;
+    cad::simulation::MultibodyResult result = cad::simulation::MultibodySystem::simulate(assembly, options);
+    ASSERT_TRUE(result.success) << result.message;
+    ASSERT_EQ(result.series.bodyCount(), 2u);
+    EXPECT_EQ(result.series.bodyIds()[0], frame);
+    const std::size_t last = result.series.sampleCount() - 1;
+    const cad::core::Transform held = result.series.transform(last, 0);
+    EXPECT_NEAR(held.tx, 0.0, 1e-6);
+    EXPECT_NEAR(held.tz, 0.0, 1e-6);
+    // Pendel schwingt am Gelenk: Abstand zum Drehpunkt bleibt, der Körper fällt nicht frei
+    const cad::core::Transform swung = result.series.transform(last, 1);
+    EXPECT_NEAR(std::hypot(swung.tx, swung.tz), 100.0, 0.5);
+    EXPECT_LT(swung.tz, -10.0);
+
+    // Explizit fixierte Komponente muss ein Körper sein
+    options.ground_component = assembly.components()[0].id;
+    result = cad::simulation::MultibodySystem::simulate(assembly, options);
+    EXPECT_FALSE(result.success);
+    EXPECT_NE(result.message.find("keinem Gelenk"), std::string::npos);
+}
+
+TEST(SimulationServiceTest, SliderCrankClosedLoop) {
+    cad::core::Assembly assembly = sliderCrank();
+    cad::simulation::MultibodyOptions options;
+    options.time_step = 1e-3;
+    options.duration = 1.0;
+    options.joint_drives["Revolute1"] = 2.0 * kPi;
+    options.sample_stride = 10;
+    cad::simulation::MultibodyResult result = cad::simulation::MultibodySystem::simulate(assembly, options);
+    ASSERT_TRUE(result.success) << result.message;
+    ASSERT_EQ(result.driven_joints.size(), 1u);
+    EXPECT_TRUE(result.warnings.empty());
+
+    const auto& series = result.series;
+    for (std::size_t s = 0; s < series.sampleCount(); ++s) {
+        const double theta = series.jointValue(s, 0);
+        // Drehung um +y bewegt +x nach -z; Schieberlage x = r cosθ + sqrt(l² - r² sin²θ)
+        const double expected = 20.0 * std::cos(theta) + std::sqrt(3600.0 - 400.0 * std::sin(theta) * std::sin(theta));
+        EXPECT_NEAR(series.transform(s, 3).tx, expected, 0.5) << "t = " << series.time(s);
+        // Schieber-Koordinate relativ zur Startlage
+        EXPECT_NEAR(series.jointValue(s, 3), expected - 80.0, 0.5);
+    }
+}
+
+TEST(SimulationServiceTest, SliderLimitStopsTravel) {
+    cad::core::Assembly assembly;
+    std::uint64_t ground = assembly.addComponent(cad::core::Part("Ground"), at(0, 0, 0));
+    std::uint64_t carriage = assembly.addComponent(cad::core::Part("Carriage"), at(0, 0, 0));
+    assembly.createSlider(ground, carriage, 0.0, 0.0, 1.0, -10.0, 10.0);
+
+    cad::simulation::MultibodyOptions options;
+    options.time_step = 1e-3;
+    options.duration = 0.5;
+    options.joint_drives["Slider_7"] = 1.0;
+    cad::simulation::MultibodyResult result = cad::simulation::MultibodySystem::simulate(assembly, options);
+    ASSERT_TRUE(result.success) << result.message;
+    ASSERT_EQ(result.warnings.size(), 1u);  // Antrieb ohne passendes Gelenk
+    const std::size_t last = result.series.sampleCount() - 1;
+    EXPECT_NEAR(result.series.jointValue(last, 0), -10.0, 0.1);
+    EXPECT_NEAR(result.series.transform(last, 1).tz, -10.0, 0.1);
+}
+
+TEST(SimulationServiceTest, LongStudyStreamsCompactSeries) {
+    cad::core::Assembly assembly = sliderCrank();
+    SimulationService service;
+    SimulationRequest request;
+    request.targetAssembly = "SliderCrank";
+    request.type = SimulationType::Motion;
+    request.time_step = 1e-4;
+    request.duration = 10.0;  // 100k Schritte
+    request.joint_drives["Revolute1"] = 2.0 * kPi;
+    request.assembly = &assembly;
+
+    SimulationResult result = service.runSimulation(request);
+    ASSERT_TRUE(result.success) << result.message;
+    const auto& series = result.motion_result.trajectories;
+    EXPECT_LE(series.sampleCount(), 4097u);
+    EXPECT_NEAR(series.time(series.sampleCount() - 1), 10.0, 1e-6);
+    EXPECT_NEAR(series.jointValue(series.sampleCount() - 1, 0), 20.0 * kPi, 0.05);
+    EXPECT_LT(series.memoryBytes(), 1024u * 1024u);
+    std::cout << "    100k steps in " << result.computation_time << " s" << std::endl;
+}
+
+TEST(SimulationServiceTest, MotionWithoutAssemblyUsesAnalyticModel) {
+    SimulationService service;
+    SimulationRequest request;
+    request.targetAssembly = "MainAssembly";
+    request.type = SimulationType::Motion;
+    request.joint_drives["Revolute1"] = 1.0;
+    SimulationResult result = service.runSimulation(request);
+    ASSERT_TRUE(result.success);
+    EXPECT_FALSE(result.motion_result.positions.empty());
+    EXPECT_EQ(result.motion_result.trajectories.sampleCount(), 0u);
+}